@@ -26,6 +26,7 @@ google_cloud_cpp_generator_hdrs = [
     "internal/idempotency_policy_generator.h",
     "internal/logging_decorator_generator.h",
     "internal/metadata_decorator_generator.h",
+    "internal/metrics_decorator_generator.h",
     "internal/predicate_utils.h",
     "internal/printer.h",
     "internal/retry_policy_generator.h",
@@ -43,6 +44,7 @@ google_cloud_cpp_generator_srcs = [
     "internal/idempotency_policy_generator.cc",
     "internal/logging_decorator_generator.cc",
     "internal/metadata_decorator_generator.cc",
+    "internal/metrics_decorator_generator.cc",
     "internal/predicate_utils.cc",
     "internal/retry_policy_generator.cc",
     "internal/service_code_generator.cc",
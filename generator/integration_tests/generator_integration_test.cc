@@ -101,6 +101,8 @@ class GeneratorIntegrationTest
     args.emplace_back("--proto_path=" + code_path);
     args.emplace_back("--cpp_codegen_out=" + output_path_);
     args.emplace_back("--cpp_codegen_opt=product_path=" + product_path_);
+    args.emplace_back("--cpp_codegen_opt=gen_async_rpc=GetDatabase");
+    args.emplace_back("--cpp_codegen_opt=gen_async_rpc=DropDatabase");
     args.emplace_back("generator/integration_tests/test.proto");
 
     std::vector<char const*> c_args;
@@ -146,6 +148,8 @@ INSTANTIATE_TEST_SUITE_P(
                     "internal/database_admin_logging_decorator.gcpcxx.pb.cc",
                     "internal/database_admin_metadata_decorator.gcpcxx.pb.h",
                     "internal/database_admin_metadata_decorator.gcpcxx.pb.cc",
+                    "internal/database_admin_metrics_decorator.gcpcxx.pb.h",
+                    "internal/database_admin_metrics_decorator.gcpcxx.pb.cc",
                     "internal/database_admin_stub_factory.gcpcxx.pb.h",
                     "internal/database_admin_stub_factory.gcpcxx.pb.cc",
                     "internal/database_admin_stub.gcpcxx.pb.h",
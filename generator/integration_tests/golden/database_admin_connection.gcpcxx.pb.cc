@@ -17,8 +17,13 @@
 // source: generator/integration_tests/test.proto
 
 #include "generator/integration_tests/golden/database_admin_connection.gcpcxx.pb.h"
+#include "absl/memory/memory.h"
 #include "generator/integration_tests/golden/internal/database_admin_stub_factory.gcpcxx.pb.h"
+#include "google/cloud/background_threads.h"
+#include "google/cloud/internal/async_polling_loop.h"
+#include "google/cloud/internal/async_retry_loop.h"
 #include "google/cloud/internal/polling_loop.h"
+#include "google/cloud/internal/resumable_streaming_read_rpc.h"
 #include "google/cloud/internal/retry_loop.h"
 #include <memory>
 
@@ -163,6 +168,40 @@ ListBackupOperationsRange DatabaseAdminConnection::ListBackupOperations(
     });
 }
 
+StreamingReadStream DatabaseAdminConnection::StreamingRead(
+    ::google::test::admin::database::v1::StreamingReadRequest const&) {
+  return google::cloud::internal::MakeStreamRange<::google::test::admin::database::v1::StreamingReadResponse>(
+      []() -> absl::variant<Status, ::google::test::admin::database::v1::StreamingReadResponse> {
+        return Status(StatusCode::kUnimplemented, "not implemented");
+      });
+}
+
+std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<
+    ::google::test::admin::database::v1::StreamingReadWriteRequest,
+    ::google::test::admin::database::v1::StreamingReadWriteResponse>>
+DatabaseAdminConnection::AsyncStreamingReadWrite() {
+  return absl::make_unique<
+      google::cloud::internal::AsyncStreamingReadWriteRpcError<
+          ::google::test::admin::database::v1::StreamingReadWriteRequest,
+          ::google::test::admin::database::v1::StreamingReadWriteResponse>>(
+      Status(StatusCode::kUnimplemented, "not implemented"));
+}
+
+future<StatusOr<::google::test::admin::database::v1::Database>>
+DatabaseAdminConnection::AsyncGetDatabase(
+    ::google::test::admin::database::v1::GetDatabaseRequest const&) {
+  return google::cloud::make_ready_future<
+    StatusOr<::google::test::admin::database::v1::Database>>(
+    Status(StatusCode::kUnimplemented, "not implemented"));
+}
+
+future<Status>
+DatabaseAdminConnection::AsyncDropDatabase(
+    ::google::test::admin::database::v1::DropDatabaseRequest const&) {
+  return google::cloud::make_ready_future(
+    Status(StatusCode::kUnimplemented, "not implemented"));
+}
+
 namespace {
 std::unique_ptr<RetryPolicy> DefaultRetryPolicy() {
   return LimitedTimeRetryPolicy(std::chrono::minutes(30)).clone();
@@ -188,26 +227,40 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
  public:
   explicit DatabaseAdminConnectionImpl(
       std::shared_ptr<golden_internal::DatabaseAdminStub> stub,
+      std::unique_ptr<BackgroundThreads> background_threads,
       std::unique_ptr<RetryPolicy> retry_policy,
       std::unique_ptr<BackoffPolicy> backoff_policy,
       std::unique_ptr<PollingPolicy> polling_policy,
-      std::unique_ptr<DatabaseAdminConnectionIdempotencyPolicy> idempotency_policy)
+      std::unique_ptr<DatabaseAdminConnectionIdempotencyPolicy> idempotency_policy,
+      std::shared_ptr<RetryBudget> retry_budget = {},
+      BackoffSleeper backoff_sleeper = {})
       : stub_(std::move(stub)),
+        background_threads_(std::move(background_threads)),
         retry_policy_prototype_(std::move(retry_policy)),
         backoff_policy_prototype_(std::move(backoff_policy)),
         polling_policy_prototype_(std::move(polling_policy)),
-        idempotency_policy_(std::move(idempotency_policy)) {}
+        idempotency_policy_(std::move(idempotency_policy)),
+        retry_budget_(std::move(retry_budget)),
+        backoff_sleeper_(std::move(backoff_sleeper)) {}
 
   explicit DatabaseAdminConnectionImpl(
-      std::shared_ptr<golden_internal::DatabaseAdminStub> stub)
+      std::shared_ptr<golden_internal::DatabaseAdminStub> stub,
+      std::unique_ptr<BackgroundThreads> background_threads,
+      std::shared_ptr<RetryBudget> retry_budget = {},
+      BackoffSleeper backoff_sleeper = {})
       : DatabaseAdminConnectionImpl(
-          std::move(stub),
+          std::move(stub), std::move(background_threads),
           DefaultRetryPolicy(),
           DefaultBackoffPolicy(),
           DefaultPollingPolicy(),
-          MakeDefaultDatabaseAdminConnectionIdempotencyPolicy()) {}
+          MakeDefaultDatabaseAdminConnectionIdempotencyPolicy(),
+          std::move(retry_budget), std::move(backoff_sleeper)) {}
 
-  ~DatabaseAdminConnectionImpl() override = default;
+  // Stop polling any pending operations, otherwise releasing the
+  // background threads would block until their next polling timer.
+  ~DatabaseAdminConnectionImpl() override {
+    polling_loops_.Shutdown();
+  }
 
   ListDatabasesRange ListDatabases(
       ::google::test::admin::database::v1::ListDatabasesRequest request) override {
@@ -218,10 +271,12 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
     auto backoff = std::shared_ptr<BackoffPolicy const>(
         backoff_policy_prototype_->clone());
     auto idempotency = idempotency_policy_->ListDatabases(request);
+    auto budget = retry_budget_;
+    auto sleeper = backoff_sleeper_;
     char const* function_name = __func__;
     return ListDatabasesRange(
         std::move(request),
-        [stub, retry, backoff, idempotency, function_name]
+        [stub, retry, backoff, idempotency, budget, sleeper, function_name]
           (::google::test::admin::database::v1::ListDatabasesRequest const& r) {
           return google::cloud::internal::RetryLoop(
               retry->clone(), backoff->clone(), idempotency,
@@ -229,7 +284,7 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
                      ::google::test::admin::database::v1::ListDatabasesRequest const& request) {
                 return stub->ListDatabases(context, request);
               },
-              r, function_name);
+              r, function_name, budget, sleeper);
         },
         [](::google::test::admin::database::v1::ListDatabasesResponse r) {
           std::vector<::google::test::admin::database::v1::Database> result(r.databases().size());
@@ -249,7 +304,7 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
                ::google::test::admin::database::v1::CreateDatabaseRequest const& request) {
           return stub_->CreateDatabase(context, request);
         },
-        request, __func__);
+        request, __func__, retry_budget_, backoff_sleeper_);
     if (!operation) {
       return google::cloud::make_ready_future(
           StatusOr<::google::test::admin::database::v1::Database>(operation.status()));
@@ -268,7 +323,7 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
             ::google::test::admin::database::v1::GetDatabaseRequest const& request) {
           return stub_->GetDatabase(context, request);
         },
-        request, __func__);
+        request, __func__, retry_budget_, backoff_sleeper_);
 }
 
   future<StatusOr<::google::test::admin::database::v1::UpdateDatabaseDdlMetadata>>
@@ -281,7 +336,7 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
                ::google::test::admin::database::v1::UpdateDatabaseDdlRequest const& request) {
           return stub_->UpdateDatabaseDdl(context, request);
         },
-        request, __func__);
+        request, __func__, retry_budget_, backoff_sleeper_);
     if (!operation) {
       return google::cloud::make_ready_future(
           StatusOr<::google::test::admin::database::v1::UpdateDatabaseDdlMetadata>(operation.status()));
@@ -300,7 +355,7 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
             ::google::test::admin::database::v1::DropDatabaseRequest const& request) {
           return stub_->DropDatabase(context, request);
         },
-        request, __func__);
+        request, __func__, retry_budget_, backoff_sleeper_);
 }
 
   StatusOr<::google::test::admin::database::v1::GetDatabaseDdlResponse>
@@ -313,7 +368,7 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
             ::google::test::admin::database::v1::GetDatabaseDdlRequest const& request) {
           return stub_->GetDatabaseDdl(context, request);
         },
-        request, __func__);
+        request, __func__, retry_budget_, backoff_sleeper_);
 }
 
   StatusOr<::google::iam::v1::Policy>
@@ -326,7 +381,7 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
             ::google::iam::v1::SetIamPolicyRequest const& request) {
           return stub_->SetIamPolicy(context, request);
         },
-        request, __func__);
+        request, __func__, retry_budget_, backoff_sleeper_);
 }
 
   StatusOr<::google::iam::v1::Policy>
@@ -339,7 +394,7 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
             ::google::iam::v1::GetIamPolicyRequest const& request) {
           return stub_->GetIamPolicy(context, request);
         },
-        request, __func__);
+        request, __func__, retry_budget_, backoff_sleeper_);
 }
 
   StatusOr<::google::iam::v1::TestIamPermissionsResponse>
@@ -352,7 +407,7 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
             ::google::iam::v1::TestIamPermissionsRequest const& request) {
           return stub_->TestIamPermissions(context, request);
         },
-        request, __func__);
+        request, __func__, retry_budget_, backoff_sleeper_);
 }
 
   future<StatusOr<::google::test::admin::database::v1::Backup>>
@@ -365,7 +420,7 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
                ::google::test::admin::database::v1::CreateBackupRequest const& request) {
           return stub_->CreateBackup(context, request);
         },
-        request, __func__);
+        request, __func__, retry_budget_, backoff_sleeper_);
     if (!operation) {
       return google::cloud::make_ready_future(
           StatusOr<::google::test::admin::database::v1::Backup>(operation.status()));
@@ -384,7 +439,7 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
             ::google::test::admin::database::v1::GetBackupRequest const& request) {
           return stub_->GetBackup(context, request);
         },
-        request, __func__);
+        request, __func__, retry_budget_, backoff_sleeper_);
 }
 
   StatusOr<::google::test::admin::database::v1::Backup>
@@ -397,7 +452,7 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
             ::google::test::admin::database::v1::UpdateBackupRequest const& request) {
           return stub_->UpdateBackup(context, request);
         },
-        request, __func__);
+        request, __func__, retry_budget_, backoff_sleeper_);
 }
 
   Status
@@ -410,7 +465,7 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
             ::google::test::admin::database::v1::DeleteBackupRequest const& request) {
           return stub_->DeleteBackup(context, request);
         },
-        request, __func__);
+        request, __func__, retry_budget_, backoff_sleeper_);
 }
 
   ListBackupsRange ListBackups(
@@ -422,10 +477,12 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
     auto backoff = std::shared_ptr<BackoffPolicy const>(
         backoff_policy_prototype_->clone());
     auto idempotency = idempotency_policy_->ListBackups(request);
+    auto budget = retry_budget_;
+    auto sleeper = backoff_sleeper_;
     char const* function_name = __func__;
     return ListBackupsRange(
         std::move(request),
-        [stub, retry, backoff, idempotency, function_name]
+        [stub, retry, backoff, idempotency, budget, sleeper, function_name]
           (::google::test::admin::database::v1::ListBackupsRequest const& r) {
           return google::cloud::internal::RetryLoop(
               retry->clone(), backoff->clone(), idempotency,
@@ -433,7 +490,7 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
                      ::google::test::admin::database::v1::ListBackupsRequest const& request) {
                 return stub->ListBackups(context, request);
               },
-              r, function_name);
+              r, function_name, budget, sleeper);
         },
         [](::google::test::admin::database::v1::ListBackupsResponse r) {
           std::vector<::google::test::admin::database::v1::Backup> result(r.backups().size());
@@ -453,7 +510,7 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
                ::google::test::admin::database::v1::RestoreDatabaseRequest const& request) {
           return stub_->RestoreDatabase(context, request);
         },
-        request, __func__);
+        request, __func__, retry_budget_, backoff_sleeper_);
     if (!operation) {
       return google::cloud::make_ready_future(
           StatusOr<::google::test::admin::database::v1::Database>(operation.status()));
@@ -471,10 +528,12 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
     auto backoff = std::shared_ptr<BackoffPolicy const>(
         backoff_policy_prototype_->clone());
     auto idempotency = idempotency_policy_->ListDatabaseOperations(request);
+    auto budget = retry_budget_;
+    auto sleeper = backoff_sleeper_;
     char const* function_name = __func__;
     return ListDatabaseOperationsRange(
         std::move(request),
-        [stub, retry, backoff, idempotency, function_name]
+        [stub, retry, backoff, idempotency, budget, sleeper, function_name]
           (::google::test::admin::database::v1::ListDatabaseOperationsRequest const& r) {
           return google::cloud::internal::RetryLoop(
               retry->clone(), backoff->clone(), idempotency,
@@ -482,7 +541,7 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
                      ::google::test::admin::database::v1::ListDatabaseOperationsRequest const& request) {
                 return stub->ListDatabaseOperations(context, request);
               },
-              r, function_name);
+              r, function_name, budget, sleeper);
         },
         [](::google::test::admin::database::v1::ListDatabaseOperationsResponse r) {
           std::vector<::google::longrunning::Operation> result(r.operations().size());
@@ -501,10 +560,12 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
     auto backoff = std::shared_ptr<BackoffPolicy const>(
         backoff_policy_prototype_->clone());
     auto idempotency = idempotency_policy_->ListBackupOperations(request);
+    auto budget = retry_budget_;
+    auto sleeper = backoff_sleeper_;
     char const* function_name = __func__;
     return ListBackupOperationsRange(
         std::move(request),
-        [stub, retry, backoff, idempotency, function_name]
+        [stub, retry, backoff, idempotency, budget, sleeper, function_name]
           (::google::test::admin::database::v1::ListBackupOperationsRequest const& r) {
           return google::cloud::internal::RetryLoop(
               retry->clone(), backoff->clone(), idempotency,
@@ -512,7 +573,7 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
                      ::google::test::admin::database::v1::ListBackupOperationsRequest const& request) {
                 return stub->ListBackupOperations(context, request);
               },
-              r, function_name);
+              r, function_name, budget, sleeper);
         },
         [](::google::test::admin::database::v1::ListBackupOperationsResponse r) {
           std::vector<::google::longrunning::Operation> result(r.operations().size());
@@ -522,45 +583,88 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
         });
   }
 
+  StreamingReadStream StreamingRead(
+      ::google::test::admin::database::v1::StreamingReadRequest const& request) override {
+    auto stub = stub_;
+    auto factory = [stub](::google::test::admin::database::v1::StreamingReadRequest const& request) {
+      return stub->StreamingRead(
+          absl::make_unique<grpc::ClientContext>(), request);
+    };
+    std::shared_ptr<google::cloud::internal::StreamingReadRpc<
+        ::google::test::admin::database::v1::StreamingReadResponse>>
+        stream = google::cloud::internal::MakeResumableStreamingReadRpc<
+            ::google::test::admin::database::v1::StreamingReadResponse,
+            ::google::test::admin::database::v1::StreamingReadRequest>(
+            retry_policy_prototype_->clone(),
+            backoff_policy_prototype_->clone(), std::move(factory),
+            DatabaseAdminStreamingReadStreamingUpdater, request);
+    return google::cloud::internal::MakeStreamRange<::google::test::admin::database::v1::StreamingReadResponse>(
+        [stream] { return stream->Read(); });
+  }
+
+  std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<
+      ::google::test::admin::database::v1::StreamingReadWriteRequest,
+      ::google::test::admin::database::v1::StreamingReadWriteResponse>>
+  AsyncStreamingReadWrite() override {
+    auto cq = background_threads_->cq();
+    return stub_->AsyncStreamingReadWrite(
+        cq, absl::make_unique<grpc::ClientContext>());
+  }
+
+  future<StatusOr<::google::test::admin::database::v1::Database>>
+  AsyncGetDatabase(
+      ::google::test::admin::database::v1::GetDatabaseRequest const& request) override {
+    auto stub = stub_;
+    return google::cloud::internal::AsyncRetryLoop(
+        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
+        idempotency_policy_->GetDatabase(request),
+        background_threads_->cq(),
+        [stub](CompletionQueue& cq,
+               std::unique_ptr<grpc::ClientContext> context,
+               ::google::test::admin::database::v1::GetDatabaseRequest const& request) {
+          return stub->AsyncGetDatabase(cq, std::move(context), request);
+        },
+        request, __func__, retry_budget_);
+  }
+
+  future<Status>
+  AsyncDropDatabase(
+      ::google::test::admin::database::v1::DropDatabaseRequest const& request) override {
+    auto stub = stub_;
+    return google::cloud::internal::AsyncRetryLoop(
+        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),
+        idempotency_policy_->DropDatabase(request),
+        background_threads_->cq(),
+        [stub](CompletionQueue& cq,
+               std::unique_ptr<grpc::ClientContext> context,
+               ::google::test::admin::database::v1::DropDatabaseRequest const& request) {
+          return stub->AsyncDropDatabase(cq, std::move(context), request);
+        },
+        request, __func__, retry_budget_);
+  }
+
  private:
   template <typename MethodResponse, template<typename> class Extractor,
     typename Stub>
   future<StatusOr<MethodResponse>>
   AwaitLongrunningOperation(google::longrunning::Operation operation) {  // NOLINT
-    using ResponseExtractor = Extractor<MethodResponse>;
-    std::weak_ptr<Stub> cancel_stub(stub_);
-    promise<typename ResponseExtractor::ReturnType> pr(
-        [cancel_stub, operation]() {
-          grpc::ClientContext context;
-          context.set_deadline(std::chrono::system_clock::now() +
+    std::shared_ptr<Stub> stub = stub_;
+    return google::cloud::internal::AsyncAwaitLongRunningOperation<
+        Extractor<MethodResponse>>(
+        background_threads_->cq(), std::move(operation),
+        [stub](google::cloud::CompletionQueue& cq,
+               std::unique_ptr<grpc::ClientContext> context,
+               google::longrunning::GetOperationRequest const& request) {
+          return stub->AsyncGetOperation(cq, std::move(context), request);
+        },
+        [stub](google::cloud::CompletionQueue& cq,
+               std::unique_ptr<grpc::ClientContext> context,
+               google::longrunning::CancelOperationRequest const& request) {
+          context->set_deadline(std::chrono::system_clock::now() +
             std::chrono::seconds(60));
-          google::longrunning::CancelOperationRequest request;
-          request.set_name(operation.name());
-          if (auto ptr = cancel_stub.lock()) {
-            ptr->CancelOperation(context, request);
-          }
-    });
-    auto f = pr.get_future();
-    std::thread t(
-        [](std::shared_ptr<Stub> stub,
-           google::longrunning::Operation operation,
-           std::unique_ptr<PollingPolicy> polling_policy,
-           google::cloud::promise<typename ResponseExtractor::ReturnType> promise,
-           char const* location) mutable {
-          auto result = google::cloud::internal::PollingLoop<ResponseExtractor>(
-              std::move(polling_policy),
-              [stub](grpc::ClientContext& context,
-                     google::longrunning::GetOperationRequest const& request) {
-                return stub->GetOperation(context, request);
-              },
-              std::move(operation), location);
-          stub.reset();
-          promise.set_value(std::move(result));
+          return stub->AsyncCancelOperation(cq, std::move(context), request);
         },
-        stub_, std::move(operation), polling_policy_prototype_->clone(),
-        std::move(pr), __func__);
-    t.detach();
-    return f;
+        polling_policy_prototype_->clone(), __func__, &polling_loops_);
   }
 
   future<StatusOr<::google::test::admin::database::v1::Database>>
@@ -600,17 +704,23 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
   }
 
   std::shared_ptr<golden_internal::DatabaseAdminStub> stub_;
+  std::unique_ptr<BackgroundThreads> background_threads_;
   std::unique_ptr<RetryPolicy const> retry_policy_prototype_;
   std::unique_ptr<BackoffPolicy const> backoff_policy_prototype_;
   std::unique_ptr<PollingPolicy const> polling_policy_prototype_;
   std::unique_ptr<DatabaseAdminConnectionIdempotencyPolicy> idempotency_policy_;
+  std::shared_ptr<RetryBudget> retry_budget_;
+  BackoffSleeper backoff_sleeper_;
+  google::cloud::internal::AsyncPollingLoopGroup polling_loops_;
 };
 }  // namespace
 
 std::shared_ptr<DatabaseAdminConnection> MakeDatabaseAdminConnection(
     ConnectionOptions const& options) {
   return std::make_shared<DatabaseAdminConnectionImpl>(
-      golden_internal::CreateDefaultDatabaseAdminStub(options));
+      golden_internal::CreateDefaultDatabaseAdminStub(options),
+      options.background_threads_factory()(), options.retry_budget(),
+      options.backoff_sleeper());
 }
 
 std::shared_ptr<DatabaseAdminConnection> MakeDatabaseAdminConnection(
@@ -620,8 +730,10 @@ std::shared_ptr<DatabaseAdminConnection> MakeDatabaseAdminConnection(
     std::unique_ptr<DatabaseAdminConnectionIdempotencyPolicy> idempotency_policy) {
   return std::make_shared<DatabaseAdminConnectionImpl>(
       golden_internal::CreateDefaultDatabaseAdminStub(options),
+      options.background_threads_factory()(),
       std::move(retry_policy), std::move(backoff_policy),
-      std::move(polling_policy), std::move(idempotency_policy));
+      std::move(polling_policy), std::move(idempotency_policy),
+      options.retry_budget(), options.backoff_sleeper());
 }
 
 std::shared_ptr<DatabaseAdminConnection> MakeDatabaseAdminConnection(
@@ -631,7 +743,8 @@ std::shared_ptr<DatabaseAdminConnection> MakeDatabaseAdminConnection(
     std::unique_ptr<PollingPolicy> polling_policy,
     std::unique_ptr<DatabaseAdminConnectionIdempotencyPolicy> idempotency_policy) {
   return std::make_shared<DatabaseAdminConnectionImpl>(
-      std::move(stub), std::move(retry_policy), std::move(backoff_policy),
+      std::move(stub), google::cloud::internal::DefaultBackgroundThreads(1),
+      std::move(retry_policy), std::move(backoff_policy),
       std::move(polling_policy), std::move(idempotency_policy));
 }
 
@@ -24,7 +24,9 @@
 #include "generator/integration_tests/golden/retry_policy.gcpcxx.pb.h"
 #include "google/cloud/backoff_policy.h"
 #include "google/cloud/future.h"
+#include "google/cloud/internal/async_read_write_stream_impl.h"
 #include "google/cloud/internal/pagination_range.h"
+#include "google/cloud/internal/stream_range.h"
 #include "google/cloud/polling_policy.h"
 #include "google/cloud/status_or.h"
 #include "google/cloud/version.h"
@@ -56,6 +58,14 @@ using ListBackupOperationsRange = google::cloud::internal::PaginationRange<
     ::google::test::admin::database::v1::ListBackupOperationsRequest,
     ::google::test::admin::database::v1::ListBackupOperationsResponse>;
 
+using StreamingReadStream = google::cloud::internal::StreamRange<
+    ::google::test::admin::database::v1::StreamingReadResponse>;
+
+/// Update @p request to resume `StreamingRead()` after @p response.
+void DatabaseAdminStreamingReadStreamingUpdater(
+    ::google::test::admin::database::v1::StreamingReadResponse const& response,
+    ::google::test::admin::database::v1::StreamingReadRequest& request);
+
 class DatabaseAdminConnection {
  public:
   virtual ~DatabaseAdminConnection() = 0;
@@ -111,6 +121,20 @@ class DatabaseAdminConnection {
   virtual ListBackupOperationsRange
   ListBackupOperations(::google::test::admin::database::v1::ListBackupOperationsRequest request);
 
+  virtual StreamingReadStream
+  StreamingRead(::google::test::admin::database::v1::StreamingReadRequest const& request);
+
+  virtual std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<
+      ::google::test::admin::database::v1::StreamingReadWriteRequest,
+      ::google::test::admin::database::v1::StreamingReadWriteResponse>>
+  AsyncStreamingReadWrite();
+
+  virtual future<StatusOr<::google::test::admin::database::v1::Database>>
+  AsyncGetDatabase(::google::test::admin::database::v1::GetDatabaseRequest const& request);
+
+  virtual future<Status>
+  AsyncDropDatabase(::google::test::admin::database::v1::DropDatabaseRequest const& request);
+
 };
 
 std::shared_ptr<DatabaseAdminConnection> MakeDatabaseAdminConnection(
@@ -17,6 +17,7 @@
 #include "google/cloud/polling_policy.h"
 #include "google/cloud/testing_util/assert_ok.h"
 #include "google/cloud/testing_util/is_proto_equal.h"
+#include "absl/memory/memory.h"
 #include <gmock/gmock.h>
 #include <google/protobuf/text_format.h>
 #include <memory>
@@ -133,6 +134,34 @@ public:
        ::google::test::admin::database::v1::ListBackupOperationsRequest const
            &request),
       (override));
+  MOCK_METHOD(std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+                  ::google::test::admin::database::v1::StreamingReadResponse>>,
+              StreamingRead,
+              (std::unique_ptr<grpc::ClientContext> context,
+               ::google::test::admin::database::v1::StreamingReadRequest const
+                   &request),
+              (override));
+  MOCK_METHOD(
+      (std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<
+           ::google::test::admin::database::v1::StreamingReadWriteRequest,
+           ::google::test::admin::database::v1::StreamingReadWriteResponse>>),
+      AsyncStreamingReadWrite,
+      (google::cloud::CompletionQueue & cq,
+       std::unique_ptr<grpc::ClientContext> context),
+      (override));
+  MOCK_METHOD(
+      future<StatusOr<::google::test::admin::database::v1::Database>>,
+      AsyncGetDatabase,
+      (google::cloud::CompletionQueue & cq,
+       std::unique_ptr<grpc::ClientContext> context,
+       ::google::test::admin::database::v1::GetDatabaseRequest const &request),
+      (override));
+  MOCK_METHOD(
+      future<Status>, AsyncDropDatabase,
+      (google::cloud::CompletionQueue & cq,
+       std::unique_ptr<grpc::ClientContext> context,
+       ::google::test::admin::database::v1::DropDatabaseRequest const &request),
+      (override));
   /// Poll a long-running operation.
   MOCK_METHOD(StatusOr<google::longrunning::Operation>, GetOperation,
               (grpc::ClientContext & client_context,
@@ -143,6 +172,31 @@ public:
               (grpc::ClientContext & client_context,
                google::longrunning::CancelOperationRequest const &request),
               (override));
+  /// Poll a long-running operation asynchronously.
+  MOCK_METHOD(future<StatusOr<google::longrunning::Operation>>,
+              AsyncGetOperation,
+              (google::cloud::CompletionQueue & cq,
+               std::unique_ptr<grpc::ClientContext> client_context,
+               google::longrunning::GetOperationRequest const &request),
+              (override));
+  /// Cancel a long-running operation asynchronously.
+  MOCK_METHOD(future<Status>, AsyncCancelOperation,
+              (google::cloud::CompletionQueue & cq,
+               std::unique_ptr<grpc::ClientContext> client_context,
+               google::longrunning::CancelOperationRequest const &request),
+              (override));
+};
+
+class MockStreamingReadRpc
+    : public google::cloud::internal::StreamingReadRpc<
+          ::google::test::admin::database::v1::StreamingReadResponse> {
+public:
+  ~MockStreamingReadRpc() override = default;
+  MOCK_METHOD(void, Cancel, (), (override));
+  MOCK_METHOD((absl::variant<
+                  Status,
+                  ::google::test::admin::database::v1::StreamingReadResponse>),
+              Read, (), (override));
 };
 
 std::shared_ptr<golden::DatabaseAdminConnection> CreateTestingConnection(
@@ -262,8 +316,9 @@ TEST(GoldenConnectionTest, CreateDatabaseSuccess) {
             op.set_done(false);
             return make_status_or(op);
           });
-  EXPECT_CALL(*mock, GetOperation)
-      .WillOnce([](grpc::ClientContext &,
+  EXPECT_CALL(*mock, AsyncGetOperation)
+      .WillOnce([](google::cloud::CompletionQueue &,
+                   std::unique_ptr<grpc::ClientContext>,
                    google::longrunning::GetOperationRequest const &r) {
         EXPECT_EQ("test-operation-name", r.name());
         google::longrunning::Operation op;
@@ -272,7 +327,7 @@ TEST(GoldenConnectionTest, CreateDatabaseSuccess) {
         ::google::test::admin::database::v1::Database database;
         database.set_name("test-database");
         op.mutable_response()->PackFrom(database);
-        return make_status_or(op);
+        return make_ready_future(make_status_or(op));
       });
   auto conn = CreateTestingConnection(std::move(mock));
   ::google::test::admin::database::v1::CreateDatabaseRequest dbase;
@@ -303,6 +358,49 @@ TEST(GoldenConnectionTest, HandleCreateDatabaseError) {
   EXPECT_EQ(StatusCode::kPermissionDenied, db.status().code());
 }
 
+/// @test Verify that destroying the connection stops polling operations.
+TEST(GoldenConnectionTest, CreateDatabaseDestroyConnectionWhilePolling) {
+  auto mock = std::make_shared<MockGoldenStub>();
+  EXPECT_CALL(*mock, CreateDatabase)
+      .WillOnce(
+          [](grpc::ClientContext &,
+             ::google::test::admin::database::v1::CreateDatabaseRequest const
+                 &) {
+            google::longrunning::Operation op;
+            op.set_name("test-operation-name");
+            op.set_done(false);
+            return make_status_or(op);
+          });
+  EXPECT_CALL(*mock, AsyncGetOperation).Times(0);
+  EXPECT_CALL(*mock, AsyncCancelOperation).Times(0);
+
+  // Wait much longer than any test should take before polling.
+  golden::LimitedErrorCountRetryPolicy retry(/*maximum_failures=*/2);
+  ExponentialBackoffPolicy backoff(
+      /*initial_delay=*/std::chrono::microseconds(1),
+      /*maximum_delay=*/std::chrono::microseconds(1),
+      /*scaling=*/2.0);
+  GenericPollingPolicy<golden::LimitedErrorCountRetryPolicy,
+                       ExponentialBackoffPolicy>
+      polling(retry, ExponentialBackoffPolicy(
+                         /*initial_delay=*/std::chrono::minutes(5),
+                         /*maximum_delay=*/std::chrono::minutes(5),
+                         /*scaling=*/2.0));
+  auto conn = golden::MakeDatabaseAdminConnection(
+      mock, retry.clone(), backoff.clone(), polling.clone(),
+      golden::MakeDefaultDatabaseAdminConnectionIdempotencyPolicy());
+  ::google::test::admin::database::v1::CreateDatabaseRequest dbase;
+  auto fut = conn->CreateDatabase(dbase);
+  EXPECT_EQ(std::future_status::timeout,
+            fut.wait_for(std::chrono::milliseconds(10)));
+
+  // This would block until the next poll if the timer was not cancelled.
+  conn.reset();
+  ASSERT_EQ(std::future_status::ready, fut.wait_for(std::chrono::seconds(0)));
+  auto db = fut.get();
+  EXPECT_EQ(StatusCode::kCancelled, db.status().code());
+}
+
 /// @test Verify that errors in the polling loop are reported.
 TEST(DatabaseAdminClientTest, CreateDatabaseErrorInPoll) {
   auto mock = std::make_shared<MockGoldenStub>();
@@ -316,8 +414,9 @@ TEST(DatabaseAdminClientTest, CreateDatabaseErrorInPoll) {
             op.set_done(false);
             return make_status_or(std::move(op));
           });
-  EXPECT_CALL(*mock, GetOperation)
-      .WillOnce([](grpc::ClientContext &,
+  EXPECT_CALL(*mock, AsyncGetOperation)
+      .WillOnce([](google::cloud::CompletionQueue &,
+                   std::unique_ptr<grpc::ClientContext>,
                    google::longrunning::GetOperationRequest const &r) {
         EXPECT_EQ("test-operation-name", r.name());
         google::longrunning::Operation op;
@@ -325,7 +424,7 @@ TEST(DatabaseAdminClientTest, CreateDatabaseErrorInPoll) {
         op.mutable_error()->set_code(
             static_cast<int>(grpc::StatusCode::PERMISSION_DENIED));
         op.mutable_error()->set_message("uh-oh");
-        return op;
+        return make_ready_future(make_status_or(op));
       });
   auto conn = CreateTestingConnection(std::move(mock));
   ::google::test::admin::database::v1::CreateDatabaseRequest dbase;
@@ -390,6 +489,56 @@ TEST(DatabaseAdminClientTest, GetDatabaseTooManyTransients) {
   EXPECT_EQ(StatusCode::kUnavailable, response.status().code());
 }
 
+/// @test Verify that the asynchronous version retries transient errors.
+TEST(DatabaseAdminClientTest, AsyncGetDatabaseSuccess) {
+  auto mock = std::make_shared<MockGoldenStub>();
+  std::string const expected_name =
+      "projects/test-project/instances/test-instance/databases/test-database";
+  EXPECT_CALL(*mock, AsyncGetDatabase)
+      .WillOnce([](google::cloud::CompletionQueue &,
+                   std::unique_ptr<grpc::ClientContext>,
+                   ::google::test::admin::database::v1::GetDatabaseRequest const
+                       &) {
+        return make_ready_future(
+            StatusOr<::google::test::admin::database::v1::Database>(
+                Status(StatusCode::kUnavailable, "try-again")));
+      })
+      .WillOnce([&expected_name](
+                    google::cloud::CompletionQueue &,
+                    std::unique_ptr<grpc::ClientContext>,
+                    ::google::test::admin::database::v1::GetDatabaseRequest const
+                        &request) {
+        EXPECT_EQ(expected_name, request.name());
+        ::google::test::admin::database::v1::Database response;
+        response.set_name(request.name());
+        return make_ready_future(make_status_or(response));
+      });
+  auto conn = CreateTestingConnection(std::move(mock));
+  ::google::test::admin::database::v1::GetDatabaseRequest request;
+  request.set_name(expected_name);
+  auto response = conn->AsyncGetDatabase(request).get();
+  ASSERT_STATUS_OK(response);
+  EXPECT_EQ(expected_name, response->name());
+}
+
+/// @test Verify that the asynchronous version stops on permanent errors.
+TEST(DatabaseAdminClientTest, AsyncGetDatabasePermanentError) {
+  auto mock = std::make_shared<MockGoldenStub>();
+  EXPECT_CALL(*mock, AsyncGetDatabase)
+      .WillOnce([](google::cloud::CompletionQueue &,
+                   std::unique_ptr<grpc::ClientContext>,
+                   ::google::test::admin::database::v1::GetDatabaseRequest const
+                       &) {
+        return make_ready_future(
+            StatusOr<::google::test::admin::database::v1::Database>(
+                Status(StatusCode::kPermissionDenied, "uh-oh")));
+      });
+  auto conn = CreateTestingConnection(std::move(mock));
+  ::google::test::admin::database::v1::GetDatabaseRequest request;
+  auto response = conn->AsyncGetDatabase(request).get();
+  EXPECT_EQ(StatusCode::kPermissionDenied, response.status().code());
+}
+
 /// @test Verify that successful case works.
 TEST(DatabaseAdminClientTest, UpdateDatabaseDdlSuccess) {
   auto mock = std::make_shared<MockGoldenStub>();
@@ -406,8 +555,9 @@ TEST(DatabaseAdminClientTest, UpdateDatabaseDdlSuccess) {
             op.set_done(false);
             return make_status_or(op);
           });
-  EXPECT_CALL(*mock, GetOperation)
-      .WillOnce([](grpc::ClientContext &,
+  EXPECT_CALL(*mock, AsyncGetOperation)
+      .WillOnce([](google::cloud::CompletionQueue &,
+                   std::unique_ptr<grpc::ClientContext>,
                    google::longrunning::GetOperationRequest const &r) {
         EXPECT_EQ("test-operation-name", r.name());
         google::longrunning::Operation op;
@@ -416,7 +566,7 @@ TEST(DatabaseAdminClientTest, UpdateDatabaseDdlSuccess) {
         ::google::test::admin::database::v1::UpdateDatabaseDdlMetadata metadata;
         metadata.set_database("test-database");
         op.mutable_metadata()->PackFrom(metadata);
-        return make_status_or(op);
+        return make_ready_future(make_status_or(op));
       });
   auto conn = CreateTestingConnection(std::move(mock));
   ::google::test::admin::database::v1::UpdateDatabaseDdlRequest request;
@@ -468,8 +618,9 @@ TEST(DatabaseAdminClientTest, UpdateDatabaseDdlGetOperationError) {
             op.set_done(false);
             return make_status_or(std::move(op));
           });
-  EXPECT_CALL(*mock, GetOperation)
-      .WillOnce([](grpc::ClientContext &,
+  EXPECT_CALL(*mock, AsyncGetOperation)
+      .WillOnce([](google::cloud::CompletionQueue &,
+                   std::unique_ptr<grpc::ClientContext>,
                    google::longrunning::GetOperationRequest const &r) {
         EXPECT_EQ("test-operation-name", r.name());
         google::longrunning::Operation op;
@@ -477,7 +628,7 @@ TEST(DatabaseAdminClientTest, UpdateDatabaseDdlGetOperationError) {
         op.mutable_error()->set_code(
             static_cast<int>(grpc::StatusCode::PERMISSION_DENIED));
         op.mutable_error()->set_message("uh-oh");
-        return op;
+        return make_ready_future(make_status_or(op));
       });
   auto conn = CreateTestingConnection(std::move(mock));
   ::google::test::admin::database::v1::UpdateDatabaseDdlRequest request;
@@ -525,6 +676,24 @@ TEST(DatabaseAdminClientTest, DropDatabasePermanentError) {
   EXPECT_EQ(StatusCode::kPermissionDenied, response.code());
 }
 
+/// @test Verify the asynchronous version of a RPC returning `Empty`.
+TEST(DatabaseAdminClientTest, AsyncDropDatabaseSuccess) {
+  auto mock = std::make_shared<MockGoldenStub>();
+  EXPECT_CALL(*mock, AsyncDropDatabase)
+      .WillOnce([](google::cloud::CompletionQueue &,
+                   std::unique_ptr<grpc::ClientContext>,
+                   ::google::test::admin::database::v1::DropDatabaseRequest const
+                       &request) {
+        EXPECT_EQ("test-database", request.database());
+        return make_ready_future(Status());
+      });
+  auto conn = CreateTestingConnection(std::move(mock));
+  ::google::test::admin::database::v1::DropDatabaseRequest request;
+  request.set_database("test-database");
+  auto status = conn->AsyncDropDatabase(request).get();
+  EXPECT_STATUS_OK(status);
+}
+
 /// @test Verify that the successful case works.
 TEST(DatabaseAdminClientTest, GetDatabaseDdlSuccess) {
   auto mock = std::make_shared<MockGoldenStub>();
@@ -767,8 +936,9 @@ TEST(DatabaseAdminClientTest, CreateBackupSuccess) {
             op.set_done(false);
             return make_status_or(op);
           });
-  EXPECT_CALL(*mock, GetOperation)
-      .WillOnce([](grpc::ClientContext &,
+  EXPECT_CALL(*mock, AsyncGetOperation)
+      .WillOnce([](google::cloud::CompletionQueue &,
+                   std::unique_ptr<grpc::ClientContext>,
                    google::longrunning::GetOperationRequest const &r) {
         EXPECT_EQ("test-operation-name", r.name());
         google::longrunning::Operation op;
@@ -777,7 +947,7 @@ TEST(DatabaseAdminClientTest, CreateBackupSuccess) {
         ::google::test::admin::database::v1::Backup backup;
         backup.set_name("test-backup");
         op.mutable_response()->PackFrom(backup);
-        return make_status_or(op);
+        return make_ready_future(make_status_or(op));
       });
   auto conn = CreateTestingConnection(std::move(mock));
   ::google::test::admin::database::v1::CreateBackupRequest request;
@@ -794,10 +964,6 @@ TEST(DatabaseAdminClientTest, CreateBackupSuccess) {
 /// @test Verify cancellation.
 TEST(DatabaseAdminClientTest, CreateBackupCancel) {
   auto mock = std::make_shared<MockGoldenStub>();
-  // Suppress a false leak.
-  // TODO(#4038): After we fix the issue #4038, we won't need to use
-  // `AllowLeak()` any more.
-  Mock::AllowLeak(mock.get());
   promise<void> p;
   EXPECT_CALL(*mock, CreateBackup)
       .WillOnce(
@@ -808,24 +974,27 @@ TEST(DatabaseAdminClientTest, CreateBackupCancel) {
             op.set_done(false);
             return make_status_or(op);
           });
-  EXPECT_CALL(*mock, CancelOperation)
-      .WillOnce([](grpc::ClientContext &,
+  EXPECT_CALL(*mock, AsyncCancelOperation)
+      .WillOnce([](google::cloud::CompletionQueue &,
+                   std::unique_ptr<grpc::ClientContext>,
                    google::longrunning::CancelOperationRequest const &r) {
         EXPECT_EQ("test-operation-name", r.name());
-        return google::cloud::Status();
+        return make_ready_future(google::cloud::Status());
       });
-  EXPECT_CALL(*mock, GetOperation)
-      .WillOnce([&p](grpc::ClientContext &,
+  EXPECT_CALL(*mock, AsyncGetOperation)
+      .WillOnce([&p](google::cloud::CompletionQueue &,
+                     std::unique_ptr<grpc::ClientContext>,
                      google::longrunning::GetOperationRequest const &r) {
         EXPECT_EQ("test-operation-name", r.name());
         google::longrunning::Operation op;
         op.set_name(r.name());
         op.set_done(false);
-        // wait for `cancel` call in the main thread.
-        p.get_future().get();
-        return make_status_or(op);
+        // Complete only after the `cancel` call in the main thread.
+        return p.get_future().then(
+            [op](future<void>) { return make_status_or(op); });
       })
-      .WillOnce([](grpc::ClientContext &,
+      .WillOnce([](google::cloud::CompletionQueue &,
+                   std::unique_ptr<grpc::ClientContext>,
                    google::longrunning::GetOperationRequest const &r) {
         EXPECT_EQ("test-operation-name", r.name());
         google::longrunning::Operation op;
@@ -834,7 +1003,7 @@ TEST(DatabaseAdminClientTest, CreateBackupCancel) {
         ::google::test::admin::database::v1::Backup backup;
         backup.set_name("test-backup");
         op.mutable_response()->PackFrom(backup);
-        return make_status_or(op);
+        return make_ready_future(make_status_or(op));
       });
   auto conn = CreateTestingConnection(std::move(mock));
   ::google::test::admin::database::v1::CreateBackupRequest request;
@@ -1118,8 +1287,9 @@ TEST(DatabaseAdminClientTest, RestoreDatabaseSuccess) {
             op.set_done(false);
             return make_status_or(op);
           });
-  EXPECT_CALL(*mock, GetOperation)
-      .WillOnce([](grpc::ClientContext &,
+  EXPECT_CALL(*mock, AsyncGetOperation)
+      .WillOnce([](google::cloud::CompletionQueue &,
+                   std::unique_ptr<grpc::ClientContext>,
                    google::longrunning::GetOperationRequest const &r) {
         EXPECT_EQ("test-operation-name", r.name());
         google::longrunning::Operation op;
@@ -1128,7 +1298,7 @@ TEST(DatabaseAdminClientTest, RestoreDatabaseSuccess) {
         ::google::test::admin::database::v1::Database database;
         database.set_name("test-database");
         op.mutable_response()->PackFrom(database);
-        return make_status_or(op);
+        return make_ready_future(make_status_or(op));
       });
   auto conn = CreateTestingConnection(std::move(mock));
   ::google::test::admin::database::v1::RestoreDatabaseRequest request;
@@ -1336,6 +1506,69 @@ TEST(DatabaseAdminClientTest, ListBackupOperationsTooManyFailures) {
   EXPECT_EQ(StatusCode::kUnavailable, begin->status().code());
 }
 
+/// @test Verify that streaming reads resume from the last response received.
+TEST(DatabaseAdminClientTest, StreamingReadResume) {
+  using ::google::test::admin::database::v1::StreamingReadRequest;
+  using ::google::test::admin::database::v1::StreamingReadResponse;
+  auto make_response = [](std::string const &statement,
+                          std::string const &token) {
+    StreamingReadResponse response;
+    response.set_statement(statement);
+    response.set_resume_token(token);
+    return response;
+  };
+  auto mock = std::make_shared<MockGoldenStub>();
+  EXPECT_CALL(*mock, StreamingRead)
+      .WillOnce([&](std::unique_ptr<grpc::ClientContext>,
+                    StreamingReadRequest const &request) {
+        EXPECT_TRUE(request.resume_token().empty());
+        auto stream = absl::make_unique<MockStreamingReadRpc>();
+        EXPECT_CALL(*stream, Read)
+            .WillOnce(Return(make_response("s1", "token-1")))
+            .WillOnce(Return(Status(StatusCode::kUnavailable, "try-again")));
+        return stream;
+      })
+      .WillOnce([&](std::unique_ptr<grpc::ClientContext>,
+                    StreamingReadRequest const &request) {
+        EXPECT_EQ("token-1", request.resume_token());
+        auto stream = absl::make_unique<MockStreamingReadRpc>();
+        EXPECT_CALL(*stream, Read)
+            .WillOnce(Return(make_response("s2", "token-2")))
+            .WillOnce(Return(Status()));
+        return stream;
+      });
+  auto conn = CreateTestingConnection(std::move(mock));
+  StreamingReadRequest request;
+  request.set_database("test-database");
+  std::vector<std::string> actual;
+  for (auto const& response : conn->StreamingRead(request)) {
+    ASSERT_STATUS_OK(response);
+    actual.push_back(response->statement());
+  }
+  EXPECT_THAT(actual, ElementsAre("s1", "s2"));
+}
+
+/// @test Verify that permanent errors end the stream.
+TEST(DatabaseAdminClientTest, StreamingReadPermanentError) {
+  auto mock = std::make_shared<MockGoldenStub>();
+  EXPECT_CALL(*mock, StreamingRead)
+      .WillOnce([](std::unique_ptr<grpc::ClientContext>,
+                   ::google::test::admin::database::v1::StreamingReadRequest const
+                       &) {
+        auto stream = absl::make_unique<MockStreamingReadRpc>();
+        EXPECT_CALL(*stream, Read)
+            .WillOnce(Return(Status(StatusCode::kPermissionDenied, "uh-oh")));
+        return stream;
+      });
+  auto conn = CreateTestingConnection(std::move(mock));
+  ::google::test::admin::database::v1::StreamingReadRequest request;
+  auto range = conn->StreamingRead(request);
+  auto begin = range.begin();
+  ASSERT_NE(begin, range.end());
+  EXPECT_EQ(StatusCode::kPermissionDenied, begin->status().code());
+  EXPECT_EQ(++begin, range.end());
+}
+
 } // namespace
 } // namespace GOOGLE_CLOUD_CPP_NS
 } // namespace golden_internal
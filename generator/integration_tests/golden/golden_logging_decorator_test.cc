@@ -15,6 +15,7 @@
 #include "google/cloud/log.h"
 #include "google/cloud/testing_util/assert_ok.h"
 #include "google/cloud/testing_util/capture_log_lines_backend.h"
+#include "absl/memory/memory.h"
 #include <gmock/gmock.h>
 #include <memory>
 
@@ -146,6 +147,35 @@ class MockGoldenStub
            request),
       (override));
 
+  MOCK_METHOD(std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+                  ::google::test::admin::database::v1::StreamingReadResponse>>,
+              StreamingRead,
+              (std::unique_ptr<grpc::ClientContext> context,
+               ::google::test::admin::database::v1::StreamingReadRequest const&
+                   request),
+              (override));
+  MOCK_METHOD(
+      (std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<
+           ::google::test::admin::database::v1::StreamingReadWriteRequest,
+           ::google::test::admin::database::v1::StreamingReadWriteResponse>>),
+      AsyncStreamingReadWrite,
+      (google::cloud::CompletionQueue & cq,
+       std::unique_ptr<grpc::ClientContext> context),
+      (override));
+  MOCK_METHOD(
+      future<StatusOr<::google::test::admin::database::v1::Database>>,
+      AsyncGetDatabase,
+      (google::cloud::CompletionQueue & cq,
+       std::unique_ptr<grpc::ClientContext> context,
+       ::google::test::admin::database::v1::GetDatabaseRequest const& request),
+      (override));
+  MOCK_METHOD(
+      future<Status>, AsyncDropDatabase,
+      (google::cloud::CompletionQueue & cq,
+       std::unique_ptr<grpc::ClientContext> context,
+       ::google::test::admin::database::v1::DropDatabaseRequest const& request),
+      (override));
+
   /// Poll a long-running operation.
   MOCK_METHOD(StatusOr<google::longrunning::Operation>, GetOperation,
               (grpc::ClientContext & client_context,
@@ -157,6 +187,21 @@ class MockGoldenStub
               (grpc::ClientContext & client_context,
                google::longrunning::CancelOperationRequest const& request),
               (override));
+
+  /// Poll a long-running operation asynchronously.
+  MOCK_METHOD(future<StatusOr<google::longrunning::Operation>>,
+              AsyncGetOperation,
+              (google::cloud::CompletionQueue & cq,
+               std::unique_ptr<grpc::ClientContext> client_context,
+               google::longrunning::GetOperationRequest const& request),
+              (override));
+
+  /// Cancel a long-running operation asynchronously.
+  MOCK_METHOD(future<Status>, AsyncCancelOperation,
+              (google::cloud::CompletionQueue & cq,
+               std::unique_ptr<grpc::ClientContext> client_context,
+               google::longrunning::CancelOperationRequest const& request),
+              (override));
 };
 
 class LoggingDecoratorTest : public ::testing::Test {
@@ -446,6 +491,101 @@ TEST_F(LoggingDecoratorTest, ListBackupOperations) {
   EXPECT_THAT(log_lines, Contains(HasSubstr(TransientError().message())));
 }
 
+TEST_F(LoggingDecoratorTest, StreamingRead) {
+  EXPECT_CALL(*mock_, StreamingRead)
+      .WillOnce(
+          [](std::unique_ptr<grpc::ClientContext>,
+             google::test::admin::database::v1::StreamingReadRequest const&) {
+            return std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+                google::test::admin::database::v1::StreamingReadResponse>>{};
+          });
+
+  DatabaseAdminLogging stub(mock_, TracingOptions{});
+  google::test::admin::database::v1::StreamingReadRequest request;
+  request.set_database("test-database");
+  auto stream =
+      stub.StreamingRead(absl::make_unique<grpc::ClientContext>(), request);
+  EXPECT_EQ(stream, nullptr);
+
+  auto const log_lines = ClearLogLines();
+  EXPECT_THAT(log_lines, Contains(HasSubstr("StreamingRead")));
+  EXPECT_THAT(log_lines, Contains(HasSubstr("test-database")));
+  EXPECT_THAT(log_lines, Contains(HasSubstr("null stream")));
+}
+
+TEST_F(LoggingDecoratorTest, AsyncStreamingReadWrite) {
+  EXPECT_CALL(*mock_, AsyncStreamingReadWrite)
+      .WillOnce(
+          [](google::cloud::CompletionQueue&,
+             std::unique_ptr<grpc::ClientContext>) {
+            using ::google::test::admin::database::v1::
+                StreamingReadWriteRequest;
+            using ::google::test::admin::database::v1::
+                StreamingReadWriteResponse;
+            return std::unique_ptr<
+                google::cloud::internal::AsyncStreamingReadWriteRpc<
+                    StreamingReadWriteRequest, StreamingReadWriteResponse>>{};
+          });
+
+  DatabaseAdminLogging stub(mock_, TracingOptions{});
+  CompletionQueue cq;
+  auto stream = stub.AsyncStreamingReadWrite(
+      cq, absl::make_unique<grpc::ClientContext>());
+  EXPECT_EQ(stream, nullptr);
+
+  auto const log_lines = ClearLogLines();
+  EXPECT_THAT(log_lines, Contains(HasSubstr("AsyncStreamingReadWrite")));
+  EXPECT_THAT(log_lines, Contains(HasSubstr("null stream")));
+}
+
+TEST_F(LoggingDecoratorTest, AsyncGetDatabase) {
+  EXPECT_CALL(*mock_, AsyncGetDatabase)
+      .WillOnce(
+          [](google::cloud::CompletionQueue&,
+             std::unique_ptr<grpc::ClientContext>,
+             google::test::admin::database::v1::GetDatabaseRequest const&) {
+            return make_ready_future(
+                StatusOr<google::test::admin::database::v1::Database>(
+                    TransientError()));
+          });
+
+  DatabaseAdminLogging stub(mock_, TracingOptions{});
+  CompletionQueue cq;
+  auto status =
+      stub.AsyncGetDatabase(
+              cq, absl::make_unique<grpc::ClientContext>(),
+              google::test::admin::database::v1::GetDatabaseRequest())
+          .get();
+  EXPECT_EQ(TransientError(), status.status());
+
+  auto const log_lines = ClearLogLines();
+  EXPECT_THAT(log_lines, Contains(HasSubstr("AsyncGetDatabase")));
+  EXPECT_THAT(log_lines, Contains(HasSubstr(TransientError().message())));
+}
+
+TEST_F(LoggingDecoratorTest, AsyncDropDatabase) {
+  EXPECT_CALL(*mock_, AsyncDropDatabase)
+      .WillOnce(
+          [](google::cloud::CompletionQueue&,
+             std::unique_ptr<grpc::ClientContext>,
+             google::test::admin::database::v1::DropDatabaseRequest const&) {
+            return make_ready_future(TransientError());
+          });
+
+  DatabaseAdminLogging stub(mock_, TracingOptions{});
+  CompletionQueue cq;
+  auto status =
+      stub.AsyncDropDatabase(
+              cq, absl::make_unique<grpc::ClientContext>(),
+              google::test::admin::database::v1::DropDatabaseRequest())
+          .get();
+  EXPECT_EQ(TransientError(), status);
+
+  auto const log_lines = ClearLogLines();
+  EXPECT_THAT(log_lines, Contains(HasSubstr("AsyncDropDatabase")));
+  EXPECT_THAT(log_lines, Contains(HasSubstr(TransientError().message())));
+}
+
 TEST_F(LoggingDecoratorTest, GetOperation) {
   EXPECT_CALL(*mock_, GetOperation(_, _)).WillOnce(Return(TransientError()));
 
@@ -474,6 +614,47 @@ TEST_F(LoggingDecoratorTest, CancelOperation) {
   EXPECT_THAT(log_lines, Contains(HasSubstr(TransientError().message())));
 }
 
+TEST_F(LoggingDecoratorTest, AsyncGetOperation) {
+  EXPECT_CALL(*mock_, AsyncGetOperation(_, _, _))
+      .WillOnce([](google::cloud::CompletionQueue&,
+                   std::unique_ptr<grpc::ClientContext>,
+                   google::longrunning::GetOperationRequest const&) {
+        return make_ready_future(
+            StatusOr<google::longrunning::Operation>(TransientError()));
+      });
+
+  DatabaseAdminLogging stub(mock_, TracingOptions{});
+  google::cloud::CompletionQueue cq;
+  auto status =
+      stub.AsyncGetOperation(cq, absl::make_unique<grpc::ClientContext>(),
+                             google::longrunning::GetOperationRequest());
+  EXPECT_EQ(TransientError(), status.get().status());
+
+  auto const log_lines = ClearLogLines();
+  EXPECT_THAT(log_lines, Contains(HasSubstr("AsyncGetOperation")));
+  EXPECT_THAT(log_lines, Contains(HasSubstr(TransientError().message())));
+}
+
+TEST_F(LoggingDecoratorTest, AsyncCancelOperation) {
+  EXPECT_CALL(*mock_, AsyncCancelOperation(_, _, _))
+      .WillOnce([](google::cloud::CompletionQueue&,
+                   std::unique_ptr<grpc::ClientContext>,
+                   google::longrunning::CancelOperationRequest const&) {
+        return make_ready_future(TransientError());
+      });
+
+  DatabaseAdminLogging stub(mock_, TracingOptions{});
+  google::cloud::CompletionQueue cq;
+  auto status =
+      stub.AsyncCancelOperation(cq, absl::make_unique<grpc::ClientContext>(),
+                                google::longrunning::CancelOperationRequest());
+  EXPECT_EQ(TransientError(), status.get());
+
+  auto const log_lines = ClearLogLines();
+  EXPECT_THAT(log_lines, Contains(HasSubstr("AsyncCancelOperation")));
+  EXPECT_THAT(log_lines, Contains(HasSubstr(TransientError().message())));
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace golden_internal
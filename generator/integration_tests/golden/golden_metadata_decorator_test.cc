@@ -15,6 +15,7 @@
 #include "google/cloud/internal/api_client_header.h"
 #include "google/cloud/testing_util/assert_ok.h"
 #include "google/cloud/testing_util/validate_metadata.h"
+#include "absl/memory/memory.h"
 #include <gmock/gmock.h>
 #include <memory>
 
@@ -147,6 +148,35 @@ class MockGoldenStub
            request),
       (override));
 
+  MOCK_METHOD(std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+                  ::google::test::admin::database::v1::StreamingReadResponse>>,
+              StreamingRead,
+              (std::unique_ptr<grpc::ClientContext> context,
+               ::google::test::admin::database::v1::StreamingReadRequest const&
+                   request),
+              (override));
+  MOCK_METHOD(
+      (std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<
+           ::google::test::admin::database::v1::StreamingReadWriteRequest,
+           ::google::test::admin::database::v1::StreamingReadWriteResponse>>),
+      AsyncStreamingReadWrite,
+      (google::cloud::CompletionQueue & cq,
+       std::unique_ptr<grpc::ClientContext> context),
+      (override));
+  MOCK_METHOD(
+      future<StatusOr<::google::test::admin::database::v1::Database>>,
+      AsyncGetDatabase,
+      (google::cloud::CompletionQueue & cq,
+       std::unique_ptr<grpc::ClientContext> context,
+       ::google::test::admin::database::v1::GetDatabaseRequest const& request),
+      (override));
+  MOCK_METHOD(
+      future<Status>, AsyncDropDatabase,
+      (google::cloud::CompletionQueue & cq,
+       std::unique_ptr<grpc::ClientContext> context,
+       ::google::test::admin::database::v1::DropDatabaseRequest const& request),
+      (override));
+
   /// Poll a long-running operation.
   MOCK_METHOD(StatusOr<google::longrunning::Operation>, GetOperation,
               (grpc::ClientContext & client_context,
@@ -158,6 +188,21 @@ class MockGoldenStub
               (grpc::ClientContext & client_context,
                google::longrunning::CancelOperationRequest const& request),
               (override));
+
+  /// Poll a long-running operation asynchronously.
+  MOCK_METHOD(future<StatusOr<google::longrunning::Operation>>,
+              AsyncGetOperation,
+              (google::cloud::CompletionQueue & cq,
+               std::unique_ptr<grpc::ClientContext> client_context,
+               google::longrunning::GetOperationRequest const& request),
+              (override));
+
+  /// Cancel a long-running operation asynchronously.
+  MOCK_METHOD(future<Status>, AsyncCancelOperation,
+              (google::cloud::CompletionQueue & cq,
+               std::unique_ptr<grpc::ClientContext> client_context,
+               google::longrunning::CancelOperationRequest const& request),
+              (override));
 };
 
 class MetadataDecoratorTest : public ::testing::Test {
@@ -528,6 +573,82 @@ TEST_F(MetadataDecoratorTest, ListBackupOperations) {
   EXPECT_EQ(TransientError(), status.status());
 }
 
+TEST_F(MetadataDecoratorTest, StreamingRead) {
+  EXPECT_CALL(*mock_, StreamingRead)
+      .WillOnce(
+          [this](
+              std::unique_ptr<grpc::ClientContext> context,
+              google::test::admin::database::v1::StreamingReadRequest const&) {
+            EXPECT_STATUS_OK(IsContextMDValid(
+                *context,
+                "google.test.admin.database.v1.DatabaseAdmin.StreamingRead",
+                expected_api_client_header_));
+            return std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+                google::test::admin::database::v1::StreamingReadResponse>>{};
+          });
+
+  DatabaseAdminMetadata stub(mock_);
+  google::test::admin::database::v1::StreamingReadRequest request;
+  request.set_database(
+      "projects/my_project/instances/my_instance/databases/my_database");
+  auto stream =
+      stub.StreamingRead(absl::make_unique<grpc::ClientContext>(), request);
+  EXPECT_EQ(stream, nullptr);
+}
+
+TEST_F(MetadataDecoratorTest, AsyncGetDatabase) {
+  EXPECT_CALL(*mock_, AsyncGetDatabase)
+      .WillOnce(
+          [this](google::cloud::CompletionQueue&,
+                 std::unique_ptr<grpc::ClientContext> context,
+                 google::test::admin::database::v1::GetDatabaseRequest const&) {
+            EXPECT_STATUS_OK(IsContextMDValid(
+                *context,
+                "google.test.admin.database.v1.DatabaseAdmin.GetDatabase",
+                expected_api_client_header_));
+            return make_ready_future(
+                StatusOr<google::test::admin::database::v1::Database>(
+                    TransientError()));
+          });
+
+  DatabaseAdminMetadata stub(mock_);
+  CompletionQueue cq;
+  google::test::admin::database::v1::GetDatabaseRequest request;
+  request.set_name(
+      "projects/my_project/instances/my_instance/databases/my_database");
+  auto status =
+      stub.AsyncGetDatabase(cq, absl::make_unique<grpc::ClientContext>(),
+                            request)
+          .get();
+  EXPECT_EQ(TransientError(), status.status());
+}
+
+TEST_F(MetadataDecoratorTest, AsyncDropDatabase) {
+  EXPECT_CALL(*mock_, AsyncDropDatabase)
+      .WillOnce(
+          [this](
+              google::cloud::CompletionQueue&,
+              std::unique_ptr<grpc::ClientContext> context,
+              google::test::admin::database::v1::DropDatabaseRequest const&) {
+            EXPECT_STATUS_OK(IsContextMDValid(
+                *context,
+                "google.test.admin.database.v1.DatabaseAdmin.DropDatabase",
+                expected_api_client_header_));
+            return make_ready_future(TransientError());
+          });
+
+  DatabaseAdminMetadata stub(mock_);
+  CompletionQueue cq;
+  google::test::admin::database::v1::DropDatabaseRequest request;
+  request.set_database(
+      "projects/my_project/instances/my_instance/databases/my_database");
+  auto status =
+      stub.AsyncDropDatabase(cq, absl::make_unique<grpc::ClientContext>(),
+                             request)
+          .get();
+  EXPECT_EQ(TransientError(), status);
+}
+
 TEST_F(MetadataDecoratorTest, GetOperation) {
   EXPECT_CALL(*mock_, GetOperation(_, _))
       .WillOnce([this](grpc::ClientContext& context,
@@ -564,6 +685,47 @@ TEST_F(MetadataDecoratorTest, CancelOperation) {
   EXPECT_EQ(TransientError(), status);
 }
 
+TEST_F(MetadataDecoratorTest, AsyncGetOperation) {
+  EXPECT_CALL(*mock_, AsyncGetOperation(_, _, _))
+      .WillOnce([this](google::cloud::CompletionQueue&,
+                       std::unique_ptr<grpc::ClientContext> context,
+                       google::longrunning::GetOperationRequest const&) {
+        EXPECT_STATUS_OK(IsContextMDValid(
+            *context, "google.longrunning.Operations.GetOperation",
+            expected_api_client_header_));
+        return make_ready_future(
+            StatusOr<google::longrunning::Operation>(TransientError()));
+      });
+
+  DatabaseAdminMetadata stub(mock_);
+  google::cloud::CompletionQueue cq;
+  google::longrunning::GetOperationRequest request;
+  request.set_name("operations/my_operation");
+  auto status = stub.AsyncGetOperation(
+      cq, absl::make_unique<grpc::ClientContext>(), request);
+  EXPECT_EQ(TransientError(), status.get().status());
+}
+
+TEST_F(MetadataDecoratorTest, AsyncCancelOperation) {
+  EXPECT_CALL(*mock_, AsyncCancelOperation(_, _, _))
+      .WillOnce([this](google::cloud::CompletionQueue&,
+                       std::unique_ptr<grpc::ClientContext> context,
+                       google::longrunning::CancelOperationRequest const&) {
+        EXPECT_STATUS_OK(IsContextMDValid(
+            *context, "google.longrunning.Operations.CancelOperation",
+            expected_api_client_header_));
+        return make_ready_future(TransientError());
+      });
+
+  DatabaseAdminMetadata stub(mock_);
+  google::cloud::CompletionQueue cq;
+  google::longrunning::CancelOperationRequest request;
+  request.set_name("operations/my_operation");
+  auto status = stub.AsyncCancelOperation(
+      cq, absl::make_unique<grpc::ClientContext>(), request);
+  EXPECT_EQ(TransientError(), status.get());
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace golden_internal
@@ -0,0 +1,370 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "generator/integration_tests/golden/internal/database_admin_metrics_decorator.gcpcxx.pb.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace golden_internal {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+
+using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::Return;
+
+class MockGoldenStub
+    : public google::cloud::golden_internal::DatabaseAdminStub {
+ public:
+  ~MockGoldenStub() override = default;
+  MOCK_METHOD(
+      StatusOr<::google::test::admin::database::v1::ListDatabasesResponse>,
+      ListDatabases,
+      (grpc::ClientContext & context,
+       ::google::test::admin::database::v1::ListDatabasesRequest const&
+           request),
+      (override));
+
+  MOCK_METHOD(StatusOr<::google::longrunning::Operation>, CreateDatabase,
+              (grpc::ClientContext & context,
+               ::google::test::admin::database::v1::CreateDatabaseRequest const&
+                   request),
+              (override));
+
+  MOCK_METHOD(
+      StatusOr<::google::test::admin::database::v1::Database>, GetDatabase,
+      (grpc::ClientContext & context,
+       ::google::test::admin::database::v1::GetDatabaseRequest const& request),
+      (override));
+
+  MOCK_METHOD(
+      StatusOr<::google::longrunning::Operation>, UpdateDatabaseDdl,
+      (grpc::ClientContext & context,
+       ::google::test::admin::database::v1::UpdateDatabaseDdlRequest const&
+           request),
+      (override));
+
+  MOCK_METHOD(
+      Status, DropDatabase,
+      (grpc::ClientContext & context,
+       ::google::test::admin::database::v1::DropDatabaseRequest const& request),
+      (override));
+
+  MOCK_METHOD(
+      StatusOr<::google::test::admin::database::v1::GetDatabaseDdlResponse>,
+      GetDatabaseDdl,
+      (grpc::ClientContext & context,
+       ::google::test::admin::database::v1::GetDatabaseDdlRequest const&
+           request),
+      (override));
+
+  MOCK_METHOD(StatusOr<::google::iam::v1::Policy>, SetIamPolicy,
+              (grpc::ClientContext & context,
+               ::google::iam::v1::SetIamPolicyRequest const& request),
+              (override));
+
+  MOCK_METHOD(StatusOr<::google::iam::v1::Policy>, GetIamPolicy,
+              (grpc::ClientContext & context,
+               ::google::iam::v1::GetIamPolicyRequest const& request),
+              (override));
+
+  MOCK_METHOD(StatusOr<::google::iam::v1::TestIamPermissionsResponse>,
+              TestIamPermissions,
+              (grpc::ClientContext & context,
+               ::google::iam::v1::TestIamPermissionsRequest const& request),
+              (override));
+
+  MOCK_METHOD(
+      StatusOr<::google::longrunning::Operation>, CreateBackup,
+      (grpc::ClientContext & context,
+       ::google::test::admin::database::v1::CreateBackupRequest const& request),
+      (override));
+
+  MOCK_METHOD(
+      StatusOr<::google::test::admin::database::v1::Backup>, GetBackup,
+      (grpc::ClientContext & context,
+       ::google::test::admin::database::v1::GetBackupRequest const& request),
+      (override));
+
+  MOCK_METHOD(
+      StatusOr<::google::test::admin::database::v1::Backup>, UpdateBackup,
+      (grpc::ClientContext & context,
+       ::google::test::admin::database::v1::UpdateBackupRequest const& request),
+      (override));
+
+  MOCK_METHOD(
+      Status, DeleteBackup,
+      (grpc::ClientContext & context,
+       ::google::test::admin::database::v1::DeleteBackupRequest const& request),
+      (override));
+
+  MOCK_METHOD(
+      StatusOr<::google::test::admin::database::v1::ListBackupsResponse>,
+      ListBackups,
+      (grpc::ClientContext & context,
+       ::google::test::admin::database::v1::ListBackupsRequest const& request),
+      (override));
+
+  MOCK_METHOD(
+      StatusOr<::google::longrunning::Operation>, RestoreDatabase,
+      (grpc::ClientContext & context,
+       ::google::test::admin::database::v1::RestoreDatabaseRequest const&
+           request),
+      (override));
+
+  MOCK_METHOD(
+      StatusOr<
+          ::google::test::admin::database::v1::ListDatabaseOperationsResponse>,
+      ListDatabaseOperations,
+      (grpc::ClientContext & context,
+       ::google::test::admin::database::v1::ListDatabaseOperationsRequest const&
+           request),
+      (override));
+
+  MOCK_METHOD(
+      StatusOr<
+          ::google::test::admin::database::v1::ListBackupOperationsResponse>,
+      ListBackupOperations,
+      (grpc::ClientContext & context,
+       ::google::test::admin::database::v1::ListBackupOperationsRequest const&
+           request),
+      (override));
+
+  MOCK_METHOD(std::unique_ptr<google::cloud::internal::StreamingReadRpc<
+                  ::google::test::admin::database::v1::StreamingReadResponse>>,
+              StreamingRead,
+              (std::unique_ptr<grpc::ClientContext> context,
+               ::google::test::admin::database::v1::StreamingReadRequest const&
+                   request),
+              (override));
+  MOCK_METHOD(
+      (std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<
+           ::google::test::admin::database::v1::StreamingReadWriteRequest,
+           ::google::test::admin::database::v1::StreamingReadWriteResponse>>),
+      AsyncStreamingReadWrite,
+      (google::cloud::CompletionQueue & cq,
+       std::unique_ptr<grpc::ClientContext> context),
+      (override));
+  MOCK_METHOD(
+      future<StatusOr<::google::test::admin::database::v1::Database>>,
+      AsyncGetDatabase,
+      (google::cloud::CompletionQueue & cq,
+       std::unique_ptr<grpc::ClientContext> context,
+       ::google::test::admin::database::v1::GetDatabaseRequest const& request),
+      (override));
+  MOCK_METHOD(
+      future<Status>, AsyncDropDatabase,
+      (google::cloud::CompletionQueue & cq,
+       std::unique_ptr<grpc::ClientContext> context,
+       ::google::test::admin::database::v1::DropDatabaseRequest const& request),
+      (override));
+
+  /// Poll a long-running operation.
+  MOCK_METHOD(StatusOr<google::longrunning::Operation>, GetOperation,
+              (grpc::ClientContext & client_context,
+               google::longrunning::GetOperationRequest const& request),
+              (override));
+
+  /// Cancel a long-running operation.
+  MOCK_METHOD(Status, CancelOperation,
+              (grpc::ClientContext & client_context,
+               google::longrunning::CancelOperationRequest const& request),
+              (override));
+
+  /// Poll a long-running operation asynchronously.
+  MOCK_METHOD(future<StatusOr<google::longrunning::Operation>>,
+              AsyncGetOperation,
+              (google::cloud::CompletionQueue & cq,
+               std::unique_ptr<grpc::ClientContext> client_context,
+               google::longrunning::GetOperationRequest const& request),
+              (override));
+
+  /// Cancel a long-running operation asynchronously.
+  MOCK_METHOD(future<Status>, AsyncCancelOperation,
+              (google::cloud::CompletionQueue & cq,
+               std::unique_ptr<grpc::ClientContext> client_context,
+               google::longrunning::CancelOperationRequest const& request),
+              (override));
+};
+
+class MockStreamingReadRpc
+    : public google::cloud::internal::StreamingReadRpc<
+          ::google::test::admin::database::v1::StreamingReadResponse> {
+ public:
+  ~MockStreamingReadRpc() override = default;
+  MOCK_METHOD(void, Cancel, (), (override));
+  MOCK_METHOD((absl::variant<
+                  Status,
+                  ::google::test::admin::database::v1::StreamingReadResponse>),
+              Read, (), (override));
+};
+
+class MetricsDecoratorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    mock_ = std::make_shared<MockGoldenStub>();
+    sink_ = std::make_shared<RpcMetricsAggregator>();
+  }
+
+  static Status TransientError() {
+    return Status(StatusCode::kUnavailable, "try-again");
+  }
+
+  static std::size_t Index(StatusCode code) {
+    return static_cast<std::size_t>(code);
+  }
+
+  std::vector<std::string> MethodNames() const {
+    std::vector<std::string> names;
+    for (auto const& kv : sink_->Snapshot()) names.push_back(kv.first);
+    return names;
+  }
+
+  std::shared_ptr<MockGoldenStub> mock_;
+  std::shared_ptr<RpcMetricsAggregator> sink_;
+};
+
+TEST_F(MetricsDecoratorTest, GetDatabase) {
+  ::google::test::admin::database::v1::Database database;
+  database.set_name("test-database");
+  EXPECT_CALL(*mock_, GetDatabase(_, _))
+      .WillOnce(Return(TransientError()))
+      .WillOnce(Return(database));
+
+  DatabaseAdminMetrics stub(mock_, sink_);
+  grpc::ClientContext context;
+  ::google::test::admin::database::v1::GetDatabaseRequest request;
+  request.set_name("test-database");
+  auto failure = stub.GetDatabase(context, request);
+  EXPECT_EQ(TransientError(), failure.status());
+  auto success = stub.GetDatabase(context, request);
+  ASSERT_STATUS_OK(success);
+
+  EXPECT_THAT(MethodNames(), ElementsAre("DatabaseAdmin.GetDatabase"));
+  auto const m = sink_->Snapshot().at("DatabaseAdmin.GetDatabase");
+  EXPECT_EQ(2, m.attempts);
+  EXPECT_EQ(2 * request.ByteSizeLong(), m.request_bytes);
+  EXPECT_EQ(database.ByteSizeLong(), m.response_bytes);
+  EXPECT_EQ(1, m.status_codes[Index(StatusCode::kOk)]);
+  EXPECT_EQ(1, m.status_codes[Index(StatusCode::kUnavailable)]);
+}
+
+TEST_F(MetricsDecoratorTest, DropDatabase) {
+  EXPECT_CALL(*mock_, DropDatabase(_, _)).WillOnce(Return(TransientError()));
+
+  DatabaseAdminMetrics stub(mock_, sink_);
+  grpc::ClientContext context;
+  auto status = stub.DropDatabase(
+      context, ::google::test::admin::database::v1::DropDatabaseRequest());
+  EXPECT_EQ(TransientError(), status);
+
+  EXPECT_THAT(MethodNames(), ElementsAre("DatabaseAdmin.DropDatabase"));
+  auto const m = sink_->Snapshot().at("DatabaseAdmin.DropDatabase");
+  EXPECT_EQ(1, m.attempts);
+  EXPECT_EQ(1, m.status_codes[Index(StatusCode::kUnavailable)]);
+}
+
+TEST_F(MetricsDecoratorTest, StreamingRead) {
+  EXPECT_CALL(*mock_, StreamingRead)
+      .WillOnce(
+          [](std::unique_ptr<grpc::ClientContext>,
+             ::google::test::admin::database::v1::StreamingReadRequest const&) {
+            auto stream = absl::make_unique<MockStreamingReadRpc>();
+            ::google::test::admin::database::v1::StreamingReadResponse r;
+            r.set_statement("s1");
+            EXPECT_CALL(*stream, Read)
+                .WillOnce(Return(r))
+                .WillOnce(Return(Status()));
+            return stream;
+          });
+
+  DatabaseAdminMetrics stub(mock_, sink_);
+  auto stream = stub.StreamingRead(
+      absl::make_unique<grpc::ClientContext>(),
+      ::google::test::admin::database::v1::StreamingReadRequest());
+  ASSERT_NE(stream, nullptr);
+  (void)stream->Read();
+  EXPECT_TRUE(MethodNames().empty());
+  (void)stream->Read();
+
+  EXPECT_THAT(MethodNames(), ElementsAre("DatabaseAdmin.StreamingRead"));
+  auto const m = sink_->Snapshot().at("DatabaseAdmin.StreamingRead");
+  EXPECT_EQ(1, m.attempts);
+  EXPECT_LT(0, m.response_bytes);
+  EXPECT_EQ(1, m.status_codes[Index(StatusCode::kOk)]);
+}
+
+TEST_F(MetricsDecoratorTest, AsyncGetDatabase) {
+  EXPECT_CALL(*mock_, AsyncGetDatabase)
+      .WillOnce(
+          [](google::cloud::CompletionQueue&,
+             std::unique_ptr<grpc::ClientContext>,
+             ::google::test::admin::database::v1::GetDatabaseRequest const&) {
+            return make_ready_future(
+                StatusOr<::google::test::admin::database::v1::Database>(
+                    TransientError()));
+          });
+
+  DatabaseAdminMetrics stub(mock_, sink_);
+  CompletionQueue cq;
+  auto response =
+      stub.AsyncGetDatabase(
+              cq, absl::make_unique<grpc::ClientContext>(),
+              ::google::test::admin::database::v1::GetDatabaseRequest())
+          .get();
+  EXPECT_EQ(TransientError(), response.status());
+
+  EXPECT_THAT(MethodNames(), ElementsAre("DatabaseAdmin.GetDatabase"));
+}
+
+TEST_F(MetricsDecoratorTest, GetOperation) {
+  EXPECT_CALL(*mock_, GetOperation(_, _)).WillOnce(Return(TransientError()));
+
+  DatabaseAdminMetrics stub(mock_, sink_);
+  grpc::ClientContext context;
+  auto status = stub.GetOperation(
+      context, google::longrunning::GetOperationRequest());
+  EXPECT_EQ(TransientError(), status.status());
+
+  EXPECT_THAT(MethodNames(), ElementsAre("Operations.GetOperation"));
+}
+
+TEST_F(MetricsDecoratorTest, AsyncGetOperation) {
+  EXPECT_CALL(*mock_, AsyncGetOperation(_, _, _))
+      .WillOnce([](google::cloud::CompletionQueue&,
+                   std::unique_ptr<grpc::ClientContext>,
+                   google::longrunning::GetOperationRequest const&) {
+        return make_ready_future(
+            StatusOr<google::longrunning::Operation>(TransientError()));
+      });
+
+  DatabaseAdminMetrics stub(mock_, sink_);
+  google::cloud::CompletionQueue cq;
+  auto status =
+      stub.AsyncGetOperation(cq, absl::make_unique<grpc::ClientContext>(),
+                             google::longrunning::GetOperationRequest());
+  EXPECT_EQ(TransientError(), status.get().status());
+
+  EXPECT_THAT(MethodNames(), ElementsAre("Operations.GetOperation"));
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace golden_internal
+}  // namespace cloud
+}  // namespace google
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "generator/integration_tests/golden/internal/database_admin_stub.gcpcxx.pb.h"
+#include "absl/memory/memory.h"
 #include <gmock/gmock.h>
 #include <memory>
 
@@ -406,6 +407,49 @@ class MockGrpcDatabaseAdminStub
            request,
        ::grpc::CompletionQueue* cq),
       (override));
+  MOCK_METHOD(::grpc::ClientReaderInterface<
+                  ::google::test::admin::database::v1::StreamingReadResponse>*,
+              StreamingReadRaw,
+              (::grpc::ClientContext * context,
+               const ::google::test::admin::database::v1::StreamingReadRequest&
+                   request),
+              (override));
+  MOCK_METHOD(::grpc::ClientAsyncReaderInterface<
+                  ::google::test::admin::database::v1::StreamingReadResponse>*,
+              AsyncStreamingReadRaw,
+              (::grpc::ClientContext * context,
+               const ::google::test::admin::database::v1::StreamingReadRequest&
+                   request,
+               ::grpc::CompletionQueue* cq, void* tag),
+              (override));
+  MOCK_METHOD(::grpc::ClientAsyncReaderInterface<
+                  ::google::test::admin::database::v1::StreamingReadResponse>*,
+              PrepareAsyncStreamingReadRaw,
+              (::grpc::ClientContext * context,
+               const ::google::test::admin::database::v1::StreamingReadRequest&
+                   request,
+               ::grpc::CompletionQueue* cq),
+              (override));
+  MOCK_METHOD(
+      (::grpc::ClientReaderWriterInterface<
+          ::google::test::admin::database::v1::StreamingReadWriteRequest,
+          ::google::test::admin::database::v1::StreamingReadWriteResponse>*),
+      StreamingReadWriteRaw, (::grpc::ClientContext * context), (override));
+  MOCK_METHOD(
+      (::grpc::ClientAsyncReaderWriterInterface<
+          ::google::test::admin::database::v1::StreamingReadWriteRequest,
+          ::google::test::admin::database::v1::StreamingReadWriteResponse>*),
+      AsyncStreamingReadWriteRaw,
+      (::grpc::ClientContext * context, ::grpc::CompletionQueue* cq,
+       void* tag),
+      (override));
+  MOCK_METHOD(
+      (::grpc::ClientAsyncReaderWriterInterface<
+          ::google::test::admin::database::v1::StreamingReadWriteRequest,
+          ::google::test::admin::database::v1::StreamingReadWriteResponse>*),
+      PrepareAsyncStreamingReadWriteRaw,
+      (::grpc::ClientContext * context, ::grpc::CompletionQueue* cq),
+      (override));
 };
 
 class MockLongrunningOperationsStub
@@ -509,6 +553,19 @@ class MockLongrunningOperationsStub
               (override));
 };
 
+class MockStreamingReadResponseReader
+    : public ::grpc::ClientReaderInterface<
+          ::google::test::admin::database::v1::StreamingReadResponse> {
+ public:
+  ~MockStreamingReadResponseReader() override = default;
+  MOCK_METHOD(void, WaitForInitialMetadata, (), (override));
+  MOCK_METHOD(::grpc::Status, Finish, (), (override));
+  MOCK_METHOD(bool, NextMessageSize, (uint32_t*), (override));
+  MOCK_METHOD(bool, Read,
+              (::google::test::admin::database::v1::StreamingReadResponse*),
+              (override));
+};
+
 class GoldenStubTest : public ::testing::Test {
  protected:
   void SetUp() override {
@@ -606,6 +663,40 @@ TEST_F(GoldenStubTest, DropDatabase) {
   EXPECT_EQ(failure, TransientError());
 }
 
+TEST_F(GoldenStubTest, StreamingRead) {
+  google::test::admin::database::v1::StreamingReadRequest request;
+  EXPECT_CALL(*grpc_stub_, StreamingReadRaw(_, _))
+      .WillOnce(
+          [](grpc::ClientContext*,
+             google::test::admin::database::v1::StreamingReadRequest const&) {
+            auto* reader = new MockStreamingReadResponseReader;
+            EXPECT_CALL(*reader, Read)
+                .WillOnce([](google::test::admin::database::v1::
+                                 StreamingReadResponse* r) {
+                  r->set_statement("s1");
+                  return true;
+                })
+                .WillOnce(Return(false));
+            EXPECT_CALL(*reader, Finish).WillOnce(Return(GrpcTransientError()));
+            return reader;
+          });
+  DefaultDatabaseAdminStub stub(std::move(grpc_stub_),
+                                std::move(longrunning_stub_));
+  auto stream = stub.StreamingRead(absl::make_unique<grpc::ClientContext>(),
+                                   request);
+  auto response = stream->Read();
+  ASSERT_TRUE(absl::holds_alternative<
+              google::test::admin::database::v1::StreamingReadResponse>(
+      response));
+  EXPECT_EQ("s1",
+            absl::get<google::test::admin::database::v1::StreamingReadResponse>(
+                response)
+                .statement());
+  response = stream->Read();
+  ASSERT_TRUE(absl::holds_alternative<Status>(response));
+  EXPECT_EQ(absl::get<Status>(response), TransientError());
+}
+
 TEST_F(GoldenStubTest, GetDatabaseDdl) {
   grpc::Status status;
   grpc::ClientContext context;
@@ -27,10 +27,13 @@ google_cloud_cpp_generator_golden_files = [
     "internal/database_admin_logging_decorator.gcpcxx.pb.h",
     "internal/database_admin_metadata_decorator.gcpcxx.pb.cc",
     "internal/database_admin_metadata_decorator.gcpcxx.pb.h",
+    "internal/database_admin_metrics_decorator.gcpcxx.pb.cc",
+    "internal/database_admin_metrics_decorator.gcpcxx.pb.h",
     "internal/database_admin_stub.gcpcxx.pb.cc",
     "internal/database_admin_stub.gcpcxx.pb.h",
     "internal/database_admin_stub_factory.gcpcxx.pb.cc",
     "internal/database_admin_stub_factory.gcpcxx.pb.h",
     "retry_policy.gcpcxx.pb.h",
     "retry_traits.h",
+    "streaming.cc",
 ]
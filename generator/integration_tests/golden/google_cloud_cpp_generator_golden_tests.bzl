@@ -22,6 +22,7 @@ google_cloud_cpp_generator_golden_tests = [
     "golden_idempotency_policy_test.cc",
     "golden_logging_decorator_test.cc",
     "golden_metadata_decorator_test.cc",
+    "golden_metrics_decorator_test.cc",
     "golden_stub_factory_test.cc",
     "golden_stub_test.cc",
 ]
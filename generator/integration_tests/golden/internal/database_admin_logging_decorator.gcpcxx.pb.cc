@@ -238,6 +238,62 @@ DatabaseAdminLogging::ListBackupOperations(
       context, request, __func__, tracing_options_);
 }
 
+std::unique_ptr<google::cloud::internal::StreamingReadRpc<::google::test::admin::database::v1::StreamingReadResponse>>
+DatabaseAdminLogging::StreamingRead(
+    std::unique_ptr<grpc::ClientContext> context,
+    ::google::test::admin::database::v1::StreamingReadRequest const& request) {
+  return google::cloud::internal::LogWrapper(
+      [this](std::unique_ptr<grpc::ClientContext> context,
+             ::google::test::admin::database::v1::StreamingReadRequest const& request) {
+        return child_->StreamingRead(std::move(context), request);
+      },
+      std::move(context), request, __func__, tracing_options_);
+}
+
+std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<
+    ::google::test::admin::database::v1::StreamingReadWriteRequest,
+    ::google::test::admin::database::v1::StreamingReadWriteResponse>>
+DatabaseAdminLogging::AsyncStreamingReadWrite(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context) {
+  return google::cloud::internal::LogWrapper(
+      [this](google::cloud::CompletionQueue& cq,
+             std::unique_ptr<grpc::ClientContext> context) {
+        return child_->AsyncStreamingReadWrite(cq, std::move(context));
+      },
+      cq, std::move(context), __func__, tracing_options_);
+}
+
+future<StatusOr<::google::test::admin::database::v1::Database>>
+DatabaseAdminLogging::AsyncGetDatabase(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    ::google::test::admin::database::v1::GetDatabaseRequest const& request) {
+  return google::cloud::internal::LogWrapper(
+      [this](google::cloud::CompletionQueue& cq,
+             std::unique_ptr<grpc::ClientContext> context,
+             ::google::test::admin::database::v1::GetDatabaseRequest const& request) {
+        return child_->AsyncGetDatabase(
+            cq, std::move(context), request);
+      },
+      cq, std::move(context), request, __func__, tracing_options_);
+}
+
+future<Status>
+DatabaseAdminLogging::AsyncDropDatabase(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    ::google::test::admin::database::v1::DropDatabaseRequest const& request) {
+  return google::cloud::internal::LogWrapper(
+      [this](google::cloud::CompletionQueue& cq,
+             std::unique_ptr<grpc::ClientContext> context,
+             ::google::test::admin::database::v1::DropDatabaseRequest const& request) {
+        return child_->AsyncDropDatabase(
+            cq, std::move(context), request);
+      },
+      cq, std::move(context), request, __func__, tracing_options_);
+}
+
 StatusOr<google::longrunning::Operation> DatabaseAdminLogging::GetOperation(
     grpc::ClientContext& context,
     google::longrunning::GetOperationRequest const& request) {
@@ -259,6 +315,34 @@ Status DatabaseAdminLogging::CancelOperation(
       },
       context, request, __func__, tracing_options_);
 }
+
+future<StatusOr<google::longrunning::Operation>>
+DatabaseAdminLogging::AsyncGetOperation(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::longrunning::GetOperationRequest const& request) {
+  return google::cloud::internal::LogWrapper(
+      [this](google::cloud::CompletionQueue& cq,
+             std::unique_ptr<grpc::ClientContext> context,
+             google::longrunning::GetOperationRequest const& request) {
+        return child_->AsyncGetOperation(cq, std::move(context), request);
+      },
+      cq, std::move(context), request, __func__, tracing_options_);
+}
+
+future<Status> DatabaseAdminLogging::AsyncCancelOperation(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::longrunning::CancelOperationRequest const& request) {
+  return google::cloud::internal::LogWrapper(
+      [this](google::cloud::CompletionQueue& cq,
+             std::unique_ptr<grpc::ClientContext> context,
+             google::longrunning::CancelOperationRequest const& request) {
+        return child_->AsyncCancelOperation(cq, std::move(context),
+                                            request);
+      },
+      cq, std::move(context), request, __func__, tracing_options_);
+}
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace golden_internal
 }  // namespace cloud
@@ -179,6 +179,42 @@ DatabaseAdminMetadata::ListBackupOperations(
   return child_->ListBackupOperations(context, request);
 }
 
+std::unique_ptr<google::cloud::internal::StreamingReadRpc<::google::test::admin::database::v1::StreamingReadResponse>>
+DatabaseAdminMetadata::StreamingRead(
+    std::unique_ptr<grpc::ClientContext> context,
+    ::google::test::admin::database::v1::StreamingReadRequest const& request) {
+  SetMetadata(*context, "database=" + request.database());
+  return child_->StreamingRead(std::move(context), request);
+}
+
+std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<
+    ::google::test::admin::database::v1::StreamingReadWriteRequest,
+    ::google::test::admin::database::v1::StreamingReadWriteResponse>>
+DatabaseAdminMetadata::AsyncStreamingReadWrite(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context) {
+  SetMetadata(*context);
+  return child_->AsyncStreamingReadWrite(cq, std::move(context));
+}
+
+future<StatusOr<::google::test::admin::database::v1::Database>>
+DatabaseAdminMetadata::AsyncGetDatabase(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    ::google::test::admin::database::v1::GetDatabaseRequest const& request) {
+  SetMetadata(*context, "name=" + request.name());
+  return child_->AsyncGetDatabase(cq, std::move(context), request);
+}
+
+future<Status>
+DatabaseAdminMetadata::AsyncDropDatabase(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    ::google::test::admin::database::v1::DropDatabaseRequest const& request) {
+  SetMetadata(*context, "database=" + request.database());
+  return child_->AsyncDropDatabase(cq, std::move(context), request);
+}
+
 StatusOr<google::longrunning::Operation> DatabaseAdminMetadata::GetOperation(
     grpc::ClientContext& context,
     google::longrunning::GetOperationRequest const& request) {
@@ -193,12 +229,33 @@ Status DatabaseAdminMetadata::CancelOperation(
   return child_->CancelOperation(context, request);
 }
 
+future<StatusOr<google::longrunning::Operation>>
+DatabaseAdminMetadata::AsyncGetOperation(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::longrunning::GetOperationRequest const& request) {
+  SetMetadata(*context, "name=" + request.name());
+  return child_->AsyncGetOperation(cq, std::move(context), request);
+}
+
+future<Status> DatabaseAdminMetadata::AsyncCancelOperation(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::longrunning::CancelOperationRequest const& request) {
+  SetMetadata(*context, "name=" + request.name());
+  return child_->AsyncCancelOperation(cq, std::move(context), request);
+}
+
 void DatabaseAdminMetadata::SetMetadata(grpc::ClientContext& context,
                                         std::string const& request_params) {
   context.AddMetadata("x-goog-request-params", request_params);
   context.AddMetadata("x-goog-api-client", api_client_header_);
 }
 
+void DatabaseAdminMetadata::SetMetadata(grpc::ClientContext& context) {
+  context.AddMetadata("x-goog-api-client", api_client_header_);
+}
+
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace golden_internal
 }  // namespace cloud
@@ -101,6 +101,28 @@ class DatabaseAdminMetadata : public DatabaseAdminStub {
     grpc::ClientContext& context,
     ::google::test::admin::database::v1::ListBackupOperationsRequest const& request) override;
 
+  std::unique_ptr<google::cloud::internal::StreamingReadRpc<::google::test::admin::database::v1::StreamingReadResponse>>
+  StreamingRead(
+    std::unique_ptr<grpc::ClientContext> context,
+    ::google::test::admin::database::v1::StreamingReadRequest const& request) override;
+
+  std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<
+      ::google::test::admin::database::v1::StreamingReadWriteRequest,
+      ::google::test::admin::database::v1::StreamingReadWriteResponse>>
+  AsyncStreamingReadWrite(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context) override;
+
+  future<StatusOr<::google::test::admin::database::v1::Database>> AsyncGetDatabase(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    ::google::test::admin::database::v1::GetDatabaseRequest const& request) override;
+
+  future<Status> AsyncDropDatabase(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    ::google::test::admin::database::v1::DropDatabaseRequest const& request) override;
+
   /// Poll a long-running operation.
   StatusOr<google::longrunning::Operation> GetOperation(
       grpc::ClientContext& context,
@@ -111,9 +133,22 @@ class DatabaseAdminMetadata : public DatabaseAdminStub {
       grpc::ClientContext& context,
       google::longrunning::CancelOperationRequest const& request) override;
 
+  /// Poll a long-running operation asynchronously.
+  future<StatusOr<google::longrunning::Operation>> AsyncGetOperation(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> context,
+      google::longrunning::GetOperationRequest const& request) override;
+
+  /// Cancel a long-running operation asynchronously.
+  future<Status> AsyncCancelOperation(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> context,
+      google::longrunning::CancelOperationRequest const& request) override;
+
  private:
   void SetMetadata(grpc::ClientContext& context,
                    std::string const& request_params);
+  void SetMetadata(grpc::ClientContext& context);
   std::shared_ptr<DatabaseAdminStub> child_;
   std::string api_client_header_;
 };  // DatabaseAdminMetadata
@@ -0,0 +1,351 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by the Codegen C++ plugin.
+// If you make any local changes, they will be lost.
+// source: generator/integration_tests/test.proto
+
+#include "generator/integration_tests/golden/internal/database_admin_metrics_decorator.gcpcxx.pb.h"
+#include "google/cloud/grpc_error_delegate.h"
+#include "google/cloud/internal/metrics_wrapper.h"
+#include "google/cloud/status_or.h"
+#include <generator/integration_tests/test.grpc.pb.h>
+#include <google/longrunning/operations.grpc.pb.h>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace golden_internal {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+
+DatabaseAdminMetrics::DatabaseAdminMetrics(
+    std::shared_ptr<DatabaseAdminStub> child,
+    std::shared_ptr<RpcMetricsSink> sink)
+    : child_(std::move(child)), sink_(std::move(sink)) {}
+
+StatusOr<::google::test::admin::database::v1::ListDatabasesResponse>
+DatabaseAdminMetrics::ListDatabases(
+    grpc::ClientContext& context,
+    ::google::test::admin::database::v1::ListDatabasesRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             ::google::test::admin::database::v1::ListDatabasesRequest const& request) {
+        return child_->ListDatabases(context, request);
+      },
+      context, request, "DatabaseAdmin.ListDatabases", sink_);
+}
+
+StatusOr<::google::longrunning::Operation>
+DatabaseAdminMetrics::CreateDatabase(
+    grpc::ClientContext& context,
+    ::google::test::admin::database::v1::CreateDatabaseRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             ::google::test::admin::database::v1::CreateDatabaseRequest const& request) {
+        return child_->CreateDatabase(context, request);
+      },
+      context, request, "DatabaseAdmin.CreateDatabase", sink_);
+}
+
+StatusOr<::google::test::admin::database::v1::Database>
+DatabaseAdminMetrics::GetDatabase(
+    grpc::ClientContext& context,
+    ::google::test::admin::database::v1::GetDatabaseRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             ::google::test::admin::database::v1::GetDatabaseRequest const& request) {
+        return child_->GetDatabase(context, request);
+      },
+      context, request, "DatabaseAdmin.GetDatabase", sink_);
+}
+
+StatusOr<::google::longrunning::Operation>
+DatabaseAdminMetrics::UpdateDatabaseDdl(
+    grpc::ClientContext& context,
+    ::google::test::admin::database::v1::UpdateDatabaseDdlRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             ::google::test::admin::database::v1::UpdateDatabaseDdlRequest const& request) {
+        return child_->UpdateDatabaseDdl(context, request);
+      },
+      context, request, "DatabaseAdmin.UpdateDatabaseDdl", sink_);
+}
+
+Status
+DatabaseAdminMetrics::DropDatabase(
+    grpc::ClientContext& context,
+    ::google::test::admin::database::v1::DropDatabaseRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             ::google::test::admin::database::v1::DropDatabaseRequest const& request) {
+        return child_->DropDatabase(context, request);
+      },
+      context, request, "DatabaseAdmin.DropDatabase", sink_);
+}
+
+StatusOr<::google::test::admin::database::v1::GetDatabaseDdlResponse>
+DatabaseAdminMetrics::GetDatabaseDdl(
+    grpc::ClientContext& context,
+    ::google::test::admin::database::v1::GetDatabaseDdlRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             ::google::test::admin::database::v1::GetDatabaseDdlRequest const& request) {
+        return child_->GetDatabaseDdl(context, request);
+      },
+      context, request, "DatabaseAdmin.GetDatabaseDdl", sink_);
+}
+
+StatusOr<::google::iam::v1::Policy>
+DatabaseAdminMetrics::SetIamPolicy(
+    grpc::ClientContext& context,
+    ::google::iam::v1::SetIamPolicyRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             ::google::iam::v1::SetIamPolicyRequest const& request) {
+        return child_->SetIamPolicy(context, request);
+      },
+      context, request, "DatabaseAdmin.SetIamPolicy", sink_);
+}
+
+StatusOr<::google::iam::v1::Policy>
+DatabaseAdminMetrics::GetIamPolicy(
+    grpc::ClientContext& context,
+    ::google::iam::v1::GetIamPolicyRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             ::google::iam::v1::GetIamPolicyRequest const& request) {
+        return child_->GetIamPolicy(context, request);
+      },
+      context, request, "DatabaseAdmin.GetIamPolicy", sink_);
+}
+
+StatusOr<::google::iam::v1::TestIamPermissionsResponse>
+DatabaseAdminMetrics::TestIamPermissions(
+    grpc::ClientContext& context,
+    ::google::iam::v1::TestIamPermissionsRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             ::google::iam::v1::TestIamPermissionsRequest const& request) {
+        return child_->TestIamPermissions(context, request);
+      },
+      context, request, "DatabaseAdmin.TestIamPermissions", sink_);
+}
+
+StatusOr<::google::longrunning::Operation>
+DatabaseAdminMetrics::CreateBackup(
+    grpc::ClientContext& context,
+    ::google::test::admin::database::v1::CreateBackupRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             ::google::test::admin::database::v1::CreateBackupRequest const& request) {
+        return child_->CreateBackup(context, request);
+      },
+      context, request, "DatabaseAdmin.CreateBackup", sink_);
+}
+
+StatusOr<::google::test::admin::database::v1::Backup>
+DatabaseAdminMetrics::GetBackup(
+    grpc::ClientContext& context,
+    ::google::test::admin::database::v1::GetBackupRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             ::google::test::admin::database::v1::GetBackupRequest const& request) {
+        return child_->GetBackup(context, request);
+      },
+      context, request, "DatabaseAdmin.GetBackup", sink_);
+}
+
+StatusOr<::google::test::admin::database::v1::Backup>
+DatabaseAdminMetrics::UpdateBackup(
+    grpc::ClientContext& context,
+    ::google::test::admin::database::v1::UpdateBackupRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             ::google::test::admin::database::v1::UpdateBackupRequest const& request) {
+        return child_->UpdateBackup(context, request);
+      },
+      context, request, "DatabaseAdmin.UpdateBackup", sink_);
+}
+
+Status
+DatabaseAdminMetrics::DeleteBackup(
+    grpc::ClientContext& context,
+    ::google::test::admin::database::v1::DeleteBackupRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             ::google::test::admin::database::v1::DeleteBackupRequest const& request) {
+        return child_->DeleteBackup(context, request);
+      },
+      context, request, "DatabaseAdmin.DeleteBackup", sink_);
+}
+
+StatusOr<::google::test::admin::database::v1::ListBackupsResponse>
+DatabaseAdminMetrics::ListBackups(
+    grpc::ClientContext& context,
+    ::google::test::admin::database::v1::ListBackupsRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             ::google::test::admin::database::v1::ListBackupsRequest const& request) {
+        return child_->ListBackups(context, request);
+      },
+      context, request, "DatabaseAdmin.ListBackups", sink_);
+}
+
+StatusOr<::google::longrunning::Operation>
+DatabaseAdminMetrics::RestoreDatabase(
+    grpc::ClientContext& context,
+    ::google::test::admin::database::v1::RestoreDatabaseRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             ::google::test::admin::database::v1::RestoreDatabaseRequest const& request) {
+        return child_->RestoreDatabase(context, request);
+      },
+      context, request, "DatabaseAdmin.RestoreDatabase", sink_);
+}
+
+StatusOr<::google::test::admin::database::v1::ListDatabaseOperationsResponse>
+DatabaseAdminMetrics::ListDatabaseOperations(
+    grpc::ClientContext& context,
+    ::google::test::admin::database::v1::ListDatabaseOperationsRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             ::google::test::admin::database::v1::ListDatabaseOperationsRequest const& request) {
+        return child_->ListDatabaseOperations(context, request);
+      },
+      context, request, "DatabaseAdmin.ListDatabaseOperations", sink_);
+}
+
+StatusOr<::google::test::admin::database::v1::ListBackupOperationsResponse>
+DatabaseAdminMetrics::ListBackupOperations(
+    grpc::ClientContext& context,
+    ::google::test::admin::database::v1::ListBackupOperationsRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             ::google::test::admin::database::v1::ListBackupOperationsRequest const& request) {
+        return child_->ListBackupOperations(context, request);
+      },
+      context, request, "DatabaseAdmin.ListBackupOperations", sink_);
+}
+
+std::unique_ptr<google::cloud::internal::StreamingReadRpc<::google::test::admin::database::v1::StreamingReadResponse>>
+DatabaseAdminMetrics::StreamingRead(
+    std::unique_ptr<grpc::ClientContext> context,
+    ::google::test::admin::database::v1::StreamingReadRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](std::unique_ptr<grpc::ClientContext> context,
+             ::google::test::admin::database::v1::StreamingReadRequest const& request) {
+        return child_->StreamingRead(std::move(context), request);
+      },
+      std::move(context), request, "DatabaseAdmin.StreamingRead", sink_);
+}
+
+std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<
+    ::google::test::admin::database::v1::StreamingReadWriteRequest,
+    ::google::test::admin::database::v1::StreamingReadWriteResponse>>
+DatabaseAdminMetrics::AsyncStreamingReadWrite(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](google::cloud::CompletionQueue& cq,
+             std::unique_ptr<grpc::ClientContext> context) {
+        return child_->AsyncStreamingReadWrite(cq, std::move(context));
+      },
+      cq, std::move(context), "DatabaseAdmin.StreamingReadWrite", sink_);
+}
+
+future<StatusOr<::google::test::admin::database::v1::Database>>
+DatabaseAdminMetrics::AsyncGetDatabase(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    ::google::test::admin::database::v1::GetDatabaseRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](google::cloud::CompletionQueue& cq,
+             std::unique_ptr<grpc::ClientContext> context,
+             ::google::test::admin::database::v1::GetDatabaseRequest const& request) {
+        return child_->AsyncGetDatabase(
+            cq, std::move(context), request);
+      },
+      cq, std::move(context), request, "DatabaseAdmin.GetDatabase", sink_);
+}
+
+future<Status>
+DatabaseAdminMetrics::AsyncDropDatabase(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    ::google::test::admin::database::v1::DropDatabaseRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](google::cloud::CompletionQueue& cq,
+             std::unique_ptr<grpc::ClientContext> context,
+             ::google::test::admin::database::v1::DropDatabaseRequest const& request) {
+        return child_->AsyncDropDatabase(
+            cq, std::move(context), request);
+      },
+      cq, std::move(context), request, "DatabaseAdmin.DropDatabase", sink_);
+}
+
+StatusOr<google::longrunning::Operation> DatabaseAdminMetrics::GetOperation(
+    grpc::ClientContext& context,
+    google::longrunning::GetOperationRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::longrunning::GetOperationRequest const& request) {
+        return child_->GetOperation(context, request);
+      },
+      context, request, "Operations.GetOperation", sink_);
+}
+
+Status DatabaseAdminMetrics::CancelOperation(
+    grpc::ClientContext& context,
+    google::longrunning::CancelOperationRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](grpc::ClientContext& context,
+             google::longrunning::CancelOperationRequest const& request) {
+        return child_->CancelOperation(context, request);
+      },
+      context, request, "Operations.CancelOperation", sink_);
+}
+
+future<StatusOr<google::longrunning::Operation>>
+DatabaseAdminMetrics::AsyncGetOperation(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::longrunning::GetOperationRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](google::cloud::CompletionQueue& cq,
+             std::unique_ptr<grpc::ClientContext> context,
+             google::longrunning::GetOperationRequest const& request) {
+        return child_->AsyncGetOperation(cq, std::move(context), request);
+      },
+      cq, std::move(context), request, "Operations.GetOperation", sink_);
+}
+
+future<Status> DatabaseAdminMetrics::AsyncCancelOperation(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    google::longrunning::CancelOperationRequest const& request) {
+  return google::cloud::internal::MetricsWrapper(
+      [this](google::cloud::CompletionQueue& cq,
+             std::unique_ptr<grpc::ClientContext> context,
+             google::longrunning::CancelOperationRequest const& request) {
+        return child_->AsyncCancelOperation(cq, std::move(context),
+                                            request);
+      },
+      cq, std::move(context), request, "Operations.CancelOperation",
+      sink_);
+}
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace golden_internal
+}  // namespace cloud
+}  // namespace google
+
@@ -17,6 +17,7 @@
 // source: generator/integration_tests/test.proto
 
 #include "generator/integration_tests/golden/internal/database_admin_stub.gcpcxx.pb.h"
+#include "absl/memory/memory.h"
 #include "google/cloud/grpc_error_delegate.h"
 #include "google/cloud/status_or.h"
 #include <generator/integration_tests/test.grpc.pb.h>
@@ -251,6 +252,62 @@ DefaultDatabaseAdminStub::ListBackupOperations(
     return response;
 }
 
+std::unique_ptr<google::cloud::internal::StreamingReadRpc<::google::test::admin::database::v1::StreamingReadResponse>>
+DefaultDatabaseAdminStub::StreamingRead(
+  std::unique_ptr<grpc::ClientContext> client_context,
+  ::google::test::admin::database::v1::StreamingReadRequest const& request) {
+    auto stream = grpc_stub_->StreamingRead(client_context.get(), request);
+    return absl::make_unique<google::cloud::internal::StreamingReadRpcImpl<
+        ::google::test::admin::database::v1::StreamingReadResponse>>(
+        std::move(client_context), std::move(stream));
+}
+
+std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<
+    ::google::test::admin::database::v1::StreamingReadWriteRequest,
+    ::google::test::admin::database::v1::StreamingReadWriteResponse>>
+DefaultDatabaseAdminStub::AsyncStreamingReadWrite(
+  google::cloud::CompletionQueue& cq,
+  std::unique_ptr<grpc::ClientContext> client_context) {
+    return google::cloud::internal::MakeStreamingReadWriteRpc<
+        ::google::test::admin::database::v1::StreamingReadWriteRequest,
+        ::google::test::admin::database::v1::StreamingReadWriteResponse>(
+        cq, std::move(client_context),
+        [this](grpc::ClientContext* context, grpc::CompletionQueue* cq) {
+          return grpc_stub_->PrepareAsyncStreamingReadWrite(context, cq);
+        });
+}
+
+future<StatusOr<::google::test::admin::database::v1::Database>>
+DefaultDatabaseAdminStub::AsyncGetDatabase(
+  google::cloud::CompletionQueue& cq,
+  std::unique_ptr<grpc::ClientContext> client_context,
+  ::google::test::admin::database::v1::GetDatabaseRequest const& request) {
+    return cq.MakeUnaryRpc(
+        [this](grpc::ClientContext* context,
+               ::google::test::admin::database::v1::GetDatabaseRequest const& request,
+               grpc::CompletionQueue* cq) {
+          return grpc_stub_->AsyncGetDatabase(context, request, cq);
+        },
+        request, std::move(client_context));
+}
+
+future<Status>
+DefaultDatabaseAdminStub::AsyncDropDatabase(
+  google::cloud::CompletionQueue& cq,
+  std::unique_ptr<grpc::ClientContext> client_context,
+  ::google::test::admin::database::v1::DropDatabaseRequest const& request) {
+    return cq.MakeUnaryRpc(
+        [this](grpc::ClientContext* context,
+               ::google::test::admin::database::v1::DropDatabaseRequest const& request,
+               grpc::CompletionQueue* cq) {
+          return grpc_stub_->AsyncDropDatabase(context, request, cq);
+        },
+        request, std::move(client_context))
+        .then([](future<StatusOr<google::protobuf::Empty>> f) {
+          return f.get().status();
+        });
+}
+
 /// Poll a long-running operation.
 StatusOr<google::longrunning::Operation>
 DefaultDatabaseAdminStub::GetOperation(
@@ -276,6 +333,38 @@ Status DefaultDatabaseAdminStub::CancelOperation(
   }
   return google::cloud::Status();
 }
+
+/// Poll a long-running operation asynchronously.
+future<StatusOr<google::longrunning::Operation>>
+DefaultDatabaseAdminStub::AsyncGetOperation(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> client_context,
+    google::longrunning::GetOperationRequest const& request) {
+  return cq.MakeUnaryRpc(
+      [this](grpc::ClientContext* context,
+             google::longrunning::GetOperationRequest const& request,
+             grpc::CompletionQueue* cq) {
+        return operations_->AsyncGetOperation(context, request, cq);
+      },
+      request, std::move(client_context));
+}
+
+/// Cancel a long-running operation asynchronously.
+future<Status> DefaultDatabaseAdminStub::AsyncCancelOperation(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> client_context,
+    google::longrunning::CancelOperationRequest const& request) {
+  return cq.MakeUnaryRpc(
+      [this](grpc::ClientContext* context,
+             google::longrunning::CancelOperationRequest const& request,
+             grpc::CompletionQueue* cq) {
+        return operations_->AsyncCancelOperation(context, request, cq);
+      },
+      request, std::move(client_context))
+      .then([](future<StatusOr<google::protobuf::Empty>> f) {
+        return f.get().status();
+      });
+}
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace golden_internal
 }  // namespace cloud
@@ -18,6 +18,10 @@
 #ifndef GOOGLE_CLOUD_CPP_GENERATOR_INTEGRATION_TESTS_GOLDEN_INTERNAL_DATABASE_ADMIN_STUB_GCPCXX_PB_H
 #define GOOGLE_CLOUD_CPP_GENERATOR_INTEGRATION_TESTS_GOLDEN_INTERNAL_DATABASE_ADMIN_STUB_GCPCXX_PB_H
 
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/future.h"
+#include "google/cloud/internal/async_read_write_stream_impl.h"
+#include "google/cloud/internal/streaming_read_rpc.h"
 #include "google/cloud/status_or.h"
 #include "google/cloud/version.h"
 #include <generator/integration_tests/test.grpc.pb.h>
@@ -101,6 +105,28 @@ class DatabaseAdminStub {
     grpc::ClientContext& context,
     ::google::test::admin::database::v1::ListBackupOperationsRequest const& request) = 0;
 
+  virtual std::unique_ptr<google::cloud::internal::StreamingReadRpc<::google::test::admin::database::v1::StreamingReadResponse>>
+  StreamingRead(
+    std::unique_ptr<grpc::ClientContext> context,
+    ::google::test::admin::database::v1::StreamingReadRequest const& request) = 0;
+
+  virtual std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<
+      ::google::test::admin::database::v1::StreamingReadWriteRequest,
+      ::google::test::admin::database::v1::StreamingReadWriteResponse>>
+  AsyncStreamingReadWrite(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context) = 0;
+
+  virtual future<StatusOr<::google::test::admin::database::v1::Database>> AsyncGetDatabase(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    ::google::test::admin::database::v1::GetDatabaseRequest const& request) = 0;
+
+  virtual future<Status> AsyncDropDatabase(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context,
+    ::google::test::admin::database::v1::DropDatabaseRequest const& request) = 0;
+
   /// Poll a long-running operation.
   virtual StatusOr<google::longrunning::Operation> GetOperation(
       grpc::ClientContext& client_context,
@@ -111,6 +137,18 @@ class DatabaseAdminStub {
       grpc::ClientContext& client_context,
       google::longrunning::CancelOperationRequest const& request) = 0;
 
+  /// Poll a long-running operation asynchronously.
+  virtual future<StatusOr<google::longrunning::Operation>> AsyncGetOperation(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> client_context,
+      google::longrunning::GetOperationRequest const& request) = 0;
+
+  /// Cancel a long-running operation asynchronously.
+  virtual future<Status> AsyncCancelOperation(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> client_context,
+      google::longrunning::CancelOperationRequest const& request) = 0;
+
 };
 
 class DefaultDatabaseAdminStub : public DatabaseAdminStub {
@@ -206,6 +244,30 @@ class DefaultDatabaseAdminStub : public DatabaseAdminStub {
     grpc::ClientContext& client_context,
     ::google::test::admin::database::v1::ListBackupOperationsRequest const& request) override;
 
+  std::unique_ptr<google::cloud::internal::StreamingReadRpc<::google::test::admin::database::v1::StreamingReadResponse>>
+  StreamingRead(
+    std::unique_ptr<grpc::ClientContext> client_context,
+    ::google::test::admin::database::v1::StreamingReadRequest const& request) override;
+
+  std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<
+      ::google::test::admin::database::v1::StreamingReadWriteRequest,
+      ::google::test::admin::database::v1::StreamingReadWriteResponse>>
+  AsyncStreamingReadWrite(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> client_context) override;
+
+  future<StatusOr<::google::test::admin::database::v1::Database>>
+  AsyncGetDatabase(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> client_context,
+    ::google::test::admin::database::v1::GetDatabaseRequest const& request) override;
+
+  future<Status>
+  AsyncDropDatabase(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> client_context,
+    ::google::test::admin::database::v1::DropDatabaseRequest const& request) override;
+
   /// Poll a long-running operation.
   StatusOr<google::longrunning::Operation> GetOperation(
       grpc::ClientContext& client_context,
@@ -216,6 +278,18 @@ class DefaultDatabaseAdminStub : public DatabaseAdminStub {
       grpc::ClientContext& client_context,
       google::longrunning::CancelOperationRequest const& request) override;
 
+  /// Poll a long-running operation asynchronously.
+  future<StatusOr<google::longrunning::Operation>> AsyncGetOperation(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> client_context,
+      google::longrunning::GetOperationRequest const& request) override;
+
+  /// Cancel a long-running operation asynchronously.
+  future<Status> AsyncCancelOperation(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> client_context,
+      google::longrunning::CancelOperationRequest const& request) override;
+
  private:
   std::unique_ptr<::google::test::admin::database::v1::DatabaseAdmin::StubInterface> grpc_stub_;
   std::unique_ptr<google::longrunning::Operations::StubInterface> operations_;
@@ -19,6 +19,7 @@
 #include "generator/integration_tests/golden/internal/database_admin_stub_factory.gcpcxx.pb.h"
 #include "generator/integration_tests/golden/internal/database_admin_logging_decorator.gcpcxx.pb.h"
 #include "generator/integration_tests/golden/internal/database_admin_metadata_decorator.gcpcxx.pb.h"
+#include "generator/integration_tests/golden/internal/database_admin_metrics_decorator.gcpcxx.pb.h"
 #include "generator/integration_tests/golden/internal/database_admin_stub.gcpcxx.pb.h"
 #include "google/cloud/log.h"
 #include <memory>
@@ -44,6 +45,11 @@ CreateDefaultDatabaseAdminStub(golden::ConnectionOptions const& options) {
 
   stub = std::make_shared<DatabaseAdminMetadata>(std::move(stub));
 
+  if (options.rpc_metrics_sink()) {
+    stub = std::make_shared<DatabaseAdminMetrics>(
+        std::move(stub), options.rpc_metrics_sink());
+  }
+
   if (options.tracing_enabled("rpc")) {
     GCP_LOG(INFO) << "Enabled logging for gRPC calls";
     stub = std::make_shared<DatabaseAdminLogging>(std::move(stub),
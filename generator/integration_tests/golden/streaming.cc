@@ -0,0 +1,33 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "generator/integration_tests/golden/database_admin_connection.gcpcxx.pb.h"
+
+namespace google {
+namespace cloud {
+namespace golden {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+
+/// Resume the stream after the last `resume_token` received.
+void DatabaseAdminStreamingReadStreamingUpdater(
+    ::google::test::admin::database::v1::StreamingReadResponse const& response,
+    ::google::test::admin::database::v1::StreamingReadRequest& request) {
+  if (response.resume_token().empty()) return;
+  request.set_resume_token(response.resume_token());
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace golden
+}  // namespace cloud
+}  // namespace google
@@ -18,6 +18,7 @@
 #include "google/cloud/internal/absl_str_replace_quiet.h"
 #include "absl/strings/str_split.h"
 #include <google/protobuf/compiler/code_generator.h>
+#include <algorithm>
 #include <cctype>
 #include <string>
 
@@ -112,6 +113,22 @@ ProcessCommandLineArgs(std::string const& parameters) {
   if (path.back() != '/') {
     path += '/';
   }
+
+  // Each `gen_async_rpc=<Method>` option requests an asynchronous variant of
+  // one method. Collect them into a single entry, the service vars can only
+  // hold one value per key.
+  std::vector<std::string> async_rpcs;
+  for (auto const& arg : command_line_args) {
+    if (arg.first == "gen_async_rpc") async_rpcs.push_back(arg.second);
+  }
+  command_line_args.erase(
+      std::remove_if(command_line_args.begin(), command_line_args.end(),
+                     [](std::pair<std::string, std::string> const& p) {
+                       return p.first == "gen_async_rpc";
+                     }),
+      command_line_args.end());
+  command_line_args.emplace_back("gen_async_rpcs",
+                                 absl::StrJoin(async_rpcs, ","));
   return command_line_args;
 }
 
@@ -99,6 +99,9 @@ std::vector<std::string> BuildNamespaces(
  * '--cpp_codegen_opt=key=value'. This can be specified multiple times to
  * pass various key,value pairs. The resulting string passed from protoc to
  * the plugin is a comma delimited list such: "key1=value1,key2,key3=value3"
+ *
+ * The `gen_async_rpc=<Method>` option can be repeated, the values are returned
+ * as a single, comma delimited, `gen_async_rpcs` entry.
  */
 StatusOr<std::vector<std::pair<std::string, std::string>>>
 ProcessCommandLineArgs(std::string const& parameters);
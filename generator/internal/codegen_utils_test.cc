@@ -20,6 +20,11 @@ namespace cloud {
 namespace generator_internal {
 namespace {
 
+using ::testing::_;
+using ::testing::Contains;
+using ::testing::Not;
+using ::testing::Pair;
+
 TEST(GeneratedFileSuffix, Success) {
   EXPECT_EQ(".gcpcxx.pb", GeneratedFileSuffix());
 }
@@ -172,6 +177,20 @@ TEST(ProcessCommandLineArgs, ProductPathAlreadyFormatted) {
   EXPECT_EQ(result->front().second, "google/cloud/pubsub/");
 }
 
+TEST(ProcessCommandLineArgs, AsyncRpcs) {
+  auto result = ProcessCommandLineArgs(
+      "product_path=google/cloud/pubsub/,gen_async_rpc=Get,gen_async_rpc=Drop");
+  ASSERT_TRUE(result.ok());
+  EXPECT_THAT(*result, Contains(Pair("gen_async_rpcs", "Get,Drop")));
+  EXPECT_THAT(*result, Not(Contains(Pair("gen_async_rpc", _))));
+}
+
+TEST(ProcessCommandLineArgs, NoAsyncRpcs) {
+  auto result = ProcessCommandLineArgs("product_path=google/cloud/pubsub/");
+  ASSERT_TRUE(result.ok());
+  EXPECT_THAT(*result, Contains(Pair("gen_async_rpcs", "")));
+}
+
 }  // namespace
 }  // namespace generator_internal
 }  // namespace cloud
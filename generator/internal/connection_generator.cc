@@ -50,9 +50,11 @@ Status ConnectionGenerator::GenerateHeader() {
       {vars("connection_options_header_path"),
        vars("idempotency_policy_header_path"), vars("stub_header_path"),
        vars("retry_policy_header_path"), "google/cloud/backoff_policy.h",
-       "google/cloud/future.h", "google/cloud/internal/pagination_range.h",
-       "google/cloud/polling_policy.h", "google/cloud/status_or.h",
-       "google/cloud/version.h"});
+       "google/cloud/future.h",
+       "google/cloud/internal/async_read_write_stream_impl.h",
+       "google/cloud/internal/pagination_range.h",
+       "google/cloud/internal/stream_range.h", "google/cloud/polling_policy.h",
+       "google/cloud/status_or.h", "google/cloud/version.h"});
   HeaderSystemIncludes({"google/longrunning/operations.grpc.pb.h", "memory"});
   HeaderPrint("\n");
 
@@ -73,7 +75,34 @@ Status ConnectionGenerator::GenerateHeader() {
     "    $response_type$>;\n\n"},
                 // clang-format on
             },
-            All(IsNonStreaming, Not(IsLongrunningOperation), IsPaginated))},
+            All(IsNonStreaming, Not(IsLongrunningOperation), IsPaginated)),
+         MethodPattern(
+             {
+                 // clang-format off
+   {"using $method_name$Stream = "
+    "google::cloud::internal::StreamRange<\n"
+    "    $response_type$>;\n\n"},
+                 // clang-format on
+             },
+             IsStreamingRead)},
+        __FILE__, __LINE__);
+  }
+
+  // The generator cannot infer how to resume each streaming read RPC, these
+  // functions are implemented by hand.
+  for (auto const& method : methods()) {
+    HeaderPrintMethod(
+        method,
+        {MethodPattern(
+            {
+                // clang-format off
+   {"/// Update @p request to resume `$method_name$()` after @p response.\n"
+    "void $service_name$$method_name$StreamingUpdater(\n"
+    "    $response_type$ const& response,\n"
+    "    $request_type$& request);\n\n"},
+                // clang-format on
+            },
+            IsStreamingRead)},
         __FILE__, __LINE__);
   }
 
@@ -118,7 +147,43 @@ Status ConnectionGenerator::GenerateHeader() {
     "  $method_name$($request_type$ request);\n\n"},
                  // clang-format on
              },
-             All(IsNonStreaming, Not(IsLongrunningOperation), IsPaginated))},
+             All(IsNonStreaming, Not(IsLongrunningOperation), IsPaginated)),
+         MethodPattern(
+             {
+                 // clang-format off
+   {"  virtual $method_name$Stream\n"
+    "  $method_name$($request_type$ const& request);\n\n"},
+                 // clang-format on
+             },
+             IsStreamingRead),
+         MethodPattern(
+             {
+                 // clang-format off
+   {"  virtual std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<\n"
+    "      $request_type$,\n"
+    "      $response_type$>>\n"
+    "  Async$method_name$();\n\n"},
+                 // clang-format on
+             },
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    HeaderPrintMethod(
+        method,
+        {MethodPattern(
+            {
+                {IsResponseTypeEmpty,
+                 // clang-format off
+    "  virtual future<Status>\n",
+    "  virtual future<StatusOr<$response_type$>>\n"},
+   {"  Async$method_name$($request_type$ const& request);\n"
+        "\n",}
+                // clang-format on
+            },
+            All(IsNonStreaming, Not(IsLongrunningOperation),
+                Not(IsPaginated)))},
         __FILE__, __LINE__);
   }
 
@@ -169,8 +234,13 @@ Status ConnectionGenerator::GenerateCc() {
   // includes
   CcLocalIncludes({vars("connection_header_path"),
                    vars("stub_factory_header_path"),
+                   "google/cloud/background_threads.h",
+                   "google/cloud/internal/async_polling_loop.h",
+                   "google/cloud/internal/async_retry_loop.h",
                    "google/cloud/internal/polling_loop.h",
-                   "google/cloud/internal/retry_loop.h"});
+                   "google/cloud/internal/resumable_streaming_read_rpc.h",
+                   "google/cloud/internal/retry_loop.h",
+                   "absl/memory/memory.h"});
   CcSystemIncludes({"memory"});
   CcPrint("\n");
 
@@ -232,7 +302,61 @@ Status ConnectionGenerator::GenerateCc() {
                      // clang-format on
                  },
              },
-             All(IsNonStreaming, Not(IsLongrunningOperation), IsPaginated))},
+             All(IsNonStreaming, Not(IsLongrunningOperation), IsPaginated)),
+         MethodPattern(
+             {
+                 // clang-format off
+   {"$method_name$Stream $connection_class_name$::$method_name$(\n"
+    "    $request_type$ const&) {\n"
+    "  return google::cloud::internal::MakeStreamRange<$response_type$>(\n"
+    "      []() -> absl::variant<Status, $response_type$> {\n"
+    "        return Status(StatusCode::kUnimplemented, \"not implemented\");\n"
+    "      });\n"
+    "}\n\n"},
+                 // clang-format on
+             },
+             IsStreamingRead),
+         MethodPattern(
+             {
+                 // clang-format off
+   {"std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<\n"
+    "    $request_type$,\n"
+    "    $response_type$>>\n"
+    "$connection_class_name$::Async$method_name$() {\n"
+    "  return absl::make_unique<\n"
+    "      google::cloud::internal::AsyncStreamingReadWriteRpcError<\n"
+    "          $request_type$,\n"
+    "          $response_type$>>(\n"
+    "      Status(StatusCode::kUnimplemented, \"not implemented\"));\n"
+    "}\n\n"},
+                 // clang-format on
+             },
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    CcPrintMethod(
+        method,
+        {MethodPattern(
+            {
+                {IsResponseTypeEmpty,
+                 // clang-format off
+    "future<Status>\n",
+    "future<StatusOr<$response_type$>>\n"},
+   {"$connection_class_name$::Async$method_name$(\n"
+    "    $request_type$ const&) {\n"},
+   {IsResponseTypeEmpty,
+    "  return google::cloud::make_ready_future(\n",
+    "  return google::cloud::make_ready_future<\n"
+    "    StatusOr<$response_type$>>(\n"},
+   {"    Status(StatusCode::kUnimplemented, \"not implemented\"));\n"
+    "}\n\n"
+    },
+                // clang-format on
+            },
+            All(IsNonStreaming, Not(IsLongrunningOperation),
+                Not(IsPaginated)))},
         __FILE__, __LINE__);
   }
 
@@ -270,28 +394,42 @@ Status ConnectionGenerator::GenerateCc() {
       "  explicit $connection_class_name$Impl(\n"
       "      std::shared_ptr<$product_internal_namespace$::$stub_class_name$> "
       "stub,\n"
+      "      std::unique_ptr<BackgroundThreads> background_threads,\n"
       "      std::unique_ptr<RetryPolicy> retry_policy,\n"
       "      std::unique_ptr<BackoffPolicy> backoff_policy,\n"
       "      std::unique_ptr<PollingPolicy> polling_policy,\n"
       "      std::unique_ptr<DatabaseAdminConnectionIdempotencyPolicy> "
-      "idempotency_policy)\n"
+      "idempotency_policy,\n"
+      "      std::shared_ptr<RetryBudget> retry_budget = {},\n"
+      "      BackoffSleeper backoff_sleeper = {})\n"
       "      : stub_(std::move(stub)),\n"
+      "        background_threads_(std::move(background_threads)),\n"
       "        retry_policy_prototype_(std::move(retry_policy)),\n"
       "        backoff_policy_prototype_(std::move(backoff_policy)),\n"
       "        polling_policy_prototype_(std::move(polling_policy)),\n"
-      "        idempotency_policy_(std::move(idempotency_policy)) {}\n"
+      "        idempotency_policy_(std::move(idempotency_policy)),\n"
+      "        retry_budget_(std::move(retry_budget)),\n"
+      "        backoff_sleeper_(std::move(backoff_sleeper)) {}\n"
       "\n"
       "  explicit $connection_class_name$Impl(\n"
       "      std::shared_ptr<$product_internal_namespace$::$stub_class_name$> "
-      "stub)\n"
+      "stub,\n"
+      "      std::unique_ptr<BackgroundThreads> background_threads,\n"
+      "      std::shared_ptr<RetryBudget> retry_budget = {},\n"
+      "      BackoffSleeper backoff_sleeper = {})\n"
       "      : $connection_class_name$Impl(\n"
-      "          std::move(stub),\n"
+      "          std::move(stub), std::move(background_threads),\n"
       "          DefaultRetryPolicy(),\n"
       "          DefaultBackoffPolicy(),\n"
       "          DefaultPollingPolicy(),\n"
-      "          MakeDefaultDatabaseAdminConnectionIdempotencyPolicy()) {}\n"
+      "          MakeDefaultDatabaseAdminConnectionIdempotencyPolicy(),\n"
+      "          std::move(retry_budget), std::move(backoff_sleeper)) {}\n"
       "\n"
-      "  ~$connection_class_name$Impl() override = default;\n\n");
+      "  // Stop polling any pending operations, otherwise releasing the\n"
+      "  // background threads would block until their next polling timer.\n"
+      "  ~$connection_class_name$Impl() override {\n"
+      "    polling_loops_.Shutdown();\n"
+      "  }\n\n");
   //  clang-format on
 
   for (auto const& method : methods()) {
@@ -312,7 +450,7 @@ Status ConnectionGenerator::GenerateCc() {
     "            $request_type$ const& request) {\n"
     "          return stub_->$method_name$(context, request);\n"
     "        },\n"
-    "        request, __func__);\n"
+    "        request, __func__, retry_budget_, backoff_sleeper_);\n"
     "}\n"
     "\n",}
                  // clang-format on
@@ -334,7 +472,7 @@ Status ConnectionGenerator::GenerateCc() {
     "               $request_type$ const& request) {\n"
     "          return stub_->$method_name$(context, request);\n"
     "        },\n"
-    "        request, __func__);\n"
+    "        request, __func__, retry_budget_, backoff_sleeper_);\n"
     "    if (!operation) {\n"
     "      return google::cloud::make_ready_future(\n"
     "          StatusOr<$longrunning_deduced_response_type$>(operation.status()));\n"
@@ -358,10 +496,12 @@ Status ConnectionGenerator::GenerateCc() {
     "    auto backoff = std::shared_ptr<BackoffPolicy const>(\n"
     "        backoff_policy_prototype_->clone());\n"
     "    auto idempotency = idempotency_policy_->$method_name$(request);\n"
+    "    auto budget = retry_budget_;\n"
+    "    auto sleeper = backoff_sleeper_;\n"
     "    char const* function_name = __func__;\n"
     "    return $method_name$Range(\n"
     "        std::move(request),\n"
-    "        [stub, retry, backoff, idempotency, function_name]\n"
+    "        [stub, retry, backoff, idempotency, budget, sleeper, function_name]\n"
     "          ($request_type$ const& r) {\n"
     "          return google::cloud::internal::RetryLoop(\n"
     "              retry->clone(), backoff->clone(), idempotency,\n"
@@ -369,7 +509,7 @@ Status ConnectionGenerator::GenerateCc() {
     "                     $request_type$ const& request) {\n"
     "                return stub->$method_name$(context, request);\n"
     "              },\n"
-    "              r, function_name);\n"
+    "              r, function_name, budget, sleeper);\n"
     "        },\n"
     "        []($response_type$ r) {\n"
     "          std::vector<$range_output_type$> result(r.$range_output_field_name$().size());\n"
@@ -381,7 +521,75 @@ Status ConnectionGenerator::GenerateCc() {
                      // clang-format on
                  },
              },
-             All(IsNonStreaming, Not(IsLongrunningOperation), IsPaginated))},
+             All(IsNonStreaming, Not(IsLongrunningOperation), IsPaginated)),
+         MethodPattern(
+             {
+                 // clang-format off
+   {"  $method_name$Stream $method_name$(\n"
+    "      $request_type$ const& request) override {\n"
+    "    auto stub = stub_;\n"
+    "    auto factory = [stub]($request_type$ const& request) {\n"
+    "      return stub->$method_name$(\n"
+    "          absl::make_unique<grpc::ClientContext>(), request);\n"
+    "    };\n"
+    "    std::shared_ptr<google::cloud::internal::StreamingReadRpc<\n"
+    "        $response_type$>>\n"
+    "        stream = google::cloud::internal::MakeResumableStreamingReadRpc<\n"
+    "            $response_type$,\n"
+    "            $request_type$>(\n"
+    "            retry_policy_prototype_->clone(),\n"
+    "            backoff_policy_prototype_->clone(), std::move(factory),\n"
+    "            $service_name$$method_name$StreamingUpdater, request);\n"
+    "    return google::cloud::internal::MakeStreamRange<$response_type$>(\n"
+    "        [stream] { return stream->Read(); });\n"
+    "  }\n\n"},
+                 // clang-format on
+             },
+             IsStreamingRead),
+         MethodPattern(
+             {
+                 // clang-format off
+   {"  std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<\n"
+    "      $request_type$,\n"
+    "      $response_type$>>\n"
+    "  Async$method_name$() override {\n"
+    "    auto cq = background_threads_->cq();\n"
+    "    return stub_->Async$method_name$(\n"
+    "        cq, absl::make_unique<grpc::ClientContext>());\n"
+    "  }\n\n"},
+                 // clang-format on
+             },
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    CcPrintMethod(
+        method,
+        {MethodPattern(
+            {
+                {IsResponseTypeEmpty,
+                 // clang-format off
+    "  future<Status>\n",
+    "  future<StatusOr<$response_type$>>\n"},
+   {"  Async$method_name$(\n"
+    "      $request_type$ const& request) override {\n"
+    "    auto stub = stub_;\n"
+    "    return google::cloud::internal::AsyncRetryLoop(\n"
+    "        retry_policy_prototype_->clone(), backoff_policy_prototype_->clone(),\n"
+    "        idempotency_policy_->$method_name$(request),\n"
+    "        background_threads_->cq(),\n"
+    "        [stub](CompletionQueue& cq,\n"
+    "               std::unique_ptr<grpc::ClientContext> context,\n"
+    "               $request_type$ const& request) {\n"
+    "          return stub->Async$method_name$(cq, std::move(context), request);\n"
+    "        },\n"
+    "        request, __func__, retry_budget_);\n"
+    "  }\n\n"},
+                // clang-format on
+            },
+            All(IsNonStreaming, Not(IsLongrunningOperation),
+                Not(IsPaginated)))},
         __FILE__, __LINE__);
   }
 
@@ -389,47 +597,31 @@ Status ConnectionGenerator::GenerateCc() {
     " private:\n");
   // clang-format on
 
-  // TODO(#4038) - use the (implicit) completion queue to run this loop, and
-  // once using a completion queue, consider changing to AsyncCancelOperation.
+  // The loop waits on completion queue timers between polls, so awaiting an
+  // operation does not dedicate a thread to it. Destroying the connection
+  // stops the loop, and satisfies the future with a `kCancelled` error.
   CcPrint(  // clang-format off
     "  template <typename MethodResponse, template<typename> class Extractor,\n"
     "    typename Stub>\n"
     "  future<StatusOr<MethodResponse>>\n"
     "  AwaitLongrunningOperation(google::longrunning::Operation operation) {  // NOLINT\n"
-    "    using ResponseExtractor = Extractor<MethodResponse>;\n"
-    "    std::weak_ptr<Stub> cancel_stub(stub_);\n"
-    "    promise<typename ResponseExtractor::ReturnType> pr(\n"
-    "        [cancel_stub, operation]() {\n"
-    "          grpc::ClientContext context;\n"
-    "          context.set_deadline(std::chrono::system_clock::now() +\n"
+    "    std::shared_ptr<Stub> stub = stub_;\n"
+    "    return google::cloud::internal::AsyncAwaitLongRunningOperation<\n"
+    "        Extractor<MethodResponse>>(\n"
+    "        background_threads_->cq(), std::move(operation),\n"
+    "        [stub](google::cloud::CompletionQueue& cq,\n"
+    "               std::unique_ptr<grpc::ClientContext> context,\n"
+    "               google::longrunning::GetOperationRequest const& request) {\n"
+    "          return stub->AsyncGetOperation(cq, std::move(context), request);\n"
+    "        },\n"
+    "        [stub](google::cloud::CompletionQueue& cq,\n"
+    "               std::unique_ptr<grpc::ClientContext> context,\n"
+    "               google::longrunning::CancelOperationRequest const& request) {\n"
+    "          context->set_deadline(std::chrono::system_clock::now() +\n"
     "            std::chrono::seconds(60));\n"
-    "          google::longrunning::CancelOperationRequest request;\n"
-    "          request.set_name(operation.name());\n"
-    "          if (auto ptr = cancel_stub.lock()) {\n"
-    "            ptr->CancelOperation(context, request);\n"
-    "          }\n"
-    "    });\n"
-    "    auto f = pr.get_future();\n"
-    "    std::thread t(\n"
-    "        [](std::shared_ptr<Stub> stub,\n"
-    "           google::longrunning::Operation operation,\n"
-    "           std::unique_ptr<PollingPolicy> polling_policy,\n"
-    "           google::cloud::promise<typename ResponseExtractor::ReturnType> promise,\n"
-    "           char const* location) mutable {\n"
-    "          auto result = google::cloud::internal::PollingLoop<ResponseExtractor>(\n"
-    "              std::move(polling_policy),\n"
-    "              [stub](grpc::ClientContext& context,\n"
-    "                     google::longrunning::GetOperationRequest const& request) {\n"
-    "                return stub->GetOperation(context, request);\n"
-    "              },\n"
-    "              std::move(operation), location);\n"
-    "          stub.reset();\n"
-    "          promise.set_value(std::move(result));\n"
+    "          return stub->AsyncCancelOperation(cq, std::move(context), request);\n"
     "        },\n"
-    "        stub_, std::move(operation), polling_policy_prototype_->clone(),\n"
-    "        std::move(pr), __func__);\n"
-    "    t.detach();\n"
-    "    return f;\n"
+    "        polling_policy_prototype_->clone(), __func__, &polling_loops_);\n"
     "  }\n\n"
       );
   // clang-format on
@@ -460,10 +652,14 @@ Status ConnectionGenerator::GenerateCc() {
 
   CcPrint(  // clang-format off
     "  std::shared_ptr<$product_internal_namespace$::$stub_class_name$> stub_;\n"
+    "  std::unique_ptr<BackgroundThreads> background_threads_;\n"
     "  std::unique_ptr<RetryPolicy const> retry_policy_prototype_;\n"
     "  std::unique_ptr<BackoffPolicy const> backoff_policy_prototype_;\n"
     "  std::unique_ptr<PollingPolicy const> polling_policy_prototype_;\n"
     "  std::unique_ptr<DatabaseAdminConnectionIdempotencyPolicy> idempotency_policy_;\n"
+    "  std::shared_ptr<RetryBudget> retry_budget_;\n"
+    "  BackoffSleeper backoff_sleeper_;\n"
+    "  google::cloud::internal::AsyncPollingLoopGroup polling_loops_;\n"
     "};\n");
   // clang-format on
 
@@ -473,7 +669,9 @@ Status ConnectionGenerator::GenerateCc() {
     "std::shared_ptr<$connection_class_name$> Make$connection_class_name$(\n"
     "    ConnectionOptions const& options) {\n"
     "  return std::make_shared<$connection_class_name$Impl>(\n"
-    "      $product_internal_namespace$::CreateDefault$stub_class_name$(options));\n"
+    "      $product_internal_namespace$::CreateDefault$stub_class_name$(options),\n"
+    "      options.background_threads_factory()(), options.retry_budget(),\n"
+    "      options.backoff_sleeper());\n"
     "}\n\n");
   // clang-format on
 
@@ -486,8 +684,10 @@ Status ConnectionGenerator::GenerateCc() {
     "    std::unique_ptr<DatabaseAdminConnectionIdempotencyPolicy> idempotency_policy) {\n"
     "  return std::make_shared<$connection_class_name$Impl>(\n"
     "      $product_internal_namespace$::CreateDefault$stub_class_name$(options),\n"
+    "      options.background_threads_factory()(),\n"
     "      std::move(retry_policy), std::move(backoff_policy),\n"
-    "      std::move(polling_policy), std::move(idempotency_policy));\n"
+    "      std::move(polling_policy), std::move(idempotency_policy),\n"
+    "      options.retry_budget(), options.backoff_sleeper());\n"
     "}\n\n");
   // clang-format on
 
@@ -499,7 +699,8 @@ Status ConnectionGenerator::GenerateCc() {
     "    std::unique_ptr<PollingPolicy> polling_policy,\n"
     "    std::unique_ptr<DatabaseAdminConnectionIdempotencyPolicy> idempotency_policy) {\n"
     "  return std::make_shared<$connection_class_name$Impl>(\n"
-    "      std::move(stub), std::move(retry_policy), std::move(backoff_policy),\n"
+    "      std::move(stub), google::cloud::internal::DefaultBackgroundThreads(1),\n"
+    "      std::move(retry_policy), std::move(backoff_policy),\n"
     "      std::move(polling_policy), std::move(idempotency_policy));\n"
     "}\n\n");
   // clang-format on
@@ -22,6 +22,7 @@
 #include "generator/internal/idempotency_policy_generator.h"
 #include "generator/internal/logging_decorator_generator.h"
 #include "generator/internal/metadata_decorator_generator.h"
+#include "generator/internal/metrics_decorator_generator.h"
 #include "generator/internal/predicate_utils.h"
 #include "generator/internal/retry_policy_generator.h"
 #include "generator/internal/stub_factory_generator.h"
@@ -241,6 +242,15 @@ VarsDictionary CreateServiceVars(
       absl::StrCat(vars["product_path"], "internal/",
                    ServiceNameToFilePath(descriptor.name()),
                    "_metadata_decorator", GeneratedFileSuffix(), ".h");
+  vars["metrics_class_name"] = absl::StrCat(descriptor.name(), "Metrics");
+  vars["metrics_cc_path"] =
+      absl::StrCat(vars["product_path"], "internal/",
+                   ServiceNameToFilePath(descriptor.name()),
+                   "_metrics_decorator", GeneratedFileSuffix(), ".cc");
+  vars["metrics_header_path"] =
+      absl::StrCat(vars["product_path"], "internal/",
+                   ServiceNameToFilePath(descriptor.name()),
+                   "_metrics_decorator", GeneratedFileSuffix(), ".h");
   vars["product_namespace"] = BuildNamespaces(vars["product_path"])[2];
   vars["product_internal_namespace"] =
       BuildNamespaces(vars["product_path"], NamespaceType::kInternal)[2];
@@ -253,6 +263,7 @@ VarsDictionary CreateServiceVars(
       absl::StrCat(vars["product_path"], "retry_traits", ".h");
   vars["service_endpoint"] =
       descriptor.options().GetExtension(google::api::default_host);
+  vars["service_name"] = descriptor.name();
   vars["stub_class_name"] = absl::StrCat(descriptor.name(), "Stub");
   vars["stub_cc_path"] = absl::StrCat(vars["product_path"], "internal/",
                                       ServiceNameToFilePath(descriptor.name()),
@@ -320,6 +331,9 @@ std::vector<std::unique_ptr<GeneratorInterface>> MakeGenerators(
   code_generators.push_back(absl::make_unique<MetadataDecoratorGenerator>(
       service, CreateServiceVars(*service, vars), CreateMethodVars(*service),
       context));
+  code_generators.push_back(absl::make_unique<MetricsDecoratorGenerator>(
+      service, CreateServiceVars(*service, vars), CreateMethodVars(*service),
+      context));
   code_generators.push_back(absl::make_unique<RetryPolicyGenerator>(
       service, CreateServiceVars(*service, vars), CreateMethodVars(*service),
       context));
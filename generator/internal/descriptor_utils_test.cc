@@ -104,6 +104,13 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_pair("metadata_header_path",
                        "google/cloud/frobber/internal/"
                        "frobber_metadata_decorator.gcpcxx.pb.h"),
+        std::make_pair("metrics_class_name", "FrobberServiceMetrics"),
+        std::make_pair("metrics_cc_path",
+                       "google/cloud/frobber/internal/"
+                       "frobber_metrics_decorator.gcpcxx.pb.cc"),
+        std::make_pair("metrics_header_path",
+                       "google/cloud/frobber/internal/"
+                       "frobber_metrics_decorator.gcpcxx.pb.h"),
         std::make_pair("product_namespace", "frobber"),
         std::make_pair("product_internal_namespace", "frobber_internal"),
         std::make_pair("proto_file_name",
@@ -115,6 +122,7 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_pair("retry_traits_header_path",
                        "google/cloud/frobber/retry_traits.h"),
         std::make_pair("service_endpoint", ""),
+        std::make_pair("service_name", "FrobberService"),
         std::make_pair("stub_class_name", "FrobberServiceStub"),
         std::make_pair(
             "stub_cc_path",
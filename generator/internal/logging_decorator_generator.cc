@@ -77,7 +77,44 @@ Status LoggingDecoratorGenerator::GenerateHeader() {
     "    $request_type$ const& request) override;\n"
                          // clang-format on
                          "\n"}},
-                       IsNonStreaming)},
+                       IsNonStreaming),
+         MethodPattern(
+             {  // clang-format off
+   {"  std::unique_ptr<google::cloud::internal::StreamingReadRpc<$response_type$>>\n"
+    "  $method_name$(\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) override;\n"
+    "\n"}},
+             // clang-format on
+             IsStreamingRead),
+         MethodPattern(
+             {  // clang-format off
+   {"  std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<\n"
+    "      $request_type$,\n"
+    "      $response_type$>>\n"
+    "  Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context) override;\n"
+    "\n"}},
+             // clang-format on
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    HeaderPrintMethod(
+        method,
+        {MethodPattern({{IsResponseTypeEmpty,
+                         // clang-format off
+    "  future<Status> Async$method_name$(\n",
+    "  future<StatusOr<$response_type$>> Async$method_name$(\n"},
+   {"    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) override;\n"
+                         // clang-format on
+                         "\n"}},
+                       All(IsNonStreaming, Not(IsLongrunningOperation),
+                           Not(IsPaginated)))},
         __FILE__, __LINE__);
   }
 
@@ -93,6 +130,20 @@ Status LoggingDecoratorGenerator::GenerateHeader() {
     "      grpc::ClientContext& context,\n"
     "      google::longrunning::CancelOperationRequest const& request) "
     "override;\n"
+    "\n"
+    "  /// Poll a long-running operation asynchronously.\n"
+    "  future<StatusOr<google::longrunning::Operation>> AsyncGetOperation(\n"
+    "      google::cloud::CompletionQueue& cq,\n"
+    "      std::unique_ptr<grpc::ClientContext> context,\n"
+    "      google::longrunning::GetOperationRequest const& request) "
+    "override;\n"
+    "\n"
+    "  /// Cancel a long-running operation asynchronously.\n"
+    "  future<Status> AsyncCancelOperation(\n"
+    "      google::cloud::CompletionQueue& cq,\n"
+    "      std::unique_ptr<grpc::ClientContext> context,\n"
+    "      google::longrunning::CancelOperationRequest const& request) "
+    "override;\n"
     "\n");
   // clang-format on
 
@@ -163,7 +214,70 @@ Status LoggingDecoratorGenerator::GenerateCc() {
     "}\n"
     "\n"}},
             // clang-format on
-            IsNonStreaming)},
+            IsNonStreaming),
+         MethodPattern(
+             {  // clang-format off
+   {"std::unique_ptr<google::cloud::internal::StreamingReadRpc<$response_type$>>\n"
+    "$logging_class_name$::$method_name$(\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) {\n"
+    "  return google::cloud::internal::LogWrapper(\n"
+    "      [this](std::unique_ptr<grpc::ClientContext> context,\n"
+    "             $request_type$ const& request) {\n"
+    "        return child_->$method_name$(std::move(context), request);\n"
+    "      },\n"
+    "      std::move(context), request, __func__, tracing_options_);\n"
+    "}\n"
+    "\n"}},
+             // clang-format on
+             IsStreamingRead),
+         MethodPattern(
+             {  // clang-format off
+   {"std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<\n"
+    "    $request_type$,\n"
+    "    $response_type$>>\n"
+    "$logging_class_name$::Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context) {\n"
+    "  return google::cloud::internal::LogWrapper(\n"
+    "      [this](google::cloud::CompletionQueue& cq,\n"
+    "             std::unique_ptr<grpc::ClientContext> context) {\n"
+    "        return child_->Async$method_name$(cq, std::move(context));\n"
+    "      },\n"
+    "      cq, std::move(context), __func__, tracing_options_);\n"
+    "}\n"
+    "\n"}},
+             // clang-format on
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    CcPrintMethod(
+        method,
+        {MethodPattern(
+            {{IsResponseTypeEmpty,
+              // clang-format off
+    "future<Status>\n",
+    "future<StatusOr<$response_type$>>\n"},
+    {
+    "$logging_class_name$::Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) {\n"
+    "  return google::cloud::internal::LogWrapper(\n"
+    "      [this](google::cloud::CompletionQueue& cq,\n"
+    "             std::unique_ptr<grpc::ClientContext> context,\n"
+    "             $request_type$ const& request) {\n"
+    "        return child_->Async$method_name$(\n"
+    "            cq, std::move(context), request);\n"
+    "      },\n"
+    "      cq, std::move(context), request, __func__, tracing_options_);\n"
+    "}\n"
+    "\n"}},
+            // clang-format on
+            All(IsNonStreaming, Not(IsLongrunningOperation),
+                Not(IsPaginated)))},
         __FILE__, __LINE__);
   }
 
@@ -189,6 +303,34 @@ Status LoggingDecoratorGenerator::GenerateCc() {
     "        return child_->CancelOperation(context, request);\n"
     "      },\n"
     "      context, request, __func__, tracing_options_);\n"
+    "}\n"
+    "\n"
+    "future<StatusOr<google::longrunning::Operation>>\n"
+    "$logging_class_name$::AsyncGetOperation(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    google::longrunning::GetOperationRequest const& request) {\n"
+    "  return google::cloud::internal::LogWrapper(\n"
+    "      [this](google::cloud::CompletionQueue& cq,\n"
+    "             std::unique_ptr<grpc::ClientContext> context,\n"
+    "             google::longrunning::GetOperationRequest const& request) {\n"
+    "        return child_->AsyncGetOperation(cq, std::move(context), request);\n"
+    "      },\n"
+    "      cq, std::move(context), request, __func__, tracing_options_);\n"
+    "}\n"
+    "\n"
+    "future<Status> $logging_class_name$::AsyncCancelOperation(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    google::longrunning::CancelOperationRequest const& request) {\n"
+    "  return google::cloud::internal::LogWrapper(\n"
+    "      [this](google::cloud::CompletionQueue& cq,\n"
+    "             std::unique_ptr<grpc::ClientContext> context,\n"
+    "             google::longrunning::CancelOperationRequest const& request) {\n"
+    "        return child_->AsyncCancelOperation(cq, std::move(context),\n"
+    "                                            request);\n"
+    "      },\n"
+    "      cq, std::move(context), request, __func__, tracing_options_);\n"
     "}\n"
             // clang-format on
   );
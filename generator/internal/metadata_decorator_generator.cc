@@ -22,6 +22,7 @@
 #include "generator/internal/printer.h"
 #include <google/api/client.pb.h>
 #include <google/protobuf/descriptor.h>
+#include <algorithm>
 
 namespace google {
 namespace cloud {
@@ -36,6 +37,13 @@ MetadataDecoratorGenerator::MetadataDecoratorGenerator(
                            service_descriptor, std::move(service_vars),
                            std::move(service_method_vars), context) {}
 
+bool MetadataDecoratorGenerator::HasBidirStreamingMethod() const {
+  return std::any_of(methods().begin(), methods().end(),
+                     [](google::protobuf::MethodDescriptor const& m) {
+                       return IsBidirStreaming(m);
+                     });
+}
+
 Status MetadataDecoratorGenerator::GenerateHeader() {
   HeaderPrint(CopyrightLicenseFileHeader());
   HeaderPrint(  // clang-format off
@@ -76,7 +84,44 @@ Status MetadataDecoratorGenerator::GenerateHeader() {
     "    $request_type$ const& request) override;\n"
                          // clang-format on
                          "\n"}},
-                       IsNonStreaming)},
+                       IsNonStreaming),
+         MethodPattern(
+             {  // clang-format off
+   {"  std::unique_ptr<google::cloud::internal::StreamingReadRpc<$response_type$>>\n"
+    "  $method_name$(\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) override;\n"
+    "\n"}},
+             // clang-format on
+             IsStreamingRead),
+         MethodPattern(
+             {  // clang-format off
+   {"  std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<\n"
+    "      $request_type$,\n"
+    "      $response_type$>>\n"
+    "  Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context) override;\n"
+    "\n"}},
+             // clang-format on
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    HeaderPrintMethod(
+        method,
+        {MethodPattern({{IsResponseTypeEmpty,
+                         // clang-format off
+    "  future<Status> Async$method_name$(\n",
+    "  future<StatusOr<$response_type$>> Async$method_name$(\n"},
+   {"    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) override;\n"
+                         // clang-format on
+                         "\n"}},
+                       All(IsNonStreaming, Not(IsLongrunningOperation),
+                           Not(IsPaginated)))},
         __FILE__, __LINE__);
   }
 
@@ -92,13 +137,33 @@ Status MetadataDecoratorGenerator::GenerateHeader() {
     "      grpc::ClientContext& context,\n"
     "      google::longrunning::CancelOperationRequest const& request) "
     "override;\n"
+    "\n"
+    "  /// Poll a long-running operation asynchronously.\n"
+    "  future<StatusOr<google::longrunning::Operation>> AsyncGetOperation(\n"
+    "      google::cloud::CompletionQueue& cq,\n"
+    "      std::unique_ptr<grpc::ClientContext> context,\n"
+    "      google::longrunning::GetOperationRequest const& request) "
+    "override;\n"
+    "\n"
+    "  /// Cancel a long-running operation asynchronously.\n"
+    "  future<Status> AsyncCancelOperation(\n"
+    "      google::cloud::CompletionQueue& cq,\n"
+    "      std::unique_ptr<grpc::ClientContext> context,\n"
+    "      google::longrunning::CancelOperationRequest const& request) "
+    "override;\n"
     "\n");
   // clang-format on
 
   HeaderPrint(  // clang-format off
     " private:\n"
     "  void SetMetadata(grpc::ClientContext& context,\n"
-    "                   std::string const& request_params);\n"
+    "                   std::string const& request_params);\n");
+  // clang-format on
+  // Bidirectional streams have no request to extract routing parameters from.
+  if (HasBidirStreamingMethod()) {
+    HeaderPrint("  void SetMetadata(grpc::ClientContext& context);\n");
+  }
+  HeaderPrint(  // clang-format off
     "  std::shared_ptr<$stub_class_name$> child_;\n"
     "  std::string api_client_header_;\n"
     "};  // $metadata_class_name$\n"
@@ -175,7 +240,55 @@ Status MetadataDecoratorGenerator::GenerateCc() {
                 // clang-format on
             },
             // clang-format on
-            IsNonStreaming)},
+            IsNonStreaming),
+         MethodPattern(
+             {  // clang-format off
+   {"std::unique_ptr<google::cloud::internal::StreamingReadRpc<$response_type$>>\n"
+    "$metadata_class_name$::$method_name$(\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) {\n"
+    "  SetMetadata(*context, \"$method_request_param_key$=\" + request.$method_request_param_value$);\n"
+    "  return child_->$method_name$(std::move(context), request);\n"
+    "}\n"
+    "\n"}},
+             // clang-format on
+             IsStreamingRead),
+         MethodPattern(
+             {  // clang-format off
+   {"std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<\n"
+    "    $request_type$,\n"
+    "    $response_type$>>\n"
+    "$metadata_class_name$::Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context) {\n"
+    "  SetMetadata(*context);\n"
+    "  return child_->Async$method_name$(cq, std::move(context));\n"
+    "}\n"
+    "\n"}},
+             // clang-format on
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    CcPrintMethod(
+        method,
+        {MethodPattern(
+            {{IsResponseTypeEmpty,
+              // clang-format off
+    "future<Status>\n",
+    "future<StatusOr<$response_type$>>\n"},
+   {"$metadata_class_name$::Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) {\n"
+    "  SetMetadata(*context, \"$method_request_param_key$=\" + request.$method_request_param_value$);\n"
+    "  return child_->Async$method_name$(cq, std::move(context), request);\n"
+    "}\n"
+    "\n"}},
+            // clang-format on
+            All(IsNonStreaming, Not(IsLongrunningOperation),
+                Not(IsPaginated)))},
         __FILE__, __LINE__);
   }
 
@@ -193,6 +306,22 @@ Status MetadataDecoratorGenerator::GenerateCc() {
       "    google::longrunning::CancelOperationRequest const& request) {\n"
       "  SetMetadata(context, \"name=\" + request.name());\n"
       "  return child_->CancelOperation(context, request);\n"
+      "}\n\n"
+      "future<StatusOr<google::longrunning::Operation>>\n"
+      "$metadata_class_name$::AsyncGetOperation(\n"
+      "    google::cloud::CompletionQueue& cq,\n"
+      "    std::unique_ptr<grpc::ClientContext> context,\n"
+      "    google::longrunning::GetOperationRequest const& request) {\n"
+      "  SetMetadata(*context, \"name=\" + request.name());\n"
+      "  return child_->AsyncGetOperation(cq, std::move(context), request);\n"
+      "}\n"
+      "\n"
+      "future<Status> $metadata_class_name$::AsyncCancelOperation(\n"
+      "    google::cloud::CompletionQueue& cq,\n"
+      "    std::unique_ptr<grpc::ClientContext> context,\n"
+      "    google::longrunning::CancelOperationRequest const& request) {\n"
+      "  SetMetadata(*context, \"name=\" + request.name());\n"
+      "  return child_->AsyncCancelOperation(cq, std::move(context), request);\n"
       "}\n\n"
             // clang-format on
   );
@@ -207,6 +336,15 @@ Status MetadataDecoratorGenerator::GenerateCc() {
             // clang-format on
   );
 
+  if (HasBidirStreamingMethod()) {
+    CcPrint(  // clang-format off
+    "void $metadata_class_name$::SetMetadata(grpc::ClientContext& context) {\n"
+    "  context.AddMetadata(\"x-goog-api-client\", api_client_header_);\n"
+    "}\n\n"
+              // clang-format on
+    );
+  }
+
   CcCloseNamespaces();
   return {};
 }
@@ -50,6 +50,8 @@ class MetadataDecoratorGenerator : public ServiceCodeGenerator {
  private:
   Status GenerateHeader() override;
   Status GenerateCc() override;
+
+  bool HasBidirStreamingMethod() const;
 };
 
 }  // namespace generator_internal
@@ -0,0 +1,344 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "generator/internal/metrics_decorator_generator.h"
+#include "google/cloud/internal/absl_str_cat_quiet.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_split.h"
+#include "generator/internal/codegen_utils.h"
+#include "generator/internal/descriptor_utils.h"
+#include "generator/internal/predicate_utils.h"
+#include "generator/internal/printer.h"
+#include <google/api/client.pb.h>
+#include <google/protobuf/descriptor.h>
+
+namespace google {
+namespace cloud {
+namespace generator_internal {
+
+MetricsDecoratorGenerator::MetricsDecoratorGenerator(
+    google::protobuf::ServiceDescriptor const* service_descriptor,
+    VarsDictionary service_vars,
+    std::map<std::string, VarsDictionary> service_method_vars,
+    google::protobuf::compiler::GeneratorContext* context)
+    : ServiceCodeGenerator("metrics_header_path", "metrics_cc_path",
+                           service_descriptor, std::move(service_vars),
+                           std::move(service_method_vars), context) {}
+
+Status MetricsDecoratorGenerator::GenerateHeader() {
+  HeaderPrint(CopyrightLicenseFileHeader());
+  HeaderPrint(  // clang-format off
+    "// Generated by the Codegen C++ plugin.\n"
+    "// If you make any local changes, they will be lost.\n"
+    "// source: $proto_file_name$\n"
+    "#ifndef $header_include_guard$\n"
+    "#define $header_include_guard$\n"
+    "\n");
+  // clang-format on
+
+  // includes
+  HeaderLocalIncludes({vars("stub_header_path"),
+                       "google/cloud/rpc_metrics.h",
+                       "google/cloud/version.h"});
+  HeaderSystemIncludes({"string", "memory"});
+
+  auto result = HeaderOpenNamespaces(NamespaceType::kInternal);
+  if (!result.ok()) return result;
+
+  // Metrics decorator class
+  HeaderPrint(  // clang-format off
+    "class $metrics_class_name$ : public $stub_class_name$ {\n"
+    " public:\n"
+    "  ~$metrics_class_name$() override = default;\n"
+    "  $metrics_class_name$(std::shared_ptr<$stub_class_name$> child,\n"
+    "                       std::shared_ptr<RpcMetricsSink> sink);\n"
+    "\n");
+  // clang-format on
+
+  for (auto const& method : methods()) {
+    HeaderPrintMethod(
+        method,
+        {MethodPattern({{IsResponseTypeEmpty,
+                         // clang-format off
+    "  Status $method_name$(\n",
+    "  StatusOr<$response_type$> $method_name$(\n"},
+   {"    grpc::ClientContext& context,\n"
+    "    $request_type$ const& request) override;\n"
+                         // clang-format on
+                         "\n"}},
+                       IsNonStreaming),
+         MethodPattern(
+             {  // clang-format off
+   {"  std::unique_ptr<google::cloud::internal::StreamingReadRpc<$response_type$>>\n"
+    "  $method_name$(\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) override;\n"
+    "\n"}},
+             // clang-format on
+             IsStreamingRead),
+         MethodPattern(
+             {  // clang-format off
+   {"  std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<\n"
+    "      $request_type$,\n"
+    "      $response_type$>>\n"
+    "  Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context) override;\n"
+    "\n"}},
+             // clang-format on
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    HeaderPrintMethod(
+        method,
+        {MethodPattern({{IsResponseTypeEmpty,
+                         // clang-format off
+    "  future<Status> Async$method_name$(\n",
+    "  future<StatusOr<$response_type$>> Async$method_name$(\n"},
+   {"    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) override;\n"
+                         // clang-format on
+                         "\n"}},
+                       All(IsNonStreaming, Not(IsLongrunningOperation),
+                           Not(IsPaginated)))},
+        __FILE__, __LINE__);
+  }
+
+  HeaderPrint(  // clang-format off
+    "  /// Poll a long-running operation.\n"
+    "  StatusOr<google::longrunning::Operation> GetOperation(\n"
+    "      grpc::ClientContext& context,\n"
+    "      google::longrunning::GetOperationRequest const& request) "
+    "override;\n"
+    "\n"
+    "  /// Cancel a long-running operation.\n"
+    "  Status CancelOperation(\n"
+    "      grpc::ClientContext& context,\n"
+    "      google::longrunning::CancelOperationRequest const& request) "
+    "override;\n"
+    "\n"
+    "  /// Poll a long-running operation asynchronously.\n"
+    "  future<StatusOr<google::longrunning::Operation>> AsyncGetOperation(\n"
+    "      google::cloud::CompletionQueue& cq,\n"
+    "      std::unique_ptr<grpc::ClientContext> context,\n"
+    "      google::longrunning::GetOperationRequest const& request) "
+    "override;\n"
+    "\n"
+    "  /// Cancel a long-running operation asynchronously.\n"
+    "  future<Status> AsyncCancelOperation(\n"
+    "      google::cloud::CompletionQueue& cq,\n"
+    "      std::unique_ptr<grpc::ClientContext> context,\n"
+    "      google::longrunning::CancelOperationRequest const& request) "
+    "override;\n"
+    "\n");
+  // clang-format on
+
+  HeaderPrint(  // clang-format off
+    " private:\n"
+    "  std::shared_ptr<$stub_class_name$> child_;\n"
+    "  std::shared_ptr<RpcMetricsSink> sink_;\n"
+    "};  // $metrics_class_name$\n"
+    "\n");
+  // clang-format on
+
+  HeaderCloseNamespaces();
+  // close header guard
+  HeaderPrint(  // clang-format off
+      "#endif  // $header_include_guard$\n");
+  // clang-format on
+  return {};
+}
+
+Status MetricsDecoratorGenerator::GenerateCc() {
+  CcPrint(CopyrightLicenseFileHeader());
+  CcPrint(  // clang-format off
+    "// Generated by the Codegen C++ plugin.\n"
+    "// If you make any local changes, they will be lost.\n"
+    "// source: $proto_file_name$\n\n");
+  // clang-format on
+
+  // includes
+  CcLocalIncludes(
+      {vars("metrics_header_path"), "google/cloud/grpc_error_delegate.h",
+       "google/cloud/internal/metrics_wrapper.h", "google/cloud/status_or.h"});
+  CcSystemIncludes({vars("proto_grpc_header_path"),
+                    "google/longrunning/operations.grpc.pb.h", "memory"});
+  CcPrint("\n");
+
+  auto result = CcOpenNamespaces(NamespaceType::kInternal);
+  if (!result.ok()) return result;
+
+  // constructor
+  CcPrint(  // clang-format off
+    "$metrics_class_name$::$metrics_class_name$(\n"
+    "    std::shared_ptr<$stub_class_name$> child,\n"
+    "    std::shared_ptr<RpcMetricsSink> sink)\n"
+    "    : child_(std::move(child)), sink_(std::move(sink)) {}\n"
+    "\n");
+  // clang-format on
+
+  // metrics decorator class member methods
+  for (auto const& method : methods()) {
+    CcPrintMethod(
+        method,
+        {MethodPattern(
+            {{IsResponseTypeEmpty,
+              // clang-format off
+    "Status\n",
+    "StatusOr<$response_type$>\n"},
+    {
+    "$metrics_class_name$::$method_name$(\n"
+    "    grpc::ClientContext& context,\n"
+    "    $request_type$ const& request) {\n"
+    "  return google::cloud::internal::MetricsWrapper(\n"
+    "      [this](grpc::ClientContext& context,\n"
+    "             $request_type$ const& request) {\n"
+    "        return child_->$method_name$(context, request);\n"
+    "      },\n"
+    "      context, request, \"$service_name$.$method_name$\", sink_);\n"
+    "}\n"
+    "\n"}},
+            // clang-format on
+            IsNonStreaming),
+         MethodPattern(
+             {  // clang-format off
+   {"std::unique_ptr<google::cloud::internal::StreamingReadRpc<$response_type$>>\n"
+    "$metrics_class_name$::$method_name$(\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) {\n"
+    "  return google::cloud::internal::MetricsWrapper(\n"
+    "      [this](std::unique_ptr<grpc::ClientContext> context,\n"
+    "             $request_type$ const& request) {\n"
+    "        return child_->$method_name$(std::move(context), request);\n"
+    "      },\n"
+    "      std::move(context), request, \"$service_name$.$method_name$\", sink_);\n"
+    "}\n"
+    "\n"}},
+             // clang-format on
+             IsStreamingRead),
+         MethodPattern(
+             {  // clang-format off
+   {"std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<\n"
+    "    $request_type$,\n"
+    "    $response_type$>>\n"
+    "$metrics_class_name$::Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context) {\n"
+    "  return google::cloud::internal::MetricsWrapper(\n"
+    "      [this](google::cloud::CompletionQueue& cq,\n"
+    "             std::unique_ptr<grpc::ClientContext> context) {\n"
+    "        return child_->Async$method_name$(cq, std::move(context));\n"
+    "      },\n"
+    "      cq, std::move(context), \"$service_name$.$method_name$\", sink_);\n"
+    "}\n"
+    "\n"}},
+             // clang-format on
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    CcPrintMethod(
+        method,
+        {MethodPattern(
+            {{IsResponseTypeEmpty,
+              // clang-format off
+    "future<Status>\n",
+    "future<StatusOr<$response_type$>>\n"},
+    {
+    "$metrics_class_name$::Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) {\n"
+    "  return google::cloud::internal::MetricsWrapper(\n"
+    "      [this](google::cloud::CompletionQueue& cq,\n"
+    "             std::unique_ptr<grpc::ClientContext> context,\n"
+    "             $request_type$ const& request) {\n"
+    "        return child_->Async$method_name$(\n"
+    "            cq, std::move(context), request);\n"
+    "      },\n"
+    "      cq, std::move(context), request, \"$service_name$.$method_name$\", sink_);\n"
+    "}\n"
+    "\n"}},
+            // clang-format on
+            All(IsNonStreaming, Not(IsLongrunningOperation),
+                Not(IsPaginated)))},
+        __FILE__, __LINE__);
+  }
+
+  // long running operation support methods
+  CcPrint(  // clang-format off
+    "StatusOr<google::longrunning::Operation> $metrics_class_name$::GetOperation(\n"
+    "    grpc::ClientContext& context,\n"
+    "    google::longrunning::GetOperationRequest const& request) {\n"
+    "  return google::cloud::internal::MetricsWrapper(\n"
+    "      [this](grpc::ClientContext& context,\n"
+    "             google::longrunning::GetOperationRequest const& request) {\n"
+    "        return child_->GetOperation(context, request);\n"
+    "      },\n"
+    "      context, request, \"Operations.GetOperation\", sink_);\n"
+    "}\n"
+    "\n"
+    "Status $metrics_class_name$::CancelOperation(\n"
+    "    grpc::ClientContext& context,\n"
+    "    google::longrunning::CancelOperationRequest const& request) {\n"
+    "  return google::cloud::internal::MetricsWrapper(\n"
+    "      [this](grpc::ClientContext& context,\n"
+    "             google::longrunning::CancelOperationRequest const& request) {\n"
+    "        return child_->CancelOperation(context, request);\n"
+    "      },\n"
+    "      context, request, \"Operations.CancelOperation\", sink_);\n"
+    "}\n"
+    "\n"
+    "future<StatusOr<google::longrunning::Operation>>\n"
+    "$metrics_class_name$::AsyncGetOperation(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    google::longrunning::GetOperationRequest const& request) {\n"
+    "  return google::cloud::internal::MetricsWrapper(\n"
+    "      [this](google::cloud::CompletionQueue& cq,\n"
+    "             std::unique_ptr<grpc::ClientContext> context,\n"
+    "             google::longrunning::GetOperationRequest const& request) {\n"
+    "        return child_->AsyncGetOperation(cq, std::move(context), request);\n"
+    "      },\n"
+    "      cq, std::move(context), request, \"Operations.GetOperation\", sink_);\n"
+    "}\n"
+    "\n"
+    "future<Status> $metrics_class_name$::AsyncCancelOperation(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    google::longrunning::CancelOperationRequest const& request) {\n"
+    "  return google::cloud::internal::MetricsWrapper(\n"
+    "      [this](google::cloud::CompletionQueue& cq,\n"
+    "             std::unique_ptr<grpc::ClientContext> context,\n"
+    "             google::longrunning::CancelOperationRequest const& request) {\n"
+    "        return child_->AsyncCancelOperation(cq, std::move(context),\n"
+    "                                            request);\n"
+    "      },\n"
+    "      cq, std::move(context), request, \"Operations.CancelOperation\",\n"
+    "      sink_);\n"
+    "}\n"
+            // clang-format on
+  );
+
+  CcCloseNamespaces();
+  return {};
+}
+
+}  // namespace generator_internal
+}  // namespace cloud
+}  // namespace google
@@ -36,6 +36,16 @@ bool IsPaginated(google::protobuf::MethodDescriptor const& method);
  */
 bool IsNonStreaming(google::protobuf::MethodDescriptor const& method);
 
+/**
+ * Determines if the given method has only server-side streaming.
+ */
+bool IsStreamingRead(google::protobuf::MethodDescriptor const& method);
+
+/**
+ * Determines if the given method has bidirectional streaming.
+ */
+bool IsBidirStreaming(google::protobuf::MethodDescriptor const& method);
+
 /**
  * Determines if the given method is a long running operation.
  */
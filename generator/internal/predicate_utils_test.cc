@@ -198,6 +198,59 @@ TEST(PredicateUtilsTest, IsNonStreaming) {
       IsNonStreaming(*service_file_descriptor_lro->service(0)->method(3)));
 }
 
+TEST(PredicateUtilsTest, StreamingKinds) {
+  FileDescriptorProto service_file;
+  auto constexpr kServiceText = R"pb(
+    name: "google/foo/v1/service.proto"
+    package: "google.protobuf"
+    message_type { name: "Input" }
+    message_type { name: "Output" }
+    service {
+      name: "Service"
+      method {
+        name: "NonStreaming"
+        input_type: "google.protobuf.Input"
+        output_type: "google.protobuf.Output"
+      }
+      method {
+        name: "ClientStreaming"
+        input_type: "google.protobuf.Input"
+        output_type: "google.protobuf.Output"
+        client_streaming: true
+      }
+      method {
+        name: "ServerStreaming"
+        input_type: "google.protobuf.Input"
+        output_type: "google.protobuf.Output"
+        server_streaming: true
+      }
+      method {
+        name: "BidirectionalStreaming"
+        input_type: "google.protobuf.Input"
+        output_type: "google.protobuf.Output"
+        client_streaming: true
+        server_streaming: true
+      }
+    }
+  )pb";
+  ASSERT_TRUE(google::protobuf::TextFormat::ParseFromString(kServiceText,
+                                                            &service_file));
+  DescriptorPool pool;
+  FileDescriptor const* service_file_descriptor = pool.BuildFile(service_file);
+  ASSERT_NE(service_file_descriptor, nullptr);
+  auto const& service = *service_file_descriptor->service(0);
+
+  EXPECT_FALSE(IsStreamingRead(*service.method(0)));
+  EXPECT_FALSE(IsStreamingRead(*service.method(1)));
+  EXPECT_TRUE(IsStreamingRead(*service.method(2)));
+  EXPECT_FALSE(IsStreamingRead(*service.method(3)));
+
+  EXPECT_FALSE(IsBidirStreaming(*service.method(0)));
+  EXPECT_FALSE(IsBidirStreaming(*service.method(1)));
+  EXPECT_FALSE(IsBidirStreaming(*service.method(2)));
+  EXPECT_TRUE(IsBidirStreaming(*service.method(3)));
+}
+
 TEST(PredicateUtilsTest, IsLongrunningMetadataTypeUsedAsResponseEmptyResponse) {
   FileDescriptorProto longrunning_file;
   auto constexpr kLongrunningText = R"pb(
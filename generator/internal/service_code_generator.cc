@@ -23,6 +23,8 @@
 #include "generator/internal/printer.h"
 #include <google/api/client.pb.h>
 #include <google/protobuf/descriptor.h>
+#include <set>
+#include <string>
 
 namespace google {
 namespace cloud {
@@ -42,9 +44,7 @@ ServiceCodeGenerator::ServiceCodeGenerator(
   assert(service_descriptor != nullptr);
   assert(context != nullptr);
   SetVars(service_vars_[header_path_key]);
-  for (int i = 0; i < service_descriptor_->method_count(); ++i) {
-    methods_.emplace_back(*service_descriptor_->method(i));
-  }
+  SetMethods();
 }
 
 ServiceCodeGenerator::ServiceCodeGenerator(
@@ -60,8 +60,23 @@ ServiceCodeGenerator::ServiceCodeGenerator(
   assert(service_descriptor != nullptr);
   assert(context != nullptr);
   SetVars(service_vars_[header_path_key]);
+  SetMethods();
+}
+
+void ServiceCodeGenerator::SetMethods() {
+  auto const async_names = [this] {
+    auto iter = service_vars_.find("gen_async_rpcs");
+    if (iter == service_vars_.end()) return std::set<std::string>{};
+    std::set<std::string> names =
+        absl::StrSplit(iter->second, ',', absl::SkipEmpty());
+    return names;
+  }();
   for (int i = 0; i < service_descriptor_->method_count(); ++i) {
-    methods_.emplace_back(*service_descriptor_->method(i));
+    auto const& method = *service_descriptor_->method(i);
+    methods_.emplace_back(method);
+    if (async_names.count(method.name()) != 0) {
+      async_methods_.emplace_back(method);
+    }
   }
 }
 
@@ -83,6 +98,12 @@ ServiceCodeGenerator::methods() const {
   return methods_;
 }
 
+std::vector<
+    std::reference_wrapper<google::protobuf::MethodDescriptor const>> const&
+ServiceCodeGenerator::async_methods() const {
+  return async_methods_;
+}
+
 VarsDictionary ServiceCodeGenerator::MergeServiceAndMethodVars(
     google::protobuf::MethodDescriptor const& method) const {
   auto vars = service_vars_;
@@ -59,6 +59,16 @@ class ServiceCodeGenerator : public GeneratorInterface {
   std::vector<
       std::reference_wrapper<google::protobuf::MethodDescriptor const>> const&
   methods() const;
+  /**
+   * The methods named by the `gen_async_rpc` options.
+   *
+   * Asynchronous variants are only generated for these methods, generating
+   * them for every method would bloat the generated code with functions most
+   * applications never call.
+   */
+  std::vector<
+      std::reference_wrapper<google::protobuf::MethodDescriptor const>> const&
+  async_methods() const;
   void SetVars(absl::string_view header_path);
   VarsDictionary MergeServiceAndMethodVars(
       google::protobuf::MethodDescriptor const& method) const;
@@ -93,6 +103,7 @@ class ServiceCodeGenerator : public GeneratorInterface {
   Status OpenNamespaces(Printer& p,
                         NamespaceType ns_type = NamespaceType::kNormal);
   void CloseNamespaces(Printer& p);
+  void SetMethods();
 
   google::protobuf::ServiceDescriptor const* service_descriptor_;
   VarsDictionary service_vars_;
@@ -100,6 +111,8 @@ class ServiceCodeGenerator : public GeneratorInterface {
   std::vector<std::string> namespaces_;
   std::vector<std::reference_wrapper<google::protobuf::MethodDescriptor const>>
       methods_;
+  std::vector<std::reference_wrapper<google::protobuf::MethodDescriptor const>>
+      async_methods_;
   Printer header_;
   Printer cc_;
 };
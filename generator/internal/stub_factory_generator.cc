@@ -75,7 +75,8 @@ Status StubFactoryGenerator::GenerateCc() {
   // includes
   CcLocalIncludes({vars("stub_factory_header_path"),
                    vars("logging_header_path"), vars("metadata_header_path"),
-                   vars("stub_header_path"), "google/cloud/log.h"});
+                   vars("metrics_header_path"), vars("stub_header_path"),
+                   "google/cloud/log.h"});
   CcSystemIncludes({"memory"});
   CcPrint("\n");
 
@@ -102,6 +103,11 @@ Status StubFactoryGenerator::GenerateCc() {
       "\n"
       "  stub = std::make_shared<$metadata_class_name$>(std::move(stub));\n"
       "\n"
+      "  if (options.rpc_metrics_sink()) {\n"
+      "    stub = std::make_shared<$metrics_class_name$>(\n"
+      "        std::move(stub), options.rpc_metrics_sink());\n"
+      "  }\n"
+      "\n"
       "  if (options.tracing_enabled(\"rpc\")) {\n"
       "    GCP_LOG(INFO) << \"Enabled logging for gRPC calls\";\n"
       "    stub = std::make_shared<$logging_class_name$>(std::move(stub),\n"
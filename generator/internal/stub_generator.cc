@@ -48,7 +48,11 @@ Status StubGenerator::GenerateHeader() {
   // clang-format on
 
   // includes
-  HeaderLocalIncludes({"google/cloud/status_or.h", "google/cloud/version.h"});
+  HeaderLocalIncludes({"google/cloud/completion_queue.h",
+                       "google/cloud/future.h",
+                       "google/cloud/internal/async_read_write_stream_impl.h",
+                       "google/cloud/internal/streaming_read_rpc.h",
+                       "google/cloud/status_or.h", "google/cloud/version.h"});
   HeaderSystemIncludes({vars("proto_grpc_header_path"),
                         "google/longrunning/operations.grpc.pb.h", "memory"});
   HeaderPrint("\n");
@@ -76,7 +80,45 @@ Status StubGenerator::GenerateHeader() {
     "    $request_type$ const& request) = 0;\n"
               // clang-format on
               "\n"}},
-            IsNonStreaming)},
+            IsNonStreaming),
+         MethodPattern(
+             {  // clang-format off
+   {"  virtual std::unique_ptr<google::cloud::internal::StreamingReadRpc<$response_type$>>\n"
+    "  $method_name$(\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) = 0;\n"
+    "\n"}},
+             // clang-format on
+             IsStreamingRead),
+         MethodPattern(
+             {  // clang-format off
+   {"  virtual std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<\n"
+    "      $request_type$,\n"
+    "      $response_type$>>\n"
+    "  Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context) = 0;\n"
+    "\n"}},
+             // clang-format on
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    HeaderPrintMethod(
+        method,
+        {MethodPattern(
+            {{IsResponseTypeEmpty,
+              // clang-format off
+    "  virtual future<Status> Async$method_name$(\n",
+    "  virtual future<StatusOr<$response_type$>> Async$method_name$(\n"},
+   {"    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> context,\n"
+    "    $request_type$ const& request) = 0;\n"
+              // clang-format on
+              "\n"}},
+            All(IsNonStreaming, Not(IsLongrunningOperation),
+                Not(IsPaginated)))},
         __FILE__, __LINE__);
   }
 
@@ -91,6 +133,18 @@ Status StubGenerator::GenerateHeader() {
     "  virtual Status CancelOperation(\n"
     "      grpc::ClientContext& client_context,\n"
     "      google::longrunning::CancelOperationRequest const& request) = 0;\n"
+    "\n"
+    "  /// Poll a long-running operation asynchronously.\n"
+    "  virtual future<StatusOr<google::longrunning::Operation>> AsyncGetOperation(\n"
+    "      google::cloud::CompletionQueue& cq,\n"
+    "      std::unique_ptr<grpc::ClientContext> client_context,\n"
+    "      google::longrunning::GetOperationRequest const& request) = 0;\n"
+    "\n"
+    "  /// Cancel a long-running operation asynchronously.\n"
+    "  virtual future<Status> AsyncCancelOperation(\n"
+    "      google::cloud::CompletionQueue& cq,\n"
+    "      std::unique_ptr<grpc::ClientContext> client_context,\n"
+    "      google::longrunning::CancelOperationRequest const& request) = 0;\n"
     "\n");
   // clang-format on
 
@@ -124,7 +178,45 @@ Status StubGenerator::GenerateHeader() {
     "    $request_type$ const& request) override;\n"
     "\n"}},
                        // clang-format on
-                       IsNonStreaming)},
+                       IsNonStreaming),
+         MethodPattern(
+             {  // clang-format off
+   {"  std::unique_ptr<google::cloud::internal::StreamingReadRpc<$response_type$>>\n"
+    "  $method_name$(\n"
+    "    std::unique_ptr<grpc::ClientContext> client_context,\n"
+    "    $request_type$ const& request) override;\n"
+    "\n"}},
+             // clang-format on
+             IsStreamingRead),
+         MethodPattern(
+             {  // clang-format off
+   {"  std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<\n"
+    "      $request_type$,\n"
+    "      $response_type$>>\n"
+    "  Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> client_context) override;\n"
+    "\n"}},
+             // clang-format on
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    HeaderPrintMethod(
+        method,
+        {MethodPattern({{IsResponseTypeEmpty,
+                         // clang-format off
+    "  future<Status>\n",
+    "  future<StatusOr<$response_type$>>\n"},
+    {"  Async$method_name$(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> client_context,\n"
+    "    $request_type$ const& request) override;\n"
+    "\n"}},
+                       // clang-format on
+                       All(IsNonStreaming, Not(IsLongrunningOperation),
+                           Not(IsPaginated)))},
         __FILE__, __LINE__);
   }
 
@@ -139,6 +231,18 @@ Status StubGenerator::GenerateHeader() {
     "  Status CancelOperation(\n"
     "      grpc::ClientContext& client_context,\n"
     "      google::longrunning::CancelOperationRequest const& request) override;\n"
+    "\n"
+    "  /// Poll a long-running operation asynchronously.\n"
+    "  future<StatusOr<google::longrunning::Operation>> AsyncGetOperation(\n"
+    "      google::cloud::CompletionQueue& cq,\n"
+    "      std::unique_ptr<grpc::ClientContext> client_context,\n"
+    "      google::longrunning::GetOperationRequest const& request) override;\n"
+    "\n"
+    "  /// Cancel a long-running operation asynchronously.\n"
+    "  future<Status> AsyncCancelOperation(\n"
+    "      google::cloud::CompletionQueue& cq,\n"
+    "      std::unique_ptr<grpc::ClientContext> client_context,\n"
+    "      google::longrunning::CancelOperationRequest const& request) override;\n"
     "\n");
   // clang-format on
 
@@ -167,7 +271,7 @@ Status StubGenerator::GenerateCc() {
   // clang-format on
 
   // includes
-  CcLocalIncludes({vars("stub_header_path"),
+  CcLocalIncludes({vars("stub_header_path"), "absl/memory/memory.h",
                    "google/cloud/grpc_error_delegate.h",
                    "google/cloud/status_or.h"});
   CcSystemIncludes({vars("proto_grpc_header_path"),
@@ -205,7 +309,72 @@ Status StubGenerator::GenerateCc() {
    {"}\n"
     "\n"}},
             // clang-format on
-            IsNonStreaming)},
+            IsNonStreaming),
+         MethodPattern(
+             {  // clang-format off
+   {"std::unique_ptr<google::cloud::internal::StreamingReadRpc<$response_type$>>\n"
+    "Default$stub_class_name$::$method_name$(\n"
+    "  std::unique_ptr<grpc::ClientContext> client_context,\n"
+    "  $request_type$ const& request) {\n"
+    "    auto stream = grpc_stub_->$method_name$(client_context.get(), request);\n"
+    "    return absl::make_unique<google::cloud::internal::StreamingReadRpcImpl<\n"
+    "        $response_type$>>(\n"
+    "        std::move(client_context), std::move(stream));\n"
+    "}\n"
+    "\n"}},
+             // clang-format on
+             IsStreamingRead),
+         MethodPattern(
+             {  // clang-format off
+   {"std::unique_ptr<google::cloud::internal::AsyncStreamingReadWriteRpc<\n"
+    "    $request_type$,\n"
+    "    $response_type$>>\n"
+    "Default$stub_class_name$::Async$method_name$(\n"
+    "  google::cloud::CompletionQueue& cq,\n"
+    "  std::unique_ptr<grpc::ClientContext> client_context) {\n"
+    "    return google::cloud::internal::MakeStreamingReadWriteRpc<\n"
+    "        $request_type$,\n"
+    "        $response_type$>(\n"
+    "        cq, std::move(client_context),\n"
+    "        [this](grpc::ClientContext* context, grpc::CompletionQueue* cq) {\n"
+    "          return grpc_stub_->PrepareAsync$method_name$(context, cq);\n"
+    "        });\n"
+    "}\n"
+    "\n"}},
+             // clang-format on
+             IsBidirStreaming)},
+        __FILE__, __LINE__);
+  }
+
+  for (auto const& method : async_methods()) {
+    CcPrintMethod(
+        method,
+        {MethodPattern(
+            {{IsResponseTypeEmpty,
+              // clang-format off
+    "future<Status>\n",
+    "future<StatusOr<$response_type$>>\n"},
+    {"Default$stub_class_name$::Async$method_name$(\n"
+    "  google::cloud::CompletionQueue& cq,\n"
+    "  std::unique_ptr<grpc::ClientContext> client_context,\n"
+    "  $request_type$ const& request) {\n"
+    "    return cq.MakeUnaryRpc(\n"
+    "        [this](grpc::ClientContext* context,\n"
+    "               $request_type$ const& request,\n"
+    "               grpc::CompletionQueue* cq) {\n"
+    "          return grpc_stub_->Async$method_name$(context, request, cq);\n"
+    "        },\n"},
+   {IsResponseTypeEmpty,
+    "        request, std::move(client_context))\n"
+    "        .then([](future<StatusOr<google::protobuf::Empty>> f) {\n"
+    "          return f.get().status();\n"
+    "        });\n",
+    "        request, std::move(client_context));\n"},
+   {"}\n"
+    "\n"}},
+            // clang-format on
+            All(IsNonStreaming, Not(IsLongrunningOperation),
+                Not(IsPaginated)))},
         __FILE__, __LINE__);
   }
 
@@ -235,6 +404,38 @@ Status StubGenerator::GenerateCc() {
     "    return google::cloud::MakeStatusFromRpcError(status);\n"
     "  }\n"
     "  return google::cloud::Status();\n"
+    "}\n"
+    "\n"
+    "/// Poll a long-running operation asynchronously.\n"
+    "future<StatusOr<google::longrunning::Operation>>\n"
+    "Default$stub_class_name$::AsyncGetOperation(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> client_context,\n"
+    "    google::longrunning::GetOperationRequest const& request) {\n"
+    "  return cq.MakeUnaryRpc(\n"
+    "      [this](grpc::ClientContext* context,\n"
+    "             google::longrunning::GetOperationRequest const& request,\n"
+    "             grpc::CompletionQueue* cq) {\n"
+    "        return operations_->AsyncGetOperation(context, request, cq);\n"
+    "      },\n"
+    "      request, std::move(client_context));\n"
+    "}\n"
+    "\n"
+    "/// Cancel a long-running operation asynchronously.\n"
+    "future<Status> Default$stub_class_name$::AsyncCancelOperation(\n"
+    "    google::cloud::CompletionQueue& cq,\n"
+    "    std::unique_ptr<grpc::ClientContext> client_context,\n"
+    "    google::longrunning::CancelOperationRequest const& request) {\n"
+    "  return cq.MakeUnaryRpc(\n"
+    "      [this](grpc::ClientContext* context,\n"
+    "             google::longrunning::CancelOperationRequest const& request,\n"
+    "             grpc::CompletionQueue* cq) {\n"
+    "        return operations_->AsyncCancelOperation(context, request, cq);\n"
+    "      },\n"
+    "      request, std::move(client_context))\n"
+    "      .then([](future<StatusOr<google::protobuf::Empty>> f) {\n"
+    "        return f.get().status();\n"
+    "      });\n"
     "}\n");
   // clang-format on
 
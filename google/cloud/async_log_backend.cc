@@ -0,0 +1,186 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/async_log_backend.h"
+#include "absl/memory/memory.h"
+#include <chrono>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+
+std::size_t RoundUpToPowerOfTwo(std::size_t capacity) {
+  std::size_t size = 2;
+  while (size < capacity) size *= 2;
+  return size;
+}
+
+// The background thread sleeps until a producer wakes it up. This is only a
+// safety net, in case a wakeup is missed.
+auto constexpr kWriterPollPeriod = std::chrono::milliseconds(100);
+
+}  // namespace
+
+std::size_t constexpr AsyncLogBackend::kDefaultCapacity;
+
+AsyncLogBackend::AsyncLogBackend(std::shared_ptr<LogBackend> backend,
+                                 std::size_t capacity, Severity flush_severity)
+    : backend_(std::move(backend)),
+      flush_severity_(flush_severity),
+      mask_(RoundUpToPowerOfTwo(capacity) - 1),
+      slots_(absl::make_unique<Slot[]>(mask_ + 1)) {
+  for (std::size_t i = 0; i != mask_ + 1; ++i) {
+    slots_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  writer_ = std::thread([this] { WriterLoop(); });
+}
+
+AsyncLogBackend::~AsyncLogBackend() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  writer_cv_.notify_one();
+  writer_.join();
+}
+
+void AsyncLogBackend::Process(LogRecord const& log_record) {
+  ProcessWithOwnership(log_record);
+}
+
+void AsyncLogBackend::ProcessWithOwnership(LogRecord log_record) {
+  // The wrapped backend may log too, those records arrive in the writer thread,
+  // which cannot wait for itself.
+  auto const flush =
+      log_record.severity >= flush_severity_ && !InWriterThread();
+  while (!TryPush(log_record)) {
+    if (!flush) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    WakeWriter();
+    std::this_thread::yield();
+  }
+  WakeWriter();
+  if (flush) Flush();
+}
+
+void AsyncLogBackend::Flush() {
+  if (InWriterThread()) return;
+  auto const target = write_pos_.load();
+  std::unique_lock<std::mutex> lk(mu_);
+  writer_cv_.notify_one();
+  flushed_cv_.wait(lk, [this, target] {
+    // Positions wrap around, compare their distance instead of the values.
+    auto const pending = target - read_pos_.load();
+    return pending == 0 || pending > mask_ + 1;
+  });
+}
+
+// This is the bounded queue described in
+// http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+// simplified for a single consumer.
+bool AsyncLogBackend::TryPush(LogRecord& log_record) {
+  auto pos = write_pos_.load(std::memory_order_relaxed);
+  for (;;) {
+    auto& slot = slots_[pos & mask_];
+    auto const seq = slot.sequence.load(std::memory_order_acquire);
+    auto const diff =
+        static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+    if (diff == 0) {
+      if (write_pos_.compare_exchange_weak(pos, pos + 1,
+                                           std::memory_order_relaxed)) {
+        slot.record = std::move(log_record);
+        slot.sequence.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      // The slot still holds the record from the previous lap, the buffer
+      // is full.
+      return false;
+    } else {
+      pos = write_pos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool AsyncLogBackend::TryPop(LogRecord& log_record) {
+  auto const pos = read_pos_.load(std::memory_order_relaxed);
+  auto& slot = slots_[pos & mask_];
+  if (slot.sequence.load(std::memory_order_acquire) != pos + 1) return false;
+  log_record = std::move(slot.record);
+  slot.sequence.store(pos + mask_ + 1, std::memory_order_release);
+  read_pos_.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+bool AsyncLogBackend::InWriterThread() const {
+  return std::this_thread::get_id() == writer_.get_id();
+}
+
+bool AsyncLogBackend::HasRecords() const {
+  auto const pos = read_pos_.load(std::memory_order_relaxed);
+  return slots_[pos & mask_].sequence.load(std::memory_order_acquire) ==
+         pos + 1;
+}
+
+void AsyncLogBackend::WakeWriter() {
+  // Pairs with the fence in `WriterLoop()`: either the writer sees the new
+  // record before going to sleep, or this thread sees `writer_waiting_`. Only
+  // the first producer after the writer goes to sleep pays for the wakeup.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (!writer_waiting_.load(std::memory_order_relaxed)) return;
+  if (!writer_waiting_.exchange(false)) return;
+  std::lock_guard<std::mutex> lk(mu_);
+  writer_cv_.notify_one();
+}
+
+void AsyncLogBackend::ReportDropped(std::uint64_t& reported) {
+  auto const dropped = dropped_.load(std::memory_order_relaxed);
+  if (dropped == reported) return;
+  LogRecord record;
+  record.severity = Severity::GCP_LS_WARNING;
+  record.function = __func__;
+  record.filename = __FILE__;
+  record.lineno = __LINE__;
+  record.timestamp = std::chrono::system_clock::now();
+  record.message = "AsyncLogBackend discarded " +
+                   std::to_string(dropped - reported) +
+                   " log records, the buffer was full";
+  reported = dropped;
+  backend_->ProcessWithOwnership(std::move(record));
+}
+
+void AsyncLogBackend::WriterLoop() {
+  std::uint64_t reported = 0;
+  LogRecord record;
+  for (;;) {
+    while (TryPop(record)) backend_->ProcessWithOwnership(std::move(record));
+    ReportDropped(reported);
+
+    std::unique_lock<std::mutex> lk(mu_);
+    flushed_cv_.notify_all();
+    if (shutdown_ && !HasRecords()) return;
+    writer_waiting_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    writer_cv_.wait_for(lk, kWriterPollPeriod,
+                        [this] { return shutdown_ || HasRecords(); });
+    writer_waiting_.store(false, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
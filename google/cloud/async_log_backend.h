@@ -0,0 +1,138 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_ASYNC_LOG_BACKEND_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_ASYNC_LOG_BACKEND_H
+
+#include "google/cloud/log.h"
+#include "google/cloud/version.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+
+/**
+ * A `LogBackend` that forwards log records to another backend in a background
+ * thread.
+ *
+ * The threads logging through this backend only move the `LogRecord` into a
+ * bounded, lock-free, multi-producer single-consumer ring buffer. A dedicated
+ * thread drains the buffer and calls the wrapped backend, so any formatting and
+ * I/O performed by the wrapped backend does not add latency to the application
+ * threads.
+ *
+ * Logging never blocks the application threads: if the buffer is full the
+ * record is discarded, and the number of discarded records is reported through
+ * the wrapped backend once there is space again. The exception are records at
+ * or above @p flush_severity, these are never discarded, and the calling thread
+ * waits until they (and any records before them) are processed. This preserves
+ * the important log lines if the application crashes shortly after logging
+ * them. Records logged by the wrapped backend itself (which arrive in the
+ * background thread) are never waited for, so they may be discarded.
+ *
+ * @par Example
+ * @code
+ * auto backend = std::make_shared<google::cloud::AsyncLogBackend>(
+ *     std::make_shared<MyLogBackend>());
+ * auto id = google::cloud::LogSink::Instance().AddBackend(backend);
+ * @endcode
+ */
+class AsyncLogBackend : public LogBackend {
+ public:
+  /// The default number of records buffered between the threads.
+  static std::size_t constexpr kDefaultCapacity = 4096;
+
+  /**
+   * Create a backend forwarding the records to @p backend.
+   *
+   * @param backend the backend receiving the records, it is only called from
+   *     the background thread.
+   * @param capacity the maximum number of records waiting for the background
+   *     thread, rounded up to a power of two.
+   * @param flush_severity the records at this severity, or higher, are never
+   *     discarded, and wait until they are processed.
+   */
+  explicit AsyncLogBackend(
+      std::shared_ptr<LogBackend> backend,
+      std::size_t capacity = kDefaultCapacity,
+      Severity flush_severity = Severity::GCP_LS_WARNING);
+
+  /// Processes any buffered records and stops the background thread.
+  ~AsyncLogBackend() override;
+
+  AsyncLogBackend(AsyncLogBackend const&) = delete;
+  AsyncLogBackend& operator=(AsyncLogBackend const&) = delete;
+
+  void Process(LogRecord const& log_record) override;
+  void ProcessWithOwnership(LogRecord log_record) override;
+
+  /**
+   * Block until the records accepted before this call are processed.
+   *
+   * If called from the background thread, e.g. by the wrapped backend, this
+   * returns immediately, as the thread cannot wait for itself.
+   */
+  void Flush();
+
+  /// The number of records discarded because the buffer was full.
+  std::uint64_t dropped_count() const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Slot {
+    // The position of the record in the buffer: `pos` when the slot is ready
+    // to be written for `pos`, `pos + 1` once it holds the record for `pos`.
+    std::atomic<std::size_t> sequence;
+    LogRecord record;
+  };
+
+  bool TryPush(LogRecord& log_record);
+  bool TryPop(LogRecord& log_record);
+  bool InWriterThread() const;
+  bool HasRecords() const;
+  void WakeWriter();
+  void ReportDropped(std::uint64_t& reported);
+  void WriterLoop();
+
+  std::shared_ptr<LogBackend> backend_;
+  Severity const flush_severity_;
+  std::size_t const mask_;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<std::size_t> write_pos_{0};
+  std::atomic<std::size_t> read_pos_{0};
+  std::atomic<std::uint64_t> dropped_{0};
+  std::atomic<bool> writer_waiting_{false};
+
+  // Only used to put the background thread to sleep, and to wait for it in
+  // `Flush()`, never to push records.
+  std::mutex mu_;
+  std::condition_variable writer_cv_;
+  std::condition_variable flushed_cv_;
+  bool shutdown_ = false;
+  std::thread writer_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_ASYNC_LOG_BACKEND_H
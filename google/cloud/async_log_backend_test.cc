@@ -0,0 +1,214 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/async_log_backend.h"
+#include <gmock/gmock.h>
+#include <future>
+#include <map>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+
+class RecordingBackend : public LogBackend {
+ public:
+  void Process(LogRecord const& lr) override { ProcessWithOwnership(lr); }
+  void ProcessWithOwnership(LogRecord lr) override {
+    std::lock_guard<std::mutex> lk(mu_);
+    threads_.push_back(std::this_thread::get_id());
+    records_.push_back(std::move(lr));
+  }
+
+  std::vector<LogRecord> records() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return records_;
+  }
+  std::vector<std::thread::id> threads() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return threads_;
+  }
+
+ private:
+  std::mutex mu_;
+  std::vector<LogRecord> records_;
+  std::vector<std::thread::id> threads_;
+};
+
+LogRecord MakeRecord(Severity severity, std::string message) {
+  LogRecord record;
+  record.severity = severity;
+  record.function = "Func";
+  record.filename = "filename.cc";
+  record.lineno = 123;
+  record.timestamp = std::chrono::system_clock::now();
+  record.message = std::move(message);
+  return record;
+}
+
+std::vector<std::string> Messages(std::vector<LogRecord> const& records) {
+  std::vector<std::string> messages;
+  for (auto const& r : records) messages.push_back(r.message);
+  return messages;
+}
+
+TEST(AsyncLogBackendTest, ForwardsInBackground) {
+  auto backend = std::make_shared<RecordingBackend>();
+  AsyncLogBackend tested(backend);
+  tested.ProcessWithOwnership(MakeRecord(Severity::GCP_LS_INFO, "m1"));
+  tested.Process(MakeRecord(Severity::GCP_LS_DEBUG, "m2"));
+  tested.Flush();
+
+  auto const records = backend->records();
+  EXPECT_THAT(Messages(records), ElementsAre("m1", "m2"));
+  for (auto const& r : records) {
+    EXPECT_EQ(std::this_thread::get_id(), r.thread_id);
+  }
+  for (auto const& id : backend->threads()) {
+    EXPECT_NE(std::this_thread::get_id(), id);
+  }
+}
+
+TEST(AsyncLogBackendTest, FlushSeverityWaits) {
+  auto backend = std::make_shared<RecordingBackend>();
+  AsyncLogBackend tested(backend);
+  tested.ProcessWithOwnership(MakeRecord(Severity::GCP_LS_INFO, "m1"));
+  tested.ProcessWithOwnership(MakeRecord(Severity::GCP_LS_WARNING, "m2"));
+  // No need to call Flush(), the WARNING message waits for all messages.
+  EXPECT_THAT(Messages(backend->records()), ElementsAre("m1", "m2"));
+}
+
+TEST(AsyncLogBackendTest, DestructorDrains) {
+  auto backend = std::make_shared<RecordingBackend>();
+  {
+    AsyncLogBackend tested(backend);
+    for (int i = 0; i != 100; ++i) {
+      tested.ProcessWithOwnership(
+          MakeRecord(Severity::GCP_LS_INFO, std::to_string(i)));
+    }
+  }
+  EXPECT_EQ(100, backend->records().size());
+}
+
+class BlockingBackend : public RecordingBackend {
+ public:
+  explicit BlockingBackend(std::shared_future<void> unblock)
+      : unblock_(std::move(unblock)) {}
+
+  void ProcessWithOwnership(LogRecord lr) override {
+    unblock_.wait();
+    RecordingBackend::ProcessWithOwnership(std::move(lr));
+  }
+
+ private:
+  std::shared_future<void> unblock_;
+};
+
+TEST(AsyncLogBackendTest, DiscardsWhenFull) {
+  std::promise<void> unblock;
+  auto backend = std::make_shared<BlockingBackend>(unblock.get_future());
+  AsyncLogBackend tested(backend, 4);
+  // The background thread blocks on (at most) one of these records, the rest
+  // fill the buffer.
+  for (int i = 0; i != 16; ++i) {
+    tested.ProcessWithOwnership(
+        MakeRecord(Severity::GCP_LS_INFO, std::to_string(i)));
+  }
+  EXPECT_LE(11, tested.dropped_count());
+  unblock.set_value();
+  tested.Flush();
+
+  // The accepted records are processed, followed by a report of the discarded
+  // records.
+  auto const records = backend->records();
+  ASSERT_EQ(16 - tested.dropped_count() + 1, records.size());
+  EXPECT_EQ("0", records.front().message);
+  auto const& report = records.back();
+  EXPECT_EQ(Severity::GCP_LS_WARNING, report.severity);
+  EXPECT_THAT(report.message,
+              HasSubstr("discarded " + std::to_string(tested.dropped_count())));
+}
+
+/// A backend that logs through the `AsyncLogBackend` that calls it.
+class ReentrantBackend : public RecordingBackend {
+ public:
+  void set_target(AsyncLogBackend* target) { target_ = target; }
+
+  void ProcessWithOwnership(LogRecord lr) override {
+    auto const nested = lr.message == "m1";
+    RecordingBackend::ProcessWithOwnership(std::move(lr));
+    if (!nested) return;
+    target_->ProcessWithOwnership(MakeRecord(Severity::GCP_LS_ERROR, "nested"));
+    target_->Flush();
+    done_.set_value();
+  }
+
+  std::future<void> done() { return done_.get_future(); }
+
+ private:
+  AsyncLogBackend* target_ = nullptr;
+  std::promise<void> done_;
+};
+
+TEST(AsyncLogBackendTest, FlushFromWriterThreadDoesNotBlock) {
+  auto backend = std::make_shared<ReentrantBackend>();
+  auto done = backend->done();
+  {
+    AsyncLogBackend tested(backend);
+    backend->set_target(&tested);
+    tested.ProcessWithOwnership(MakeRecord(Severity::GCP_LS_INFO, "m1"));
+    // The writer thread must not wait for itself.
+    ASSERT_EQ(std::future_status::ready,
+              done.wait_for(std::chrono::seconds(30)));
+  }
+  EXPECT_THAT(Messages(backend->records()), ElementsAre("m1", "nested"));
+}
+
+TEST(AsyncLogBackendTest, MultipleThreads) {
+  auto constexpr kThreadCount = 4;
+  auto constexpr kIterations = 1000;
+  auto backend = std::make_shared<RecordingBackend>();
+  AsyncLogBackend tested(backend, 16);
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kThreadCount; ++t) {
+    threads.emplace_back([&tested] {
+      for (int i = 0; i != kIterations; ++i) {
+        // Use the flush severity so no records are discarded.
+        tested.ProcessWithOwnership(
+            MakeRecord(Severity::GCP_LS_ERROR, std::to_string(i)));
+      }
+    });
+  }
+  for (auto& t : threads) t.join();
+  tested.Flush();
+
+  // Each thread's records are processed in the order they were logged.
+  std::map<std::thread::id, int> next;
+  for (auto const& r : backend->records()) {
+    EXPECT_EQ(std::to_string(next[r.thread_id]++), r.message);
+  }
+  ASSERT_EQ(kThreadCount, next.size());
+  for (auto const& kv : next) EXPECT_EQ(kIterations, kv.second);
+  EXPECT_EQ(0, tested.dropped_count());
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,61 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BACKOFF_SLEEPER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BACKOFF_SLEEPER_H
+
+#include "google/cloud/version.h"
+#include <chrono>
+#include <functional>
+#include <thread>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+
+/**
+ * Waits for the backoff period between two attempts of a blocking operation.
+ *
+ * The blocking retry loops in the client libraries call this function between
+ * attempts. By default the calling thread sleeps, which parks the thread while
+ * the service recovers. Applications running the libraries on a cooperative
+ * scheduler (for example, fibers, or a thread pool that can run other tasks
+ * while one is waiting) can provide a function that yields to the scheduler, so
+ * other ready work runs during the backoff period.
+ *
+ * The function must not return before the backoff period expires, otherwise
+ * the retry loop retries faster than the backoff policy allows.
+ *
+ * @par Example
+ * @code
+ * namespace gc = ::google::cloud;
+ * gc::BackoffSleeper sleeper = [](std::chrono::milliseconds period) {
+ *   boost::this_fiber::sleep_for(period);
+ * };
+ * @endcode
+ */
+using BackoffSleeper = std::function<void(std::chrono::milliseconds)>;
+
+/// Returns a `BackoffSleeper` that blocks the calling thread.
+inline BackoffSleeper DefaultBackoffSleeper() {
+  return [](std::chrono::milliseconds period) {
+    std::this_thread::sleep_for(period);
+  };
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BACKOFF_SLEEPER_H
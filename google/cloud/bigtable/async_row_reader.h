@@ -20,6 +20,7 @@
 #include "google/cloud/bigtable/filters.h"
 #include "google/cloud/bigtable/internal/readrowsparser.h"
 #include "google/cloud/bigtable/internal/rowreaderiterator.h"
+#include "google/cloud/bigtable/internal/sorted_row_set.h"
 #include "google/cloud/bigtable/metadata_update_policy.h"
 #include "google/cloud/bigtable/row.h"
 #include "google/cloud/bigtable/row_set.h"
@@ -118,8 +119,6 @@ class AsyncRowReader : public std::enable_shared_from_this<
 
     request.set_app_profile_id(app_profile_id_);
     request.set_table_name(table_name_);
-    auto row_set_proto = row_set_.as_proto();
-    request.mutable_rows()->Swap(&row_set_proto);
 
     auto filter_proto = filter_.as_proto();
     request.mutable_filter()->Swap(&filter_proto);
@@ -136,17 +135,50 @@ class AsyncRowReader : public std::enable_shared_from_this<
 
     auto client = client_;
     auto self = this->shared_from_this();
-    cq_.MakeStreamingReadRpc(
-        [client](grpc::ClientContext* context,
-                 google::bigtable::v2::ReadRowsRequest const& request,
-                 grpc::CompletionQueue* cq) {
-          return client->PrepareAsyncReadRows(context, request, cq);
+    auto stream = cq_.MakeStreamingReadRpc(
+        [client, self, &request](grpc::ClientContext* context,
+                                 google::bigtable::v2::ReadRowsRequest const&,
+                                 grpc::CompletionQueue* cq) {
+          // gRPC serializes the request before returning, so the row keys are
+          // only lent while the call is prepared. This happens before
+          // `StartCall()`, so the stream callbacks, which also change
+          // `row_set_`, cannot run concurrently.
+          self->row_set_.LendBatch(*request.mutable_rows());
+          auto reader = client->PrepareAsyncReadRows(context, request, cq);
+          self->row_set_.ReturnBatch(*request.mutable_rows());
+          return reader;
         },
         request, std::move(context),
         [self](google::bigtable::v2::ReadRowsResponse r) {
           return self->OnDataReceived(std::move(r));
         },
         [self](Status s) { self->OnStreamFinished(std::move(s)); });
+
+    std::unique_lock<std::mutex> lk(mu_);
+    stream_ = stream;
+    bool const cancelled = cancelled_;
+    lk.unlock();
+    if (cancelled) stream->Cancel();
+  }
+
+  /**
+   * Cancel the outstanding request (if any) and stop retrying.
+   *
+   * `Table` uses this function to cancel hedged requests once another request
+   * has returned. The callbacks are still called, with a status reflecting
+   * the cancelled request.
+   */
+  void CancelRequest() {
+    std::unique_lock<std::mutex> lk(mu_);
+    cancelled_ = true;
+    auto stream = stream_;
+    lk.unlock();
+    if (stream) stream->Cancel();
+  }
+
+  bool RequestCancelled() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return cancelled_;
   }
 
   /**
@@ -288,14 +320,16 @@ class AsyncRowReader : public std::enable_shared_from_this<
     // number of rows and still receive an error (the parser can throw
     // an error at end of stream for example), there is no need to
     // retry and we have no good value for rows_limit anyway.
-    if (rows_limit_ != NO_ROWS_LIMIT && rows_limit_ <= rows_count_) {
+    bool const limit_reached =
+        rows_limit_ != NO_ROWS_LIMIT && rows_limit_ <= rows_count_;
+    if (limit_reached) {
       status_ = Status();
     }
 
     if (!last_read_row_key_.empty()) {
       // We've returned some rows and need to make sure we don't
       // request them again.
-      row_set_ = row_set_.Intersect(RowRange::Open(last_read_row_key_, ""));
+      row_set_.ResumeAfter(last_read_row_key_);
     }
 
     // If we receive an error, but the retryable set is empty, consider it a
@@ -303,6 +337,14 @@ class AsyncRowReader : public std::enable_shared_from_this<
     if (row_set_.IsEmpty()) {
       status_ = Status();
     }
+    if (status_.ok()) rpc_retry_policy_->OnSuccess();
+
+    if (status_.ok() && !limit_reached && !RequestCancelled() &&
+        row_set_.CompleteBatch()) {
+      // Large sets of row keys are requested in batches, start the next one.
+      MakeRequest();
+      return;
+    }
 
     if (status_.ok()) {
       // We've successfully finished the scan.
@@ -311,7 +353,7 @@ class AsyncRowReader : public std::enable_shared_from_this<
       return;
     }
 
-    if (!rpc_retry_policy_->OnFailure(status_)) {
+    if (!rpc_retry_policy_->OnFailure(status_) || RequestCancelled()) {
       // Can't retry.
       whole_op_finished_ = true;
       TryGiveRowToUser();
@@ -383,13 +425,17 @@ class AsyncRowReader : public std::enable_shared_from_this<
   friend class Table;
 
   std::mutex mu_;
+  /// The current streaming RPC, used to cancel it, guarded by `mu_`.
+  std::shared_ptr<AsyncOperation> stream_;
+  /// Set if the request was cancelled via `CancelRequest()`, guarded by `mu_`.
+  bool cancelled_ = false;
   CompletionQueue cq_;
   std::shared_ptr<DataClient> client_;
   std::string app_profile_id_;
   std::string table_name_;
   RowFunctor on_row_;
   FinishFunctor on_finish_;
-  RowSet row_set_;
+  internal::SortedRowSet row_set_;
   std::int64_t rows_limit_;
   Filter filter_;
   std::unique_ptr<RPCRetryPolicy> rpc_retry_policy_;
@@ -24,6 +24,9 @@
 #include "google/cloud/testing_util/validate_metadata.h"
 #include "absl/memory/memory.h"
 #include <gmock/gmock.h>
+#include <grpcpp/alarm.h>
+#include <algorithm>
+#include <mutex>
 #include <thread>
 
 namespace google {
@@ -1078,6 +1081,263 @@ TEST_F(TableAsyncReadRowsTest, ReadRowError) {
   ASSERT_EQ(StatusCode::kPermissionDenied, row.status().code());
 }
 
+/// Return a response with a single row, with "000" as its key.
+void ReturnRow000(btproto::ReadRowsResponse* r, void*) {
+  *r = bigtable::testing::ReadRowsResponseFromString(
+      R"(
+        chunks {
+          row_key: "000"
+          family_name { value: "fam" }
+          qualifier { value: "col" }
+          timestamp_micros: 42000
+          value: "value"
+          commit_row: true
+        })");
+}
+
+TEST_F(TableAsyncReadRowsTest, HedgedReadRowSendsHedgeAfterDelay) {
+  auto budget = std::make_shared<HedgingBudget>(1.0, 10.0);
+  bigtable::Table table(client_, kTableId,
+                        FixedDelayHedgingPolicy(10_ms, budget));
+
+  // The expectations are matched newest first, so add the hedge first.
+  auto& hedge = AddReader([](btproto::ReadRowsRequest const&) {});
+  EXPECT_CALL(hedge, Finish(_, _)).WillOnce([](grpc::Status* status, void*) {
+    *status = grpc::Status::OK;
+  });
+  auto& original = AddReader([](btproto::ReadRowsRequest const&) {});
+  EXPECT_CALL(original, Read(_, _))
+      .WillOnce(ReturnRow000)
+      .RetiresOnSaturation();
+  EXPECT_CALL(original, Finish(_, _))
+      .WillOnce([](grpc::Status* status, void*) {
+        *status = grpc::Status::OK;
+      });
+
+  auto row_future = table.AsyncReadRow(cq_, "000", Filter::PassAllFilter());
+
+  // Only the original request is sent before the hedge timer expires.
+  EXPECT_FALSE(reader_started_[0]);
+  EXPECT_TRUE(reader_started_[1]);
+  EXPECT_EQ(0, budget->hedges_sent());
+
+  ASSERT_EQ(2U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish Start(), expire the timer
+
+  EXPECT_TRUE(reader_started_[0]);
+  EXPECT_EQ(1, budget->hedges_sent());
+  EXPECT_TRUE(Unsatisfied(row_future));
+
+  ASSERT_EQ(2U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Return data, finish hedge Start()
+  ASSERT_EQ(2U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(false);  // Finish both streams
+  ASSERT_EQ(2U, cq_impl_->size());
+  EXPECT_TRUE(Unsatisfied(row_future));
+  cq_impl_->SimulateCompletion(true);  // Finish Finish()
+
+  auto row = row_future.get();
+  ASSERT_STATUS_OK(row);
+  ASSERT_TRUE(row->first);
+  ASSERT_EQ("000", row->second.row_key());
+
+  ASSERT_EQ(0U, cq_impl_->size());
+}
+
+TEST_F(TableAsyncReadRowsTest, HedgedReadRowFirstSuccessCancelsOthers) {
+  auto budget = std::make_shared<HedgingBudget>(1.0, 10.0);
+  bigtable::Table table(client_, kTableId,
+                        FixedDelayHedgingPolicy(10_ms, budget));
+
+  auto& hedge = AddReader([](btproto::ReadRowsRequest const&) {});
+  // The hedge is cancelled once the original request succeeds, so this
+  // (normally retryable) error must not start a new request.
+  EXPECT_CALL(hedge, Finish(_, _)).WillOnce([](grpc::Status* status, void*) {
+    *status = grpc::Status(grpc::StatusCode::UNAVAILABLE, "try-again");
+  });
+  auto& original = AddReader([](btproto::ReadRowsRequest const&) {});
+  EXPECT_CALL(original, Read(_, _))
+      .WillOnce(ReturnRow000)
+      .RetiresOnSaturation();
+  EXPECT_CALL(original, Finish(_, _))
+      .WillOnce([](grpc::Status* status, void*) {
+        *status = grpc::Status::OK;
+      });
+
+  auto row_future = table.AsyncReadRow(cq_, "000", Filter::PassAllFilter());
+
+  ASSERT_EQ(2U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish Start(), expire the timer
+  ASSERT_EQ(2U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Return data, finish hedge Start()
+  ASSERT_EQ(2U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(false);  // Finish both streams
+  ASSERT_EQ(2U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish Finish()
+
+  auto row = row_future.get();
+  ASSERT_STATUS_OK(row);
+  ASSERT_TRUE(row->first);
+  ASSERT_EQ("000", row->second.row_key());
+
+  // The cancelled hedge did not schedule a retry.
+  ASSERT_EQ(0U, cq_impl_->size());
+}
+
+TEST_F(TableAsyncReadRowsTest, HedgedReadRowFailureWaitsForOthers) {
+  auto budget = std::make_shared<HedgingBudget>(1.0, 10.0);
+  bigtable::Table table(client_, kTableId,
+                        FixedDelayHedgingPolicy(10_ms, budget));
+
+  auto& hedge = AddReader([](btproto::ReadRowsRequest const&) {});
+  EXPECT_CALL(hedge, Read(_, _))
+      .WillOnce(ReturnRow000)
+      .RetiresOnSaturation();
+  EXPECT_CALL(hedge, Finish(_, _)).WillOnce([](grpc::Status* status, void*) {
+    *status = grpc::Status::OK;
+  });
+  // The original request returns a couple of empty responses, so it reaches
+  // the end of the stream at the same time as the hedge, and then fails.
+  auto& original = AddReader([](btproto::ReadRowsRequest const&) {});
+  EXPECT_CALL(original, Read(_, _))
+      .Times(2)
+      .WillRepeatedly([](btproto::ReadRowsResponse*, void*) {})
+      .RetiresOnSaturation();
+  EXPECT_CALL(original, Finish(_, _))
+      .WillOnce([](grpc::Status* status, void*) {
+        *status = grpc::Status(grpc::StatusCode::PERMISSION_DENIED, "uh-oh");
+      });
+
+  auto row_future = table.AsyncReadRow(cq_, "000", Filter::PassAllFilter());
+
+  ASSERT_EQ(2U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish Start(), expire the timer
+  ASSERT_EQ(2U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Empty response, finish hedge Start()
+  ASSERT_EQ(2U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Empty response, return data
+  ASSERT_EQ(2U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(false);  // Finish both streams
+  ASSERT_EQ(2U, cq_impl_->size());
+  EXPECT_TRUE(Unsatisfied(row_future));
+  // The original request fails first, the result comes from the hedge.
+  cq_impl_->SimulateCompletion(true);  // Finish Finish()
+
+  auto row = row_future.get();
+  ASSERT_STATUS_OK(row);
+  ASSERT_TRUE(row->first);
+  ASSERT_EQ("000", row->second.row_key());
+
+  ASSERT_EQ(0U, cq_impl_->size());
+}
+
+TEST_F(TableAsyncReadRowsTest, HedgedReadRowBudgetExhausted) {
+  // An empty budget rejects all the hedges.
+  auto budget = std::make_shared<HedgingBudget>(0.0, 0.0);
+  bigtable::Table table(client_, kTableId,
+                        FixedDelayHedgingPolicy(10_ms, budget));
+
+  auto& stream = AddReader([](btproto::ReadRowsRequest const&) {});
+  EXPECT_CALL(stream, Finish(_, _)).WillOnce([](grpc::Status* status, void*) {
+    *status = grpc::Status::OK;
+  });
+
+  auto row_future = table.AsyncReadRow(cq_, "000", Filter::PassAllFilter());
+
+  EXPECT_TRUE(reader_started_[0]);
+
+  ASSERT_EQ(2U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish Start(), expire the timer
+
+  // No hedge was sent, only the original `Read()` is pending.
+  EXPECT_EQ(0, budget->hedges_sent());
+  EXPECT_EQ(1, budget->hedges_rejected());
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(false);  // Finish stream
+  ASSERT_EQ(1U, cq_impl_->size());
+  EXPECT_TRUE(Unsatisfied(row_future));
+  cq_impl_->SimulateCompletion(true);  // Finish Finish()
+
+  auto row = row_future.get();
+  ASSERT_STATUS_OK(row);
+  ASSERT_FALSE(row->first);
+
+  ASSERT_EQ(0U, cq_impl_->size());
+}
+
+/// @test Verify that large row sets are read in batches with many CQ threads.
+TEST_F(TableAsyncReadRowsTest, LargeRowSetManyThreads) {
+  CompletionQueue cq;
+  std::vector<std::thread> threads(4);
+  for (auto& t : threads) t = std::thread([&cq] { cq.Run(); });
+
+  // Enough row keys to need several batches.
+  auto constexpr kKeyCount = 10000;
+  RowSet row_set;
+  std::vector<std::string> expected;
+  for (int i = 0; i != kKeyCount; ++i) {
+    auto key = "row-key-" + std::to_string(i);
+    key.resize(64, '-');
+    row_set.Append(key);
+    expected.push_back(std::move(key));
+  }
+  std::sort(expected.begin(), expected.end());
+
+  std::mutex mu;
+  std::vector<std::string> requested;
+  std::vector<std::unique_ptr<grpc::Alarm>> alarms;
+  // Complete `tag` from a CQ thread, as the real streams do.
+  auto complete = [&mu, &alarms](grpc::CompletionQueue* grpc_cq, void* tag,
+                                 bool ok) {
+    auto deadline = std::chrono::system_clock::now();
+    if (!ok) deadline += std::chrono::hours(1);
+    auto alarm = absl::make_unique<grpc::Alarm>();
+    alarm->Set(grpc_cq, deadline, tag);
+    // A cancelled alarm completes with `ok == false`.
+    if (!ok) alarm->Cancel();
+    std::lock_guard<std::mutex> lk(mu);
+    alarms.push_back(std::move(alarm));
+  };
+
+  EXPECT_CALL(*client_, PrepareAsyncReadRows(_, _, _))
+      .WillRepeatedly([&](grpc::ClientContext*,
+                          btproto::ReadRowsRequest const& r,
+                          grpc::CompletionQueue* grpc_cq) {
+        {
+          std::lock_guard<std::mutex> lk(mu);
+          for (auto const& key : r.rows().row_keys()) requested.push_back(key);
+        }
+        auto reader = absl::make_unique<
+            MockClientAsyncReaderInterface<btproto::ReadRowsResponse>>();
+        EXPECT_CALL(*reader, StartCall(_)).WillOnce([=](void* tag) {
+          complete(grpc_cq, tag, true);
+        });
+        EXPECT_CALL(*reader, Read(_, _))
+            .WillOnce([=](btproto::ReadRowsResponse*, void* tag) {
+              complete(grpc_cq, tag, false);
+            });
+        EXPECT_CALL(*reader, Finish(_, _))
+            .WillOnce([=](grpc::Status* status, void* tag) {
+              *status = grpc::Status::OK;
+              complete(grpc_cq, tag, true);
+            });
+        return reader;
+      });
+
+  promise<Status> done;
+  table_.AsyncReadRows(
+      cq, [](Row const&) { return make_ready_future(true); },
+      [&done](Status s) { done.set_value(std::move(s)); }, std::move(row_set),
+      Filter::PassAllFilter());
+  EXPECT_STATUS_OK(done.get_future().get());
+
+  cq.Shutdown();
+  for (auto& t : threads) t.join();
+
+  // Each key is requested exactly once, and in ascending order.
+  EXPECT_EQ(expected, requested);
+}
+
 }  // namespace
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
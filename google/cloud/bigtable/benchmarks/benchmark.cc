@@ -15,6 +15,7 @@
 #include "google/cloud/bigtable/benchmarks/benchmark.h"
 #include "google/cloud/bigtable/benchmarks/random_mutation.h"
 #include "google/cloud/bigtable/table_admin.h"
+#include <algorithm>
 #include <future>
 #include <iomanip>
 #include <sstream>
@@ -184,6 +185,35 @@ void Benchmark::PrintLatencyResult(std::ostream& os,
   os << "\n";
 }
 
+void Benchmark::PrintLatencyHistogram(std::ostream& os,
+                                      std::string const& test_name,
+                                      std::string const& operation,
+                                      BenchmarkResult const& result) {
+  if (result.operations.empty()) {
+    os << "# Test=" << test_name << ", " << operation << " no results\n";
+    return;
+  }
+  // buckets[i] counts the latencies in [2^(i-1), 2^i) microseconds.
+  std::vector<std::size_t> buckets;
+  for (auto const& op : result.operations) {
+    std::size_t b = 0;
+    for (auto us = op.latency.count(); us != 0; us /= 2) ++b;
+    if (b >= buckets.size()) buckets.resize(b + 1);
+    ++buckets[b];
+  }
+  auto const max = *std::max_element(buckets.begin(), buckets.end());
+  std::size_t constexpr kBarWidth = 50;
+  os << "# Test=" << test_name << ", " << operation << " Latency Histogram\n";
+  for (std::size_t b = 0; b != buckets.size(); ++b) {
+    using std::chrono::microseconds;
+    auto const lo = b == 0 ? 0 : std::int64_t{1} << (b - 1);
+    auto const hi = std::int64_t{1} << b;
+    os << "# [" << FormatDuration(microseconds(lo)) << ", "
+       << FormatDuration(microseconds(hi)) << ") " << buckets[b] << " "
+       << std::string(buckets[b] * kBarWidth / max, '*') << "\n";
+  }
+}
+
 std::string Benchmark::ResultsCsvHeader() {
   return "name,start,op.name,measurement,nsamples,min,p50,p90,p95,p99,p99.9,max"
          ",units,throughput.rows,throughput.ops,notes";
@@ -91,6 +91,17 @@ class Benchmark {
                                  std::string const& operation,
                                  BenchmarkResult& result);
 
+  /**
+   * Print a histogram of the latencies in @p result.
+   *
+   * The buckets are powers of 2 (in microseconds), which is enough to spot
+   * changes in the shape of the distribution, e.g., a long tail.
+   */
+  static void PrintLatencyHistogram(std::ostream& os,
+                                    std::string const& test_name,
+                                    std::string const& operation,
+                                    BenchmarkResult const& result);
+
   /// Return the header for CSV results.
   static std::string ResultsCsvHeader();
 
@@ -161,6 +161,31 @@ TEST(BenchmarkTest, PrintLatencyResult) {
   EXPECT_THAT(output, HasSubstr("p100=10.000ms"));
 }
 
+TEST(BenchmarkTest, PrintLatencyHistogram) {
+  BenchmarkResult result{};
+  result.elapsed = std::chrono::milliseconds(1000);
+  result.row_count = 100;
+  result.operations.resize(100);
+  int count = 0;
+  std::generate(result.operations.begin(), result.operations.end(), [&count]() {
+    return OperationResult{google::cloud::Status{},
+                           std::chrono::microseconds(++count * 100)};
+  });
+
+  std::ostringstream os;
+  Benchmark::PrintLatencyHistogram(os, "foo", "bar", result);
+  std::string output = os.str();
+
+  // We do not want a change detector test, so the following assertions are
+  // fairly minimal. The buckets are powers of 2, the first sample (100us) is
+  // alone in its bucket, and the largest bucket [4.096ms, 8.192ms) has the
+  // longest bar.
+  EXPECT_THAT(output, HasSubstr("Latency Histogram"));
+  EXPECT_THAT(output, HasSubstr("128.000us) 1 *"));
+  EXPECT_THAT(output, HasSubstr("8.192ms) 41 " + std::string(50, '*') + "\n"));
+  EXPECT_THAT(output, HasSubstr("16.384ms) 19 "));
+}
+
 TEST(BenchmarkTest, PrintCsv) {
   char* argv[] = {arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7};
   int argc = sizeof(argv) / sizeof(argv[0]);
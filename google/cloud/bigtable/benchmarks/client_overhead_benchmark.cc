@@ -0,0 +1,445 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/benchmark.h"
+#include "google/cloud/bigtable/benchmarks/embedded_server.h"
+#include "google/cloud/bigtable/benchmarks/random_mutation.h"
+#include "google/cloud/bigtable/mutation_batcher.h"
+#include "google/cloud/bigtable/table.h"
+#include "google/cloud/internal/getenv.h"
+#include "google/cloud/internal/random.h"
+#include "google/cloud/testing_util/allocation_counter.h"
+#include "google/cloud/testing_util/command_line_parsing.h"
+#include "google/cloud/testing_util/timer.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+/**
+ * @file
+ *
+ * Measure the client-side overhead of the Cloud Bigtable C++ client.
+ *
+ * This benchmark runs an embedded server in the same process, and measures the
+ * CPU time, the number of memory allocations, and the latency of:
+ *
+ * - `Table::ReadRows()` scanning `--scan-size` rows.
+ * - `Table::BulkApply()` with `--bulk-size` rows.
+ * - `Table::ReadRow()`.
+ * - `MutationBatcher::AsyncApply()` with `--bulk-size` rows.
+ *
+ * The server does not store any data, it returns rows with `--cells-per-row`
+ * cells of `--cell-size` bytes, optionally splitting each cell in several
+ * chunks, and packing several rows in each response. The server can also delay
+ * each response, and inject (retryable) errors.
+ *
+ * The CPU time and allocations are only measured in the threads running the
+ * client, and exclude the threads running the embedded server. Some of the
+ * work in the client happens in gRPC's internal threads, which are not
+ * measured either. The results are best used to compare two versions of the
+ * client on the same machine, they do not predict the overhead in production.
+ */
+
+namespace {
+namespace bigtable = ::google::cloud::bigtable;
+using ::google::cloud::Status;
+using ::google::cloud::StatusCode;
+using ::google::cloud::StatusOr;
+using ::google::cloud::bigtable::benchmarks::Benchmark;
+using ::google::cloud::bigtable::benchmarks::BenchmarkResult;
+using ::google::cloud::bigtable::benchmarks::EmbeddedServerOptions;
+using ::google::cloud::bigtable::benchmarks::FormatDuration;
+using ::google::cloud::bigtable::benchmarks::kColumnFamily;
+using ::google::cloud::testing_util::AllocationCounter;
+using ::google::cloud::testing_util::Timer;
+
+// Only count allocations in the threads running the client library, the
+// server threads never start this counter.
+AllocationCounter allocation_counter;
+
+auto constexpr kDescription = R"""(
+A client-side overhead benchmark for the Cloud Bigtable C++ client library.
+
+Measure the CPU time, the memory allocations, and the latency of the client
+library against an embedded server, running in the same process. The server
+can be configured to generate different loads.
+)""";
+
+struct Config {
+  EmbeddedServerOptions server;
+  std::int64_t scan_size = 1000;
+  int bulk_size = 100;
+  std::chrono::seconds duration = std::chrono::seconds(10);
+
+  bool show_help = false;
+};
+
+StatusOr<Config> ParseArgs(std::vector<std::string> args);
+
+/// The result of running one of the operations for `Config::duration`.
+struct OverheadResult {
+  BenchmarkResult result;
+  std::chrono::microseconds cpu_time;
+  std::int64_t allocations;
+  std::int64_t errors;
+};
+
+/**
+ * Run @p run (with the input created by @p prepare) repeatedly.
+ *
+ * Only @p run is measured, @p prepare can be used to create any inputs without
+ * affecting the results.
+ */
+template <typename Prepare, typename Run>
+OverheadResult RunOperation(Config const& config, Prepare prepare, Run run) {
+  OverheadResult r{};
+  auto const start = std::chrono::steady_clock::now();
+  auto const end = start + config.duration;
+  for (auto now = start; now < end; now = std::chrono::steady_clock::now()) {
+    auto input = prepare();
+    std::int64_t rows = 0;
+    Timer timer;
+    timer.Start();
+    auto const allocations = allocation_counter.count();
+    allocation_counter.Start();
+    auto op = Benchmark::TimeOperation([&]() -> Status {
+      auto n = run(std::move(input));
+      if (!n) return n.status();
+      rows = *n;
+      return Status{};
+    });
+    allocation_counter.Stop();
+    r.allocations += allocation_counter.count() - allocations;
+    timer.Stop();
+    r.cpu_time += timer.cpu_time();
+    if (!op.status.ok()) ++r.errors;
+    r.result.row_count += rows;
+    r.result.operations.push_back(std::move(op));
+  }
+  r.result.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  return r;
+}
+
+/// Run a CompletionQueue, measuring the CPU time and allocations in its thread.
+class MeasuredCompletionQueue {
+ public:
+  MeasuredCompletionQueue()
+      : thread_([this] {
+          allocation_counter.Start();
+          timer_.Start();
+          cq_.Run();
+          timer_.Stop();
+        }) {}
+  ~MeasuredCompletionQueue() {
+    if (thread_.joinable()) Shutdown();
+  }
+
+  google::cloud::CompletionQueue& cq() { return cq_; }
+
+  /// Stop the thread and return its CPU time.
+  std::chrono::microseconds Shutdown() {
+    cq_.Shutdown();
+    thread_.join();
+    return timer_.cpu_time();
+  }
+
+ private:
+  google::cloud::CompletionQueue cq_;
+  Timer timer_;
+  std::thread thread_;
+};
+
+void PrintResult(std::string const& operation, OverheadResult& r) {
+  auto const rows = (std::max)(std::int64_t{1}, r.result.row_count);
+  auto const cpu_per_row = std::chrono::nanoseconds(
+      std::chrono::nanoseconds(r.cpu_time).count() / rows);
+  std::cout << "# Operation=" << operation
+            << ", Count=" << r.result.operations.size()
+            << ", Rows=" << r.result.row_count << ", Errors=" << r.errors
+            << ", CPU/row=" << FormatDuration(cpu_per_row)
+            << ", Allocations/row="
+            << static_cast<double>(r.allocations) / static_cast<double>(rows)
+            << "\n";
+  Benchmark::PrintLatencyResult(std::cout, "client-overhead", operation,
+                                r.result);
+  Benchmark::PrintLatencyHistogram(std::cout, "client-overhead", operation,
+                                   r.result);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  auto config = ParseArgs({argv, argv + argc});
+  if (!config) {
+    std::cerr << "Error parsing command-line arguments\n";
+    std::cerr << config.status() << "\n";
+    return 1;
+  }
+  if (config->show_help) return 0;
+
+  std::cout << "# Cells per Row: " << config->server.cells_per_row
+            << "\n# Cell Size: " << config->server.cell_size
+            << "\n# Chunks per Cell: " << config->server.chunks_per_cell
+            << "\n# Rows per Response: " << config->server.rows_per_response
+            << "\n# Latency: " << FormatDuration(config->server.latency)
+            << "\n# Error Rate: " << config->server.error_rate
+            << "\n# Scan Size: " << config->scan_size
+            << "\n# Bulk Size: " << config->bulk_size
+            << "\n# Duration: " << FormatDuration(config->duration) << "\n";
+
+  auto server = bigtable::benchmarks::CreateEmbeddedServer(config->server);
+  std::thread server_thread([&server] { server->Wait(); });
+
+  bigtable::ClientOptions options(grpc::InsecureChannelCredentials());
+  options.set_data_endpoint(server->address());
+  options.set_connection_pool_size(1);
+  bigtable::Table table(bigtable::CreateDefaultDataClient(
+                            "benchmark-project", "benchmark-instance", options),
+                        "benchmark-table");
+
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+  // Create the values before the benchmark, so the mutations are cheap to
+  // create.
+  std::vector<std::string> values(100);
+  std::generate(values.begin(), values.end(), [&] {
+    return bigtable::benchmarks::MakeRandomValue(generator,
+                                                 config->server.cell_size);
+  });
+  std::size_t value_index = 0;
+  auto make_mutation = [&](std::string row_key) {
+    bigtable::SingleRowMutation mutation(std::move(row_key));
+    for (int i = 0; i != config->server.cells_per_row; ++i) {
+      mutation.emplace_back(bigtable::SetCell(
+          kColumnFamily, "field" + std::to_string(i),
+          std::chrono::milliseconds(0), values[value_index]));
+      value_index = (value_index + 1) % values.size();
+    }
+    return mutation;
+  };
+  auto make_key = [&generator] {
+    return "user" + std::to_string(std::uniform_int_distribution<int>(
+                        0, 1000000)(generator));
+  };
+
+  auto read_rows = RunOperation(
+      *config, [] { return 0; },
+      [&](int) -> StatusOr<std::int64_t> {
+        auto reader = table.ReadRows(bigtable::RowRange::InfiniteRange(),
+                                     config->scan_size,
+                                     bigtable::Filter::PassAllFilter());
+        std::int64_t count = 0;
+        for (auto& row : reader) {
+          if (!row) return std::move(row).status();
+          ++count;
+        }
+        return count;
+      });
+  PrintResult("ReadRows()", read_rows);
+
+  auto bulk_apply = RunOperation(
+      *config,
+      [&] {
+        bigtable::BulkMutation bulk;
+        for (int i = 0; i != config->bulk_size; ++i) {
+          bulk.emplace_back(make_mutation(make_key()));
+        }
+        return bulk;
+      },
+      [&](bigtable::BulkMutation bulk) -> StatusOr<std::int64_t> {
+        auto const size = static_cast<std::int64_t>(bulk.size());
+        auto failures = table.BulkApply(std::move(bulk));
+        if (!failures.empty()) return failures.front().status();
+        return size;
+      });
+  PrintResult("BulkApply()", bulk_apply);
+
+  auto read_row = RunOperation(
+      *config, make_key, [&](std::string key) -> StatusOr<std::int64_t> {
+        auto row =
+            table.ReadRow(std::move(key), bigtable::Filter::PassAllFilter());
+        if (!row) return std::move(row).status();
+        return row->first ? 1 : 0;
+      });
+  PrintResult("ReadRow()", read_row);
+
+  MeasuredCompletionQueue background;
+  bigtable::MutationBatcher batcher(table);
+  auto batcher_apply = RunOperation(
+      *config,
+      [&] {
+        std::vector<bigtable::SingleRowMutation> mutations;
+        for (int i = 0; i != config->bulk_size; ++i) {
+          mutations.push_back(make_mutation(make_key()));
+        }
+        return mutations;
+      },
+      [&](std::vector<bigtable::SingleRowMutation> mutations)
+          -> StatusOr<std::int64_t> {
+        std::vector<google::cloud::future<Status>> pending;
+        pending.reserve(mutations.size());
+        for (auto& m : mutations) {
+          auto f = batcher.AsyncApply(background.cq(), std::move(m));
+          // Respect the flow control in the batcher.
+          f.first.get();
+          pending.push_back(std::move(f.second));
+        }
+        Status status;
+        for (auto& f : pending) {
+          auto s = f.get();
+          if (!s.ok()) status = std::move(s);
+        }
+        if (!status.ok()) return status;
+        return static_cast<std::int64_t>(pending.size());
+      });
+  batcher_apply.cpu_time += background.Shutdown();
+  PrintResult("MutationBatcher::AsyncApply()", batcher_apply);
+
+  server->Shutdown();
+  server_thread.join();
+
+  return 0;
+}
+
+namespace {
+using ::google::cloud::internal::GetEnv;
+using ::google::cloud::testing_util::OptionDescriptor;
+using ::google::cloud::testing_util::ParseBufferSize;
+using ::google::cloud::testing_util::ParseDuration;
+
+StatusOr<Config> ParseArgsImpl(std::vector<std::string> args,
+                               std::string const& description) {
+  Config options;
+  bool show_help = false;
+  bool show_description = false;
+
+  std::vector<OptionDescriptor> desc{
+      {"--help", "print usage information",
+       [&show_help](std::string const&) { show_help = true; }},
+      {"--description", "print benchmark description",
+       [&show_description](std::string const&) { show_description = true; }},
+
+      {"--cells-per-row", "the number of cells in each row",
+       [&options](std::string const& val) {
+         options.server.cells_per_row = std::stoi(val);
+       }},
+      {"--cell-size", "the size of each cell value",
+       [&options](std::string const& val) {
+         options.server.cell_size = ParseBufferSize(val);
+       }},
+      {"--chunks-per-cell", "split each cell value in this many chunks",
+       [&options](std::string const& val) {
+         options.server.chunks_per_cell = std::stoi(val);
+       }},
+      {"--rows-per-response", "the number of rows in each ReadRows response",
+       [&options](std::string const& val) {
+         options.server.rows_per_response = std::stoi(val);
+       }},
+      {"--latency-us", "delay each response by this many microseconds",
+       [&options](std::string const& val) {
+         options.server.latency = std::chrono::microseconds(std::stol(val));
+       }},
+      {"--error-rate", "the probability of an error in each request",
+       [&options](std::string const& val) {
+         options.server.error_rate = std::stod(val);
+       }},
+
+      {"--scan-size", "the number of rows in each ReadRows() call",
+       [&options](std::string const& val) {
+         options.scan_size = std::stol(val);
+       }},
+      {"--bulk-size", "the number of rows in each BulkApply() call",
+       [&options](std::string const& val) {
+         options.bulk_size = std::stoi(val);
+       }},
+      {"--duration", "run each operation for this time",
+       [&options](std::string const& val) {
+         options.duration = ParseDuration(val);
+       }},
+  };
+  auto const usage = BuildUsage(desc, args[0]);
+  auto unparsed = OptionsParse(desc, args);
+
+  if (show_description) {
+    std::cout << description << "\n\n";
+  }
+
+  if (show_help) {
+    std::cout << usage << "\n";
+    options.show_help = true;
+    return options;
+  }
+
+  if (unparsed.size() != 1) {
+    return Status(StatusCode::kInvalidArgument,
+                  "unexpected arguments for the benchmark");
+  }
+  if (options.server.cells_per_row <= 0 ||
+      options.server.chunks_per_cell <= 0 ||
+      options.server.rows_per_response <= 0) {
+    return Status(StatusCode::kInvalidArgument,
+                  "--cells-per-row, --chunks-per-cell and --rows-per-response "
+                  "must be positive");
+  }
+  if (options.server.error_rate < 0 || options.server.error_rate >= 1) {
+    return Status(StatusCode::kInvalidArgument,
+                  "--error-rate must be in the [0, 1) range");
+  }
+  if (options.scan_size <= 0 || options.bulk_size <= 0) {
+    return Status(StatusCode::kInvalidArgument,
+                  "--scan-size and --bulk-size must be positive");
+  }
+
+  return options;
+}
+
+StatusOr<Config> SelfTest(std::string const& cmd) {
+  auto error = [](std::string m) {
+    return Status(StatusCode::kUnknown, std::move(m));
+  };
+  auto config = ParseArgsImpl({cmd, "--help"}, kDescription);
+  if (!config || !config->show_help) return error("--help parsing");
+  config = ParseArgsImpl({cmd, "--description", "--help"}, kDescription);
+  if (!config || !config->show_help) return error("--description parsing");
+  config = ParseArgsImpl({cmd, "--error-rate=2"}, kDescription);
+  if (config) return error("--error-rate validation");
+  config = ParseArgsImpl({cmd, "--chunks-per-cell=0"}, kDescription);
+  if (config) return error("--chunks-per-cell validation");
+
+  return ParseArgsImpl(
+      {
+          cmd,
+          "--cells-per-row=5",
+          "--cell-size=1KiB",
+          "--chunks-per-cell=2",
+          "--rows-per-response=10",
+          "--error-rate=0.01",
+          "--scan-size=100",
+          "--bulk-size=10",
+          "--duration=1s",
+      },
+      kDescription);
+}
+
+StatusOr<Config> ParseArgs(std::vector<std::string> args) {
+  bool auto_run =
+      GetEnv("GOOGLE_CLOUD_CPP_AUTO_RUN_EXAMPLES").value_or("") == "yes";
+  if (auto_run) return SelfTest(args[0]);
+  return ParseArgsImpl(std::move(args), kDescription);
+}
+
+}  // namespace
@@ -17,9 +17,13 @@
 #include "google/cloud/bigtable/benchmarks/setup.h"
 #include <google/bigtable/admin/v2/bigtable_table_admin.grpc.pb.h>
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <algorithm>
 #include <atomic>
 #include <iomanip>
+#include <mutex>
+#include <random>
 #include <sstream>
+#include <thread>
 
 namespace btproto = google::bigtable::v2;
 namespace btadmin = google::bigtable::admin::v2;
@@ -39,21 +43,27 @@ namespace benchmarks {
  */
 class BigtableImpl final : public btproto::Bigtable::Service {
  public:
-  BigtableImpl()
-      : mutate_row_count_(0), mutate_rows_count_(0), read_rows_count_(0) {
+  explicit BigtableImpl(EmbeddedServerOptions options)
+      : options_(std::move(options)),
+        generator_(google::cloud::internal::MakeDefaultPRNG()),
+        mutate_row_count_(0),
+        mutate_rows_count_(0),
+        read_rows_count_(0) {
     // Prepare a list of random values to use at run-time.  This is because we
     // want the overhead of this implementation to be as small as possible.
     // Using a single value is an option, but compresses too well and makes the
     // tests a bit unrealistic.
-    auto generator = google::cloud::internal::MakeDefaultPRNG();
     values_.resize(1000);
-    std::generate(values_.begin(), values_.end(),
-                  [&generator]() { return MakeRandomValue(generator); });
+    std::generate(values_.begin(), values_.end(), [this]() {
+      return MakeRandomValue(generator_, options_.cell_size);
+    });
   }
 
   grpc::Status MutateRow(grpc::ServerContext*, btproto::MutateRowRequest const*,
                          btproto::MutateRowResponse*) override {
     ++mutate_row_count_;
+    SimulateLatency();
+    if (InjectError()) return TransientError();
     return grpc::Status::OK;
   }
 
@@ -61,11 +71,13 @@ class BigtableImpl final : public btproto::Bigtable::Service {
       grpc::ServerContext*, btproto::MutateRowsRequest const* request,
       grpc::ServerWriter<btproto::MutateRowsResponse>* writer) override {
     ++mutate_rows_count_;
+    SimulateLatency();
     btproto::MutateRowsResponse msg;
     for (int index = 0; index != request->entries_size(); ++index) {
       auto& entry = *msg.add_entries();
       entry.set_index(index);
-      entry.mutable_status()->set_code(grpc::StatusCode::OK);
+      entry.mutable_status()->set_code(InjectError() ? grpc::UNAVAILABLE
+                                                     : grpc::OK);
     }
     writer->WriteLast(msg, grpc::WriteOptions());
     return grpc::Status::OK;
@@ -75,38 +87,38 @@ class BigtableImpl final : public btproto::Bigtable::Service {
       grpc::ServerContext*, btproto::ReadRowsRequest const* request,
       grpc::ServerWriter<btproto::ReadRowsResponse>* writer) override {
     ++read_rows_count_;
+    SimulateLatency();
     std::int64_t rows_limit = 10000;
     if (request->rows_limit() != 0) {
       rows_limit = request->rows_limit();
     }
+    // If the request fails, it fails after returning `fail_after` rows.
+    auto fail_after = rows_limit;
+    if (InjectError()) fail_after = RandomRowCount(rows_limit);
+
+    auto const cells_per_row = (std::max)(1, options_.cells_per_row);
+    auto const rows_per_response = (std::max)(1, options_.rows_per_response);
+    // Retried requests resume after the last row received by the client.
+    auto const first_row = FirstRow(*request);
 
     btproto::ReadRowsResponse msg;
+    std::size_t idx = 0;
     for (std::int64_t i = 0; i != rows_limit; ++i) {
-      std::size_t idx = 0;
-      char const* cf = kColumnFamily;
+      if (i == fail_after) {
+        if (msg.chunks_size() != 0) writer->Write(msg);
+        return TransientError();
+      }
       std::ostringstream os;
-      os << "user" << std::setw(12) << std::setfill('0') << i;
+      os << "user" << std::setw(12) << std::setfill('0') << first_row + i;
       std::string row_key = os.str();
-      for (int j = 0; j != kNumFields; ++j) {
-        auto& chunk = *msg.add_chunks();
-        // This is neither the real format of the keys, nor the keys requested,
-        // but it is good enough for a simulation.
-        chunk.set_row_key(row_key);
-        chunk.set_timestamp_micros(0);
-        chunk.mutable_family_name()->set_value(cf);
-        chunk.mutable_qualifier()->set_value("field" + std::to_string(j));
-        chunk.set_value(values_[idx]);
-        chunk.set_value_size(static_cast<std::int32_t>(values_[idx].size()));
+      for (int j = 0; j != cells_per_row; ++j) {
+        AddCell(msg, row_key, j, values_[idx]);
         if (++idx >= values_.size()) {
           idx = 0;
         }
-        cf = "";
-        if (j == kNumFields - 1) {
-          chunk.set_value_size(0);
-          chunk.set_commit_row(true);
-        }
       }
-      if (i != request->rows_limit() - 1) {
+      msg.mutable_chunks()->rbegin()->set_commit_row(true);
+      if ((i + 1) % rows_per_response == 0 && i != rows_limit - 1) {
         writer->Write(msg);
         msg = {};
       }
@@ -120,6 +132,75 @@ class BigtableImpl final : public btproto::Bigtable::Service {
   int read_rows_count() const { return read_rows_count_.load(); }
 
  private:
+  /// Return the index of the first row in the range requested.
+  static std::int64_t FirstRow(btproto::ReadRowsRequest const& request) {
+    if (request.rows().row_ranges_size() == 0) return 0;
+    auto const& range = request.rows().row_ranges(0);
+    auto const open =
+        range.start_key_case() == btproto::RowRange::kStartKeyOpen;
+    auto const& key = open ? range.start_key_open() : range.start_key_closed();
+    if (key.compare(0, 4, "user") != 0) return 0;
+    std::int64_t index = 0;
+    std::istringstream(key.substr(4)) >> index;
+    return open ? index + 1 : index;
+  }
+
+  /// Add the chunks for a cell, splitting the value as configured.
+  void AddCell(btproto::ReadRowsResponse& msg, std::string const& row_key,
+               int column, std::string const& value) const {
+    auto const chunks =
+        static_cast<std::size_t>((std::max)(1, options_.chunks_per_cell));
+    auto const chunk_size = (value.size() + chunks - 1) / chunks;
+    auto& first = *msg.add_chunks();
+    // This is neither the real format of the keys, nor the keys requested,
+    // but it is good enough for a simulation.
+    if (column == 0) {
+      first.set_row_key(row_key);
+      first.mutable_family_name()->set_value(kColumnFamily);
+    }
+    first.mutable_qualifier()->set_value("field" + std::to_string(column));
+    first.set_timestamp_micros(0);
+    if (chunk_size >= value.size()) {
+      first.set_value(value);
+      return;
+    }
+    first.set_value(value.substr(0, chunk_size));
+    first.set_value_size(static_cast<std::int32_t>(value.size()));
+    for (auto offset = chunk_size; offset < value.size();
+         offset += chunk_size) {
+      auto& chunk = *msg.add_chunks();
+      chunk.set_value(value.substr(offset, chunk_size));
+      if (offset + chunk_size < value.size()) {
+        chunk.set_value_size(static_cast<std::int32_t>(value.size()));
+      }
+    }
+  }
+
+  void SimulateLatency() const {
+    if (options_.latency.count() == 0) return;
+    std::this_thread::sleep_for(options_.latency);
+  }
+
+  bool InjectError() {
+    if (options_.error_rate <= 0.0) return false;
+    std::lock_guard<std::mutex> lk(mu_);
+    return std::uniform_real_distribution<double>(0, 1)(generator_) <
+           options_.error_rate;
+  }
+
+  std::int64_t RandomRowCount(std::int64_t rows_limit) {
+    std::lock_guard<std::mutex> lk(mu_);
+    return std::uniform_int_distribution<std::int64_t>(0, rows_limit - 1)(
+        generator_);
+  }
+
+  static grpc::Status TransientError() {
+    return grpc::Status(grpc::StatusCode::UNAVAILABLE, "injected error");
+  }
+
+  EmbeddedServerOptions const options_;
+  std::mutex mu_;
+  google::cloud::internal::DefaultPRNG generator_;
   std::vector<std::string> values_;
   std::atomic<int> mutate_row_count_;
   std::atomic<int> mutate_rows_count_;
@@ -160,7 +241,8 @@ class TableAdminImpl final : public btadmin::BigtableTableAdmin::Service {
 /// The implementation of EmbeddedServer.
 class DefaultEmbeddedServer : public EmbeddedServer {
  public:
-  explicit DefaultEmbeddedServer() {
+  explicit DefaultEmbeddedServer(EmbeddedServerOptions options)
+      : bigtable_service_(std::move(options)) {
     int port;
     std::string server_address("[::]:0");
     builder_.AddListeningPort(server_address, grpc::InsecureServerCredentials(),
@@ -200,7 +282,13 @@ class DefaultEmbeddedServer : public EmbeddedServer {
 };
 
 std::unique_ptr<EmbeddedServer> CreateEmbeddedServer() {
-  return std::unique_ptr<EmbeddedServer>(new DefaultEmbeddedServer);
+  return CreateEmbeddedServer(EmbeddedServerOptions{});
+}
+
+std::unique_ptr<EmbeddedServer> CreateEmbeddedServer(
+    EmbeddedServerOptions options) {
+  return std::unique_ptr<EmbeddedServer>(
+      new DefaultEmbeddedServer(std::move(options)));
 }
 
 }  // namespace benchmarks
@@ -15,6 +15,9 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_EMBEDDED_SERVER_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_EMBEDDED_SERVER_H
 
+#include "google/cloud/bigtable/benchmarks/constants.h"
+#include <chrono>
+#include <cstddef>
 #include <memory>
 #include <string>
 
@@ -46,9 +49,40 @@ class EmbeddedServer {
   virtual int read_rows_count() const = 0;
 };
 
+/**
+ * Configure the load generated by the embedded server.
+ *
+ * The defaults match the table used by the benchmarks: each row has
+ * `kNumFields` cells of `kFieldSize` bytes, sent in a single chunk, one row
+ * per response, with no added latency or errors.
+ */
+struct EmbeddedServerOptions {
+  /// The number of cells in each row returned by `ReadRows`.
+  int cells_per_row = kNumFields;
+  /// The size of each cell value returned by `ReadRows`.
+  std::size_t cell_size = kFieldSize;
+  /// Split each cell value in this many chunks.
+  int chunks_per_cell = 1;
+  /// The number of rows in each `ReadRowsResponse` message.
+  int rows_per_response = 1;
+  /// Wait this long before answering each request.
+  std::chrono::microseconds latency = std::chrono::microseconds(0);
+  /**
+   * The probability of a (retryable) error in each request.
+   *
+   * `MutateRows` fails each entry with this probability. `ReadRows` fails
+   * with this probability, after returning a random number of rows.
+   */
+  double error_rate = 0.0;
+};
+
 /// Create an embedded server.
 std::unique_ptr<EmbeddedServer> CreateEmbeddedServer();
 
+/// Create an embedded server generating the load described by @p options.
+std::unique_ptr<EmbeddedServer> CreateEmbeddedServer(
+    EmbeddedServerOptions options);
+
 }  // namespace benchmarks
 }  // namespace bigtable
 }  // namespace cloud
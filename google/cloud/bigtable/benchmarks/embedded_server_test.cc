@@ -148,3 +148,70 @@ TEST(EmbeddedServer, ReadRows100) {
   server->Shutdown();
   wait_thread.join();
 }
+
+TEST(EmbeddedServer, ReadRowsWithOptions) {
+  bigtable::benchmarks::EmbeddedServerOptions server_options;
+  server_options.cells_per_row = 3;
+  server_options.cell_size = 10;
+  server_options.chunks_per_cell = 4;
+  server_options.rows_per_response = 7;
+  auto server = CreateEmbeddedServer(server_options);
+  std::thread wait_thread([&server]() { server->Wait(); });
+
+  bigtable::ClientOptions options(grpc::InsecureChannelCredentials());
+  options.set_data_endpoint(server->address());
+  bigtable::Table table(bigtable::CreateDefaultDataClient(
+                            "fake-project", "fake-instance", options),
+                        "fake-table");
+
+  auto reader =
+      table.ReadRows(bigtable::RowSet(bigtable::RowRange::InfiniteRange()), 20,
+                     bigtable::Filter::PassAllFilter());
+  int count = 0;
+  for (auto& row : reader) {
+    ASSERT_STATUS_OK(row);
+    ASSERT_EQ(3U, row->cells().size());
+    for (auto const& cell : row->cells()) {
+      EXPECT_EQ(10U, cell.value().size());
+    }
+    ++count;
+  }
+  EXPECT_EQ(20, count);
+  EXPECT_EQ(1, server->read_rows_count());
+
+  server->Shutdown();
+  wait_thread.join();
+}
+
+TEST(EmbeddedServer, ReadRowsWithErrors) {
+  bigtable::benchmarks::EmbeddedServerOptions server_options;
+  server_options.error_rate = 0.5;
+  auto server = CreateEmbeddedServer(server_options);
+  std::thread wait_thread([&server]() { server->Wait(); });
+
+  bigtable::ClientOptions options(grpc::InsecureChannelCredentials());
+  options.set_data_endpoint(server->address());
+  bigtable::Table table(
+      bigtable::CreateDefaultDataClient("fake-project", "fake-instance",
+                                        options),
+      "fake-table", bigtable::LimitedErrorCountRetryPolicy(100),
+      bigtable::ExponentialBackoffPolicy(milliseconds(1), milliseconds(5)));
+
+  // The injected errors are retried, and the retries resume after the last row
+  // received, so the client sees each row exactly once.
+  auto reader =
+      table.ReadRows(bigtable::RowSet(bigtable::RowRange::InfiniteRange()),
+                     100, bigtable::Filter::PassAllFilter());
+  std::string last;
+  int count = 0;
+  for (auto& row : reader) {
+    ASSERT_STATUS_OK(row);
+    EXPECT_LT(last, row->row_key());
+    last = row->row_key();
+    ++count;
+  }
+  EXPECT_EQ(100, count);
+
+  server->Shutdown();
+  wait_thread.join();
+}
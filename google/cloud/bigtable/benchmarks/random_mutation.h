@@ -30,6 +30,10 @@ bigtable::Mutation MakeRandomMutation(google::cloud::internal::DefaultPRNG& gen,
 /// Create a random value to store in a field.
 std::string MakeRandomValue(google::cloud::internal::DefaultPRNG& gen);
 
+/// Create a random value of @p size bytes.
+std::string MakeRandomValue(google::cloud::internal::DefaultPRNG& gen,
+                            std::size_t size);
+
 }  // namespace benchmarks
 }  // namespace bigtable
 }  // namespace cloud
@@ -29,6 +29,7 @@ bigtable_client_hdrs = [
     "data_client.h",
     "expr.h",
     "filters.h",
+    "hedging_policy.h",
     "iam_binding.h",
     "iam_policy.h",
     "idempotent_mutation_policy.h",
@@ -48,10 +49,13 @@ bigtable_client_hdrs = [
     "internal/common_client.h",
     "internal/google_bytes_traits.h",
     "internal/prefix_range_end.h",
+    "internal/read_ahead_buffer.h",
     "internal/readrowsparser.h",
+    "internal/row_cache_impl.h",
     "internal/rowreaderiterator.h",
     "internal/rpc_policy_parameters.h",
     "internal/rpc_policy_parameters.inc",
+    "internal/sorted_row_set.h",
     "internal/unary_client_utils.h",
     "metadata_update_policy.h",
     "mutation_batcher.h",
@@ -59,6 +63,7 @@ bigtable_client_hdrs = [
     "polling_policy.h",
     "read_modify_write_rule.h",
     "row.h",
+    "row_cache.h",
     "row_key.h",
     "row_key_sample.h",
     "row_range.h",
@@ -80,6 +85,7 @@ bigtable_client_srcs = [
     "cluster_config.cc",
     "data_client.cc",
     "expr.cc",
+    "hedging_policy.cc",
     "iam_binding.cc",
     "iam_policy.cc",
     "idempotent_mutation_policy.cc",
@@ -92,12 +98,16 @@ bigtable_client_srcs = [
     "internal/common_client.cc",
     "internal/google_bytes_traits.cc",
     "internal/prefix_range_end.cc",
+    "internal/read_ahead_buffer.cc",
     "internal/readrowsparser.cc",
+    "internal/row_cache_impl.cc",
     "internal/rowreaderiterator.cc",
+    "internal/sorted_row_set.cc",
     "metadata_update_policy.cc",
     "mutation_batcher.cc",
     "mutations.cc",
     "polling_policy.cc",
+    "row_cache.cc",
     "row_range.cc",
     "row_reader.cc",
     "row_set.cc",
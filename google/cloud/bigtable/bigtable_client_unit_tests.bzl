@@ -33,6 +33,7 @@ bigtable_client_unit_tests = [
     "expr_test.cc",
     "filters_test.cc",
     "force_sanitizer_failures_test.cc",
+    "hedging_policy_test.cc",
     "iam_binding_test.cc",
     "iam_policy_test.cc",
     "idempotent_mutation_policy_test.cc",
@@ -48,6 +49,8 @@ bigtable_client_unit_tests = [
     "internal/bulk_mutator_test.cc",
     "internal/google_bytes_traits_test.cc",
     "internal/prefix_range_end_test.cc",
+    "internal/row_cache_impl_test.cc",
+    "internal/sorted_row_set_test.cc",
     "metadata_update_policy_test.cc",
     "mutation_batcher_test.cc",
     "mutations_test.cc",
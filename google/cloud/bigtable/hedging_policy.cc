@@ -0,0 +1,161 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/hedging_policy.h"
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+std::shared_ptr<HedgingBudget> DefaultHedgingBudget(
+    std::shared_ptr<HedgingBudget> budget) {
+  if (budget) return budget;
+  return std::make_shared<HedgingBudget>(/*hedge_ratio=*/0.05,
+                                         /*max_tokens=*/10.0);
+}
+}  // namespace
+
+HedgingBudget::HedgingBudget(double hedge_ratio, double max_tokens)
+    : deposit_(static_cast<std::int64_t>(hedge_ratio * kScale)),
+      capacity_(static_cast<std::int64_t>(max_tokens * kScale)),
+      tokens_(capacity_) {}
+
+void HedgingBudget::OnRequest() {
+  auto current = tokens_.load();
+  std::int64_t desired;
+  do {
+    if (current >= capacity_) return;
+    desired = (std::min)(capacity_, current + deposit_);
+  } while (!tokens_.compare_exchange_weak(current, desired));
+}
+
+bool HedgingBudget::TryAcquire() {
+  auto current = tokens_.load();
+  do {
+    if (current < kScale) {
+      ++hedges_rejected_;
+      return false;
+    }
+  } while (!tokens_.compare_exchange_weak(current, current - kScale));
+  ++hedges_sent_;
+  return true;
+}
+
+FixedDelayHedgingPolicy::FixedDelayHedgingPolicy(
+    std::chrono::milliseconds delay, std::shared_ptr<HedgingBudget> budget)
+    : delay_(delay), budget_(DefaultHedgingBudget(std::move(budget))) {}
+
+std::unique_ptr<HedgingPolicy> FixedDelayHedgingPolicy::clone() const {
+  return std::unique_ptr<HedgingPolicy>(new FixedDelayHedgingPolicy(*this));
+}
+
+void FixedDelayHedgingPolicy::OnRequest() { budget_->OnRequest(); }
+
+bool FixedDelayHedgingPolicy::OnHedge() { return budget_->TryAcquire(); }
+
+/**
+ * Keep a sliding window of recent latency samples.
+ *
+ * Computing the percentile requires a partial sort of the window, which is
+ * too expensive to do for every request. Instead, we recompute the value
+ * every few samples and cache the result in an atomic, so `hedge_delay()`
+ * never blocks.
+ */
+class PercentileHedgingPolicy::LatencyTracker {
+ public:
+  LatencyTracker(double percentile, std::chrono::milliseconds minimum_delay,
+                 std::chrono::milliseconds maximum_delay)
+      : percentile_((std::max)(0.0, (std::min)(percentile, 100.0))),
+        minimum_delay_(minimum_delay),
+        maximum_delay_((std::max)(minimum_delay, maximum_delay)),
+        delay_(maximum_delay_.count()) {
+    samples_.reserve(kWindowSize);
+  }
+
+  std::chrono::milliseconds delay() const {
+    return std::chrono::milliseconds(delay_.load(std::memory_order_relaxed));
+  }
+
+  void Add(std::chrono::microseconds latency) {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (samples_.size() < kWindowSize) {
+      samples_.push_back(latency);
+    } else {
+      samples_[next_] = latency;
+      next_ = (next_ + 1) % kWindowSize;
+    }
+    if (++since_update_ < kUpdateInterval) return;
+    since_update_ = 0;
+    if (samples_.size() < kMinimumSamples) return;
+
+    scratch_ = samples_;
+    auto const index = static_cast<std::size_t>(
+        percentile_ / 100.0 * static_cast<double>(scratch_.size() - 1));
+    std::nth_element(scratch_.begin(), scratch_.begin() + index,
+                     scratch_.end());
+    auto value = std::chrono::duration_cast<std::chrono::milliseconds>(
+        scratch_[index]);
+    value = (std::max)(minimum_delay_, (std::min)(maximum_delay_, value));
+    delay_.store(value.count(), std::memory_order_relaxed);
+  }
+
+ private:
+  static std::size_t constexpr kWindowSize = 1024;
+  static std::size_t constexpr kUpdateInterval = 64;
+  static std::size_t constexpr kMinimumSamples = 100;
+
+  double const percentile_;
+  std::chrono::milliseconds const minimum_delay_;
+  std::chrono::milliseconds const maximum_delay_;
+  std::atomic<std::chrono::milliseconds::rep> delay_;
+
+  std::mutex mu_;
+  std::vector<std::chrono::microseconds> samples_;
+  std::vector<std::chrono::microseconds> scratch_;
+  std::size_t next_ = 0;
+  std::size_t since_update_ = 0;
+};
+
+PercentileHedgingPolicy::PercentileHedgingPolicy(
+    double percentile, std::chrono::milliseconds minimum_delay,
+    std::chrono::milliseconds maximum_delay,
+    std::shared_ptr<HedgingBudget> budget)
+    : tracker_(std::make_shared<LatencyTracker>(percentile, minimum_delay,
+                                                maximum_delay)),
+      budget_(DefaultHedgingBudget(std::move(budget))) {}
+
+std::unique_ptr<HedgingPolicy> PercentileHedgingPolicy::clone() const {
+  return std::unique_ptr<HedgingPolicy>(new PercentileHedgingPolicy(*this));
+}
+
+std::chrono::milliseconds PercentileHedgingPolicy::hedge_delay() const {
+  return tracker_->delay();
+}
+
+void PercentileHedgingPolicy::OnRequest() { budget_->OnRequest(); }
+
+bool PercentileHedgingPolicy::OnHedge() { return budget_->TryAcquire(); }
+
+void PercentileHedgingPolicy::OnCompletion(std::chrono::microseconds latency) {
+  tracker_->Add(latency);
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
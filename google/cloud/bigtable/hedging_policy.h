@@ -0,0 +1,214 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_HEDGING_POLICY_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_HEDGING_POLICY_H
+
+#include "google/cloud/bigtable/version.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Limit the number of hedged requests sent by one or more `Table` objects.
+ *
+ * Hedged requests trade extra load on the service for lower tail latency. That
+ * is a good trade while only a few servers are slow, but it is a bad one
+ * during an incident, when most requests are slow and hedging them would
+ * double the load on an already overloaded service.
+ *
+ * This class implements a token bucket: each (non-hedged) request deposits
+ * @p hedge_ratio tokens in the bucket, and each hedge withdraws one token. If
+ * there are no tokens available the hedge is not sent. In the long run, at
+ * most `hedge_ratio` of the requests are hedged, and at most @p max_tokens
+ * hedges can be sent in a burst.
+ *
+ * Applications can share a single `HedgingBudget` across multiple
+ * `HedgingPolicy` objects (and therefore across multiple `Table` objects) to
+ * limit the total number of hedges sent by the process.
+ *
+ * @par Thread-safety
+ * This class is thread-safe, and uses only atomic operations.
+ */
+class HedgingBudget {
+ public:
+  /**
+   * Create a new budget.
+   *
+   * @param hedge_ratio the fraction of requests that may be hedged, for
+   *     example, use `0.05` to hedge at most 5% of the requests.
+   * @param max_tokens the maximum number of hedges that can be sent in a
+   *     burst. The bucket starts full.
+   */
+  HedgingBudget(double hedge_ratio, double max_tokens);
+
+  /// Deposit tokens for a new (non-hedged) request.
+  void OnRequest();
+
+  /// Withdraw a token for a hedge, returns false if there are none available.
+  bool TryAcquire();
+
+  /// The number of hedges allowed by this budget.
+  std::int64_t hedges_sent() const { return hedges_sent_.load(); }
+
+  /// The number of hedges rejected because the bucket was empty.
+  std::int64_t hedges_rejected() const { return hedges_rejected_.load(); }
+
+ private:
+  // The tokens are kept in fixed-point, with `kScale` units per token, so we
+  // can update them with atomic integer operations.
+  static std::int64_t constexpr kScale = 1000;
+
+  std::int64_t const deposit_;
+  std::int64_t const capacity_;
+  std::atomic<std::int64_t> tokens_;
+  std::atomic<std::int64_t> hedges_sent_{0};
+  std::atomic<std::int64_t> hedges_rejected_{0};
+};
+
+/**
+ * Define the interface to control hedged reads in `Table::ReadRow()` and
+ * `Table::AsyncReadRow()`.
+ *
+ * When a `Table` is configured with a `HedgingPolicy`, point reads that do not
+ * complete within `hedge_delay()` are duplicated: a second `ReadRows` request
+ * is sent (typically over a different channel), the first response is
+ * returned to the application and the other request is cancelled.
+ *
+ * The application provides an instance of this class when the `Table` object
+ * is created. This instance serves as a prototype to create new
+ * `HedgingPolicy` objects for each request. Unlike the retry and backoff
+ * policies, the clones share their state (e.g. the `HedgingBudget`, and any
+ * latency statistics) with the prototype.
+ *
+ * The requests are hedged over the `DataClient` connection pool, so the
+ * hedged request typically uses a different channel than the original one.
+ *
+ * @par Thread-safety
+ * The member functions may be called from any thread running the completion
+ * queue, implementations must be thread-safe.
+ */
+class HedgingPolicy {
+ public:
+  virtual ~HedgingPolicy() = default;
+
+  /// Return a new copy of this object, sharing any budget and statistics.
+  virtual std::unique_ptr<HedgingPolicy> clone() const = 0;
+
+  /// How long to wait for a response before sending a hedged request.
+  virtual std::chrono::milliseconds hedge_delay() const = 0;
+
+  /// Called for each (non-hedged) request.
+  virtual void OnRequest() = 0;
+
+  /// Called before sending a hedged request, return false to skip the hedge.
+  virtual bool OnHedge() = 0;
+
+  /// Called with the latency of each successful request.
+  virtual void OnCompletion(std::chrono::microseconds latency) = 0;
+};
+
+/**
+ * Send a hedged request after a fixed delay.
+ */
+class FixedDelayHedgingPolicy : public HedgingPolicy {
+ public:
+  /**
+   * Create a policy with a fixed delay.
+   *
+   * @param delay how long to wait before sending the hedged request.
+   * @param budget limit the number of hedges, if `nullptr` then hedge at most
+   *     5% of the requests.
+   */
+  template <typename Rep, typename Period>
+  explicit FixedDelayHedgingPolicy(std::chrono::duration<Rep, Period> delay,
+                                   std::shared_ptr<HedgingBudget> budget = {})
+      : FixedDelayHedgingPolicy(
+            std::chrono::duration_cast<std::chrono::milliseconds>(delay),
+            std::move(budget)) {}
+  FixedDelayHedgingPolicy(std::chrono::milliseconds delay,
+                          std::shared_ptr<HedgingBudget> budget);
+
+  std::unique_ptr<HedgingPolicy> clone() const override;
+  std::chrono::milliseconds hedge_delay() const override { return delay_; }
+  void OnRequest() override;
+  bool OnHedge() override;
+  void OnCompletion(std::chrono::microseconds) override {}
+
+ private:
+  std::chrono::milliseconds delay_;
+  std::shared_ptr<HedgingBudget> budget_;
+};
+
+/**
+ * Send a hedged request once a request is slower than most requests.
+ *
+ * This policy tracks the latency of recent requests, and sends a hedged
+ * request when a request takes longer than the given percentile, for example,
+ * the p95 latency. The delay is clamped to `[minimum_delay, maximum_delay]`,
+ * the maximum delay is also used until enough samples are collected.
+ */
+class PercentileHedgingPolicy : public HedgingPolicy {
+ public:
+  /**
+   * Create a policy based on the observed latency.
+   *
+   * @param percentile the latency percentile used as the hedge delay, must be
+   *     in the `(0.0, 100.0)` range, e.g. `95.0`.
+   * @param minimum_delay do not hedge any faster than this.
+   * @param maximum_delay do not wait any longer than this to hedge.
+   * @param budget limit the number of hedges, if `nullptr` then hedge at most
+   *     5% of the requests.
+   */
+  template <typename Rep1, typename Period1, typename Rep2, typename Period2>
+  PercentileHedgingPolicy(double percentile,
+                          std::chrono::duration<Rep1, Period1> minimum_delay,
+                          std::chrono::duration<Rep2, Period2> maximum_delay,
+                          std::shared_ptr<HedgingBudget> budget = {})
+      : PercentileHedgingPolicy(
+            percentile,
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                minimum_delay),
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                maximum_delay),
+            std::move(budget)) {}
+  PercentileHedgingPolicy(double percentile,
+                          std::chrono::milliseconds minimum_delay,
+                          std::chrono::milliseconds maximum_delay,
+                          std::shared_ptr<HedgingBudget> budget);
+
+  std::unique_ptr<HedgingPolicy> clone() const override;
+  std::chrono::milliseconds hedge_delay() const override;
+  void OnRequest() override;
+  bool OnHedge() override;
+  void OnCompletion(std::chrono::microseconds latency) override;
+
+ private:
+  class LatencyTracker;
+
+  std::shared_ptr<LatencyTracker> tracker_;
+  std::shared_ptr<HedgingBudget> budget_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_HEDGING_POLICY_H
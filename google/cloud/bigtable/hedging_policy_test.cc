@@ -0,0 +1,136 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/hedging_policy.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include <gmock/gmock.h>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+using ::google::cloud::testing_util::chrono_literals::operator"" _ms;
+using ::google::cloud::testing_util::chrono_literals::operator"" _us;
+
+TEST(HedgingBudgetTest, StartsFull) {
+  HedgingBudget budget(0.1, 3.0);
+  EXPECT_TRUE(budget.TryAcquire());
+  EXPECT_TRUE(budget.TryAcquire());
+  EXPECT_TRUE(budget.TryAcquire());
+  EXPECT_FALSE(budget.TryAcquire());
+  EXPECT_EQ(3, budget.hedges_sent());
+  EXPECT_EQ(1, budget.hedges_rejected());
+}
+
+TEST(HedgingBudgetTest, RefillsWithRequests) {
+  HedgingBudget budget(0.1, 1.0);
+  EXPECT_TRUE(budget.TryAcquire());
+  EXPECT_FALSE(budget.TryAcquire());
+  for (int i = 0; i != 9; ++i) budget.OnRequest();
+  EXPECT_FALSE(budget.TryAcquire());
+  budget.OnRequest();
+  EXPECT_TRUE(budget.TryAcquire());
+  EXPECT_FALSE(budget.TryAcquire());
+}
+
+TEST(HedgingBudgetTest, CappedAtMaxTokens) {
+  HedgingBudget budget(0.5, 2.0);
+  for (int i = 0; i != 100; ++i) budget.OnRequest();
+  EXPECT_TRUE(budget.TryAcquire());
+  EXPECT_TRUE(budget.TryAcquire());
+  EXPECT_FALSE(budget.TryAcquire());
+}
+
+TEST(HedgingBudgetTest, ThreadSafe) {
+  auto constexpr kThreads = 8;
+  auto constexpr kIterations = 1000;
+  HedgingBudget budget(0.0, 100.0);
+  std::vector<std::thread> tasks;
+  for (int t = 0; t != kThreads; ++t) {
+    tasks.emplace_back([&budget] {
+      for (int i = 0; i != kIterations; ++i) budget.TryAcquire();
+    });
+  }
+  for (auto& t : tasks) t.join();
+  EXPECT_EQ(100, budget.hedges_sent());
+  EXPECT_EQ(kThreads * kIterations - 100, budget.hedges_rejected());
+}
+
+TEST(FixedDelayHedgingPolicyTest, Simple) {
+  auto budget = std::make_shared<HedgingBudget>(0.0, 1.0);
+  FixedDelayHedgingPolicy tested(10_ms, budget);
+  EXPECT_EQ(10_ms, tested.hedge_delay());
+  tested.OnRequest();
+  EXPECT_TRUE(tested.OnHedge());
+  EXPECT_FALSE(tested.OnHedge());
+}
+
+TEST(FixedDelayHedgingPolicyTest, CloneSharesBudget) {
+  auto budget = std::make_shared<HedgingBudget>(0.0, 1.0);
+  FixedDelayHedgingPolicy original(10_ms, budget);
+  auto tested = original.clone();
+  EXPECT_EQ(10_ms, tested->hedge_delay());
+  EXPECT_TRUE(tested->OnHedge());
+  EXPECT_FALSE(original.OnHedge());
+  EXPECT_EQ(1, budget->hedges_sent());
+  EXPECT_EQ(1, budget->hedges_rejected());
+}
+
+TEST(PercentileHedgingPolicyTest, UsesMaximumUntilEnoughSamples) {
+  PercentileHedgingPolicy tested(50.0, 1_ms, 100_ms);
+  EXPECT_EQ(100_ms, tested.hedge_delay());
+  for (int i = 0; i != 10; ++i) tested.OnCompletion(5000_us);
+  EXPECT_EQ(100_ms, tested.hedge_delay());
+}
+
+TEST(PercentileHedgingPolicyTest, TracksPercentile) {
+  PercentileHedgingPolicy tested(90.0, 1_ms, 100_ms);
+  // 90% of the requests take 5ms, 10% take 50ms.
+  for (int i = 0; i != 1024; ++i) {
+    tested.OnCompletion(i % 10 == 0 ? 50000_us : 5000_us);
+  }
+  EXPECT_EQ(5_ms, tested.hedge_delay());
+
+  // Now make 20% of the requests slow.
+  for (int i = 0; i != 1024; ++i) {
+    tested.OnCompletion(i % 5 == 0 ? 50000_us : 5000_us);
+  }
+  EXPECT_EQ(50_ms, tested.hedge_delay());
+}
+
+TEST(PercentileHedgingPolicyTest, Clamped) {
+  PercentileHedgingPolicy tested(50.0, 10_ms, 20_ms);
+  for (int i = 0; i != 1024; ++i) tested.OnCompletion(1000_us);
+  EXPECT_EQ(10_ms, tested.hedge_delay());
+  for (int i = 0; i != 1024; ++i) tested.OnCompletion(100000_us);
+  EXPECT_EQ(20_ms, tested.hedge_delay());
+}
+
+TEST(PercentileHedgingPolicyTest, CloneSharesStatistics) {
+  PercentileHedgingPolicy original(50.0, 1_ms, 100_ms);
+  auto tested = original.clone();
+  for (int i = 0; i != 1024; ++i) tested->OnCompletion(5000_us);
+  EXPECT_EQ(5_ms, original.hedge_delay());
+  EXPECT_EQ(5_ms, tested->hedge_delay());
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -87,6 +87,14 @@ void AsyncRetryBulkApply::OnRead(
 }
 
 void AsyncRetryBulkApply::OnFinish(CompletionQueue cq, Status status) {
+  if (status.ok()) {
+    rpc_retry_policy_->OnSuccess();
+  } else if (!rpc_retry_policy_->OnFailure(status)) {
+    // Stop retrying, all the pending mutations fail with this status.
+    state_.OnFinish(std::move(status));
+    promise_.set_value(std::move(state_).OnRetryDone());
+    return;
+  }
   state_.OnFinish(std::move(status));
   StartIterationIfNeeded(std::move(cq));
 }
@@ -96,6 +96,7 @@ class AsyncRetryMultiPageFuture {
   static void OnCompletion(std::shared_ptr<AsyncRetryMultiPageFuture> self,
                            StatusOr<Response> result) {
     if (result) {
+      self->rpc_retry_policy_->OnSuccess();
       // Something is working, so let's reset backoff policy, so that if a
       // failure happens, we start from small wait periods.
       self->rpc_backoff_policy_ = self->rpc_backoff_policy_prototype_->clone();
@@ -0,0 +1,137 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/read_ahead_buffer.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+ReadAheadBuffer::ReadAheadBuffer(grpc::ClientContext& context, Stream& stream,
+                                 ReadRowsParser& parser, std::size_t max_rows,
+                                 std::size_t max_bytes)
+    : context_(context),
+      stream_(stream),
+      parser_(parser),
+      max_rows_((std::max)(max_rows, std::size_t{1})),
+      max_bytes_(max_bytes),
+      reader_([this] { Run(); }) {}
+
+ReadAheadBuffer::~ReadAheadBuffer() {
+  std::unique_lock<std::mutex> lk(mu_);
+  cancelled_ = true;
+  auto const done = done_;
+  lk.unlock();
+  cv_.notify_all();
+  // The background thread may be blocked in `Read()`, cancelling the context
+  // unblocks it.
+  if (!done) context_.TryCancel();
+  reader_.join();
+}
+
+grpc::Status ReadAheadBuffer::Next(absl::optional<Row>& row) {
+  row.reset();
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return !rows_.empty() || done_; });
+  if (rows_.empty()) return status_;
+  row.emplace(std::move(rows_.front()));
+  rows_.pop_front();
+  bytes_ -= RowSize(*row);
+  lk.unlock();
+  cv_.notify_all();
+  return grpc::Status::OK;
+}
+
+std::size_t ReadAheadBuffer::RowSize(Row const& row) {
+  auto size = row.row_key().size();
+  for (auto const& cell : row.cells()) {
+    size += cell.family_name().size() + cell.column_qualifier().size() +
+            cell.value().size() + sizeof(cell.timestamp());
+    for (auto const& label : cell.labels()) size += label.size();
+  }
+  return size;
+}
+
+void ReadAheadBuffer::Run() {
+  grpc::Status status;
+  google::bigtable::v2::ReadRowsResponse response;
+  // The parser may already have a row, e.g., when it is a test mock.
+  status = Drain();
+  while (status.ok()) {
+    if (!stream_.Read(&response)) {
+      status = stream_.Finish();
+      if (status.ok()) parser_.HandleEndOfStream(status);
+      Done(std::move(status));
+      return;
+    }
+    for (auto& chunk : *response.mutable_chunks()) {
+      parser_.HandleChunk(std::move(chunk), status);
+      if (!status.ok()) break;
+      status = Drain();
+      if (!status.ok()) break;
+    }
+  }
+  // On errors the stream may still be open, cancel it so we can finalize it.
+  context_.TryCancel();
+  while (stream_.Read(&response)) {
+  }
+  (void)stream_.Finish();  // ignore errors, we already have one
+  Done(std::move(status));
+}
+
+grpc::Status ReadAheadBuffer::Drain() {
+  grpc::Status status;
+  while (parser_.HasNext()) {
+    auto row = parser_.Next(status);
+    if (!status.ok()) return status;
+    if (!Push(std::move(row))) {
+      return grpc::Status(grpc::StatusCode::CANCELLED, "read-ahead cancelled");
+    }
+  }
+  return status;
+}
+
+bool ReadAheadBuffer::Push(Row row) {
+  auto const size = RowSize(row);
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this, size] {
+    if (cancelled_) return true;
+    if (rows_.size() >= max_rows_) return false;
+    // Always accept at least one row, even if it is larger than the limit.
+    return rows_.empty() || bytes_ + size <= max_bytes_;
+  });
+  if (cancelled_) return false;
+  rows_.push_back(std::move(row));
+  bytes_ += size;
+  lk.unlock();
+  cv_.notify_all();
+  return true;
+}
+
+void ReadAheadBuffer::Done(grpc::Status status) {
+  std::unique_lock<std::mutex> lk(mu_);
+  done_ = true;
+  status_ = std::move(status);
+  lk.unlock();
+  cv_.notify_all();
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
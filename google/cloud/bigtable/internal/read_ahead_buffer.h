@@ -0,0 +1,116 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_READ_AHEAD_BUFFER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_READ_AHEAD_BUFFER_H
+
+#include "google/cloud/bigtable/internal/readrowsparser.h"
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/version.h"
+#include "absl/types/optional.h"
+#include <google/bigtable/v2/bigtable.pb.h>
+#include <grpcpp/grpcpp.h>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * Read and parse the rows of a `ReadRows` stream in a background thread.
+ *
+ * `RowReader` uses this class to overlap the application's processing with
+ * the network transfer. A background thread reads the stream, parses the
+ * responses, and queues the resulting rows. The queue is bounded by both the
+ * number of rows and (approximately) the number of bytes, so a slow consumer
+ * applies backpressure to the stream.
+ *
+ * The background thread owns @p stream and @p parser until this object is
+ * destroyed, the caller must not use them in the meantime. The stream is
+ * always finalized (by calling `Finish()`) before the background thread
+ * exits.
+ *
+ * @par Thread-safety
+ * `Next()` must be called from a single thread.
+ */
+class ReadAheadBuffer {
+ public:
+  using Stream =
+      grpc::ClientReaderInterface<google::bigtable::v2::ReadRowsResponse>;
+
+  /**
+   * Start reading @p stream in a background thread.
+   *
+   * @param max_rows the maximum number of rows to buffer, must be at least 1.
+   * @param max_bytes the (approximate) maximum number of bytes to buffer. A
+   *     single row larger than this limit is still delivered.
+   */
+  ReadAheadBuffer(grpc::ClientContext& context, Stream& stream,
+                  ReadRowsParser& parser, std::size_t max_rows,
+                  std::size_t max_bytes);
+
+  /// Cancel the stream (if it is still open) and wait for the background
+  /// thread.
+  ~ReadAheadBuffer();
+
+  ReadAheadBuffer(ReadAheadBuffer const&) = delete;
+  ReadAheadBuffer& operator=(ReadAheadBuffer const&) = delete;
+
+  /**
+   * Wait until a row is available, or the stream is closed.
+   *
+   * @param row receives the next row, or is reset if there are no more rows.
+   * @return the status of the stream, only meaningful when @p row is reset.
+   *     All the rows received before an error are returned before the error.
+   */
+  grpc::Status Next(absl::optional<Row>& row);
+
+  /// The approximate size of @p row, used to limit the buffer.
+  static std::size_t RowSize(Row const& row);
+
+ private:
+  void Run();
+  grpc::Status Drain();
+  bool Push(Row row);
+  void Done(grpc::Status status);
+
+  grpc::ClientContext& context_;
+  Stream& stream_;
+  ReadRowsParser& parser_;
+  std::size_t const max_rows_;
+  std::size_t const max_bytes_;
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<Row> rows_;
+  std::size_t bytes_ = 0;
+  bool done_ = false;
+  bool cancelled_ = false;
+  grpc::Status status_;
+
+  std::thread reader_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_READ_AHEAD_BUFFER_H
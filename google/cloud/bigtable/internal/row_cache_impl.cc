@@ -0,0 +1,187 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/row_cache_impl.h"
+#include "absl/memory/memory.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+RowCacheImpl::RowCacheImpl(std::size_t max_entries,
+                           std::chrono::milliseconds ttl,
+                           std::size_t shard_count,
+                           std::function<Clock::time_point()> now)
+    : shard_capacity_(
+          (std::max)(std::size_t{1},
+                     max_entries / (std::max)(std::size_t{1}, shard_count))),
+      ttl_(ttl),
+      now_(std::move(now)) {
+  shard_count = (std::max)(std::size_t{1}, shard_count);
+  shards_.reserve(shard_count);
+  for (std::size_t i = 0; i != shard_count; ++i) {
+    shards_.push_back(absl::make_unique<Shard>());
+  }
+}
+
+future<RowCacheImpl::ReadResult> RowCacheImpl::Read(
+    std::string const& table_name, std::string const& row_key,
+    Filter const& filter, ReadFunction const& read) {
+  auto row_id = RowId(table_name, row_key);
+  auto filter_key = filter.as_proto().SerializeAsString();
+  auto& shard = ShardFor(row_id);
+
+  std::unique_lock<std::mutex> lk(shard.mu);
+  auto r = shard.index.find(row_id);
+  if (r != shard.index.end()) {
+    auto f = r->second.find(filter_key);
+    if (f != r->second.end()) {
+      auto i = f->second;
+      if (i->expiration > now_()) {
+        ++hits_;
+        shard.lru.splice(shard.lru.begin(), shard.lru, i);
+        return make_ready_future(ReadResult(i->value));
+      }
+      ++expirations_;
+      Erase(shard, i);
+    }
+  }
+
+  auto& flights = shard.in_flight[row_id];
+  auto f = flights.find(filter_key);
+  if (f != flights.end()) {
+    ++coalesced_;
+    f->second->waiters.emplace_back();
+    return f->second->waiters.back().get_future();
+  }
+  ++misses_;
+  auto flight = std::make_shared<InFlight>();
+  flights.emplace(filter_key, flight);
+  lk.unlock();
+
+  auto self = shared_from_this();
+  return read().then([self, row_id, filter_key, flight](future<ReadResult> g) {
+    auto result = g.get();
+    self->OnReadComplete(row_id, filter_key, flight, result);
+    return result;
+  });
+}
+
+void RowCacheImpl::Invalidate(std::string const& table_name,
+                              std::string const& row_key) {
+  auto row_id = RowId(table_name, row_key);
+  auto& shard = ShardFor(row_id);
+  std::lock_guard<std::mutex> lk(shard.mu);
+  auto r = shard.index.find(row_id);
+  if (r != shard.index.end()) {
+    // Erase() modifies the index, collect the entries first.
+    std::vector<EntryList::iterator> entries;
+    for (auto const& kv : r->second) entries.push_back(kv.second);
+    for (auto i : entries) Erase(shard, i);
+    invalidations_ += static_cast<std::int64_t>(entries.size());
+  }
+  auto f = shard.in_flight.find(row_id);
+  if (f == shard.in_flight.end()) return;
+  for (auto& kv : f->second) kv.second->invalidated = true;
+}
+
+void RowCacheImpl::Clear() {
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lk(shard->mu);
+    shard->lru.clear();
+    shard->index.clear();
+    // The reads in progress may have started before some writes.
+    for (auto& r : shard->in_flight) {
+      for (auto& kv : r.second) kv.second->invalidated = true;
+    }
+  }
+}
+
+RowCacheMetrics RowCacheImpl::metrics() const {
+  std::size_t entries = 0;
+  for (auto const& shard : shards_) {
+    std::lock_guard<std::mutex> lk(shard->mu);
+    entries += shard->lru.size();
+  }
+  return RowCacheMetrics{hits_.load(),        misses_.load(),
+                         coalesced_.load(),   evictions_.load(),
+                         expirations_.load(), invalidations_.load(),
+                         entries};
+}
+
+std::string RowCacheImpl::RowId(std::string const& table_name,
+                                std::string const& row_key) {
+  // Table names never contain a NUL character, so the first NUL separates the
+  // table name from the row key, and the ids are unique.
+  std::string id;
+  id.reserve(table_name.size() + 1 + row_key.size());
+  id.append(table_name);
+  id.push_back('\0');
+  id.append(row_key);
+  return id;
+}
+
+RowCacheImpl::Shard& RowCacheImpl::ShardFor(std::string const& row_id) {
+  return *shards_[std::hash<std::string>{}(row_id) % shards_.size()];
+}
+
+void RowCacheImpl::OnReadComplete(std::string const& row_id,
+                                  std::string const& filter,
+                                  std::shared_ptr<InFlight> const& flight,
+                                  ReadResult const& result) {
+  auto& shard = ShardFor(row_id);
+  std::unique_lock<std::mutex> lk(shard.mu);
+  auto r = shard.in_flight.find(row_id);
+  if (r != shard.in_flight.end()) {
+    r->second.erase(filter);
+    if (r->second.empty()) shard.in_flight.erase(r);
+  }
+  if (result && !flight->invalidated) Insert(shard, row_id, filter, *result);
+  auto waiters = std::move(flight->waiters);
+  lk.unlock();
+  for (auto& w : waiters) w.set_value(result);
+}
+
+void RowCacheImpl::Insert(Shard& shard, std::string const& row_id,
+                          std::string const& filter, ValueType value) {
+  auto& filters = shard.index[row_id];
+  auto f = filters.find(filter);
+  if (f != filters.end()) Erase(shard, f->second);
+
+  shard.lru.push_front(
+      Entry{row_id, filter, std::move(value), now_() + ttl_});
+  shard.index[row_id][filter] = shard.lru.begin();
+  while (shard.lru.size() > shard_capacity_) {
+    ++evictions_;
+    Erase(shard, std::prev(shard.lru.end()));
+  }
+}
+
+void RowCacheImpl::Erase(Shard& shard, EntryList::iterator i) {
+  auto r = shard.index.find(i->row_id);
+  if (r != shard.index.end()) {
+    r->second.erase(i->filter);
+    if (r->second.empty()) shard.index.erase(r);
+  }
+  shard.lru.erase(i);
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,133 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ROW_CACHE_IMPL_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ROW_CACHE_IMPL_H
+
+#include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/row_cache.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/future.h"
+#include "google/cloud/status_or.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * Implement `bigtable::RowCache`.
+ *
+ * The cache is split in shards, selected by the hash of the table name and row
+ * key, so all the entries for a row (one per filter) are in the same shard.
+ * Each shard is a LRU list, indexed by row and then by filter, protected by a
+ * mutex.
+ */
+class RowCacheImpl : public std::enable_shared_from_this<RowCacheImpl> {
+ public:
+  using ValueType = std::pair<bool, Row>;
+  using ReadResult = StatusOr<ValueType>;
+  using ReadFunction = std::function<future<ReadResult>()>;
+  using Clock = std::chrono::steady_clock;
+
+  RowCacheImpl(std::size_t max_entries, std::chrono::milliseconds ttl,
+               std::size_t shard_count, std::function<Clock::time_point()> now =
+                                            [] { return Clock::now(); });
+
+  /**
+   * Return the cached value, or call @p read to fetch and cache it.
+   *
+   * If another read for the same row and filter is in progress this function
+   * returns its result instead of calling @p read. Only successful results
+   * are cached.
+   */
+  future<ReadResult> Read(std::string const& table_name,
+                          std::string const& row_key, Filter const& filter,
+                          ReadFunction const& read);
+
+  /// Remove the entries for @p row_key, and do not cache reads in progress.
+  void Invalidate(std::string const& table_name, std::string const& row_key);
+
+  void Clear();
+  RowCacheMetrics metrics() const;
+
+ private:
+  struct Entry {
+    std::string row_id;
+    std::string filter;
+    ValueType value;
+    Clock::time_point expiration;
+  };
+  using EntryList = std::list<Entry>;
+
+  struct InFlight {
+    std::vector<promise<ReadResult>> waiters;
+    bool invalidated = false;
+  };
+
+  struct Shard {
+    std::mutex mu;
+    EntryList lru;
+    /// Index the entries by row id and then by filter.
+    std::unordered_map<std::string,
+                       std::unordered_map<std::string, EntryList::iterator>>
+        index;
+    /// The reads in progress, by row id and then by filter.
+    std::unordered_map<
+        std::string,
+        std::unordered_map<std::string, std::shared_ptr<InFlight>>>
+        in_flight;
+  };
+
+  static std::string RowId(std::string const& table_name,
+                           std::string const& row_key);
+  Shard& ShardFor(std::string const& row_id);
+  void OnReadComplete(std::string const& row_id, std::string const& filter,
+                      std::shared_ptr<InFlight> const& flight,
+                      ReadResult const& result);
+  void Insert(Shard& shard, std::string const& row_id,
+              std::string const& filter, ValueType value);
+  static void Erase(Shard& shard, EntryList::iterator i);
+
+  std::size_t const shard_capacity_;
+  std::chrono::milliseconds const ttl_;
+  std::function<Clock::time_point()> const now_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+
+  std::atomic<std::int64_t> hits_{0};
+  std::atomic<std::int64_t> misses_{0};
+  std::atomic<std::int64_t> coalesced_{0};
+  std::atomic<std::int64_t> evictions_{0};
+  std::atomic<std::int64_t> expirations_{0};
+  std::atomic<std::int64_t> invalidations_{0};
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ROW_CACHE_IMPL_H
@@ -0,0 +1,228 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/row_cache_impl.h"
+#include <gmock/gmock.h>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ReadResult = RowCacheImpl::ReadResult;
+
+std::string const kTable = "projects/p/instances/i/tables/t";
+
+/// A read function that counts how many times it is called.
+class FakeRead {
+ public:
+  explicit FakeRead(std::string value) : value_(std::move(value)) {}
+
+  RowCacheImpl::ReadFunction fn() {
+    return [this] {
+      ++calls_;
+      return make_ready_future(
+          ReadResult(std::make_pair(true, Row("r1", {Cell("r1", "fam", "c1",
+                                                           0, value_)}))));
+    };
+  }
+
+  int calls() const { return calls_; }
+  void set_value(std::string v) { value_ = std::move(v); }
+
+ private:
+  std::string value_;
+  int calls_ = 0;
+};
+
+std::string Value(future<ReadResult> f) {
+  auto r = f.get();
+  EXPECT_TRUE(r.ok());
+  if (!r || !r->first) return {};
+  return r->second.cells().at(0).value();
+}
+
+std::shared_ptr<RowCacheImpl> MakeCache(std::size_t max_entries,
+                                        std::size_t shard_count = 1) {
+  return std::make_shared<RowCacheImpl>(max_entries, std::chrono::hours(1),
+                                        shard_count);
+}
+
+TEST(RowCacheImplTest, HitAndMiss) {
+  auto tested = MakeCache(10);
+  FakeRead read("v1");
+  EXPECT_EQ("v1", Value(tested->Read(kTable, "r1", Filter::PassAllFilter(),
+                                     read.fn())));
+  read.set_value("v2");
+  EXPECT_EQ("v1", Value(tested->Read(kTable, "r1", Filter::PassAllFilter(),
+                                     read.fn())));
+  EXPECT_EQ(1, read.calls());
+
+  // A different filter, table, or key is a different entry.
+  EXPECT_EQ("v2", Value(tested->Read(kTable, "r1", Filter::Latest(1),
+                                     read.fn())));
+  EXPECT_EQ("v2", Value(tested->Read(kTable + "2", "r1",
+                                     Filter::PassAllFilter(), read.fn())));
+  EXPECT_EQ("v2", Value(tested->Read(kTable, "r2", Filter::PassAllFilter(),
+                                     read.fn())));
+  EXPECT_EQ(4, read.calls());
+
+  auto m = tested->metrics();
+  EXPECT_EQ(1, m.hits);
+  EXPECT_EQ(4, m.misses);
+  EXPECT_EQ(4, m.entries);
+}
+
+TEST(RowCacheImplTest, Expiration) {
+  auto now = RowCacheImpl::Clock::now();
+  auto clock = [&now] { return now; };
+  auto tested = std::make_shared<RowCacheImpl>(10, std::chrono::seconds(5), 1,
+                                               clock);
+  FakeRead read("v1");
+  EXPECT_EQ("v1", Value(tested->Read(kTable, "r1", Filter::PassAllFilter(),
+                                     read.fn())));
+  read.set_value("v2");
+  now += std::chrono::seconds(4);
+  EXPECT_EQ("v1", Value(tested->Read(kTable, "r1", Filter::PassAllFilter(),
+                                     read.fn())));
+  now += std::chrono::seconds(2);
+  EXPECT_EQ("v2", Value(tested->Read(kTable, "r1", Filter::PassAllFilter(),
+                                     read.fn())));
+  EXPECT_EQ(2, read.calls());
+  EXPECT_EQ(1, tested->metrics().expirations);
+}
+
+TEST(RowCacheImplTest, EvictLeastRecentlyUsed) {
+  auto tested = MakeCache(2);
+  FakeRead read("v1");
+  (void)tested->Read(kTable, "r1", Filter::PassAllFilter(), read.fn()).get();
+  (void)tested->Read(kTable, "r2", Filter::PassAllFilter(), read.fn()).get();
+  // Make "r1" the most recently used entry, and then evict "r2".
+  (void)tested->Read(kTable, "r1", Filter::PassAllFilter(), read.fn()).get();
+  (void)tested->Read(kTable, "r3", Filter::PassAllFilter(), read.fn()).get();
+  EXPECT_EQ(3, read.calls());
+
+  (void)tested->Read(kTable, "r1", Filter::PassAllFilter(), read.fn()).get();
+  EXPECT_EQ(3, read.calls());
+  (void)tested->Read(kTable, "r2", Filter::PassAllFilter(), read.fn()).get();
+  EXPECT_EQ(4, read.calls());
+
+  auto m = tested->metrics();
+  EXPECT_EQ(2, m.evictions);
+  EXPECT_EQ(2, m.entries);
+}
+
+TEST(RowCacheImplTest, Invalidate) {
+  auto tested = MakeCache(10);
+  FakeRead read("v1");
+  (void)tested->Read(kTable, "r1", Filter::PassAllFilter(), read.fn()).get();
+  (void)tested->Read(kTable, "r1", Filter::Latest(1), read.fn()).get();
+  (void)tested->Read(kTable, "r2", Filter::Latest(1), read.fn()).get();
+
+  tested->Invalidate(kTable, "r1");
+  read.set_value("v2");
+  EXPECT_EQ("v2", Value(tested->Read(kTable, "r1", Filter::PassAllFilter(),
+                                     read.fn())));
+  EXPECT_EQ("v1",
+            Value(tested->Read(kTable, "r2", Filter::Latest(1), read.fn())));
+  EXPECT_EQ(4, read.calls());
+  EXPECT_EQ(2, tested->metrics().invalidations);
+}
+
+TEST(RowCacheImplTest, CoalesceConcurrentReads) {
+  auto tested = MakeCache(10);
+  promise<ReadResult> p;
+  int calls = 0;
+  auto read = [&] {
+    ++calls;
+    return p.get_future();
+  };
+  auto f1 = tested->Read(kTable, "r1", Filter::PassAllFilter(), read);
+  auto f2 = tested->Read(kTable, "r1", Filter::PassAllFilter(), read);
+  EXPECT_EQ(1, calls);
+
+  p.set_value(std::make_pair(false, Row("r1", {})));
+  auto r1 = f1.get();
+  ASSERT_TRUE(r1.ok());
+  EXPECT_FALSE(r1->first);
+  auto r2 = f2.get();
+  ASSERT_TRUE(r2.ok());
+  EXPECT_FALSE(r2->first);
+
+  // Missing rows are cached too.
+  auto r3 = tested->Read(kTable, "r1", Filter::PassAllFilter(), read).get();
+  ASSERT_TRUE(r3.ok());
+  EXPECT_EQ(1, calls);
+
+  auto m = tested->metrics();
+  EXPECT_EQ(1, m.misses);
+  EXPECT_EQ(1, m.coalesced);
+  EXPECT_EQ(1, m.hits);
+}
+
+TEST(RowCacheImplTest, InvalidateDuringRead) {
+  auto tested = MakeCache(10);
+  promise<ReadResult> p;
+  auto f = tested->Read(kTable, "r1", Filter::PassAllFilter(),
+                        [&p] { return p.get_future(); });
+  // The read may have started before the write, do not cache its result.
+  tested->Invalidate(kTable, "r1");
+  p.set_value(std::make_pair(false, Row("r1", {})));
+  EXPECT_TRUE(f.get().ok());
+
+  FakeRead read("v1");
+  EXPECT_EQ("v1", Value(tested->Read(kTable, "r1", Filter::PassAllFilter(),
+                                     read.fn())));
+  EXPECT_EQ(1, read.calls());
+}
+
+TEST(RowCacheImplTest, ErrorsAreNotCached) {
+  auto tested = MakeCache(10);
+  int calls = 0;
+  auto read = [&calls] {
+    ++calls;
+    return make_ready_future(
+        ReadResult(Status(StatusCode::kUnavailable, "try-again")));
+  };
+  auto r = tested->Read(kTable, "r1", Filter::PassAllFilter(), read).get();
+  EXPECT_EQ(StatusCode::kUnavailable, r.status().code());
+  r = tested->Read(kTable, "r1", Filter::PassAllFilter(), read).get();
+  EXPECT_EQ(StatusCode::kUnavailable, r.status().code());
+  EXPECT_EQ(2, calls);
+  EXPECT_EQ(0, tested->metrics().entries);
+}
+
+TEST(RowCacheImplTest, Clear) {
+  auto tested = MakeCache(100, 4);
+  FakeRead read("v1");
+  for (auto const* key : {"r1", "r2", "r3", "r4", "r5", "r6"}) {
+    (void)tested->Read(kTable, key, Filter::PassAllFilter(), read.fn()).get();
+  }
+  EXPECT_EQ(6, tested->metrics().entries);
+  tested->Clear();
+  EXPECT_EQ(0, tested->metrics().entries);
+  (void)tested->Read(kTable, "r1", Filter::PassAllFilter(), read.fn()).get();
+  EXPECT_EQ(7, read.calls());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
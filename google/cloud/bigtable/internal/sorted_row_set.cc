@@ -0,0 +1,125 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/sorted_row_set.h"
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+// The approximate overhead of each key in the request, i.e., the field tag
+// and the length.
+std::size_t constexpr kKeyOverhead = 4;
+}  // namespace
+
+SortedRowSet::SortedRowSet(RowSet row_set, std::size_t max_batch_bytes)
+    : max_batch_bytes_(max_batch_bytes),
+      row_set_(std::move(row_set).as_proto()),
+      all_rows_(row_set_.row_keys().empty() && row_set_.row_ranges().empty()) {
+  // Swapping the elements of a `RepeatedPtrField` swaps the strings, this does
+  // not copy any of the keys.
+  auto& keys = *row_set_.mutable_row_keys();
+  std::sort(keys.begin(), keys.end(), std::greater<std::string>());
+  auto end = std::unique(keys.begin(), keys.end());
+  keys.DeleteSubrange(static_cast<int>(end - keys.begin()),
+                      static_cast<int>(keys.end() - end));
+}
+
+void SortedRowSet::ResumeAfter(std::string const& row_key) {
+  auto open = RowRange::Open(row_key, std::string());
+  if (all_rows_) {
+    all_rows_ = false;
+    *row_set_.add_row_ranges() = std::move(open).as_proto();
+    return;
+  }
+  // The keys are sorted in descending order, the keys at or before `row_key`
+  // are at the end.
+  auto& keys = *row_set_.mutable_row_keys();
+  auto p = std::partition_point(
+      keys.begin(), keys.end(),
+      [&row_key](std::string const& k) { return k > row_key; });
+  keys.DeleteSubrange(static_cast<int>(p - keys.begin()),
+                      static_cast<int>(keys.end() - p));
+
+  // There are typically only a few ranges, a linear scan is good enough.
+  google::protobuf::RepeatedPtrField<google::bigtable::v2::RowRange> ranges;
+  for (auto& r : *row_set_.mutable_row_ranges()) {
+    auto i = open.Intersect(RowRange(std::move(r)));
+    if (std::get<0>(i)) *ranges.Add() = std::move(std::get<1>(i)).as_proto();
+  }
+  row_set_.mutable_row_ranges()->Swap(&ranges);
+}
+
+bool SortedRowSet::IsEmpty() const {
+  if (all_rows_ || !row_set_.row_keys().empty()) return false;
+  return std::all_of(row_set_.row_ranges().begin(),
+                     row_set_.row_ranges().end(),
+                     [](google::bigtable::v2::RowRange const& r) {
+                       return RowRange(r).IsEmpty();
+                     });
+}
+
+void SortedRowSet::LendBatch(google::bigtable::v2::RowSet& rows) {
+  auto& keys = *row_set_.mutable_row_keys();
+  auto count = keys.size();
+  // Only split sets with just row keys, splitting the row ranges at the batch
+  // boundaries is not worth the complexity.
+  if (row_set_.row_ranges().empty()) {
+    std::size_t bytes = 0;
+    count = 0;
+    for (auto i = keys.size(); i != 0; --i, ++count) {
+      bytes += keys.Get(i - 1).size() + kKeyOverhead;
+      // Always send at least one key.
+      if (count != 0 && bytes > max_batch_bytes_) break;
+    }
+  }
+  partial_batch_ = count < keys.size();
+  if (partial_batch_) batch_end_ = keys.Get(keys.size() - count);
+
+  std::vector<std::string*> lent(static_cast<std::size_t>(count));
+  keys.ExtractSubrange(keys.size() - count, count, lent.data());
+  // Send the keys in ascending order, which makes the requests easier to read.
+  for (auto i = lent.rbegin(); i != lent.rend(); ++i) {
+    rows.mutable_row_keys()->AddAllocated(*i);
+  }
+  rows.mutable_row_ranges()->Swap(row_set_.mutable_row_ranges());
+}
+
+void SortedRowSet::ReturnBatch(google::bigtable::v2::RowSet& rows) {
+  auto& lent = *rows.mutable_row_keys();
+  std::vector<std::string*> keys(static_cast<std::size_t>(lent.size()));
+  lent.ExtractSubrange(0, lent.size(), keys.data());
+  for (auto i = keys.rbegin(); i != keys.rend(); ++i) {
+    row_set_.mutable_row_keys()->AddAllocated(*i);
+  }
+  rows.mutable_row_ranges()->Swap(row_set_.mutable_row_ranges());
+}
+
+bool SortedRowSet::CompleteBatch() {
+  if (!partial_batch_) return false;
+  partial_batch_ = false;
+  ResumeAfter(batch_end_);
+  return !IsEmpty();
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
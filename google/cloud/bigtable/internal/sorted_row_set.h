@@ -0,0 +1,102 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_SORTED_ROW_SET_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_SORTED_ROW_SET_H
+
+#include "google/cloud/bigtable/row_set.h"
+#include "google/cloud/bigtable/version.h"
+#include <google/bigtable/v2/data.pb.h>
+#include <cstddef>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * The default limit for the size of the row keys in a single request.
+ *
+ * This is well below the server limits on the size of a request.
+ */
+std::size_t constexpr kDefaultReadRowsBatchBytes = 256 * 1024;
+
+/**
+ * The `RowSet` of a `ReadRows` scan, optimized to resume interrupted scans.
+ *
+ * `RowReader` and `AsyncRowReader` resume failed streams after the last row
+ * they received. With a plain `RowSet` that requires a linear scan (and a
+ * copy) of all the row keys for every retry, and yet another copy to create
+ * the request. This class keeps the row keys sorted in descending order, so
+ * the keys already read are at the end of the list, and can be removed in
+ * `O(log n)` time (plus the time to release the removed keys) without copying
+ * any of the remaining keys.
+ *
+ * Requests for large sets of row keys (and only row keys) are split into
+ * consecutive batches, each one smaller than @p max_batch_bytes. The batches
+ * are sent one after the other, so the rows are still returned in order.
+ *
+ * The keys are lent to each request, and taken back once the request is sent,
+ * this relies on gRPC serializing the request before the `ReadRows()` and
+ * `PrepareAsyncReadRows()` functions return.
+ */
+class SortedRowSet {
+ public:
+  explicit SortedRowSet(
+      RowSet row_set,
+      std::size_t max_batch_bytes = kDefaultReadRowsBatchBytes);
+
+  /// Remove the keys and ranges at or before @p row_key.
+  void ResumeAfter(std::string const& row_key);
+
+  /**
+   * Returns true if the set is empty.
+   *
+   * As with `RowSet::IsEmpty()`, a set that matches all the rows is not empty.
+   */
+  bool IsEmpty() const;
+
+  /// Move the next batch of keys and ranges into @p rows.
+  void LendBatch(google::bigtable::v2::RowSet& rows);
+
+  /// Take back the keys and ranges lent to @p rows.
+  void ReturnBatch(google::bigtable::v2::RowSet& rows);
+
+  /**
+   * Remove the keys in the last batch, once it completes successfully.
+   *
+   * Returns true if there are more batches to request.
+   */
+  bool CompleteBatch();
+
+ private:
+  std::size_t const max_batch_bytes_;
+  /// Keys sorted in descending order, ranges in any order.
+  google::bigtable::v2::RowSet row_set_;
+  /// If true the (empty) set represents all the rows in the table.
+  bool all_rows_;
+  /// If true, the last request included only some of the keys.
+  bool partial_batch_ = false;
+  /// The largest key in the last request, valid if `partial_batch_` is set.
+  std::string batch_end_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_SORTED_ROW_SET_H
@@ -0,0 +1,176 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/sorted_row_set.h"
+#include <gmock/gmock.h>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::testing::ElementsAre;
+
+std::vector<std::string> Keys(google::bigtable::v2::RowSet const& rows) {
+  return {rows.row_keys().begin(), rows.row_keys().end()};
+}
+
+TEST(SortedRowSetTest, AllRows) {
+  SortedRowSet tested{RowSet()};
+  EXPECT_FALSE(tested.IsEmpty());
+
+  google::bigtable::v2::RowSet rows;
+  tested.LendBatch(rows);
+  EXPECT_EQ(0, rows.row_keys_size());
+  EXPECT_EQ(0, rows.row_ranges_size());
+  tested.ReturnBatch(rows);
+  EXPECT_FALSE(tested.CompleteBatch());
+
+  tested.ResumeAfter("r1");
+  EXPECT_FALSE(tested.IsEmpty());
+  tested.LendBatch(rows);
+  ASSERT_EQ(1, rows.row_ranges_size());
+  EXPECT_EQ("r1", rows.row_ranges(0).start_key_open());
+  EXPECT_EQ("", rows.row_ranges(0).end_key_open());
+  tested.ReturnBatch(rows);
+}
+
+TEST(SortedRowSetTest, KeysAreSortedAndUnique) {
+  SortedRowSet tested(RowSet("r3", "r1", "r2", "r1"));
+  google::bigtable::v2::RowSet rows;
+  tested.LendBatch(rows);
+  EXPECT_THAT(Keys(rows), ElementsAre("r1", "r2", "r3"));
+  tested.ReturnBatch(rows);
+  EXPECT_EQ(0, rows.row_keys_size());
+
+  // The keys are available after they are returned.
+  tested.LendBatch(rows);
+  EXPECT_THAT(Keys(rows), ElementsAre("r1", "r2", "r3"));
+  tested.ReturnBatch(rows);
+}
+
+TEST(SortedRowSetTest, ResumeAfterKeys) {
+  SortedRowSet tested(RowSet("r3", "r1", "r4", "r2"));
+  tested.ResumeAfter("r2");
+  EXPECT_FALSE(tested.IsEmpty());
+  google::bigtable::v2::RowSet rows;
+  tested.LendBatch(rows);
+  EXPECT_THAT(Keys(rows), ElementsAre("r3", "r4"));
+  tested.ReturnBatch(rows);
+
+  // Resuming from a key that is not in the set also works.
+  tested.ResumeAfter("r35");
+  tested.LendBatch(rows);
+  EXPECT_THAT(Keys(rows), ElementsAre("r4"));
+  tested.ReturnBatch(rows);
+
+  tested.ResumeAfter("r4");
+  EXPECT_TRUE(tested.IsEmpty());
+}
+
+TEST(SortedRowSetTest, ResumeAfterRanges) {
+  SortedRowSet tested(
+      RowSet(RowRange::Range("a", "c"), RowRange::Range("d", "f"), "e1"));
+  tested.ResumeAfter("b");
+  EXPECT_FALSE(tested.IsEmpty());
+  google::bigtable::v2::RowSet rows;
+  tested.LendBatch(rows);
+  EXPECT_THAT(Keys(rows), ElementsAre("e1"));
+  ASSERT_EQ(2, rows.row_ranges_size());
+  EXPECT_EQ("b", rows.row_ranges(0).start_key_open());
+  EXPECT_EQ("c", rows.row_ranges(0).end_key_open());
+  EXPECT_EQ("d", rows.row_ranges(1).start_key_closed());
+  tested.ReturnBatch(rows);
+
+  tested.ResumeAfter("e");
+  tested.LendBatch(rows);
+  EXPECT_THAT(Keys(rows), ElementsAre("e1"));
+  ASSERT_EQ(1, rows.row_ranges_size());
+  EXPECT_EQ("e", rows.row_ranges(0).start_key_open());
+  tested.ReturnBatch(rows);
+
+  tested.ResumeAfter("f");
+  EXPECT_TRUE(tested.IsEmpty());
+}
+
+TEST(SortedRowSetTest, EmptyRange) {
+  SortedRowSet tested{RowSet(RowRange::Empty())};
+  EXPECT_TRUE(tested.IsEmpty());
+}
+
+TEST(SortedRowSetTest, SplitKeysInBatches) {
+  // Each key uses 2 bytes, plus the overhead, so only two keys fit in a batch.
+  SortedRowSet tested(RowSet("k5", "k1", "k4", "k2", "k3"), 12);
+  google::bigtable::v2::RowSet rows;
+  tested.LendBatch(rows);
+  EXPECT_THAT(Keys(rows), ElementsAre("k1", "k2"));
+  tested.ReturnBatch(rows);
+  EXPECT_TRUE(tested.CompleteBatch());
+
+  tested.LendBatch(rows);
+  EXPECT_THAT(Keys(rows), ElementsAre("k3", "k4"));
+  tested.ReturnBatch(rows);
+  // Simulate a failure after reading "k3", the retry starts a new batch.
+  tested.ResumeAfter("k3");
+  tested.LendBatch(rows);
+  EXPECT_THAT(Keys(rows), ElementsAre("k4", "k5"));
+  tested.ReturnBatch(rows);
+  EXPECT_FALSE(tested.CompleteBatch());
+}
+
+TEST(SortedRowSetTest, SplitAlwaysSendsOneKey) {
+  SortedRowSet tested(RowSet("a-very-long-key", "another-very-long-key"), 1);
+  google::bigtable::v2::RowSet rows;
+  tested.LendBatch(rows);
+  EXPECT_THAT(Keys(rows), ElementsAre("a-very-long-key"));
+  tested.ReturnBatch(rows);
+  EXPECT_TRUE(tested.CompleteBatch());
+
+  tested.LendBatch(rows);
+  EXPECT_THAT(Keys(rows), ElementsAre("another-very-long-key"));
+  tested.ReturnBatch(rows);
+  EXPECT_FALSE(tested.CompleteBatch());
+}
+
+TEST(SortedRowSetTest, NoSplitWithRanges) {
+  SortedRowSet tested(RowSet("k1", "k2", "k3", RowRange::Prefix("p")), 1);
+  google::bigtable::v2::RowSet rows;
+  tested.LendBatch(rows);
+  EXPECT_THAT(Keys(rows), ElementsAre("k1", "k2", "k3"));
+  EXPECT_EQ(1, rows.row_ranges_size());
+  tested.ReturnBatch(rows);
+  EXPECT_FALSE(tested.CompleteBatch());
+}
+
+TEST(SortedRowSetTest, CompleteLastBatchIsEmpty) {
+  SortedRowSet tested(RowSet("k1", "k2"), 6);
+  google::bigtable::v2::RowSet rows;
+  tested.LendBatch(rows);
+  EXPECT_THAT(Keys(rows), ElementsAre("k1"));
+  tested.ReturnBatch(rows);
+  // The scan stopped after "k2", e.g. because of a row limit.
+  tested.ResumeAfter("k2");
+  EXPECT_TRUE(tested.IsEmpty());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -149,6 +149,7 @@ struct UnaryClientUtils {
       // Call the pointer to member function.
       status = (client.*function)(&client_context, request, &response);
       if (status.ok()) {
+        rpc_policy.OnSuccess();
         break;
       }
       if (!rpc_policy.OnFailure(status)) {
@@ -200,7 +201,9 @@ struct UnaryClientUtils {
     // Call the pointer to member function.
     status = (client.*function)(&client_context, request, &response);
 
-    if (!status.ok()) {
+    if (status.ok()) {
+      rpc_policy->OnSuccess();
+    } else {
       std::string full_message = error_message;
       full_message += "(" + metadata_update_policy.value() + ") ";
       full_message += status.error_message();
@@ -0,0 +1,40 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/row_cache.h"
+#include "google/cloud/bigtable/internal/row_cache_impl.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+
+RowCache::RowCache(std::size_t max_entries, std::chrono::milliseconds ttl,
+                   std::size_t shard_count)
+    : impl_(std::make_shared<internal::RowCacheImpl>(max_entries, ttl,
+                                                     shard_count)) {}
+
+RowCacheMetrics RowCache::metrics() const { return impl_->metrics(); }
+
+void RowCache::Clear() { impl_->Clear(); }
+
+void RowCache::Invalidate(std::string const& table_name,
+                          std::string const& row_key) {
+  impl_->Invalidate(table_name, row_key);
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,128 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_CACHE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_CACHE_H
+
+#include "google/cloud/bigtable/version.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+class RowCacheImpl;
+}  // namespace internal
+
+/// Counters to monitor the effectiveness of a `RowCache`.
+struct RowCacheMetrics {
+  /// The number of reads served from the cache.
+  std::int64_t hits;
+  /// The number of reads that required a `ReadRows` request.
+  std::int64_t misses;
+  /// The number of reads that waited for a request started by another read.
+  std::int64_t coalesced;
+  /// The number of entries removed to make room for new entries.
+  std::int64_t evictions;
+  /// The number of entries removed because their TTL expired.
+  std::int64_t expirations;
+  /// The number of entries removed because the row was modified.
+  std::int64_t invalidations;
+  /// The current number of entries in the cache.
+  std::size_t entries;
+};
+
+/**
+ * A client-side cache for `Table::ReadRow()` and `Table::AsyncReadRow()`.
+ *
+ * Applications that read the same rows many times can use this class to
+ * serve some of the reads from memory. The cache is keyed by the table, the
+ * row key, and the filter used in the read. Each entry expires after a fixed
+ * TTL, and the least recently used entries are evicted once the cache is full.
+ * The results are cached whether the row exists or not.
+ *
+ * Writes made through a `Table` using this cache, including writes made via a
+ * `MutationBatcher` wrapping the `Table`, invalidate the modified rows. Writes
+ * made by other means (for example, other processes) are not visible until
+ * the cached entries expire. Applications can call `Invalidate()` to remove
+ * entries for rows modified by other means.
+ *
+ * Concurrent reads for the same row and filter are coalesced: only the first
+ * read sends a request, the others wait for its result.
+ *
+ * Copies of this object share the cache. The cache is split into several
+ * shards, each protected by its own mutex, to reduce contention.
+ *
+ * @par Example
+ * @code
+ * namespace cbt = google::cloud::bigtable;
+ * using std::chrono::seconds;
+ * cbt::RowCache cache(100000, seconds(5));
+ * cbt::Table table(client, "my-table", cache);
+ * auto row = table.ReadRow("hot-key", cbt::Filter::Latest(1));
+ * std::cout << "hits=" << cache.metrics().hits << "\n";
+ * @endcode
+ */
+class RowCache {
+ public:
+  /// The default number of shards.
+  static std::size_t constexpr kDefaultShardCount = 16;
+
+  /**
+   * Create a new cache.
+   *
+   * @param max_entries the maximum number of entries in the cache.
+   * @param ttl how long the entries are valid.
+   * @param shard_count the number of shards, each shard holds approximately
+   *     `max_entries / shard_count` entries.
+   */
+  template <typename Rep, typename Period>
+  RowCache(std::size_t max_entries, std::chrono::duration<Rep, Period> ttl,
+           std::size_t shard_count = kDefaultShardCount)
+      : RowCache(max_entries,
+                 std::chrono::duration_cast<std::chrono::milliseconds>(ttl),
+                 shard_count) {}
+  RowCache(std::size_t max_entries, std::chrono::milliseconds ttl,
+           std::size_t shard_count);
+
+  /// Return the current values of the counters.
+  RowCacheMetrics metrics() const;
+
+  /// Remove all the entries.
+  void Clear();
+
+  /**
+   * Remove any entries for @p row_key in @p table_name.
+   *
+   * @param table_name the full name of the table, as in `Table::table_name()`.
+   * @param row_key the row modified by the application.
+   */
+  void Invalidate(std::string const& table_name, std::string const& row_key);
+
+ private:
+  friend class Table;
+  std::shared_ptr<internal::RowCacheImpl> impl_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_CACHE_H
@@ -18,6 +18,7 @@
 #include "google/cloud/internal/throw_delegate.h"
 #include "google/cloud/log.h"
 #include "absl/memory/memory.h"
+#include <algorithm>
 #include <thread>
 
 namespace google {
@@ -103,7 +104,14 @@ RowReader::iterator RowReader::begin() {
 // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
 RowReader::iterator RowReader::end() { return internal::RowReaderIterator(); }
 
+void RowReader::EnableReadAhead(std::size_t max_rows, std::size_t max_bytes) {
+  read_ahead_max_rows_ = (std::max)(max_rows, std::size_t{1});
+  read_ahead_max_bytes_ = max_bytes;
+}
+
 void RowReader::MakeRequest() {
+  // Stop any background reader before replacing the stream it uses.
+  read_ahead_.reset();
   response_ = {};
   processed_chunks_count_ = 0;
 
@@ -111,8 +119,7 @@ void RowReader::MakeRequest() {
   request.set_table_name(table_name_);
   request.set_app_profile_id(app_profile_id_);
 
-  auto row_set_proto = row_set_.as_proto();
-  request.mutable_rows()->Swap(&row_set_proto);
+  row_set_.LendBatch(*request.mutable_rows());
 
   auto filter_proto = filter_.as_proto();
   request.mutable_filter()->Swap(&filter_proto);
@@ -126,9 +133,16 @@ void RowReader::MakeRequest() {
   backoff_policy_->Setup(*context_);
   metadata_update_policy_.Setup(*context_);
   stream_ = client_->ReadRows(context_.get(), request);
+  // gRPC serializes the request before returning, take back the row keys.
+  row_set_.ReturnBatch(*request.mutable_rows());
   stream_is_open_ = true;
 
   parser_ = parser_factory_->Create();
+  if (read_ahead_max_rows_ != 0) {
+    read_ahead_ = absl::make_unique<internal::ReadAheadBuffer>(
+        *context_, *stream_, *parser_, read_ahead_max_rows_,
+        read_ahead_max_bytes_);
+  }
 }
 
 bool RowReader::NextChunk() {
@@ -152,7 +166,15 @@ StatusOr<RowReader::OptionalRow> RowReader::Advance() {
     OptionalRow row;
     grpc::Status status = AdvanceOrFail(row);
     if (status.ok()) {
-      return row;
+      if (row || (rows_limit_ != NO_ROWS_LIMIT && rows_limit_ <= rows_count_)) {
+        return row;
+      }
+      // The stream finished successfully.
+      retry_policy_->OnSuccess();
+      // Large sets of row keys are requested in batches, start the next one.
+      if (!row_set_.CompleteBatch()) return row;
+      MakeRequest();
+      continue;
     }
     row.reset();
 
@@ -167,7 +189,7 @@ StatusOr<RowReader::OptionalRow> RowReader::Advance() {
     if (!last_read_row_key_.empty()) {
       // We've returned some rows and need to make sure we don't
       // request them again.
-      row_set_ = row_set_.Intersect(RowRange::Open(last_read_row_key_, ""));
+      row_set_.ResumeAfter(last_read_row_key_);
     }
 
     // If we receive an error, but the retryable set is empty, stop.
@@ -193,6 +215,7 @@ grpc::Status RowReader::AdvanceOrFail(OptionalRow& row) {
   if (!stream_) {
     MakeRequest();
   }
+  if (read_ahead_) return NextReadAheadRow(row);
   while (!parser_->HasNext()) {
     if (NextChunk()) {
       parser_->HandleChunk(
@@ -228,12 +251,30 @@ grpc::Status RowReader::AdvanceOrFail(OptionalRow& row) {
   return status;
 }
 
+grpc::Status RowReader::NextReadAheadRow(OptionalRow& row) {
+  auto status = read_ahead_->Next(row);
+  if (!row) {
+    // The background reader always finalizes the stream.
+    stream_is_open_ = false;
+    return status;
+  }
+  ++rows_count_;
+  last_read_row_key_ = std::string(row->row_key());
+  return status;
+}
+
 void RowReader::Cancel() {
   operation_cancelled_ = true;
   if (!stream_is_open_) {
     return;
   }
   context_->TryCancel();
+  if (read_ahead_) {
+    // The background reader drains and finalizes the stream.
+    read_ahead_.reset();
+    stream_is_open_ = false;
+    return;
+  }
 
   // Also drain any data left unread
   google::bigtable::v2::ReadRowsResponse response;
@@ -17,8 +17,10 @@
 
 #include "google/cloud/bigtable/data_client.h"
 #include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/internal/read_ahead_buffer.h"
 #include "google/cloud/bigtable/internal/readrowsparser.h"
 #include "google/cloud/bigtable/internal/rowreaderiterator.h"
+#include "google/cloud/bigtable/internal/sorted_row_set.h"
 #include "google/cloud/bigtable/metadata_update_policy.h"
 #include "google/cloud/bigtable/row.h"
 #include "google/cloud/bigtable/row_set.h"
@@ -30,6 +32,7 @@
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
 #include <grpcpp/grpcpp.h>
 #include <cinttypes>
+#include <cstddef>
 #include <iterator>
 
 namespace google {
@@ -104,6 +107,27 @@ class RowReader {
    */
   void Cancel();
 
+  /**
+   * Read and parse rows in a background thread.
+   *
+   * By default the rows are read from the network only when the application
+   * advances the iterator, so fetching the data and processing it are fully
+   * serialized. With read-ahead enabled a background thread streams the
+   * response into a bounded queue of parsed rows, overlapping the network
+   * transfer with the application's work.
+   *
+   * Failed streams are retried as usual, any rows already queued are returned
+   * before the stream is resumed after the last row returned to the
+   * application.
+   *
+   * Must be called before `begin()`.
+   *
+   * @param max_rows the maximum number of rows queued, must be at least 1.
+   * @param max_bytes the (approximate) maximum number of bytes queued. A
+   *     single row larger than this limit is still returned.
+   */
+  void EnableReadAhead(std::size_t max_rows, std::size_t max_bytes);
+
  private:
   using OptionalRow = absl::optional<Row>;
 
@@ -136,10 +160,13 @@ class RowReader {
   /// Sends the ReadRows request to the stub.
   void MakeRequest();
 
+  /// Called by AdvanceOrFail() when read-ahead is enabled.
+  grpc::Status NextReadAheadRow(OptionalRow& row);
+
   std::shared_ptr<DataClient> client_;
   std::string app_profile_id_;
   std::string table_name_;
-  RowSet row_set_;
+  internal::SortedRowSet row_set_;
   std::int64_t rows_limit_;
   Filter filter_;
   std::unique_ptr<RPCRetryPolicy> retry_policy_;
@@ -165,6 +192,12 @@ class RowReader {
   std::int64_t rows_count_;
   /// Holds the last read row key, for retries.
   RowKeyType last_read_row_key_;
+
+  /// The read-ahead limits, zero rows if read-ahead is disabled.
+  std::size_t read_ahead_max_rows_ = 0;
+  std::size_t read_ahead_max_bytes_ = 0;
+  /// Reads `stream_` in the background, must be destroyed before `stream_`.
+  std::unique_ptr<internal::ReadAheadBuffer> read_ahead_;
 };
 
 }  // namespace BIGTABLE_CLIENT_NS
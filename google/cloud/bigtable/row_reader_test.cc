@@ -25,6 +25,8 @@
 #include <gmock/gmock.h>
 #include <deque>
 #include <initializer_list>
+#include <numeric>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -796,6 +798,149 @@ TEST_F(RowReaderTest, FailedStreamRetryNewContext) {
   EXPECT_EQ(++it, reader.end());
 }
 
+TEST_F(RowReaderTest, ReadAheadReadsAllRows) {
+  // wrapped in unique_ptr by ReadRows
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto parser = absl::make_unique<ReadRowsParserMock>();
+  parser->SetRows({"r1", "r2", "r3"});
+  EXPECT_CALL(*parser, HandleEndOfStreamHook).Times(1);
+  {
+    ::testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows).WillOnce(stream->MakeMockReturner());
+    EXPECT_CALL(*stream, Read).WillOnce(Return(true));
+    EXPECT_CALL(*stream, Read).WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+
+  parser_factory_->AddParser(std::move(parser));
+  bigtable::RowReader reader(
+      client_, "", bigtable::RowSet(), bigtable::RowReader::NO_ROWS_LIMIT,
+      bigtable::Filter::PassAllFilter(), std::move(retry_policy_),
+      std::move(backoff_policy_), metadata_update_policy_,
+      std::move(parser_factory_));
+  // Use a single row buffer so the background thread blocks on each row.
+  reader.EnableReadAhead(1, 1024);
+
+  std::vector<std::string> actual;
+  for (auto& row : reader) {
+    ASSERT_STATUS_OK(row);
+    actual.push_back(row->row_key());
+  }
+  EXPECT_THAT(actual, ::testing::ElementsAre("r1", "r2", "r3"));
+}
+
+TEST_F(RowReaderTest, ReadAheadFailedStreamRetriesSkipAlreadyReadRows) {
+  // wrapped in unique_ptr by ReadRows
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto parser = absl::make_unique<ReadRowsParserMock>();
+  parser->SetRows({"r1"});
+  {
+    ::testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows(_, RequestWithRowKeysCount(2)))
+        .WillOnce(stream->MakeMockReturner());
+
+    EXPECT_CALL(*stream, Read).WillOnce(Return(true));
+    EXPECT_CALL(*stream, Read).WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish())
+        .WillOnce(Return(grpc::Status(grpc::StatusCode::INTERNAL, "retry")));
+
+    EXPECT_CALL(*retry_policy_, OnFailureHook).WillOnce(Return(true));
+    EXPECT_CALL(*backoff_policy_, OnCompletionHook)
+        .WillOnce(Return(std::chrono::milliseconds(0)));
+
+    // the stub will free it
+    auto* stream_retry =
+        new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+    // The rows returned before the failure are skipped, even though the
+    // failure was detected by the background thread.
+    EXPECT_CALL(*client_, ReadRows(_, RequestWithRowKeysCount(1)))
+        .WillOnce(stream_retry->MakeMockReturner());
+    EXPECT_CALL(*stream_retry, Read).WillOnce(Return(false));
+    EXPECT_CALL(*stream_retry, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+
+  parser_factory_->AddParser(std::move(parser));
+  bigtable::RowReader reader(
+      client_, "", bigtable::RowSet("r1", "r2"),
+      bigtable::RowReader::NO_ROWS_LIMIT, bigtable::Filter::PassAllFilter(),
+      std::move(retry_policy_), std::move(backoff_policy_),
+      metadata_update_policy_, std::move(parser_factory_));
+  reader.EnableReadAhead(16, 1024 * 1024);
+
+  auto it = reader.begin();
+  EXPECT_NE(it, reader.end());
+  ASSERT_STATUS_OK(*it);
+  EXPECT_EQ((*it)->row_key(), "r1");
+  EXPECT_EQ(++it, reader.end());
+}
+
+TEST_F(RowReaderTest, ReadAheadCancelClosesStream) {
+  auto parser = absl::make_unique<ReadRowsParserMock>();
+  parser->SetRows({"r1"});
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  {
+    ::testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows).WillOnce(stream->MakeMockReturner());
+    EXPECT_CALL(*stream, Read).WillOnce(Return(true));
+    EXPECT_CALL(*stream, Read).WillOnce(Return(true));
+    EXPECT_CALL(*stream, Read).WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+
+  parser_factory_->AddParser(std::move(parser));
+  bigtable::RowReader reader(
+      client_, "", bigtable::RowSet(), bigtable::RowReader::NO_ROWS_LIMIT,
+      bigtable::Filter::PassAllFilter(), std::move(retry_policy_),
+      std::move(backoff_policy_), metadata_update_policy_,
+      std::move(parser_factory_));
+  reader.EnableReadAhead(16, 1024 * 1024);
+
+  auto it = reader.begin();
+  EXPECT_NE(it, reader.end());
+  ASSERT_STATUS_OK(*it);
+  EXPECT_EQ((*it)->row_key(), "r1");
+  // Cancel the call, the stream must be finalized exactly once, regardless of
+  // how far the background thread got.
+  reader.Cancel();
+  it = reader.begin();
+  EXPECT_NE(it, reader.end());
+  EXPECT_FALSE(*it);
+}
+
+TEST_F(RowReaderTest, LargeRowSetIsSplitInBatches) {
+  auto constexpr kKeyCount = 40000;
+  bigtable::RowSet row_set;
+  for (int i = 0; i != kKeyCount; ++i) {
+    row_set.Append("row-" + std::to_string(100000 + i));
+  }
+
+  std::vector<int> key_counts;
+  std::string last_key;
+  EXPECT_CALL(*client_, ReadRows)
+      .Times(::testing::AtLeast(2))
+      .WillRepeatedly([&](grpc::ClientContext*, ReadRowsRequest const& req) {
+        key_counts.push_back(req.rows().row_keys_size());
+        // The batches are sent in order, without overlaps.
+        EXPECT_LT(last_key, req.rows().row_keys(0));
+        last_key = req.rows().row_keys(req.rows().row_keys_size() - 1);
+        auto stream = absl::make_unique<MockReadRowsReader>(
+            "google.bigtable.v2.Bigtable.ReadRows");
+        EXPECT_CALL(*stream, Read).WillOnce(Return(false));
+        EXPECT_CALL(*stream, Finish).WillOnce(Return(grpc::Status::OK));
+        return stream;
+      });
+
+  bigtable::RowReader reader(
+      client_, "", std::move(row_set), bigtable::RowReader::NO_ROWS_LIMIT,
+      bigtable::Filter::PassAllFilter(), std::move(retry_policy_),
+      std::move(backoff_policy_), metadata_update_policy_,
+      std::move(parser_factory_));
+  EXPECT_EQ(reader.begin(), reader.end());
+
+  EXPECT_EQ(kKeyCount,
+            std::accumulate(key_counts.begin(), key_counts.end(), 0));
+}
+
 }  // anonymous namespace
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
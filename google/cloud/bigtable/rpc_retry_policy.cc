@@ -64,6 +64,28 @@ bool LimitedTimeRetryPolicy::OnFailure(grpc::Status const& status) {
   return impl_.OnFailure(MakeStatusFromRpcError(status));
 }
 
+std::unique_ptr<RPCRetryPolicy> BudgetedRetryPolicy::clone() const {
+  return std::unique_ptr<RPCRetryPolicy>(new BudgetedRetryPolicy(*this));
+}
+
+void BudgetedRetryPolicy::Setup(grpc::ClientContext& context) const {
+  policy_->Setup(context);
+}
+
+bool BudgetedRetryPolicy::OnFailure(google::cloud::Status const& status) {
+  // Only consume a token if the wrapped policy would retry.
+  return policy_->OnFailure(status) && budget_->TryRetry();
+}
+
+bool BudgetedRetryPolicy::OnFailure(grpc::Status const& status) {
+  return OnFailure(MakeStatusFromRpcError(status));
+}
+
+void BudgetedRetryPolicy::OnSuccess() {
+  policy_->OnSuccess();
+  budget_->OnSuccess();
+}
+
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
 }  // namespace cloud
@@ -18,6 +18,7 @@
 #include "google/cloud/bigtable/internal/rpc_policy_parameters.h"
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/internal/retry_policy.h"
+#include "google/cloud/retry_budget.h"
 #include "google/cloud/status.h"
 #include <grpcpp/grpcpp.h>
 #include <chrono>
@@ -109,6 +110,14 @@ class RPCRetryPolicy {
   // TODO(#2344) - remove ::grpc::Status version.
   virtual bool OnFailure(grpc::Status const& status) = 0;
 
+  /**
+   * Handle a successful RPC.
+   *
+   * Most policies only care about failures, the default implementation does
+   * nothing.
+   */
+  virtual void OnSuccess() {}
+
   static bool IsPermanentFailure(google::cloud::Status const& status) {
     return internal::SafeGrpcRetry::IsPermanentFailure(status);
   }
@@ -164,6 +173,43 @@ class LimitedTimeRetryPolicy : public RPCRetryPolicy {
   Impl impl_;
 };
 
+/**
+ * Limit the retries of another policy with a budget shared across requests.
+ *
+ * Each failure is retried only if the wrapped policy allows it *and* the
+ * @p budget has a token for the retry. Successful requests refill the budget.
+ * Share the budget across all the `Table`, `TableAdmin` and `InstanceAdmin`
+ * objects that should be limited together.
+ *
+ * @par Example
+ * @code
+ * auto budget = std::make_shared<google::cloud::RetryBudget>();
+ * bigtable::Table table(client, "my-table",
+ *     bigtable::BudgetedRetryPolicy(
+ *         bigtable::LimitedErrorCountRetryPolicy(5), budget));
+ * @endcode
+ */
+class BudgetedRetryPolicy : public RPCRetryPolicy {
+ public:
+  BudgetedRetryPolicy(RPCRetryPolicy const& policy,
+                      std::shared_ptr<RetryBudget> budget)
+      : policy_(policy.clone()), budget_(std::move(budget)) {}
+
+  BudgetedRetryPolicy(BudgetedRetryPolicy const& rhs)
+      : policy_(rhs.policy_->clone()), budget_(rhs.budget_) {}
+
+  std::unique_ptr<RPCRetryPolicy> clone() const override;
+  void Setup(grpc::ClientContext& context) const override;
+  bool OnFailure(google::cloud::Status const& status) override;
+  // TODO(#2344) - remove ::grpc::Status version.
+  bool OnFailure(grpc::Status const& status) override;
+  void OnSuccess() override;
+
+ private:
+  std::unique_ptr<RPCRetryPolicy> policy_;
+  std::shared_ptr<RetryBudget> budget_;
+};
+
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
 }  // namespace cloud
@@ -106,3 +106,60 @@ TEST(LimitedErrorCountRetryPolicy, OnNonRetryable) {
   bigtable::LimitedErrorCountRetryPolicy tested(3);
   EXPECT_FALSE(tested.OnFailure(CreatePermanentError()));
 }
+
+/// @test Verify that BudgetedRetryPolicy stops retrying when the budget is
+/// exhausted, even if the wrapped policy would retry.
+TEST(BudgetedRetryPolicy, BudgetExhausted) {
+  auto budget = std::make_shared<google::cloud::RetryBudget>(0.5, 2.0);
+  bigtable::BudgetedRetryPolicy tested(
+      bigtable::LimitedErrorCountRetryPolicy(10), budget);
+  EXPECT_TRUE(tested.OnFailure(CreateTransientError()));
+  EXPECT_TRUE(tested.OnFailure(CreateTransientError()));
+  EXPECT_FALSE(tested.OnFailure(CreateTransientError()));
+  EXPECT_EQ(2, budget->permitted_retries());
+  EXPECT_EQ(1, budget->throttled_retries());
+
+  // Two successful requests earn one more retry.
+  tested.OnSuccess();
+  tested.OnSuccess();
+  EXPECT_TRUE(tested.OnFailure(CreateTransientError()));
+  EXPECT_FALSE(tested.OnFailure(CreateTransientError()));
+}
+
+/// @test Verify that BudgetedRetryPolicy respects the wrapped policy.
+TEST(BudgetedRetryPolicy, WrappedPolicyExhausted) {
+  auto budget = std::make_shared<google::cloud::RetryBudget>(0.5, 10.0);
+  bigtable::BudgetedRetryPolicy tested(
+      bigtable::LimitedErrorCountRetryPolicy(2), budget);
+  EXPECT_TRUE(tested.OnFailure(CreateTransientError()));
+  EXPECT_TRUE(tested.OnFailure(CreateTransientError()));
+  EXPECT_FALSE(tested.OnFailure(CreateTransientError()));
+  // Only the retries allowed by the wrapped policy consume tokens.
+  EXPECT_EQ(2, budget->permitted_retries());
+  EXPECT_EQ(0, budget->throttled_retries());
+}
+
+/// @test Verify that non-retryable errors do not consume the budget.
+TEST(BudgetedRetryPolicy, OnNonRetryable) {
+  auto budget = std::make_shared<google::cloud::RetryBudget>(0.5, 10.0);
+  bigtable::BudgetedRetryPolicy tested(
+      bigtable::LimitedErrorCountRetryPolicy(3), budget);
+  EXPECT_FALSE(tested.OnFailure(CreatePermanentError()));
+  EXPECT_EQ(0, budget->permitted_retries());
+}
+
+/// @test Verify that clones share the budget, but not the wrapped policy state.
+TEST(BudgetedRetryPolicy, Clone) {
+  auto budget = std::make_shared<google::cloud::RetryBudget>(0.5, 3.0);
+  bigtable::BudgetedRetryPolicy original(
+      bigtable::LimitedErrorCountRetryPolicy(2), budget);
+  auto c1 = original.clone();
+  auto c2 = original.clone();
+  EXPECT_TRUE(c1->OnFailure(CreateTransientError()));
+  EXPECT_TRUE(c1->OnFailure(CreateTransientError()));
+  EXPECT_FALSE(c1->OnFailure(CreateTransientError()));
+  EXPECT_TRUE(c2->OnFailure(CreateTransientError()));
+  EXPECT_FALSE(c2->OnFailure(CreateTransientError()));
+  EXPECT_EQ(3, budget->permitted_retries());
+  EXPECT_EQ(1, budget->throttled_retries());
+}
@@ -15,9 +15,11 @@
 #include "google/cloud/bigtable/table.h"
 #include "google/cloud/bigtable/internal/async_bulk_apply.h"
 #include "google/cloud/bigtable/internal/bulk_mutator.h"
+#include "google/cloud/bigtable/internal/row_cache_impl.h"
 #include "google/cloud/bigtable/internal/unary_client_utils.h"
 #include "google/cloud/grpc_error_delegate.h"
 #include "google/cloud/internal/async_retry_unary_rpc.h"
+#include "google/cloud/internal/background_threads_impl.h"
 #include <thread>
 #include <type_traits>
 
@@ -61,6 +63,204 @@ Row TransformReadModifyWriteRowResponse(Response& response) {
   return Row(std::move(*row.mutable_key()), std::move(cells));
 }
 
+using ReadRowResult = StatusOr<std::pair<bool, Row>>;
+
+/// Collect the results of a `Table::AsyncReadRow()` request.
+class AsyncReadRowHandler {
+ public:
+  AsyncReadRowHandler() : row_("", {}) {}
+
+  future<ReadRowResult> GetFuture() { return row_promise_.get_future(); }
+
+  future<bool> OnRow(Row row) {
+    // assert(!row_received_);
+    row_ = std::move(row);
+    row_received_ = true;
+    // Don't satisfy the promise before `OnStreamFinished`.
+    //
+    // The `CompletionQueue`, which this object holds a reference to, should
+    // not be shut down before `OnStreamFinished` is called. In order to make
+    // sure of that, satisying the `promise<>` is deferred until then - the
+    // user shouldn't shutown the `CompleetionQue` before this whole
+    // operations is done.
+    return make_ready_future(false);
+  }
+
+  void OnStreamFinished(Status status) {
+    if (row_received_) {
+      // If we got a row we don't need to care about the stream status.
+      row_promise_.set_value(std::make_pair(true, std::move(row_)));
+      return;
+    }
+    if (status.ok()) {
+      row_promise_.set_value(std::make_pair(false, Row("", {})));
+    } else {
+      row_promise_.set_value(std::move(status));
+    }
+  }
+
+ private:
+  Row row_;
+  bool row_received_{};
+  promise<ReadRowResult> row_promise_;
+};
+
+/**
+ * The state of a hedged `Table::AsyncReadRow()` request.
+ *
+ * Each attempt is a separate `AsyncRowReader`, with its own retry loop. The
+ * first attempt to succeed, or the last one to fail, satisfies the future
+ * returned to the application, and any other attempts are cancelled.
+ */
+class HedgedReadRowState
+    : public std::enable_shared_from_this<HedgedReadRowState> {
+ public:
+  /// Start a new attempt, return its result and a function to cancel it.
+  using StartAttemptFunction =
+      std::function<std::pair<future<ReadRowResult>, std::function<void()>>()>;
+
+  using TimerFuture = future<StatusOr<std::chrono::system_clock::time_point>>;
+
+  HedgedReadRowState(CompletionQueue cq, std::unique_ptr<HedgingPolicy> policy,
+                     StartAttemptFunction start_attempt)
+      : cq_(std::move(cq)),
+        policy_(std::move(policy)),
+        start_attempt_(std::move(start_attempt)),
+        start_time_(std::chrono::steady_clock::now()) {}
+
+  future<ReadRowResult> Start() {
+    auto result = promise_.get_future();
+    policy_->OnRequest();
+    StartAttempt();
+
+    // Do not extend the lifetime of this object if the timer is pending.
+    std::weak_ptr<HedgedReadRowState> w = shared_from_this();
+    auto timer = cq_.MakeRelativeTimer(policy_->hedge_delay())
+                     .then([w](TimerFuture f) {
+                       auto self = w.lock();
+                       if (!self || !f.get()) return;
+                       self->OnHedgeTimer();
+                     });
+    std::unique_lock<std::mutex> lk(mu_);
+    if (done_) {
+      lk.unlock();
+      timer.cancel();
+      return result;
+    }
+    timer_ = std::move(timer);
+    return result;
+  }
+
+ private:
+  void StartAttempt() {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      if (done_) return;
+      ++outstanding_;
+    }
+    auto attempt = start_attempt_();
+    auto self = shared_from_this();
+    attempt.first.then([self](future<ReadRowResult> f) {
+      self->OnAttemptFinished(f.get());
+    });
+    std::unique_lock<std::mutex> lk(mu_);
+    if (done_) {
+      lk.unlock();
+      attempt.second();
+      return;
+    }
+    cancel_.push_back(std::move(attempt.second));
+  }
+
+  void OnHedgeTimer() {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      if (done_) return;
+    }
+    if (!policy_->OnHedge()) return;
+    StartAttempt();
+  }
+
+  void OnAttemptFinished(ReadRowResult result) {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (done_) return;
+    --outstanding_;
+    // Wait for any other attempts before reporting a failure.
+    if (!result && outstanding_ != 0) return;
+    done_ = true;
+    auto cancel = std::move(cancel_);
+    auto timer = std::move(timer_);
+    lk.unlock();
+
+    for (auto& c : cancel) c();
+    if (timer.valid()) timer.cancel();
+    if (result) {
+      auto const elapsed = std::chrono::steady_clock::now() - start_time_;
+      policy_->OnCompletion(
+          std::chrono::duration_cast<std::chrono::microseconds>(elapsed));
+    }
+    promise_.set_value(std::move(result));
+  }
+
+  CompletionQueue cq_;
+  std::unique_ptr<HedgingPolicy> policy_;
+  StartAttemptFunction start_attempt_;
+  std::chrono::steady_clock::time_point const start_time_;
+  promise<ReadRowResult> promise_;
+
+  std::mutex mu_;
+  bool done_ = false;
+  int outstanding_ = 0;
+  std::vector<std::function<void()>> cancel_;
+  future<void> timer_;
+};
+
+/// Return the row keys in @p mut, leaving the mutations unchanged.
+std::vector<std::string> RowKeys(BulkMutation& mut) {
+  btproto::MutateRowsRequest request;
+  mut.MoveTo(&request);
+  std::vector<std::string> keys;
+  keys.reserve(static_cast<std::size_t>(request.entries_size()));
+  for (auto& entry : *request.mutable_entries()) {
+    keys.push_back(entry.row_key());
+    mut.emplace_back(SingleRowMutation(std::move(entry)));
+  }
+  return keys;
+}
+
+/// Remove the modified rows from the cache (if any) when a write completes.
+class InvalidateOnExit {
+ public:
+  InvalidateOnExit(std::shared_ptr<bigtable::internal::RowCacheImpl> cache,
+                   std::string table_name, std::vector<std::string> row_keys)
+      : cache_(std::move(cache)),
+        table_name_(std::move(table_name)),
+        row_keys_(std::move(row_keys)) {}
+  ~InvalidateOnExit() {
+    if (!cache_) return;
+    for (auto const& k : row_keys_) cache_->Invalidate(table_name_, k);
+  }
+
+  InvalidateOnExit(InvalidateOnExit const&) = delete;
+  InvalidateOnExit& operator=(InvalidateOnExit const&) = delete;
+
+ private:
+  std::shared_ptr<bigtable::internal::RowCacheImpl> cache_;
+  std::string table_name_;
+  std::vector<std::string> row_keys_;
+};
+
+/// Remove the modified rows from the cache (if any) once @p f is satisfied.
+template <typename T>
+future<T> InvalidateAfter(
+    future<T> f, std::shared_ptr<bigtable::internal::RowCacheImpl> cache,
+    std::string table_name, std::vector<std::string> row_keys) {
+  if (!cache) return f;
+  return f.then([cache, table_name, row_keys](future<T> g) {
+    for (auto const& k : row_keys) cache->Invalidate(table_name, k);
+    return g.get();
+  });
+}
 }  // namespace
 
 using ClientUtils = bigtable::internal::UnaryClientUtils<DataClient>;
@@ -69,6 +269,10 @@ static_assert(std::is_copy_assignable<bigtable::Table>::value,
               "bigtable::Table must be CopyAssignable");
 
 Status Table::Apply(SingleRowMutation mut) {
+  InvalidateOnExit invalidate(
+      row_cache_, table_name_,
+      row_cache_ ? std::vector<std::string>{mut.row_key()}
+                 : std::vector<std::string>{});
   // Copy the policies in effect for this operation.  Many policy classes change
   // their state as the operation makes progress (or fails to make progress), so
   // we need fresh instances.
@@ -98,6 +302,7 @@ Status Table::Apply(SingleRowMutation mut) {
     status = client_->MutateRow(&client_context, request, &response);
 
     if (status.ok()) {
+      rpc_policy->OnSuccess();
       return google::cloud::Status{};
     }
     // It is up to the policy to terminate this loop, it could run
@@ -111,6 +316,8 @@ Status Table::Apply(SingleRowMutation mut) {
 }
 
 future<Status> Table::AsyncApply(SingleRowMutation mut, CompletionQueue& cq) {
+  std::vector<std::string> row_keys;
+  if (row_cache_) row_keys.push_back(mut.row_key());
   google::bigtable::v2::MutateRowRequest request;
   SetCommonTableOperationRequest<google::bigtable::v2::MutateRowRequest>(
       request, app_profile_id_, table_name_);
@@ -132,23 +339,30 @@ future<Status> Table::AsyncApply(SingleRowMutation mut, CompletionQueue& cq) {
 
   auto client = client_;
   auto metadata_update_policy = clone_metadata_update_policy();
-  return google::cloud::internal::StartRetryAsyncUnaryRpc(
-             cq, __func__, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
-             idempotency,
-             [client, metadata_update_policy](
-                 grpc::ClientContext* context,
-                 google::bigtable::v2::MutateRowRequest const& request,
-                 grpc::CompletionQueue* cq) {
-               metadata_update_policy.Setup(*context);
-               return client->AsyncMutateRow(context, request, cq);
-             },
-             std::move(request))
-      .then([](future<StatusOr<google::bigtable::v2::MutateRowResponse>> r) {
-        return r.get().status();
-      });
+  auto result =
+      google::cloud::internal::StartRetryAsyncUnaryRpc(
+          cq, __func__, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
+          idempotency,
+          [client, metadata_update_policy](
+              grpc::ClientContext* context,
+              google::bigtable::v2::MutateRowRequest const& request,
+              grpc::CompletionQueue* cq) {
+            metadata_update_policy.Setup(*context);
+            return client->AsyncMutateRow(context, request, cq);
+          },
+          std::move(request))
+          .then(
+              [](future<StatusOr<google::bigtable::v2::MutateRowResponse>> r) {
+                return r.get().status();
+              });
+  return InvalidateAfter(std::move(result), row_cache_, table_name_,
+                         std::move(row_keys));
 }
 
 std::vector<FailedMutation> Table::BulkApply(BulkMutation mut) {
+  InvalidateOnExit invalidate(
+      row_cache_, table_name_,
+      row_cache_ ? RowKeys(mut) : std::vector<std::string>{});
   grpc::Status status;
 
   // Copy the policies in effect for this operation.  Many policy classes change
@@ -166,7 +380,9 @@ std::vector<FailedMutation> Table::BulkApply(BulkMutation mut) {
     retry_policy->Setup(client_context);
     metadata_update_policy_.Setup(client_context);
     status = mutator.MakeOneRequest(*client_, client_context);
-    if (!status.ok() && !retry_policy->OnFailure(status)) {
+    if (status.ok()) {
+      retry_policy->OnSuccess();
+    } else if (!retry_policy->OnFailure(status)) {
       break;
     }
     auto delay = backoff_policy->OnCompletion(status);
@@ -177,11 +393,15 @@ std::vector<FailedMutation> Table::BulkApply(BulkMutation mut) {
 
 future<std::vector<FailedMutation>> Table::AsyncBulkApply(BulkMutation mut,
                                                           CompletionQueue& cq) {
+  std::vector<std::string> row_keys;
+  if (row_cache_) row_keys = RowKeys(mut);
   auto mutation_policy = clone_idempotent_mutation_policy();
-  return internal::AsyncRetryBulkApply::Create(
+  auto result = internal::AsyncRetryBulkApply::Create(
       cq, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
       *mutation_policy, clone_metadata_update_policy(), client_,
       app_profile_id_, table_name(), std::move(mut));
+  return InvalidateAfter(std::move(result), row_cache_, table_name_,
+                         std::move(row_keys));
 }
 
 RowReader Table::ReadRows(RowSet row_set, Filter filter) {
@@ -203,6 +423,24 @@ RowReader Table::ReadRows(RowSet row_set, std::int64_t rows_limit,
 
 StatusOr<std::pair<bool, Row>> Table::ReadRow(std::string row_key,
                                               Filter filter) {
+  if (!row_cache_) {
+    return UncachedReadRow(std::move(row_key), std::move(filter));
+  }
+  // The cache calls the function, if at all, before `Read()` returns.
+  return row_cache_
+      ->Read(table_name_, row_key, filter,
+             [this, &row_key, &filter] {
+               return make_ready_future(UncachedReadRow(row_key, filter));
+             })
+      .get();
+}
+
+StatusOr<std::pair<bool, Row>> Table::UncachedReadRow(std::string row_key,
+                                                      Filter filter) {
+  if (hedging_policy_prototype_) {
+    auto cq = hedging_background_threads_->cq();
+    return AsyncHedgedReadRow(cq, std::move(row_key), std::move(filter)).get();
+  }
   RowSet row_set(std::move(row_key));
   std::int64_t const rows_limit = 1;
   RowReader reader =
@@ -226,6 +464,9 @@ StatusOr<std::pair<bool, Row>> Table::ReadRow(std::string row_key,
 StatusOr<MutationBranch> Table::CheckAndMutateRow(
     std::string row_key, Filter filter, std::vector<Mutation> true_mutations,
     std::vector<Mutation> false_mutations) {
+  InvalidateOnExit invalidate(row_cache_, table_name_,
+                              row_cache_ ? std::vector<std::string>{row_key}
+                                         : std::vector<std::string>{});
   grpc::Status status;
   btproto::CheckAndMutateRowRequest request;
   request.set_row_key(std::move(row_key));
@@ -256,6 +497,8 @@ StatusOr<MutationBranch> Table::CheckAndMutateRow(
 future<StatusOr<MutationBranch>> Table::AsyncCheckAndMutateRow(
     std::string row_key, Filter filter, std::vector<Mutation> true_mutations,
     std::vector<Mutation> false_mutations, CompletionQueue& cq) {
+  std::vector<std::string> row_keys;
+  if (row_cache_) row_keys.push_back(row_key);
   btproto::CheckAndMutateRowRequest request;
   request.set_row_key(std::move(row_key));
   SetCommonTableOperationRequest<btproto::CheckAndMutateRowRequest>(
@@ -273,27 +516,30 @@ future<StatusOr<MutationBranch>> Table::AsyncCheckAndMutateRow(
 
   auto client = client_;
   auto metadata_update_policy = clone_metadata_update_policy();
-  return google::cloud::internal::StartRetryAsyncUnaryRpc(
-             cq, __func__, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
-             idempotency,
-             [client, metadata_update_policy](
-                 grpc::ClientContext* context,
-                 btproto::CheckAndMutateRowRequest const& request,
-                 grpc::CompletionQueue* cq) {
-               metadata_update_policy.Setup(*context);
-               return client->AsyncCheckAndMutateRow(context, request, cq);
-             },
-             std::move(request))
-      .then([](future<StatusOr<btproto::CheckAndMutateRowResponse>> f)
-                -> StatusOr<MutationBranch> {
-        auto response = f.get();
-        if (!response) {
-          return response.status();
-        }
-        return response->predicate_matched()
-                   ? MutationBranch::kPredicateMatched
-                   : MutationBranch::kPredicateNotMatched;
-      });
+  auto result =
+      google::cloud::internal::StartRetryAsyncUnaryRpc(
+          cq, __func__, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
+          idempotency,
+          [client, metadata_update_policy](
+              grpc::ClientContext* context,
+              btproto::CheckAndMutateRowRequest const& request,
+              grpc::CompletionQueue* cq) {
+            metadata_update_policy.Setup(*context);
+            return client->AsyncCheckAndMutateRow(context, request, cq);
+          },
+          std::move(request))
+          .then([](future<StatusOr<btproto::CheckAndMutateRowResponse>> f)
+                    -> StatusOr<MutationBranch> {
+            auto response = f.get();
+            if (!response) {
+              return response.status();
+            }
+            return response->predicate_matched()
+                       ? MutationBranch::kPredicateMatched
+                       : MutationBranch::kPredicateNotMatched;
+          });
+  return InvalidateAfter(std::move(result), row_cache_, table_name_,
+                         std::move(row_keys));
 }
 
 // Call the `google.bigtable.v2.Bigtable.SampleRowKeys` RPC until
@@ -328,6 +574,7 @@ StatusOr<std::vector<bigtable::RowKeySample>> Table::SampleRows() {
     }
     auto status = stream->Finish();
     if (status.ok()) {
+      retry_policy->OnSuccess();
       break;
     }
     if (!retry_policy->OnFailure(status)) {
@@ -347,6 +594,10 @@ StatusOr<Row> Table::ReadModifyWriteRowImpl(
   SetCommonTableOperationRequest<
       ::google::bigtable::v2::ReadModifyWriteRowRequest>(
       request, app_profile_id_, table_name_);
+  InvalidateOnExit invalidate(
+      row_cache_, table_name_,
+      row_cache_ ? std::vector<std::string>{request.row_key()}
+                 : std::vector<std::string>{});
 
   grpc::Status status;
   auto response = ClientUtils::MakeNonIdempotentCall(
@@ -366,75 +617,54 @@ future<StatusOr<Row>> Table::AsyncReadModifyWriteRowImpl(
   SetCommonTableOperationRequest<
       ::google::bigtable::v2::ReadModifyWriteRowRequest>(
       request, app_profile_id_, table_name_);
+  std::vector<std::string> row_keys;
+  if (row_cache_) row_keys.push_back(request.row_key());
 
   auto client = client_;
   auto metadata_update_policy = clone_metadata_update_policy();
-  return google::cloud::internal::StartRetryAsyncUnaryRpc(
-             cq, __func__, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
-             Idempotency::kNonIdempotent,
-             [client, metadata_update_policy](
-                 grpc::ClientContext* context,
-                 btproto::ReadModifyWriteRowRequest const& request,
-                 grpc::CompletionQueue* cq) {
-               metadata_update_policy.Setup(*context);
-               return client->AsyncReadModifyWriteRow(context, request, cq);
-             },
-             std::move(request))
-      .then([](future<StatusOr<btproto::ReadModifyWriteRowResponse>> fut)
-                -> StatusOr<Row> {
-        auto result = fut.get();
-        if (!result) {
-          return result.status();
-        }
-        return TransformReadModifyWriteRowResponse<
-            btproto::ReadModifyWriteRowResponse>(*result);
-      });
+  auto result =
+      google::cloud::internal::StartRetryAsyncUnaryRpc(
+          cq, __func__, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
+          Idempotency::kNonIdempotent,
+          [client, metadata_update_policy](
+              grpc::ClientContext* context,
+              btproto::ReadModifyWriteRowRequest const& request,
+              grpc::CompletionQueue* cq) {
+            metadata_update_policy.Setup(*context);
+            return client->AsyncReadModifyWriteRow(context, request, cq);
+          },
+          std::move(request))
+          .then([](future<StatusOr<btproto::ReadModifyWriteRowResponse>> fut)
+                    -> StatusOr<Row> {
+            auto result = fut.get();
+            if (!result) {
+              return result.status();
+            }
+            return TransformReadModifyWriteRowResponse<
+                btproto::ReadModifyWriteRowResponse>(*result);
+          });
+  return InvalidateAfter(std::move(result), row_cache_, table_name_,
+                         std::move(row_keys));
 }
 
 future<StatusOr<std::pair<bool, Row>>> Table::AsyncReadRow(CompletionQueue& cq,
                                                            std::string row_key,
                                                            Filter filter) {
-  class AsyncReadRowHandler {
-   public:
-    AsyncReadRowHandler() : row_("", {}) {}
-
-    future<StatusOr<std::pair<bool, Row>>> GetFuture() {
-      return row_promise_.get_future();
-    }
-
-    future<bool> OnRow(Row row) {
-      // assert(!row_received_);
-      row_ = std::move(row);
-      row_received_ = true;
-      // Don't satisfy the promise before `OnStreamFinished`.
-      //
-      // The `CompletionQueue`, which this object holds a reference to, should
-      // not be shut down before `OnStreamFinished` is called. In order to make
-      // sure of that, satisying the `promise<>` is deferred until then - the
-      // user shouldn't shutown the `CompleetionQue` before this whole
-      // operations is done.
-      return make_ready_future(false);
-    }
-
-    void OnStreamFinished(Status status) {
-      if (row_received_) {
-        // If we got a row we don't need to care about the stream status.
-        row_promise_.set_value(std::make_pair(true, std::move(row_)));
-        return;
-      }
-      if (status.ok()) {
-        row_promise_.set_value(std::make_pair(false, Row("", {})));
-      } else {
-        row_promise_.set_value(std::move(status));
-      }
-    }
-
-   private:
-    Row row_;
-    bool row_received_{};
-    promise<StatusOr<std::pair<bool, Row>>> row_promise_;
-  };
+  if (!row_cache_) {
+    return UncachedAsyncReadRow(cq, std::move(row_key), std::move(filter));
+  }
+  // The cache calls the function, if at all, before `Read()` returns.
+  return row_cache_->Read(table_name_, row_key, filter,
+                          [this, &cq, &row_key, &filter] {
+                            return UncachedAsyncReadRow(cq, row_key, filter);
+                          });
+}
 
+future<StatusOr<std::pair<bool, Row>>> Table::UncachedAsyncReadRow(
+    CompletionQueue& cq, std::string row_key, Filter filter) {
+  if (hedging_policy_prototype_) {
+    return AsyncHedgedReadRow(cq, std::move(row_key), std::move(filter));
+  }
   RowSet row_set(std::move(row_key));
   std::int64_t const rows_limit = 1;
   auto handler = std::make_shared<AsyncReadRowHandler>();
@@ -447,6 +677,48 @@ future<StatusOr<std::pair<bool, Row>>> Table::AsyncReadRow(CompletionQueue& cq,
   return handler->GetFuture();
 }
 
+future<StatusOr<std::pair<bool, Row>>> Table::AsyncHedgedReadRow(
+    CompletionQueue& cq, std::string row_key, Filter filter) {
+  // Capture copies of the table configuration, the hedged request may outlive
+  // this object.
+  auto client = client_;
+  auto app_profile_id = app_profile_id_;
+  auto table_name = table_name_;
+  auto rpc_retry_policy = rpc_retry_policy_prototype_;
+  auto rpc_backoff_policy = rpc_backoff_policy_prototype_;
+  auto metadata_update_policy = metadata_update_policy_;
+  auto start_attempt = [cq, client, app_profile_id, table_name, row_key,
+                        filter, rpc_retry_policy, rpc_backoff_policy,
+                        metadata_update_policy] {
+    auto handler = std::make_shared<AsyncReadRowHandler>();
+    auto on_row = [handler](Row row) { return handler->OnRow(std::move(row)); };
+    auto on_finish = [handler](Status status) {
+      handler->OnStreamFinished(std::move(status));
+    };
+    using Reader = AsyncRowReader<decltype(on_row), decltype(on_finish)>;
+    std::int64_t const rows_limit = 1;
+    auto reader = Reader::Create(
+        cq, client, app_profile_id, table_name, std::move(on_row),
+        std::move(on_finish), RowSet(row_key), rows_limit, filter,
+        rpc_retry_policy->clone(), rpc_backoff_policy->clone(),
+        metadata_update_policy,
+        absl::make_unique<bigtable::internal::ReadRowsParserFactory>());
+    std::function<void()> cancel = [reader] { reader->CancelRequest(); };
+    return std::make_pair(handler->GetFuture(), std::move(cancel));
+  };
+  auto state = std::make_shared<HedgedReadRowState>(
+      cq, hedging_policy_prototype_->clone(), std::move(start_attempt));
+  return state->Start();
+}
+
+void Table::ChangePolicy(HedgingPolicy const& policy) {
+  hedging_policy_prototype_ = policy.clone();
+  if (!hedging_background_threads_) {
+    hedging_background_threads_ = std::make_shared<
+        google::cloud::internal::AutomaticallyCreatedBackgroundThreads>();
+  }
+}
+
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
 }  // namespace cloud
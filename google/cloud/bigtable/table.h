@@ -19,15 +19,18 @@
 #include "google/cloud/bigtable/completion_queue.h"
 #include "google/cloud/bigtable/data_client.h"
 #include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/hedging_policy.h"
 #include "google/cloud/bigtable/idempotent_mutation_policy.h"
 #include "google/cloud/bigtable/mutations.h"
 #include "google/cloud/bigtable/read_modify_write_rule.h"
+#include "google/cloud/bigtable/row_cache.h"
 #include "google/cloud/bigtable/row_key_sample.h"
 #include "google/cloud/bigtable/row_reader.h"
 #include "google/cloud/bigtable/row_set.h"
 #include "google/cloud/bigtable/rpc_backoff_policy.h"
 #include "google/cloud/bigtable/rpc_retry_policy.h"
 #include "google/cloud/bigtable/version.h"
+#include "google/cloud/background_threads.h"
 #include "google/cloud/future.h"
 #include "google/cloud/grpc_error_delegate.h"
 #include "google/cloud/status.h"
@@ -172,7 +175,10 @@ class Table {
   struct ValidPolicy
       : absl::disjunction<std::is_base_of<RPCBackoffPolicy, P>,
                           std::is_base_of<RPCRetryPolicy, P>,
-                          std::is_base_of<IdempotentMutationPolicy, P>> {};
+                          std::is_base_of<IdempotentMutationPolicy, P>,
+                          std::is_base_of<HedgingPolicy, P>,
+                          std::is_base_of<RowCache,
+                                          typename std::decay<P>::type>> {};
 
   /// A meta function to check if all the @p Policies are valid policy types.
   template <typename... Policies>
@@ -263,10 +269,19 @@ class Table {
    *       allowed. Use `LimitedTimeRetryPolicy` to bound the time for any
    *       request. You can also create your own policies that combine time and
    *       error counts.
+   *     - `HedgingPolicy` to send hedged requests in `ReadRow()` and
+   *       `AsyncReadRow()`. By default requests are not hedged. Use
+   *       `FixedDelayHedgingPolicy` or `PercentileHedgingPolicy` to enable
+   *       hedging.
+   *     - `RowCache` to serve `ReadRow()` and `AsyncReadRow()` from a
+   *       client-side cache. By default the reads are not cached. Unlike the
+   *       policies, the cache is shared with the application and with any
+   *       copies of this object.
    *
    * @see SafeIdempotentMutationPolicy, AlwaysRetryMutationPolicy,
    *     ExponentialBackoffPolicy, LimitedErrorCountRetryPolicy,
-   *     LimitedTimeRetryPolicy.
+   *     LimitedTimeRetryPolicy, FixedDelayHedgingPolicy,
+   *     PercentileHedgingPolicy.
    *
    * @par Idempotency Policy Example
    * @snippet data_snippets.cc apply relaxed idempotency
@@ -327,10 +342,19 @@ class Table {
    *       allowed. Use `LimitedTimeRetryPolicy` to bound the time for any
    *       request. You can also create your own policies that combine time and
    *       error counts.
+   *     - `HedgingPolicy` to send hedged requests in `ReadRow()` and
+   *       `AsyncReadRow()`. By default requests are not hedged. Use
+   *       `FixedDelayHedgingPolicy` or `PercentileHedgingPolicy` to enable
+   *       hedging.
+   *     - `RowCache` to serve `ReadRow()` and `AsyncReadRow()` from a
+   *       client-side cache. By default the reads are not cached. Unlike the
+   *       policies, the cache is shared with the application and with any
+   *       copies of this object.
    *
    * @see SafeIdempotentMutationPolicy, AlwaysRetryMutationPolicy,
    *     ExponentialBackoffPolicy, LimitedErrorCountRetryPolicy,
-   *     LimitedTimeRetryPolicy.
+   *     LimitedTimeRetryPolicy, FixedDelayHedgingPolicy,
+   *     PercentileHedgingPolicy.
    *
    * @par Idempotency Policy Example
    * @snippet data_snippets.cc apply relaxed idempotency
@@ -519,6 +543,17 @@ class Table {
    * @par Idempotency
    * This is a read-only operation and therefore it is always idempotent.
    *
+   * @par Hedging
+   * If the table was created with a `HedgingPolicy` a second request is sent
+   * when the first one does not complete within the policy's delay. The
+   * requests run in a background thread owned by this object, and the calling
+   * thread blocks until the first request completes.
+   *
+   * @par Caching
+   * If the table was created with a `RowCache` the result may be served from
+   * the cache, and concurrent reads for the same row and filter send a single
+   * request.
+   *
    * @par Thread-safety
    * Two threads concurrently calling this member function on the same instance
    * of this class are **not** guaranteed to work. Consider copying the object
@@ -827,6 +862,17 @@ class Table {
    * @par Idempotency
    * This is a read-only operation and therefore it is always idempotent.
    *
+   * @par Hedging
+   * If the table was created with a `HedgingPolicy` a second request is sent
+   * when the first one does not complete within the policy's delay. The future
+   * is satisfied with the first successful response, and the other request is
+   * cancelled.
+   *
+   * @par Caching
+   * If the table was created with a `RowCache` the future may be satisfied
+   * immediately from the cache, and concurrent reads for the same row and
+   * filter send a single request.
+   *
    * @par Thread-safety
    * Two threads concurrently calling this member function on the same instance
    * of this class are **not** guaranteed to work. Consider copying the object
@@ -877,6 +923,18 @@ class Table {
     return idempotent_mutation_policy_->clone();
   }
 
+  /// Implement `ReadRow()` without the cache.
+  StatusOr<std::pair<bool, Row>> UncachedReadRow(std::string row_key,
+                                                 Filter filter);
+
+  /// Implement `AsyncReadRow()` without the cache.
+  future<StatusOr<std::pair<bool, Row>>> UncachedAsyncReadRow(
+      CompletionQueue& cq, std::string row_key, Filter filter);
+
+  /// Send a `ReadRow` request, and hedge it as configured by the policy.
+  future<StatusOr<std::pair<bool, Row>>> AsyncHedgedReadRow(
+      CompletionQueue& cq, std::string row_key, Filter filter);
+
   //@{
   /// @name Helper functions to implement constructors with changed policies.
   void ChangePolicy(RPCRetryPolicy const& policy) {
@@ -891,6 +949,10 @@ class Table {
     idempotent_mutation_policy_ = policy.clone();
   }
 
+  void ChangePolicy(HedgingPolicy const& policy);
+
+  void ChangePolicy(RowCache const& cache) { row_cache_ = cache.impl_; }
+
   template <typename Policy, typename... Policies>
   void ChangePolicies(Policy&& policy, Policies&&... policies) {
     ChangePolicy(policy);
@@ -908,6 +970,11 @@ class Table {
   std::shared_ptr<RPCBackoffPolicy const> rpc_backoff_policy_prototype_;
   MetadataUpdatePolicy metadata_update_policy_;
   std::shared_ptr<IdempotentMutationPolicy> idempotent_mutation_policy_;
+  std::shared_ptr<HedgingPolicy const> hedging_policy_prototype_;
+  /// Runs the hedged requests for the synchronous `ReadRow()`.
+  std::shared_ptr<BackgroundThreads> hedging_background_threads_;
+  /// Caches the results of `ReadRow()`, shared with any copies.
+  std::shared_ptr<internal::RowCacheImpl> row_cache_;
 };
 
 }  // namespace BIGTABLE_CLIENT_NS
@@ -91,6 +91,36 @@ TEST_F(TableApplyTest, RetryIdempotent) {
   EXPECT_EQ(google::cloud::StatusCode::kUnavailable, status.code());
 }
 
+/// @test Verify that Table::Apply() stops retrying when the budget is empty.
+TEST_F(TableApplyTest, RetryBudgetExhausted) {
+  auto budget = std::make_shared<google::cloud::RetryBudget>(0.5, 2.0);
+  bigtable::Table table(
+      client_, kTableId,
+      bigtable::BudgetedRetryPolicy(
+          bigtable::LimitedErrorCountRetryPolicy(10), budget),
+      bigtable::ExponentialBackoffPolicy(std::chrono::microseconds(10),
+                                         std::chrono::microseconds(100)));
+
+  auto const transient =
+      grpc::Status(grpc::StatusCode::UNAVAILABLE, "try-again");
+  EXPECT_CALL(*client_, MutateRow)
+      .WillOnce(mock_mutate_row(transient))
+      .WillOnce(mock_mutate_row(transient))
+      .WillOnce(mock_mutate_row(transient))
+      .WillOnce(mock_mutate_row(grpc::Status::OK));
+  auto status = table.Apply(bigtable::SingleRowMutation(
+      "bar", {bigtable::SetCell("fam", "col", 0_ms, "val")}));
+  EXPECT_EQ(google::cloud::StatusCode::kUnavailable, status.code());
+  EXPECT_EQ(2, budget->permitted_retries());
+  EXPECT_EQ(1, budget->throttled_retries());
+
+  // Successful requests refill the budget.
+  status = table.Apply(bigtable::SingleRowMutation(
+      "bar", {bigtable::SetCell("fam", "col", 0_ms, "val")}));
+  ASSERT_STATUS_OK(status);
+  EXPECT_DOUBLE_EQ(0.5, budget->tokens());
+}
+
 }  // namespace
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
@@ -14,9 +14,16 @@
 
 #include "google/cloud/bigtable/table.h"
 #include "google/cloud/bigtable/testing/mock_read_rows_reader.h"
+#include "google/cloud/bigtable/testing/mock_response_reader.h"
 #include "google/cloud/bigtable/testing/table_test_fixture.h"
 #include "google/cloud/testing_util/assert_ok.h"
+#include "google/cloud/testing_util/chrono_literals.h"
 #include "absl/memory/memory.h"
+#include <grpcpp/alarm.h>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -25,8 +32,11 @@ inline namespace BIGTABLE_CLIENT_NS {
 namespace {
 
 namespace btproto = ::google::bigtable::v2;
+using ::google::cloud::bigtable::testing::MockClientAsyncReaderInterface;
 using ::google::cloud::bigtable::testing::MockReadRowsReader;
 using ::google::cloud::testing_util::IsContextMDValid;
+using ::google::cloud::testing_util::chrono_literals::operator"" _ms;
+using ::testing::_;
 using ::testing::Return;
 
 class TableReadRowTest : public bigtable::testing::TableTestFixture {};
@@ -118,6 +128,183 @@ TEST_F(TableReadRowTest, UnrecoverableFailure) {
   EXPECT_FALSE(row);
 }
 
+/**
+ * Completes the tags of mocked asynchronous streams from the CQ threads.
+ *
+ * The hedged `ReadRow()` runs its requests in the table's background threads,
+ * so the mocks must complete their tags through the real `CompletionQueue`.
+ * `Hold()` keeps a tag pending until `ReleaseHeld()` completes it with
+ * `ok == false`, tags held after `ReleaseHeld()` complete immediately.
+ */
+class AsyncTags {
+ public:
+  void Complete(grpc::CompletionQueue* cq, void* tag, bool ok = true) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto* alarm = Set(cq, tag, ok ? Now() : Later());
+    // A cancelled alarm completes with `ok == false`.
+    if (!ok) alarm->Cancel();
+  }
+
+  void Hold(grpc::CompletionQueue* cq, void* tag) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto* alarm = Set(cq, tag, Later());
+    if (released_) {
+      alarm->Cancel();
+      return;
+    }
+    held_.push_back(alarm);
+  }
+
+  void ReleaseHeld() {
+    std::lock_guard<std::mutex> lk(mu_);
+    released_ = true;
+    for (auto* a : held_) a->Cancel();
+    held_.clear();
+  }
+
+ private:
+  static std::chrono::system_clock::time_point Now() {
+    return std::chrono::system_clock::now();
+  }
+  static std::chrono::system_clock::time_point Later() {
+    return Now() + std::chrono::hours(1);
+  }
+
+  grpc::Alarm* Set(grpc::CompletionQueue* cq, void* tag,
+                   std::chrono::system_clock::time_point deadline) {
+    auto alarm = absl::make_unique<grpc::Alarm>();
+    alarm->Set(cq, deadline, tag);
+    alarms_.push_back(std::move(alarm));
+    return alarms_.back().get();
+  }
+
+  std::mutex mu_;
+  bool released_ = false;
+  std::vector<std::unique_ptr<grpc::Alarm>> alarms_;
+  std::vector<grpc::Alarm*> held_;
+};
+
+using MockAsyncReader =
+    MockClientAsyncReaderInterface<btproto::ReadRowsResponse>;
+
+/// @test Verify the synchronous `ReadRow()` returns the hedged response.
+TEST_F(TableReadRowTest, HedgedReadRowHedgeWins) {
+  AsyncTags tags;
+  promise<void> original_finished;
+  std::mutex mu;
+  int attempt = 0;
+  EXPECT_CALL(*client_, PrepareAsyncReadRows(_, _, _))
+      .Times(2)
+      .WillRepeatedly([&](grpc::ClientContext*,
+                          btproto::ReadRowsRequest const& req,
+                          grpc::CompletionQueue* cq) {
+        EXPECT_EQ(1, req.rows().row_keys_size());
+        EXPECT_EQ("r1", req.rows().row_keys(0));
+        auto reader = absl::make_unique<MockAsyncReader>();
+        EXPECT_CALL(*reader, StartCall(_)).WillOnce([&tags, cq](void* tag) {
+          tags.Complete(cq, tag);
+        });
+        auto const is_original = [&] {
+          std::lock_guard<std::mutex> lk(mu);
+          return attempt++ == 0;
+        }();
+        if (is_original) {
+          // The original request never returns any data, until it is
+          // cancelled at the end of the test.
+          EXPECT_CALL(*reader, Read(_, _))
+              .WillOnce([&tags, cq](btproto::ReadRowsResponse*, void* tag) {
+                tags.Hold(cq, tag);
+              });
+          EXPECT_CALL(*reader, Finish(_, _))
+              .WillOnce([&tags, &original_finished, cq](grpc::Status* status,
+                                                        void* tag) {
+                *status = grpc::Status(grpc::StatusCode::CANCELLED, "cancel");
+                tags.Complete(cq, tag);
+                original_finished.set_value();
+              });
+          return reader;
+        }
+        EXPECT_CALL(*reader, Read(_, _))
+            .WillOnce([&tags, cq](btproto::ReadRowsResponse* r, void* tag) {
+              *r = bigtable::testing::ReadRowsResponseFromString(R"(
+                  chunks {
+                    row_key: "r1"
+                    family_name { value: "fam" }
+                    qualifier { value: "col" }
+                    timestamp_micros: 42000
+                    value: "value"
+                    commit_row: true
+                  })");
+              tags.Complete(cq, tag);
+            })
+            .WillOnce([&tags, cq](btproto::ReadRowsResponse*, void* tag) {
+              tags.Complete(cq, tag, false);
+            });
+        EXPECT_CALL(*reader, Finish(_, _))
+            .WillOnce([&tags, cq](grpc::Status* status, void* tag) {
+              *status = grpc::Status::OK;
+              tags.Complete(cq, tag);
+            });
+        return reader;
+      });
+
+  auto budget = std::make_shared<HedgingBudget>(1.0, 10.0);
+  bigtable::Table table(client_, kTableId,
+                        FixedDelayHedgingPolicy(1_ms, budget));
+  auto result = table.ReadRow("r1", bigtable::Filter::PassAllFilter());
+
+  // Wait for the cancelled original request before destroying the table.
+  tags.ReleaseHeld();
+  original_finished.get_future().get();
+
+  ASSERT_STATUS_OK(result);
+  EXPECT_TRUE(result->first);
+  EXPECT_EQ("r1", result->second.row_key());
+  EXPECT_EQ(1, budget->hedges_sent());
+}
+
+/// @test Verify the synchronous `ReadRow()` does not hedge without budget.
+TEST_F(TableReadRowTest, HedgedReadRowBudgetExhausted) {
+  AsyncTags tags;
+  EXPECT_CALL(*client_, PrepareAsyncReadRows(_, _, _))
+      .WillOnce([&tags](grpc::ClientContext*, btproto::ReadRowsRequest const&,
+                        grpc::CompletionQueue* cq) {
+        auto reader = absl::make_unique<MockAsyncReader>();
+        EXPECT_CALL(*reader, StartCall(_)).WillOnce([&tags, cq](void* tag) {
+          tags.Complete(cq, tag);
+        });
+        // Keep the request pending until the hedge is rejected.
+        EXPECT_CALL(*reader, Read(_, _))
+            .WillOnce([&tags, cq](btproto::ReadRowsResponse*, void* tag) {
+              tags.Hold(cq, tag);
+            });
+        EXPECT_CALL(*reader, Finish(_, _))
+            .WillOnce([&tags, cq](grpc::Status* status, void* tag) {
+              *status = grpc::Status::OK;
+              tags.Complete(cq, tag);
+            });
+        return reader;
+      });
+
+  // An empty budget rejects all the hedges.
+  auto budget = std::make_shared<HedgingBudget>(0.0, 0.0);
+  bigtable::Table table(client_, kTableId,
+                        FixedDelayHedgingPolicy(1_ms, budget));
+  auto result = std::async(std::launch::async, [&table] {
+    return table.ReadRow("r1", bigtable::Filter::PassAllFilter());
+  });
+  while (budget->hedges_rejected() == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  tags.ReleaseHeld();
+
+  auto row = result.get();
+  ASSERT_STATUS_OK(row);
+  EXPECT_FALSE(row->first);
+  EXPECT_EQ(0, budget->hedges_sent());
+  EXPECT_EQ(1, budget->hedges_rejected());
+}
+
 }  // anonymous namespace
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
@@ -0,0 +1,185 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/future.h"
+#include "google/cloud/internal/default_completion_queue_impl.h"
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+
+// Run on (1 X 2100 MHz CPU )
+// ----------------------------------------------------------------------------
+// Benchmark                                     Time   Iterations UserCounters
+// ----------------------------------------------------------------------------
+// BM_CompletionQueueRunAsync/1/real_time      136148 ns    2448 7.34497M/s
+// BM_CompletionQueueRunAsync/4/real_time      125279 ns    2015 7.98221M/s
+// BM_CompletionQueueRunAsync/16/real_time     132842 ns    2194 7.52774M/s
+// BM_CompletionQueueRunAsyncChain/1/real_time 752630 ns     414 1.32867M/s
+// BM_CompletionQueueRunAsyncChain/4/real_time 820606 ns     366 1.21861M/s
+//
+// ----------------------------------------------------------------------------
+// Benchmark                                     Time   Iterations UserCounters
+// ----------------------------------------------------------------------------
+// BM_CompletionQueueCancelTimers/0/65536     1302 ms      1  50.3391k/s alarm
+// BM_CompletionQueueCancelTimers/1/65536     63.8 ms     10 1027.17k/s wheel
+// BM_CompletionQueueCancelTimers/0/1048576 184311 ms      1  5.68917k/s alarm
+// BM_CompletionQueueCancelTimers/1/1048576    901 ms      1   1.1632M/s wheel
+// BM_CompletionQueueExpireTimers/0/131072     752 ms      1  174.251k/s alarm
+// BM_CompletionQueueExpireTimers/1/131072     158 ms      6  830.039k/s wheel
+
+// Each iteration schedules a burst of functions and waits until all of them
+// run. The argument is the number of threads running the event loop, so the
+// items_per_second counter shows how `RunAsync()` scales with more threads.
+auto constexpr kBurstSize = 1000;
+
+void BM_CompletionQueueRunAsync(benchmark::State& state) {
+  CompletionQueue cq;
+  std::vector<std::thread> runners(static_cast<std::size_t>(state.range(0)));
+  for (auto& t : runners) t = std::thread([&cq] { cq.Run(); });
+
+  for (auto _ : state) {
+    std::atomic<int> pending(kBurstSize);
+    promise<void> done;
+    auto f = done.get_future();
+    for (int i = 0; i != kBurstSize; ++i) {
+      cq.RunAsync([&pending, &done] {
+        if (pending.fetch_sub(1) == 1) done.set_value();
+      });
+    }
+    f.get();
+  }
+  state.SetItemsProcessed(state.iterations() * kBurstSize);
+
+  cq.Shutdown();
+  for (auto& t : runners) t.join();
+}
+BENCHMARK(BM_CompletionQueueRunAsync)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
+
+// Schedule each function from the previous one, this measures the latency of
+// `RunAsync()` rather than its throughput.
+void BM_CompletionQueueRunAsyncChain(benchmark::State& state) {
+  CompletionQueue cq;
+  std::vector<std::thread> runners(static_cast<std::size_t>(state.range(0)));
+  for (auto& t : runners) t = std::thread([&cq] { cq.Run(); });
+
+  struct Chain {
+    CompletionQueue cq;
+    int remaining;
+    promise<void> done;
+
+    void Next() {
+      if (--remaining == 0) {
+        done.set_value();
+        return;
+      }
+      cq.RunAsync([this] { Next(); });
+    }
+  };
+
+  for (auto _ : state) {
+    Chain chain{cq, kBurstSize, {}};
+    auto f = chain.done.get_future();
+    cq.RunAsync([&chain] { chain.Next(); });
+    f.get();
+  }
+  state.SetItemsProcessed(state.iterations() * kBurstSize);
+
+  cq.Shutdown();
+  for (auto& t : runners) t.join();
+}
+BENCHMARK(BM_CompletionQueueRunAsyncChain)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
+
+using TimerFuture = future<StatusOr<std::chrono::system_clock::time_point>>;
+
+// The first argument selects the timer wheel (1) or one `grpc::Alarm` per
+// timer (0), the second argument is the number of timers.
+CompletionQueue MakeTimerCompletionQueue(benchmark::State& state) {
+  auto const use_timer_wheel = state.range(0) != 0;
+  state.SetLabel(use_timer_wheel ? "timer-wheel" : "alarm-per-timer");
+  return CompletionQueue(
+      std::make_shared<internal::DefaultCompletionQueueImpl>(use_timer_wheel));
+}
+
+// Create many outstanding timers, spread over the next minute, and then cancel
+// all of them. This is the common case for lease extension and backoff timers.
+void BM_CompletionQueueCancelTimers(benchmark::State& state) {
+  auto cq = MakeTimerCompletionQueue(state);
+  std::thread runner([&cq] { cq.Run(); });
+  auto const count = state.range(1);
+
+  std::vector<TimerFuture> timers(static_cast<std::size_t>(count));
+  for (auto _ : state) {
+    for (std::int64_t i = 0; i != count; ++i) {
+      timers[static_cast<std::size_t>(i)] =
+          cq.MakeRelativeTimer(std::chrono::milliseconds(1000 + i % 60000));
+    }
+    for (auto& t : timers) t.cancel();
+    for (auto& t : timers) benchmark::DoNotOptimize(t.get());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+
+  cq.Shutdown();
+  runner.join();
+}
+BENCHMARK(BM_CompletionQueueCancelTimers)
+    ->Args({0, 1 << 16})
+    ->Args({1, 1 << 16})
+    ->Args({0, 1 << 20})
+    ->Args({1, 1 << 20})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// Create many timers expiring in the next few milliseconds, and wait for all
+// of them.
+void BM_CompletionQueueExpireTimers(benchmark::State& state) {
+  auto cq = MakeTimerCompletionQueue(state);
+  std::thread runner([&cq] { cq.Run(); });
+  auto const count = state.range(1);
+
+  std::vector<TimerFuture> timers(static_cast<std::size_t>(count));
+  for (auto _ : state) {
+    for (std::int64_t i = 0; i != count; ++i) {
+      timers[static_cast<std::size_t>(i)] =
+          cq.MakeRelativeTimer(std::chrono::microseconds(i % 10000));
+    }
+    for (auto& t : timers) benchmark::DoNotOptimize(t.get());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+
+  cq.Shutdown();
+  runner.join();
+}
+BENCHMARK(BM_CompletionQueueExpireTimers)
+    ->Args({0, 1 << 17})
+    ->Args({1, 1 << 17})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -20,7 +20,9 @@
 #include <google/bigtable/admin/v2/bigtable_table_admin.grpc.pb.h>
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
 #include <gmock/gmock.h>
+#include <atomic>
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <thread>
 
@@ -125,6 +127,50 @@ TEST(CompletionQueueTest, TimerSmokeTest) {
   t.join();
 }
 
+/// @test Verify timers expire in order, and not before their deadline.
+TEST(CompletionQueueTest, TimerOrder) {
+  CompletionQueue cq;
+  std::thread t([&cq] { cq.Run(); });
+
+  using ms = std::chrono::milliseconds;
+  // Start with a long timer, the shorter timers must not wait for it.
+  auto long_timer = cq.MakeRelativeTimer(std::chrono::hours(1));
+  std::vector<future<std::chrono::system_clock::time_point>> timers;
+  for (auto d : {ms(50), ms(10), ms(0), ms(100), ms(10)}) {
+    timers.push_back(cq.MakeRelativeTimer(d).then(
+        [](future<StatusOr<std::chrono::system_clock::time_point>> f) {
+          auto deadline = f.get();
+          EXPECT_STATUS_OK(deadline);
+          EXPECT_LE(*deadline, std::chrono::system_clock::now());
+          return *deadline;
+        }));
+  }
+  for (auto& f : timers) f.get();
+  EXPECT_EQ(std::future_status::timeout, long_timer.wait_for(ms(0)));
+
+  long_timer.cancel();
+  EXPECT_EQ(StatusCode::kCancelled, long_timer.get().status().code());
+  cq.Shutdown();
+  t.join();
+}
+
+/// @test Verify the completion queue works without the timer wheel.
+TEST(CompletionQueueTest, TimerWithoutTimerWheel) {
+  CompletionQueue cq(std::make_shared<internal::DefaultCompletionQueueImpl>(
+      /*use_timer_wheel=*/false));
+  std::thread t([&cq] { cq.Run(); });
+
+  using ms = std::chrono::milliseconds;
+  auto expired = cq.MakeRelativeTimer(ms(1));
+  auto canceled = cq.MakeRelativeTimer(std::chrono::hours(1));
+  EXPECT_STATUS_OK(expired.get());
+  canceled.cancel();
+  EXPECT_EQ(StatusCode::kCancelled, canceled.get().status().code());
+
+  cq.Shutdown();
+  t.join();
+}
+
 TEST(CompletionQueueTest, MockSmokeTest) {
   auto mock = std::make_shared<FakeCompletionQueueImpl>();
 
@@ -488,6 +534,37 @@ TEST(CompletionQueueTest, RunAsyncThread) {
   for (auto& t : runners) t.join();
 }
 
+TEST(CompletionQueueTest, RunAsyncReentrant) {
+  CompletionQueue cq;
+  auto constexpr kRunners = 4;
+  std::vector<std::thread> runners(kRunners);
+  for (auto& t : runners) t = std::thread([&cq] { cq.Run(); });
+
+  // Each function in the chain schedules the next one and a leaf function,
+  // exercising calls to RunAsync() while the queued functions are drained.
+  auto constexpr kDepth = 1000;
+  auto constexpr kExpected = 2 * kDepth - 1;
+  std::atomic<int> count(0);
+  promise<void> done;
+  auto increment = [&] {
+    if (++count == kExpected) done.set_value();
+  };
+  std::function<void(int)> chain = [&](int depth) {
+    cq.RunAsync([&, depth] {
+      increment();
+      if (depth == kDepth) return;
+      chain(depth + 1);
+      cq.RunAsync(increment);
+    });
+  };
+  chain(1);
+  done.get_future().get();
+  EXPECT_EQ(kExpected, count.load());
+
+  cq.Shutdown();
+  for (auto& t : runners) t.join();
+}
+
 TEST(CompletionQueueTest, NoRunAsyncAfterShutdown) {
   CompletionQueue cq;
 
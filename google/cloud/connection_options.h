@@ -15,8 +15,11 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_CONNECTION_OPTIONS_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_CONNECTION_OPTIONS_H
 
+#include "google/cloud/backoff_sleeper.h"
 #include "google/cloud/completion_queue.h"
 #include "google/cloud/internal/background_threads_impl.h"
+#include "google/cloud/retry_budget.h"
+#include "google/cloud/rpc_metrics.h"
 #include "google/cloud/status_or.h"
 #include "google/cloud/tracing_options.h"
 #include "google/cloud/version.h"
@@ -129,6 +132,60 @@ class ConnectionOptions {
   /// Return the options for use when tracing RPCs.
   TracingOptions const& tracing_options() const { return tracing_options_; }
 
+  /**
+   * Record per-RPC metrics into @p sink.
+   *
+   * When set, clients configured with this object measure the latency, the
+   * request and response sizes, and the status of each RPC attempt, and
+   * report them to @p sink. Use `RpcMetricsAggregator` to aggregate the
+   * measurements in memory. The default is to not record any metrics.
+   */
+  ConnectionOptions& set_rpc_metrics_sink(
+      std::shared_ptr<RpcMetricsSink> sink) {
+    rpc_metrics_sink_ = std::move(sink);
+    return *this;
+  }
+
+  /// The sink for RPC metrics, `nullptr` if metrics are disabled.
+  std::shared_ptr<RpcMetricsSink> const& rpc_metrics_sink() const {
+    return rpc_metrics_sink_;
+  }
+
+  /**
+   * Limit the retries in clients configured with this object.
+   *
+   * All the retry loops in the clients created with this object consult
+   * @p budget before retrying a request. Share the same budget across several
+   * `ConnectionOptions` to limit their retries together. The default is to not
+   * use a budget, each request is retried as the retry policy allows.
+   */
+  ConnectionOptions& set_retry_budget(std::shared_ptr<RetryBudget> budget) {
+    retry_budget_ = std::move(budget);
+    return *this;
+  }
+
+  /// The retry budget, `nullptr` if retries are not limited by a budget.
+  std::shared_ptr<RetryBudget> const& retry_budget() const {
+    return retry_budget_;
+  }
+
+  /**
+   * Wait between retries with @p sleeper.
+   *
+   * The blocking operations in clients configured with this object call
+   * @p sleeper to wait for the backoff period between attempts. The default
+   * blocks the calling thread.
+   *
+   * @see `BackoffSleeper` for more details.
+   */
+  ConnectionOptions& set_backoff_sleeper(BackoffSleeper sleeper) {
+    backoff_sleeper_ = std::move(sleeper);
+    return *this;
+  }
+
+  /// The function used to wait between retries of blocking operations.
+  BackoffSleeper const& backoff_sleeper() const { return backoff_sleeper_; }
+
   /**
    * Define the gRPC channel domain for clients configured with this object.
    *
@@ -240,6 +297,9 @@ class ConnectionOptions {
   int num_channels_;
   std::set<std::string> tracing_components_;
   TracingOptions tracing_options_;
+  std::shared_ptr<RpcMetricsSink> rpc_metrics_sink_;
+  std::shared_ptr<RetryBudget> retry_budget_;
+  BackoffSleeper backoff_sleeper_ = DefaultBackoffSleeper();
   std::string channel_pool_domain_;
 
   std::string user_agent_prefix_;
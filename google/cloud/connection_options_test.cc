@@ -19,6 +19,7 @@
 #include "google/cloud/testing_util/scoped_environment.h"
 #include <gmock/gmock.h>
 #include <map>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -102,6 +103,32 @@ TEST(ConnectionOptionsTest, TracingOptions) {
   EXPECT_EQ(32, tracing_options.truncate_string_field_longer_than());
 }
 
+TEST(ConnectionOptionsTest, RpcMetricsSink) {
+  TestConnectionOptions options(grpc::InsecureChannelCredentials());
+  EXPECT_EQ(nullptr, options.rpc_metrics_sink());
+  auto sink = std::make_shared<RpcMetricsAggregator>();
+  options.set_rpc_metrics_sink(sink);
+  EXPECT_EQ(sink, options.rpc_metrics_sink());
+}
+
+TEST(ConnectionOptionsTest, RetryBudget) {
+  TestConnectionOptions options(grpc::InsecureChannelCredentials());
+  EXPECT_EQ(nullptr, options.retry_budget());
+  auto budget = std::make_shared<RetryBudget>();
+  options.set_retry_budget(budget);
+  EXPECT_EQ(budget, options.retry_budget());
+}
+
+TEST(ConnectionOptionsTest, BackoffSleeper) {
+  TestConnectionOptions options(grpc::InsecureChannelCredentials());
+  EXPECT_TRUE(static_cast<bool>(options.backoff_sleeper()));
+  std::vector<std::chrono::milliseconds> calls;
+  options.set_backoff_sleeper(
+      [&calls](std::chrono::milliseconds p) { calls.push_back(p); });
+  options.backoff_sleeper()(std::chrono::milliseconds(42));
+  EXPECT_THAT(calls, ElementsAre(std::chrono::milliseconds(42)));
+}
+
 TEST(ConnectionOptionsTest, ChannelPoolName) {
   TestConnectionOptions options(grpc::InsecureChannelCredentials());
   EXPECT_TRUE(options.channel_pool_domain().empty());
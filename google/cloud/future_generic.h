@@ -135,7 +135,7 @@ template <typename T>
 class promise final : private internal::promise_base<T> {
  public:
   /// Creates a promise with an unsatisfied shared state.
-  promise() : internal::promise_base<T>([] {}) {}
+  promise() = default;
 
   /// Creates a promise with an unsatisfied shared state.
   explicit promise(
@@ -143,6 +143,17 @@ class promise final : private internal::promise_base<T> {
       std::function<void()> cancellation_callback)
       : internal::promise_base<T>(std::move(cancellation_callback)) {}
 
+  /**
+   * Creates a promise with an unsatisfied shared state, allocated using
+   * @p alloc.
+   *
+   * Applications that create many short-lived futures may use this constructor
+   * to allocate their shared state from a pool, or any other custom allocator.
+   */
+  template <typename Alloc>
+  promise(std::allocator_arg_t, Alloc const& alloc)
+      : internal::promise_base<T>(std::allocator_arg, alloc, [] {}) {}
+
   /// Creates a promise *without* a shared state.
   explicit promise(null_promise_t x)
       : internal::promise_base<T>(std::move(x)) {}
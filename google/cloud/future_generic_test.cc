@@ -54,6 +54,46 @@ TEST(FutureTestInt, DestroyInSignalingThread) {
   }
 }
 
+/// A minimal allocator that counts the allocations.
+template <typename T>
+struct CountingAllocator {
+  using value_type = T;
+
+  explicit CountingAllocator(int* c) : count(c) {}
+  template <typename U>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  CountingAllocator(CountingAllocator<U> const& rhs) : count(rhs.count) {}
+
+  T* allocate(std::size_t n) {
+    ++*count;
+    return std::allocator<T>{}.allocate(n);
+  }
+  void deallocate(T* p, std::size_t n) { std::allocator<T>{}.deallocate(p, n); }
+
+  int* count;
+};
+
+template <typename T, typename U>
+bool operator==(CountingAllocator<T> const& a, CountingAllocator<U> const& b) {
+  return a.count == b.count;
+}
+
+template <typename T, typename U>
+bool operator!=(CountingAllocator<T> const& a, CountingAllocator<U> const& b) {
+  return !(a == b);
+}
+
+/// @test Verify the shared state can be created with a custom allocator.
+TEST(FutureTestInt, Allocator) {
+  int count = 0;
+  promise<int> p(std::allocator_arg, CountingAllocator<int>(&count));
+  EXPECT_EQ(1, count);
+  auto f = p.get_future();
+  EXPECT_FALSE(f.is_ready());
+  p.set_value(42);
+  EXPECT_EQ(42, f.get());
+}
+
 /// @test Verify promise<bool> works as expected
 TEST(FutureTestBool, SetValueBasic) {
   promise<bool> p;
@@ -0,0 +1,136 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/future.h"
+#include "google/cloud/testing_util/allocation_counter.h"
+#include <benchmark/benchmark.h>
+#include <thread>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+
+// Run on (1 X 2100 MHz CPU ), best CPU time of 6 runs.
+// ----------------------------------------------------------------------
+// Benchmark                        Before          After
+// ----------------------------------------------------------------------
+// BM_FutureGetReady           68.4 ns allocs=1   81.8 ns allocs=1
+// BM_FutureThenReady           187 ns allocs=3    167 ns allocs=2
+// BM_FutureThenNotReady        183 ns allocs=3    172 ns allocs=2
+// BM_FutureThenChain/16       2624 ns allocs=33  2130 ns allocs=17
+// BM_FutureThenCrossThread   10031 ns allocs=4  10383 ns allocs=3
+//
+// "Before" uses a mutex to protect each shared state, and allocates each
+// continuation on the heap. "After" uses atomic operations, and stores the
+// continuations in the shared state. The results are noisy in this (virtual)
+// machine, the allocation counts are not.
+//
+// `BM_FutureGetReady` is about 13ns slower. Part of that is the larger shared
+// state (264 vs. 168 bytes), the continuation buffer is unused in this
+// benchmark, but shrinking it only recovers about 3ns. We accept the
+// difference: most futures in the library get a continuation, and all the
+// single-thread benchmarks with continuations are faster.
+
+// Report the number of allocations per iteration. Only the allocations in the
+// benchmark thread are counted, not in the threads created by the benchmark
+// library (if any).
+class ReportAllocations {
+ public:
+  explicit ReportAllocations(benchmark::State& state) : state_(state) {
+    counter_.Start();
+  }
+  ~ReportAllocations() {
+    counter_.Stop();
+    state_.counters["allocs"] =
+        benchmark::Counter(static_cast<double>(counter_.count()),
+                           benchmark::Counter::kAvgIterations);
+  }
+
+ private:
+  benchmark::State& state_;
+  testing_util::AllocationCounter counter_;
+};
+
+// Create a promise/future pair, satisfy the promise, and get the value.
+void BM_FutureGetReady(benchmark::State& state) {
+  ReportAllocations report(state);
+  for (auto _ : state) {
+    promise<int> p;
+    auto f = p.get_future();
+    p.set_value(42);
+    benchmark::DoNotOptimize(f.get());
+  }
+}
+BENCHMARK(BM_FutureGetReady);
+
+// Attach a continuation to a satisfied future, it runs immediately.
+void BM_FutureThenReady(benchmark::State& state) {
+  ReportAllocations report(state);
+  for (auto _ : state) {
+    promise<int> p;
+    auto f = p.get_future();
+    p.set_value(42);
+    auto g = f.then([](future<int> f) { return f.get() + 1; });
+    benchmark::DoNotOptimize(g.get());
+  }
+}
+BENCHMARK(BM_FutureThenReady);
+
+// Attach a continuation, and then satisfy the future. This is the most common
+// case in the library, where continuations are attached to pending RPCs.
+void BM_FutureThenNotReady(benchmark::State& state) {
+  ReportAllocations report(state);
+  for (auto _ : state) {
+    promise<int> p;
+    auto g = p.get_future().then([](future<int> f) { return f.get() + 1; });
+    p.set_value(42);
+    benchmark::DoNotOptimize(g.get());
+  }
+}
+BENCHMARK(BM_FutureThenNotReady);
+
+// Attach a chain of continuations before satisfying the first future.
+void BM_FutureThenChain(benchmark::State& state) {
+  ReportAllocations report(state);
+  for (auto _ : state) {
+    promise<int> p;
+    auto f = p.get_future();
+    for (std::int64_t i = 0; i != state.range(0); ++i) {
+      f = f.then([](future<int> f) { return f.get() + 1; });
+    }
+    p.set_value(0);
+    benchmark::DoNotOptimize(f.get());
+  }
+}
+BENCHMARK(BM_FutureThenChain)->Arg(16);
+
+// Satisfy the future from a different thread, while this thread blocks
+// waiting for the result of the continuation.
+void BM_FutureThenCrossThread(benchmark::State& state) {
+  ReportAllocations report(state);
+  for (auto _ : state) {
+    promise<int> p;
+    auto g = p.get_future().then([](future<int> f) { return f.get() + 1; });
+    std::thread t([&p] { p.set_value(42); });
+    benchmark::DoNotOptimize(g.get());
+    t.join();
+  }
+}
+BENCHMARK(BM_FutureThenCrossThread);
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -131,12 +131,23 @@ template <>
 class promise<void> final : private internal::promise_base<void> {
  public:
   /// Creates a promise with an unsatisfied shared state.
-  promise() : promise_base([] {}) {}
+  promise() = default;
 
   /// Creates a promise with an unsatisfied shared state.
   explicit promise(std::function<void()> cancellation_callback)
       : promise_base(std::move(cancellation_callback)) {}
 
+  /**
+   * Creates a promise with an unsatisfied shared state, allocated using
+   * @p alloc.
+   *
+   * Applications that create many short-lived futures may use this constructor
+   * to allocate their shared state from a pool, or any other custom allocator.
+   */
+  template <typename Alloc>
+  promise(std::allocator_arg_t, Alloc const& alloc)
+      : promise_base(std::allocator_arg, alloc, [] {}) {}
+
   /// Creates a promise *without* a shared state.
   explicit promise(null_promise_t x) : promise_base(std::move(x)) {}
 
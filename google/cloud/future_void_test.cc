@@ -61,6 +61,16 @@ TEST(FutureTestVoid, DestroyInSignalingThread) {
   }
 }
 
+/// @test Verify the shared state can be created with an allocator.
+TEST(FutureTestVoid, Allocator) {
+  promise<void> p(std::allocator_arg, std::allocator<void>{});
+  auto f = p.get_future();
+  EXPECT_FALSE(f.is_ready());
+  p.set_value();
+  f.get();
+  SUCCEED();
+}
+
 /// @test Verify conformance with section 30.6.5 of the C++14 spec.
 // NOLINTNEXTLINE(google-readability-avoid-underscore-in-googletest-name)
 TEST(FutureTestVoid, conform_30_6_5_3) {
@@ -17,7 +17,9 @@
 """Automatically generated source lists for google_cloud_cpp_common - DO NOT EDIT."""
 
 google_cloud_cpp_common_hdrs = [
+    "async_log_backend.h",
     "backoff_policy.h",
+    "backoff_sleeper.h",
     "future.h",
     "future_generic.h",
     "future_void.h",
@@ -38,6 +40,7 @@ google_cloud_cpp_common_hdrs = [
     "internal/filesystem.h",
     "internal/format_time_point.h",
     "internal/future_base.h",
+    "internal/future_coroutines.h",
     "internal/future_fwd.h",
     "internal/future_impl.h",
     "internal/future_then_impl.h",
@@ -45,6 +48,7 @@ google_cloud_cpp_common_hdrs = [
     "internal/getenv.h",
     "internal/invoke_result.h",
     "internal/ios_flags_saver.h",
+    "internal/latency_histogram.h",
     "internal/parse_rfc3339.h",
     "internal/port_platform.h",
     "internal/random.h",
@@ -60,6 +64,8 @@ google_cloud_cpp_common_hdrs = [
     "log.h",
     "optional.h",
     "polling_policy.h",
+    "retry_budget.h",
+    "rpc_metrics.h",
     "status.h",
     "status_or.h",
     "terminate_handler.h",
@@ -68,6 +74,7 @@ google_cloud_cpp_common_hdrs = [
 ]
 
 google_cloud_cpp_common_srcs = [
+    "async_log_backend.cc",
     "iam_bindings.cc",
     "iam_policy.cc",
     "internal/api_client_header.cc",
@@ -77,6 +84,7 @@ google_cloud_cpp_common_srcs = [
     "internal/format_time_point.cc",
     "internal/future_impl.cc",
     "internal/getenv.cc",
+    "internal/latency_histogram.cc",
     "internal/parse_rfc3339.cc",
     "internal/random.cc",
     "internal/setenv.cc",
@@ -85,6 +93,8 @@ google_cloud_cpp_common_srcs = [
     "internal/user_agent_prefix.cc",
     "kms_key_name.cc",
     "log.cc",
+    "retry_budget.cc",
+    "rpc_metrics.cc",
     "status.cc",
     "terminate_handler.cc",
     "tracing_options.cc",
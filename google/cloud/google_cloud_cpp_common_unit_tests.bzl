@@ -17,6 +17,7 @@
 """Automatically generated unit tests list - DO NOT EDIT."""
 
 google_cloud_cpp_common_unit_tests = [
+    "async_log_backend_test.cc",
     "future_generic_test.cc",
     "future_generic_then_test.cc",
     "future_void_test.cc",
@@ -29,8 +30,10 @@ google_cloud_cpp_common_unit_tests = [
     "internal/env_test.cc",
     "internal/filesystem_test.cc",
     "internal/format_time_point_test.cc",
+    "internal/future_coroutines_test.cc",
     "internal/future_impl_test.cc",
     "internal/invoke_result_test.cc",
+    "internal/latency_histogram_test.cc",
     "internal/parse_rfc3339_test.cc",
     "internal/random_test.cc",
     "internal/retry_policy_test.cc",
@@ -41,6 +44,8 @@ google_cloud_cpp_common_unit_tests = [
     "internal/utility_test.cc",
     "kms_key_name_test.cc",
     "log_test.cc",
+    "retry_budget_test.cc",
+    "rpc_metrics_test.cc",
     "status_or_test.cc",
     "status_test.cc",
     "terminate_handler_test.cc",
@@ -26,29 +26,38 @@ google_cloud_cpp_grpc_utils_hdrs = [
     "grpc_utils/completion_queue.h",
     "grpc_utils/grpc_error_delegate.h",
     "grpc_utils/version.h",
+    "internal/async_polling_loop.h",
     "internal/async_read_stream_impl.h",
     "internal/async_read_write_stream_impl.h",
     "internal/async_retry_loop.h",
     "internal/async_retry_unary_rpc.h",
     "internal/async_rpc_details.h",
     "internal/background_threads_impl.h",
+    "internal/completion_queue_coroutines.h",
     "internal/completion_queue_impl.h",
     "internal/default_completion_queue_impl.h",
     "internal/log_wrapper.h",
+    "internal/metrics_wrapper.h",
     "internal/pagination_range.h",
     "internal/polling_loop.h",
+    "internal/resumable_streaming_read_rpc.h",
     "internal/retry_loop.h",
     "internal/retry_loop_helpers.h",
+    "internal/stream_range.h",
+    "internal/streaming_read_rpc.h",
     "internal/time_utils.h",
+    "internal/timer_wheel.h",
 ]
 
 google_cloud_cpp_grpc_utils_srcs = [
     "completion_queue.cc",
     "connection_options.cc",
     "grpc_error_delegate.cc",
+    "internal/async_polling_loop.cc",
     "internal/background_threads_impl.cc",
     "internal/default_completion_queue_impl.cc",
     "internal/log_wrapper.cc",
     "internal/retry_loop_helpers.cc",
     "internal/time_utils.cc",
+    "internal/timer_wheel.cc",
 ]
@@ -20,13 +20,20 @@ google_cloud_cpp_grpc_utils_unit_tests = [
     "completion_queue_test.cc",
     "connection_options_test.cc",
     "grpc_error_delegate_test.cc",
+    "internal/async_polling_loop_test.cc",
     "internal/async_read_write_stream_impl_test.cc",
     "internal/async_retry_loop_test.cc",
     "internal/async_retry_unary_rpc_test.cc",
     "internal/background_threads_impl_test.cc",
+    "internal/completion_queue_coroutines_test.cc",
     "internal/log_wrapper_test.cc",
+    "internal/metrics_wrapper_test.cc",
     "internal/pagination_range_test.cc",
     "internal/polling_loop_test.cc",
+    "internal/resumable_streaming_read_rpc_test.cc",
     "internal/retry_loop_test.cc",
+    "internal/stream_range_test.cc",
+    "internal/streaming_read_rpc_test.cc",
     "internal/time_utils_test.cc",
+    "internal/timer_wheel_test.cc",
 ]
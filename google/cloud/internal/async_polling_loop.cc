@@ -0,0 +1,204 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/async_polling_loop.h"
+#include "absl/memory/memory.h"
+#include <algorithm>
+#include <atomic>
+#include <string>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+using ::google::longrunning::Operation;
+
+class AsyncPollingLoopImpl
+    : public std::enable_shared_from_this<AsyncPollingLoopImpl> {
+ public:
+  AsyncPollingLoopImpl(google::cloud::CompletionQueue cq,
+                       AsyncPollLongRunningOperation poll,
+                       AsyncCancelLongRunningOperation cancel,
+                       std::unique_ptr<PollingPolicy> polling_policy,
+                       char const* location)
+      : cq_(std::move(cq)),
+        poll_(std::move(poll)),
+        cancel_(std::move(cancel)),
+        polling_policy_(std::move(polling_policy)),
+        location_(location) {}
+
+  future<StatusOr<Operation>> Start(Operation op) {
+    auto weak = std::weak_ptr<AsyncPollingLoopImpl>(shared_from_this());
+    result_ = promise<StatusOr<Operation>>([weak] {
+      if (auto self = weak.lock()) self->Cancel();
+    });
+    auto f = result_.get_future();
+    op_name_ = op.name();
+    if (op.done()) {
+      result_.set_value(std::move(op));
+      return f;
+    }
+    Wait();
+    return f;
+  }
+
+  /// Stop polling, without cancelling the operation in the service.
+  void Stop() {
+    std::unique_lock<std::mutex> lk(mu_);
+    stopped_ = true;
+    auto timer = std::move(timer_);
+    lk.unlock();
+    // The timer callback reports the loop as stopped.
+    if (timer.valid()) timer.cancel();
+  }
+
+ private:
+  void Wait() {
+    if (stopped()) {
+      result_.set_value(StoppedStatus());
+      return;
+    }
+    auto self = shared_from_this();
+    auto timer =
+        cq_.MakeRelativeTimer(polling_policy_->WaitPeriod())
+            .then([self](future<StatusOr<std::chrono::system_clock::time_point>>
+                             f) { self->OnTimer(f.get()); });
+    std::unique_lock<std::mutex> lk(mu_);
+    if (stopped_) {
+      lk.unlock();
+      timer.cancel();
+      return;
+    }
+    timer_ = std::move(timer);
+  }
+
+  void OnTimer(StatusOr<std::chrono::system_clock::time_point> tp) {
+    if (!tp) {
+      if (stopped()) {
+        result_.set_value(StoppedStatus());
+        return;
+      }
+      // Some kind of error in the CompletionQueue, probably shutting down.
+      result_.set_value(std::move(tp).status());
+      return;
+    }
+    google::longrunning::GetOperationRequest request;
+    request.set_name(op_name_);
+    auto self = shared_from_this();
+    poll_(cq_, absl::make_unique<grpc::ClientContext>(), request)
+        .then([self](future<StatusOr<Operation>> f) {
+          self->OnPoll(f.get());
+        });
+  }
+
+  void OnPoll(StatusOr<Operation> op) {
+    if (op && op->done()) {
+      result_.set_value(*std::move(op));
+      return;
+    }
+    // Update the polling policy even on successful requests, so we can stop
+    // after too many polling attempts.
+    if (!polling_policy_->OnFailure(op.status())) {
+      if (op) {
+        result_.set_value(
+            Status(StatusCode::kDeadlineExceeded,
+                   std::string(location_) +
+                       "() - exhausted polling policy with no previous error"));
+        return;
+      }
+      result_.set_value(std::move(op).status());
+      return;
+    }
+    Wait();
+  }
+
+  void Cancel() {
+    if (cancelled_.exchange(true) || !cancel_) return;
+    google::longrunning::CancelOperationRequest request;
+    request.set_name(op_name_);
+    // The result is ignored, the next poll reports if the operation was
+    // actually cancelled.
+    (void)cancel_(cq_, absl::make_unique<grpc::ClientContext>(), request);
+  }
+
+  bool stopped() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return stopped_;
+  }
+
+  Status StoppedStatus() const {
+    return Status(StatusCode::kCancelled,
+                  std::string(location_) +
+                      "() - polling stopped before the operation completed");
+  }
+
+  google::cloud::CompletionQueue cq_;
+  AsyncPollLongRunningOperation poll_;
+  AsyncCancelLongRunningOperation cancel_;
+  std::unique_ptr<PollingPolicy> polling_policy_;
+  char const* location_;
+  std::string op_name_;
+  std::atomic<bool> cancelled_{false};
+  promise<StatusOr<Operation>> result_;
+
+  std::mutex mu_;
+  bool stopped_ = false;
+  future<void> timer_;
+};
+
+void AsyncPollingLoopGroup::Shutdown() {
+  std::unique_lock<std::mutex> lk(mu_);
+  shutdown_ = true;
+  auto loops = std::move(loops_);
+  lk.unlock();
+  for (auto& w : loops) {
+    if (auto loop = w.lock()) loop->Stop();
+  }
+}
+
+void AsyncPollingLoopGroup::Add(
+    std::shared_ptr<AsyncPollingLoopImpl> const& loop) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (shutdown_) {
+    lk.unlock();
+    loop->Stop();
+    return;
+  }
+  // Forget about any loops that have completed.
+  loops_.erase(std::remove_if(loops_.begin(), loops_.end(),
+                              [](std::weak_ptr<AsyncPollingLoopImpl> const& w) {
+                                return w.expired();
+                              }),
+               loops_.end());
+  loops_.push_back(loop);
+}
+
+future<StatusOr<google::longrunning::Operation>> AsyncPollingLoop(
+    google::cloud::CompletionQueue cq, google::longrunning::Operation op,
+    AsyncPollLongRunningOperation poll, AsyncCancelLongRunningOperation cancel,
+    std::unique_ptr<PollingPolicy> polling_policy, char const* location,
+    AsyncPollingLoopGroup* group) {
+  auto loop = std::make_shared<AsyncPollingLoopImpl>(
+      std::move(cq), std::move(poll), std::move(cancel),
+      std::move(polling_policy), location);
+  auto f = loop->Start(std::move(op));
+  if (group != nullptr) group->Add(loop);
+  return f;
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
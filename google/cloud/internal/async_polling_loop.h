@@ -0,0 +1,136 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_POLLING_LOOP_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_POLLING_LOOP_H
+
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/future.h"
+#include "google/cloud/grpc_error_delegate.h"
+#include "google/cloud/polling_policy.h"
+#include "google/cloud/status_or.h"
+#include "google/cloud/version.h"
+#include <google/longrunning/operations.pb.h>
+#include <grpcpp/grpcpp.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/// Asynchronously fetch the current state of a long-running operation.
+using AsyncPollLongRunningOperation =
+    std::function<future<StatusOr<google::longrunning::Operation>>(
+        google::cloud::CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
+        google::longrunning::GetOperationRequest const&)>;
+
+/// Asynchronously request the cancellation of a long-running operation.
+using AsyncCancelLongRunningOperation = std::function<future<Status>(
+    google::cloud::CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
+    google::longrunning::CancelOperationRequest const&)>;
+
+class AsyncPollingLoopImpl;
+
+/**
+ * Stop a group of `AsyncPollingLoop()` calls.
+ *
+ * Connections use this class to stop polling when they are destroyed. The
+ * loops wait on timers from the connection's `CompletionQueue`, and if the
+ * connection owns the threads running that queue, releasing those threads
+ * would block until the next polling timer expires. `Shutdown()` cancels the
+ * pending timers and the futures returned by the loops are satisfied with a
+ * `kCancelled` error. The long-running operations are *not* cancelled, they
+ * continue to run in the service.
+ */
+class AsyncPollingLoopGroup {
+ public:
+  AsyncPollingLoopGroup() = default;
+  AsyncPollingLoopGroup(AsyncPollingLoopGroup const&) = delete;
+  AsyncPollingLoopGroup& operator=(AsyncPollingLoopGroup const&) = delete;
+
+  /// Stop any pending loops in this group, and any loops added later.
+  void Shutdown();
+
+  /// Add a loop to the group, stopping it immediately after `Shutdown()`.
+  void Add(std::shared_ptr<AsyncPollingLoopImpl> const& loop);
+
+ private:
+  std::mutex mu_;
+  bool shutdown_ = false;
+  std::vector<std::weak_ptr<AsyncPollingLoopImpl>> loops_;
+};
+
+/**
+ * Poll a long-running operation until it completes, without blocking threads.
+ *
+ * This is the asynchronous version of `PollingLoop()`. Instead of sleeping
+ * between polls it waits on `CompletionQueue` timers, so any number of
+ * operations can be awaited using only the threads running `cq.Run()`.
+ *
+ * Cancelling the returned future calls @p cancel, which asks the service to
+ * cancel the operation. The loop keeps polling until the operation completes,
+ * typically with a `kCancelled` error, because the service may ignore the
+ * request, or may complete the operation before it is cancelled.
+ *
+ * If @p group is not null the loop is added to it, and stops polling when the
+ * group is shut down.
+ *
+ * @return the completed operation, or the error that stopped the loop, for
+ *     example, if the polling policy is exhausted.
+ */
+future<StatusOr<google::longrunning::Operation>> AsyncPollingLoop(
+    google::cloud::CompletionQueue cq, google::longrunning::Operation op,
+    AsyncPollLongRunningOperation poll, AsyncCancelLongRunningOperation cancel,
+    std::unique_ptr<PollingPolicy> polling_policy, char const* location,
+    AsyncPollingLoopGroup* group = nullptr);
+
+/**
+ * Asynchronously wait for a long-running operation and extract its result.
+ *
+ * @tparam ValueExtractor one of `PollingLoopResponseExtractor` or
+ *     `PollingLoopMetadataExtractor`, defined in
+ *     `google/cloud/internal/polling_loop.h`.
+ */
+template <typename ValueExtractor>
+future<typename ValueExtractor::ReturnType> AsyncAwaitLongRunningOperation(
+    google::cloud::CompletionQueue cq, google::longrunning::Operation op,
+    AsyncPollLongRunningOperation poll, AsyncCancelLongRunningOperation cancel,
+    std::unique_ptr<PollingPolicy> polling_policy, char const* location,
+    AsyncPollingLoopGroup* group = nullptr) {
+  using ReturnType = typename ValueExtractor::ReturnType;
+  return AsyncPollingLoop(std::move(cq), std::move(op), std::move(poll),
+                          std::move(cancel), std::move(polling_policy),
+                          location, group)
+      .then([location](future<StatusOr<google::longrunning::Operation>> f)
+                -> ReturnType {
+        auto op = f.get();
+        if (!op) return std::move(op).status();
+        if (op->has_error()) {
+          // The long running operation failed, return the error to the caller.
+          return google::cloud::MakeStatusFromRpcError(op->error());
+        }
+        return ValueExtractor::Extract(*op, location);
+      });
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_POLLING_LOOP_H
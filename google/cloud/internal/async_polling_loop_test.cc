@@ -0,0 +1,285 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/async_polling_loop.h"
+#include "google/cloud/backoff_policy.h"
+#include "google/cloud/internal/background_threads_impl.h"
+#include "google/cloud/internal/polling_loop.h"
+#include "google/cloud/internal/retry_policy.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include "google/cloud/testing_util/fake_completion_queue_impl.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <google/protobuf/struct.pb.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+using ::google::longrunning::CancelOperationRequest;
+using ::google::longrunning::GetOperationRequest;
+using ::google::longrunning::Operation;
+using ::testing::HasSubstr;
+
+struct TestGrpcRetry {
+  static inline bool IsPermanentFailure(google::cloud::Status const& status) {
+    return !status.ok() && status.code() != StatusCode::kUnavailable;
+  }
+};
+
+std::unique_ptr<PollingPolicy> TestPollingPolicy() {
+  using Policy =
+      GenericPollingPolicy<LimitedErrorCountRetryPolicy<TestGrpcRetry>,
+                           ExponentialBackoffPolicy>;
+  return Policy(LimitedErrorCountRetryPolicy<TestGrpcRetry>(5),
+                ExponentialBackoffPolicy(std::chrono::microseconds(1),
+                                         std::chrono::microseconds(5), 2.0))
+      .clone();
+}
+
+/// A polling policy that waits much longer than any test should take.
+std::unique_ptr<PollingPolicy> SlowPollingPolicy() {
+  using Policy =
+      GenericPollingPolicy<LimitedErrorCountRetryPolicy<TestGrpcRetry>,
+                           ExponentialBackoffPolicy>;
+  return Policy(LimitedErrorCountRetryPolicy<TestGrpcRetry>(5),
+                ExponentialBackoffPolicy(std::chrono::minutes(5),
+                                         std::chrono::minutes(5), 2.0))
+      .clone();
+}
+
+Operation PendingOperation() {
+  Operation op;
+  op.set_name("test-operation");
+  return op;
+}
+
+Operation CompletedOperation(std::string const& value) {
+  google::protobuf::Value response;
+  response.set_string_value(value);
+  auto op = PendingOperation();
+  op.set_done(true);
+  op.mutable_response()->PackFrom(response);
+  return op;
+}
+
+AsyncPollLongRunningOperation PollSequence(
+    std::vector<StatusOr<Operation>> responses, int& count) {
+  return [responses, &count](CompletionQueue&,
+                             std::unique_ptr<grpc::ClientContext>,
+                             GetOperationRequest const& request) {
+    EXPECT_EQ("test-operation", request.name());
+    auto const i = static_cast<std::size_t>(count++);
+    if (i >= responses.size()) return make_ready_future(responses.back());
+    return make_ready_future(responses[i]);
+  };
+}
+
+AsyncCancelLongRunningOperation CancelNotCalled() {
+  return [](CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
+            CancelOperationRequest const&) {
+    EXPECT_TRUE(false);
+    return make_ready_future(Status{});
+  };
+}
+
+TEST(AsyncPollingLoopTest, ImmediatelyDone) {
+  AutomaticallyCreatedBackgroundThreads background;
+  int count = 0;
+  auto actual = AsyncPollingLoop(background.cq(), CompletedOperation("42"),
+                                 PollSequence({PendingOperation()}, count),
+                                 CancelNotCalled(), TestPollingPolicy(),
+                                 "test-location")
+                    .get();
+  ASSERT_STATUS_OK(actual);
+  EXPECT_TRUE(actual->done());
+  EXPECT_EQ(0, count);
+}
+
+TEST(AsyncPollingLoopTest, PollUntilDone) {
+  AutomaticallyCreatedBackgroundThreads background;
+  int count = 0;
+  auto actual =
+      AsyncAwaitLongRunningOperation<
+          PollingLoopResponseExtractor<google::protobuf::Value>>(
+          background.cq(), PendingOperation(),
+          PollSequence({PendingOperation(),
+                        Status(StatusCode::kUnavailable, "try-again"),
+                        PendingOperation(), CompletedOperation("42")},
+                       count),
+          CancelNotCalled(), TestPollingPolicy(), "test-location")
+          .get();
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ("42", actual->string_value());
+  EXPECT_EQ(4, count);
+}
+
+TEST(AsyncPollingLoopTest, OperationError) {
+  AutomaticallyCreatedBackgroundThreads background;
+  auto failed = PendingOperation();
+  failed.set_done(true);
+  failed.mutable_error()->set_code(
+      static_cast<std::int32_t>(StatusCode::kPermissionDenied));
+  failed.mutable_error()->set_message("uh-oh");
+  int count = 0;
+  auto actual =
+      AsyncAwaitLongRunningOperation<
+          PollingLoopResponseExtractor<google::protobuf::Value>>(
+          background.cq(), PendingOperation(), PollSequence({failed}, count),
+          CancelNotCalled(), TestPollingPolicy(), "test-location")
+          .get();
+  EXPECT_THAT(actual.status(),
+              StatusIs(StatusCode::kPermissionDenied, HasSubstr("uh-oh")));
+}
+
+TEST(AsyncPollingLoopTest, PermanentError) {
+  AutomaticallyCreatedBackgroundThreads background;
+  int count = 0;
+  auto actual =
+      AsyncPollingLoop(
+          background.cq(), PendingOperation(),
+          PollSequence({Status(StatusCode::kPermissionDenied, "uh-oh")}, count),
+          CancelNotCalled(), TestPollingPolicy(), "test-location")
+          .get();
+  EXPECT_THAT(actual.status(),
+              StatusIs(StatusCode::kPermissionDenied, HasSubstr("uh-oh")));
+  EXPECT_EQ(1, count);
+}
+
+TEST(AsyncPollingLoopTest, PollingPolicyExhausted) {
+  AutomaticallyCreatedBackgroundThreads background;
+  int count = 0;
+  auto actual = AsyncPollingLoop(background.cq(), PendingOperation(),
+                                 PollSequence({PendingOperation()}, count),
+                                 CancelNotCalled(), TestPollingPolicy(),
+                                 "test-location")
+                    .get();
+  EXPECT_THAT(actual.status(),
+              StatusIs(StatusCode::kDeadlineExceeded,
+                       HasSubstr("test-location")));
+  EXPECT_EQ(6, count);
+}
+
+TEST(AsyncPollingLoopTest, CancelRequestsServerCancellation) {
+  auto impl = std::make_shared<testing_util::FakeCompletionQueueImpl>();
+  CompletionQueue cq(impl);
+  auto cancelled = PendingOperation();
+  cancelled.set_done(true);
+  cancelled.mutable_error()->set_code(
+      static_cast<std::int32_t>(StatusCode::kCancelled));
+  cancelled.mutable_error()->set_message("cancelled");
+  int count = 0;
+  int cancel_count = 0;
+  auto f = AsyncPollingLoop(
+      cq, PendingOperation(), PollSequence({cancelled}, count),
+      [&cancel_count](CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
+                      CancelOperationRequest const& request) {
+        EXPECT_EQ("test-operation", request.name());
+        ++cancel_count;
+        return make_ready_future(Status{});
+      },
+      TestPollingPolicy(), "test-location");
+
+  EXPECT_EQ(1, impl->size());
+  f.cancel();
+  EXPECT_EQ(1, cancel_count);
+  // The loop continues until the service reports the operation as completed.
+  EXPECT_FALSE(f.is_ready());
+  impl->SimulateCompletion(true);
+  auto actual = f.get();
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(static_cast<std::int32_t>(StatusCode::kCancelled),
+            actual->error().code());
+  EXPECT_EQ(1, count);
+}
+
+TEST(AsyncPollingLoopTest, TimerFailure) {
+  auto impl = std::make_shared<testing_util::FakeCompletionQueueImpl>();
+  CompletionQueue cq(impl);
+  int count = 0;
+  auto f = AsyncPollingLoop(cq, PendingOperation(),
+                            PollSequence({PendingOperation()}, count),
+                            CancelNotCalled(), TestPollingPolicy(),
+                            "test-location");
+  impl->SimulateCompletion(false);
+  auto actual = f.get();
+  EXPECT_FALSE(actual.ok());
+  EXPECT_EQ(0, count);
+}
+
+/// @test Verify shutting down a group stops its loops without waiting.
+TEST(AsyncPollingLoopTest, GroupShutdownStopsPolling) {
+  auto background = absl::make_unique<AutomaticallyCreatedBackgroundThreads>();
+  AsyncPollingLoopGroup group;
+  int count = 0;
+  auto f = AsyncPollingLoop(background->cq(), PendingOperation(),
+                            PollSequence({PendingOperation()}, count),
+                            CancelNotCalled(), SlowPollingPolicy(),
+                            "test-location", &group);
+  EXPECT_EQ(std::future_status::timeout,
+            f.wait_for(std::chrono::milliseconds(10)));
+
+  group.Shutdown();
+  auto actual = f.get();
+  EXPECT_THAT(actual.status(),
+              StatusIs(StatusCode::kCancelled, HasSubstr("test-location")));
+  EXPECT_EQ(0, count);
+  // There are no pending timers, this does not block.
+  background.reset();
+}
+
+TEST(AsyncPollingLoopTest, GroupAddAfterShutdown) {
+  AutomaticallyCreatedBackgroundThreads background;
+  AsyncPollingLoopGroup group;
+  group.Shutdown();
+  int count = 0;
+  auto actual = AsyncPollingLoop(background.cq(), PendingOperation(),
+                                 PollSequence({PendingOperation()}, count),
+                                 CancelNotCalled(), SlowPollingPolicy(),
+                                 "test-location", &group)
+                    .get();
+  EXPECT_THAT(actual.status(),
+              StatusIs(StatusCode::kCancelled, HasSubstr("test-location")));
+  EXPECT_EQ(0, count);
+}
+
+/// @test Verify many operations can be awaited using a single thread.
+TEST(AsyncPollingLoopTest, ManyOperationsSingleThread) {
+  AutomaticallyCreatedBackgroundThreads background(1);
+  auto constexpr kOperations = 100;
+  std::vector<int> counts(kOperations);
+  std::vector<future<StatusOr<Operation>>> pending;
+  for (auto& c : counts) {
+    pending.push_back(AsyncPollingLoop(
+        background.cq(), PendingOperation(),
+        PollSequence({PendingOperation(), PendingOperation(),
+                      CompletedOperation("42")},
+                     c),
+        CancelNotCalled(), TestPollingPolicy(), "test-location"));
+  }
+  for (auto& f : pending) EXPECT_STATUS_OK(f.get());
+  for (auto c : counts) EXPECT_EQ(3, c);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
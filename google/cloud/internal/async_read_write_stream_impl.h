@@ -152,6 +152,35 @@ class AsyncStreamingReadWriteRpcImpl
       stream_;
 };
 
+/**
+ * An asynchronous streaming read/write RPC that fails immediately.
+ *
+ * Used where a stream cannot be created, for example, in the default
+ * implementation of generated `*Connection` classes. The failure is reported
+ * by `Finish()`, as it would be for a stream that failed to start.
+ */
+template <typename Request, typename Response>
+class AsyncStreamingReadWriteRpcError
+    : public AsyncStreamingReadWriteRpc<Request, Response> {
+ public:
+  explicit AsyncStreamingReadWriteRpcError(Status status)
+      : status_(std::move(status)) {}
+
+  void Cancel() override {}
+  future<bool> Start() override { return make_ready_future(false); }
+  future<absl::optional<Response>> Read() override {
+    return make_ready_future(absl::optional<Response>{});
+  }
+  future<bool> Write(Request const&, grpc::WriteOptions) override {
+    return make_ready_future(false);
+  }
+  future<bool> WritesDone() override { return make_ready_future(false); }
+  future<Status> Finish() override { return make_ready_future(status_); }
+
+ private:
+  Status status_;
+};
+
 template <typename Request, typename Response>
 using PrepareAsyncReadWriteRpc = absl::FunctionRef<
     std::unique_ptr<grpc::ClientAsyncReaderWriterInterface<Request, Response>>(
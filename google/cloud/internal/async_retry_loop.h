@@ -21,6 +21,7 @@
 #include "google/cloud/internal/invoke_result.h"
 #include "google/cloud/internal/retry_loop_helpers.h"
 #include "google/cloud/internal/retry_policy.h"
+#include "google/cloud/retry_budget.h"
 #include "google/cloud/version.h"
 #include "absl/meta/type_traits.h"
 #include <grpcpp/grpcpp.h>
@@ -56,7 +57,8 @@ struct FutureValueType<future<T>> {
  * we need to do is return a future satisfied immediately. And writing the
  * implementation of these stubs is very easy too.
  *
- * This class implements the retry loop for such an RPC.
+ * This class implements the retry loop for such an RPC. If a `RetryBudget` is
+ * provided, the loop only retries while the budget allows it.
  */
 template <typename Functor, typename Request>
 class AsyncRetryLoopImpl : public std::enable_shared_from_this<
@@ -65,14 +67,16 @@ class AsyncRetryLoopImpl : public std::enable_shared_from_this<
   AsyncRetryLoopImpl(std::unique_ptr<RetryPolicy> retry_policy,
                      std::unique_ptr<BackoffPolicy> backoff_policy,
                      Idempotency idempotency, google::cloud::CompletionQueue cq,
-                     Functor&& functor, Request request, char const* location)
+                     Functor&& functor, Request request, char const* location,
+                     std::shared_ptr<RetryBudget> budget)
       : retry_policy_(std::move(retry_policy)),
         backoff_policy_(std::move(backoff_policy)),
         idempotency_(idempotency),
         cq_(std::move(cq)),
         functor_(std::forward<Functor>(functor)),
         request_(std::move(request)),
-        location_(location) {}
+        location_(location),
+        budget_(std::move(budget)) {}
 
   using ReturnType = google::cloud::internal::invoke_result_t<
       Functor, google::cloud::CompletionQueue&,
@@ -112,6 +116,7 @@ class AsyncRetryLoopImpl : public std::enable_shared_from_this<
     SetIdle();
     // A successful attempt, set the value and finish the loop.
     if (result.ok()) {
+      if (budget_) budget_->OnSuccess();
       SetDone(std::move(result));
       return;
     }
@@ -131,6 +136,11 @@ class AsyncRetryLoopImpl : public std::enable_shared_from_this<
       }
       return;
     }
+    if (budget_ && !budget_->TryRetry()) {
+      SetDone(
+          RetryLoopError("Retry budget exhausted in", location_, last_status_));
+      return;
+    }
     if (Cancelled()) return;
     auto self = this->shared_from_this();
     auto op =
@@ -216,6 +226,7 @@ class AsyncRetryLoopImpl : public std::enable_shared_from_this<
   absl::decay_t<Functor> functor_;
   Request request_;
   char const* location_ = "unknown";
+  std::shared_ptr<RetryBudget> budget_;
   Status last_status_ = Status(StatusCode::kUnknown, "Retry policy exhausted");
   promise<T> result_;
   std::mutex mu_;
@@ -236,14 +247,15 @@ template <typename Functor, typename Request,
 auto AsyncRetryLoop(std::unique_ptr<RetryPolicy> retry_policy,
                     std::unique_ptr<BackoffPolicy> backoff_policy,
                     Idempotency idempotency, google::cloud::CompletionQueue cq,
-                    Functor&& functor, Request request, char const* location)
+                    Functor&& functor, Request request, char const* location,
+                    std::shared_ptr<RetryBudget> budget = {})
     -> google::cloud::internal::invoke_result_t<
         Functor, google::cloud::CompletionQueue&,
         std::unique_ptr<grpc::ClientContext>, Request const&> {
   auto loop = std::make_shared<AsyncRetryLoopImpl<Functor, Request>>(
       std::move(retry_policy), std::move(backoff_policy), idempotency,
       std::move(cq), std::forward<Functor>(functor), std::move(request),
-      location);
+      location, std::move(budget));
   return loop->Start();
 }
 
@@ -240,6 +240,39 @@ TEST(AsyncRetryLoopTest, TooManyTransientFailuresIdempotent) {
                              HasSubstr("test-location"))));
 }
 
+TEST(AsyncRetryLoopTest, RetryBudget) {
+  AutomaticallyCreatedBackgroundThreads background;
+  auto budget = std::make_shared<RetryBudget>(0.5, 1.0);
+  int counter = 0;
+  auto transient = [&](google::cloud::CompletionQueue&,
+                       std::unique_ptr<grpc::ClientContext>, int request) {
+    if (++counter % 2 == 1) {
+      return make_ready_future(
+          StatusOr<int>(Status(StatusCode::kUnavailable, "try again")));
+    }
+    return make_ready_future(StatusOr<int>(2 * request));
+  };
+  StatusOr<int> actual =
+      AsyncRetryLoop(TestRetryPolicy(), TestBackoffPolicy(),
+                     Idempotency::kIdempotent, background.cq(), transient, 42,
+                     "test-location", budget)
+          .get();
+  ASSERT_THAT(actual.status(), StatusIs(StatusCode::kOk));
+  EXPECT_EQ(1, budget->permitted_retries());
+
+  actual = AsyncRetryLoop(TestRetryPolicy(), TestBackoffPolicy(),
+                          Idempotency::kIdempotent, background.cq(), transient,
+                          42, "test-location", budget)
+               .get();
+  EXPECT_EQ(3, counter);
+  EXPECT_THAT(actual.status(),
+              StatusIs(StatusCode::kUnavailable,
+                       AllOf(HasSubstr("try again"),
+                             HasSubstr("Retry budget exhausted"),
+                             HasSubstr("test-location"))));
+  EXPECT_EQ(1, budget->throttled_retries());
+}
+
 TEST(AsyncRetryLoopTest, ExhaustedDuringBackoff) {
   using ms = std::chrono::milliseconds;
   AutomaticallyCreatedBackgroundThreads background;
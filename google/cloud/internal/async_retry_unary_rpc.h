@@ -112,6 +112,7 @@ class RetryAsyncUnaryRpc {
   static void OnCompletion(std::shared_ptr<RetryAsyncUnaryRpc> self,
                            CompletionQueue cq, StatusOr<Response> result) {
     if (result) {
+      NotifySuccess(*self->rpc_retry_policy_, 0);
       self->final_result_.set_value(std::move(result));
       return;
     }
@@ -152,6 +153,18 @@ class RetryAsyncUnaryRpc {
         });
   }
 
+  //@{
+  /// Notify the retry policies that track successful requests, e.g. to refill
+  /// a retry budget.
+  template <typename Policy>
+  static auto NotifySuccess(Policy& policy, int)
+      -> decltype(policy.OnSuccess()) {
+    return policy.OnSuccess();
+  }
+  template <typename Policy>
+  static void NotifySuccess(Policy&, long) {}  // NOLINT(google-runtime-int)
+  //@}
+
   /// Generate an error message
   Status DetailedStatus(char const* context, Status const& status) {
     std::string full_message = location_;
@@ -0,0 +1,101 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_COMPLETION_QUEUE_COROUTINES_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_COMPLETION_QUEUE_COROUTINES_H
+/**
+ * @file
+ *
+ * Integrate `google::cloud::CompletionQueue` with C++20 coroutines.
+ *
+ * Timers and asynchronous RPCs already return `future<T>`, and can be used
+ * with `co_await` (see `google/cloud/internal/future_coroutines.h`):
+ *
+ * @code
+ * future<Status> Example(CompletionQueue cq, Stream& stream) {
+ *   co_await internal::ResumeOn(cq);   // now running in `cq.Run()`
+ *   co_await cq.MakeRelativeTimer(std::chrono::milliseconds(100));
+ *   if (!co_await stream.Start()) co_return co_await stream.Finish();
+ *   while (auto response = co_await stream.Read()) Process(*response);
+ *   co_return co_await stream.Finish();
+ * }
+ * @endcode
+ *
+ * where `Stream` is an `AsyncStreamingReadWriteRpc<Request, Response>`.
+ *
+ * This file defines nothing for older compilers, or C++ versions before C++20.
+ */
+
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/future.h"
+#include "google/cloud/version.h"
+#if GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+#include <coroutine>
+#include <utility>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/// The awaiter returned by `ResumeOn()`.
+class CompletionQueueAwaiter {
+ public:
+  explicit CompletionQueueAwaiter(CompletionQueue cq) : cq_(std::move(cq)) {}
+
+  bool await_ready() const { return false; }
+  void await_suspend(std::coroutine_handle<> h) { cq_.RunAsync(Resume(h)); }
+  void await_resume() {}
+
+ private:
+  // Resumes the coroutine. If the completion queue is shutdown before the
+  // coroutine resumes, the coroutine is destroyed instead of leaked. If the
+  // coroutine returns a `future<T>` the future is satisfied with an exception.
+  class Resume {
+   public:
+    explicit Resume(std::coroutine_handle<> h) : h_(h) {}
+    Resume(Resume&& rhs) noexcept : h_(std::exchange(rhs.h_, {})) {}
+    Resume& operator=(Resume&&) = delete;
+    ~Resume() {
+      if (h_) h_.destroy();
+    }
+
+    void operator()() { std::exchange(h_, {}).resume(); }
+
+   private:
+    std::coroutine_handle<> h_;
+  };
+
+  CompletionQueue cq_;
+};
+
+/**
+ * Suspend the coroutine and resume it in a thread running `cq.Run()`.
+ *
+ * This is the coroutine equivalent of `cq.RunAsync()`, use it to move work out
+ * of the current thread, for example, to start many coroutines without waiting
+ * for each one to reach its first suspension point.
+ */
+inline CompletionQueueAwaiter ResumeOn(CompletionQueue cq) {
+  return CompletionQueueAwaiter(std::move(cq));
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_COMPLETION_QUEUE_COROUTINES_H
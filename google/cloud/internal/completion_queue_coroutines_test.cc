@@ -0,0 +1,135 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/completion_queue_coroutines.h"
+#include "google/cloud/internal/async_read_write_stream_impl.h"
+#include "google/cloud/testing_util/expect_future_error.h"
+#include "absl/types/optional.h"
+#include <gmock/gmock.h>
+#include <chrono>
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+#if GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+
+using ::testing::ElementsAre;
+
+future<std::thread::id> RunningThread(CompletionQueue cq) {
+  co_await ResumeOn(cq);
+  co_return std::this_thread::get_id();
+}
+
+TEST(CompletionQueueCoroutinesTest, ResumeOn) {
+  CompletionQueue cq;
+  std::thread runner([&cq] { cq.Run(); });
+  EXPECT_EQ(runner.get_id(), RunningThread(cq).get());
+  cq.Shutdown();
+  runner.join();
+}
+
+TEST(CompletionQueueCoroutinesTest, ResumeOnShutdown) {
+  CompletionQueue cq;
+  cq.Shutdown();
+  auto f = RunningThread(cq);
+  cq.Run();
+  // The coroutine is destroyed, abandoning the promise for its result.
+  testing_util::ExpectFutureError([&] { f.get(); },
+                                  std::future_errc::broken_promise);
+}
+
+/// @test Verify many coroutines can wait on timers, using a single thread.
+TEST(CompletionQueueCoroutinesTest, FanOutTimers) {
+  CompletionQueue cq;
+  std::thread runner([&cq] { cq.Run(); });
+
+  auto sleeper = [](CompletionQueue cq, int i) -> future<int> {
+    co_await ResumeOn(cq);
+    auto timer = co_await cq.MakeRelativeTimer(std::chrono::milliseconds(i));
+    co_return timer.ok() ? i : -1;
+  };
+  auto fan_in = [](std::vector<future<int>> values) -> future<int> {
+    int total = 0;
+    for (auto& v : values) total += co_await std::move(v);
+    co_return total;
+  };
+
+  std::vector<future<int>> results;
+  for (int i = 0; i != 100; ++i) results.push_back(sleeper(cq, i % 10));
+  EXPECT_EQ(450, fan_in(std::move(results)).get());
+
+  cq.Shutdown();
+  runner.join();
+}
+
+/// A simple streaming RPC, returning each value, and then a successful status.
+class FakeStream : public AsyncStreamingReadWriteRpc<std::string, std::string> {
+ public:
+  explicit FakeStream(std::deque<std::string> responses)
+      : responses_(std::move(responses)) {}
+
+  void Cancel() override {}
+  future<bool> Start() override { return make_ready_future(true); }
+  future<absl::optional<std::string>> Read() override {
+    if (responses_.empty()) {
+      return make_ready_future(absl::optional<std::string>{});
+    }
+    auto r = std::move(responses_.front());
+    responses_.pop_front();
+    return make_ready_future(absl::make_optional(std::move(r)));
+  }
+  future<bool> Write(std::string const&, grpc::WriteOptions) override {
+    return make_ready_future(true);
+  }
+  future<bool> WritesDone() override { return make_ready_future(true); }
+  future<Status> Finish() override { return make_ready_future(Status{}); }
+
+ private:
+  std::deque<std::string> responses_;
+};
+
+TEST(CompletionQueueCoroutinesTest, StreamingRead) {
+  auto read_all = [](FakeStream& stream,
+                     std::vector<std::string>& values) -> future<Status> {
+    if (!co_await stream.Start()) co_return co_await stream.Finish();
+    while (auto r = co_await stream.Read()) values.push_back(*std::move(r));
+    co_return co_await stream.Finish();
+  };
+
+  FakeStream stream({"a", "b", "c"});
+  std::vector<std::string> values;
+  EXPECT_TRUE(read_all(stream, values).get().ok());
+  EXPECT_THAT(values, ElementsAre("a", "b", "c"));
+}
+
+#else
+
+TEST(CompletionQueueCoroutinesTest, Disabled) {
+  GTEST_SKIP() << "coroutines are not supported by this compiler";
+}
+
+#endif  // GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
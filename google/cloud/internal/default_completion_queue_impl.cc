@@ -15,7 +15,9 @@
 #include "google/cloud/internal/default_completion_queue_impl.h"
 #include "google/cloud/internal/throw_delegate.h"
 #include "absl/memory/memory.h"
+#include <grpc/support/time.h>
 #include <grpcpp/alarm.h>
+#include <algorithm>
 #include <sstream>
 
 // There is no way to unblock the gRPC event loop, not even calling Shutdown(),
@@ -23,6 +25,11 @@
 // shutdown the run.
 std::chrono::milliseconds constexpr kLoopTimeout(50);
 
+// The maximum number of `RunAsync()` functions executed on each wakeup. Small
+// enough to share a burst of functions among the threads running the event
+// loop, large enough to amortize the cost of the alarm.
+std::size_t constexpr kRunAsyncBatchSize = 16;
+
 namespace google {
 namespace cloud {
 inline namespace GOOGLE_CLOUD_CPP_NS {
@@ -30,88 +37,159 @@ namespace internal {
 
 namespace {
 
+using TimerValueType = StatusOr<std::chrono::system_clock::time_point>;
+
+// The timer wheel ticks are milliseconds since the epoch. Timers expire on the
+// first tick at or after their deadline.
+std::int64_t DeadlineTick(std::chrono::system_clock::time_point deadline) {
+  auto const d = deadline.time_since_epoch();
+  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(d);
+  if (ms < d) ms += std::chrono::milliseconds(1);
+  return ms.count();
+}
+
+std::int64_t NowTick() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+std::chrono::system_clock::time_point TickTime(std::int64_t tick) {
+  return std::chrono::system_clock::time_point(
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          std::chrono::milliseconds(tick)));
+}
+
+}  // namespace
+
 /**
- * Wrap a gRPC timer into an `AsyncOperation`.
- *
- * Applications (or more likely, other components in the client library) will
- * associate timers with a completion queue. gRPC timers require applications
- * to create a unique `grpc::Alarm` object for each timer, and then to
- * associate them with the completion queue using a `void*` tag.
+ * A timer created by `MakeDeadlineTimer()`.
  *
- * This class collaborates with our wrapper for `CompletionQueue` to associate
- * a `future<AsyncTimerResult>` for each timer. This class takes care of
- * allocating the `grpc::Alarm`, creating a unique `void*` associated with the
- * timer, and satisfying the future when the timer expires.
+ * This class collaborates with `DefaultCompletionQueueImpl` to satisfy a
+ * `future<>` when the timer expires. Timers are usually stored in the
+ * completion queue's timer wheel, which owns them (via `self`) until they
+ * expire or are canceled. Timers can also use their own `grpc::Alarm`, in
+ * which case they are registered as a pending operation.
  *
- * Note that this class is an implementation detail, hidden from the
- * application developers.
+ * The `self`, `alarm`, and `canceled` members are guarded by the completion
+ * queue's `timer_mu_`.
  */
-class AsyncTimerFuture : public internal::AsyncGrpcOperation {
+class WheelTimer : public AsyncGrpcOperation, public TimerWheelNode {
  public:
-  using ValueType = StatusOr<std::chrono::system_clock::time_point>;
-
   // We need to create the shared_ptr before completing the initialization, so
   // use a factory member function.
-  static std::pair<std::shared_ptr<AsyncTimerFuture>, future<ValueType>>
-  Create() {
-    auto self = std::shared_ptr<AsyncTimerFuture>(new AsyncTimerFuture);
-    auto weak = std::weak_ptr<AsyncTimerFuture>(self);
-    self->promise_ = promise<AsyncTimerFuture::ValueType>([weak] {
+  static std::pair<std::shared_ptr<WheelTimer>, future<TimerValueType>> Create(
+      std::weak_ptr<DefaultCompletionQueueImpl> impl,
+      std::chrono::system_clock::time_point deadline) {
+    auto self = std::shared_ptr<WheelTimer>(
+        new WheelTimer(std::move(impl), deadline));
+    auto weak = std::weak_ptr<WheelTimer>(self);
+    self->promise_ = promise<TimerValueType>([weak] {
       if (auto self = weak.lock()) self->Cancel();
     });
     return {self, self->promise_.get_future()};
   }
 
-  void Set(grpc::CompletionQueue& cq,
-           std::chrono::system_clock::time_point deadline, void* tag) {
-    deadline_ = deadline;
-    alarm_.Set(&cq, deadline, tag);
+  std::chrono::system_clock::time_point deadline() const { return deadline_; }
+
+  void Cancel() override {
+    if (auto impl = impl_.lock()) impl->CancelTimer(*this);
   }
 
-  void Cancel() override { alarm_.Cancel(); }
+  void Expire(bool ok) {
+    promise_.set_value(ok ? TimerValueType(deadline_) : Canceled());
+  }
+
+  std::shared_ptr<WheelTimer> self;
+  std::unique_ptr<grpc::Alarm> alarm;
+  bool canceled = false;
 
  private:
-  explicit AsyncTimerFuture() : promise_(null_promise_t{}) {}
+  WheelTimer(std::weak_ptr<DefaultCompletionQueueImpl> impl,
+             std::chrono::system_clock::time_point deadline)
+      : impl_(std::move(impl)),
+        deadline_(deadline),
+        promise_(null_promise_t{}) {}
 
   bool Notify(bool ok) override {
-    promise_.set_value(ok ? ValueType(deadline_) : Canceled());
+    Expire(ok);
     return true;
   }
 
-  static ValueType Canceled() {
+  static TimerValueType Canceled() {
     return Status{StatusCode::kCancelled, "timer canceled"};
   }
 
-  promise<ValueType> promise_;
+  std::weak_ptr<DefaultCompletionQueueImpl> impl_;
   std::chrono::system_clock::time_point deadline_;
+  promise<TimerValueType> promise_;
+};
+
+/// Wakes up the event loop when the next timer in the timer wheel expires.
+class TimerWheelAlarm : public AsyncGrpcOperation {
+ public:
+  explicit TimerWheelAlarm(DefaultCompletionQueueImpl* impl) : impl_(impl) {}
+
+  void Set(grpc::CompletionQueue& cq,
+           std::chrono::system_clock::time_point deadline) {
+    AsyncGrpcOperation* tag = this;
+    alarm_.Set(&cq, deadline, tag);
+  }
+
+  void Cancel() override { alarm_.Cancel(); }
+
+ private:
+  bool Notify(bool) override {
+    impl_->OnTimerWheelAlarm();
+    return false;
+  }
+
+  DefaultCompletionQueueImpl* impl_;
   grpc::Alarm alarm_;
 };
 
-class AsyncFunction : public internal::AsyncGrpcOperation {
+/**
+ * Wakes up the event loop to run the functions queued by `RunAsync()`.
+ *
+ * These objects are pooled by `DefaultCompletionQueueImpl`. They are not
+ * registered as pending operations, so they are never released by the event
+ * loop, and they can be rearmed as soon as they fire.
+ */
+class RunAsyncWakeup : public AsyncGrpcOperation {
  public:
-  explicit AsyncFunction(std::unique_ptr<internal::RunAsyncBase> fun)
-      : fun_(std::move(fun)), alarm_(absl::make_unique<grpc::Alarm>()) {}
+  explicit RunAsyncWakeup(DefaultCompletionQueueImpl* impl) : impl_(impl) {}
 
-  void Set(grpc::CompletionQueue& cq, void* tag) {
-    alarm_->Set(&cq, std::chrono::system_clock::now(), tag);
+  void Set(grpc::CompletionQueue& cq) {
+    // A deadline in the past fires immediately, `now()` would be rounded up to
+    // the timer granularity (typically 1ms).
+    AsyncGrpcOperation* tag = this;
+    alarm_.Set(&cq, gpr_inf_past(GPR_CLOCK_MONOTONIC), tag);
   }
 
   void Cancel() override {}
 
  private:
   bool Notify(bool ok) override {
-    auto f = std::move(fun_);
-    alarm_.reset();
-    if (!ok) return true;  // do not run async operations on shutdown CQs
-    f->exec();
-    return true;
+    impl_->DrainRunAsync(this, ok);
+    return false;
   }
 
-  std::unique_ptr<internal::RunAsyncBase> fun_;
-  std::unique_ptr<grpc::Alarm> alarm_;
+  DefaultCompletionQueueImpl* impl_;
+  grpc::Alarm alarm_;
 };
 
-}  // namespace
+DefaultCompletionQueueImpl::DefaultCompletionQueueImpl()
+    : DefaultCompletionQueueImpl(/*use_timer_wheel=*/true) {}
+
+DefaultCompletionQueueImpl::DefaultCompletionQueueImpl(bool use_timer_wheel)
+    : use_timer_wheel_(use_timer_wheel),
+      timer_wheel_(NowTick()),
+      timer_wheel_alarm_(absl::make_unique<TimerWheelAlarm>(this)) {}
+
+DefaultCompletionQueueImpl::~DefaultCompletionQueueImpl() {
+  // Break the ownership cycles for any timers left in the wheel.
+  ClearTimerWheel();
+}
 
 void DefaultCompletionQueueImpl::Run() {
   void* tag;
@@ -119,6 +197,10 @@ void DefaultCompletionQueueImpl::Run() {
   auto deadline = [] {
     return std::chrono::system_clock::now() + kLoopTimeout;
   };
+  {
+    std::lock_guard<std::mutex> lk(run_async_mu_);
+    ++run_threads_;
+  }
 
   for (auto status = cq_.AsyncNext(&tag, &ok, deadline());
        status != grpc::CompletionQueue::SHUTDOWN;
@@ -128,14 +210,37 @@ void DefaultCompletionQueueImpl::Run() {
       google::cloud::internal::ThrowRuntimeError(
           "unexpected status from AsyncNext()");
     }
-    auto op = FindOperation(tag);
+    // The tags are always the address of the operation, see StartOperation().
+    // The operation remains registered, and therefore alive, until it is
+    // completed.
+    auto* op = static_cast<AsyncGrpcOperation*>(tag);
     if (op->Notify(ok)) {
       ForgetOperation(tag);
     }
   }
+  std::lock_guard<std::mutex> lk(run_async_mu_);
+  --run_threads_;
 }
 
 void DefaultCompletionQueueImpl::Shutdown() {
+  {
+    // No wakeups are armed after this point, setting an alarm on a shutdown
+    // `grpc::CompletionQueue` is an error.
+    std::lock_guard<std::mutex> lk(run_async_mu_);
+    run_async_shutdown_ = true;
+  }
+  std::vector<std::shared_ptr<WheelTimer>> timers;
+  {
+    std::lock_guard<std::mutex> lk(timer_mu_);
+    timers_shutdown_ = true;
+    if (timer_wheel_alarm_armed_ && !timer_wheel_alarm_canceled_) {
+      timer_wheel_alarm_canceled_ = true;
+      timer_wheel_alarm_->Cancel();
+    }
+  }
+  // Timers still run to completion after `Shutdown()`, but the timer wheel
+  // alarm cannot be rearmed, so each timer gets its own alarm.
+  for (auto& t : ClearTimerWheel()) StartTimerAlarm(std::move(t));
   {
     std::lock_guard<std::mutex> lk(mu_);
     shutdown_ = true;
@@ -144,6 +249,8 @@ void DefaultCompletionQueueImpl::Shutdown() {
 }
 
 void DefaultCompletionQueueImpl::CancelAll() {
+  for (auto& t : ClearTimerWheel()) t->Expire(/*ok=*/false);
+
   // Cancel all operations. We need to make a copy of the operations because
   // canceling them may trigger a recursive call that needs the lock. And we
   // need the lock because canceling might trigger calls that invalidate the
@@ -160,9 +267,9 @@ void DefaultCompletionQueueImpl::CancelAll() {
 future<StatusOr<std::chrono::system_clock::time_point>>
 DefaultCompletionQueueImpl::MakeDeadlineTimer(
     std::chrono::system_clock::time_point deadline) {
-  auto p = AsyncTimerFuture::Create();
-  auto op = std::move(p.first);
-  StartOperation(op, [&](void* tag) { op->Set(cq(), deadline, tag); });
+  auto p = WheelTimer::Create(shared_from_this(), deadline);
+  if (use_timer_wheel_ && AddToTimerWheel(p.first)) return std::move(p.second);
+  StartTimerAlarm(std::move(p.first));
   return std::move(p.second);
 }
 
@@ -176,8 +283,14 @@ DefaultCompletionQueueImpl::MakeRelativeTimer(
 
 void DefaultCompletionQueueImpl::RunAsync(
     std::unique_ptr<internal::RunAsyncBase> function) {
-  auto op = std::make_shared<AsyncFunction>(std::move(function));
-  StartOperation(op, [&](void* tag) { op->Set(cq(), tag); });
+  std::unique_lock<std::mutex> lk(run_async_mu_);
+  if (run_async_shutdown_) {
+    lk.unlock();
+    function.reset();  // do not run async operations on shutdown CQs
+    return;
+  }
+  run_async_queue_.push_back(std::move(function));
+  ArmRunAsyncWakeup();
 }
 
 void DefaultCompletionQueueImpl::StartOperation(
@@ -205,17 +318,6 @@ void DefaultCompletionQueueImpl::StartOperation(
 
 grpc::CompletionQueue& DefaultCompletionQueueImpl::cq() { return cq_; }
 
-std::shared_ptr<AsyncGrpcOperation> DefaultCompletionQueueImpl::FindOperation(
-    void* tag) {
-  std::lock_guard<std::mutex> lk(mu_);
-  auto loc = pending_ops_.find(tag);
-  if (pending_ops_.end() == loc) {
-    google::cloud::internal::ThrowRuntimeError(
-        "assertion failure: searching for async op tag");
-  }
-  return loc->second;
-}
-
 void DefaultCompletionQueueImpl::ForgetOperation(void* tag) {
   std::lock_guard<std::mutex> lk(mu_);
   auto const num_erased = pending_ops_.erase(tag);
@@ -226,6 +328,125 @@ void DefaultCompletionQueueImpl::ForgetOperation(void* tag) {
   }
 }
 
+void DefaultCompletionQueueImpl::ArmRunAsyncWakeup() {
+  // Use at most one wakeup per thread running the event loop, and only if
+  // there is enough work for all of them.
+  auto const active = wakeups_.size() - idle_wakeups_.size();
+  auto const max_active =
+      static_cast<std::size_t>((std::max)(1, run_threads_));
+  if (active >= max_active || run_async_queue_.size() <= active) return;
+  RunAsyncWakeup* wakeup;
+  if (idle_wakeups_.empty()) {
+    wakeups_.push_back(absl::make_unique<RunAsyncWakeup>(this));
+    wakeup = wakeups_.back().get();
+  } else {
+    wakeup = idle_wakeups_.back();
+    idle_wakeups_.pop_back();
+  }
+  wakeup->Set(cq_);
+}
+
+void DefaultCompletionQueueImpl::DrainRunAsync(RunAsyncWakeup* wakeup,
+                                               bool ok) {
+  std::unique_lock<std::mutex> lk(run_async_mu_);
+  // After shutdown the wakeup cannot be rearmed, so it takes all the functions.
+  auto const drain_all = !ok || run_async_shutdown_;
+  auto const n = drain_all ? run_async_queue_.size()
+                           : (std::min)(kRunAsyncBatchSize,
+                                        run_async_queue_.size());
+  auto const end = std::next(run_async_queue_.begin(),
+                             static_cast<std::ptrdiff_t>(n));
+  std::vector<std::unique_ptr<RunAsyncBase>> batch(
+      std::make_move_iterator(run_async_queue_.begin()),
+      std::make_move_iterator(end));
+  run_async_queue_.erase(run_async_queue_.begin(), end);
+  if (run_async_queue_.empty() || drain_all) {
+    idle_wakeups_.push_back(wakeup);
+  } else {
+    wakeup->Set(cq_);
+    ArmRunAsyncWakeup();
+  }
+  // The functions may call RunAsync(), and so may their destructors.
+  lk.unlock();
+  if (!ok) return;  // do not run async operations on shutdown CQs
+  for (auto& f : batch) f->exec();
+}
+
+bool DefaultCompletionQueueImpl::AddToTimerWheel(
+    std::shared_ptr<WheelTimer> const& timer) {
+  std::lock_guard<std::mutex> lk(timer_mu_);
+  if (timers_shutdown_) return false;
+  timer_wheel_.Insert(timer.get(), DeadlineTick(timer->deadline()));
+  timer->self = timer;
+  ArmTimerWheelAlarm();
+  return true;
+}
+
+void DefaultCompletionQueueImpl::StartTimerAlarm(
+    std::shared_ptr<WheelTimer> timer) {
+  auto* t = timer.get();
+  StartOperation(std::move(timer), [this, t](void* tag) {
+    std::lock_guard<std::mutex> lk(timer_mu_);
+    t->alarm = absl::make_unique<grpc::Alarm>();
+    t->alarm->Set(&cq_, t->deadline(), tag);
+    // The timer may have been canceled while it was moving out of the wheel.
+    if (t->canceled) t->alarm->Cancel();
+  });
+}
+
+void DefaultCompletionQueueImpl::CancelTimer(WheelTimer& timer) {
+  std::unique_lock<std::mutex> lk(timer_mu_);
+  if (timer_wheel_.Remove(&timer)) {
+    auto self = std::move(timer.self);
+    lk.unlock();
+    self->Expire(/*ok=*/false);
+    return;
+  }
+  timer.canceled = true;
+  if (timer.alarm) timer.alarm->Cancel();
+}
+
+std::vector<std::shared_ptr<WheelTimer>>
+DefaultCompletionQueueImpl::ClearTimerWheel() {
+  std::vector<std::shared_ptr<WheelTimer>> timers;
+  std::lock_guard<std::mutex> lk(timer_mu_);
+  for (auto* node : timer_wheel_.Clear()) {
+    timers.push_back(std::move(static_cast<WheelTimer*>(node)->self));
+  }
+  return timers;
+}
+
+void DefaultCompletionQueueImpl::ArmTimerWheelAlarm() {
+  if (timers_shutdown_ || timer_wheel_.empty()) return;
+  auto const tick = timer_wheel_.NextEventTick();
+  if (timer_wheel_alarm_armed_) {
+    // A pending `grpc::Alarm` cannot be set again, cancel it and set it once
+    // the cancellation is delivered, in OnTimerWheelAlarm().
+    if (tick < timer_wheel_alarm_tick_ && !timer_wheel_alarm_canceled_) {
+      timer_wheel_alarm_canceled_ = true;
+      timer_wheel_alarm_->Cancel();
+    }
+    return;
+  }
+  timer_wheel_alarm_armed_ = true;
+  timer_wheel_alarm_canceled_ = false;
+  timer_wheel_alarm_tick_ = tick;
+  timer_wheel_alarm_->Set(cq_, TickTime(tick));
+}
+
+void DefaultCompletionQueueImpl::OnTimerWheelAlarm() {
+  std::vector<std::shared_ptr<WheelTimer>> expired;
+  {
+    std::lock_guard<std::mutex> lk(timer_mu_);
+    timer_wheel_alarm_armed_ = false;
+    for (auto* node : timer_wheel_.Advance(NowTick())) {
+      expired.push_back(std::move(static_cast<WheelTimer*>(node)->self));
+    }
+    ArmTimerWheelAlarm();
+  }
+  for (auto& t : expired) t->Expire(/*ok=*/true);
+}
+
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
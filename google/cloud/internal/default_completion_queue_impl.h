@@ -16,21 +16,57 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_DEFAULT_COMPLETION_QUEUE_IMPL_H
 
 #include "google/cloud/internal/completion_queue_impl.h"
+#include "google/cloud/internal/timer_wheel.h"
 #include "google/cloud/version.h"
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace google {
 namespace cloud {
 inline namespace GOOGLE_CLOUD_CPP_NS {
 namespace internal {
 
+class RunAsyncWakeup;
+class TimerWheelAlarm;
+class WheelTimer;
+
 /**
  * The default implementation for `CompletionQueue`.
+ *
+ * The tag for each operation is the address of the `AsyncGrpcOperation`, so
+ * the event loop does not need to search for the operation when it completes.
+ * The pending operations are still kept in a map, this map owns the operations
+ * and is used to cancel them.
+ *
+ * Functions scheduled via `RunAsync()` do not create a new operation or a new
+ * `grpc::Alarm`. They are queued, and a small pool of alarms (at most one per
+ * thread calling `Run()`) wakes up the event loop to drain the queue in
+ * batches.
+ *
+ * Timers are stored in a `TimerWheel` with millisecond ticks, and a single
+ * `grpc::Alarm` wakes up the event loop when the next timer expires. Creating
+ * or canceling a timer does not register an operation with gRPC. On shutdown
+ * the pending timers move to their own `grpc::Alarm`, so they still expire at
+ * their deadline.
  */
-class DefaultCompletionQueueImpl : public CompletionQueueImpl {
+class DefaultCompletionQueueImpl
+    : public CompletionQueueImpl,
+      public std::enable_shared_from_this<DefaultCompletionQueueImpl> {
  public:
-  DefaultCompletionQueueImpl() = default;
-  ~DefaultCompletionQueueImpl() override = default;
+  DefaultCompletionQueueImpl();
+
+  /**
+   * Create a completion queue that optionally disables the timer wheel.
+   *
+   * Without the timer wheel each timer uses its own `grpc::Alarm`. This is
+   * only intended for benchmarks and tests.
+   */
+  explicit DefaultCompletionQueueImpl(bool use_timer_wheel);
+
+  ~DefaultCompletionQueueImpl() override;
 
   /// Run the event loop until Shutdown() is called.
   void Run() override;
@@ -60,17 +96,61 @@ class DefaultCompletionQueueImpl : public CompletionQueueImpl {
   grpc::CompletionQueue& cq() override;
 
  private:
-  /// Return the asynchronous operation associated with @p tag.
-  std::shared_ptr<AsyncGrpcOperation> FindOperation(void* tag);
+  friend class RunAsyncWakeup;
+  friend class TimerWheelAlarm;
+  friend class WheelTimer;
 
   /// Unregister @p tag from pending operations.
   void ForgetOperation(void* tag);
 
+  /// Arm an idle wakeup, or create a new one, if the queue needs it.
+  void ArmRunAsyncWakeup();  // REQUIRES(run_async_mu_)
+
+  /// Run (or discard) a batch of functions queued by `RunAsync()`.
+  void DrainRunAsync(RunAsyncWakeup* wakeup, bool ok);
+
+  /// Add @p timer to the timer wheel, returns false after shutdown.
+  bool AddToTimerWheel(std::shared_ptr<WheelTimer> const& timer);
+
+  /// Start a `grpc::Alarm` for @p timer, bypassing the timer wheel.
+  void StartTimerAlarm(std::shared_ptr<WheelTimer> timer);
+
+  /// Cancel @p timer, whether it is in the wheel or has its own alarm.
+  void CancelTimer(WheelTimer& timer);
+
+  /// Remove all the timers from the wheel.
+  std::vector<std::shared_ptr<WheelTimer>> ClearTimerWheel();
+
+  /// Arm the timer wheel alarm for the next event in the wheel.
+  void ArmTimerWheelAlarm();  // REQUIRES(timer_mu_)
+
+  /// Expire the timers when the timer wheel alarm fires.
+  void OnTimerWheelAlarm();
+
   grpc::CompletionQueue cq_;
   mutable std::mutex mu_;
   bool shutdown_{false};  // GUARDED_BY(mu_)
   std::unordered_map<void*, std::shared_ptr<AsyncGrpcOperation>>
       pending_ops_;  // GUARDED_BY(mu_)
+
+  std::mutex run_async_mu_;
+  bool run_async_shutdown_ = false;  // GUARDED_BY(run_async_mu_)
+  int run_threads_ = 0;              // GUARDED_BY(run_async_mu_)
+  std::deque<std::unique_ptr<RunAsyncBase>>
+      run_async_queue_;  // GUARDED_BY(run_async_mu_)
+  std::vector<std::unique_ptr<RunAsyncWakeup>>
+      wakeups_;  // GUARDED_BY(run_async_mu_)
+  std::vector<RunAsyncWakeup*> idle_wakeups_;  // GUARDED_BY(run_async_mu_)
+
+  // If both mutexes are needed `mu_` must be locked first.
+  bool const use_timer_wheel_;
+  std::mutex timer_mu_;
+  bool timers_shutdown_ = false;             // GUARDED_BY(timer_mu_)
+  TimerWheel timer_wheel_;                   // GUARDED_BY(timer_mu_)
+  bool timer_wheel_alarm_armed_ = false;     // GUARDED_BY(timer_mu_)
+  bool timer_wheel_alarm_canceled_ = false;  // GUARDED_BY(timer_mu_)
+  std::int64_t timer_wheel_alarm_tick_ = 0;  // GUARDED_BY(timer_mu_)
+  std::unique_ptr<TimerWheelAlarm> timer_wheel_alarm_;
 };
 
 }  // namespace internal
@@ -22,6 +22,8 @@
 
 #include "google/cloud/internal/future_impl.h"
 #include "google/cloud/version.h"
+#include <functional>
+#include <memory>
 
 namespace google {
 namespace cloud {
@@ -158,10 +160,20 @@ class promise_base {  // NOLINT(readability-identifier-naming)
   /// Initialize the common components to a null state.
   explicit promise_base(null_promise_t) {}
 
+  /// Initialize the common components of a promise, without cancellation.
+  promise_base() : shared_state_(std::make_shared<shared_state_type>()) {}
+
   /// Initialize the common components of a promise
   explicit promise_base(std::function<void()> cancellation_callback)
-      : shared_state_(
-            std::make_shared<shared_state_type>(cancellation_callback)) {}
+      : shared_state_(std::make_shared<shared_state_type>(
+            std::move(cancellation_callback))) {}
+
+  /// Initialize the common components, allocating the shared state with @p a.
+  template <typename Alloc>
+  promise_base(std::allocator_arg_t, Alloc const& a,
+               std::function<void()> cancellation_callback)
+      : shared_state_(std::allocate_shared<shared_state_type>(
+            a, std::move(cancellation_callback))) {}
   promise_base(promise_base&&) noexcept = default;
 
   ~promise_base() {
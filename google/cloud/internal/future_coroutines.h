@@ -0,0 +1,149 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_FUTURE_COROUTINES_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_FUTURE_COROUTINES_H
+/**
+ * @file
+ *
+ * Integrate `google::cloud::future<T>` with C++20 coroutines.
+ *
+ * When the compiler supports coroutines (see
+ * `GOOGLE_CLOUD_CPP_HAVE_COROUTINES`) applications can:
+ *
+ * - `co_await` a `future<T>`, the coroutine is suspended until the future is
+ *   satisfied, and resumes in the thread that satisfies the future. For
+ *   futures returned by the library that is typically a thread running
+ *   `CompletionQueue::Run()`.
+ * - Use `future<T>` as the return type of a coroutine, the `co_return`
+ *   statement satisfies the future.
+ *
+ * @code
+ * future<int> Sum(CompletionQueue cq, std::vector<future<int>> values) {
+ *   int sum = 0;
+ *   for (auto& v : values) sum += co_await std::move(v);
+ *   co_await cq.MakeRelativeTimer(std::chrono::milliseconds(10));
+ *   co_return sum;
+ * }
+ * @endcode
+ *
+ * This file defines nothing for older compilers, or C++ versions before C++20.
+ */
+
+#include "google/cloud/internal/future_then_impl.h"
+#include "google/cloud/terminate_handler.h"
+#include "google/cloud/version.h"
+#if GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * The awaiter for `co_await f`, where `f` is a `future<T>`.
+ *
+ * The coroutine is suspended only if the future is not satisfied, in that
+ * case it is resumed by a continuation attached to the future. Like any other
+ * continuation, it does not run if the promise is abandoned.
+ */
+template <typename T>
+class FutureAwaiter {
+ public:
+  explicit FutureAwaiter(future<T> f) : future_(std::move(f)) {}
+
+  bool await_ready() const { return future_.is_ready(); }
+
+  bool await_suspend(std::coroutine_handle<> h) {
+    // The continuation may run before `.then()` returns, if the future is
+    // satisfied by some other thread. In that case the coroutine is not
+    // suspended at all. Otherwise the continuation resumes the coroutine. The
+    // `suspended_` flag tells each side which case applies.
+    auto pending = std::move(future_);
+    (void)pending.then([this, h](future<T> f) {
+      future_ = std::move(f);
+      if (suspended_.exchange(true)) h.resume();
+    });
+    return !suspended_.exchange(true);
+  }
+
+  T await_resume() { return future_.get(); }
+
+ private:
+  future<T> future_;
+  std::atomic<bool> suspended_{false};
+};
+
+/// Satisfies the `promise<T>` when a coroutine returning `future<T>` ends.
+template <typename T>
+class FutureCoroutinePromiseBase {
+ public:
+  future<T> get_return_object() { return promise_.get_future(); }
+
+  // The coroutine starts running immediately, as the functions returning
+  // `future<T>` typically do, and its frame is released when it completes.
+  std::suspend_never initial_suspend() noexcept { return {}; }
+  std::suspend_never final_suspend() noexcept { return {}; }
+
+  void unhandled_exception() {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    promise_.set_exception(std::current_exception());
+#else
+    google::cloud::Terminate("unhandled exception in coroutine");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  }
+
+ protected:
+  promise<T> promise_;
+};
+
+template <typename T>
+class FutureCoroutinePromise : public FutureCoroutinePromiseBase<T> {
+ public:
+  void return_value(T value) { this->promise_.set_value(std::move(value)); }
+};
+
+template <>
+class FutureCoroutinePromise<void> : public FutureCoroutinePromiseBase<void> {
+ public:
+  void return_void() { this->promise_.set_value(); }
+};
+
+}  // namespace internal
+
+/// Suspend the coroutine until @p f is satisfied.
+template <typename T>
+internal::FutureAwaiter<T> operator co_await(future<T>&& f) {
+  return internal::FutureAwaiter<T>(std::move(f));
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+namespace std {
+/// Functions returning `future<T>` can be coroutines.
+template <typename T, typename... Args>
+struct coroutine_traits<google::cloud::future<T>, Args...> {
+  using promise_type = google::cloud::internal::FutureCoroutinePromise<T>;
+};
+}  // namespace std
+
+#endif  // GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_FUTURE_COROUTINES_H
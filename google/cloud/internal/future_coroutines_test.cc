@@ -0,0 +1,129 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/future_coroutines.h"
+#include "google/cloud/future.h"
+#include <gmock/gmock.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+#if GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+
+using ::testing::HasSubstr;
+
+future<int> Twice(future<int> f) { co_return 2 * co_await std::move(f); }
+
+future<void> Wait(future<void> f, bool& done) {
+  co_await std::move(f);
+  done = true;
+}
+
+TEST(FutureCoroutinesTest, AwaitSatisfied) {
+  promise<int> p;
+  p.set_value(21);
+  auto f = Twice(p.get_future());
+  ASSERT_TRUE(f.is_ready());
+  EXPECT_EQ(42, f.get());
+}
+
+TEST(FutureCoroutinesTest, AwaitPending) {
+  promise<int> p;
+  auto f = Twice(p.get_future());
+  EXPECT_FALSE(f.is_ready());
+  p.set_value(21);
+  ASSERT_TRUE(f.is_ready());
+  EXPECT_EQ(42, f.get());
+}
+
+TEST(FutureCoroutinesTest, AwaitVoid) {
+  promise<void> p;
+  bool done = false;
+  auto f = Wait(p.get_future(), done);
+  EXPECT_FALSE(done);
+  p.set_value();
+  EXPECT_TRUE(done);
+  f.get();
+}
+
+/// @test Verify the coroutine resumes exactly once when the future is
+/// satisfied by other threads while the coroutine suspends.
+TEST(FutureCoroutinesTest, AwaitFromOtherThread) {
+  for (int i = 0; i != 1000; ++i) {
+    promise<int> p;
+    std::thread t([&p, i] { p.set_value(i); });
+    auto f = Twice(p.get_future());
+    EXPECT_EQ(2 * i, f.get());
+    t.join();
+  }
+}
+
+/// @test Verify a coroutine can wait for many futures (fan-out / fan-in).
+TEST(FutureCoroutinesTest, FanOutFanIn) {
+  auto sum = [](std::vector<future<int>> values) -> future<int> {
+    int total = 0;
+    for (auto& v : values) total += co_await std::move(v);
+    co_return total;
+  };
+
+  std::vector<promise<int>> promises(100);
+  std::vector<future<int>> futures;
+  for (auto& p : promises) futures.push_back(Twice(p.get_future()));
+  auto f = sum(std::move(futures));
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i != 4; ++i) {
+    threads.emplace_back([&promises, i] {
+      for (auto j = i; j < 100; j += 4) {
+        promises[static_cast<std::size_t>(j)].set_value(j);
+      }
+    });
+  }
+  EXPECT_EQ(2 * 99 * 100 / 2, f.get());
+  for (auto& t : threads) t.join();
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+TEST(FutureCoroutinesTest, AwaitException) {
+  promise<int> p;
+  auto f = Twice(p.get_future());
+  p.set_exception(std::make_exception_ptr(std::runtime_error("test message")));
+  EXPECT_THROW(
+      try { f.get(); } catch (std::runtime_error const& ex) {
+        EXPECT_THAT(ex.what(), HasSubstr("test message"));
+        throw;
+      },
+      std::runtime_error);
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
+#else
+
+TEST(FutureCoroutinesTest, Disabled) {
+  GTEST_SKIP() << "coroutines are not supported by this compiler";
+}
+
+#endif  // GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
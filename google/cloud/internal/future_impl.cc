@@ -22,6 +22,13 @@ namespace google {
 namespace cloud {
 inline namespace GOOGLE_CLOUD_CPP_NS {
 namespace internal {
+std::uint32_t constexpr future_shared_state_base::kSatisfying;
+std::uint32_t constexpr future_shared_state_base::kHasException;
+std::uint32_t constexpr future_shared_state_base::kHasValue;
+std::uint32_t constexpr future_shared_state_base::kHasContinuation;
+std::uint32_t constexpr future_shared_state_base::kHasWaiters;
+std::size_t constexpr future_shared_state_base::kContinuationBufferSize;
+
 [[noreturn]] void ThrowFutureError(std::future_errc ec, char const* msg) {
 #ifdef GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
   (void)msg;  // disable unused argument warning.
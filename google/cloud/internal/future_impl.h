@@ -24,10 +24,16 @@
 #include "google/cloud/terminate_handler.h"
 #include "google/cloud/version.h"
 #include "absl/memory/memory.h"
+#include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
+#include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
+#include <type_traits>
 
 namespace google {
 namespace cloud {
@@ -61,6 +67,16 @@ class continuation_base {  // NOLINT(readability-identifier-naming)
  * `future<void>` share a lot of code. This class refactors that code, it
  * represents a shared state of unknown type.
  *
+ * The state of the class (satisfied or not, with a value or an exception, with
+ * a continuation, with blocked threads) is kept in a single atomic word. The
+ * common operations (`set_value()`, `then()`, `is_ready()`, and `get()` for a
+ * satisfied future) only need atomic read-modify-write operations. The mutex
+ * and condition variable are only used by threads that block waiting for the
+ * shared state to become satisfied.
+ *
+ * Continuations that fit in a small buffer are stored in the shared state,
+ * this avoids a heap allocation for most `.then()` calls.
+ *
  * @note While most of the invariants for promises and futures are implemented
  *   by this class, not all of them are. Notably, future values can only be
  *   retrieved once, but this is enforced because calling `.get()` or `.then()`
@@ -69,14 +85,22 @@ class continuation_base {  // NOLINT(readability-identifier-naming)
  */
 class future_shared_state_base {  // NOLINT(readability-identifier-naming)
  public:
-  future_shared_state_base() : future_shared_state_base([] {}) {}
+  future_shared_state_base() = default;
   explicit future_shared_state_base(std::function<void()> cancellation_callback)
-      : current_state_(state::not_ready),
-        cancellation_callback_(std::move(cancellation_callback)) {}
+      : cancellation_callback_(std::move(cancellation_callback)) {}
+
+  ~future_shared_state_base() {
+    if (continuation_ == nullptr) return;
+    if (continuation_is_inline_) {
+      continuation_->~continuation_base();
+    } else {
+      delete continuation_;
+    }
+  }
+
   /// Return true if the shared state has a value or an exception.
   bool is_ready() const {
-    std::unique_lock<std::mutex> lk(mu_);
-    return is_ready_unlocked();
+    return is_ready_state(current_state_.load(std::memory_order_acquire));
   }
 
   /// Return true if the shared state can be cancelled.
@@ -84,8 +108,9 @@ class future_shared_state_base {  // NOLINT(readability-identifier-naming)
 
   /// Block until is_ready() returns true ...
   void wait() {
+    if (is_ready()) return;
     std::unique_lock<std::mutex> lk(mu_);
-    cv_.wait(lk, [this] { return is_ready_unlocked(); });
+    cv_.wait(lk, [this] { return is_ready_or_add_waiter(); });
   }
 
   /**
@@ -112,16 +137,11 @@ class future_shared_state_base {  // NOLINT(readability-identifier-naming)
    */
   template <typename Rep, typename Period>
   std::future_status wait_for(std::chrono::duration<Rep, Period> duration) {
+    if (is_ready()) return std::future_status::ready;
     std::unique_lock<std::mutex> lk(mu_);
-    bool result =
-        cv_.wait_for(lk, duration, [this] { return is_ready_unlocked(); });
-    if (result) {
-      return std::future_status::ready;
-    }
-    if (continuation_) {
-      return std::future_status::deferred;
-    }
-    return std::future_status::timeout;
+    bool result = cv_.wait_for(lk, duration,
+                               [this] { return is_ready_or_add_waiter(); });
+    return wait_status(result);
   }
 
   /**
@@ -142,26 +162,18 @@ class future_shared_state_base {  // NOLINT(readability-identifier-naming)
    */
   template <typename Clock>
   std::future_status wait_until(std::chrono::time_point<Clock> deadline) {
+    if (is_ready()) return std::future_status::ready;
     std::unique_lock<std::mutex> lk(mu_);
-    if (!lk.owns_lock()) {
-      return std::future_status::timeout;
-    }
-    bool result =
-        cv_.wait_until(lk, deadline, [this] { return is_ready_unlocked(); });
-    if (result) {
-      return std::future_status::ready;
-    }
-    if (continuation_) {
-      return std::future_status::deferred;
-    }
-    return std::future_status::timeout;
+    bool result = cv_.wait_until(lk, deadline,
+                                 [this] { return is_ready_or_add_waiter(); });
+    return wait_status(result);
   }
 
   /// Set the shared state to hold an exception and notify immediately.
   void set_exception(std::exception_ptr ex) {
-    std::unique_lock<std::mutex> lk(mu_);
-    set_exception(std::move(ex), lk);
-    notify_now(std::move(lk));
+    start_satisfy(__func__);
+    exception_ = std::move(ex);
+    finish_satisfy(kHasException, true);
   }
 
   /**
@@ -173,34 +185,60 @@ class future_shared_state_base {  // NOLINT(readability-identifier-naming)
    * `std::future_errc::broken_promise`.
    */
   void abandon() {
-    std::unique_lock<std::mutex> lk(mu_);
-    if (is_ready_unlocked()) {
-      return;
-    }
+    if (is_ready()) return;
+    auto const previous =
+        current_state_.fetch_or(kSatisfying, std::memory_order_acq_rel);
+    if ((previous & kSatisfying) != 0) return;
 #if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
-    set_exception(std::make_exception_ptr(
-                      std::future_error(std::future_errc::broken_promise)),
-                  lk);
+    exception_ = std::make_exception_ptr(
+        std::future_error(std::future_errc::broken_promise));
 #else
-    set_exception(nullptr, lk);
+    exception_ = nullptr;
 #endif
-    cv_.notify_all();
+    // Abandoning the shared state does not execute the continuation, only
+    // wakes up any blocked threads.
+    finish_satisfy(kHasException, false);
   }
 
   void set_continuation(std::unique_ptr<continuation_base> c) {
-    std::unique_lock<std::mutex> lk(mu_);
-    if (continuation_) {
-      ThrowFutureError(std::future_errc::future_already_retrieved, __func__);
-    }
-    // If the future is already satisfied, invoke the continuation immediately.
-    if (is_ready_unlocked()) {
-      // Release the lock before calling the user's code, holding locks during
-      // callbacks is a bad practice.
-      lk.unlock();
-      c->execute();
-      return;
-    }
-    continuation_ = std::move(c);
+    check_no_continuation(__func__);
+    continuation_ = c.release();
+    continuation_is_inline_ = false;
+    arm_continuation();
+  }
+
+  /**
+   * Create a continuation of type @p Continuation, without scheduling it.
+   *
+   * The continuation is created in a buffer inside the shared state if it
+   * fits, otherwise it is allocated on the heap. The caller must call
+   * `arm_continuation()` to schedule (or run) the continuation.
+   */
+  template <typename Continuation, typename... Args>
+  Continuation* emplace_continuation(char const* msg, Args&&... args) {
+    check_no_continuation(msg);
+    using fits = std::integral_constant<
+        bool, sizeof(Continuation) <= sizeof(continuation_buffer_t) &&
+                  alignof(Continuation) <= alignof(continuation_buffer_t)>;
+    auto* c =
+        new_continuation<Continuation>(fits{}, std::forward<Args>(args)...);
+    continuation_ = c;
+    continuation_is_inline_ = fits::value;
+    return c;
+  }
+
+  /**
+   * Schedule the continuation created by `emplace_continuation()`.
+   *
+   * If the shared state is already satisfied the continuation runs
+   * immediately, otherwise it runs when the shared state is satisfied.
+   */
+  void arm_continuation() {
+    // The promise will not see the continuation until this operation, and it
+    // runs it if and only if the shared state was not satisfied.
+    auto const previous =
+        current_state_.fetch_or(kHasContinuation, std::memory_order_acq_rel);
+    if (is_ready_state(previous)) continuation_->execute();
   }
 
   std::function<void()> release_cancellation_callback() {
@@ -212,7 +250,7 @@ class future_shared_state_base {  // NOLINT(readability-identifier-naming)
     if (!cancellable()) {
       return false;
     }
-    cancellation_callback_();
+    if (cancellation_callback_) cancellation_callback_();
     // If the callback fails with an exception we assume it had no effect.
     // Incidentally this means we provide the strong exception guarantee for
     // this function.
@@ -221,30 +259,98 @@ class future_shared_state_base {  // NOLINT(readability-identifier-naming)
   }
 
  protected:
-  bool is_ready_unlocked() const { return current_state_ != state::not_ready; }
+  // The bits in `current_state_`.
+  static std::uint32_t constexpr kSatisfying = 1U << 0;
+  static std::uint32_t constexpr kHasException = 1U << 1;
+  static std::uint32_t constexpr kHasValue = 1U << 2;
+  static std::uint32_t constexpr kHasContinuation = 1U << 3;
+  static std::uint32_t constexpr kHasWaiters = 1U << 4;
+
+  static bool is_ready_state(std::uint32_t s) {
+    return (s & (kHasException | kHasValue)) != 0;
+  }
 
-  /// Satisfy the shared state using an exception.
-  void set_exception(std::exception_ptr ex, std::unique_lock<std::mutex>&) {
-    if (is_ready_unlocked()) {
-      ThrowFutureError(std::future_errc::promise_already_satisfied, __func__);
+  /**
+   * Reserve the right to satisfy the shared state.
+   *
+   * Only one thread can store a value or an exception in the shared state,
+   * this thread "claims" the shared state before storing either.
+   *
+   * @throws std::future_error if the shared state was already satisfied, or a
+   *     different thread is satisfying it.
+   */
+  void start_satisfy(char const* msg) {
+    auto const previous =
+        current_state_.fetch_or(kSatisfying, std::memory_order_acq_rel);
+    if ((previous & kSatisfying) != 0) {
+      ThrowFutureError(std::future_errc::promise_already_satisfied, msg);
     }
-    exception_ = std::move(ex);
-    current_state_ = state::has_exception;
   }
 
-  /// If needed, notify any waiting threads that the shared state is satisfied.
-  void notify_now(std::unique_lock<std::mutex> lk) {
-    if (continuation_) {
-      // Release the lock before calling the continuation because the
-      // continuation will likely call get() to fetch the state of the future.
-      lk.unlock();
+  /**
+   * Mark the shared state as satisfied, run the continuation, if any, and
+   * notify any blocked threads.
+   */
+  void finish_satisfy(std::uint32_t ready_bit, bool run_continuation) {
+    auto const previous =
+        current_state_.fetch_or(ready_bit, std::memory_order_acq_rel);
+    if ((previous & kHasWaiters) != 0) {
+      // The blocked threads set `kHasWaiters` and check the state while
+      // holding `mu_`, and release `mu_` only as they block. Acquiring `mu_`
+      // before notifying guarantees they receive the notification. The caller
+      // (a promise or a continuation) owns the shared state, so it remains
+      // valid even if the blocked threads return before this point.
+      std::lock_guard<std::mutex> lk(mu_);
+      cv_.notify_all();
+    }
+    if (run_continuation && (previous & kHasContinuation) != 0) {
+      // If there is a continuation there can be no threads blocked on get()
+      // or wait() because then() invalidates the future. Note that no locks
+      // are held while calling the continuation.
       continuation_->execute();
-      // If there is a continuation there can be no threads blocked on get() or
-      // wait() because then() invalidates the future. Therefore we can return
-      // without notifying any other threads.
-      return;
     }
-    cv_.notify_all();
+  }
+
+  /// Block until the shared state is satisfied, and return its state.
+  std::uint32_t wait_ready_state() {
+    auto const s = current_state_.load(std::memory_order_acquire);
+    if (is_ready_state(s)) return s;
+    wait();
+    return current_state_.load(std::memory_order_acquire);
+  }
+
+  /// Register a blocked thread, unless the shared state is satisfied.
+  bool is_ready_or_add_waiter() {
+    return is_ready_state(
+        current_state_.fetch_or(kHasWaiters, std::memory_order_acq_rel));
+  }
+
+  std::future_status wait_status(bool ready) const {
+    if (ready) return std::future_status::ready;
+    if ((current_state_.load(std::memory_order_acquire) & kHasContinuation) !=
+        0) {
+      return std::future_status::deferred;
+    }
+    return std::future_status::timeout;
+  }
+
+  template <typename Continuation, typename... Args>
+  Continuation* new_continuation(std::true_type, Args&&... args) {
+    return new (&continuation_buffer_)
+        Continuation(std::forward<Args>(args)...);
+  }
+
+  template <typename Continuation, typename... Args>
+  Continuation* new_continuation(std::false_type, Args&&... args) {
+    return new Continuation(std::forward<Args>(args)...);
+  }
+
+  // Only the holder of the (only) future can set a continuation, so this does
+  // not need to be atomic with respect to `arm_continuation()`.
+  void check_no_continuation(char const* msg) const {
+    if (continuation_ != nullptr) {
+      ThrowFutureError(std::future_errc::future_already_retrieved, msg);
+    }
   }
 
   /**
@@ -284,24 +390,31 @@ class future_shared_state_base {  // NOLINT(readability-identifier-naming)
   /// Keep track of whether `get_future()` has been called.
   std::atomic_flag retrieved_ = ATOMIC_FLAG_INIT;
 
-  mutable std::mutex mu_;
+  /// A combination of the `k*` bits.
+  std::atomic<std::uint32_t> current_state_ = ATOMIC_VAR_INIT(0);
+
+  // Only used to block threads until the shared state is satisfied.
+  std::mutex mu_;
   std::condition_variable cv_;
-  enum class state {
-    not_ready,      // NOLINT(readability-identifier-naming)
-    has_exception,  // NOLINT(readability-identifier-naming)
-    has_value,      // NOLINT(readability-identifier-naming)
-  };
-  state current_state_;
+
+  /// Only written before `kHasException` is set.
   std::exception_ptr exception_;
 
   /**
    * The continuation, if any, associated with this shared state.
    *
    * Note that continuations may be set independently of having a value or
-   * exception. Setting a continuation does not change the `current_state_`
-   * member variable and does not satisfy the shared state.
+   * exception. Setting a continuation does not satisfy the shared state.
    */
-  std::unique_ptr<continuation_base> continuation_;
+  continuation_base* continuation_ = nullptr;
+  bool continuation_is_inline_ = false;
+
+  // Most continuations hold a functor with a few captures, and two pointers to
+  // shared states. Those fit in this buffer.
+  static std::size_t constexpr kContinuationBufferSize = 12 * sizeof(void*);
+  using continuation_buffer_t =
+      std::aligned_storage<kContinuationBufferSize, alignof(void*)>::type;
+  continuation_buffer_t continuation_buffer_;
 
   // Allow users "cancel" the future with the given callback.
   std::atomic<bool> cancelled_ = ATOMIC_VAR_INIT(false);
@@ -332,13 +445,13 @@ class future_shared_state;
 template <typename T>
 class future_shared_state final : private future_shared_state_base {
  public:
-  future_shared_state() : future_shared_state_base(), buffer_() {}
+  future_shared_state() : buffer_() {}
   // NOLINTNEXTLINE(performance-unnecessary-value-param) TODO(#4112)
   explicit future_shared_state(std::function<void()> cancellation_callback)
       : future_shared_state_base(std::move(cancellation_callback)), buffer_() {}
   ~future_shared_state() {
-    if (current_state_ == state::has_value) {
-      // Recall that state::has_value is a terminal state, once a value is
+    if ((current_state_.load(std::memory_order_acquire) & kHasValue) != 0) {
+      // Recall that kHasValue is a terminal state, once a value is
       // stored in this class nothing else (no exceptions nor continuations)
       // can be stored.  And if a value was stored then we need to call the
       // destructor. Even if the value was moved out, the destructor still
@@ -348,7 +461,9 @@ class future_shared_state final : private future_shared_state_base {
   }
 
   using future_shared_state_base::abandon;
+  using future_shared_state_base::arm_continuation;
   using future_shared_state_base::cancel;
+  using future_shared_state_base::emplace_continuation;
   using future_shared_state_base::is_ready;
   using future_shared_state_base::release_cancellation_callback;
   using future_shared_state_base::set_continuation;
@@ -359,9 +474,7 @@ class future_shared_state final : private future_shared_state_base {
 
   /// The implementation details for `future<T>::get()`
   T get() {
-    std::unique_lock<std::mutex> lk(mu_);
-    cv_.wait(lk, [this] { return is_ready_unlocked(); });
-    if (current_state_ == state::has_exception) {
+    if ((wait_ready_state() & kHasException) != 0) {
 #if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
       std::rethrow_exception(exception_);
 #else
@@ -386,21 +499,13 @@ class future_shared_state final : private future_shared_state_base {
    *     error code is `std::future_errc::promise_already_satisfied`.
    */
   void set_value(T value) {
-    std::unique_lock<std::mutex> lk(mu_);
-    if (is_ready_unlocked()) {
-      ThrowFutureError(std::future_errc::promise_already_satisfied, __func__);
-    }
+    start_satisfy(__func__);
     // We can only reach this point once, all other states are terminal.
     // Therefore we know that `buffer_` has not been initialized and calling
     // placement new via the move constructor is the best way to initialize the
-    // buffer.
-
-    // TODO(#1405) - this is calling application code while holding a lock.
-    // That could result in a deadlock (or at least unbounded priority
-    // inversions) if the move constructor for `T` takes a long time to execute.
+    // buffer. No locks are held while running the move constructor.
     new (reinterpret_cast<T*>(&buffer_)) T(std::move(value));
-    current_state_ = state::has_value;
-    notify_now(std::move(lk));
+    finish_satisfy(kHasValue, true);
   }
 
   /**
@@ -477,7 +582,9 @@ class future_shared_state<void> final : private future_shared_state_base {
       : future_shared_state_base(std::move(cancellation_callback)) {}
 
   using future_shared_state_base::abandon;
+  using future_shared_state_base::arm_continuation;
   using future_shared_state_base::cancel;
+  using future_shared_state_base::emplace_continuation;
   using future_shared_state_base::is_ready;
   using future_shared_state_base::release_cancellation_callback;
   using future_shared_state_base::set_continuation;
@@ -488,9 +595,7 @@ class future_shared_state<void> final : private future_shared_state_base {
 
   /// The implementation details for `future<void>::get()`
   void get() {
-    std::unique_lock<std::mutex> lk(mu_);
-    cv_.wait(lk, [this] { return is_ready_unlocked(); });
-    if (current_state_ == state::has_exception) {
+    if ((wait_ready_state() & kHasException) != 0) {
 #if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
       std::rethrow_exception(exception_);
 #else
@@ -502,9 +607,8 @@ class future_shared_state<void> final : private future_shared_state_base {
 
   /// The implementation details for `promise<void>::set_value()`
   void set_value() {
-    std::unique_lock<std::mutex> lk(mu_);
-    set_value(lk);
-    notify_now(std::move(lk));
+    start_satisfy(__func__);
+    finish_satisfy(kHasValue, true);
   }
 
   /**
@@ -568,14 +672,6 @@ class future_shared_state<void> final : private future_shared_state_base {
   static void mark_retrieved(std::shared_ptr<future_shared_state> const& sh) {
     future_shared_state_base::mark_retrieved(sh.get());
   }
-
- private:
-  void set_value(std::unique_lock<std::mutex> const&) {
-    if (is_ready_unlocked()) {
-      ThrowFutureError(std::future_errc::promise_already_satisfied, __func__);
-    }
-    current_state_ = state::has_value;
-  }
 };
 
 /**
@@ -670,11 +766,11 @@ struct continuation : public continuation_base {
   using requires_unwrap_t =
       typename continuation_helper<Functor, R>::requires_unwrap_t;
 
-  continuation(Functor&& f, std::shared_ptr<input_shared_state_t> s)
+  continuation(Functor&& f, std::shared_ptr<input_shared_state_t> const& s)
       : functor(std::move(f)),
-        input(std::move(s)),
+        input(s),
         output(std::make_shared<future_shared_state<result_t>>(
-            input.lock()->release_cancellation_callback())) {}
+            s->release_cancellation_callback())) {}
 
   continuation(Functor&& f, std::shared_ptr<input_shared_state_t> s,
                std::shared_ptr<output_shared_state_t> o)
@@ -726,12 +822,13 @@ struct unwrapping_continuation : public continuation_base {
   using output_shared_state_t = future_shared_state<R>;
   using intermediate_shared_state_t = future_shared_state<R>;
 
-  unwrapping_continuation(Functor&& f, std::shared_ptr<input_shared_state_t> s)
+  unwrapping_continuation(Functor&& f,
+                          std::shared_ptr<input_shared_state_t> const& s)
       : functor(std::move(f)),
-        input(std::move(s)),
+        input(s),
         intermediate(),
         output(std::make_shared<output_shared_state_t>(
-            input.lock()->release_cancellation_callback())) {}
+            s->release_cancellation_callback())) {}
 
   void execute() override {
     auto tmp = input.lock();
@@ -763,13 +860,12 @@ struct unwrapping_continuation : public continuation_base {
       return r->get();
     };
     using continuation_type = internal::continuation<decltype(unwrapper), R>;
-    auto continuation = absl::make_unique<continuation_type>(
-        std::move(unwrapper), intermediate, output);
     // assert(intermediate->continuation_ == nullptr)
     // If intermediate has a continuation then the associated future would have
     // been invalid, and we never get here.
-    intermediate->set_continuation(
-        std::unique_ptr<continuation_base>(std::move(continuation)));
+    intermediate->template emplace_continuation<continuation_type>(
+        __func__, std::move(unwrapper), intermediate, output);
+    intermediate->arm_continuation();
   }
 
   /// The functor called when `input` is satisfied.
@@ -792,11 +888,10 @@ std::shared_ptr<typename internal::continuation_helper<F, T>::state_t>
 future_shared_state<T>::make_continuation(
     std::shared_ptr<future_shared_state<T>> self, F&& functor) {
   using continuation_type = internal::continuation<F, T>;
-  auto continuation =
-      absl::make_unique<continuation_type>(std::forward<F>(functor), self);
+  auto* continuation = self->template emplace_continuation<continuation_type>(
+      __func__, std::forward<F>(functor), self);
   auto result = continuation->output;
-  self->set_continuation(
-      std::unique_ptr<continuation_base>(std::move(continuation)));
+  self->arm_continuation();
   return result;
 }
 
@@ -814,13 +909,12 @@ future_shared_state<T>::make_continuation(
 
   // First create a continuation that calls the functor, and stores the result
   // in a `future_shared_state<future_shared_state<R>>`
-  auto continuation =
-      absl::make_unique<continuation_type>(std::forward<F>(functor), self);
-  // Save the value of `continuation->output`, because the move will make it
-  // inaccessible.
+  auto* continuation = self->template emplace_continuation<continuation_type>(
+      __func__, std::forward<F>(functor), self);
+  // Save the value of `continuation->output`, because the continuation may
+  // run (and reset it) as soon as it is armed.
   std::shared_ptr<future_shared_state<R>> result = continuation->output;
-  self->set_continuation(
-      std::unique_ptr<continuation_base>(std::move(continuation)));
+  self->arm_continuation();
   return result;
 }
 
@@ -830,13 +924,12 @@ std::shared_ptr<typename internal::continuation_helper<F, void>::state_t>
 future_shared_state<void>::make_continuation(
     std::shared_ptr<future_shared_state<void>> self, F&& functor) {
   using continuation_type = internal::continuation<F, void>;
-  auto continuation =
-      absl::make_unique<continuation_type>(std::forward<F>(functor), self);
-  // Save the value of `continuation->output`, because the move will make it
-  // inaccessible.
+  auto* continuation = self->template emplace_continuation<continuation_type>(
+      __func__, std::forward<F>(functor), self);
+  // Save the value of `continuation->output`, because the continuation may
+  // run (and reset it) as soon as it is armed.
   auto result = continuation->output;
-  self->set_continuation(
-      std::unique_ptr<continuation_base>(std::move(continuation)));
+  self->arm_continuation();
   return result;
 }
 
@@ -856,13 +949,12 @@ future_shared_state<void>::make_continuation(
 
   // First create a continuation that calls the functor, and stores the result
   // in a `future_shared_state<future_shared_state<R>>`
-  auto continuation =
-      absl::make_unique<continuation_type>(std::forward<F>(functor), self);
-  // Save the value of `continuation->output`, because the move will make it
-  // inaccessible.
+  auto* continuation = self->template emplace_continuation<continuation_type>(
+      __func__, std::forward<F>(functor), self);
+  // Save the value of `continuation->output`, because the continuation may
+  // run (and reset it) as soon as it is armed.
   std::shared_ptr<future_shared_state<R>> result = continuation->output;
-  self->set_continuation(
-      std::unique_ptr<continuation_base>(std::move(continuation)));
+  self->arm_continuation();
   return result;
 }
 
@@ -18,6 +18,9 @@
 #include "google/cloud/testing_util/testing_types.h"
 #include "absl/memory/memory.h"
 #include <gmock/gmock.h>
+#include <array>
+#include <atomic>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -516,6 +519,54 @@ TEST(ContinuationIntTest, SetValueCallsContinuation) {
   EXPECT_EQ(84, output->get());
 }
 
+/// @test Verify continuations too large for the inline buffer work.
+TEST(ContinuationIntTest, LargeFunctor) {
+  std::array<int, 64> large;
+  large.fill(1);
+  auto functor =
+      [large](std::shared_ptr<future_shared_state<int>> const& state) {
+        return state->get() + large.back();
+      };
+
+  auto input = std::make_shared<future_shared_state<int>>();
+  std::shared_ptr<future_shared_state<int>> output =
+      input->make_continuation(input, std::move(functor));
+
+  input->set_value(42);
+  EXPECT_TRUE(output->is_ready());
+  EXPECT_EQ(43, output->get());
+}
+
+/// @test Verify the continuation runs exactly once when it is set while the
+/// shared state is satisfied from a different thread.
+TEST(ContinuationIntTest, SetValueRacesWithContinuation) {
+  for (int i = 0; i != 1000; ++i) {
+    std::atomic<int> called(0);
+    auto functor =
+        [&called](std::shared_ptr<future_shared_state<int>> const& state) {
+          ++called;
+          return 2 * state->get();
+        };
+    auto input = std::make_shared<future_shared_state<int>>();
+    std::thread t([input] { input->set_value(42); });
+    std::shared_ptr<future_shared_state<int>> output =
+        input->make_continuation(input, std::move(functor));
+    EXPECT_EQ(84, output->get());
+    t.join();
+    EXPECT_EQ(1, called.load());
+  }
+}
+
+/// @test Verify a blocked thread is woken up by a different thread.
+TEST(FutureImplInt, WaitRacesWithSetValue) {
+  for (int i = 0; i != 1000; ++i) {
+    future_shared_state<int> shared_state;
+    std::thread t([&shared_state] { shared_state.set_value(42); });
+    EXPECT_EQ(42, shared_state.get());
+    t.join();
+  }
+}
+
 TEST(FutureImplNoDefaultConstructor, SetValue) {
   future_shared_state<NoDefaultConstructor> shared_state;
   EXPECT_FALSE(shared_state.is_ready());
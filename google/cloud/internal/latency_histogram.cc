@@ -0,0 +1,38 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/latency_histogram.h"
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+std::size_t LatencyBucket(std::chrono::microseconds latency,
+                          std::size_t bucket_count) {
+  std::size_t bucket = 0;
+  for (auto v = latency.count(); v > 1 && bucket + 1 < bucket_count; v /= 2) {
+    ++bucket;
+  }
+  return bucket;
+}
+
+std::chrono::microseconds LatencyBucketUpperBound(std::size_t bucket) {
+  return std::chrono::microseconds(std::int64_t{2} << bucket);
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,73 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_LATENCY_HISTOGRAM_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_LATENCY_HISTOGRAM_H
+
+#include "google/cloud/version.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * Returns the bucket for @p latency in a logarithmic latency histogram.
+ *
+ * Bucket `0` counts the latencies below 2us, bucket `i` counts the latencies
+ * in the `[2^i, 2^(i+1))` microseconds range, and the last bucket counts
+ * everything above that.
+ */
+std::size_t LatencyBucket(std::chrono::microseconds latency,
+                          std::size_t bucket_count);
+
+/// The (exclusive) upper bound for the latencies in @p bucket.
+std::chrono::microseconds LatencyBucketUpperBound(std::size_t bucket);
+
+/**
+ * Estimates the @p percentile latency, in the [0, 100] range, of a histogram.
+ *
+ * Returns the upper bound of the bucket containing the percentile, or zero if
+ * there are no samples.
+ *
+ * @tparam Buckets a container of `std::int64_t` counts, see `LatencyBucket()`.
+ */
+template <typename Buckets>
+std::chrono::microseconds LatencyPercentile(Buckets const& buckets,
+                                            double percentile) {
+  std::int64_t count = 0;
+  for (auto b : buckets) count += b;
+  if (count == 0) return std::chrono::microseconds(0);
+  percentile = (std::max)(0.0, (std::min)(percentile, 100.0));
+  auto const target = static_cast<double>(count) * percentile / 100.0;
+  std::int64_t cumulative = 0;
+  std::size_t bucket = 0;
+  for (auto b : buckets) {
+    cumulative += b;
+    if (static_cast<double>(cumulative) >= target) break;
+    ++bucket;
+  }
+  return LatencyBucketUpperBound(bucket);
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_LATENCY_HISTOGRAM_H
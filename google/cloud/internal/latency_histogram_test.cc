@@ -0,0 +1,73 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/latency_histogram.h"
+#include <gmock/gmock.h>
+#include <array>
+#include <limits>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+using us = std::chrono::microseconds;
+
+TEST(LatencyHistogramTest, Bucket) {
+  EXPECT_EQ(0, LatencyBucket(us(-1), 40));
+  EXPECT_EQ(0, LatencyBucket(us(0), 40));
+  EXPECT_EQ(0, LatencyBucket(us(1), 40));
+  EXPECT_EQ(1, LatencyBucket(us(2), 40));
+  EXPECT_EQ(1, LatencyBucket(us(3), 40));
+  EXPECT_EQ(2, LatencyBucket(us(4), 40));
+  EXPECT_EQ(10, LatencyBucket(us(1024), 40));
+  EXPECT_EQ(39, LatencyBucket(us((std::numeric_limits<std::int64_t>::max)()),
+                              40));
+  EXPECT_EQ(3, LatencyBucket(us(1024), 4));
+}
+
+TEST(LatencyHistogramTest, UpperBound) {
+  EXPECT_EQ(us(2), LatencyBucketUpperBound(0));
+  EXPECT_EQ(us(4), LatencyBucketUpperBound(1));
+  EXPECT_EQ(us(2048), LatencyBucketUpperBound(10));
+  for (std::size_t i = 0; i != 40; ++i) {
+    EXPECT_EQ(i, LatencyBucket(LatencyBucketUpperBound(i) - us(1), 40));
+  }
+}
+
+TEST(LatencyHistogramTest, Percentile) {
+  EXPECT_EQ(us(0), LatencyPercentile(std::vector<std::int64_t>{}, 50.0));
+  EXPECT_EQ(us(0), LatencyPercentile(std::vector<std::int64_t>{0, 0}, 50.0));
+
+  std::vector<std::int64_t> const buckets{10, 0, 0, 80, 10};
+  EXPECT_EQ(us(2), LatencyPercentile(buckets, 0.0));
+  EXPECT_EQ(us(2), LatencyPercentile(buckets, 5.0));
+  EXPECT_EQ(us(16), LatencyPercentile(buckets, 50.0));
+  EXPECT_EQ(us(16), LatencyPercentile(buckets, 90.0));
+  EXPECT_EQ(us(32), LatencyPercentile(buckets, 99.0));
+  EXPECT_EQ(us(32), LatencyPercentile(buckets, 100.0));
+  EXPECT_EQ(us(32), LatencyPercentile(buckets, 200.0));
+
+  std::array<std::int64_t, 3> const array{0, 1, 1};
+  EXPECT_EQ(us(4), LatencyPercentile(array, 50.0));
+  EXPECT_EQ(us(8), LatencyPercentile(array, 75.0));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
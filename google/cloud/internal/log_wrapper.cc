@@ -13,13 +13,53 @@
 // limitations under the License.
 
 #include "google/cloud/internal/log_wrapper.h"
+#include "google/cloud/internal/random.h"
+#include <google/protobuf/io/zero_copy_stream.h>
 #include <google/protobuf/text_format.h>
+#include <algorithm>
 #include <atomic>
 
 namespace google {
 namespace cloud {
 inline namespace GOOGLE_CLOUD_CPP_NS {
 namespace internal {
+namespace {
+
+std::size_t constexpr kChunkSize = 1024;
+
+// A string output stream accepting at most `limit` bytes. Once the limit is
+// reached the TextFormat printer stops generating output, so very large
+// messages are never fully formatted in memory.
+class CappedStringOutputStream
+    : public google::protobuf::io::ZeroCopyOutputStream {
+ public:
+  CappedStringOutputStream(std::string* target, std::size_t limit)
+      : target_(target), limit_(limit) {}
+
+  bool Next(void** data, int* size) override {
+    if (target_->size() >= limit_) return false;
+    auto const position = target_->size();
+    auto const chunk = (std::min)(limit_ - position, kChunkSize);
+    target_->resize(position + chunk);
+    *data = &(*target_)[position];
+    *size = static_cast<int>(chunk);
+    return true;
+  }
+
+  void BackUp(int count) override {
+    target_->resize(target_->size() - static_cast<std::size_t>(count));
+  }
+
+  std::int64_t ByteCount() const override {
+    return static_cast<std::int64_t>(target_->size());
+  }
+
+ private:
+  std::string* target_;
+  std::size_t limit_;
+};
+
+}  // namespace
 
 std::string DebugString(google::protobuf::Message const& m,
                         TracingOptions const& options) {
@@ -29,10 +69,24 @@ std::string DebugString(google::protobuf::Message const& m,
   p.SetUseShortRepeatedPrimitives(options.use_short_repeated_primitives());
   p.SetTruncateStringFieldLongerThan(
       options.truncate_string_field_longer_than());
-  p.PrintToString(m, &str);
+  auto const limit = options.truncate_message_longer_than();
+  if (limit <= 0) {
+    p.PrintToString(m, &str);
+    return str;
+  }
+  CappedStringOutputStream output(&str, static_cast<std::size_t>(limit));
+  if (!p.Print(m, &output)) str += "...<truncated>...";
   return str;
 }
 
+bool TracingSampled(TracingOptions const& options) {
+  auto const rate = options.sampling_rate();
+  if (rate >= 1.0) return true;
+  if (rate <= 0.0) return false;
+  thread_local auto generator = MakeDefaultPRNG();
+  return std::uniform_real_distribution<double>(0.0, 1.0)(generator) < rate;
+}
+
 std::string RequestIdForLogging() {
   static std::atomic<std::uint64_t> generator{0};
   return std::to_string(++generator);
@@ -35,6 +35,14 @@ std::string DebugString(google::protobuf::Message const& m,
 
 char const* DebugFutureStatus(std::future_status s);
 
+/**
+ * Returns true if an RPC should be traced, see `TracingOptions::sampling_rate`.
+ *
+ * The wrappers call this once per RPC, so the request and response of an RPC
+ * are either both logged or both skipped.
+ */
+bool TracingSampled(TracingOptions const& options);
+
 // Create a unique ID that can be used to match asynchronous requests/reponse
 // pairs.
 std::string RequestIdForLogging();
@@ -68,6 +76,7 @@ template <
 Result LogWrapper(Functor&& functor, grpc::ClientContext& context,
                   Request const& request, char const* where,
                   TracingOptions const& options) {
+  if (!TracingSampled(options)) return functor(context, request);
   GCP_LOG(DEBUG) << where << "() << " << DebugString(request, options);
   auto response = functor(context, request);
   GCP_LOG(DEBUG) << where << "() >> status=" << response;
@@ -81,6 +90,7 @@ template <typename Functor, typename Request,
 Result LogWrapper(Functor&& functor, grpc::ClientContext& context,
                   Request const& request, char const* where,
                   TracingOptions const& options) {
+  if (!TracingSampled(options)) return functor(context, request);
   GCP_LOG(DEBUG) << where << "() << " << DebugString(request, options);
   auto response = functor(context, request);
   if (!response) {
@@ -99,6 +109,7 @@ template <typename Functor, typename Request,
 Result LogWrapper(Functor&& functor, grpc::ClientContext& context,
                   Request const& request, char const* where,
                   TracingOptions const& options) {
+  if (!TracingSampled(options)) return functor(context, request);
   GCP_LOG(DEBUG) << where << "() << " << DebugString(request, options);
   auto response = functor(context, request);
   GCP_LOG(DEBUG) << where << "() >> " << (response ? "not null" : "null")
@@ -106,6 +117,40 @@ Result LogWrapper(Functor&& functor, grpc::ClientContext& context,
   return response;
 }
 
+template <typename Functor, typename Request,
+          typename Result = google::cloud::internal::invoke_result_t<
+              Functor, std::unique_ptr<grpc::ClientContext>, Request const&>,
+          typename std::enable_if<IsUniquePtr<Result>::value, int>::type = 0>
+Result LogWrapper(Functor&& functor,
+                  std::unique_ptr<grpc::ClientContext> context,
+                  Request const& request, char const* where,
+                  TracingOptions const& options) {
+  if (!TracingSampled(options)) return functor(std::move(context), request);
+  GCP_LOG(DEBUG) << where << "() << " << DebugString(request, options);
+  auto response = functor(std::move(context), request);
+  GCP_LOG(DEBUG) << where << "() >> " << (response ? "not null" : "null")
+                 << " stream";
+  return response;
+}
+
+template <typename Functor,
+          typename Result = google::cloud::internal::invoke_result_t<
+              Functor, google::cloud::CompletionQueue&,
+              std::unique_ptr<grpc::ClientContext>>,
+          typename std::enable_if<IsUniquePtr<Result>::value, int>::type = 0>
+Result LogWrapper(Functor&& functor, google::cloud::CompletionQueue& cq,
+                  std::unique_ptr<grpc::ClientContext> context,
+                  char const* where, TracingOptions const& options) {
+  if (!TracingSampled(options)) return functor(cq, std::move(context));
+  // Bidirectional streams have no initial request, the application writes the
+  // requests after the stream is created.
+  GCP_LOG(DEBUG) << where << "() << (void)";
+  auto response = functor(cq, std::move(context));
+  GCP_LOG(DEBUG) << where << "() >> " << (response ? "not null" : "null")
+                 << " stream";
+  return response;
+}
+
 template <
     typename Functor, typename Request,
     typename Result = google::cloud::internal::invoke_result_t<
@@ -113,6 +158,7 @@ template <
 Result LogWrapper(Functor&& functor, grpc::ClientContext& context,
                   Request const& request, grpc::CompletionQueue* cq,
                   char const* where, TracingOptions const& options) {
+  if (!TracingSampled(options)) return functor(context, request, cq);
   GCP_LOG(DEBUG) << where << "() << " << DebugString(request, options);
   auto response = functor(context, request, cq);
   GCP_LOG(DEBUG) << where << "() >> " << (response ? "not null" : "null")
@@ -127,6 +173,7 @@ template <
     typename std::enable_if<IsFutureStatusOr<Result>::value, int>::type = 0>
 Result LogWrapper(Functor&& functor, Request request, char const* where,
                   TracingOptions const& options) {
+  if (!TracingSampled(options)) return functor(std::move(request));
   // Because this is an asynchronous request we need a unique identifier so
   // applications can match the request and response in the log.
   auto prefix = std::string(where) + "(" + RequestIdForLogging() + ")";
@@ -160,6 +207,9 @@ Result LogWrapper(Functor&& functor, google::cloud::CompletionQueue& cq,
                   std::unique_ptr<grpc::ClientContext> context,
                   Request const& request, char const* where,
                   TracingOptions const& options) {
+  if (!TracingSampled(options)) {
+    return functor(cq, std::move(context), request);
+  }
   // Because this is an asynchronous request we need a unique identifier so
   // applications can match the request and response in the log.
   auto prefix = std::string(where) + "(" + RequestIdForLogging() + ")";
@@ -192,6 +242,9 @@ Result LogWrapper(Functor&& functor, google::cloud::CompletionQueue& cq,
                   std::unique_ptr<grpc::ClientContext> context,
                   Request const& request, char const* where,
                   TracingOptions const& options) {
+  if (!TracingSampled(options)) {
+    return functor(cq, std::move(context), request);
+  }
   // Because this is an asynchronous request we need a unique identifier so
   // applications can match the request and response in the log.
   auto prefix = std::string(where) + "(" + RequestIdForLogging() + ")";
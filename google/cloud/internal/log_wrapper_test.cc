@@ -15,6 +15,7 @@
 #include "google/cloud/internal/log_wrapper.h"
 #include "google/cloud/testing_util/capture_log_lines_backend.h"
 #include "google/cloud/tracing_options.h"
+#include "absl/memory/memory.h"
 #include <google/protobuf/text_format.h>
 #include <google/spanner/v1/mutation.pb.h>
 #include <gmock/gmock.h>
@@ -28,6 +29,7 @@ namespace {
 using ::testing::AllOf;
 using ::testing::Contains;
 using ::testing::HasSubstr;
+using ::testing::IsEmpty;
 
 google::spanner::v1::Mutation MakeMutation() {
   auto constexpr kText = R"pb(
@@ -132,6 +134,59 @@ TEST(LogWrapper, Truncate) {
   EXPECT_EQ(text, internal::DebugString(MakeMutation(), tracing_options));
 }
 
+TEST(LogWrapper, TruncateMessage) {
+  TracingOptions tracing_options;
+  tracing_options.SetOptions("truncate_message_longer_than=32");
+  std::string const text =
+      R"pb(insert { table: "Singers" column...<truncated>...)pb";
+  EXPECT_EQ(text, internal::DebugString(MakeMutation(), tracing_options));
+
+  // Messages under the limit are not modified.
+  tracing_options.SetOptions("truncate_message_longer_than=4096");
+  EXPECT_EQ(internal::DebugString(MakeMutation(), TracingOptions{}),
+            internal::DebugString(MakeMutation(), tracing_options));
+}
+
+TEST(LogWrapper, TracingSampled) {
+  TracingOptions tracing_options;
+  EXPECT_TRUE(TracingSampled(tracing_options));
+  tracing_options.SetOptions("sampling_rate=0");
+  EXPECT_FALSE(TracingSampled(tracing_options));
+
+  tracing_options.SetOptions("sampling_rate=0.5");
+  auto constexpr kTrials = 1000;
+  int sampled = 0;
+  for (int i = 0; i != kTrials; ++i) {
+    if (TracingSampled(tracing_options)) ++sampled;
+  }
+  EXPECT_LT(0, sampled);
+  EXPECT_GT(kTrials, sampled);
+}
+
+/// @test the RPCs not sampled are not logged
+TEST(LogWrapper, NotSampled) {
+  auto mock = [](grpc::ClientContext&, google::spanner::v1::Mutation const&) {
+    return make_status_or(MakeMutation());
+  };
+
+  auto backend = std::make_shared<testing_util::CaptureLogLinesBackend>();
+  auto id = google::cloud::LogSink::Instance().AddBackend(backend);
+
+  TracingOptions tracing_options;
+  tracing_options.SetOptions("sampling_rate=0");
+  grpc::ClientContext context;
+  auto response = LogWrapper(mock, context, MakeMutation(), "in-test",
+                             tracing_options);
+  EXPECT_TRUE(response.ok());
+  EXPECT_THAT(backend->ClearLogLines(), IsEmpty());
+
+  LogWrapper(mock, context, MakeMutation(), "in-test", TracingOptions{});
+  EXPECT_THAT(backend->ClearLogLines(),
+              Contains(HasSubstr("in-test() >> response=")));
+
+  google::cloud::LogSink::Instance().RemoveBackend(id);
+}
+
 TEST(LogWrapper, FutureStatus) {
   struct Case {
     std::future_status actual;
@@ -283,6 +338,53 @@ TEST(LogWrapper, FutureStatusWithContextAndCQ) {
   google::cloud::LogSink::Instance().RemoveBackend(id);
 }
 
+/// @test the overload for functions returning a streaming read RPC
+TEST(LogWrapper, StreamingReadWithContext) {
+  auto mock = [](std::unique_ptr<grpc::ClientContext>,
+                 google::spanner::v1::Mutation const&) {
+    return absl::make_unique<google::spanner::v1::Mutation>();
+  };
+
+  auto backend = std::make_shared<testing_util::CaptureLogLinesBackend>();
+  auto id = google::cloud::LogSink::Instance().AddBackend(backend);
+
+  auto stream = LogWrapper(mock, absl::make_unique<grpc::ClientContext>(),
+                           MakeMutation(), "in-test", {});
+  EXPECT_NE(stream, nullptr);
+
+  auto const log_lines = backend->ClearLogLines();
+  EXPECT_THAT(log_lines,
+              Contains(AllOf(HasSubstr("in-test()"), HasSubstr(" << "))));
+  EXPECT_THAT(log_lines, Contains(AllOf(HasSubstr("in-test()"),
+                                        HasSubstr(" >> not null stream"))));
+
+  google::cloud::LogSink::Instance().RemoveBackend(id);
+}
+
+/// @test the overload for functions returning a bidirectional stream
+TEST(LogWrapper, StreamingReadWriteWithContextAndCQ) {
+  auto mock = [](google::cloud::CompletionQueue&,
+                 std::unique_ptr<grpc::ClientContext>) {
+    return std::unique_ptr<google::spanner::v1::Mutation>{};
+  };
+
+  auto backend = std::make_shared<testing_util::CaptureLogLinesBackend>();
+  auto id = google::cloud::LogSink::Instance().AddBackend(backend);
+
+  CompletionQueue cq;
+  auto stream = LogWrapper(mock, cq, absl::make_unique<grpc::ClientContext>(),
+                           "in-test", {});
+  EXPECT_EQ(stream, nullptr);
+
+  auto const log_lines = backend->ClearLogLines();
+  EXPECT_THAT(log_lines,
+              Contains(AllOf(HasSubstr("in-test()"), HasSubstr(" << (void)"))));
+  EXPECT_THAT(log_lines, Contains(AllOf(HasSubstr("in-test()"),
+                                        HasSubstr(" >> null stream"))));
+
+  google::cloud::LogSink::Instance().RemoveBackend(id);
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
@@ -0,0 +1,295 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_METRICS_WRAPPER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_METRICS_WRAPPER_H
+
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/future.h"
+#include "google/cloud/internal/async_read_write_stream_impl.h"
+#include "google/cloud/internal/invoke_result.h"
+#include "google/cloud/internal/streaming_read_rpc.h"
+#include "google/cloud/rpc_metrics.h"
+#include "google/cloud/status_or.h"
+#include "google/cloud/version.h"
+#include "absl/memory/memory.h"
+#include "absl/types/variant.h"
+#include <grpcpp/grpcpp.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/*
+ * The `MetricsWrapper()` overloads measure a single stub call and report it to
+ * a `RpcMetricsSink`. They are used by the generated `*Metrics` decorators, and
+ * can be used by hand-written stubs too. The @p where argument names the RPC
+ * in the sink, it must have static storage duration.
+ */
+
+inline void RecordRpcMetrics(RpcMetricsSink& sink, char const* where,
+                             std::chrono::steady_clock::time_point start,
+                             std::size_t request_bytes,
+                             std::size_t response_bytes, StatusCode code) {
+  sink.Record(RpcMetricsSample{where, std::chrono::steady_clock::now() - start,
+                               request_bytes, response_bytes, code});
+}
+
+inline std::size_t ResponseBytes(Status const&) { return 0; }
+template <typename T>
+std::size_t ResponseBytes(StatusOr<T> const& response) {
+  return response ? response->ByteSizeLong() : 0;
+}
+
+inline StatusCode ResponseCode(Status const& status) { return status.code(); }
+template <typename T>
+StatusCode ResponseCode(StatusOr<T> const& response) {
+  return response.status().code();
+}
+
+/**
+ * Accumulates the measurements for a streaming RPC, and records them once.
+ *
+ * Streams are recorded when their final status is known. Streams destroyed
+ * before that are recorded as `kCancelled`. The byte counts are atomic because
+ * a bidirectional stream may have a `Read()` and a `Write()` completing
+ * concurrently.
+ */
+class StreamingRpcMetrics {
+ public:
+  StreamingRpcMetrics(std::shared_ptr<RpcMetricsSink> sink, char const* where,
+                      std::chrono::steady_clock::time_point start,
+                      std::size_t request_bytes)
+      : sink_(std::move(sink)),
+        where_(where),
+        start_(start),
+        request_bytes_(request_bytes) {}
+
+  void AddRequestBytes(std::size_t n) { request_bytes_.fetch_add(n); }
+  void AddResponseBytes(std::size_t n) { response_bytes_.fetch_add(n); }
+
+  void Record(StatusCode code) {
+    if (recorded_.exchange(true)) return;
+    RecordRpcMetrics(*sink_, where_, start_, request_bytes_.load(),
+                     response_bytes_.load(), code);
+  }
+
+ private:
+  std::shared_ptr<RpcMetricsSink> sink_;
+  char const* where_;
+  std::chrono::steady_clock::time_point start_;
+  std::atomic<std::size_t> request_bytes_;
+  std::atomic<std::size_t> response_bytes_{0};
+  std::atomic<bool> recorded_{false};
+};
+
+/**
+ * Measures a streaming read RPC, from its creation until its final status.
+ *
+ * The response size is the total size of all the messages in the stream.
+ */
+template <typename ResponseType>
+class MetricsStreamingReadRpc : public StreamingReadRpc<ResponseType> {
+ public:
+  MetricsStreamingReadRpc(std::unique_ptr<StreamingReadRpc<ResponseType>> impl,
+                          std::shared_ptr<RpcMetricsSink> sink,
+                          char const* where,
+                          std::chrono::steady_clock::time_point start,
+                          std::size_t request_bytes)
+      : impl_(std::move(impl)),
+        metrics_(std::move(sink), where, start, request_bytes) {}
+
+  ~MetricsStreamingReadRpc() override {
+    metrics_.Record(StatusCode::kCancelled);
+  }
+
+  void Cancel() override { impl_->Cancel(); }
+
+  absl::variant<Status, ResponseType> Read() override {
+    auto response = impl_->Read();
+    if (absl::holds_alternative<ResponseType>(response)) {
+      metrics_.AddResponseBytes(
+          absl::get<ResponseType>(response).ByteSizeLong());
+      return response;
+    }
+    metrics_.Record(absl::get<Status>(response).code());
+    return response;
+  }
+
+ private:
+  std::unique_ptr<StreamingReadRpc<ResponseType>> impl_;
+  StreamingRpcMetrics metrics_;
+};
+
+/**
+ * Measures a bidirectional streaming RPC, from its creation until `Finish()`.
+ *
+ * The request and response sizes are the total size of all the messages
+ * written and read, respectively.
+ */
+template <typename Request, typename Response>
+class MetricsAsyncStreamingReadWriteRpc
+    : public AsyncStreamingReadWriteRpc<Request, Response> {
+ public:
+  MetricsAsyncStreamingReadWriteRpc(
+      std::unique_ptr<AsyncStreamingReadWriteRpc<Request, Response>> impl,
+      std::shared_ptr<RpcMetricsSink> sink, char const* where,
+      std::chrono::steady_clock::time_point start)
+      : impl_(std::move(impl)),
+        metrics_(std::make_shared<StreamingRpcMetrics>(std::move(sink), where,
+                                                       start, 0)) {}
+
+  ~MetricsAsyncStreamingReadWriteRpc() override {
+    metrics_->Record(StatusCode::kCancelled);
+  }
+
+  void Cancel() override { impl_->Cancel(); }
+  future<bool> Start() override { return impl_->Start(); }
+
+  future<absl::optional<Response>> Read() override {
+    auto metrics = metrics_;
+    return impl_->Read().then(
+        [metrics](future<absl::optional<Response>> f) {
+          auto response = f.get();
+          if (response) metrics->AddResponseBytes(response->ByteSizeLong());
+          return response;
+        });
+  }
+
+  future<bool> Write(Request const& request,
+                     grpc::WriteOptions options) override {
+    metrics_->AddRequestBytes(request.ByteSizeLong());
+    return impl_->Write(request, std::move(options));
+  }
+
+  future<bool> WritesDone() override { return impl_->WritesDone(); }
+
+  future<Status> Finish() override {
+    auto metrics = metrics_;
+    return impl_->Finish().then([metrics](future<Status> f) {
+      auto status = f.get();
+      metrics->Record(status.code());
+      return status;
+    });
+  }
+
+ private:
+  std::unique_ptr<AsyncStreamingReadWriteRpc<Request, Response>> impl_;
+  std::shared_ptr<StreamingRpcMetrics> metrics_;
+};
+
+template <typename Request, typename Response>
+std::unique_ptr<AsyncStreamingReadWriteRpc<Request, Response>>
+MakeMetricsAsyncStreamingReadWriteRpc(
+    std::unique_ptr<AsyncStreamingReadWriteRpc<Request, Response>> impl,
+    std::shared_ptr<RpcMetricsSink> sink, char const* where,
+    std::chrono::steady_clock::time_point start) {
+  return absl::make_unique<
+      MetricsAsyncStreamingReadWriteRpc<Request, Response>>(
+      std::move(impl), std::move(sink), where, start);
+}
+
+template <typename T>
+struct IsStreamingReadRpc : public std::false_type {};
+template <typename T>
+struct IsStreamingReadRpc<std::unique_ptr<StreamingReadRpc<T>>>
+    : public std::true_type {};
+
+template <typename T>
+struct IsStatusOrFuture : public std::false_type {};
+template <typename T>
+struct IsStatusOrFuture<future<StatusOr<T>>> : public std::true_type {};
+template <>
+struct IsStatusOrFuture<future<Status>> : public std::true_type {};
+
+template <typename Functor, typename Request,
+          typename Result = google::cloud::internal::invoke_result_t<
+              Functor, grpc::ClientContext&, Request const&>>
+Result MetricsWrapper(Functor&& functor, grpc::ClientContext& context,
+                      Request const& request, char const* where,
+                      std::shared_ptr<RpcMetricsSink> const& sink) {
+  auto const start = std::chrono::steady_clock::now();
+  auto response = functor(context, request);
+  RecordRpcMetrics(*sink, where, start, request.ByteSizeLong(),
+                   ResponseBytes(response), ResponseCode(response));
+  return response;
+}
+
+template <
+    typename Functor, typename Request,
+    typename Result = google::cloud::internal::invoke_result_t<
+        Functor, std::unique_ptr<grpc::ClientContext>, Request const&>,
+    typename std::enable_if<IsStreamingReadRpc<Result>::value, int>::type = 0>
+Result MetricsWrapper(Functor&& functor,
+                      std::unique_ptr<grpc::ClientContext> context,
+                      Request const& request, char const* where,
+                      std::shared_ptr<RpcMetricsSink> const& sink) {
+  using ResponseType = typename absl::variant_alternative<
+      1, decltype(std::declval<Result>()->Read())>::type;
+  auto const start = std::chrono::steady_clock::now();
+  auto stream = functor(std::move(context), request);
+  if (!stream) return stream;
+  return absl::make_unique<MetricsStreamingReadRpc<ResponseType>>(
+      std::move(stream), sink, where, start, request.ByteSizeLong());
+}
+
+template <typename Functor,
+          typename Result = google::cloud::internal::invoke_result_t<
+              Functor, google::cloud::CompletionQueue&,
+              std::unique_ptr<grpc::ClientContext>>>
+Result MetricsWrapper(Functor&& functor, google::cloud::CompletionQueue& cq,
+                      std::unique_ptr<grpc::ClientContext> context,
+                      char const* where,
+                      std::shared_ptr<RpcMetricsSink> const& sink) {
+  auto const start = std::chrono::steady_clock::now();
+  auto stream = functor(cq, std::move(context));
+  if (!stream) {
+    RecordRpcMetrics(*sink, where, start, 0, 0, StatusCode::kUnknown);
+    return stream;
+  }
+  return MakeMetricsAsyncStreamingReadWriteRpc(std::move(stream), sink, where,
+                                               start);
+}
+
+template <
+    typename Functor, typename Request,
+    typename Result = google::cloud::internal::invoke_result_t<
+        Functor, google::cloud::CompletionQueue&,
+        std::unique_ptr<grpc::ClientContext>, Request const&>,
+    typename std::enable_if<IsStatusOrFuture<Result>::value, int>::type = 0>
+Result MetricsWrapper(Functor&& functor, google::cloud::CompletionQueue& cq,
+                      std::unique_ptr<grpc::ClientContext> context,
+                      Request const& request, char const* where,
+                      std::shared_ptr<RpcMetricsSink> const& sink) {
+  auto const start = std::chrono::steady_clock::now();
+  auto const request_bytes = request.ByteSizeLong();
+  return functor(cq, std::move(context), request)
+      .then([sink, where, start, request_bytes](Result f) {
+        auto response = f.get();
+        RecordRpcMetrics(*sink, where, start, request_bytes,
+                         ResponseBytes(response), ResponseCode(response));
+        return response;
+      });
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_METRICS_WRAPPER_H
@@ -0,0 +1,276 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/metrics_wrapper.h"
+#include "absl/memory/memory.h"
+#include <google/protobuf/duration.pb.h>
+#include <google/protobuf/timestamp.pb.h>
+#include <gmock/gmock.h>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+using ::google::protobuf::Duration;
+using ::google::protobuf::Timestamp;
+
+class CaptureSink : public RpcMetricsSink {
+ public:
+  void Record(RpcMetricsSample const& sample) override {
+    samples.push_back(sample);
+  }
+
+  std::vector<RpcMetricsSample> samples;
+};
+
+Duration MakeRequest() {
+  Duration request;
+  request.set_seconds(123);
+  request.set_nanos(456);
+  return request;
+}
+
+Timestamp MakeResponse() {
+  Timestamp response;
+  response.set_seconds(1234567);
+  return response;
+}
+
+TEST(MetricsWrapper, StatusOrSuccess) {
+  auto sink = std::make_shared<CaptureSink>();
+  grpc::ClientContext context;
+  auto const request = MakeRequest();
+  auto response = MetricsWrapper(
+      [](grpc::ClientContext&, Duration const&) {
+        return make_status_or(MakeResponse());
+      },
+      context, request, "Service.Method", sink);
+  ASSERT_TRUE(response);
+
+  ASSERT_EQ(1, sink->samples.size());
+  auto const& s = sink->samples.front();
+  EXPECT_STREQ("Service.Method", s.method);
+  EXPECT_EQ(request.ByteSizeLong(), s.request_bytes);
+  EXPECT_EQ(response->ByteSizeLong(), s.response_bytes);
+  EXPECT_EQ(StatusCode::kOk, s.code);
+  EXPECT_LE(0, s.latency.count());
+}
+
+TEST(MetricsWrapper, StatusOrError) {
+  auto sink = std::make_shared<CaptureSink>();
+  grpc::ClientContext context;
+  auto response = MetricsWrapper(
+      [](grpc::ClientContext&, Duration const&) {
+        return StatusOr<Timestamp>(
+            Status(StatusCode::kUnavailable, "try-again"));
+      },
+      context, MakeRequest(), "Service.Method", sink);
+  EXPECT_EQ(StatusCode::kUnavailable, response.status().code());
+
+  ASSERT_EQ(1, sink->samples.size());
+  EXPECT_EQ(0, sink->samples.front().response_bytes);
+  EXPECT_EQ(StatusCode::kUnavailable, sink->samples.front().code);
+}
+
+TEST(MetricsWrapper, Status) {
+  auto sink = std::make_shared<CaptureSink>();
+  grpc::ClientContext context;
+  auto status = MetricsWrapper(
+      [](grpc::ClientContext&, Duration const&) {
+        return Status(StatusCode::kPermissionDenied, "uh-oh");
+      },
+      context, MakeRequest(), "Service.Method", sink);
+  EXPECT_EQ(StatusCode::kPermissionDenied, status.code());
+
+  ASSERT_EQ(1, sink->samples.size());
+  EXPECT_EQ(StatusCode::kPermissionDenied, sink->samples.front().code);
+}
+
+class FakeStream : public StreamingReadRpc<Timestamp> {
+ public:
+  explicit FakeStream(int count) : count_(count) {}
+
+  void Cancel() override {}
+  absl::variant<Status, Timestamp> Read() override {
+    if (count_ == 0) return Status(StatusCode::kUnavailable, "try-again");
+    --count_;
+    return MakeResponse();
+  }
+
+ private:
+  int count_;
+};
+
+TEST(MetricsWrapper, StreamingRead) {
+  auto sink = std::make_shared<CaptureSink>();
+  auto const request = MakeRequest();
+  auto stream = MetricsWrapper(
+      [](std::unique_ptr<grpc::ClientContext>, Duration const&) {
+        return std::unique_ptr<StreamingReadRpc<Timestamp>>(new FakeStream(3));
+      },
+      absl::make_unique<grpc::ClientContext>(), request, "Service.Stream",
+      sink);
+  ASSERT_TRUE(stream);
+
+  // Nothing is recorded until the stream is done.
+  for (int i = 0; i != 3; ++i) {
+    auto r = stream->Read();
+    EXPECT_TRUE(absl::holds_alternative<Timestamp>(r));
+    EXPECT_TRUE(sink->samples.empty());
+  }
+  auto r = stream->Read();
+  ASSERT_TRUE(absl::holds_alternative<Status>(r));
+
+  ASSERT_EQ(1, sink->samples.size());
+  auto const& s = sink->samples.front();
+  EXPECT_STREQ("Service.Stream", s.method);
+  EXPECT_EQ(request.ByteSizeLong(), s.request_bytes);
+  EXPECT_EQ(3 * MakeResponse().ByteSizeLong(), s.response_bytes);
+  EXPECT_EQ(StatusCode::kUnavailable, s.code);
+}
+
+TEST(MetricsWrapper, StreamingReadDestroyed) {
+  auto sink = std::make_shared<CaptureSink>();
+  auto stream = MetricsWrapper(
+      [](std::unique_ptr<grpc::ClientContext>, Duration const&) {
+        return std::unique_ptr<StreamingReadRpc<Timestamp>>(new FakeStream(3));
+      },
+      absl::make_unique<grpc::ClientContext>(), MakeRequest(),
+      "Service.Stream", sink);
+  ASSERT_TRUE(stream);
+  auto r = stream->Read();
+  EXPECT_TRUE(absl::holds_alternative<Timestamp>(r));
+  EXPECT_TRUE(sink->samples.empty());
+
+  stream.reset();
+  ASSERT_EQ(1, sink->samples.size());
+  auto const& s = sink->samples.front();
+  EXPECT_EQ(MakeResponse().ByteSizeLong(), s.response_bytes);
+  EXPECT_EQ(StatusCode::kCancelled, s.code);
+}
+
+class FakeReadWriteStream
+    : public AsyncStreamingReadWriteRpc<Duration, Timestamp> {
+ public:
+  void Cancel() override {}
+  future<bool> Start() override { return make_ready_future(true); }
+  future<absl::optional<Timestamp>> Read() override {
+    return make_ready_future(absl::make_optional(MakeResponse()));
+  }
+  future<bool> Write(Duration const&, grpc::WriteOptions) override {
+    return make_ready_future(true);
+  }
+  future<bool> WritesDone() override { return make_ready_future(true); }
+  future<Status> Finish() override {
+    return make_ready_future(Status(StatusCode::kAborted, "aborted"));
+  }
+};
+
+TEST(MetricsWrapper, ReadWriteStream) {
+  auto sink = std::make_shared<CaptureSink>();
+  CompletionQueue cq;
+  auto stream = MetricsWrapper(
+      [](CompletionQueue&, std::unique_ptr<grpc::ClientContext>) {
+        return std::unique_ptr<AsyncStreamingReadWriteRpc<Duration, Timestamp>>(
+            new FakeReadWriteStream);
+      },
+      cq, absl::make_unique<grpc::ClientContext>(), "Service.ReadWrite", sink);
+  ASSERT_TRUE(stream);
+
+  // Nothing is recorded until the stream is finished.
+  EXPECT_TRUE(stream->Start().get());
+  EXPECT_TRUE(stream->Write(MakeRequest(), grpc::WriteOptions{}).get());
+  EXPECT_TRUE(stream->Write(MakeRequest(), grpc::WriteOptions{}).get());
+  EXPECT_TRUE(stream->Read().get().has_value());
+  EXPECT_TRUE(stream->WritesDone().get());
+  EXPECT_TRUE(sink->samples.empty());
+  EXPECT_EQ(StatusCode::kAborted, stream->Finish().get().code());
+
+  ASSERT_EQ(1, sink->samples.size());
+  auto const& s = sink->samples.front();
+  EXPECT_STREQ("Service.ReadWrite", s.method);
+  EXPECT_EQ(2 * MakeRequest().ByteSizeLong(), s.request_bytes);
+  EXPECT_EQ(MakeResponse().ByteSizeLong(), s.response_bytes);
+  EXPECT_EQ(StatusCode::kAborted, s.code);
+
+  // Destroying a finished stream does not record it again.
+  stream.reset();
+  EXPECT_EQ(1, sink->samples.size());
+}
+
+TEST(MetricsWrapper, ReadWriteStreamDestroyed) {
+  auto sink = std::make_shared<CaptureSink>();
+  CompletionQueue cq;
+  auto stream = MetricsWrapper(
+      [](CompletionQueue&, std::unique_ptr<grpc::ClientContext>) {
+        return std::unique_ptr<AsyncStreamingReadWriteRpc<Duration, Timestamp>>(
+            new FakeReadWriteStream);
+      },
+      cq, absl::make_unique<grpc::ClientContext>(), "Service.ReadWrite", sink);
+  ASSERT_TRUE(stream);
+  EXPECT_TRUE(stream->Start().get());
+  EXPECT_TRUE(sink->samples.empty());
+
+  stream.reset();
+  ASSERT_EQ(1, sink->samples.size());
+  EXPECT_EQ(StatusCode::kCancelled, sink->samples.front().code);
+}
+
+TEST(MetricsWrapper, AsyncStatusOr) {
+  auto sink = std::make_shared<CaptureSink>();
+  CompletionQueue cq;
+  promise<StatusOr<Timestamp>> p;
+  auto response = MetricsWrapper(
+      [&p](CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
+           Duration const&) { return p.get_future(); },
+      cq, absl::make_unique<grpc::ClientContext>(), MakeRequest(),
+      "Service.Async", sink);
+
+  // Nothing is recorded until the future is satisfied.
+  EXPECT_TRUE(sink->samples.empty());
+  p.set_value(MakeResponse());
+  ASSERT_TRUE(response.get());
+
+  ASSERT_EQ(1, sink->samples.size());
+  EXPECT_EQ(MakeResponse().ByteSizeLong(),
+            sink->samples.front().response_bytes);
+  EXPECT_EQ(StatusCode::kOk, sink->samples.front().code);
+}
+
+TEST(MetricsWrapper, AsyncStatus) {
+  auto sink = std::make_shared<CaptureSink>();
+  CompletionQueue cq;
+  auto status = MetricsWrapper(
+                    [](CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
+                       Duration const&) {
+                      return make_ready_future(
+                          Status(StatusCode::kNotFound, "not found"));
+                    },
+                    cq, absl::make_unique<grpc::ClientContext>(),
+                    MakeRequest(), "Service.Async", sink)
+                    .get();
+  EXPECT_EQ(StatusCode::kNotFound, status.code());
+
+  ASSERT_EQ(1, sink->samples.size());
+  EXPECT_EQ(StatusCode::kNotFound, sink->samples.front().code);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
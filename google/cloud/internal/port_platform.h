@@ -89,6 +89,23 @@
 #  define GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS 1
 #endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
 
+// Discover if C++20 coroutines are available. This requires compiling with
+// C++20, and a standard library that implements `<coroutine>`. Note that some
+// compilers (e.g. GCC with `-fcoroutines`) define `__cpp_impl_coroutine` in
+// older C++ versions, but their `<coroutine>` header is empty in that case,
+// so we rely on the library feature test macro. Older compilers (or C++
+// versions) simply do not get the coroutine integration.
+#ifdef GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+#  error "GOOGLE_CLOUD_CPP_HAVE_COROUTINES should not be set directly."
+#elif __cplusplus >= 202002L && defined(__has_include)
+#  if __has_include(<version>)
+#    include <version>
+#  endif  // __has_include(<version>)
+#  if defined(__cpp_lib_coroutine) && __cpp_lib_coroutine >= 201902L
+#    define GOOGLE_CLOUD_CPP_HAVE_COROUTINES 1
+#  endif  // defined(__cpp_lib_coroutine) && __cpp_lib_coroutine >= 201902L
+#endif  // GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+
 // clang-format on
 
 #endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_PORT_PLATFORM_H
@@ -0,0 +1,174 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_RESUMABLE_STREAMING_READ_RPC_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_RESUMABLE_STREAMING_READ_RPC_H
+
+#include "google/cloud/backoff_policy.h"
+#include "google/cloud/internal/retry_policy.h"
+#include "google/cloud/internal/streaming_read_rpc.h"
+#include "google/cloud/status.h"
+#include "google/cloud/version.h"
+#include "absl/types/variant.h"
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * Create a new stream starting at the position recorded in @p request.
+ *
+ * The caller owns the `grpc::ClientContext`, so this is typically a lambda
+ * that creates the context, and then calls the stub.
+ */
+template <typename ResponseType, typename RequestType>
+using StreamFactory =
+    std::function<std::unique_ptr<StreamingReadRpc<ResponseType>>(
+        RequestType const&)>;
+
+/**
+ * Update @p request so a new stream resumes after @p response.
+ *
+ * Each service has its own way to resume streams, for example, using a
+ * resume token or an offset. The generator cannot infer this, so these
+ * functions are written by hand.
+ */
+template <typename ResponseType, typename RequestType>
+using RequestUpdater =
+    std::function<void(ResponseType const&, RequestType&)>;
+
+/**
+ * A streaming read RPC that resumes the stream on transient errors.
+ *
+ * Streaming read RPCs may be interrupted after they have delivered some
+ * data. Restarting them from the beginning would deliver the same data
+ * twice, so this class uses a `RequestUpdater` to record the progress of the
+ * stream in the request, and then creates a new stream using the updated
+ * request. The retry policy is reset each time the stream makes progress, so
+ * long running streams can recover from more than a handful of errors.
+ */
+template <typename ResponseType, typename RequestType>
+class ResumableStreamingReadRpc : public StreamingReadRpc<ResponseType> {
+ public:
+  using Sleeper = std::function<void(std::chrono::milliseconds)>;
+
+  template <typename RetryPolicyType>
+  ResumableStreamingReadRpc(
+      std::unique_ptr<RetryPolicyType> retry_policy,
+      std::unique_ptr<BackoffPolicy> backoff_policy, Sleeper sleeper,
+      StreamFactory<ResponseType, RequestType> stream_factory,
+      RequestUpdater<ResponseType, RequestType> updater, RequestType request)
+      : retry_policy_factory_(MakeRetryPolicyFactory(std::move(retry_policy))),
+        backoff_policy_prototype_(std::move(backoff_policy)),
+        sleeper_(std::move(sleeper)),
+        stream_factory_(std::move(stream_factory)),
+        updater_(std::move(updater)),
+        request_(std::move(request)) {}
+
+  ResumableStreamingReadRpc(ResumableStreamingReadRpc&&) = delete;
+  ResumableStreamingReadRpc& operator=(ResumableStreamingReadRpc&&) = delete;
+
+  void Cancel() override {
+    if (impl_) impl_->Cancel();
+  }
+
+  absl::variant<Status, ResponseType> Read() override {
+    if (!impl_) impl_ = stream_factory_(request_);
+    auto response = impl_->Read();
+    if (absl::holds_alternative<ResponseType>(response)) {
+      OnData(absl::get<ResponseType>(response));
+      return response;
+    }
+    auto last_status = absl::get<Status>(std::move(response));
+    if (last_status.ok()) return last_status;
+
+    // The stream failed, start a new retry loop if it made any progress since
+    // the last failure.
+    if (has_received_data_ || !retry_policy_) {
+      retry_policy_ = retry_policy_factory_();
+      backoff_policy_ = backoff_policy_prototype_->clone();
+    }
+    has_received_data_ = false;
+    while (retry_policy_->OnFailure(last_status)) {
+      sleeper_(backoff_policy_->OnCompletion());
+      impl_ = stream_factory_(request_);
+      response = impl_->Read();
+      if (absl::holds_alternative<ResponseType>(response)) {
+        OnData(absl::get<ResponseType>(response));
+        return response;
+      }
+      last_status = absl::get<Status>(std::move(response));
+      if (last_status.ok()) return last_status;
+    }
+    return last_status;
+  }
+
+ private:
+  template <typename RetryPolicyType>
+  static std::function<std::unique_ptr<RetryPolicy>()> MakeRetryPolicyFactory(
+      std::unique_ptr<RetryPolicyType> retry_policy) {
+    std::shared_ptr<RetryPolicyType> prototype(std::move(retry_policy));
+    return [prototype] {
+      return std::unique_ptr<RetryPolicy>(prototype->clone());
+    };
+  }
+
+  void OnData(ResponseType const& response) {
+    updater_(response, request_);
+    has_received_data_ = true;
+  }
+
+  std::function<std::unique_ptr<RetryPolicy>()> const retry_policy_factory_;
+  std::unique_ptr<BackoffPolicy> const backoff_policy_prototype_;
+  Sleeper const sleeper_;
+  StreamFactory<ResponseType, RequestType> const stream_factory_;
+  RequestUpdater<ResponseType, RequestType> const updater_;
+  RequestType request_;
+  std::unique_ptr<RetryPolicy> retry_policy_;
+  std::unique_ptr<BackoffPolicy> backoff_policy_;
+  std::unique_ptr<StreamingReadRpc<ResponseType>> impl_;
+  bool has_received_data_ = false;
+};
+
+/**
+ * Create a `ResumableStreamingReadRpc` that sleeps using the current thread.
+ *
+ * The `ResponseType` and `RequestType` parameters cannot be deduced from
+ * lambdas, callers must provide them explicitly.
+ */
+template <typename ResponseType, typename RequestType,
+          typename RetryPolicyType>
+std::unique_ptr<StreamingReadRpc<ResponseType>> MakeResumableStreamingReadRpc(
+    std::unique_ptr<RetryPolicyType> retry_policy,
+    std::unique_ptr<BackoffPolicy> backoff_policy,
+    StreamFactory<ResponseType, RequestType> stream_factory,
+    RequestUpdater<ResponseType, RequestType> updater, RequestType request) {
+  return std::unique_ptr<StreamingReadRpc<ResponseType>>(
+      new ResumableStreamingReadRpc<ResponseType, RequestType>(
+          std::move(retry_policy), std::move(backoff_policy),
+          [](std::chrono::milliseconds d) { std::this_thread::sleep_for(d); },
+          std::move(stream_factory), std::move(updater), std::move(request)));
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_RESUMABLE_STREAMING_READ_RPC_H
@@ -0,0 +1,189 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/resumable_streaming_read_rpc.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+
+struct FakeRequest {
+  std::string key;
+  std::string token;
+};
+
+struct FakeResponse {
+  std::string value;
+  std::string token;
+};
+
+struct TestRetryablePolicy {
+  static bool IsPermanentFailure(google::cloud::Status const& s) {
+    return !s.ok() && s.code() == StatusCode::kPermissionDenied;
+  }
+};
+
+using TestRetryPolicy = LimitedErrorCountRetryPolicy<TestRetryablePolicy>;
+
+/// A fake stream, returning the given responses and final status.
+class FakeStream : public StreamingReadRpc<FakeResponse> {
+ public:
+  explicit FakeStream(std::deque<absl::variant<Status, FakeResponse>> values)
+      : values_(std::move(values)) {}
+
+  void Cancel() override {}
+  absl::variant<Status, FakeResponse> Read() override {
+    if (values_.empty()) return Status{};
+    auto v = std::move(values_.front());
+    values_.pop_front();
+    return v;
+  }
+
+ private:
+  std::deque<absl::variant<Status, FakeResponse>> values_;
+};
+
+FakeResponse MakeResponse(std::string value) {
+  return FakeResponse{value, "token-" + value};
+}
+
+void UpdateRequest(FakeResponse const& response, FakeRequest& request) {
+  request.token = response.token;
+}
+
+struct ReadResult {
+  std::vector<std::string> values;
+  Status status;
+};
+
+ReadResult ReadAll(StreamingReadRpc<FakeResponse>& stream) {
+  ReadResult result;
+  for (;;) {
+    auto v = stream.Read();
+    if (absl::holds_alternative<Status>(v)) {
+      result.status = absl::get<Status>(std::move(v));
+      return result;
+    }
+    result.values.push_back(absl::get<FakeResponse>(std::move(v)).value);
+  }
+}
+
+class ResumableStreamingReadRpcTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<StreamingReadRpc<FakeResponse>> MakeReader(
+      int maximum_failures) {
+    return absl::make_unique<
+        ResumableStreamingReadRpc<FakeResponse, FakeRequest>>(
+        TestRetryPolicy(maximum_failures).clone(),
+        ExponentialBackoffPolicy(std::chrono::microseconds(1),
+                                 std::chrono::microseconds(5), 2.0)
+            .clone(),
+        [this](std::chrono::milliseconds) { ++sleep_count_; },
+        [this](FakeRequest const& request) {
+          EXPECT_EQ("test-key", request.key);
+          tokens_.push_back(request.token);
+          auto i = factory_calls_++;
+          EXPECT_LT(i, streams_.size());
+          return absl::make_unique<FakeStream>(
+              i < streams_.size() ? streams_[i] : streams_.back());
+        },
+        UpdateRequest, FakeRequest{"test-key", ""});
+  }
+
+  using Values = std::deque<absl::variant<Status, FakeResponse>>;
+  std::vector<Values> streams_;
+  std::vector<std::string> tokens_;
+  std::size_t factory_calls_ = 0;
+  int sleep_count_ = 0;
+};
+
+TEST_F(ResumableStreamingReadRpcTest, NoFailures) {
+  streams_ = {Values{MakeResponse("v0"), MakeResponse("v1"), Status{}}};
+  auto reader = MakeReader(3);
+  auto result = ReadAll(*reader);
+  EXPECT_THAT(result.status, StatusIs(StatusCode::kOk));
+  EXPECT_THAT(result.values, ElementsAre("v0", "v1"));
+  EXPECT_THAT(tokens_, ElementsAre(""));
+  EXPECT_EQ(0, sleep_count_);
+}
+
+TEST_F(ResumableStreamingReadRpcTest, ResumeWithUpdatedRequest) {
+  auto transient = Status(StatusCode::kUnavailable, "try-again");
+  streams_ = {
+      Values{MakeResponse("v0"), MakeResponse("v1"), transient},
+      Values{transient},
+      Values{MakeResponse("v2"), Status{}},
+  };
+  auto reader = MakeReader(3);
+  auto result = ReadAll(*reader);
+  EXPECT_THAT(result.status, StatusIs(StatusCode::kOk));
+  EXPECT_THAT(result.values, ElementsAre("v0", "v1", "v2"));
+  EXPECT_THAT(tokens_, ElementsAre("", "token-v1", "token-v1"));
+  EXPECT_EQ(2, sleep_count_);
+}
+
+TEST_F(ResumableStreamingReadRpcTest, PermanentError) {
+  streams_ = {Values{MakeResponse("v0"),
+                     Status(StatusCode::kPermissionDenied, "uh-oh")}};
+  auto reader = MakeReader(3);
+  auto result = ReadAll(*reader);
+  EXPECT_THAT(result.status, StatusIs(StatusCode::kPermissionDenied));
+  EXPECT_THAT(result.values, ElementsAre("v0"));
+  EXPECT_EQ(1, factory_calls_);
+}
+
+TEST_F(ResumableStreamingReadRpcTest, TooManyTransients) {
+  auto transient = Status(StatusCode::kUnavailable, "try-again");
+  streams_ = {Values{transient}, Values{transient}, Values{transient}};
+  auto reader = MakeReader(2);
+  auto result = ReadAll(*reader);
+  EXPECT_THAT(result.status, StatusIs(StatusCode::kUnavailable));
+  EXPECT_TRUE(result.values.empty());
+  EXPECT_EQ(3, factory_calls_);
+}
+
+/// @test Verify the retry policy is reset each time the stream makes progress.
+TEST_F(ResumableStreamingReadRpcTest, ProgressResetsRetryPolicy) {
+  auto transient = Status(StatusCode::kUnavailable, "try-again");
+  streams_ = {
+      Values{MakeResponse("v0"), transient},
+      Values{transient},
+      Values{MakeResponse("v1"), transient},
+      Values{transient},
+      Values{MakeResponse("v2"), Status{}},
+  };
+  auto reader = MakeReader(2);
+  auto result = ReadAll(*reader);
+  EXPECT_THAT(result.status, StatusIs(StatusCode::kOk));
+  EXPECT_THAT(result.values, ElementsAre("v0", "v1", "v2"));
+  EXPECT_THAT(tokens_, ElementsAre("", "token-v0", "token-v0", "token-v1",
+                                   "token-v1"));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
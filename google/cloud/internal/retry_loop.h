@@ -16,13 +16,14 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_RETRY_LOOP_H
 
 #include "google/cloud/backoff_policy.h"
+#include "google/cloud/backoff_sleeper.h"
 #include "google/cloud/internal/invoke_result.h"
 #include "google/cloud/internal/retry_loop_helpers.h"
 #include "google/cloud/internal/retry_policy.h"
+#include "google/cloud/retry_budget.h"
 #include "google/cloud/status_or.h"
 #include "google/cloud/version.h"
 #include <grpcpp/grpcpp.h>
-#include <thread>
 
 namespace google {
 namespace cloud {
@@ -45,10 +46,14 @@ namespace internal {
  *     stack can set timeouts and metadata through this context.
  * @param request the parameters for the request.
  * @param location a string to annotate any error returned by this function.
+ * @param budget if not null, the budget shared with other requests, retries
+ *     are only made while the budget allows them.
  * @tparam Functor the type of @p functor.
  * @tparam Request the type of @p request.
  * @tparam Sleeper a dependency injection point to verify (in tests) that the
- *     backoff policy is used.
+ *     backoff policy is used. `RetryLoop()` uses it to wait with a
+ *     `BackoffSleeper`, so applications can run other work during the backoff
+ *     instead of blocking the thread.
  * @return the result of the first successful call to @p functor, or a
  *     `google::cloud::Status` that indicates the final error for this request.
  */
@@ -61,7 +66,7 @@ auto RetryLoopImpl(std::unique_ptr<RetryPolicy> retry_policy,
                    std::unique_ptr<BackoffPolicy> backoff_policy,
                    Idempotency idempotency, Functor&& functor,
                    Request const& request, char const* location,
-                   Sleeper sleeper)
+                   Sleeper sleeper, std::shared_ptr<RetryBudget> budget = {})
     -> google::cloud::internal::invoke_result_t<Functor, grpc::ClientContext&,
                                                 Request const&> {
   Status last_status;
@@ -70,6 +75,7 @@ auto RetryLoopImpl(std::unique_ptr<RetryPolicy> retry_policy,
     grpc::ClientContext context;
     auto result = functor(context, request);
     if (result.ok()) {
+      if (budget) budget->OnSuccess();
       return result;
     }
     last_status = GetResultStatus(std::move(result));
@@ -82,6 +88,9 @@ auto RetryLoopImpl(std::unique_ptr<RetryPolicy> retry_policy,
       // way, exit the loop.
       break;
     }
+    if (budget && !budget->TryRetry()) {
+      return RetryLoopError("Retry budget exhausted in", location, last_status);
+    }
     sleeper(backoff_policy->OnCompletion());
   }
   if (!retry_policy->IsExhausted()) {
@@ -102,13 +111,15 @@ template <typename Functor, typename Request,
 auto RetryLoop(std::unique_ptr<RetryPolicy> retry_policy,
                std::unique_ptr<BackoffPolicy> backoff_policy,
                Idempotency idempotency, Functor&& functor,
-               Request const& request, char const* location)
+               Request const& request, char const* location,
+               std::shared_ptr<RetryBudget> budget = {},
+               BackoffSleeper sleeper = {})
     -> google::cloud::internal::invoke_result_t<Functor, grpc::ClientContext&,
                                                 Request const&> {
-  return RetryLoopImpl(
-      std::move(retry_policy), std::move(backoff_policy), idempotency,
-      std::forward<Functor>(functor), request, location,
-      [](std::chrono::milliseconds p) { std::this_thread::sleep_for(p); });
+  if (!sleeper) sleeper = DefaultBackoffSleeper();
+  return RetryLoopImpl(std::move(retry_policy), std::move(backoff_policy),
+                       idempotency, std::forward<Functor>(functor), request,
+                       location, std::move(sleeper), std::move(budget));
 }
 
 }  // namespace internal
@@ -120,6 +120,32 @@ TEST(RetryLoopTest, UsesBackoffPolicy) {
               ElementsAre(ms(10), std::chrono::milliseconds(20), ms(30)));
 }
 
+/// @test Verify the public `RetryLoop()` waits using the `BackoffSleeper`.
+TEST(RetryLoopTest, UsesBackoffSleeper) {
+  using ms = std::chrono::milliseconds;
+
+  std::unique_ptr<MockBackoffPolicy> mock(new MockBackoffPolicy);
+  EXPECT_CALL(*mock, OnCompletion())
+      .WillOnce(Return(ms(10)))
+      .WillOnce(Return(ms(20)));
+
+  int counter = 0;
+  std::vector<ms> sleep_for;
+  StatusOr<int> actual = RetryLoop(
+      TestRetryPolicy(), std::move(mock), Idempotency::kIdempotent,
+      [&counter](grpc::ClientContext&, int request) {
+        if (++counter <= 2) {
+          return StatusOr<int>(Status(StatusCode::kUnavailable, "try again"));
+        }
+        return StatusOr<int>(2 * request);
+      },
+      42, "error message", nullptr,
+      [&sleep_for](ms p) { sleep_for.push_back(p); });
+  EXPECT_STATUS_OK(actual);
+  EXPECT_EQ(84, *actual);
+  EXPECT_THAT(sleep_for, ElementsAre(ms(10), ms(20)));
+}
+
 TEST(RetryLoopTest, TransientFailureNonIdempotent) {
   StatusOr<int> actual = RetryLoop(
       TestRetryPolicy(), TestBackoffPolicy(), Idempotency::kNonIdempotent,
@@ -159,6 +185,36 @@ TEST(RetryLoopTest, TooManyTransientFailuresIdempotent) {
   EXPECT_THAT(actual.status().message(), HasSubstr("Retry policy exhausted"));
 }
 
+TEST(RetryLoopTest, RetryBudget) {
+  auto budget = std::make_shared<RetryBudget>(0.5, 1.0);
+  int counter = 0;
+  auto transient_then_success = [&](grpc::ClientContext&, int request) {
+    if (++counter % 2 == 1) {
+      return StatusOr<int>(Status(StatusCode::kUnavailable, "try again"));
+    }
+    return StatusOr<int>(2 * request);
+  };
+  StatusOr<int> actual =
+      RetryLoop(TestRetryPolicy(), TestBackoffPolicy(),
+                Idempotency::kIdempotent, transient_then_success, 42,
+                "error message", budget);
+  EXPECT_STATUS_OK(actual);
+  EXPECT_EQ(2, counter);
+  EXPECT_EQ(1, budget->permitted_retries());
+  EXPECT_DOUBLE_EQ(0.5, budget->tokens());
+
+  // There is not enough budget left to retry.
+  actual = RetryLoop(TestRetryPolicy(), TestBackoffPolicy(),
+                     Idempotency::kIdempotent, transient_then_success, 42,
+                     "the answer to everything", budget);
+  EXPECT_EQ(3, counter);
+  EXPECT_EQ(StatusCode::kUnavailable, actual.status().code());
+  EXPECT_THAT(actual.status().message(), HasSubstr("try again"));
+  EXPECT_THAT(actual.status().message(), HasSubstr("the answer to everything"));
+  EXPECT_THAT(actual.status().message(), HasSubstr("Retry budget exhausted"));
+  EXPECT_EQ(1, budget->throttled_retries());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
@@ -0,0 +1,101 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_STREAM_RANGE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_STREAM_RANGE_H
+
+#include "google/cloud/internal/pagination_range.h"
+#include "google/cloud/status.h"
+#include "google/cloud/status_or.h"
+#include "google/cloud/version.h"
+#include "absl/types/variant.h"
+#include <functional>
+#include <utility>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * Adapt streaming read RPCs to look like input ranges.
+ *
+ * Streaming read RPCs return a sequence of messages followed by a final
+ * status. We want to expose these APIs as input ranges of `StatusOr<T>`, like
+ * the ranges returned by `PaginationRange`, this class performs that work.
+ *
+ * A successful status ends the range. An error status is returned as the last
+ * element of the range.
+ *
+ * @tparam T the type of the items, typically the response proto.
+ */
+template <typename T>
+class StreamRange {
+ public:
+  /// Returns the next element in the stream, or the final status.
+  using Reader = std::function<absl::variant<Status, T>()>;
+
+  explicit StreamRange(Reader reader) : reader_(std::move(reader)) {}
+
+  /// The iterator type for this Range.
+  using iterator = PaginationIterator<T, StreamRange>;
+
+  /**
+   * Return an iterator over the range of `T` objects.
+   *
+   * The returned iterator is a single-pass input iterator that reads new `T`
+   * objects from the underlying stream when incremented.
+   *
+   * Creating, and particularly incrementing, multiple iterators on the same
+   * StreamRange<> is unsupported and can produce incorrect results.
+   */
+  iterator begin() { return GetNext(); }
+
+  /// Return an iterator pointing to the end of the stream.
+  iterator end() { return iterator{}; }
+
+ private:
+  friend class PaginationIterator<T, StreamRange>;
+
+  iterator GetNext() {
+    static Status const kPastTheEndError(
+        StatusCode::kFailedPrecondition,
+        "Cannot iterating past the end of StreamRange");
+    if (done_) return iterator(nullptr, kPastTheEndError);
+    auto next = reader_();
+    if (absl::holds_alternative<T>(next)) {
+      return iterator(this, absl::get<T>(std::move(next)));
+    }
+    done_ = true;
+    auto status = absl::get<Status>(std::move(next));
+    if (status.ok()) return end();
+    return iterator(this, std::move(status));
+  }
+
+  Reader reader_;
+  bool done_ = false;
+};
+
+/// Create a `StreamRange<T>` from a function returning each element.
+template <typename T>
+StreamRange<T> MakeStreamRange(typename StreamRange<T>::Reader reader) {
+  return StreamRange<T>(std::move(reader));
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_STREAM_RANGE_H
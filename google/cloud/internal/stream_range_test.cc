@@ -0,0 +1,89 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/stream_range.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+
+StreamRange<std::string>::Reader MakeReader(
+    std::deque<absl::variant<Status, std::string>> values) {
+  auto state =
+      std::make_shared<std::deque<absl::variant<Status, std::string>>>(
+          std::move(values));
+  return [state]() -> absl::variant<Status, std::string> {
+    EXPECT_FALSE(state->empty());
+    if (state->empty()) return Status{};
+    auto v = std::move(state->front());
+    state->pop_front();
+    return v;
+  };
+}
+
+TEST(StreamRange, Empty) {
+  auto range = MakeStreamRange<std::string>(MakeReader({Status{}}));
+  EXPECT_TRUE(range.begin() == range.end());
+}
+
+TEST(StreamRange, Values) {
+  auto range = MakeStreamRange<std::string>(
+      MakeReader({std::string("a"), std::string("b"), std::string("c"),
+                  Status{}}));
+  std::vector<std::string> values;
+  for (auto& v : range) {
+    ASSERT_STATUS_OK(v);
+    values.push_back(*v);
+  }
+  EXPECT_THAT(values, ElementsAre("a", "b", "c"));
+}
+
+TEST(StreamRange, ErrorIsLastElement) {
+  auto range = MakeStreamRange<std::string>(MakeReader(
+      {std::string("a"), Status(StatusCode::kPermissionDenied, "uh-oh")}));
+  std::vector<StatusOr<std::string>> values;
+  for (auto& v : range) values.push_back(std::move(v));
+  ASSERT_EQ(2, values.size());
+  ASSERT_STATUS_OK(values[0]);
+  EXPECT_EQ("a", *values[0]);
+  EXPECT_THAT(values[1], StatusIs(StatusCode::kPermissionDenied));
+}
+
+TEST(StreamRange, PastTheEnd) {
+  auto range = MakeStreamRange<std::string>(
+      MakeReader({Status(StatusCode::kUnavailable, "try-again")}));
+  auto it = range.begin();
+  ASSERT_NE(it, range.end());
+  EXPECT_THAT(*it, StatusIs(StatusCode::kUnavailable));
+  ++it;
+  EXPECT_EQ(it, range.end());
+  EXPECT_THAT(*it, StatusIs(StatusCode::kFailedPrecondition));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
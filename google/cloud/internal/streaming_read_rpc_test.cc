@@ -0,0 +1,115 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/streaming_read_rpc.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::Return;
+
+struct FakeResponse {
+  std::string value;
+};
+
+class MockReader : public grpc::ClientReaderInterface<FakeResponse> {
+ public:
+  MOCK_METHOD0(WaitForInitialMetadata, void());
+  MOCK_METHOD0(Finish, grpc::Status());
+  MOCK_METHOD1(NextMessageSize, bool(std::uint32_t*));
+  MOCK_METHOD1(Read, bool(FakeResponse*));
+};
+
+TEST(StreamingReadRpcImpl, SuccessfulStream) {
+  auto mock = absl::make_unique<MockReader>();
+  EXPECT_CALL(*mock, Read(_))
+      .WillOnce([](FakeResponse* r) {
+        r->value = "value-0";
+        return true;
+      })
+      .WillOnce([](FakeResponse* r) {
+        r->value = "value-1";
+        return true;
+      })
+      .WillOnce(Return(false));
+  EXPECT_CALL(*mock, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  StreamingReadRpcImpl<FakeResponse> impl(
+      absl::make_unique<grpc::ClientContext>(), std::move(mock));
+  std::vector<std::string> values;
+  for (;;) {
+    auto v = impl.Read();
+    if (absl::holds_alternative<FakeResponse>(v)) {
+      values.push_back(absl::get<FakeResponse>(std::move(v)).value);
+      continue;
+    }
+    EXPECT_THAT(absl::get<Status>(std::move(v)), StatusIs(StatusCode::kOk));
+    break;
+  }
+  EXPECT_THAT(values, ElementsAre("value-0", "value-1"));
+}
+
+TEST(StreamingReadRpcImpl, ErrorInStream) {
+  auto mock = absl::make_unique<MockReader>();
+  EXPECT_CALL(*mock, Read(_))
+      .WillOnce([](FakeResponse* r) {
+        r->value = "value-0";
+        return true;
+      })
+      .WillOnce(Return(false));
+  EXPECT_CALL(*mock, Finish())
+      .WillOnce(Return(grpc::Status(grpc::StatusCode::PERMISSION_DENIED,
+                                    "uh-oh")));
+
+  StreamingReadRpcImpl<FakeResponse> impl(
+      absl::make_unique<grpc::ClientContext>(), std::move(mock));
+  auto v = impl.Read();
+  ASSERT_TRUE(absl::holds_alternative<FakeResponse>(v));
+  EXPECT_EQ("value-0", absl::get<FakeResponse>(v).value);
+  v = impl.Read();
+  ASSERT_TRUE(absl::holds_alternative<Status>(v));
+  EXPECT_THAT(absl::get<Status>(v), StatusIs(StatusCode::kPermissionDenied));
+}
+
+TEST(StreamingReadRpcImpl, DrainsStreamOnDestruction) {
+  auto mock = absl::make_unique<MockReader>();
+  EXPECT_CALL(*mock, Read(_))
+      .WillOnce(Return(true))
+      .WillOnce(Return(true))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*mock, Finish())
+      .WillOnce(Return(grpc::Status(grpc::StatusCode::CANCELLED, "cancel")));
+
+  StreamingReadRpcImpl<FakeResponse> impl(
+      absl::make_unique<grpc::ClientContext>(), std::move(mock));
+  auto v = impl.Read();
+  EXPECT_TRUE(absl::holds_alternative<FakeResponse>(v));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
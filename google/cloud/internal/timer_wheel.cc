@@ -0,0 +1,156 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/timer_wheel.h"
+#include <algorithm>
+#include <limits>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+std::size_t constexpr TimerWheel::kSlotBits;
+std::size_t constexpr TimerWheel::kSlots;
+std::size_t constexpr TimerWheel::kLevels;
+
+TimerWheel::TimerWheel(std::int64_t next_tick) : next_tick_(next_tick) {
+  for (auto& head : heads_) head.prev_ = head.next_ = &head;
+}
+
+void TimerWheel::Insert(TimerWheelNode* node, std::int64_t expiry_tick) {
+  node->expiry_tick_ = expiry_tick;
+  Link(node);
+  ++size_;
+}
+
+bool TimerWheel::Remove(TimerWheelNode* node) {
+  if (!node->linked()) return false;
+  Unlink(node);
+  --size_;
+  return true;
+}
+
+std::vector<TimerWheelNode*> TimerWheel::Advance(std::int64_t now_tick) {
+  std::vector<TimerWheelNode*> expired;
+  while (next_tick_ <= now_tick) {
+    if (size_ == 0) {
+      next_tick_ = now_tick + 1;
+      break;
+    }
+    // Skip the ticks where no timers expire or cascade.
+    auto const skip_to = (std::min)(NextEventTick(), now_tick + 1);
+    if (skip_to != next_tick_) {
+      next_tick_ = skip_to;
+      continue;
+    }
+    Cascade(1);
+    auto& head = Head(0, SlotIndex(next_tick_, 0));
+    while (!Empty(head)) {
+      auto* node = head.next_;
+      Unlink(node);
+      --size_;
+      expired.push_back(node);
+    }
+    ++next_tick_;
+  }
+  return expired;
+}
+
+std::vector<TimerWheelNode*> TimerWheel::Clear() {
+  std::vector<TimerWheelNode*> nodes;
+  nodes.reserve(size_);
+  for (auto& head : heads_) {
+    while (!Empty(head)) {
+      auto* node = head.next_;
+      Unlink(node);
+      nodes.push_back(node);
+    }
+  }
+  size_ = 0;
+  return nodes;
+}
+
+std::int64_t TimerWheel::NextEventTick() const {
+  // The nodes in the first level expire in the next `kSlots` ticks.
+  auto result = (std::numeric_limits<std::int64_t>::max)();
+  auto const end = next_tick_ + static_cast<std::int64_t>(kSlots);
+  for (auto tick = next_tick_; tick != end; ++tick) {
+    if (!Empty(Head(0, SlotIndex(tick, 0)))) {
+      result = tick;
+      break;
+    }
+  }
+  // The nodes in higher levels are cascaded when the lower levels wrap around.
+  // If `next_tick_` is at such a boundary the current slot has not been
+  // cascaded yet.
+  for (std::size_t level = 1; level != kLevels; ++level) {
+    auto const shift = kSlotBits * level;
+    auto const aligned = next_tick_ % LevelRange(level - 1) == 0;
+    auto const base = next_tick_ >> shift;
+    auto const first = aligned ? 0 : 1;
+    for (auto i = first; i != first + static_cast<int>(kSlots); ++i) {
+      auto const boundary = (base + i) << shift;
+      if (boundary >= result) break;
+      if (Empty(Head(level, SlotIndex(boundary, level)))) continue;
+      result = boundary;
+      break;
+    }
+  }
+  return result;
+}
+
+void TimerWheel::Link(TimerWheelNode* node) {
+  auto const tick = (std::max)(node->expiry_tick_, next_tick_);
+  auto const delta = tick - next_tick_;
+  std::size_t level = 0;
+  while (level + 1 != kLevels && delta >= LevelRange(level)) ++level;
+  // Timers beyond the range of the wheel go to the last slot that is in range,
+  // when that slot is cascaded they are inserted again.
+  auto const slot_tick =
+      delta < LevelRange(level) ? tick : next_tick_ + LevelRange(level) - 1;
+  auto& head = Head(level, SlotIndex(slot_tick, level));
+  node->next_ = &head;
+  node->prev_ = head.prev_;
+  head.prev_->next_ = node;
+  head.prev_ = node;
+}
+
+void TimerWheel::Unlink(TimerWheelNode* node) {
+  node->prev_->next_ = node->next_;
+  node->next_->prev_ = node->prev_;
+  node->prev_ = node->next_ = nullptr;
+}
+
+void TimerWheel::Cascade(std::size_t level) {
+  if (level == kLevels || next_tick_ % LevelRange(level - 1) != 0) return;
+  Cascade(level + 1);
+  auto& head = Head(level, SlotIndex(next_tick_, level));
+  if (Empty(head)) return;
+  // Detach the list before inserting the nodes again, as they may be inserted
+  // in the same slot.
+  auto* node = head.next_;
+  head.prev_->next_ = nullptr;
+  head.prev_ = head.next_ = &head;
+  while (node != nullptr) {
+    auto* next = node->next_;
+    Link(node);
+    node = next;
+  }
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,150 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_TIMER_WHEEL_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_TIMER_WHEEL_H
+
+#include "google/cloud/version.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+class TimerWheel;
+
+/**
+ * The timers stored in a `TimerWheel`.
+ *
+ * The wheel does not own the nodes, it only links them into intrusive lists.
+ * The owner must remove the node from the wheel before destroying it.
+ */
+class TimerWheelNode {
+ public:
+  TimerWheelNode() = default;
+  TimerWheelNode(TimerWheelNode const&) = delete;
+  TimerWheelNode& operator=(TimerWheelNode const&) = delete;
+
+  /// The tick at which the timer expires.
+  std::int64_t expiry_tick() const { return expiry_tick_; }
+
+  /// Whether the node is stored in a wheel.
+  bool linked() const { return prev_ != nullptr; }
+
+ private:
+  friend class TimerWheel;
+
+  TimerWheelNode* prev_ = nullptr;
+  TimerWheelNode* next_ = nullptr;
+  std::int64_t expiry_tick_ = 0;
+};
+
+/**
+ * A hierarchical timer wheel.
+ *
+ * Stores timers, identified by their expiration "tick", with O(1) insertion
+ * and removal. The wheel has `kLevels` levels of `kSlots` slots each, the
+ * slots in level `i` hold timers expiring `kSlots^i` to `kSlots^(i+1)` ticks
+ * in the future. As time advances the timers in the higher levels are moved
+ * ("cascaded") to the lower levels, and the timers in the first level expire.
+ * Timers beyond the range of the wheel are stored in the last level, and
+ * cascaded until they are in range.
+ *
+ * The wheel does not read any clock, the caller converts times to ticks, for
+ * example, milliseconds since the epoch, and advances the wheel.
+ *
+ * This class is not thread-safe.
+ */
+class TimerWheel {
+ public:
+  static std::size_t constexpr kSlotBits = 6;
+  static std::size_t constexpr kSlots = std::size_t{1} << kSlotBits;
+  static std::size_t constexpr kLevels = 4;
+
+  /// Create an empty wheel, where the first tick to process is @p next_tick.
+  explicit TimerWheel(std::int64_t next_tick);
+  ~TimerWheel() = default;
+
+  // The lists point to the heads stored in the wheel, it cannot be copied or
+  // moved.
+  TimerWheel(TimerWheel const&) = delete;
+  TimerWheel& operator=(TimerWheel const&) = delete;
+
+  /**
+   * Add @p node to the wheel, expiring at @p expiry_tick.
+   *
+   * Timers that have already expired are returned by the next call to
+   * `Advance()`.
+   */
+  void Insert(TimerWheelNode* node, std::int64_t expiry_tick);
+
+  /// Remove @p node from the wheel, returns false if it was not in the wheel.
+  bool Remove(TimerWheelNode* node);
+
+  /**
+   * Process all the ticks up to, and including, @p now_tick.
+   *
+   * @return the nodes (removed from the wheel) that expired in those ticks.
+   */
+  std::vector<TimerWheelNode*> Advance(std::int64_t now_tick);
+
+  /// Remove all the nodes from the wheel.
+  std::vector<TimerWheelNode*> Clear();
+
+  /**
+   * The next tick at which `Advance()` needs to be called.
+   *
+   * At this tick some timers expire, or are cascaded to lower levels. The
+   * wheel must not be empty.
+   */
+  std::int64_t NextEventTick() const;
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+ private:
+  static std::int64_t LevelRange(std::size_t level) {
+    return std::int64_t{1} << (kSlotBits * (level + 1));
+  }
+  static std::size_t SlotIndex(std::int64_t tick, std::size_t level) {
+    return static_cast<std::size_t>(tick >> (kSlotBits * level)) &
+           (kSlots - 1);
+  }
+  TimerWheelNode& Head(std::size_t level, std::size_t slot) {
+    return heads_[level * kSlots + slot];
+  }
+  TimerWheelNode const& Head(std::size_t level, std::size_t slot) const {
+    return heads_[level * kSlots + slot];
+  }
+  static bool Empty(TimerWheelNode const& head) { return head.next_ == &head; }
+
+  void Link(TimerWheelNode* node);
+  static void Unlink(TimerWheelNode* node);
+  void Cascade(std::size_t level);
+
+  std::int64_t next_tick_;
+  std::size_t size_ = 0;
+  std::array<TimerWheelNode, kLevels * kSlots> heads_;
+};
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_TIMER_WHEEL_H
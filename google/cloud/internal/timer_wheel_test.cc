@@ -0,0 +1,168 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/timer_wheel.h"
+#include "google/cloud/internal/random.h"
+#include <gmock/gmock.h>
+#include <deque>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::UnorderedElementsAre;
+
+std::vector<std::int64_t> Ticks(std::vector<TimerWheelNode*> const& nodes) {
+  std::vector<std::int64_t> ticks;
+  for (auto const* n : nodes) ticks.push_back(n->expiry_tick());
+  return ticks;
+}
+
+TEST(TimerWheel, Basic) {
+  TimerWheel wheel(100);
+  TimerWheelNode a;
+  TimerWheelNode b;
+  TimerWheelNode c;
+  wheel.Insert(&a, 105);
+  wheel.Insert(&b, 110);
+  wheel.Insert(&c, 105);
+  EXPECT_EQ(3, wheel.size());
+  EXPECT_TRUE(a.linked());
+
+  EXPECT_THAT(wheel.Advance(104), IsEmpty());
+  EXPECT_THAT(wheel.Advance(105), ElementsAre(&a, &c));
+  EXPECT_FALSE(a.linked());
+  EXPECT_EQ(1, wheel.size());
+  EXPECT_THAT(wheel.Advance(200), ElementsAre(&b));
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheel, ExpiredOnInsert) {
+  TimerWheel wheel(100);
+  TimerWheelNode a;
+  wheel.Insert(&a, 50);
+  EXPECT_EQ(100, wheel.NextEventTick());
+  EXPECT_THAT(wheel.Advance(99), IsEmpty());
+  EXPECT_THAT(wheel.Advance(100), ElementsAre(&a));
+}
+
+TEST(TimerWheel, Remove) {
+  TimerWheel wheel(0);
+  TimerWheelNode a;
+  TimerWheelNode b;
+  wheel.Insert(&a, 10);
+  wheel.Insert(&b, 100000);
+  EXPECT_TRUE(wheel.Remove(&a));
+  EXPECT_FALSE(wheel.Remove(&a));
+  EXPECT_TRUE(wheel.Remove(&b));
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_THAT(wheel.Advance(200000), IsEmpty());
+}
+
+TEST(TimerWheel, Clear) {
+  TimerWheel wheel(0);
+  TimerWheelNode a;
+  TimerWheelNode b;
+  wheel.Insert(&a, 10);
+  wheel.Insert(&b, 100000);
+  EXPECT_THAT(wheel.Clear(), UnorderedElementsAre(&a, &b));
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_FALSE(a.linked());
+  EXPECT_FALSE(b.linked());
+}
+
+TEST(TimerWheel, BeyondRange) {
+  TimerWheel wheel(0);
+  auto const range = std::int64_t{1}
+                     << (TimerWheel::kSlotBits * TimerWheel::kLevels);
+  TimerWheelNode a;
+  TimerWheelNode b;
+  wheel.Insert(&a, 3 * range + 7);
+  wheel.Insert(&b, range);
+  EXPECT_THAT(wheel.Advance(range - 1), IsEmpty());
+  EXPECT_THAT(wheel.Advance(range), ElementsAre(&b));
+  EXPECT_THAT(wheel.Advance(3 * range + 6), IsEmpty());
+  EXPECT_THAT(wheel.Advance(3 * range + 7), ElementsAre(&a));
+}
+
+/// @test Verify each timer expires exactly at its tick, as the wheel advances
+/// one tick at a time, and by larger jumps, while new timers are added.
+TEST(TimerWheel, ExpiresInOrder) {
+  auto generator = MakeDefaultPRNG();
+  for (std::int64_t max_jump : {1, 7, 100, 5000}) {
+    SCOPED_TRACE("max_jump=" + std::to_string(max_jump));
+    std::int64_t now = 123456;
+    TimerWheel wheel(now + 1);
+    std::deque<TimerWheelNode> nodes(4000);
+    std::uniform_int_distribution<std::int64_t> delay(1, 300000);
+    auto insert = nodes.begin();
+    for (; insert != nodes.begin() + 2000; ++insert) {
+      wheel.Insert(&*insert, now + delay(generator));
+    }
+
+    std::uniform_int_distribution<std::int64_t> jump(1, max_jump);
+    while (!wheel.empty()) {
+      // Keep adding timers as the wheel advances.
+      if (insert != nodes.end()) {
+        wheel.Insert(&*insert, now + delay(generator));
+        ++insert;
+      }
+      auto const next_event = wheel.NextEventTick();
+      ASSERT_GT(next_event, now);
+      auto const target = now + jump(generator);
+      // Nothing happens before the next event.
+      if (target < next_event) {
+        ASSERT_THAT(wheel.Advance(target), IsEmpty());
+        now = target;
+        continue;
+      }
+      auto const previous = now;
+      now = target;
+      for (auto const tick : Ticks(wheel.Advance(now))) {
+        ASSERT_GT(tick, previous);
+        ASSERT_LE(tick, now);
+      }
+    }
+    for (auto const& n : nodes) ASSERT_FALSE(n.linked());
+  }
+}
+
+/// @test Verify `NextEventTick()` is never later than the earliest timer.
+TEST(TimerWheel, NextEventTick) {
+  auto generator = MakeDefaultPRNG();
+  std::uniform_int_distribution<std::int64_t> delay(0, 1000000);
+  std::int64_t now = 0;
+  TimerWheel wheel(now + 1);
+  std::deque<TimerWheelNode> nodes(100);
+  for (auto& n : nodes) {
+    auto const deadline = now + 1 + delay(generator);
+    wheel.Insert(&n, deadline);
+    auto const next_event = wheel.NextEventTick();
+    ASSERT_LE(next_event, deadline);
+    ASSERT_GT(next_event, now);
+    now = (std::max)(now, next_event - 1);
+    auto expired = wheel.Advance(now);
+    EXPECT_THAT(expired, IsEmpty());
+  }
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
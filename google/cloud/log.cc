@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/log.h"
+#include "google/cloud/async_log_backend.h"
 #include "google/cloud/internal/getenv.h"
 #include "absl/time/time.h"
 #include <array>
@@ -64,21 +65,21 @@ std::ostream& operator<<(std::ostream& os, Severity x) {
 
 std::ostream& operator<<(std::ostream& os, LogRecord const& rhs) {
   return os << Timestamp{rhs.timestamp} << " [" << rhs.severity << "]"
-            << " <" << std::this_thread::get_id() << ">"
+            << " <" << rhs.thread_id << ">"
             << " " << rhs.message << " (" << rhs.filename << ':' << rhs.lineno
             << ')';
 }
 
 LogSink::LogSink()
     : empty_(true),
-      minimum_severity_(static_cast<int>(Severity::GCP_LS_LOWEST_ENABLED)) {}
+      minimum_severity_(static_cast<int>(Severity::GCP_LS_LOWEST_ENABLED)),
+      backends_(std::make_shared<BackendMap>()) {}
 
 LogSink& LogSink::Instance() {
   static auto* const kInstance = [] {
     auto* p = new LogSink;
-    if (internal::GetEnv("GOOGLE_CLOUD_CPP_ENABLE_CLOG").has_value()) {
-      p->EnableStdClogImpl();
-    }
+    auto clog = internal::GetEnv("GOOGLE_CLOUD_CPP_ENABLE_CLOG");
+    if (clog.has_value()) p->EnableStdClogImpl(*clog == "async");
     return p;
   }();
   return *kInstance;
@@ -98,24 +99,25 @@ void LogSink::RemoveBackend(long id) {
 
 void LogSink::ClearBackends() {
   std::unique_lock<std::mutex> lk(mu_);
-  backends_.clear();
+  SetBackends({});
   clog_backend_id_ = 0;
-  empty_.store(backends_.empty());
 }
 
 std::size_t LogSink::BackendCount() const {
   std::unique_lock<std::mutex> lk(mu_);
-  return backends_.size();
+  return backends_->size();
 }
 
 void LogSink::Log(LogRecord log_record) {
-  // Make a copy of the backends because calling user-defined functions while
-  // holding a lock is a bad idea: the application may change the backends while
-  // we are holding this lock, and soon deadlock occurs.
-  auto copy = [this]() {
+  // Keep a reference to the backends because calling user-defined functions
+  // while holding a lock is a bad idea: the application may change the backends
+  // while we are holding this lock, and soon deadlock occurs. The map is never
+  // modified once published, so copying the pointer is enough.
+  auto backends = [this]() {
     std::unique_lock<std::mutex> lk(mu_);
     return backends_;
   }();
+  auto const& copy = *backends;
   if (copy.empty()) {
     return;
   }
@@ -151,12 +153,14 @@ class StdClogBackend : public LogBackend {
 };
 }  // namespace
 
-void LogSink::EnableStdClogImpl() {
+void LogSink::EnableStdClogImpl(bool async) {
   std::unique_lock<std::mutex> lk(mu_);
   if (clog_backend_id_ != 0) {
     return;
   }
-  clog_backend_id_ = AddBackendImpl(std::make_shared<StdClogBackend>());
+  std::shared_ptr<LogBackend> backend = std::make_shared<StdClogBackend>();
+  if (async) backend = std::make_shared<AsyncLogBackend>(std::move(backend));
+  clog_backend_id_ = AddBackendImpl(std::move(backend));
 }
 
 void LogSink::DisableStdClogImpl() {
@@ -171,19 +175,26 @@ void LogSink::DisableStdClogImpl() {
 // NOLINTNEXTLINE(google-runtime-int)
 long LogSink::AddBackendImpl(std::shared_ptr<LogBackend> backend) {
   auto const id = ++next_id_;
-  backends_.emplace(id, std::move(backend));
-  empty_.store(backends_.empty());
+  auto copy = *backends_;
+  copy.emplace(id, std::move(backend));
+  SetBackends(std::move(copy));
   return id;
 }
 
 // NOLINTNEXTLINE(google-runtime-int)
 void LogSink::RemoveBackendImpl(long id) {
-  auto it = backends_.find(id);
-  if (backends_.end() == it) {
+  auto it = backends_->find(id);
+  if (backends_->end() == it) {
     return;
   }
-  backends_.erase(it);
-  empty_.store(backends_.empty());
+  auto copy = *backends_;
+  copy.erase(id);
+  SetBackends(std::move(copy));
+}
+
+void LogSink::SetBackends(BackendMap backends) {
+  empty_.store(backends.empty());
+  backends_ = std::make_shared<BackendMap const>(std::move(backends));
 }
 
 }  // namespace GOOGLE_CLOUD_CPP_NS
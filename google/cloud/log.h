@@ -61,7 +61,9 @@
  * Alternatively, the application can enable logging to `std::clog` without any
  * code changes or recompiling by setting the "GOOGLE_CLOUD_CPP_ENABLE_CLOG"
  * environment variable before the program starts. The existence of this
- * variable is all that matters; the value is ignored.
+ * variable is all that matters; the value is ignored, unless it is `async`, in
+ * which case the log lines are written to `std::clog` by a background thread,
+ * see `AsyncLogBackend` for details.
  *
  * Note that while `std::clog` is buffered, the framework will flush any log
  * message at severity `WARNING` or higher.
@@ -91,6 +93,7 @@
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -218,6 +221,9 @@ struct LogRecord {
   int lineno;
   std::chrono::system_clock::time_point timestamp;
   std::string message;
+  /// The thread that created the record, backends may format it in a
+  /// different thread.
+  std::thread::id thread_id = std::this_thread::get_id();
 };
 
 /// Default formatting of a LogRecord.
@@ -318,20 +324,25 @@ class LogSink {
   static void DisableStdClog() { Instance().DisableStdClogImpl(); }
 
  private:
-  void EnableStdClogImpl();
+  // NOLINTNEXTLINE(google-runtime-int)
+  using BackendMap = std::map<long, std::shared_ptr<LogBackend>>;
+
+  void EnableStdClogImpl(bool async = false);
   void DisableStdClogImpl();
   // NOLINTNEXTLINE(google-runtime-int)
   long AddBackendImpl(std::shared_ptr<LogBackend> backend);
   // NOLINTNEXTLINE(google-runtime-int)
   void RemoveBackendImpl(long id);
+  void SetBackends(BackendMap backends);
 
   std::atomic<bool> empty_;
   std::atomic<int> minimum_severity_;
   std::mutex mutable mu_;
   long next_id_ = 0;          // NOLINT(google-runtime-int)
   long clog_backend_id_ = 0;  // NOLINT(google-runtime-int)
-  // NOLINTNEXTLINE(google-runtime-int)
-  std::map<long, std::shared_ptr<LogBackend>> backends_;
+  // The backends are never modified in place, `Log()` only needs to copy the
+  // pointer while holding the lock.
+  std::shared_ptr<BackendMap const> backends_;
 };
 
 /**
@@ -410,8 +421,8 @@ class Logger {
 template <>
 class Logger<false> {
  public:
-  Logger<false>() = default;
-  Logger<false>(Severity, char const*, char const*, int, LogSink&) {}
+  Logger() = default;
+  Logger(Severity, char const*, char const*, int, LogSink&) {}
 
   //@{
   /**
@@ -194,6 +194,42 @@ TEST(LogSinkTest, ClogEnvironment) {
   testing::FLAGS_gtest_death_test_style = old_style;
 }
 
+TEST(LogSinkTest, ClogEnvironmentAsync) {
+  // See the comments in ClogEnvironment for details about the death test.
+  auto old_style = testing::FLAGS_gtest_death_test_style;
+  testing::FLAGS_gtest_death_test_style = "threadsafe";
+
+  testing_util::ScopedEnvironment env("GOOGLE_CLOUD_CPP_ENABLE_CLOG", "async");
+
+  // Only messages at WARNING and above are guaranteed to be written before the
+  // process exits.
+  auto f = [] {
+    GCP_LOG(WARNING) << "testing async clog";
+    std::exit(42);
+  };
+  ASSERT_EXIT(f(), ExitedWithCode(42), HasSubstr("testing async clog"));
+
+  testing::FLAGS_gtest_death_test_style = old_style;
+}
+
+TEST(LogSinkTest, BackendsSnapshot) {
+  LogSink sink;
+  auto backend = std::make_shared<MockLogBackend>();
+  // NOLINTNEXTLINE(google-runtime-int)
+  long id = 0;
+  // Changing the backends while a message is being logged does not affect
+  // that message.
+  EXPECT_CALL(*backend, ProcessWithOwnership(_))
+      .WillOnce([&sink, &id](LogRecord const&) {
+        sink.RemoveBackend(id);
+        EXPECT_TRUE(sink.empty());
+      });
+  id = sink.AddBackend(backend);
+
+  GOOGLE_CLOUD_CPP_LOG_I(GCP_LS_WARNING, sink) << "test message";
+  GOOGLE_CLOUD_CPP_LOG_I(GCP_LS_WARNING, sink) << "not received";
+}
+
 namespace {
 /// A class to count calls to IOStream operator.
 struct IOStreamCounter {
@@ -0,0 +1,440 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/benchmarks/embedded_server.h"
+#include "google/cloud/internal/random.h"
+#include <google/pubsub/v1/pubsub.grpc.pb.h>
+#include <grpcpp/grpcpp.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+
+namespace pubsub_proto = ::google::pubsub::v1;
+
+namespace google {
+namespace cloud {
+namespace pubsub_benchmarks {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// How often the `StreamingPull()` loop checks if the stream is closed.
+auto constexpr kPollPeriod = std::chrono::milliseconds(100);
+/// How often the leases are scanned for expired ack deadlines.
+auto constexpr kExpirationScanPeriod = std::chrono::seconds(1);
+
+grpc::Status TransientError() {
+  return grpc::Status(grpc::StatusCode::UNAVAILABLE, "injected error");
+}
+
+/// Simulate the latency and the errors configured in the options.
+class LoadGenerator {
+ public:
+  explicit LoadGenerator(EmbeddedServerOptions options)
+      : options_(std::move(options)),
+        generator_(google::cloud::internal::MakeDefaultPRNG()) {}
+
+  EmbeddedServerOptions const& options() const { return options_; }
+
+  void SimulateLatency() const {
+    if (options_.latency.count() == 0) return;
+    std::this_thread::sleep_for(options_.latency);
+  }
+
+  bool InjectError() {
+    if (options_.error_rate <= 0.0) return false;
+    std::lock_guard<std::mutex> lk(mu_);
+    return std::uniform_real_distribution<double>(0, 1)(generator_) <
+           options_.error_rate;
+  }
+
+ private:
+  EmbeddedServerOptions const options_;
+  std::mutex mu_;
+  google::cloud::internal::DefaultPRNG generator_;
+};
+
+/**
+ * The messages published to the embedded server.
+ *
+ * The messages wait in a single queue until a `StreamingPull()` leases them. A
+ * lease ends when the message is acked, when its ack deadline is set to zero,
+ * or when its ack deadline expires. In the last two cases the message goes
+ * back to the queue and it is redelivered.
+ */
+class MessageStore {
+ public:
+  /// The flow control state for each stream.
+  struct StreamLeases {
+    /// The maximum number of outstanding messages, 0 means no limit.
+    std::int64_t max_outstanding = 0;
+    std::int64_t outstanding = 0;
+  };
+
+  void Publish(pubsub_proto::PublishRequest const& request,
+               pubsub_proto::PublishResponse& response) {
+    auto const now = std::chrono::system_clock::now().time_since_epoch();
+    auto const seconds = std::chrono::duration_cast<std::chrono::seconds>(now);
+    auto const nanos =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - seconds);
+    std::unique_lock<std::mutex> lk(mu_);
+    for (auto const& m : request.messages()) {
+      Pending p{m, 0};
+      p.message.set_message_id(std::to_string(++message_id_));
+      p.message.mutable_publish_time()->set_seconds(seconds.count());
+      p.message.mutable_publish_time()->set_nanos(
+          static_cast<std::int32_t>(nanos.count()));
+      response.add_message_ids(p.message.message_id());
+      pending_.push_back(std::move(p));
+    }
+    published_messages_ += request.messages_size();
+    lk.unlock();
+    cv_.notify_all();
+  }
+
+  /**
+   * Lease up to @p max messages for @p stream, add them to @p response.
+   *
+   * Waits up to @p wait if there are no messages available, or if the stream
+   * already has too many outstanding messages.
+   */
+  void Lease(std::shared_ptr<StreamLeases> const& stream, std::size_t max,
+             std::chrono::seconds ack_deadline, std::chrono::milliseconds wait,
+             pubsub_proto::StreamingPullResponse& response) {
+    std::unique_lock<std::mutex> lk(mu_);
+    ExpireLeases(Clock::now());
+    cv_.wait_for(lk, wait, [&] {
+      return !pending_.empty() && Capacity(*stream, max) != 0;
+    });
+    auto const deadline = Clock::now() + ack_deadline;
+    auto n = (std::min)(pending_.size(), Capacity(*stream, max));
+    stream->outstanding += static_cast<std::int64_t>(n);
+    delivered_messages_ += static_cast<std::int64_t>(n);
+    for (; n != 0; --n) {
+      auto p = std::move(pending_.front());
+      pending_.pop_front();
+      auto ack_id = "ack-" + std::to_string(++ack_id_);
+      auto& r = *response.add_received_messages();
+      r.set_ack_id(ack_id);
+      r.set_delivery_attempt(++p.delivery_attempt);
+      *r.mutable_message() = p.message;
+      leases_.emplace(std::move(ack_id),
+                      LeaseInfo{std::move(p), deadline, stream});
+    }
+  }
+
+  void Ack(google::protobuf::RepeatedPtrField<std::string> const& ack_ids) {
+    if (ack_ids.empty()) return;
+    std::unique_lock<std::mutex> lk(mu_);
+    for (auto const& id : ack_ids) {
+      auto l = leases_.find(id);
+      if (l == leases_.end()) continue;
+      --l->second.stream->outstanding;
+      leases_.erase(l);
+      ++acked_messages_;
+    }
+    lk.unlock();
+    cv_.notify_all();
+  }
+
+  void ModifyAckDeadline(
+      google::protobuf::RepeatedPtrField<std::string> const& ack_ids,
+      google::protobuf::RepeatedField<std::int32_t> const& seconds) {
+    if (ack_ids.empty()) return;
+    auto const now = Clock::now();
+    std::unique_lock<std::mutex> lk(mu_);
+    auto const n = (std::min)(ack_ids.size(), seconds.size());
+    for (int i = 0; i != n; ++i) {
+      auto l = leases_.find(ack_ids.Get(i));
+      if (l == leases_.end()) continue;
+      if (seconds.Get(i) != 0) {
+        l->second.deadline = now + std::chrono::seconds(seconds.Get(i));
+        continue;
+      }
+      ++nacked_messages_;
+      Release(l);
+    }
+    lk.unlock();
+    cv_.notify_all();
+  }
+
+  /// Return the messages in a response that could not be sent to the queue.
+  void Restore(pubsub_proto::StreamingPullResponse const& response) {
+    std::unique_lock<std::mutex> lk(mu_);
+    for (auto const& r : response.received_messages()) {
+      auto l = leases_.find(r.ack_id());
+      if (l != leases_.end()) Release(l);
+    }
+    lk.unlock();
+    cv_.notify_all();
+  }
+
+  std::int64_t published_messages() const { return published_messages_; }
+  std::int64_t delivered_messages() const { return delivered_messages_; }
+  std::int64_t acked_messages() const { return acked_messages_; }
+  std::int64_t nacked_messages() const { return nacked_messages_; }
+  std::int64_t expired_messages() const { return expired_messages_; }
+
+ private:
+  struct Pending {
+    pubsub_proto::PubsubMessage message;
+    std::int32_t delivery_attempt;
+  };
+  struct LeaseInfo {
+    Pending pending;
+    Clock::time_point deadline;
+    std::shared_ptr<StreamLeases> stream;
+  };
+  using Leases = std::unordered_map<std::string, LeaseInfo>;
+
+  static std::size_t Capacity(StreamLeases const& stream, std::size_t max) {
+    if (stream.max_outstanding <= 0) return max;
+    auto const available = stream.max_outstanding - stream.outstanding;
+    if (available <= 0) return 0;
+    return (std::min)(max, static_cast<std::size_t>(available));
+  }
+
+  /// End a lease and put the message back in the queue.
+  Leases::iterator Release(Leases::iterator l) {
+    --l->second.stream->outstanding;
+    pending_.push_back(std::move(l->second.pending));
+    return leases_.erase(l);
+  }
+
+  void ExpireLeases(Clock::time_point now) {
+    if (now < next_expiration_scan_) return;
+    next_expiration_scan_ = now + kExpirationScanPeriod;
+    for (auto l = leases_.begin(); l != leases_.end();) {
+      if (l->second.deadline > now) {
+        ++l;
+        continue;
+      }
+      ++expired_messages_;
+      l = Release(l);
+    }
+  }
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<Pending> pending_;
+  Leases leases_;
+  std::int64_t message_id_ = 0;
+  std::int64_t ack_id_ = 0;
+  Clock::time_point next_expiration_scan_;
+
+  std::atomic<std::int64_t> published_messages_{0};
+  std::atomic<std::int64_t> delivered_messages_{0};
+  std::atomic<std::int64_t> acked_messages_{0};
+  std::atomic<std::int64_t> nacked_messages_{0};
+  std::atomic<std::int64_t> expired_messages_{0};
+};
+
+/**
+ * Implement the portions of the `google.pubsub.v1.Publisher` interface
+ * necessary for the benchmarks.
+ *
+ * This is not a Mock (use `pubsub_testing::MockPublisherStub` for that), nor
+ * is this a Fake implementation (use the Cloud Pub/Sub Emulator for that),
+ * this is an implementation of the interface that stores the messages in
+ * memory. It is suitable for the benchmarks, but for nothing else.
+ */
+class PublisherImpl final : public pubsub_proto::Publisher::Service {
+ public:
+  PublisherImpl(std::shared_ptr<LoadGenerator> load,
+                std::shared_ptr<MessageStore> store)
+      : load_(std::move(load)), store_(std::move(store)) {}
+
+  grpc::Status Publish(grpc::ServerContext*,
+                       pubsub_proto::PublishRequest const* request,
+                       pubsub_proto::PublishResponse* response) override {
+    ++publish_count_;
+    load_->SimulateLatency();
+    if (load_->InjectError()) return TransientError();
+    store_->Publish(*request, *response);
+    return grpc::Status::OK;
+  }
+
+  std::int64_t publish_count() const { return publish_count_.load(); }
+
+ private:
+  std::shared_ptr<LoadGenerator> load_;
+  std::shared_ptr<MessageStore> store_;
+  std::atomic<std::int64_t> publish_count_{0};
+};
+
+/**
+ * Implement the `StreamingPull()` RPC in the `google.pubsub.v1.Subscriber`
+ * interface for the benchmarks.
+ *
+ * Each stream uses a separate thread to read the acks and the ack deadline
+ * changes, while the thread running the RPC sends the messages.
+ */
+class SubscriberImpl final : public pubsub_proto::Subscriber::Service {
+ public:
+  SubscriberImpl(std::shared_ptr<LoadGenerator> load,
+                 std::shared_ptr<MessageStore> store)
+      : load_(std::move(load)), store_(std::move(store)) {}
+
+  grpc::Status StreamingPull(
+      grpc::ServerContext* context,
+      grpc::ServerReaderWriter<pubsub_proto::StreamingPullResponse,
+                               pubsub_proto::StreamingPullRequest>* stream)
+      override {
+    ++streaming_pull_count_;
+    pubsub_proto::StreamingPullRequest request;
+    if (!stream->Read(&request)) {
+      return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT,
+                          "missing initial StreamingPullRequest");
+    }
+    auto leases = std::make_shared<MessageStore::StreamLeases>();
+    leases->max_outstanding = request.max_outstanding_messages();
+    std::atomic<std::int64_t> ack_deadline{
+        load_->options().ack_deadline.count()};
+    auto process = [&](pubsub_proto::StreamingPullRequest const& r) {
+      store_->Ack(r.ack_ids());
+      store_->ModifyAckDeadline(r.modify_deadline_ack_ids(),
+                                r.modify_deadline_seconds());
+      if (r.stream_ack_deadline_seconds() == 0) return;
+      ack_deadline.store(r.stream_ack_deadline_seconds());
+    };
+    process(request);
+
+    std::atomic<bool> reader_done{false};
+    std::thread reader([&] {
+      pubsub_proto::StreamingPullRequest r;
+      while (stream->Read(&r)) process(r);
+      reader_done.store(true);
+    });
+
+    auto const max_messages = static_cast<std::size_t>(
+        (std::max)(1, load_->options().max_messages_per_response));
+    auto status = grpc::Status::OK;
+    while (!reader_done.load() && !shutdown_.load() &&
+           !context->IsCancelled()) {
+      pubsub_proto::StreamingPullResponse response;
+      store_->Lease(leases, max_messages,
+                    std::chrono::seconds(ack_deadline.load()), kPollPeriod,
+                    response);
+      if (response.received_messages().empty()) continue;
+      load_->SimulateLatency();
+      if (load_->InjectError()) {
+        store_->Restore(response);
+        status = TransientError();
+        break;
+      }
+      if (!stream->Write(response)) {
+        store_->Restore(response);
+        break;
+      }
+    }
+    // The reader blocks until the client closes the stream, cancelling the
+    // RPC unblocks it.
+    if (!reader_done.load()) context->TryCancel();
+    reader.join();
+    return status;
+  }
+
+  void Shutdown() { shutdown_.store(true); }
+
+  std::int64_t streaming_pull_count() const {
+    return streaming_pull_count_.load();
+  }
+
+ private:
+  std::shared_ptr<LoadGenerator> load_;
+  std::shared_ptr<MessageStore> store_;
+  std::atomic<bool> shutdown_{false};
+  std::atomic<std::int64_t> streaming_pull_count_{0};
+};
+
+/// The implementation of EmbeddedServer.
+class DefaultEmbeddedServer : public EmbeddedServer {
+ public:
+  explicit DefaultEmbeddedServer(EmbeddedServerOptions options)
+      : load_(std::make_shared<LoadGenerator>(std::move(options))),
+        store_(std::make_shared<MessageStore>()),
+        publisher_service_(load_, store_),
+        subscriber_service_(load_, store_) {
+    int port;
+    std::string server_address("[::]:0");
+    builder_.AddListeningPort(server_address, grpc::InsecureServerCredentials(),
+                              &port);
+    builder_.RegisterService(&publisher_service_);
+    builder_.RegisterService(&subscriber_service_);
+    server_ = builder_.BuildAndStart();
+    address_ = "localhost:" + std::to_string(port);
+  }
+
+  std::string address() const override { return address_; }
+  void Shutdown() override {
+    // The streaming pulls never finish on their own, stop them first.
+    subscriber_service_.Shutdown();
+    server_->Shutdown();
+  }
+  void Wait() override { server_->Wait(); }
+
+  std::int64_t publish_count() const override {
+    return publisher_service_.publish_count();
+  }
+  std::int64_t streaming_pull_count() const override {
+    return subscriber_service_.streaming_pull_count();
+  }
+  std::int64_t published_messages() const override {
+    return store_->published_messages();
+  }
+  std::int64_t delivered_messages() const override {
+    return store_->delivered_messages();
+  }
+  std::int64_t acked_messages() const override {
+    return store_->acked_messages();
+  }
+  std::int64_t nacked_messages() const override {
+    return store_->nacked_messages();
+  }
+  std::int64_t expired_messages() const override {
+    return store_->expired_messages();
+  }
+
+ private:
+  std::shared_ptr<LoadGenerator> load_;
+  std::shared_ptr<MessageStore> store_;
+  PublisherImpl publisher_service_;
+  SubscriberImpl subscriber_service_;
+  grpc::ServerBuilder builder_;
+  std::unique_ptr<grpc::Server> server_;
+  std::string address_;
+};
+
+}  // namespace
+
+std::unique_ptr<EmbeddedServer> CreateEmbeddedServer() {
+  return CreateEmbeddedServer(EmbeddedServerOptions{});
+}
+
+std::unique_ptr<EmbeddedServer> CreateEmbeddedServer(
+    EmbeddedServerOptions options) {
+  return std::unique_ptr<EmbeddedServer>(
+      new DefaultEmbeddedServer(std::move(options)));
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_benchmarks
+}  // namespace cloud
+}  // namespace google
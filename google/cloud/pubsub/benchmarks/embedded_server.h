@@ -0,0 +1,98 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_BENCHMARKS_EMBEDDED_SERVER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_BENCHMARKS_EMBEDDED_SERVER_H
+
+#include "google/cloud/pubsub/version.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace pubsub_benchmarks {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+/**
+ * An abstract class to run and stop the embedded Cloud Pub/Sub server.
+ *
+ * Running the benchmarks against an embedded server eliminates the network
+ * and the service as sources of variation when measuring small changes to the
+ * library. This class is used to run (using Wait()) and stop (using
+ * Shutdown()) such a server, without exposing the implementation details to
+ * the application.
+ *
+ * The server has a single message queue: all the messages published to any
+ * topic are delivered to any subscription.
+ */
+class EmbeddedServer {
+ public:
+  virtual ~EmbeddedServer() = default;
+
+  virtual std::string address() const = 0;
+  virtual void Shutdown() = 0;
+  virtual void Wait() = 0;
+
+  /// The number of `Publish()` requests.
+  virtual std::int64_t publish_count() const = 0;
+  /// The number of `StreamingPull()` requests.
+  virtual std::int64_t streaming_pull_count() const = 0;
+  /// The number of messages in all the `Publish()` requests.
+  virtual std::int64_t published_messages() const = 0;
+  /// The number of messages sent to subscribers, including redeliveries.
+  virtual std::int64_t delivered_messages() const = 0;
+  virtual std::int64_t acked_messages() const = 0;
+  /// The number of leases terminated by a zero ack deadline.
+  virtual std::int64_t nacked_messages() const = 0;
+  /// The number of leases that expired before the message was acked.
+  virtual std::int64_t expired_messages() const = 0;
+};
+
+/**
+ * Configure the load generated by the embedded server.
+ *
+ * The defaults add no latency and no errors.
+ */
+struct EmbeddedServerOptions {
+  /// Wait this long before answering each `Publish()` request, and before
+  /// sending each `StreamingPullResponse`.
+  std::chrono::microseconds latency = std::chrono::microseconds(0);
+  /**
+   * The probability of a (retryable) error in each request.
+   *
+   * `Publish()` fails with this probability. `StreamingPull()` fails with
+   * this probability before sending each response, the messages in the
+   * response are redelivered.
+   */
+  double error_rate = 0.0;
+  /// The maximum number of messages in each `StreamingPullResponse`.
+  int max_messages_per_response = 1000;
+  /// The ack deadline used until the subscriber sets a different value.
+  std::chrono::seconds ack_deadline = std::chrono::seconds(10);
+};
+
+/// Create an embedded server.
+std::unique_ptr<EmbeddedServer> CreateEmbeddedServer();
+
+/// Create an embedded server generating the load described by @p options.
+std::unique_ptr<EmbeddedServer> CreateEmbeddedServer(
+    EmbeddedServerOptions options);
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_benchmarks
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_BENCHMARKS_EMBEDDED_SERVER_H
@@ -0,0 +1,186 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/benchmarks/embedded_server.h"
+#include "google/cloud/pubsub/publisher.h"
+#include "google/cloud/pubsub/subscriber.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace pubsub_benchmarks {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+
+pubsub::ConnectionOptions TestConnectionOptions(EmbeddedServer const& server) {
+  return pubsub::ConnectionOptions(grpc::InsecureChannelCredentials())
+      .set_endpoint(server.address());
+}
+
+pubsub::Publisher MakeTestPublisher(EmbeddedServer const& server) {
+  return pubsub::Publisher(pubsub::MakePublisherConnection(
+      pubsub::Topic("fake-project", "fake-topic"), pubsub::PublisherOptions{},
+      TestConnectionOptions(server)));
+}
+
+pubsub::Subscriber MakeTestSubscriber(EmbeddedServer const& server) {
+  return pubsub::Subscriber(pubsub::MakeSubscriberConnection(
+      pubsub::Subscription("fake-project", "fake-subscription"),
+      pubsub::SubscriberOptions{}, TestConnectionOptions(server)));
+}
+
+/// Publish @p count messages and wait for the results.
+void PublishMessages(pubsub::Publisher publisher, int count) {
+  std::vector<future<StatusOr<std::string>>> results;
+  for (int i = 0; i != count; ++i) {
+    results.push_back(publisher.Publish(
+        pubsub::MessageBuilder{}.SetData("data-" + std::to_string(i)).Build()));
+  }
+  for (auto& r : results) ASSERT_STATUS_OK(r.get());
+}
+
+TEST(EmbeddedServer, WaitAndShutdown) {
+  auto server = CreateEmbeddedServer();
+  EXPECT_FALSE(server->address().empty());
+
+  std::thread wait_thread([&server]() { server->Wait(); });
+  EXPECT_TRUE(wait_thread.joinable());
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_TRUE(wait_thread.joinable());
+  server->Shutdown();
+  wait_thread.join();
+}
+
+TEST(EmbeddedServer, Publish) {
+  auto server = CreateEmbeddedServer();
+  std::thread wait_thread([&server]() { server->Wait(); });
+
+  EXPECT_EQ(0, server->publish_count());
+  PublishMessages(MakeTestPublisher(*server), 3);
+  EXPECT_LE(1, server->publish_count());
+  EXPECT_EQ(3, server->published_messages());
+
+  server->Shutdown();
+  wait_thread.join();
+}
+
+TEST(EmbeddedServer, PublishWithErrors) {
+  EmbeddedServerOptions server_options;
+  server_options.error_rate = 0.5;
+  auto server = CreateEmbeddedServer(server_options);
+  std::thread wait_thread([&server]() { server->Wait(); });
+
+  // The injected errors are retried by the publisher.
+  PublishMessages(MakeTestPublisher(*server), 10);
+  EXPECT_EQ(10, server->published_messages());
+
+  server->Shutdown();
+  wait_thread.join();
+}
+
+TEST(EmbeddedServer, PublishAndSubscribe) {
+  auto server = CreateEmbeddedServer();
+  std::thread wait_thread([&server]() { server->Wait(); });
+
+  auto constexpr kMessageCount = 100;
+  PublishMessages(MakeTestPublisher(*server), kMessageCount);
+
+  std::atomic<int> received{0};
+  promise<void> done;
+  auto subscriber = MakeTestSubscriber(*server);
+  auto session = subscriber.Subscribe(
+      [&](pubsub::Message const&, pubsub::AckHandler h) {
+        std::move(h).ack();
+        if (++received == kMessageCount) done.set_value();
+      });
+  done.get_future().get();
+  session.cancel();
+  EXPECT_STATUS_OK(session.get());
+
+  EXPECT_LE(1, server->streaming_pull_count());
+  EXPECT_LE(kMessageCount, server->delivered_messages());
+
+  server->Shutdown();
+  wait_thread.join();
+}
+
+TEST(EmbeddedServer, NackedMessagesAreRedelivered) {
+  auto server = CreateEmbeddedServer();
+  std::thread wait_thread([&server]() { server->Wait(); });
+
+  PublishMessages(MakeTestPublisher(*server), 1);
+
+  promise<void> done;
+  std::atomic<int> attempts{0};
+  auto subscriber = MakeTestSubscriber(*server);
+  auto session =
+      subscriber.Subscribe([&](pubsub::Message const&, pubsub::AckHandler h) {
+        if (++attempts == 1) return std::move(h).nack();
+        std::move(h).ack();
+        done.set_value();
+      });
+  done.get_future().get();
+  session.cancel();
+  EXPECT_STATUS_OK(session.get());
+
+  EXPECT_EQ(1, server->nacked_messages());
+  EXPECT_LE(2, server->delivered_messages());
+
+  server->Shutdown();
+  wait_thread.join();
+}
+
+TEST(EmbeddedServer, SubscribeWithErrors) {
+  EmbeddedServerOptions server_options;
+  server_options.error_rate = 0.5;
+  server_options.max_messages_per_response = 2;
+  auto server = CreateEmbeddedServer(server_options);
+  std::thread wait_thread([&server]() { server->Wait(); });
+
+  auto constexpr kMessageCount = 20;
+  PublishMessages(MakeTestPublisher(*server), kMessageCount);
+
+  // The subscriber resumes the broken streams, and the messages in the failed
+  // responses are redelivered.
+  std::mutex mu;
+  std::set<std::string> received;
+  promise<void> done;
+  auto subscriber = MakeTestSubscriber(*server);
+  auto session =
+      subscriber.Subscribe([&](pubsub::Message const& m, pubsub::AckHandler h) {
+        std::move(h).ack();
+        std::lock_guard<std::mutex> lk(mu);
+        auto const inserted = received.insert(m.message_id()).second;
+        if (inserted && received.size() == kMessageCount) done.set_value();
+      });
+  done.get_future().get();
+  session.cancel();
+  EXPECT_STATUS_OK(session.get());
+
+  EXPECT_LT(1, server->streaming_pull_count());
+
+  server->Shutdown();
+  wait_thread.join();
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_benchmarks
+}  // namespace cloud
+}  // namespace google
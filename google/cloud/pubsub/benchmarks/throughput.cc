@@ -12,17 +12,24 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "google/cloud/pubsub/benchmarks/embedded_server.h"
+#include "google/cloud/pubsub/metrics_sink.h"
 #include "google/cloud/pubsub/publisher.h"
 #include "google/cloud/pubsub/subscriber.h"
 #include "google/cloud/pubsub/subscription_admin_client.h"
 #include "google/cloud/pubsub/testing/random_names.h"
 #include "google/cloud/pubsub/topic_admin_client.h"
+#include "google/cloud/completion_queue.h"
 #include "google/cloud/internal/format_time_point.h"
 #include "google/cloud/internal/getenv.h"
+#include "google/cloud/internal/latency_histogram.h"
 #include "google/cloud/internal/random.h"
+#include "google/cloud/testing_util/allocation_counter.h"
 #include "google/cloud/testing_util/command_line_parsing.h"
 #include "google/cloud/testing_util/timer.h"
+#include "absl/memory/memory.h"
 #include "absl/strings/str_format.h"
+#include <array>
 #include <chrono>
 #include <cinttypes>
 #include <functional>
@@ -41,13 +48,29 @@ auto constexpr kDescription = R"""(
 A throughput vs. CPU benchmark for the Cloud Pub/Sub C++ client library.
 
 Measure the throughput for publishers and/or subscribers in the Cloud Pub/Sub
-C++ client library.
+C++ client library. Run the subscriber with different `--subscriber-streams`
+values to measure how the throughput scales with the number of concurrent
+streaming pulls. Likewise, run the publisher with different `--publisher-shards`
+and `--publisher-max-concurrent-batches` values to measure how the throughput
+scales with the number of concurrent `Publish()` requests.
+
+Use `--embedded-server` to run against a server in the same process, instead
+of the Cloud Pub/Sub service. In this mode the benchmark also reports the CPU
+time and the memory allocations per message, measured in the threads running
+the client library. Some of the work happens in gRPC's internal threads, which
+are not measured. When the publisher and subscriber run in the same program
+the benchmark also reports the end-to-end latency.
+
+Use `--library-metrics` to report the metrics collected by the client library,
+such as the time to fill each batch, the `Publish()` latency, the time each
+message waits before its callback is scheduled, and the callback execution time.
 )""";
 
 struct Config {
   std::string project_id;
   std::string topic_id;
   std::string subscription_id;
+  std::string endpoint;
 
   std::int64_t payload_size = 1024;
   std::chrono::seconds iteration_duration = std::chrono::seconds(5);
@@ -59,6 +82,8 @@ struct Config {
   std::int64_t publisher_max_batch_bytes = 10 * kMiB;
   std::int64_t publisher_pending_lwm = 9 * 1000000;
   std::int64_t publisher_pending_hwm = 10 * 1000000;
+  int publisher_shards = 1;
+  int publisher_max_concurrent_batches = 0;
 
   bool subscriber = false;
   int subscriber_thread_count = 1;
@@ -66,12 +91,21 @@ struct Config {
   int subscriber_max_outstanding_messages = 0;
   std::int64_t subscriber_max_outstanding_bytes = 100 * kMiB;
   int subscriber_max_concurrency = 0;
+  int subscriber_streams = 1;
+  int subscriber_channels = 0;
+  int subscriber_batch_size = 0;
 
   std::int64_t minimum_samples = 10;
   std::int64_t maximum_samples = (std::numeric_limits<std::int64_t>::max)();
   std::chrono::seconds minimum_runtime = std::chrono::seconds(5);
   std::chrono::seconds maximum_runtime = std::chrono::seconds(300);
 
+  bool embedded_server = false;
+  std::chrono::microseconds embedded_server_latency{0};
+  double embedded_server_error_rate = 0.0;
+
+  bool library_metrics = false;
+
   bool show_help = false;
 };
 
@@ -89,6 +123,8 @@ class Cleanup {
   std::vector<std::function<void()>> actions_;
 };
 
+std::int64_t MicrosecondsSinceStart();
+
 void PublisherTask(Config const& config);
 void SubscriberTask(Config const& config);
 
@@ -106,7 +142,36 @@ int main(int argc, char* argv[]) {
 
   auto generator = google::cloud::internal::MakeDefaultPRNG();
 
+  std::unique_ptr<google::cloud::pubsub_benchmarks::EmbeddedServer> server;
   Cleanup cleanup;
+  if (config->embedded_server) {
+    google::cloud::pubsub_benchmarks::EmbeddedServerOptions server_options;
+    server_options.latency = config->embedded_server_latency;
+    server_options.error_rate = config->embedded_server_error_rate;
+    server =
+        google::cloud::pubsub_benchmarks::CreateEmbeddedServer(server_options);
+    config->endpoint = server->address();
+    // The embedded server has a single queue, any names work.
+    if (config->project_id.empty()) config->project_id = "embedded-project";
+    if (config->topic_id.empty()) config->topic_id = "embedded-topic";
+    if (config->subscription_id.empty()) {
+      config->subscription_id = "embedded-subscription";
+    }
+    auto wait = std::make_shared<std::thread>([&server] { server->Wait(); });
+    cleanup.Defer([&server, wait] {
+      std::cout << "# Embedded Server: publish_count="
+                << server->publish_count()
+                << ", streaming_pull_count=" << server->streaming_pull_count()
+                << ", published=" << server->published_messages()
+                << ", delivered=" << server->delivered_messages()
+                << ", acked=" << server->acked_messages()
+                << ", nacked=" << server->nacked_messages()
+                << ", expired=" << server->expired_messages() << std::endl;
+      server->Shutdown();
+      wait->join();
+    });
+  }
+
   // If there is no pre-defined topic and/or subscription for this test, create
   // them and automatically remove them at the end of the test.
   if (config->topic_id.empty()) {
@@ -155,7 +220,10 @@ int main(int argc, char* argv[]) {
             << "\n# Publisher Max Batch Size: "
             << config->publisher_max_batch_size
             << "\n# Publisher Max Batch Bytes: "
-            << FormatSize(config->publisher_max_batch_bytes) << std::boolalpha
+            << FormatSize(config->publisher_max_batch_bytes)
+            << "\n# Publisher Shards: " << config->publisher_shards
+            << "\n# Publisher Max Concurrent Batches: "
+            << config->publisher_max_concurrent_batches << std::boolalpha
             << "\n# Subscriber: " << config->subscriber
             << "\n# Subscriber Threads: " << config->subscriber_thread_count
             << "\n# Subscriber I/O Threads: " << config->subscriber_io_threads
@@ -165,11 +233,19 @@ int main(int argc, char* argv[]) {
             << FormatSize(config->subscriber_max_outstanding_bytes)
             << "\n# Subscriber Max Concurrency: "
             << config->subscriber_max_concurrency
+            << "\n# Subscriber Streams: " << config->subscriber_streams
+            << "\n# Subscriber Channels: " << config->subscriber_channels
+            << "\n# Subscriber Batch Size: " << config->subscriber_batch_size
             << "\n# Minimum Samples: " << config->minimum_samples
             << "\n# Maximum Samples: " << config->maximum_samples
             << "\n# Minimum Runtime: " << config->minimum_runtime.count() << "s"
             << "\n# Maximum Runtime: " << config->maximum_runtime.count() << "s"
-            << std::endl;
+            << "\n# Embedded Server: " << config->embedded_server
+            << "\n# Embedded Server Latency: "
+            << config->embedded_server_latency.count() << "us"
+            << "\n# Embedded Server Error Rate: "
+            << config->embedded_server_error_rate
+            << "\n# Library Metrics: " << config->library_metrics << std::endl;
 
   auto const topic = pubsub::Topic(config->project_id, config->topic_id);
 
@@ -189,10 +265,158 @@ int main(int argc, char* argv[]) {
 
 namespace {
 
+using ::google::cloud::testing_util::AllocationCounter;
 using ::google::cloud::testing_util::Timer;
 
 std::mutex cout_mu;
 
+std::int64_t MicrosecondsSinceStart() {
+  // The publisher and subscriber use the same epoch, so the subscriber can
+  // compute the end-to-end latency when both run in this program.
+  static auto const start = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+/// Print the percentiles and the non-empty buckets in @p h.
+void PrintHistogram(std::ostream& os, std::string const& name,
+                    pubsub::MetricsHistogramSnapshot const& h) {
+  if (h.count == 0) return;
+  os << "# " << name << ": count=" << h.count
+     << ", p50<=" << h.Percentile(50.0).count() << "us"
+     << ", p90<=" << h.Percentile(90.0).count() << "us"
+     << ", p99<=" << h.Percentile(99.0).count() << "us"
+     << ", p99.9<=" << h.Percentile(99.9).count() << "us\n";
+  for (std::size_t i = 0; i != h.buckets.size(); ++i) {
+    if (h.buckets[i] == 0) continue;
+    os << "# " << name << " Histogram: <="
+       << pubsub::MetricsHistogramSnapshot::UpperBound(i).count() << "us,"
+       << h.buckets[i] << "\n";
+  }
+}
+
+/// A histogram of the end-to-end latency, using logarithmic buckets.
+class LatencyHistogram {
+ public:
+  LatencyHistogram() {
+    for (auto& b : buckets_) b.store(0);
+  }
+
+  void Record(std::int64_t latency_us) {
+    ++buckets_[google::cloud::internal::LatencyBucket(
+        std::chrono::microseconds(latency_us), buckets_.size())];
+  }
+
+  void Print(std::ostream& os, std::string const& operation) const {
+    pubsub::MetricsHistogramSnapshot h{0, std::chrono::microseconds(0), {}};
+    for (auto const& b : buckets_) {
+      h.buckets.push_back(b.load());
+      h.count += h.buckets.back();
+    }
+    PrintHistogram(os, operation + " Latency", h);
+  }
+
+ private:
+  std::array<std::atomic<std::int64_t>,
+             pubsub::InProcessMetricsSink::kBucketCount>
+      buckets_;
+};
+
+/// Print the library metrics collected in @p metrics.
+void PrintMetrics(std::string const& operation,
+                  pubsub::InProcessMetricsSink const& metrics,
+                  std::vector<pubsub::MetricsCounter> const& counters,
+                  std::vector<pubsub::MetricsHistogram> const& histograms) {
+  std::lock_guard<std::mutex> lk(cout_mu);
+  std::cout << "# " << operation << " Metrics:";
+  char const* sep = " ";
+  for (auto c : counters) {
+    std::cout << sep << pubsub::ToString(c) << "=" << metrics.counter(c);
+    sep = ", ";
+  }
+  std::cout << "\n";
+  for (auto h : histograms) {
+    PrintHistogram(std::cout, operation + " " + pubsub::ToString(h),
+                   metrics.histogram(h));
+  }
+  std::cout << std::flush;
+}
+
+/**
+ * Run a CompletionQueue, measuring the CPU time and allocations in its threads.
+ *
+ * Other threads running the client library, such as the publisher tasks, can
+ * also add their CPU time and allocations using `Measure()`.
+ */
+class MeasuredCompletionQueue {
+ public:
+  explicit MeasuredCompletionQueue(int thread_count) {
+    std::generate_n(std::back_inserter(threads_), (std::max)(1, thread_count),
+                    [this] {
+                      return std::thread([this] {
+                        Measure([this] { cq_.Run(); });
+                      });
+                    });
+  }
+  ~MeasuredCompletionQueue() { Shutdown(); }
+
+  google::cloud::CompletionQueue& cq() { return cq_; }
+
+  /// Call @p f in this thread, and measure its CPU time and allocations.
+  template <typename Functor>
+  void Measure(Functor&& f) {
+    allocations_.Start();
+    Timer timer;
+    timer.Start();
+    std::forward<Functor>(f)();
+    timer.Stop();
+    allocations_.Stop();
+    cpu_time_ += timer.cpu_time().count();
+  }
+
+  /// Stop the threads, the measurements are complete after this call.
+  void Shutdown() {
+    if (threads_.empty()) return;
+    cq_.Shutdown();
+    for (auto& t : threads_) t.join();
+    threads_.clear();
+  }
+
+  std::chrono::microseconds cpu_time() const {
+    return std::chrono::microseconds(cpu_time_.load());
+  }
+  std::int64_t allocations() const { return allocations_.count(); }
+
+ private:
+  google::cloud::CompletionQueue cq_;
+  std::atomic<std::int64_t> cpu_time_{0};
+  AllocationCounter allocations_;
+  std::vector<std::thread> threads_;
+};
+
+pubsub::ConnectionOptions MakeConnectionOptions(Config const& config) {
+  if (config.endpoint.empty()) return pubsub::ConnectionOptions{};
+  return pubsub::ConnectionOptions(grpc::InsecureChannelCredentials())
+      .set_endpoint(config.endpoint);
+}
+
+void PrintOverhead(std::string const& operation, std::int64_t count,
+                   MeasuredCompletionQueue const& io) {
+  auto const messages = static_cast<double>((std::max)(std::int64_t{1}, count));
+  auto const cpu_per_message = absl::StrFormat(
+      "%.03f", static_cast<double>(io.cpu_time().count()) / messages);
+  auto const allocations_per_message = absl::StrFormat(
+      "%.02f", static_cast<double>(io.allocations()) / messages);
+  std::lock_guard<std::mutex> lk(cout_mu);
+  std::cout << "# " << operation << " Overhead: count=" << count
+            << ", cpu_time=" << io.cpu_time().count() << "us"
+            << ", cpu_per_message=" << cpu_per_message << "us"
+            << ", allocations=" << io.allocations()
+            << ", allocations_per_message=" << allocations_per_message
+            << std::endl;
+}
+
 bool Done(Config const& config, std::int64_t samples,
           std::chrono::steady_clock::time_point start) {
   auto const now = std::chrono::steady_clock::now();
@@ -229,13 +453,27 @@ void PublisherTask(Config const& config) {
       pubsub::PublisherOptions{}
           .set_maximum_batch_message_count(config.publisher_max_batch_size)
           .set_maximum_batch_bytes(
-              static_cast<std::size_t>(config.publisher_max_batch_bytes));
+              static_cast<std::size_t>(config.publisher_max_batch_bytes))
+          .set_shard_count(static_cast<std::size_t>(config.publisher_shards))
+          .set_maximum_concurrent_batches(static_cast<std::size_t>(
+              config.publisher_max_concurrent_batches));
+  std::shared_ptr<pubsub::InProcessMetricsSink> metrics;
+  if (config.library_metrics) {
+    metrics = std::make_shared<pubsub::InProcessMetricsSink>();
+    publisher_options.set_metrics_sink(metrics);
+  }
   auto connection_options =
-      pubsub::ConnectionOptions{}.set_channel_pool_domain("Publisher");
+      MakeConnectionOptions(config).set_channel_pool_domain("Publisher");
   if (config.publisher_io_threads) {
     connection_options.set_background_thread_pool_size(
         config.publisher_io_threads);
   }
+  std::unique_ptr<MeasuredCompletionQueue> io;
+  if (config.embedded_server) {
+    io = absl::make_unique<MeasuredCompletionQueue>(
+        config.publisher_io_threads);
+    connection_options.DisableBackgroundThreads(io->cq());
+  }
 
   pubsub::Publisher publisher(pubsub::MakePublisherConnection(
       pubsub::Topic(config.project_id, config.topic_id),
@@ -269,18 +507,14 @@ void PublisherTask(Config const& config) {
   std::atomic<std::int64_t> send_count{0};
   std::atomic<std::int64_t> error_count{0};
   std::atomic<bool> shutdown{false};
-  auto worker = [&](int id) {
-    using std::chrono::steady_clock;
-    using std::chrono::duration_cast;
-    auto const start = std::chrono::steady_clock::now();
+  auto publish_loop = [&](int id) {
     for (std::int64_t i = 0; !shutdown.load(); ++i) {
       pending_wait();
-      auto const elapsed =
-          duration_cast<std::chrono::microseconds>(steady_clock::now() - start);
+      auto const send_time = MicrosecondsSinceStart();
       publisher
           .Publish(pubsub::MessageBuilder{}
                        .SetAttributes({
-                           {"sendTime", std::to_string(elapsed.count())},
+                           {"sendTime", std::to_string(send_time)},
                            {"clientId", std::to_string(id)},
                            {"sequenceNumber", std::to_string(i)},
                        })
@@ -293,6 +527,13 @@ void PublisherTask(Config const& config) {
           });
     }
   };
+  auto worker = [&](int id) {
+    if (io) {
+      io->Measure([&] { publish_loop(id); });
+    } else {
+      publish_loop(id);
+    }
+  };
   std::vector<std::thread> workers;
   int task_id = 0;
   std::generate_n(std::back_inserter(workers), config.publisher_thread_count,
@@ -316,6 +557,18 @@ void PublisherTask(Config const& config) {
   pending_nothing();
   std::cout << "# Publisher: error_count=" << error_count
             << ", hwm_count=" << hwm_count << std::endl;
+  if (metrics) {
+    PrintMetrics("Publisher", *metrics,
+                 {pubsub::MetricsCounter::kPublishBatches,
+                  pubsub::MetricsCounter::kPublishedMessages,
+                  pubsub::MetricsCounter::kPublishFailedMessages},
+                 {pubsub::MetricsHistogram::kBatchFillTime,
+                  pubsub::MetricsHistogram::kBatchCorkedTime,
+                  pubsub::MetricsHistogram::kPublishLatency});
+  }
+  if (!io) return;
+  io->Shutdown();
+  PrintOverhead("Publisher", send_count.load(), *io);
 }
 
 void SubscriberTask(Config const& config) {
@@ -324,27 +577,64 @@ void SubscriberTask(Config const& config) {
           .set_max_outstanding_messages(
               config.subscriber_max_outstanding_messages)
           .set_max_outstanding_bytes(config.subscriber_max_outstanding_bytes)
-          .set_max_concurrency(config.subscriber_max_concurrency);
+          .set_max_concurrency(config.subscriber_max_concurrency)
+          .set_concurrent_streams(
+              static_cast<std::size_t>(config.subscriber_streams));
+  std::shared_ptr<pubsub::InProcessMetricsSink> metrics;
+  if (config.library_metrics) {
+    metrics = std::make_shared<pubsub::InProcessMetricsSink>();
+    subscriber_options.set_metrics_sink(metrics);
+  }
   auto connection_options =
-      pubsub::ConnectionOptions{}.set_channel_pool_domain("Subscriber");
+      MakeConnectionOptions(config).set_channel_pool_domain("Subscriber");
+  if (config.subscriber_channels != 0) {
+    connection_options.set_num_channels(config.subscriber_channels);
+  }
   if (config.subscriber_io_threads != 0) {
     connection_options.set_background_thread_pool_size(
         config.subscriber_io_threads);
   }
+  std::unique_ptr<MeasuredCompletionQueue> io;
+  if (config.embedded_server) {
+    io = absl::make_unique<MeasuredCompletionQueue>(
+        config.subscriber_io_threads);
+    connection_options.DisableBackgroundThreads(io->cq());
+  }
 
   pubsub::Subscriber subscriber(pubsub::MakeSubscriberConnection(
       pubsub::Subscription(config.project_id, config.subscription_id),
       std::move(subscriber_options), std::move(connection_options)));
   std::atomic<std::int64_t> received_count{0};
-  auto handler = [&received_count](pubsub::Message const&,
-                                   pubsub::AckHandler h) {
+  // The send time is only meaningful if the publisher runs in this program.
+  LatencyHistogram latency;
+  auto record_latency = [&](pubsub::Message const& m) {
+    if (!config.publisher || !m.has_attribute("sendTime")) return;
+    latency.Record(MicrosecondsSinceStart() -
+                   std::stoll(m.attribute("sendTime")));
+  };
+  auto handler = [&](pubsub::Message const& m, pubsub::AckHandler h) {
     ++received_count;
+    record_latency(m);
+    std::move(h).ack();
+  };
+
+  auto batch_handler = [&](std::vector<pubsub::Message> const& messages,
+                           pubsub::BulkAckHandler h) {
+    received_count += static_cast<std::int64_t>(messages.size());
+    for (auto const& m : messages) record_latency(m);
     std::move(h).ack();
   };
 
   std::vector<future<Status>> sessions;
   std::generate_n(std::back_inserter(sessions), config.subscriber_thread_count,
-                  [&] { return subscriber.Subscribe(handler); });
+                  [&] {
+                    if (config.subscriber_batch_size <= 0) {
+                      return subscriber.Subscribe(handler);
+                    }
+                    return subscriber.SubscribeBatch(
+                        batch_handler,
+                        static_cast<std::size_t>(config.subscriber_batch_size));
+                  });
 
   auto const start = std::chrono::steady_clock::now();
   for (int i = 0; !Done(config, i, start); ++i) {
@@ -370,6 +660,28 @@ void SubscriberTask(Config const& config) {
     std::cout << "# status=" << last_status << ", count=" << last_received_count
               << std::endl;
   }
+  auto const lease = subscriber.LeaseMetrics();
+  {
+    std::lock_guard<std::mutex> lk(cout_mu);
+    std::cout << "# lease: extension_requests=" << lease.extension_requests
+              << ", extended_leases=" << lease.extended_leases
+              << ", expired_leases=" << lease.expired_leases
+              << ", ack_deadline=" << lease.ack_deadline.count() << "s"
+              << std::endl;
+    latency.Print(std::cout, "Subscriber");
+  }
+  if (metrics) {
+    PrintMetrics("Subscriber", *metrics,
+                 {pubsub::MetricsCounter::kReceivedMessages,
+                  pubsub::MetricsCounter::kAckedMessages,
+                  pubsub::MetricsCounter::kNackedMessages},
+                 {pubsub::MetricsHistogram::kQueueingDelay,
+                  pubsub::MetricsHistogram::kCallbackTime,
+                  pubsub::MetricsHistogram::kAckLatency});
+  }
+  if (!io) return;
+  io->Shutdown();
+  PrintOverhead("Subscriber", received_count.load(), *io);
 }
 
 using ::google::cloud::internal::GetEnv;
@@ -428,6 +740,16 @@ google::cloud::StatusOr<Config> ParseArgsImpl(std::vector<std::string> args,
        [&options](std::string const& val) {
          options.publisher_max_batch_bytes = ParseSize(val);
        }},
+      {"--publisher-shards",
+       "number of batching shards, each shard uses a different channel",
+       [&options](std::string const& val) {
+         options.publisher_shards = std::stoi(val);
+       }},
+      {"--publisher-max-concurrent-batches",
+       "maximum number of Publish() requests in flight, 0 for no limit",
+       [&options](std::string const& val) {
+         options.publisher_max_concurrent_batches = std::stoi(val);
+       }},
 
       {"--subscriber", "run a subscriber in this program",
        [&options](std::string const& val) {
@@ -455,6 +777,21 @@ google::cloud::StatusOr<Config> ParseArgsImpl(std::vector<std::string> args,
        [&options](std::string const& val) {
          options.subscriber_max_concurrency = std::stoi(val);
        }},
+      {"--subscriber-streams",
+       "number of concurrent streaming pulls for each subscription",
+       [&options](std::string const& val) {
+         options.subscriber_streams = std::stoi(val);
+       }},
+      {"--subscriber-channels",
+       "number of subscriber channels, set to 0 to use the library default",
+       [&options](std::string const& val) {
+         options.subscriber_channels = std::stoi(val);
+       }},
+      {"--subscriber-batch-size",
+       "receive messages in batches of this size, 0 receives one at a time",
+       [&options](std::string const& val) {
+         options.subscriber_batch_size = std::stoi(val);
+       }},
 
       {"--minimum-samples", "minimum number of samples to capture",
        [&options](std::string const& val) {
@@ -472,6 +809,28 @@ google::cloud::StatusOr<Config> ParseArgsImpl(std::vector<std::string> args,
        [&options](std::string const& val) {
          options.maximum_runtime = ParseDuration(val);
        }},
+
+      {"--embedded-server",
+       "run against an embedded server instead of Cloud Pub/Sub",
+       [&options](std::string const& val) {
+         options.embedded_server = ParseBoolean(val).value_or(true);
+       }},
+      {"--embedded-server-latency-us",
+       "delay each embedded server response by this many microseconds",
+       [&options](std::string const& val) {
+         options.embedded_server_latency =
+             std::chrono::microseconds(std::stol(val));
+       }},
+      {"--embedded-server-error-rate",
+       "the probability of an error in each embedded server response",
+       [&options](std::string const& val) {
+         options.embedded_server_error_rate = std::stod(val);
+       }},
+
+      {"--library-metrics", "report the metrics collected by the library",
+       [&options](std::string const& val) {
+         options.library_metrics = ParseBoolean(val).value_or(true);
+       }},
   };
   auto const usage = BuildUsage(desc, args[0]);
   auto unparsed = OptionsParse(desc, args);
@@ -486,11 +845,18 @@ google::cloud::StatusOr<Config> ParseArgsImpl(std::vector<std::string> args,
     return options;
   }
 
-  if (options.project_id.empty()) {
+  if (options.project_id.empty() && !options.embedded_server) {
     return google::cloud::Status(google::cloud::StatusCode::kInvalidArgument,
                                  "missing or empty --project-id option");
   }
 
+  if (options.embedded_server_error_rate < 0.0 ||
+      options.embedded_server_error_rate >= 1.0) {
+    return google::cloud::Status(
+        google::cloud::StatusCode::kInvalidArgument,
+        "--embedded-server-error-rate must be in the [0, 1) range");
+  }
+
   return options;
 }
 
@@ -516,6 +882,13 @@ google::cloud::StatusOr<Config> SelfTest(std::string const& cmd) {
   if (!config) return error("--topic-id");
   config = ParseArgsImpl({cmd, "--subscription-id=test"}, kDescription);
   if (!config) return error("--subscription-id");
+  config = ParseArgsImpl({cmd, "--project-id=", "--embedded-server"},
+                         kDescription);
+  if (!config) return error("--embedded-server without --project-id");
+  config = ParseArgsImpl(
+      {cmd, "--embedded-server", "--embedded-server-error-rate=2"},
+      kDescription);
+  if (config) return error("--embedded-server-error-rate validation");
 
   return ParseArgsImpl(
       {
@@ -526,17 +899,22 @@ google::cloud::StatusOr<Config> SelfTest(std::string const& cmd) {
           "--publisher-io-threads=1",
           "--publisher-max-batch-size=2",
           "--publisher-max-batch-bytes=1KiB",
+          "--publisher-shards=2",
+          "--publisher-max-concurrent-batches=4",
           "--subscriber=true",
           "--subscriber-thread-count=1",
           "--subscriber-io-threads=1",
           "--subscriber-max-outstanding-bytes=100MiB",
           "--subscriber-max-concurrency=1000",
+          "--subscriber-streams=2",
+          "--subscriber-channels=2",
           "--iteration-duration=1s",
           "--payload-size=2KiB",
           "--minimum-samples=1",
           "--maximum-samples=2",
           "--minimum-runtime=0s",
           "--maximum-runtime=2s",
+          "--library-metrics=true",
       },
       kDescription);
 }
@@ -0,0 +1,114 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_BULK_ACK_HANDLER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_BULK_ACK_HANDLER_H
+
+#include "google/cloud/pubsub/version.h"
+#include <cstddef>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace pubsub {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+/**
+ * Defines the interface to acknowledge and reject a batch of messages.
+ *
+ * Applications using `Subscriber::SubscribeBatch()` receive a batch of
+ * messages and a single `pubsub::BulkAckHandler`. Actions on a
+ * `pubsub::BulkAckHandler` always affect all the messages in the batch.
+ * Applications cannot create standalone handlers (except in unit tests via
+ * mocks).
+ *
+ * Like `pubsub::AckHandler`, this class is move-able, but *not* copy-able,
+ * because messages can only be acknowledged or rejected exactly once. If the
+ * handler is destroyed before calling `ack()` or `nack()` all the messages are
+ * rejected.
+ *
+ * @par Thread Safety
+ * This class is *thread compatible*, only one thread should call non-const
+ * member functions of this class at a time. Note that because the non-const
+ * member functions are `&&` overloads the application can only call `ack()` or
+ * `nack()` exactly once, and only one of them.
+ */
+class BulkAckHandler {
+ public:
+  ~BulkAckHandler();
+
+  BulkAckHandler(BulkAckHandler&&) noexcept = default;
+  BulkAckHandler& operator=(BulkAckHandler&&) noexcept = default;
+
+  /**
+   * Acknowledges all the messages associated with this handler.
+   *
+   * @par Idempotency
+   * Note that this is not an idempotent operation, and therefore it is never
+   * retried. Furthermore, the service may still resend a message after a
+   * successful `ack()`. Applications developers are reminded that Cloud Pub/Sub
+   * offers "at least once" semantics so they should be prepared to handle
+   * duplicate messages.
+   */
+  void ack() && {
+    auto impl = std::move(impl_);
+    impl->ack();
+  }
+
+  /**
+   * Rejects all the messages associated with this handler.
+   *
+   * @par Idempotency
+   * Note that this is not an idempotent operation, and therefore it is never
+   * retried. Furthermore, the service may still resend a message after a
+   * successful `nack()`. Applications developers are reminded that Cloud
+   * Pub/Sub offers "at least once" semantics so they should be prepared to
+   * handle duplicate messages.
+   */
+  void nack() && {
+    auto impl = std::move(impl_);
+    impl->nack();
+  }
+
+  /// Returns the number of messages associated with this handler.
+  std::size_t size() const { return impl_->size(); }
+
+  /// Allow applications to mock a `BulkAckHandler`.
+  class Impl {
+   public:
+    virtual ~Impl() = 0;
+    /// The implementation for `BulkAckHandler::ack()`
+    virtual void ack() {}
+    /// The implementation for `BulkAckHandler::nack()`
+    virtual void nack() {}
+    /// The implementation for `BulkAckHandler::size()`
+    virtual std::size_t size() const { return 0; }
+  };
+
+  /**
+   * Applications may use this constructor in their mocks.
+   */
+  explicit BulkAckHandler(std::unique_ptr<Impl> impl)
+      : impl_(std::move(impl)) {}
+
+ private:
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_BULK_ACK_HANDLER_H
@@ -0,0 +1,61 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/ack_deadline_estimator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+std::chrono::seconds constexpr AckDeadlineEstimator::kMinimumAckDeadline;
+std::chrono::seconds constexpr AckDeadlineEstimator::kMaximumAckDeadline;
+
+AckDeadlineEstimator::AckDeadlineEstimator(double percentile)
+    : percentile_((std::min)(100.0, (std::max)(0.0, percentile))),
+      buckets_(static_cast<std::size_t>(kMaximumAckDeadline.count()) + 1) {}
+
+void AckDeadlineEstimator::Record(std::chrono::milliseconds handling_time) {
+  // Round up, a message handled in 1.5s needs a 2s deadline.
+  auto const seconds = (std::max)(
+      std::int64_t{0},
+      static_cast<std::int64_t>((handling_time.count() + 999) / 1000));
+  auto const index =
+      (std::min)(static_cast<std::size_t>(seconds), buckets_.size() - 1);
+  ++buckets_[index];
+  ++count_;
+}
+
+std::chrono::seconds AckDeadlineEstimator::Deadline() const {
+  if (count_ == 0) return kMinimumAckDeadline;
+  auto const target = static_cast<std::int64_t>(
+      std::ceil(static_cast<double>(count_) * percentile_ / 100.0));
+  std::int64_t accumulated = 0;
+  std::size_t index = 0;
+  for (; index != buckets_.size() - 1; ++index) {
+    accumulated += buckets_[index];
+    if (accumulated >= target) break;
+  }
+  auto const deadline =
+      std::chrono::seconds(static_cast<std::chrono::seconds::rep>(index));
+  return (std::max)(kMinimumAckDeadline,
+                    (std::min)(kMaximumAckDeadline, deadline));
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
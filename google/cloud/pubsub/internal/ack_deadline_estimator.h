@@ -0,0 +1,67 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ACK_DEADLINE_ESTIMATOR_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ACK_DEADLINE_ESTIMATOR_H
+
+#include "google/cloud/pubsub/version.h"
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+/**
+ * Estimate the ack deadline from the observed message handling times.
+ *
+ * Keeps a histogram, with one second buckets, of the time between receiving a
+ * message and acking (or nacking) it. The estimated deadline is a percentile
+ * of this distribution, clamped to the range accepted by the service.
+ *
+ * This class is not thread-safe, the caller must provide any synchronization.
+ */
+class AckDeadlineEstimator {
+ public:
+  static auto constexpr kMinimumAckDeadline = std::chrono::seconds(10);
+  static auto constexpr kMaximumAckDeadline = std::chrono::seconds(600);
+
+  explicit AckDeadlineEstimator(double percentile = 99.0);
+
+  /// Record the handling time for one message.
+  void Record(std::chrono::milliseconds handling_time);
+
+  /// The number of samples recorded so far.
+  std::int64_t count() const { return count_; }
+
+  /// The estimated deadline, `kMinimumAckDeadline` if there are no samples.
+  std::chrono::seconds Deadline() const;
+
+ private:
+  double const percentile_;
+  // buckets_[i] counts the samples in the (i - 1, i] seconds range, the last
+  // bucket also counts any larger samples.
+  std::vector<std::int64_t> buckets_;
+  std::int64_t count_ = 0;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ACK_DEADLINE_ESTIMATOR_H
@@ -0,0 +1,67 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "google/cloud/pubsub/internal/ack_deadline_estimator.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+
+using std::chrono::milliseconds;
+using std::chrono::seconds;
+
+TEST(AckDeadlineEstimatorTest, Empty) {
+  AckDeadlineEstimator tested;
+  EXPECT_EQ(0, tested.count());
+  EXPECT_EQ(AckDeadlineEstimator::kMinimumAckDeadline, tested.Deadline());
+}
+
+TEST(AckDeadlineEstimatorTest, Percentile) {
+  AckDeadlineEstimator tested;
+  for (int i = 0; i != 990; ++i) tested.Record(milliseconds(500));
+  for (int i = 0; i != 10; ++i) tested.Record(seconds(42));
+  EXPECT_EQ(1000, tested.count());
+  // The p99 handling time is still below the minimum.
+  EXPECT_EQ(AckDeadlineEstimator::kMinimumAckDeadline, tested.Deadline());
+
+  tested.Record(milliseconds(41500));
+  EXPECT_EQ(seconds(42), tested.Deadline());
+}
+
+TEST(AckDeadlineEstimatorTest, CustomPercentile) {
+  AckDeadlineEstimator tested(50.0);
+  for (int i = 0; i != 10; ++i) tested.Record(seconds(20));
+  for (int i = 0; i != 11; ++i) tested.Record(seconds(30));
+  EXPECT_EQ(seconds(30), tested.Deadline());
+  for (int i = 0; i != 2; ++i) tested.Record(seconds(20));
+  EXPECT_EQ(seconds(20), tested.Deadline());
+}
+
+TEST(AckDeadlineEstimatorTest, Clamped) {
+  AckDeadlineEstimator tested;
+  tested.Record(std::chrono::hours(1));
+  EXPECT_EQ(AckDeadlineEstimator::kMaximumAckDeadline, tested.Deadline());
+  tested.Record(milliseconds(-5));
+  EXPECT_EQ(AckDeadlineEstimator::kMaximumAckDeadline, tested.Deadline());
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,49 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/batch_concurrency_limiter.h"
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+void BatchConcurrencyLimiter::Acquire(std::function<void()> start) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (running_ >= max_concurrency_) {
+    queue_.push_back(std::move(start));
+    return;
+  }
+  ++running_;
+  lk.unlock();
+  start();
+}
+
+void BatchConcurrencyLimiter::Release() {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (queue_.empty()) {
+    --running_;
+    return;
+  }
+  // The completed RPC hands over its slot to the next queued RPC.
+  auto next = std::move(queue_.front());
+  queue_.pop_front();
+  lk.unlock();
+  cq_.RunAsync(std::move(next));
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,78 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_BATCH_CONCURRENCY_LIMITER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_BATCH_CONCURRENCY_LIMITER_H
+
+#include "google/cloud/pubsub/version.h"
+#include "google/cloud/completion_queue.h"
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+/**
+ * Limit the number of concurrent `Publish()` RPCs.
+ *
+ * Batches call `Acquire()` with a function to start the RPC. The function
+ * runs immediately if fewer than `max_concurrency` RPCs are in progress,
+ * otherwise it is queued, and runs (in FIFO order) when a previous RPC calls
+ * `Release()`. A single limiter can be shared by many batchers.
+ *
+ * Queued functions are scheduled on the `CompletionQueue`, and do not run in
+ * the thread calling `Release()`. That thread is completing an RPC, and if the
+ * next RPC also completed immediately (e.g. on errors) running it inline would
+ * recurse once for each queued batch.
+ */
+class BatchConcurrencyLimiter {
+ public:
+  BatchConcurrencyLimiter(google::cloud::CompletionQueue cq,
+                          std::size_t max_concurrency)
+      : cq_(std::move(cq)),
+        max_concurrency_(max_concurrency == 0 ? 1 : max_concurrency) {}
+
+  /// Run @p start when there is capacity for one more RPC.
+  void Acquire(std::function<void()> start);
+
+  /// Called when an RPC completes, starts the next queued RPC (if any).
+  void Release();
+
+  std::size_t running() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return running_;
+  }
+  std::size_t queued() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return queue_.size();
+  }
+
+ private:
+  google::cloud::CompletionQueue cq_;
+  std::size_t const max_concurrency_;
+  mutable std::mutex mu_;
+  std::size_t running_ = 0;
+  std::deque<std::function<void()>> queue_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_BATCH_CONCURRENCY_LIMITER_H
@@ -0,0 +1,106 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/batch_concurrency_limiter.h"
+#include "google/cloud/testing_util/fake_completion_queue_impl.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+
+using ::google::cloud::testing_util::FakeCompletionQueueImpl;
+using ::testing::ElementsAre;
+
+TEST(BatchConcurrencyLimiterTest, Basic) {
+  auto fake = std::make_shared<FakeCompletionQueueImpl>();
+  BatchConcurrencyLimiter tested(CompletionQueue(fake), 2);
+  std::vector<int> started;
+  for (int i = 0; i != 5; ++i) {
+    tested.Acquire([&started, i] { started.push_back(i); });
+  }
+  EXPECT_THAT(started, ElementsAre(0, 1));
+  EXPECT_EQ(2, tested.running());
+  EXPECT_EQ(3, tested.queued());
+
+  // Queued functions are scheduled in the completion queue.
+  tested.Release();
+  EXPECT_THAT(started, ElementsAre(0, 1));
+  EXPECT_EQ(1, fake->size());
+  fake->SimulateCompletion(true);
+  EXPECT_THAT(started, ElementsAre(0, 1, 2));
+  EXPECT_EQ(2, tested.running());
+  tested.Release();
+  tested.Release();
+  fake->SimulateCompletion(true);
+  EXPECT_THAT(started, ElementsAre(0, 1, 2, 3, 4));
+  EXPECT_EQ(0, tested.queued());
+
+  tested.Release();
+  tested.Release();
+  EXPECT_TRUE(fake->empty());
+  EXPECT_EQ(0, tested.running());
+  tested.Acquire([&started] { started.push_back(5); });
+  EXPECT_THAT(started, ElementsAre(0, 1, 2, 3, 4, 5));
+  EXPECT_EQ(1, tested.running());
+}
+
+TEST(BatchConcurrencyLimiterTest, ZeroIsOne) {
+  auto fake = std::make_shared<FakeCompletionQueueImpl>();
+  BatchConcurrencyLimiter tested(CompletionQueue(fake), 0);
+  int count = 0;
+  tested.Acquire([&count] { ++count; });
+  tested.Acquire([&count] { ++count; });
+  EXPECT_EQ(1, count);
+  tested.Release();
+  fake->SimulateCompletion(true);
+  EXPECT_EQ(2, count);
+}
+
+/// @test Verify releasing from a started function does not recurse.
+TEST(BatchConcurrencyLimiterTest, ReleaseDoesNotRecurse) {
+  auto fake = std::make_shared<FakeCompletionQueueImpl>();
+  BatchConcurrencyLimiter tested(CompletionQueue(fake), 1);
+  int depth = 0;
+  int max_depth = 0;
+  int count = 0;
+  // Each function completes immediately, like an RPC failing before it is
+  // sent, and releases its slot before returning.
+  auto start = [&] {
+    ++depth;
+    max_depth = (std::max)(max_depth, depth);
+    ++count;
+    tested.Release();
+    --depth;
+  };
+  tested.Acquire([] {});
+  for (int i = 0; i != 3; ++i) tested.Acquire(start);
+  EXPECT_EQ(3, tested.queued());
+  tested.Release();
+  EXPECT_EQ(0, count);
+  while (!fake->empty()) fake->SimulateCompletion(true);
+  EXPECT_EQ(3, count);
+  EXPECT_EQ(1, max_depth);
+  EXPECT_EQ(0, tested.running());
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -20,6 +20,15 @@ namespace cloud {
 namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
+// A helper callable to satisfy all the waiters in a batch with an error.
+struct SetStatus {
+  std::vector<promise<StatusOr<std::string>>> waiters;
+  Status status;
+  void operator()() {
+    for (auto& w : waiters) w.set_value(status);
+  }
+};
+
 // A helper callable to handle a response, it is a bit large for a lambda, and
 // we need move-capture anyways.
 struct Batch {
@@ -28,9 +37,15 @@ struct Batch {
   google::cloud::CompletionQueue executor;
   std::vector<promise<StatusOr<std::string>>> waiters;
   std::weak_ptr<BatchingPublisherConnection> weak;
+  std::shared_ptr<BatchConcurrencyLimiter> limiter;
+  std::shared_ptr<pubsub::MetricsSink> metrics;
+  std::chrono::steady_clock::time_point ready;
+  std::chrono::steady_clock::time_point sent;
 
   void operator()(future<StatusOr<google::pubsub::v1::PublishResponse>> f) {
+    if (limiter) limiter->Release();
     auto response = f.get();
+    if (metrics) RecordMetrics(response);
     if (!response) {
       SatisfyAllWaiters(response.status());
       if (auto batcher = weak.lock()) batcher->DiscardCorked(response.status());
@@ -42,27 +57,42 @@ struct Batch {
           Status(StatusCode::kUnknown, "mismatched message id count"));
       return;
     }
-    struct SetValue {
-      promise<StatusOr<std::string>> waiter;
-      std::string value;
-      void operator()() { waiter.set_value(std::move(value)); }
+    // A single callback satisfies all the waiters in the batch, scheduling a
+    // callback per message is expensive for large batches. The message ids are
+    // moved out of the response, which the callback owns.
+    struct SetValues {
+      std::vector<promise<StatusOr<std::string>>> waiters;
+      google::pubsub::v1::PublishResponse response;
+      void operator()() {
+        int idx = 0;
+        for (auto& w : waiters) {
+          w.set_value(std::move(*response.mutable_message_ids(idx++)));
+        }
+      }
     };
-    int idx = 0;
-    for (auto& w : waiters) {
-      executor.RunAsync(SetValue{std::move(w), response->message_ids(idx++)});
-    }
+    executor.RunAsync(SetValues{std::move(waiters), std::move(*response)});
     if (auto batcher = weak.lock()) batcher->UnCork();
   }
 
   void SatisfyAllWaiters(Status const& status) {
-    struct SetStatus {
-      promise<StatusOr<std::string>> waiter;
-      Status status;
-      void operator()() { waiter.set_value(std::move(status)); }
-    };
-    for (auto& w : waiters) {
-      executor.RunAsync(SetStatus{std::move(w), status});
-    }
+    executor.RunAsync(SetStatus{std::move(waiters), status});
+  }
+
+  void RecordMetrics(
+      StatusOr<google::pubsub::v1::PublishResponse> const& response) {
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    auto const success =
+        response && static_cast<std::size_t>(response->message_ids_size()) ==
+                        waiters.size();
+    auto const count = static_cast<std::int64_t>(waiters.size());
+    metrics->Increment(pubsub::MetricsCounter::kPublishBatches, 1);
+    metrics->Increment(success ? pubsub::MetricsCounter::kPublishedMessages
+                               : pubsub::MetricsCounter::kPublishFailedMessages,
+                       count);
+    metrics->Record(pubsub::MetricsHistogram::kPublishLatency,
+                    duration_cast<microseconds>(
+                        std::chrono::steady_clock::now() - sent));
   }
 };
 
@@ -97,6 +127,9 @@ future<StatusOr<std::string>> BatchingPublisherConnection::Publish(
   *pending_.add_messages() = std::move(proto);
   undo.release();  // no throws after this point, we can rest easy
   current_bytes_ += bytes;
+  if (metrics_ && pending_.messages_size() == 1) {
+    batch_start_ = std::chrono::steady_clock::now();
+  }
   MaybeFlush(std::move(lk));
   return f;
 }
@@ -123,18 +156,13 @@ void BatchingPublisherConnection::DiscardCorked(Status const& status) {
     corked_ = true;
     corked_status_ = status;
     pending_.Clear();
+    batch_ready_ = {};
     std::vector<promise<StatusOr<std::string>>> tmp;
     tmp.swap(waiters_);
     return tmp;
   }();
-  for (auto& p : waiters) {
-    struct MoveCapture {
-      promise<StatusOr<std::string>> p;
-      Status status;
-      void operator()() { p.set_value(std::move(status)); }
-    };
-    cq_.RunAsync(MoveCapture{std::move(p), status});
-  }
+  if (waiters.empty()) return;
+  cq_.RunAsync(SetStatus{std::move(waiters), status});
 }
 
 void BatchingPublisherConnection::MaybeFlush(std::unique_lock<std::mutex> lk) {
@@ -179,7 +207,13 @@ void BatchingPublisherConnection::OnTimer() {
 }
 
 void BatchingPublisherConnection::FlushImpl(std::unique_lock<std::mutex> lk) {
-  if (pending_.messages().empty() || corked_) return;
+  if (pending_.messages().empty()) return;
+  // The batch is ready the first time we try to flush it, even if it has to
+  // wait for a previous batch with the same ordering key.
+  if (metrics_ && batch_ready_ == std::chrono::steady_clock::time_point{}) {
+    batch_ready_ = std::chrono::steady_clock::now();
+  }
+  if (corked_) return;
 
   Batch batch;
   batch.waiters.swap(waiters_);
@@ -187,14 +221,48 @@ void BatchingPublisherConnection::FlushImpl(std::unique_lock<std::mutex> lk) {
   request.Swap(&pending_);
   corked_ = !ordering_key_.empty();
   current_bytes_ = 0;
+  auto const fill_time = batch_ready_ - batch_start_;
+  batch.ready = batch_ready_;
+  batch_ready_ = {};
   lk.unlock();
 
-  auto context = absl::make_unique<grpc::ClientContext>();
-
   batch.executor = cq_;
   batch.weak = shared_from_this();
+  batch.limiter = limiter_;
+  batch.metrics = metrics_;
+  if (metrics_) {
+    metrics_->Record(
+        pubsub::MetricsHistogram::kBatchFillTime,
+        std::chrono::duration_cast<std::chrono::microseconds>(fill_time));
+  }
   request.set_topic(topic_full_name_);
+  if (!limiter_) {
+    SendBatch(std::move(request), std::move(batch));
+    return;
+  }
 
+  // `std::function<>` requires copyable functors, but `Batch` is move-only.
+  struct PendingBatch {
+    google::pubsub::v1::PublishRequest request;
+    Batch batch;
+  };
+  auto pending = std::make_shared<PendingBatch>();
+  pending->request.Swap(&request);
+  pending->batch = std::move(batch);
+  auto self = shared_from_this();
+  limiter_->Acquire([self, pending] {
+    self->SendBatch(std::move(pending->request), std::move(pending->batch));
+  });
+}
+
+void BatchingPublisherConnection::SendBatch(
+    google::pubsub::v1::PublishRequest request, Batch batch) {
+  if (metrics_) {
+    batch.sent = std::chrono::steady_clock::now();
+    metrics_->Record(pubsub::MetricsHistogram::kBatchCorkedTime,
+                     std::chrono::duration_cast<std::chrono::microseconds>(
+                         batch.sent - batch.ready));
+  }
   auto& stub = stub_;
   google::cloud::internal::AsyncRetryLoop(
       retry_policy_->clone(), backoff_policy_->clone(),
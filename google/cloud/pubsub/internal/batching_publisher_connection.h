@@ -15,8 +15,10 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_BATCHING_PUBLISHER_CONNECTION_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_BATCHING_PUBLISHER_CONNECTION_H
 
+#include "google/cloud/pubsub/internal/batch_concurrency_limiter.h"
 #include "google/cloud/pubsub/publisher_connection.h"
 #include "google/cloud/pubsub/version.h"
+#include <chrono>
 #include <mutex>
 
 namespace google {
@@ -24,6 +26,8 @@ namespace cloud {
 namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
+struct Batch;
+
 class BatchingPublisherConnection
     : public pubsub::PublisherConnection,
       public std::enable_shared_from_this<BatchingPublisherConnection> {
@@ -34,12 +38,13 @@ class BatchingPublisherConnection
       std::shared_ptr<pubsub_internal::PublisherStub> stub,
       google::cloud::CompletionQueue cq,
       std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
-      std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy) {
+      std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy,
+      std::shared_ptr<BatchConcurrencyLimiter> limiter = {}) {
     return std::shared_ptr<BatchingPublisherConnection>(
         new BatchingPublisherConnection(
             std::move(topic), std::move(options), std::move(ordering_key),
             std::move(stub), std::move(cq), std::move(retry_policy),
-            std::move(backoff_policy)));
+            std::move(backoff_policy), std::move(limiter)));
   }
 
   future<StatusOr<std::string>> Publish(PublishParams p) override;
@@ -56,7 +61,8 @@ class BatchingPublisherConnection
       std::shared_ptr<pubsub_internal::PublisherStub> stub,
       google::cloud::CompletionQueue cq,
       std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
-      std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy)
+      std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy,
+      std::shared_ptr<BatchConcurrencyLimiter> limiter)
       : topic_(std::move(topic)),
         topic_full_name_(topic_.FullName()),
         options_(std::move(options)),
@@ -64,11 +70,14 @@ class BatchingPublisherConnection
         stub_(std::move(stub)),
         cq_(std::move(cq)),
         retry_policy_(std::move(retry_policy)),
-        backoff_policy_(std::move(backoff_policy)) {}
+        backoff_policy_(std::move(backoff_policy)),
+        limiter_(std::move(limiter)),
+        metrics_(options_.metrics_sink()) {}
 
   void OnTimer();
   void MaybeFlush(std::unique_lock<std::mutex> lk);
   void FlushImpl(std::unique_lock<std::mutex> lk);
+  void SendBatch(google::pubsub::v1::PublishRequest request, Batch batch);
 
   pubsub::Topic const topic_;
   std::string const topic_full_name_;
@@ -78,6 +87,8 @@ class BatchingPublisherConnection
   google::cloud::CompletionQueue cq_;
   std::unique_ptr<pubsub::RetryPolicy const> retry_policy_;
   std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy_;
+  std::shared_ptr<BatchConcurrencyLimiter> const limiter_;
+  std::shared_ptr<pubsub::MetricsSink> const metrics_;
 
   std::mutex mu_;
   std::vector<promise<StatusOr<std::string>>> waiters_;
@@ -86,6 +97,9 @@ class BatchingPublisherConnection
   std::chrono::system_clock::time_point batch_expiration_;
   bool corked_ = false;
   Status corked_status_;
+  // Only used if `metrics_` is not null.
+  std::chrono::steady_clock::time_point batch_start_;
+  std::chrono::steady_clock::time_point batch_ready_;
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
@@ -17,6 +17,7 @@
 #include "google/cloud/pubsub/testing/test_retry_policies.h"
 #include "google/cloud/future.h"
 #include "google/cloud/testing_util/assert_ok.h"
+#include "google/cloud/testing_util/fake_completion_queue_impl.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include <google/protobuf/text_format.h>
 #include <gmock/gmock.h>
@@ -308,6 +309,112 @@ TEST(BatchingPublisherConnectionTest, BatchByFlush) {
   for (auto& r : results) r.get();
 }
 
+TEST(BatchingPublisherConnectionTest, LimitConcurrentBatches) {
+  auto mock = std::make_shared<pubsub_testing::MockPublisherStub>();
+  pubsub::Topic const topic("test-project", "test-topic");
+
+  std::mutex mu;
+  std::condition_variable cv;
+  std::deque<promise<StatusOr<google::pubsub::v1::PublishResponse>>> rpcs;
+  std::vector<std::string> sent;
+  EXPECT_CALL(*mock, AsyncPublish)
+      .Times(3)
+      .WillRepeatedly([&](google::cloud::CompletionQueue&,
+                          std::unique_ptr<grpc::ClientContext>,
+                          google::pubsub::v1::PublishRequest const& request) {
+        std::lock_guard<std::mutex> lk(mu);
+        sent.push_back(request.messages(0).data());
+        rpcs.emplace_back();
+        cv.notify_all();
+        return rpcs.back().get_future();
+      });
+  // The limiter starts queued batches in the background threads, wait until
+  // the next RPC is sent before completing it.
+  auto complete = [&](std::string const& id) {
+    promise<StatusOr<google::pubsub::v1::PublishResponse>> p;
+    {
+      std::unique_lock<std::mutex> lk(mu);
+      cv.wait(lk, [&] { return !rpcs.empty(); });
+      p = std::move(rpcs.front());
+      rpcs.pop_front();
+    }
+    google::pubsub::v1::PublishResponse response;
+    response.add_message_ids(id);
+    p.set_value(std::move(response));
+  };
+
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads background;
+  auto limiter = std::make_shared<BatchConcurrencyLimiter>(background.cq(), 1);
+  auto publisher = BatchingPublisherConnection::Create(
+      topic, pubsub::PublisherOptions{}.set_maximum_batch_message_count(1),
+      {}, mock, background.cq(), pubsub_testing::TestRetryPolicy(),
+      pubsub_testing::TestBackoffPolicy(), limiter);
+
+  auto f0 =
+      publisher->Publish({pubsub::MessageBuilder{}.SetData("d0").Build()});
+  auto f1 =
+      publisher->Publish({pubsub::MessageBuilder{}.SetData("d1").Build()});
+  auto f2 =
+      publisher->Publish({pubsub::MessageBuilder{}.SetData("d2").Build()});
+  EXPECT_EQ(1, limiter->running());
+  EXPECT_EQ(2, limiter->queued());
+  {
+    std::lock_guard<std::mutex> lk(mu);
+    EXPECT_THAT(sent, ElementsAre("d0"));
+  }
+
+  // Completing each RPC starts the next queued batch.
+  complete("id-0");
+  EXPECT_EQ("id-0", f0.get().value());
+  complete("id-1");
+  EXPECT_EQ("id-1", f1.get().value());
+  complete("id-2");
+  EXPECT_EQ("id-2", f2.get().value());
+  {
+    std::lock_guard<std::mutex> lk(mu);
+    EXPECT_THAT(sent, ElementsAre("d0", "d1", "d2"));
+  }
+  EXPECT_EQ(0, limiter->running());
+}
+
+TEST(BatchingPublisherConnectionTest, SingleCallbackPerBatch) {
+  auto mock = std::make_shared<pubsub_testing::MockPublisherStub>();
+  pubsub::Topic const topic("test-project", "test-topic");
+
+  EXPECT_CALL(*mock, AsyncPublish)
+      .WillOnce([&](google::cloud::CompletionQueue&,
+                    std::unique_ptr<grpc::ClientContext>,
+                    google::pubsub::v1::PublishRequest const& request) {
+        EXPECT_EQ(3, request.messages_size());
+        google::pubsub::v1::PublishResponse response;
+        response.add_message_ids("test-message-id-0");
+        response.add_message_ids("test-message-id-1");
+        response.add_message_ids("test-message-id-2");
+        return make_ready_future(make_status_or(response));
+      });
+
+  auto fake = std::make_shared<testing_util::FakeCompletionQueueImpl>();
+  google::cloud::CompletionQueue cq(fake);
+  auto publisher = BatchingPublisherConnection::Create(
+      topic, pubsub::PublisherOptions{}.set_maximum_batch_message_count(3),
+      std::string{}, mock, cq, pubsub_testing::TestRetryPolicy(),
+      pubsub_testing::TestBackoffPolicy());
+  std::vector<future<StatusOr<std::string>>> results;
+  for (int i = 0; i != 3; ++i) {
+    results.push_back(publisher->Publish(
+        {pubsub::MessageBuilder{}.SetData("d" + std::to_string(i)).Build()}));
+  }
+  // The first message starts the hold timer, the response must schedule a
+  // single callback for all the messages in the batch.
+  EXPECT_EQ(2, fake->size());
+  fake->SimulateCompletion(true);
+  for (int i = 0; i != 3; ++i) {
+    auto r = results[i].get();
+    ASSERT_STATUS_OK(r);
+    EXPECT_EQ("test-message-id-" + std::to_string(i), *r);
+  }
+}
+
 TEST(BatchingPublisherConnectionTest, HandleError) {
   auto mock = std::make_shared<pubsub_testing::MockPublisherStub>();
   pubsub::Topic const topic("test-project", "test-topic");
@@ -380,6 +487,57 @@ TEST(BatchingPublisherConnectionTest, HandleInvalidResponse) {
   r1.get();
 }
 
+TEST(BatchingPublisherConnectionTest, ReportsMetrics) {
+  auto mock = std::make_shared<pubsub_testing::MockPublisherStub>();
+  pubsub::Topic const topic("test-project", "test-topic");
+
+  EXPECT_CALL(*mock, AsyncPublish)
+      .WillOnce([&](google::cloud::CompletionQueue&,
+                    std::unique_ptr<grpc::ClientContext>,
+                    google::pubsub::v1::PublishRequest const&) {
+        google::pubsub::v1::PublishResponse response;
+        response.add_message_ids("test-message-id-0");
+        response.add_message_ids("test-message-id-1");
+        return make_ready_future(make_status_or(response));
+      })
+      .WillOnce([&](google::cloud::CompletionQueue&,
+                    std::unique_ptr<grpc::ClientContext>,
+                    google::pubsub::v1::PublishRequest const&) {
+        return make_ready_future(StatusOr<google::pubsub::v1::PublishResponse>(
+            Status(StatusCode::kPermissionDenied, "uh-oh")));
+      });
+
+  auto metrics = std::make_shared<pubsub::InProcessMetricsSink>();
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads background;
+  auto const ordering_key = std::string{};
+  auto publisher = BatchingPublisherConnection::Create(
+      topic,
+      pubsub::PublisherOptions{}
+          .set_maximum_batch_message_count(2)
+          .set_metrics_sink(metrics),
+      ordering_key, mock, background.cq(), pubsub_testing::TestRetryPolicy(),
+      pubsub_testing::TestBackoffPolicy());
+
+  std::vector<future<StatusOr<std::string>>> results;
+  for (int i = 0; i != 3; ++i) {
+    results.push_back(publisher->Publish(
+        {pubsub::MessageBuilder{}
+             .SetData("test-data-" + std::to_string(i))
+             .Build()}));
+  }
+  publisher->Flush({});
+  for (auto& r : results) r.get();
+
+  using pubsub::MetricsCounter;
+  using pubsub::MetricsHistogram;
+  EXPECT_EQ(2, metrics->counter(MetricsCounter::kPublishBatches));
+  EXPECT_EQ(2, metrics->counter(MetricsCounter::kPublishedMessages));
+  EXPECT_EQ(1, metrics->counter(MetricsCounter::kPublishFailedMessages));
+  EXPECT_EQ(2, metrics->histogram(MetricsHistogram::kBatchFillTime).count);
+  EXPECT_EQ(2, metrics->histogram(MetricsHistogram::kBatchCorkedTime).count);
+  EXPECT_EQ(2, metrics->histogram(MetricsHistogram::kPublishLatency).count);
+}
+
 TEST(BatchingPublisherConnectionTest, OrderingBatchCorked) {
   auto mock = std::make_shared<pubsub_testing::MockPublisherStub>();
   pubsub::Topic const topic("test-project", "test-topic");
@@ -0,0 +1,88 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/flow_controlled_publisher_connection.h"
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+future<StatusOr<std::string>> FlowControlledPublisherConnection::Publish(
+    PublishParams p) {
+  auto const bytes = pubsub_internal::MessageSize(p.message);
+  std::unique_lock<std::mutex> lk(mu_);
+  if (IsFull(bytes)) {
+    if (options_.full_publisher_rejects()) {
+      ++rejected_;
+      return make_ready_future(StatusOr<std::string>(
+          Status(StatusCode::kFailedPrecondition, "the publisher is full")));
+    }
+    if (options_.full_publisher_blocks()) {
+      ++blocked_;
+      cv_.wait(lk, [&] { return !IsFull(bytes); });
+    }
+  }
+  ++pending_messages_;
+  pending_bytes_ += bytes;
+  lk.unlock();
+
+  // Pending messages should not extend the lifetime of this object, the
+  // application may discard the publisher before they complete.
+  auto weak =
+      std::weak_ptr<FlowControlledPublisherConnection>(shared_from_this());
+  return child_->Publish(std::move(p))
+      .then([weak, bytes](future<StatusOr<std::string>> f) {
+        if (auto self = weak.lock()) self->OnPublish(bytes);
+        return f.get();
+      });
+}
+
+void FlowControlledPublisherConnection::Flush(FlushParams p) {
+  child_->Flush(p);
+}
+
+void FlowControlledPublisherConnection::ResumePublish(ResumePublishParams p) {
+  child_->ResumePublish(std::move(p));
+}
+
+pubsub::PublisherFlowControlMetrics
+FlowControlledPublisherConnection::FlowControlMetrics(
+    FlowControlMetricsParams) {
+  std::lock_guard<std::mutex> lk(mu_);
+  return pubsub::PublisherFlowControlMetrics{pending_messages_, pending_bytes_,
+                                             blocked_, rejected_};
+}
+
+bool FlowControlledPublisherConnection::IsFull(std::size_t bytes) const {
+  // Always accept at least one message, otherwise a message larger than the
+  // limit would block forever.
+  if (pending_messages_ == 0) return false;
+  if (pending_messages_ >= options_.maximum_pending_messages()) return true;
+  auto const max_bytes = options_.maximum_pending_bytes();
+  return pending_bytes_ >= max_bytes || bytes > max_bytes - pending_bytes_;
+}
+
+void FlowControlledPublisherConnection::OnPublish(std::size_t bytes) {
+  std::unique_lock<std::mutex> lk(mu_);
+  --pending_messages_;
+  pending_bytes_ -= bytes;
+  lk.unlock();
+  cv_.notify_all();
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,84 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_FLOW_CONTROLLED_PUBLISHER_CONNECTION_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_FLOW_CONTROLLED_PUBLISHER_CONNECTION_H
+
+#include "google/cloud/pubsub/publisher_connection.h"
+#include "google/cloud/pubsub/publisher_options.h"
+#include "google/cloud/pubsub/version.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+/**
+ * Implement the publisher flow control as a decorator.
+ *
+ * Tracks the number of messages, and their total size, from the time
+ * `Publish()` is called until the future returned by the child connection is
+ * satisfied. Depending on the `PublisherOptions`, messages that would exceed
+ * the limits are accepted anyway, rejected, or block the caller.
+ */
+class FlowControlledPublisherConnection
+    : public pubsub::PublisherConnection,
+      public std::enable_shared_from_this<FlowControlledPublisherConnection> {
+ public:
+  static std::shared_ptr<FlowControlledPublisherConnection> Create(
+      pubsub::PublisherOptions const& options,
+      std::shared_ptr<pubsub::PublisherConnection> child) {
+    return std::shared_ptr<FlowControlledPublisherConnection>(
+        new FlowControlledPublisherConnection(options, std::move(child)));
+  }
+
+  ~FlowControlledPublisherConnection() override = default;
+
+  future<StatusOr<std::string>> Publish(PublishParams p) override;
+  void Flush(FlushParams) override;
+  void ResumePublish(ResumePublishParams p) override;
+  pubsub::PublisherFlowControlMetrics FlowControlMetrics(
+      FlowControlMetricsParams) override;
+
+ private:
+  FlowControlledPublisherConnection(
+      pubsub::PublisherOptions const& options,
+      std::shared_ptr<pubsub::PublisherConnection> child)
+      : options_(options), child_(std::move(child)) {}
+
+  bool IsFull(std::size_t bytes) const;
+  void OnPublish(std::size_t bytes);
+
+  pubsub::PublisherOptions const options_;
+  std::shared_ptr<pubsub::PublisherConnection> const child_;
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::size_t pending_messages_ = 0;
+  std::size_t pending_bytes_ = 0;
+  std::int64_t blocked_ = 0;
+  std::int64_t rejected_ = 0;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_FLOW_CONTROLLED_PUBLISHER_CONNECTION_H
@@ -0,0 +1,192 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/flow_controlled_publisher_connection.h"
+#include "google/cloud/pubsub/mocks/mock_publisher_connection.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <deque>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+
+pubsub::Message MakeMessage(std::string data) {
+  return pubsub::MessageBuilder{}.SetData(std::move(data)).Build();
+}
+
+/// Return futures satisfied when the test calls `Complete()`.
+class PendingPublishes {
+ public:
+  future<StatusOr<std::string>> Publish(
+      pubsub::PublisherConnection::PublishParams const&) {
+    std::lock_guard<std::mutex> lk(mu_);
+    promises_.emplace_back();
+    return promises_.back().get_future();
+  }
+
+  void Complete(std::size_t i) {
+    promise<StatusOr<std::string>> p;
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      p = std::move(promises_.at(i));
+    }
+    p.set_value("id-" + std::to_string(i));
+  }
+
+ private:
+  std::mutex mu_;
+  std::deque<promise<StatusOr<std::string>>> promises_;
+};
+
+TEST(FlowControlledPublisherConnectionTest, IgnoredByDefault) {
+  auto mock = std::make_shared<pubsub_mocks::MockPublisherConnection>();
+  PendingPublishes pending;
+  EXPECT_CALL(*mock, Publish)
+      .Times(3)
+      .WillRepeatedly([&](pubsub::PublisherConnection::PublishParams const& p) {
+        return pending.Publish(p);
+      });
+
+  auto uut = FlowControlledPublisherConnection::Create(
+      pubsub::PublisherOptions{}.set_maximum_pending_messages(1), mock);
+  auto f0 = uut->Publish({MakeMessage("a")});
+  auto f1 = uut->Publish({MakeMessage("b")});
+  auto f2 = uut->Publish({MakeMessage("c")});
+  auto m = uut->FlowControlMetrics({});
+  EXPECT_EQ(3, m.pending_messages);
+  EXPECT_LT(0, m.pending_bytes);
+
+  pending.Complete(0);
+  pending.Complete(1);
+  pending.Complete(2);
+  auto r = f1.get();
+  ASSERT_STATUS_OK(r);
+  EXPECT_EQ("id-1", *r);
+  (void)f0.get();
+  (void)f2.get();
+  m = uut->FlowControlMetrics({});
+  EXPECT_EQ(0, m.pending_messages);
+  EXPECT_EQ(0, m.pending_bytes);
+  EXPECT_EQ(0, m.blocked);
+  EXPECT_EQ(0, m.rejected);
+}
+
+TEST(FlowControlledPublisherConnectionTest, Rejects) {
+  auto mock = std::make_shared<pubsub_mocks::MockPublisherConnection>();
+  PendingPublishes pending;
+  EXPECT_CALL(*mock, Publish)
+      .Times(3)
+      .WillRepeatedly([&](pubsub::PublisherConnection::PublishParams const& p) {
+        return pending.Publish(p);
+      });
+
+  auto uut = FlowControlledPublisherConnection::Create(
+      pubsub::PublisherOptions{}
+          .set_maximum_pending_messages(2)
+          .set_full_publisher_rejects(),
+      mock);
+  auto f0 = uut->Publish({MakeMessage("a")});
+  auto f1 = uut->Publish({MakeMessage("b")});
+  auto r = uut->Publish({MakeMessage("c")}).get();
+  EXPECT_THAT(r.status(), StatusIs(StatusCode::kFailedPrecondition));
+  EXPECT_EQ(1, uut->FlowControlMetrics({}).rejected);
+
+  // Once a message completes there is room for one more.
+  pending.Complete(0);
+  ASSERT_STATUS_OK(f0.get());
+  auto f2 = uut->Publish({MakeMessage("c")});
+  EXPECT_EQ(2, uut->FlowControlMetrics({}).pending_messages);
+  pending.Complete(1);
+  pending.Complete(2);
+  ASSERT_STATUS_OK(f1.get());
+  ASSERT_STATUS_OK(f2.get());
+}
+
+TEST(FlowControlledPublisherConnectionTest, RejectsBytes) {
+  auto mock = std::make_shared<pubsub_mocks::MockPublisherConnection>();
+  PendingPublishes pending;
+  EXPECT_CALL(*mock, Publish)
+      .Times(2)
+      .WillRepeatedly([&](pubsub::PublisherConnection::PublishParams const& p) {
+        return pending.Publish(p);
+      });
+
+  auto const large = MakeMessage(std::string(1024, 'x'));
+  auto uut = FlowControlledPublisherConnection::Create(
+      pubsub::PublisherOptions{}
+          .set_maximum_pending_bytes(512)
+          .set_full_publisher_rejects(),
+      mock);
+  // A message larger than the limit is accepted when nothing is pending.
+  auto f0 = uut->Publish({large});
+  auto r = uut->Publish({MakeMessage("a")}).get();
+  EXPECT_THAT(r.status(), StatusIs(StatusCode::kFailedPrecondition));
+
+  pending.Complete(0);
+  ASSERT_STATUS_OK(f0.get());
+  auto f1 = uut->Publish({MakeMessage("a")});
+  pending.Complete(1);
+  ASSERT_STATUS_OK(f1.get());
+}
+
+TEST(FlowControlledPublisherConnectionTest, Blocks) {
+  auto mock = std::make_shared<pubsub_mocks::MockPublisherConnection>();
+  PendingPublishes pending;
+  EXPECT_CALL(*mock, Publish)
+      .Times(2)
+      .WillRepeatedly([&](pubsub::PublisherConnection::PublishParams const& p) {
+        return pending.Publish(p);
+      });
+
+  auto uut = FlowControlledPublisherConnection::Create(
+      pubsub::PublisherOptions{}
+          .set_maximum_pending_messages(1)
+          .set_full_publisher_blocks(),
+      mock);
+  auto f0 = uut->Publish({MakeMessage("a")});
+
+  promise<void> started;
+  future<StatusOr<std::string>> f1;
+  std::thread t([&] {
+    started.set_value();
+    f1 = uut->Publish({MakeMessage("b")});
+  });
+  started.get_future().get();
+  // The second call cannot proceed until the first message completes.
+  for (int i = 0; i != 100 && uut->FlowControlMetrics({}).blocked == 0; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(1, uut->FlowControlMetrics({}).blocked);
+  EXPECT_EQ(1, uut->FlowControlMetrics({}).pending_messages);
+
+  pending.Complete(0);
+  t.join();
+  ASSERT_STATUS_OK(f0.get());
+  pending.Complete(1);
+  ASSERT_STATUS_OK(f1.get());
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,167 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/multi_stream_subscription_batch_source.h"
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+std::chrono::seconds constexpr MultiStreamSubscriptionBatchSource::kPrunePeriod;
+
+void MultiStreamSubscriptionBatchSource::Start(BatchCallback callback) {
+  auto weak =
+      std::weak_ptr<MultiStreamSubscriptionBatchSource>(shared_from_this());
+  for (std::size_t i = 0; i != children_.size(); ++i) {
+    children_[i]->Start(
+        [weak, i,
+         callback](StatusOr<google::pubsub::v1::StreamingPullResponse> r) {
+          if (auto self = weak.lock()) self->OnRead(i, r);
+          callback(std::move(r));
+        });
+  }
+}
+
+void MultiStreamSubscriptionBatchSource::Shutdown() {
+  for (auto& c : children_) c->Shutdown();
+  std::lock_guard<std::mutex> lk(mu_);
+  routes_.clear();
+}
+
+void MultiStreamSubscriptionBatchSource::AckMessage(std::string const& ack_id) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto const child = ChildFor(lk, ack_id);
+  lk.unlock();
+  children_[child]->AckMessage(ack_id);
+}
+
+void MultiStreamSubscriptionBatchSource::NackMessage(
+    std::string const& ack_id) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto const child = ChildFor(lk, ack_id);
+  lk.unlock();
+  children_[child]->NackMessage(ack_id);
+}
+
+void MultiStreamSubscriptionBatchSource::BulkAck(
+    std::vector<std::string> ack_ids) {
+  auto partitions = Partition(std::move(ack_ids));
+  for (std::size_t i = 0; i != partitions.size(); ++i) {
+    if (partitions[i].empty()) continue;
+    children_[i]->BulkAck(std::move(partitions[i]));
+  }
+}
+
+void MultiStreamSubscriptionBatchSource::BulkNack(
+    std::vector<std::string> ack_ids) {
+  auto partitions = Partition(std::move(ack_ids));
+  for (std::size_t i = 0; i != partitions.size(); ++i) {
+    if (partitions[i].empty()) continue;
+    children_[i]->BulkNack(std::move(partitions[i]));
+  }
+}
+
+void MultiStreamSubscriptionBatchSource::ExtendLeases(
+    std::vector<std::string> ack_ids, std::chrono::seconds extension) {
+  std::vector<std::vector<std::string>> partitions(children_.size());
+  std::unique_lock<std::mutex> lk(mu_);
+  auto const lease_deadline = clock_() + extension;
+  for (auto& a : ack_ids) {
+    auto i = routes_.find(a);
+    if (i == routes_.end()) {
+      partitions[0].push_back(std::move(a));
+      continue;
+    }
+    i->second.lease_deadline = lease_deadline;
+    partitions[i->second.child].push_back(std::move(a));
+  }
+  lk.unlock();
+  for (std::size_t i = 0; i != partitions.size(); ++i) {
+    if (partitions[i].empty()) continue;
+    children_[i]->ExtendLeases(std::move(partitions[i]), extension);
+  }
+}
+
+void MultiStreamSubscriptionBatchSource::UpdateStreamAckDeadline(
+    std::chrono::seconds deadline) {
+  std::unique_lock<std::mutex> lk(mu_);
+  stream_ack_deadline_ = deadline;
+  lk.unlock();
+  for (auto& c : children_) c->UpdateStreamAckDeadline(deadline);
+}
+
+void MultiStreamSubscriptionBatchSource::OnRead(
+    std::size_t child,
+    StatusOr<google::pubsub::v1::StreamingPullResponse> const& response) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (!response) {
+    // The child stopped, it will not receive any more acks or extensions.
+    for (auto i = routes_.begin(); i != routes_.end();) {
+      if (i->second.child == child) {
+        i = routes_.erase(i);
+      } else {
+        ++i;
+      }
+    }
+    return;
+  }
+  auto const now = clock_();
+  if (now >= next_prune_) PruneExpired(lk, now);
+  auto const lease_deadline = now + stream_ack_deadline_;
+  for (auto const& m : response->received_messages()) {
+    routes_[m.ack_id()] = Route{child, lease_deadline};
+  }
+}
+
+void MultiStreamSubscriptionBatchSource::PruneExpired(
+    std::unique_lock<std::mutex> const&,
+    std::chrono::system_clock::time_point now) {
+  next_prune_ = now + kPrunePeriod;
+  for (auto i = routes_.begin(); i != routes_.end();) {
+    if (i->second.lease_deadline < now) {
+      i = routes_.erase(i);
+    } else {
+      ++i;
+    }
+  }
+}
+
+std::size_t MultiStreamSubscriptionBatchSource::ChildFor(
+    std::unique_lock<std::mutex> const&, std::string const& ack_id) {
+  auto i = routes_.find(ack_id);
+  // Any stream for the subscription can ack the message, use the first one
+  // for messages we did not deliver.
+  if (i == routes_.end()) return 0;
+  auto const child = i->second.child;
+  routes_.erase(i);
+  return child;
+}
+
+std::vector<std::vector<std::string>>
+MultiStreamSubscriptionBatchSource::Partition(
+    std::vector<std::string> ack_ids) {
+  std::vector<std::vector<std::string>> partitions(children_.size());
+  std::unique_lock<std::mutex> lk(mu_);
+  for (auto& a : ack_ids) {
+    auto const child = ChildFor(lk, a);
+    partitions[child].push_back(std::move(a));
+  }
+  return partitions;
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
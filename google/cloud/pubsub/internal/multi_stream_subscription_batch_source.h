@@ -0,0 +1,110 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_MULTI_STREAM_SUBSCRIPTION_BATCH_SOURCE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_MULTI_STREAM_SUBSCRIPTION_BATCH_SOURCE_H
+
+#include "google/cloud/pubsub/internal/subscription_batch_source.h"
+#include "google/cloud/pubsub/version.h"
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+/**
+ * Combine several batch sources, typically one per streaming pull, into one.
+ *
+ * The messages from all the children are delivered to a single callback, so
+ * the lease management, flow control, and concurrency control layers above
+ * this class are shared by all the streams. Acks, nacks, and lease extensions
+ * are routed to the child that delivered the message.
+ *
+ * The routes are forgotten once the message is handled, its lease (probably)
+ * expired, or the child that delivered it shut down. Any child can handle the
+ * messages without a route, so forgetting a route too early is harmless.
+ */
+class MultiStreamSubscriptionBatchSource
+    : public SubscriptionBatchSource,
+      public std::enable_shared_from_this<MultiStreamSubscriptionBatchSource> {
+ public:
+  /// How often the routes for expired leases are removed.
+  static auto constexpr kPrunePeriod = std::chrono::seconds(10);
+
+  /// A wrapper to read the current time, tests can provide a fake clock.
+  using Clock = std::function<std::chrono::system_clock::time_point()>;
+
+  explicit MultiStreamSubscriptionBatchSource(
+      std::vector<std::shared_ptr<SubscriptionBatchSource>> children,
+      Clock clock = [] { return std::chrono::system_clock::now(); })
+      : children_(std::move(children)), clock_(std::move(clock)) {}
+
+  ~MultiStreamSubscriptionBatchSource() override = default;
+
+  void Start(BatchCallback callback) override;
+  void Shutdown() override;
+  void AckMessage(std::string const& ack_id) override;
+  void NackMessage(std::string const& ack_id) override;
+  void BulkAck(std::vector<std::string> ack_ids) override;
+  void BulkNack(std::vector<std::string> ack_ids) override;
+  void ExtendLeases(std::vector<std::string> ack_ids,
+                    std::chrono::seconds extension) override;
+  void UpdateStreamAckDeadline(std::chrono::seconds deadline) override;
+
+ private:
+  void OnRead(
+      std::size_t child,
+      StatusOr<google::pubsub::v1::StreamingPullResponse> const& response);
+
+  /// Remove the routes for leases that expired before @p now.
+  void PruneExpired(std::unique_lock<std::mutex> const& lk,
+                    std::chrono::system_clock::time_point now);
+
+  /// Return the child that delivered @p ack_id, and forget the route.
+  std::size_t ChildFor(std::unique_lock<std::mutex> const& lk,
+                       std::string const& ack_id);
+
+  /// Split @p ack_ids by the child that delivered each message.
+  std::vector<std::vector<std::string>> Partition(
+      std::vector<std::string> ack_ids);
+
+  std::vector<std::shared_ptr<SubscriptionBatchSource>> const children_;
+  Clock const clock_;
+
+  std::mutex mu_;
+  struct Route {
+    std::size_t child;
+    // When the lease for the message expires, unless it is extended.
+    std::chrono::system_clock::time_point lease_deadline;
+  };
+  std::unordered_map<std::string, Route> routes_;
+  // The children may start with any deadline, until the first update assume
+  // the longest one.
+  std::chrono::seconds stream_ack_deadline_ = std::chrono::seconds(600);
+  std::chrono::system_clock::time_point next_prune_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_MULTI_STREAM_SUBSCRIPTION_BATCH_SOURCE_H
@@ -0,0 +1,178 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/multi_stream_subscription_batch_source.h"
+#include "google/cloud/pubsub/testing/mock_subscription_batch_source.h"
+#include "google/cloud/testing_util/status_matchers.h"
+#include <gmock/gmock.h>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+
+using ::google::cloud::testing_util::StatusIs;
+using ::testing::ElementsAre;
+
+google::pubsub::v1::StreamingPullResponse GenerateMessages(
+    std::string const& prefix, int count) {
+  google::pubsub::v1::StreamingPullResponse response;
+  for (int i = 0; i != count; ++i) {
+    auto const id = prefix + std::to_string(i);
+    auto& m = *response.add_received_messages();
+    m.set_ack_id("ack-" + id);
+    m.mutable_message()->set_message_id("message-" + id);
+  }
+  return response;
+}
+
+TEST(MultiStreamSubscriptionBatchSourceTest, RoutesToDeliveringStream) {
+  auto m0 = std::make_shared<pubsub_testing::MockSubscriptionBatchSource>();
+  auto m1 = std::make_shared<pubsub_testing::MockSubscriptionBatchSource>();
+  BatchCallback cb0;
+  BatchCallback cb1;
+  EXPECT_CALL(*m0, Start).WillOnce([&](BatchCallback cb) { cb0 = cb; });
+  EXPECT_CALL(*m1, Start).WillOnce([&](BatchCallback cb) { cb1 = cb; });
+
+  EXPECT_CALL(*m0, AckMessage("ack-0-0")).Times(1);
+  EXPECT_CALL(*m1, NackMessage("ack-1-0")).Times(1);
+  EXPECT_CALL(*m0,
+              ExtendLeases(ElementsAre("ack-0-1"), std::chrono::seconds(10)))
+      .Times(1);
+  EXPECT_CALL(*m1, ExtendLeases(ElementsAre("ack-1-1", "ack-1-2"),
+                                std::chrono::seconds(10)))
+      .Times(1);
+  EXPECT_CALL(*m0, BulkNack(ElementsAre("ack-0-1", "ack-unknown"))).Times(1);
+  EXPECT_CALL(*m1, BulkNack(ElementsAre("ack-1-1", "ack-1-2"))).Times(1);
+  EXPECT_CALL(*m0, Shutdown).Times(1);
+  EXPECT_CALL(*m1, Shutdown).Times(1);
+
+  auto uut = std::make_shared<MultiStreamSubscriptionBatchSource>(
+      std::vector<std::shared_ptr<SubscriptionBatchSource>>{m0, m1});
+  int received = 0;
+  uut->Start([&](StatusOr<google::pubsub::v1::StreamingPullResponse> r) {
+    ASSERT_TRUE(r.ok());
+    received += r->received_messages_size();
+  });
+  cb0(GenerateMessages("0-", 2));
+  cb1(GenerateMessages("1-", 3));
+  EXPECT_EQ(5, received);
+
+  uut->AckMessage("ack-0-0");
+  uut->NackMessage("ack-1-0");
+  uut->ExtendLeases({"ack-1-1", "ack-0-1", "ack-1-2"},
+                    std::chrono::seconds(10));
+  uut->BulkNack({"ack-1-1", "ack-0-1", "ack-unknown", "ack-1-2"});
+  uut->Shutdown();
+}
+
+TEST(MultiStreamSubscriptionBatchSourceTest, BulkAckRoutesToDeliveringStream) {
+  auto m0 = std::make_shared<pubsub_testing::MockSubscriptionBatchSource>();
+  auto m1 = std::make_shared<pubsub_testing::MockSubscriptionBatchSource>();
+  BatchCallback cb0;
+  BatchCallback cb1;
+  EXPECT_CALL(*m0, Start).WillOnce([&](BatchCallback cb) { cb0 = cb; });
+  EXPECT_CALL(*m1, Start).WillOnce([&](BatchCallback cb) { cb1 = cb; });
+  EXPECT_CALL(*m0, BulkAck(ElementsAre("ack-0-0", "ack-0-1"))).Times(1);
+  EXPECT_CALL(*m1, BulkAck(ElementsAre("ack-1-1"))).Times(1);
+
+  auto uut = std::make_shared<MultiStreamSubscriptionBatchSource>(
+      std::vector<std::shared_ptr<SubscriptionBatchSource>>{m0, m1});
+  uut->Start([](StatusOr<google::pubsub::v1::StreamingPullResponse> const&) {});
+  cb0(GenerateMessages("0-", 2));
+  cb1(GenerateMessages("1-", 2));
+  uut->BulkAck({"ack-0-0", "ack-1-1", "ack-0-1"});
+}
+
+TEST(MultiStreamSubscriptionBatchSourceTest, ForwardsErrors) {
+  auto m0 = std::make_shared<pubsub_testing::MockSubscriptionBatchSource>();
+  auto m1 = std::make_shared<pubsub_testing::MockSubscriptionBatchSource>();
+  BatchCallback cb1;
+  EXPECT_CALL(*m0, Start).Times(1);
+  EXPECT_CALL(*m1, Start).WillOnce([&](BatchCallback cb) { cb1 = cb; });
+
+  auto uut = std::make_shared<MultiStreamSubscriptionBatchSource>(
+      std::vector<std::shared_ptr<SubscriptionBatchSource>>{m0, m1});
+  Status last;
+  uut->Start([&](StatusOr<google::pubsub::v1::StreamingPullResponse> r) {
+    last = std::move(r).status();
+  });
+  cb1(Status{StatusCode::kPermissionDenied, "uh-oh"});
+  EXPECT_THAT(last, StatusIs(StatusCode::kPermissionDenied, "uh-oh"));
+}
+
+TEST(MultiStreamSubscriptionBatchSourceTest, PrunesExpiredLeases) {
+  auto m0 = std::make_shared<pubsub_testing::MockSubscriptionBatchSource>();
+  auto m1 = std::make_shared<pubsub_testing::MockSubscriptionBatchSource>();
+  BatchCallback cb0;
+  BatchCallback cb1;
+  EXPECT_CALL(*m0, Start).WillOnce([&](BatchCallback cb) { cb0 = cb; });
+  EXPECT_CALL(*m1, Start).WillOnce([&](BatchCallback cb) { cb1 = cb; });
+  EXPECT_CALL(*m0, UpdateStreamAckDeadline(std::chrono::seconds(10)))
+      .Times(1);
+  EXPECT_CALL(*m1, UpdateStreamAckDeadline(std::chrono::seconds(10)))
+      .Times(1);
+  EXPECT_CALL(*m1,
+              ExtendLeases(ElementsAre("ack-1-1"), std::chrono::seconds(30)))
+      .Times(1);
+  // The lease for "ack-1-0" expired, its route is forgotten and the ack uses
+  // the first stream.
+  EXPECT_CALL(*m0, AckMessage("ack-1-0")).Times(1);
+  EXPECT_CALL(*m1, AckMessage("ack-1-1")).Times(1);
+
+  auto now = std::chrono::system_clock::now();
+  auto uut = std::make_shared<MultiStreamSubscriptionBatchSource>(
+      std::vector<std::shared_ptr<SubscriptionBatchSource>>{m0, m1},
+      [&now] { return now; });
+  uut->Start([](StatusOr<google::pubsub::v1::StreamingPullResponse> const&) {});
+  uut->UpdateStreamAckDeadline(std::chrono::seconds(10));
+  cb1(GenerateMessages("1-", 2));
+  now += std::chrono::seconds(5);
+  uut->ExtendLeases({"ack-1-1"}, std::chrono::seconds(30));
+  // The next read removes any expired routes.
+  now += std::chrono::seconds(15);
+  cb0(GenerateMessages("0-", 1));
+
+  uut->AckMessage("ack-1-0");
+  uut->AckMessage("ack-1-1");
+}
+
+TEST(MultiStreamSubscriptionBatchSourceTest, ForgetsRoutesForFailedStream) {
+  auto m0 = std::make_shared<pubsub_testing::MockSubscriptionBatchSource>();
+  auto m1 = std::make_shared<pubsub_testing::MockSubscriptionBatchSource>();
+  BatchCallback cb0;
+  BatchCallback cb1;
+  EXPECT_CALL(*m0, Start).WillOnce([&](BatchCallback cb) { cb0 = cb; });
+  EXPECT_CALL(*m1, Start).WillOnce([&](BatchCallback cb) { cb1 = cb; });
+  EXPECT_CALL(*m0, AckMessage("ack-0-0")).Times(1);
+  EXPECT_CALL(*m0, AckMessage("ack-1-0")).Times(1);
+
+  auto uut = std::make_shared<MultiStreamSubscriptionBatchSource>(
+      std::vector<std::shared_ptr<SubscriptionBatchSource>>{m0, m1});
+  uut->Start([](StatusOr<google::pubsub::v1::StreamingPullResponse> const&) {});
+  cb0(GenerateMessages("0-", 1));
+  cb1(GenerateMessages("1-", 1));
+  cb1(Status{StatusCode::kUnavailable, "try-again"});
+
+  uut->AckMessage("ack-0-0");
+  uut->AckMessage("ack-1-0");
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
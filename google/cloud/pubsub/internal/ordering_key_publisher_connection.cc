@@ -19,10 +19,49 @@ namespace cloud {
 namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
+std::size_t constexpr OrderingKeyPublisherConnection::kShardCount;
+
+OrderingKeyPublisherConnection::OrderingKeyPublisherConnection(
+    ConnectionFactory factory, std::chrono::milliseconds idle_timeout,
+    std::function<Clock::time_point()> now)
+    : factory_(std::move(factory)),
+      idle_timeout_(idle_timeout),
+      now_(std::move(now)) {
+  auto const next_sweep = now_() + idle_timeout_;
+  shards_.reserve(kShardCount);
+  for (std::size_t i = 0; i != kShardCount; ++i) {
+    shards_.push_back(std::make_shared<Shard>());
+    shards_.back()->next_sweep = next_sweep;
+  }
+}
+
 future<StatusOr<std::string>> OrderingKeyPublisherConnection::Publish(
     PublishParams p) {
-  auto child = GetChild(p.message.ordering_key());
-  return child->Publish(std::move(p));
+  auto shard = ShardFor(p.message.ordering_key());
+  auto child = [&] {
+    auto const now = now_();
+    std::lock_guard<std::mutex> lk(shard->mu);
+    if (now >= shard->next_sweep) Sweep(*shard, now);
+    auto& c = shard->children[p.message.ordering_key()];
+    if (!c) {
+      c = std::make_shared<Child>();
+      c->connection = factory_(p.message.ordering_key());
+    }
+    ++c->pending;
+    c->last_used = now;
+    return c;
+  }();
+  // The child and the shard may outlive this object, capture them directly.
+  auto now = now_;
+  return child->connection->Publish(std::move(p))
+      .then([shard, child, now](future<StatusOr<std::string>> f) {
+        auto r = f.get();
+        std::lock_guard<std::mutex> lk(shard->mu);
+        --child->pending;
+        if (!r) child->corked = true;
+        child->last_used = now();
+        return r;
+      });
 }
 
 void OrderingKeyPublisherConnection::Flush(FlushParams p) {
@@ -31,24 +70,57 @@ void OrderingKeyPublisherConnection::Flush(FlushParams p) {
   // ordering keys. Locking while performing many (potentially long) requests is
   // just not a good idea.
   auto copy_children = [this] {
-    std::lock_guard<std::mutex> lk(mu_);
-    return children_;
+    std::vector<std::shared_ptr<PublisherConnection>> children;
+    for (auto const& shard : shards_) {
+      std::lock_guard<std::mutex> lk(shard->mu);
+      for (auto const& kv : shard->children) {
+        children.push_back(kv.second->connection);
+      }
+    }
+    return children;
   };
-  for (auto const& kv : copy_children()) kv.second->Flush(p);
+  for (auto const& c : copy_children()) c->Flush(p);
 }
 
 void OrderingKeyPublisherConnection::ResumePublish(ResumePublishParams p) {
-  auto child = GetChild(p.ordering_key);
-  child->ResumePublish(std::move(p));
+  auto const& shard = ShardFor(p.ordering_key);
+  auto child = [&]() -> std::shared_ptr<Child> {
+    std::lock_guard<std::mutex> lk(shard->mu);
+    auto i = shard->children.find(p.ordering_key);
+    // Only corked children are kept while idle, if there is no child there is
+    // nothing to resume.
+    if (i == shard->children.end()) return {};
+    i->second->corked = false;
+    return i->second;
+  }();
+  if (child) child->connection->ResumePublish(std::move(p));
+}
+
+std::size_t OrderingKeyPublisherConnection::child_count() const {
+  std::size_t count = 0;
+  for (auto const& shard : shards_) {
+    std::lock_guard<std::mutex> lk(shard->mu);
+    count += shard->children.size();
+  }
+  return count;
+}
+
+std::shared_ptr<OrderingKeyPublisherConnection::Shard> const&
+OrderingKeyPublisherConnection::ShardFor(std::string const& ordering_key) {
+  return shards_[std::hash<std::string>{}(ordering_key) % shards_.size()];
 }
 
-std::shared_ptr<pubsub::PublisherConnection>
-OrderingKeyPublisherConnection::GetChild(std::string const& ordering_key) {
-  std::lock_guard<std::mutex> lk(mu_);
-  auto i =
-      children_.emplace(ordering_key, std::shared_ptr<PublisherConnection>{});
-  if (i.second) i.first->second = factory_(ordering_key);
-  return i.first->second;
+void OrderingKeyPublisherConnection::Sweep(Shard& shard,
+                                           Clock::time_point now) {
+  shard.next_sweep = now + idle_timeout_;
+  for (auto i = shard.children.begin(); i != shard.children.end();) {
+    auto const& c = *i->second;
+    if (c.pending == 0 && !c.corked && now - c.last_used >= idle_timeout_) {
+      i = shard.children.erase(i);
+    } else {
+      ++i;
+    }
+  }
 }
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
@@ -17,24 +17,44 @@
 
 #include "google/cloud/pubsub/publisher_connection.h"
 #include "google/cloud/pubsub/version.h"
+#include <chrono>
 #include <functional>
-#include <map>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace google {
 namespace cloud {
 namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
+/**
+ * Route each message to a child connection based on its ordering key.
+ *
+ * The children are created on demand. They are kept in a map split in shards,
+ * selected by the hash of the ordering key, so publishers using different keys
+ * (typically) do not contend on the same mutex. Children without pending
+ * messages, and that are not corked by a previous error, are discarded once
+ * they have been idle for `idle_timeout`. Each shard is scanned for idle
+ * children at most once per `idle_timeout`, while publishing to it.
+ */
 class OrderingKeyPublisherConnection : public pubsub::PublisherConnection {
  public:
   using ConnectionFactory =
       std::function<std::shared_ptr<PublisherConnection>(std::string const&)>;
+  using Clock = std::chrono::steady_clock;
+
+  static std::size_t constexpr kShardCount = 32;
 
   static std::shared_ptr<OrderingKeyPublisherConnection> Create(
-      ConnectionFactory factory) {
+      ConnectionFactory factory,
+      std::chrono::milliseconds idle_timeout = std::chrono::seconds(60),
+      std::function<Clock::time_point()> now = [] { return Clock::now(); }) {
     return std::shared_ptr<OrderingKeyPublisherConnection>(
-        new OrderingKeyPublisherConnection(std::move(factory)));
+        new OrderingKeyPublisherConnection(std::move(factory), idle_timeout,
+                                           std::move(now)));
   }
 
   ~OrderingKeyPublisherConnection() override = default;
@@ -43,16 +63,34 @@ class OrderingKeyPublisherConnection : public pubsub::PublisherConnection {
   void Flush(FlushParams) override;
   void ResumePublish(ResumePublishParams p) override;
 
+  /// The number of ordering keys with a child connection, used in tests.
+  std::size_t child_count() const;
+
  private:
-  explicit OrderingKeyPublisherConnection(ConnectionFactory factory)
-      : factory_(std::move(factory)) {}
+  struct Child {
+    std::shared_ptr<PublisherConnection> connection;
+    std::size_t pending = 0;
+    bool corked = false;
+    Clock::time_point last_used;
+  };
+
+  struct Shard {
+    mutable std::mutex mu;
+    std::unordered_map<std::string, std::shared_ptr<Child>> children;
+    Clock::time_point next_sweep;
+  };
+
+  OrderingKeyPublisherConnection(ConnectionFactory factory,
+                                 std::chrono::milliseconds idle_timeout,
+                                 std::function<Clock::time_point()> now);
 
-  std::shared_ptr<PublisherConnection> GetChild(
-      std::string const& ordering_key);
+  std::shared_ptr<Shard> const& ShardFor(std::string const& ordering_key);
+  void Sweep(Shard& shard, Clock::time_point now);
 
   ConnectionFactory factory_;
-  std::mutex mu_;
-  std::map<std::string, std::shared_ptr<PublisherConnection>> children_;
+  std::chrono::milliseconds const idle_timeout_;
+  std::function<Clock::time_point()> const now_;
+  std::vector<std::shared_ptr<Shard>> shards_;
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
@@ -75,6 +75,116 @@ TEST(OrderingKeyPublisherConnectionTest, Publish) {
   publisher->Flush({});
 }
 
+pubsub::Message MakeMessage(std::string const& ordering_key) {
+  return pubsub::MessageBuilder{}
+      .SetData("data")
+      .SetOrderingKey(ordering_key)
+      .Build();
+}
+
+TEST(OrderingKeyPublisherConnectionTest, EvictIdleChildren) {
+  using Clock = OrderingKeyPublisherConnection::Clock;
+  auto now = Clock::now();
+  auto clock = [&now] { return now; };
+
+  std::size_t created = 0;
+  auto factory = [&](std::string const&) {
+    ++created;
+    auto mock = std::make_shared<pubsub_mocks::MockPublisherConnection>();
+    EXPECT_CALL(*mock, Publish)
+        .WillRepeatedly([](pubsub::PublisherConnection::PublishParams const&) {
+          return make_ready_future(make_status_or(std::string("id")));
+        });
+    return mock;
+  };
+  auto publisher = OrderingKeyPublisherConnection::Create(
+      factory, std::chrono::seconds(10), clock);
+
+  // Use enough keys to (almost certainly) populate all the shards.
+  auto const key_count = 16 * OrderingKeyPublisherConnection::kShardCount;
+  for (std::size_t i = 0; i != key_count; ++i) {
+    ASSERT_STATUS_OK(
+        publisher->Publish({MakeMessage("k" + std::to_string(i))}).get());
+  }
+  EXPECT_EQ(key_count, publisher->child_count());
+
+  // Publishing to a key before the timeout keeps it alive.
+  now += std::chrono::seconds(6);
+  ASSERT_STATUS_OK(publisher->Publish({MakeMessage("k0")}).get());
+  now += std::chrono::seconds(6);
+  for (std::size_t i = 0; i != key_count; ++i) {
+    ASSERT_STATUS_OK(
+        publisher->Publish({MakeMessage("new-" + std::to_string(i))}).get());
+  }
+  // Each shard is swept as it is used, all the idle "k*" children are gone.
+  EXPECT_EQ(key_count + 1, publisher->child_count());
+  EXPECT_EQ(2 * key_count, created);
+
+  ASSERT_STATUS_OK(publisher->Publish({MakeMessage("k0")}).get());
+  EXPECT_EQ(2 * key_count, created);
+}
+
+TEST(OrderingKeyPublisherConnectionTest, KeepPendingAndCorkedChildren) {
+  using Clock = OrderingKeyPublisherConnection::Clock;
+  auto now = Clock::now();
+  auto clock = [&now] { return now; };
+
+  promise<StatusOr<std::string>> pending;
+  std::size_t created = 0;
+  auto factory = [&](std::string const& ordering_key) {
+    ++created;
+    auto mock = std::make_shared<pubsub_mocks::MockPublisherConnection>();
+    if (ordering_key == "pending") {
+      EXPECT_CALL(*mock, Publish)
+          .WillOnce([&](pubsub::PublisherConnection::PublishParams const&) {
+            return pending.get_future();
+          });
+    } else if (ordering_key == "corked") {
+      EXPECT_CALL(*mock, Publish)
+          .WillOnce([](pubsub::PublisherConnection::PublishParams const&) {
+            return make_ready_future(StatusOr<std::string>(
+                Status(StatusCode::kPermissionDenied, "uh-oh")));
+          });
+      EXPECT_CALL(*mock, ResumePublish).Times(1);
+    } else {
+      EXPECT_CALL(*mock, Publish)
+          .WillRepeatedly(
+              [](pubsub::PublisherConnection::PublishParams const&) {
+                return make_ready_future(make_status_or(std::string("id")));
+              });
+    }
+    return mock;
+  };
+  auto publisher = OrderingKeyPublisherConnection::Create(
+      factory, std::chrono::seconds(10), clock);
+
+  auto f = publisher->Publish({MakeMessage("pending")});
+  EXPECT_FALSE(publisher->Publish({MakeMessage("corked")}).get().ok());
+  EXPECT_EQ(2U, publisher->child_count());
+
+  // Force a sweep of every shard.
+  now += std::chrono::seconds(20);
+  auto const key_count = 16 * OrderingKeyPublisherConnection::kShardCount;
+  for (std::size_t i = 0; i != key_count; ++i) {
+    ASSERT_STATUS_OK(
+        publisher->Publish({MakeMessage("k" + std::to_string(i))}).get());
+  }
+  EXPECT_EQ(key_count + 2, publisher->child_count());
+
+  // Once the message is published, and the ordering key resumed, the children
+  // are discarded in the next sweep.
+  pending.set_value(std::string("id"));
+  ASSERT_STATUS_OK(f.get());
+  publisher->ResumePublish({"corked"});
+  now += std::chrono::seconds(20);
+  for (std::size_t i = 0; i != key_count; ++i) {
+    ASSERT_STATUS_OK(
+        publisher->Publish({MakeMessage("k" + std::to_string(i))}).get());
+  }
+  EXPECT_EQ(key_count, publisher->child_count());
+  EXPECT_EQ(key_count * 2 + 2, created);
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
 }  // namespace pubsub_internal
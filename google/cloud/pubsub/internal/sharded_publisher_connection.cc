@@ -0,0 +1,59 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/sharded_publisher_connection.h"
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+
+// `std::hash<std::thread::id>` is often the identity on the address of the
+// thread control block, which is aligned, so its low bits are mostly zero.
+// Use the 64-bit MurmurHash3 finalizer to mix all the bits before `% n`.
+std::uint64_t Mix(std::uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+}  // namespace
+
+future<StatusOr<std::string>> ShardedPublisherConnection::Publish(
+    PublishParams p) {
+  auto const shard =
+      Mix(std::hash<std::thread::id>{}(std::this_thread::get_id())) %
+      children_.size();
+  return children_[shard]->Publish(std::move(p));
+}
+
+void ShardedPublisherConnection::Flush(FlushParams p) {
+  for (auto& c : children_) c->Flush(p);
+}
+
+void ShardedPublisherConnection::ResumePublish(ResumePublishParams p) {
+  for (auto& c : children_) c->ResumePublish(p);
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
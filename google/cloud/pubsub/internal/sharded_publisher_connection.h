@@ -0,0 +1,62 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_SHARDED_PUBLISHER_CONNECTION_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_SHARDED_PUBLISHER_CONNECTION_H
+
+#include "google/cloud/pubsub/publisher_connection.h"
+#include "google/cloud/pubsub/version.h"
+#include <memory>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+/**
+ * Spread the messages without ordering keys across several connections.
+ *
+ * Each calling thread is mapped to one of the children, so the messages
+ * published by a thread are batched together, while different threads
+ * (typically) do not contend on the same batcher.
+ */
+class ShardedPublisherConnection : public pubsub::PublisherConnection {
+ public:
+  static std::shared_ptr<ShardedPublisherConnection> Create(
+      std::vector<std::shared_ptr<pubsub::PublisherConnection>> children) {
+    return std::shared_ptr<ShardedPublisherConnection>(
+        new ShardedPublisherConnection(std::move(children)));
+  }
+
+  ~ShardedPublisherConnection() override = default;
+
+  future<StatusOr<std::string>> Publish(PublishParams p) override;
+  void Flush(FlushParams) override;
+  void ResumePublish(ResumePublishParams p) override;
+
+ private:
+  explicit ShardedPublisherConnection(
+      std::vector<std::shared_ptr<pubsub::PublisherConnection>> children)
+      : children_(std::move(children)) {}
+
+  std::vector<std::shared_ptr<pubsub::PublisherConnection>> const children_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_SHARDED_PUBLISHER_CONNECTION_H
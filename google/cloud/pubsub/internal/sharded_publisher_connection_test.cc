@@ -0,0 +1,78 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/sharded_publisher_connection.h"
+#include "google/cloud/pubsub/mocks/mock_publisher_connection.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+
+std::vector<std::shared_ptr<pubsub::PublisherConnection>> AsConnections(
+    std::vector<std::shared_ptr<pubsub_mocks::MockPublisherConnection>> const&
+        mocks) {
+  return {mocks.begin(), mocks.end()};
+}
+
+TEST(ShardedPublisherConnectionTest, SameThreadSameShard) {
+  std::vector<std::shared_ptr<pubsub_mocks::MockPublisherConnection>> mocks;
+  int calls = 0;
+  for (int i = 0; i != 3; ++i) {
+    auto m = std::make_shared<pubsub_mocks::MockPublisherConnection>();
+    auto const id = "id-" + std::to_string(i);
+    EXPECT_CALL(*m, Publish)
+        .WillRepeatedly(
+            [&calls, id](pubsub::PublisherConnection::PublishParams const&) {
+              ++calls;
+              return make_ready_future(StatusOr<std::string>(id));
+            });
+    mocks.push_back(std::move(m));
+  }
+
+  auto uut = ShardedPublisherConnection::Create(AsConnections(mocks));
+  auto const first =
+      uut->Publish({pubsub::MessageBuilder{}.SetData("a").Build()}).get();
+  ASSERT_STATUS_OK(first);
+  for (int i = 0; i != 10; ++i) {
+    auto r =
+        uut->Publish({pubsub::MessageBuilder{}.SetData("a").Build()}).get();
+    ASSERT_STATUS_OK(r);
+    EXPECT_EQ(*first, *r);
+  }
+  EXPECT_EQ(11, calls);
+}
+
+TEST(ShardedPublisherConnectionTest, FlushAndResumeAll) {
+  std::vector<std::shared_ptr<pubsub_mocks::MockPublisherConnection>> mocks;
+  for (int i = 0; i != 3; ++i) {
+    auto m = std::make_shared<pubsub_mocks::MockPublisherConnection>();
+    EXPECT_CALL(*m, Flush).Times(1);
+    EXPECT_CALL(*m, ResumePublish).Times(1);
+    mocks.push_back(std::move(m));
+  }
+  auto uut = ShardedPublisherConnection::Create(AsConnections(mocks));
+  uut->Flush({});
+  uut->ResumePublish({"unused"});
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
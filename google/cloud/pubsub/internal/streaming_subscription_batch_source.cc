@@ -14,6 +14,7 @@
 
 #include "google/cloud/pubsub/internal/streaming_subscription_batch_source.h"
 #include "google/cloud/log.h"
+#include <iterator>
 #include <ostream>
 
 namespace google {
@@ -52,6 +53,19 @@ void StreamingSubscriptionBatchSource::NackMessage(std::string const& ack_id) {
   DrainQueues(std::move(lk));
 }
 
+void StreamingSubscriptionBatchSource::BulkAck(
+    std::vector<std::string> ack_ids) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (ack_queue_.empty()) {
+    ack_queue_ = std::move(ack_ids);
+  } else {
+    ack_queue_.insert(ack_queue_.end(),
+                      std::make_move_iterator(ack_ids.begin()),
+                      std::make_move_iterator(ack_ids.end()));
+  }
+  DrainQueues(std::move(lk));
+}
+
 void StreamingSubscriptionBatchSource::BulkNack(
     std::vector<std::string> ack_ids) {
   std::unique_lock<std::mutex> lk(mu_);
@@ -70,6 +84,15 @@ void StreamingSubscriptionBatchSource::ExtendLeases(
   DrainQueues(std::move(lk));
 }
 
+void StreamingSubscriptionBatchSource::UpdateStreamAckDeadline(
+    std::chrono::seconds deadline) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto const value = static_cast<std::int32_t>(deadline.count());
+  if (stream_ack_deadline_seconds_.exchange(value) == value) return;
+  update_stream_ack_deadline_ = true;
+  DrainQueues(std::move(lk));
+}
+
 void StreamingSubscriptionBatchSource::StartStream(
     std::shared_ptr<pubsub::RetryPolicy> retry_policy,
     std::shared_ptr<pubsub::BackoffPolicy> backoff_policy) {
@@ -110,11 +133,7 @@ StreamingSubscriptionBatchSource::InitialRequest() const {
   request.set_client_id(client_id_);
   request.set_max_outstanding_bytes(max_outstanding_bytes_);
   request.set_max_outstanding_messages(max_outstanding_messages_);
-  auto const deadline =
-      std::max(std::chrono::seconds(10),
-               std::min(std::chrono::seconds(600), max_deadline_time_))
-          .count();
-  request.set_stream_ack_deadline_seconds(static_cast<std::int32_t>(deadline));
+  request.set_stream_ack_deadline_seconds(stream_ack_deadline_seconds_.load());
   return request;
 }
 
@@ -299,7 +318,8 @@ void StreamingSubscriptionBatchSource::OnFinish(Status status) {
 
 void StreamingSubscriptionBatchSource::DrainQueues(
     std::unique_lock<std::mutex> lk) {
-  if (ack_queue_.empty() && nack_queue_.empty() && deadlines_queue_.empty()) {
+  if (ack_queue_.empty() && nack_queue_.empty() && deadlines_queue_.empty() &&
+      !update_stream_ack_deadline_) {
     return;
   }
   if (stream_state_ != StreamState::kActive || pending_write_) return;
@@ -312,9 +332,15 @@ void StreamingSubscriptionBatchSource::DrainQueues(
   nacks.swap(nack_queue_);
   std::vector<std::pair<std::string, std::chrono::seconds>> deadlines;
   deadlines.swap(deadlines_queue_);
+  auto const update_deadline = update_stream_ack_deadline_;
+  update_stream_ack_deadline_ = false;
   lk.unlock();
 
   google::pubsub::v1::StreamingPullRequest request;
+  if (update_deadline) {
+    request.set_stream_ack_deadline_seconds(
+        stream_ack_deadline_seconds_.load());
+  }
   for (auto& a : acks) request.add_ack_ids(std::move(a));
   for (auto& n : nacks) {
     request.add_modify_deadline_ack_ids(std::move(n));
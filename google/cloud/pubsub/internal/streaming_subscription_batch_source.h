@@ -26,6 +26,9 @@
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
 #include <google/pubsub/v1/pubsub.pb.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <iosfwd>
@@ -55,7 +58,11 @@ class StreamingSubscriptionBatchSource
         client_id_(std::move(client_id)),
         max_outstanding_messages_(options.max_outstanding_messages()),
         max_outstanding_bytes_(options.max_outstanding_bytes()),
-        max_deadline_time_(options.max_deadline_time()),
+        stream_ack_deadline_seconds_(static_cast<std::int32_t>(
+            (std::max)(std::chrono::seconds(10),
+                       (std::min)(std::chrono::seconds(600),
+                                  options.max_deadline_time()))
+                .count())),
         retry_policy_(std::move(retry_policy)),
         backoff_policy_(std::move(backoff_policy)) {}
 
@@ -66,9 +73,11 @@ class StreamingSubscriptionBatchSource
   void Shutdown() override;
   void AckMessage(std::string const& ack_id) override;
   void NackMessage(std::string const& ack_id) override;
+  void BulkAck(std::vector<std::string> ack_ids) override;
   void BulkNack(std::vector<std::string> ack_ids) override;
   void ExtendLeases(std::vector<std::string> ack_ids,
                     std::chrono::seconds extension) override;
+  void UpdateStreamAckDeadline(std::chrono::seconds deadline) override;
 
   using AsyncPullStream = SubscriberStub::AsyncPullStream;
   using StreamShptr = std::shared_ptr<AsyncPullStream>;
@@ -130,7 +139,8 @@ class StreamingSubscriptionBatchSource
   std::string const client_id_;
   std::int64_t const max_outstanding_messages_;
   std::int64_t const max_outstanding_bytes_;
-  std::chrono::seconds const max_deadline_time_;
+  // Read without a lock when (re)starting the stream.
+  std::atomic<std::int32_t> stream_ack_deadline_seconds_;
   std::unique_ptr<pubsub::RetryPolicy const> retry_policy_;
   std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy_;
 
@@ -140,6 +150,7 @@ class StreamingSubscriptionBatchSource
   bool shutdown_ = false;
   bool pending_write_ = false;
   bool pending_read_ = false;
+  bool update_stream_ack_deadline_ = false;
   Status status_;
   std::shared_ptr<AsyncPullStream> stream_;
   std::vector<std::string> ack_queue_;
@@ -543,6 +543,14 @@ TEST(StreamingSubscriptionBatchSourceTest, AckMany) {
                   EXPECT_THAT(request.client_id(), IsEmpty());
                   EXPECT_THAT(request.subscription(), IsEmpty());
                   return success_stream.AddAction("Write");
+                })
+            .WillOnce(
+                [&](google::pubsub::v1::StreamingPullRequest const& request,
+                    grpc::WriteOptions const&) {
+                  EXPECT_THAT(request.ack_ids(),
+                              ElementsAre("fake-007", "fake-008"));
+                  EXPECT_THAT(request.modify_deadline_ack_ids(), IsEmpty());
+                  return success_stream.AddAction("Write");
                 });
         return stream;
       });
@@ -573,6 +581,63 @@ TEST(StreamingSubscriptionBatchSourceTest, AckMany) {
   uut->ExtendLeases({"fake-006"}, std::chrono::seconds(10));
   success_stream.WaitForAction().set_value(true);  // Write()
 
+  uut->BulkAck({"fake-007", "fake-008"});
+  success_stream.WaitForAction().set_value(true);  // Write()
+
+  shutdown->MarkAsShutdown("test", {});
+  uut->Shutdown();
+  last_read.set_value(false);                      // Read()
+  success_stream.WaitForAction().set_value(true);  // Finish()
+
+  EXPECT_THAT(done.get(), StatusIs(StatusCode::kOk));
+}
+
+TEST(StreamingSubscriptionBatchSourceTest, UpdateStreamAckDeadline) {
+  auto subscription = pubsub::Subscription("test-project", "test-subscription");
+  std::string const client_id = "fake-client-id";
+  AutomaticallyCreatedBackgroundThreads background;
+  auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
+
+  FakeStream success_stream(Status{});
+
+  EXPECT_CALL(*mock, AsyncStreamingPull)
+      .WillOnce([&](google::cloud::CompletionQueue& cq,
+                    std::unique_ptr<grpc::ClientContext> context,
+                    google::pubsub::v1::StreamingPullRequest const& request) {
+        EXPECT_EQ(300, request.stream_ack_deadline_seconds());
+        auto stream = success_stream.MakeWriteFailureStream(
+            cq, std::move(context), request);
+        using Request = google::pubsub::v1::StreamingPullRequest;
+        EXPECT_CALL(*stream,
+                    Write(Property(&Request::subscription, std::string{}), _))
+            .WillOnce(
+                [&](google::pubsub::v1::StreamingPullRequest const& request,
+                    grpc::WriteOptions const&) {
+                  EXPECT_EQ(45, request.stream_ack_deadline_seconds());
+                  EXPECT_THAT(request.ack_ids(), IsEmpty());
+                  EXPECT_THAT(request.modify_deadline_ack_ids(), IsEmpty());
+                  return success_stream.AddAction("Write");
+                });
+        return stream;
+      });
+
+  auto shutdown = std::make_shared<SessionShutdownManager>();
+  auto uut = std::make_shared<StreamingSubscriptionBatchSource>(
+      background.cq(), shutdown, mock, subscription.FullName(), client_id,
+      TestSubscriptionOptions(), TestRetryPolicy(), TestBackoffPolicy());
+
+  auto done = shutdown->Start({});
+  uut->Start([](StatusOr<google::pubsub::v1::StreamingPullResponse> const&) {});
+  success_stream.WaitForAction().set_value(true);  // Start()
+  success_stream.WaitForAction().set_value(true);  // Write()
+  success_stream.WaitForAction().set_value(true);  // Read()
+  auto last_read = success_stream.WaitForAction();
+
+  uut->UpdateStreamAckDeadline(std::chrono::seconds(45));
+  success_stream.WaitForAction().set_value(true);  // Write()
+  // Updating to the same value does not generate a new Write() request.
+  uut->UpdateStreamAckDeadline(std::chrono::seconds(45));
+
   shutdown->MarkAsShutdown("test", {});
   uut->Shutdown();
   last_read.set_value(false);                      // Read()
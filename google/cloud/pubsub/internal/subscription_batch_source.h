@@ -68,6 +68,13 @@ class SubscriptionBatchSource {
    */
   virtual void NackMessage(std::string const& ack_id) = 0;
 
+  /**
+   * Positive acknowledgment of multiple messages.
+   *
+   * Typically generated by applications receiving messages in batches.
+   */
+  virtual void BulkAck(std::vector<std::string> ack_ids) = 0;
+
   /**
    * Negative acknowledgment of multiple messages.
    *
@@ -80,6 +87,14 @@ class SubscriptionBatchSource {
    */
   virtual void ExtendLeases(std::vector<std::string> ack_ids,
                             std::chrono::seconds extension) = 0;
+
+  /**
+   * Change the ack deadline for messages delivered after this call.
+   *
+   * This is the deadline used by the service for new messages, before any
+   * lease extensions.
+   */
+  virtual void UpdateStreamAckDeadline(std::chrono::seconds deadline) = 0;
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
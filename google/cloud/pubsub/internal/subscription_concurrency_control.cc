@@ -14,30 +14,67 @@
 
 #include "google/cloud/pubsub/internal/subscription_concurrency_control.h"
 #include "google/cloud/pubsub/ack_handler.h"
+#include "google/cloud/pubsub/bulk_ack_handler.h"
 #include "google/cloud/log.h"
 #include "absl/memory/memory.h"
+#include <algorithm>
+#include <iterator>
 
 namespace google {
 namespace cloud {
 namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 namespace {
+using Clock = std::chrono::steady_clock;
+
+/// Returns the current time if @p metrics is not null, there is no need to
+/// query the clock otherwise.
+Clock::time_point MetricsStart(
+    std::shared_ptr<pubsub::MetricsSink> const& metrics) {
+  return metrics ? Clock::now() : Clock::time_point{};
+}
+
+/// Record the time since @p start, if @p metrics is not null.
+void RecordElapsed(std::shared_ptr<pubsub::MetricsSink> const& metrics,
+                   pubsub::MetricsHistogram histogram,
+                   Clock::time_point start) {
+  if (!metrics) return;
+  metrics->Record(histogram,
+                  std::chrono::duration_cast<std::chrono::microseconds>(
+                      Clock::now() - start));
+}
+
+/// Record the messages acked or nacked by a handler scheduled at @p start.
+void RecordHandled(std::shared_ptr<pubsub::MetricsSink> const& metrics,
+                   pubsub::MetricsCounter counter, std::size_t count,
+                   Clock::time_point start) {
+  if (!metrics) return;
+  metrics->Increment(counter, static_cast<std::int64_t>(count));
+  RecordElapsed(metrics, pubsub::MetricsHistogram::kAckLatency, start);
+}
+
 class AckHandlerImpl : public pubsub::AckHandler::Impl {
  public:
   explicit AckHandlerImpl(
       std::shared_ptr<SubscriptionConcurrencyControl> const& source,
       std::string ack_id, std::int32_t delivery_attempt,
-      std::size_t message_size)
+      std::size_t message_size, std::shared_ptr<pubsub::MetricsSink> metrics)
       : source_(source),
         ack_id_(std::move(ack_id)),
         delivery_attempt_(delivery_attempt),
-        message_size_(message_size) {}
+        message_size_(message_size),
+        metrics_(std::move(metrics)),
+        scheduled_(MetricsStart(metrics_)) {}
   ~AckHandlerImpl() override = default;
 
   void ack() override {
+    RecordHandled(metrics_, pubsub::MetricsCounter::kAckedMessages, 1,
+                  scheduled_);
     if (auto s = source_.lock()) s->AckMessage(ack_id_, message_size_);
   }
   void nack() override {
+    RecordHandled(metrics_, pubsub::MetricsCounter::kNackedMessages, 1,
+                  scheduled_);
     if (auto s = source_.lock()) s->NackMessage(ack_id_, message_size_);
   }
   std::int32_t delivery_attempt() const override { return delivery_attempt_; }
@@ -47,23 +84,68 @@ class AckHandlerImpl : public pubsub::AckHandler::Impl {
   std::string ack_id_;
   std::int32_t delivery_attempt_;
   std::size_t message_size_;
+  std::shared_ptr<pubsub::MetricsSink> metrics_;
+  Clock::time_point scheduled_;
+};
+
+class BulkAckHandlerImpl : public pubsub::BulkAckHandler::Impl {
+ public:
+  explicit BulkAckHandlerImpl(
+      std::shared_ptr<SubscriptionConcurrencyControl> const& source,
+      std::vector<std::string> ack_ids, std::size_t total_size,
+      std::shared_ptr<pubsub::MetricsSink> metrics)
+      : source_(source),
+        ack_ids_(std::move(ack_ids)),
+        total_size_(total_size),
+        metrics_(std::move(metrics)),
+        scheduled_(MetricsStart(metrics_)) {}
+  ~BulkAckHandlerImpl() override = default;
+
+  void ack() override {
+    RecordHandled(metrics_, pubsub::MetricsCounter::kAckedMessages,
+                  ack_ids_.size(), scheduled_);
+    if (auto s = source_.lock()) s->BulkAck(std::move(ack_ids_), total_size_);
+  }
+  void nack() override {
+    RecordHandled(metrics_, pubsub::MetricsCounter::kNackedMessages,
+                  ack_ids_.size(), scheduled_);
+    if (auto s = source_.lock()) s->BulkNack(std::move(ack_ids_), total_size_);
+  }
+  std::size_t size() const override { return ack_ids_.size(); }
+
+ private:
+  std::weak_ptr<SubscriptionConcurrencyControl> source_;
+  std::vector<std::string> ack_ids_;
+  std::size_t total_size_;
+  std::shared_ptr<pubsub::MetricsSink> metrics_;
+  Clock::time_point scheduled_;
 };
 
 }  // namespace
 
 void SubscriptionConcurrencyControl::Start(pubsub::ApplicationCallback cb) {
   std::unique_lock<std::mutex> lk(mu_);
-  if (callback_) return;
+  if (callback_ || batch_callback_) return;
   callback_ = std::move(cb);
   std::weak_ptr<SubscriptionConcurrencyControl> weak = shared_from_this();
   source_->Start([weak](google::pubsub::v1::ReceivedMessage r) {
     if (auto self = weak.lock()) self->OnMessage(std::move(r));
   });
-  if (total_messages() >= max_concurrency_) return;
-  auto const read_count = max_concurrency_ - total_messages();
-  messages_requested_ = read_count;
-  lk.unlock();
-  source_->Read(read_count);
+  ReadMore(std::move(lk));
+}
+
+void SubscriptionConcurrencyControl::StartBatch(
+    pubsub::BatchApplicationCallback cb, std::size_t max_batch_size) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (callback_ || batch_callback_) return;
+  batch_callback_ = std::move(cb);
+  max_batch_size_ = (std::max)(std::size_t{1}, max_batch_size);
+  std::weak_ptr<SubscriptionConcurrencyControl> weak = shared_from_this();
+  source_->StartBatch(
+      [weak](std::vector<google::pubsub::v1::ReceivedMessage> messages) {
+        if (auto self = weak.lock()) self->OnBatch(std::move(messages));
+      });
+  ReadMore(std::move(lk));
 }
 
 void SubscriptionConcurrencyControl::Shutdown() {
@@ -83,45 +165,120 @@ void SubscriptionConcurrencyControl::NackMessage(std::string const& ack_id,
   MessageHandled();
 }
 
-void SubscriptionConcurrencyControl::MessageHandled() {
+void SubscriptionConcurrencyControl::BulkAck(std::vector<std::string> ack_ids,
+                                             std::size_t total_size) {
+  auto const count = ack_ids.size();
+  source_->BulkAck(std::move(ack_ids), total_size);
+  MessageHandled(count);
+}
+
+void SubscriptionConcurrencyControl::BulkNack(std::vector<std::string> ack_ids,
+                                              std::size_t total_size) {
+  auto const count = ack_ids.size();
+  source_->BulkNack(std::move(ack_ids), total_size);
+  MessageHandled(count);
+}
+
+void SubscriptionConcurrencyControl::ReadMore(std::unique_lock<std::mutex> lk) {
+  if (total_messages() >= max_concurrency_) return;
+  auto const read_count = max_concurrency_ - total_messages();
+  messages_requested_ += read_count;
+  lk.unlock();
+  source_->Read(read_count);
+}
+
+void SubscriptionConcurrencyControl::MessageHandled(std::size_t count) {
   if (shutdown_manager_->FinishedOperation("handler")) return;
   std::unique_lock<std::mutex> lk(mu_);
-  --message_count_;
-  if (total_messages() < max_concurrency_) {
-    auto const read_count = max_concurrency_ - total_messages();
-    messages_requested_ += read_count;
-    lk.unlock();
-    source_->Read(read_count);
-  }
+  message_count_ -= count;
+  ReadMore(std::move(lk));
+}
+
+void SubscriptionConcurrencyControl::OnMessagesReceived(std::size_t count) {
+  std::lock_guard<std::mutex> lk(mu_);
+  messages_requested_ -= (std::min)(messages_requested_, count);
+  message_count_ += count;
 }
 
 void SubscriptionConcurrencyControl::OnMessage(
     google::pubsub::v1::ReceivedMessage m) {
-  std::unique_lock<std::mutex> lk(mu_);
-  if (messages_requested_ > 0) --messages_requested_;
-  ++message_count_;
-  lk.unlock();
+  OnMessagesReceived(1);
 
+  // Use `self` to reach the callback, copying a `std::function` for each
+  // message may allocate.
   struct MoveCapture {
-    std::shared_ptr<SessionShutdownManager> shutdown_manager;
-    pubsub::ApplicationCallback callback;
+    std::shared_ptr<SubscriptionConcurrencyControl> self;
     pubsub::Message m;
     std::unique_ptr<AckHandlerImpl> h;
     void operator()() {
+      auto const& shutdown_manager = self->shutdown_manager_;
+      auto const start = MetricsStart(self->metrics_);
       shutdown_manager->StartOperation("OnMessage/callback", "handler", [&] {
-        callback(std::move(m), pubsub::AckHandler(std::move(h)));
+        self->callback_(std::move(m), pubsub::AckHandler(std::move(h)));
+        RecordElapsed(self->metrics_, pubsub::MetricsHistogram::kCallbackTime,
+                      start);
       });
       shutdown_manager->FinishedOperation("callback");
     }
   };
+  if (metrics_) {
+    metrics_->Increment(pubsub::MetricsCounter::kReceivedMessages, 1);
+  }
+  auto self = shared_from_this();
   auto handler = absl::make_unique<AckHandlerImpl>(
-      shared_from_this(), std::move(*m.mutable_ack_id()), m.delivery_attempt(),
-      MessageProtoSize(m.message()));
+      self, std::move(*m.mutable_ack_id()), m.delivery_attempt(),
+      MessageProtoSize(m.message()), metrics_);
   auto message = FromProto(std::move(*m.mutable_message()));
   shutdown_manager_->StartAsyncOperation(
       __func__, "callback", cq_,
-      MoveCapture{shutdown_manager_, callback_, std::move(message),
-                  std::move(handler)});
+      MoveCapture{std::move(self), std::move(message), std::move(handler)});
+}
+
+void SubscriptionConcurrencyControl::OnBatch(
+    std::vector<google::pubsub::v1::ReceivedMessage> messages) {
+  OnMessagesReceived(messages.size());
+
+  struct MoveCapture {
+    std::shared_ptr<SubscriptionConcurrencyControl> self;
+    std::vector<pubsub::Message> m;
+    std::unique_ptr<BulkAckHandlerImpl> h;
+    void operator()() {
+      auto const& shutdown_manager = self->shutdown_manager_;
+      auto const start = MetricsStart(self->metrics_);
+      shutdown_manager->StartOperation("OnBatch/callback", "handler", [&] {
+        self->batch_callback_(std::move(m),
+                              pubsub::BulkAckHandler(std::move(h)));
+        RecordElapsed(self->metrics_, pubsub::MetricsHistogram::kCallbackTime,
+                      start);
+      });
+      shutdown_manager->FinishedOperation("callback");
+    }
+  };
+  if (metrics_) {
+    metrics_->Increment(pubsub::MetricsCounter::kReceivedMessages,
+                        static_cast<std::int64_t>(messages.size()));
+  }
+  auto self = shared_from_this();
+  for (auto i = messages.begin(); i != messages.end();) {
+    auto const n = (std::min)(
+        max_batch_size_, static_cast<std::size_t>(messages.end() - i));
+    std::vector<std::string> ack_ids;
+    ack_ids.reserve(n);
+    std::vector<pubsub::Message> batch;
+    batch.reserve(n);
+    std::size_t total_size = 0;
+    for (auto const end = std::next(i, static_cast<std::ptrdiff_t>(n));
+         i != end; ++i) {
+      total_size += MessageProtoSize(i->message());
+      ack_ids.push_back(std::move(*i->mutable_ack_id()));
+      batch.push_back(FromProto(std::move(*i->mutable_message())));
+    }
+    auto handler = absl::make_unique<BulkAckHandlerImpl>(
+        self, std::move(ack_ids), total_size, metrics_);
+    shutdown_manager_->StartAsyncOperation(
+        __func__, "callback", cq_,
+        MoveCapture{self, std::move(batch), std::move(handler)});
+  }
 }
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
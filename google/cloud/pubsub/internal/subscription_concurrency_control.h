@@ -19,9 +19,12 @@
 #include "google/cloud/pubsub/internal/session_shutdown_manager.h"
 #include "google/cloud/pubsub/internal/subscription_message_source.h"
 #include "google/cloud/pubsub/message.h"
+#include "google/cloud/pubsub/metrics_sink.h"
 #include "google/cloud/pubsub/version.h"
 #include <chrono>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -35,31 +38,47 @@ class SubscriptionConcurrencyControl
       google::cloud::CompletionQueue cq,
       std::shared_ptr<SessionShutdownManager> shutdown_manager,
       std::shared_ptr<SubscriptionMessageSource> source,
-      std::size_t max_concurrency) {
+      std::size_t max_concurrency,
+      std::shared_ptr<pubsub::MetricsSink> metrics = {}) {
     return std::shared_ptr<SubscriptionConcurrencyControl>(
-        new SubscriptionConcurrencyControl(std::move(cq),
-                                           std::move(shutdown_manager),
-                                           std::move(source), max_concurrency));
+        new SubscriptionConcurrencyControl(
+            std::move(cq), std::move(shutdown_manager), std::move(source),
+            max_concurrency, std::move(metrics)));
   }
 
   void Start(pubsub::ApplicationCallback);
+
+  /**
+   * Start the pipeline, delivering messages in batches.
+   *
+   * Each call to @p cb receives up to @p max_batch_size messages. Only one of
+   * `Start()` or `StartBatch()` should be called.
+   */
+  void StartBatch(pubsub::BatchApplicationCallback cb,
+                  std::size_t max_batch_size);
   void Shutdown();
   void AckMessage(std::string const& ack_id, std::size_t size);
   void NackMessage(std::string const& ack_id, std::size_t size);
+  void BulkAck(std::vector<std::string> ack_ids, std::size_t total_size);
+  void BulkNack(std::vector<std::string> ack_ids, std::size_t total_size);
 
  private:
   SubscriptionConcurrencyControl(
       google::cloud::CompletionQueue cq,
       std::shared_ptr<SessionShutdownManager> shutdown_manager,
       std::shared_ptr<SubscriptionMessageSource> source,
-      std::size_t max_concurrency)
+      std::size_t max_concurrency, std::shared_ptr<pubsub::MetricsSink> metrics)
       : cq_(std::move(cq)),
         shutdown_manager_(std::move(shutdown_manager)),
         source_(std::move(source)),
-        max_concurrency_(max_concurrency) {}
+        max_concurrency_(max_concurrency),
+        metrics_(std::move(metrics)) {}
 
-  void MessageHandled();
+  void ReadMore(std::unique_lock<std::mutex> lk);
+  void MessageHandled(std::size_t count = 1);
   void OnMessage(google::pubsub::v1::ReceivedMessage m);
+  void OnBatch(std::vector<google::pubsub::v1::ReceivedMessage> messages);
+  void OnMessagesReceived(std::size_t count);
 
   std::size_t total_messages() const {
     return message_count_ + messages_requested_;
@@ -69,9 +88,12 @@ class SubscriptionConcurrencyControl
   std::shared_ptr<SessionShutdownManager> const shutdown_manager_;
   std::shared_ptr<SubscriptionMessageSource> const source_;
   std::size_t const max_concurrency_;
+  std::shared_ptr<pubsub::MetricsSink> const metrics_;
 
   std::mutex mu_;
   pubsub::ApplicationCallback callback_;
+  pubsub::BatchApplicationCallback batch_callback_;
+  std::size_t max_batch_size_ = 0;
   std::size_t message_count_ = 0;
   std::size_t messages_requested_ = 0;
 };
@@ -18,6 +18,7 @@
 #include "google/cloud/log.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
 #include <deque>
@@ -33,6 +34,7 @@ namespace {
 using ::google::cloud::testing_util::StatusIs;
 using ::testing::_;
 using ::testing::AtLeast;
+using ::testing::ElementsAre;
 using ::testing::StartsWith;
 
 class SubscriptionConcurrencyControlTest : public ::testing::Test {
@@ -51,6 +53,17 @@ class SubscriptionConcurrencyControlTest : public ::testing::Test {
     }
   }
 
+  void PushBatch(MessageBatchCallback const& cb, std::size_t n) {
+    std::unique_lock<std::mutex> lk(messages_mu_);
+    std::vector<google::pubsub::v1::ReceivedMessage> batch;
+    for (std::size_t i = 0; i != n && !messages_.empty(); ++i) {
+      batch.push_back(std::move(messages_.front()));
+      messages_.pop_front();
+    }
+    lk.unlock();
+    if (!batch.empty()) cb(std::move(batch));
+  }
+
   void PushMessages(MessageCallback const& cb, std::size_t n) {
     std::unique_lock<std::mutex> lk(messages_mu_);
     for (std::size_t i = 0; i != n && !messages_.empty(); ++i) {
@@ -142,6 +155,122 @@ TEST_F(SubscriptionConcurrencyControlTest, MessageLifecycle) {
   EXPECT_THAT(done.get(), StatusIs(StatusCode::kOk));
 }
 
+/// @test Verify SubscriptionConcurrencyControl delivers messages in batches.
+TEST_F(SubscriptionConcurrencyControlTest, BatchLifecycle) {
+  auto source =
+      std::make_shared<pubsub_testing::MockSubscriptionMessageSource>();
+  MessageBatchCallback batch_callback;
+  PrepareMessages("ack-0-", 5);
+  EXPECT_CALL(*source, Shutdown).Times(1);
+  EXPECT_CALL(*source, StartBatch)
+      .WillOnce([&batch_callback](MessageBatchCallback cb) {
+        batch_callback = std::move(cb);
+      });
+  EXPECT_CALL(*source, Read(_)).WillRepeatedly([&](std::size_t n) {
+    PushBatch(batch_callback, n);
+  });
+  std::mutex acked_mu;
+  std::vector<std::string> acked;
+  EXPECT_CALL(*source, BulkAck)
+      .Times(3)
+      .WillRepeatedly([&](std::vector<std::string> const& ack_ids,
+                          std::size_t) {
+        std::lock_guard<std::mutex> lk(acked_mu);
+        acked.insert(acked.end(), ack_ids.begin(), ack_ids.end());
+        return make_ready_future(Status{});
+      });
+
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads background;
+  auto shutdown = std::make_shared<SessionShutdownManager>();
+  auto uut = SubscriptionConcurrencyControl::Create(
+      background.cq(), shutdown, source, /*max_concurrency=*/5);
+
+  std::mutex handler_mu;
+  std::condition_variable handler_cv;
+  std::vector<std::size_t> batch_sizes;
+  std::deque<pubsub::BulkAckHandler> ack_handlers;
+  auto handler = [&](std::vector<pubsub::Message> const& messages,
+                     pubsub::BulkAckHandler h) {
+    std::lock_guard<std::mutex> lk(handler_mu);
+    EXPECT_EQ(messages.size(), h.size());
+    batch_sizes.push_back(messages.size());
+    ack_handlers.push_back(std::move(h));
+    handler_cv.notify_one();
+  };
+
+  auto done = shutdown->Start({});
+  uut->StartBatch(handler, /*max_batch_size=*/2);
+  {
+    std::unique_lock<std::mutex> lk(handler_mu);
+    handler_cv.wait(lk, [&] { return ack_handlers.size() == 3; });
+    std::sort(batch_sizes.begin(), batch_sizes.end());
+    EXPECT_THAT(batch_sizes, ElementsAre(1, 2, 2));
+  }
+  for (auto& h : ack_handlers) std::move(h).ack();
+  std::sort(acked.begin(), acked.end());
+  EXPECT_THAT(acked, ElementsAre("ack-0-0", "ack-0-1", "ack-0-2", "ack-0-3",
+                                 "ack-0-4"));
+
+  shutdown->MarkAsShutdown(__func__, {});
+  uut->Shutdown();
+  EXPECT_THAT(done.get(), StatusIs(StatusCode::kOk));
+}
+
+/// @test Verify SubscriptionConcurrencyControl reports its metrics.
+TEST_F(SubscriptionConcurrencyControlTest, ReportsMetrics) {
+  auto source =
+      std::make_shared<pubsub_testing::MockSubscriptionMessageSource>();
+  MessageCallback message_callback;
+  PrepareMessages("ack-0-", 3);
+  EXPECT_CALL(*source, Shutdown).Times(1);
+  EXPECT_CALL(*source, Start).WillOnce([&message_callback](MessageCallback cb) {
+    message_callback = std::move(cb);
+  });
+  EXPECT_CALL(*source, Read(_)).WillRepeatedly([&](std::size_t n) {
+    PushMessages(message_callback, n);
+  });
+  EXPECT_CALL(*source, AckMessage).Times(2);
+  EXPECT_CALL(*source, NackMessage).Times(1);
+
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads background;
+  auto shutdown = std::make_shared<SessionShutdownManager>();
+  auto metrics = std::make_shared<pubsub::InProcessMetricsSink>();
+  auto uut = SubscriptionConcurrencyControl::Create(
+      background.cq(), shutdown, source, /*max_concurrency=*/1, metrics);
+
+  std::mutex handler_mu;
+  std::condition_variable handler_cv;
+  int handled = 0;
+  auto handler = [&](pubsub::Message const& m, pubsub::AckHandler h) {
+    if (m.message_id() == "message:ack-0-1") {
+      std::move(h).nack();
+    } else {
+      std::move(h).ack();
+    }
+    std::lock_guard<std::mutex> lk(handler_mu);
+    ++handled;
+    handler_cv.notify_one();
+  };
+
+  auto done = shutdown->Start({});
+  uut->Start(handler);
+  {
+    std::unique_lock<std::mutex> lk(handler_mu);
+    handler_cv.wait(lk, [&] { return handled == 3; });
+  }
+  shutdown->MarkAsShutdown(__func__, {});
+  uut->Shutdown();
+  EXPECT_THAT(done.get(), StatusIs(StatusCode::kOk));
+
+  using pubsub::MetricsCounter;
+  using pubsub::MetricsHistogram;
+  EXPECT_EQ(3, metrics->counter(MetricsCounter::kReceivedMessages));
+  EXPECT_EQ(2, metrics->counter(MetricsCounter::kAckedMessages));
+  EXPECT_EQ(1, metrics->counter(MetricsCounter::kNackedMessages));
+  EXPECT_EQ(3, metrics->histogram(MetricsHistogram::kAckLatency).count);
+  EXPECT_EQ(3, metrics->histogram(MetricsHistogram::kCallbackTime).count);
+}
+
 /// @test Verify SubscriptionConcurrencyControl schedules multiple callbacks.
 TEST_F(SubscriptionConcurrencyControlTest, ParallelCallbacks) {
   auto source =
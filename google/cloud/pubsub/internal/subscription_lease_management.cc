@@ -43,19 +43,28 @@ void SubscriptionLeaseManagement::Shutdown() {
 
 void SubscriptionLeaseManagement::AckMessage(std::string const& ack_id) {
   std::unique_lock<std::mutex> lk(mu_);
-  leases_.erase(ack_id);
+  OnHandled(lk, ack_id);
   lk.unlock();
   child_->AckMessage(ack_id);
 }
 
 void SubscriptionLeaseManagement::NackMessage(std::string const& ack_id) {
   std::unique_lock<std::mutex> lk(mu_);
-  leases_.erase(ack_id);
+  OnHandled(lk, ack_id);
   lk.unlock();
   child_->NackMessage(ack_id);
 }
 
+void SubscriptionLeaseManagement::BulkAck(std::vector<std::string> ack_ids) {
+  std::unique_lock<std::mutex> lk(mu_);
+  for (auto const& id : ack_ids) OnHandled(lk, id);
+  lk.unlock();
+  child_->BulkAck(std::move(ack_ids));
+}
+
 void SubscriptionLeaseManagement::BulkNack(std::vector<std::string> ack_ids) {
+  // These messages were not handled by the application, do not use them to
+  // estimate the ack deadline.
   std::unique_lock<std::mutex> lk(mu_);
   for (auto const& id : ack_ids) leases_.erase(id);
   lk.unlock();
@@ -68,6 +77,10 @@ void SubscriptionLeaseManagement::BulkNack(std::vector<std::string> ack_ids) {
 void SubscriptionLeaseManagement::ExtendLeases(std::vector<std::string>,
                                                std::chrono::seconds) {}
 
+// Likewise, this class estimates the stream ack deadline.
+void SubscriptionLeaseManagement::UpdateStreamAckDeadline(
+    std::chrono::seconds) {}
+
 void SubscriptionLeaseManagement::OnRead(
     StatusOr<google::pubsub::v1::StreamingPullResponse> const& response) {
   if (!response) {
@@ -78,54 +91,79 @@ void SubscriptionLeaseManagement::OnRead(
     return;
   }
   std::unique_lock<std::mutex> lk(mu_);
-  auto const now = std::chrono::system_clock::now();
-  auto const estimated_server_deadline = now + std::chrono::seconds(10);
+  auto const now = clock_();
+  auto const estimated_server_deadline =
+      now + (now < previous_ack_deadline_expiration_
+                 ? (std::min)(ack_deadline_, previous_ack_deadline_)
+                 : ack_deadline_);
   auto const handling_deadline = now + max_deadline_time_;
   for (auto const& rm : response->received_messages()) {
-    leases_.emplace(rm.ack_id(),
-                    LeaseStatus{estimated_server_deadline, handling_deadline});
+    leases_.emplace(rm.ack_id(), LeaseStatus{estimated_server_deadline,
+                                             handling_deadline, now});
   }
-  // Setup a timer to refresh the message leases. We do not want to immediately
-  // refresh them because there is a good chance they will be handled before
-  // the minimum lease time, and it seems wasteful to refresh the lease just to
-  // quickly turnaround and ack or nack the message.
-  StartRefreshTimer(std::move(lk),
-                    std::chrono::system_clock::now() + kMinimumAckDeadline);
+  auto const updated = UpdateAckDeadline(lk, now);
+  auto const deadline = ack_deadline_;
+  // Setup a timer to refresh the message leases, unless there is a timer that
+  // expires earlier, or the leases cannot be extended. We do not want to
+  // immediately refresh them because there is a good chance they will be
+  // handled before the current lease expires, and it seems wasteful to refresh
+  // the lease just to quickly turnaround and ack or nack the message.
+  if (!response->received_messages().empty() &&
+      handling_deadline >= estimated_server_deadline &&
+      estimated_server_deadline - kAckDeadlineSlack < refresh_deadline_) {
+    StartRefreshTimer(std::move(lk), estimated_server_deadline);
+  } else {
+    lk.unlock();
+  }
+  if (updated) child_->UpdateStreamAckDeadline(deadline);
 }
 
 void SubscriptionLeaseManagement::RefreshMessageLeases(
     std::unique_lock<std::mutex> lk) {
   using seconds = std::chrono::seconds;
+  using time_point = std::chrono::system_clock::time_point;
 
+  auto const now = clock_();
+  auto const scheduled =
+      refresh_deadline_ == (time_point::max)() ? now : refresh_deadline_;
+  refresh_deadline_ = (time_point::max)();
   if (leases_.empty() || refreshing_leases_) return;
 
-  std::vector<std::string> ack_ids;
-  ack_ids.reserve(leases_.size());
-  auto extension = kMaximumAckDeadline;
-  auto const now = std::chrono::system_clock::now();
-  for (auto const& kv : leases_) {
+  // Extend all the leases that would expire before the next refresh, which is
+  // (at least) half a deadline away. Extending more leases at once results in
+  // fewer, larger requests.
+  auto const cutoff =
+      (std::max)(now, scheduled) + kAckDeadlineSlack + ack_deadline_ / 2;
+  // Messages close to their handling deadline get shorter extensions, group
+  // the messages by extension.
+  std::map<seconds, std::vector<std::string>> extensions;
+  auto next = (time_point::max)();
+  for (auto& kv : leases_) {
+    auto& lease = kv.second;
     // This message lease cannot be extended any further, and we do not want to
     // send an extension of 0 seconds because that is a nack.
-    if (kv.second.handling_deadline < now + seconds(1)) continue;
-    auto const message_extension =
-        std::chrono::duration_cast<seconds>(kv.second.handling_deadline - now);
-    extension = (std::min)(extension, message_extension);
-    ack_ids.push_back(kv.first);
+    if (lease.handling_deadline < now + seconds(1)) continue;
+    if (lease.estimated_server_deadline > cutoff) {
+      next = (std::min)(next, lease.estimated_server_deadline);
+      continue;
+    }
+    auto const extension = (std::min)(
+        ack_deadline_,
+        std::chrono::duration_cast<seconds>(lease.handling_deadline - now));
+    extensions[extension].push_back(kv.first);
+    lease.estimated_server_deadline = now + extension;
+    next = (std::min)(next, lease.estimated_server_deadline);
   }
-  auto const new_deadline = now + extension;
-  if (ack_ids.empty()) {
-    StartRefreshTimer(std::move(lk), new_deadline);
-    return;
+  if (next != (time_point::max)()) {
+    StartRefreshTimer(std::move(lk), next);
+  } else {
+    lk.unlock();
   }
-  lk.unlock();
-  child_->ExtendLeases(ack_ids, extension);
-  lk.lock();
-  for (auto const& ack : ack_ids) {
-    auto i = leases_.find(ack);
-    if (i == leases_.end()) continue;
-    i->second.estimated_server_deadline = new_deadline;
+  for (auto& kv : extensions) {
+    ++metrics_->extension_requests;
+    metrics_->extended_leases += static_cast<std::int64_t>(kv.second.size());
+    child_->ExtendLeases(std::move(kv.second), kv.first);
   }
-  StartRefreshTimer(std::move(lk), new_deadline);
 }
 
 void SubscriptionLeaseManagement::StartRefreshTimer(
@@ -133,6 +171,7 @@ void SubscriptionLeaseManagement::StartRefreshTimer(
     std::chrono::system_clock::time_point new_server_deadline) {
   std::weak_ptr<SubscriptionLeaseManagement> weak = shared_from_this();
   auto deadline = new_server_deadline - kAckDeadlineSlack;
+  refresh_deadline_ = deadline;
 
   shutdown_manager_->StartOperation(__func__, "OnRefreshTimer", [&] {
     if (refresh_timer_.valid()) refresh_timer_.cancel();
@@ -159,6 +198,34 @@ void SubscriptionLeaseManagement::NackAll(std::unique_lock<std::mutex> lk) {
   BulkNack(std::move(ack_ids));
 }
 
+void SubscriptionLeaseManagement::OnHandled(std::unique_lock<std::mutex> const&,
+                                            std::string const& ack_id) {
+  auto i = leases_.find(ack_id);
+  if (i == leases_.end()) return;
+  auto const now = clock_();
+  estimator_.Record(std::chrono::duration_cast<std::chrono::milliseconds>(
+      now - i->second.received));
+  if (now > i->second.estimated_server_deadline) ++metrics_->expired_leases;
+  leases_.erase(i);
+}
+
+bool SubscriptionLeaseManagement::UpdateAckDeadline(
+    std::unique_lock<std::mutex> const&,
+    std::chrono::system_clock::time_point now) {
+  auto deadline = estimator_.Deadline();
+  if (max_deadline_time_ != std::chrono::seconds(0)) {
+    // There is no need for a deadline longer than the handling deadline.
+    deadline = (std::min)(deadline,
+                          (std::max)(kMinimumAckDeadline, max_deadline_time_));
+  }
+  if (deadline == ack_deadline_) return false;
+  previous_ack_deadline_ = ack_deadline_;
+  previous_ack_deadline_expiration_ = now + kMinimumAckDeadline;
+  ack_deadline_ = deadline;
+  metrics_->ack_deadline_seconds = deadline.count();
+  return true;
+}
+
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
 }  // namespace pubsub_internal
 }  // namespace cloud
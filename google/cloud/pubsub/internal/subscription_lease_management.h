@@ -15,25 +15,51 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_SUBSCRIPTION_LEASE_MANAGEMENT_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_SUBSCRIPTION_LEASE_MANAGEMENT_H
 
+#include "google/cloud/pubsub/internal/ack_deadline_estimator.h"
 #include "google/cloud/pubsub/internal/session_shutdown_manager.h"
 #include "google/cloud/pubsub/internal/subscriber_stub.h"
 #include "google/cloud/pubsub/internal/subscription_batch_source.h"
 #include "google/cloud/pubsub/version.h"
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <map>
 #include <memory>
+#include <mutex>
 
 namespace google {
 namespace cloud {
 namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
+/// Counters to monitor the lease management, shared by all the sessions in a
+/// `SubscriberConnection`.
+struct LeaseMetricsCounters {
+  std::atomic<std::int64_t> extension_requests{0};
+  std::atomic<std::int64_t> extended_leases{0};
+  std::atomic<std::int64_t> expired_leases{0};
+  std::atomic<std::int64_t> ack_deadline_seconds{
+      AckDeadlineEstimator::kMinimumAckDeadline.count()};
+};
+
+/**
+ * Maintain the leases for the messages received from a batch source.
+ *
+ * The ack deadline is estimated from the observed handling time of the
+ * messages, see `AckDeadlineEstimator`. The estimated deadline is used for
+ * the stream ack deadline and for each lease extension. A single timer
+ * refreshes the leases, and each time it fires all the leases that would
+ * expire in the next half deadline are extended together.
+ */
 class SubscriptionLeaseManagement
     : public SubscriptionBatchSource,
       public std::enable_shared_from_this<SubscriptionLeaseManagement> {
  public:
   static auto constexpr kAckDeadlineSlack = std::chrono::seconds(2);
-  static auto constexpr kMinimumAckDeadline = std::chrono::seconds(10);
-  static auto constexpr kMaximumAckDeadline = std::chrono::seconds(600);
+  static auto constexpr kMinimumAckDeadline =
+      AckDeadlineEstimator::kMinimumAckDeadline;
+  static auto constexpr kMaximumAckDeadline =
+      AckDeadlineEstimator::kMaximumAckDeadline;
 
   /**
    * A wrapper to create timers.
@@ -43,11 +69,15 @@ class SubscriptionLeaseManagement
   using TimerFactory =
       std::function<future<Status>(std::chrono::system_clock::time_point)>;
 
+  /// A wrapper to read the current time, tests can provide a fake clock.
+  using Clock = std::function<std::chrono::system_clock::time_point()>;
+
   static std::shared_ptr<SubscriptionLeaseManagement> Create(
       google::cloud::CompletionQueue cq,
       std::shared_ptr<SessionShutdownManager> shutdown_manager,
       std::shared_ptr<SubscriptionBatchSource> child,
-      std::chrono::seconds max_deadline_time) {
+      std::chrono::seconds max_deadline_time,
+      std::shared_ptr<LeaseMetricsCounters> metrics = {}) {
     auto timer_factory =
         [cq](std::chrono::system_clock::time_point tp) mutable {
           return cq.MakeDeadlineTimer(tp).then(
@@ -58,7 +88,9 @@ class SubscriptionLeaseManagement
     return std::shared_ptr<SubscriptionLeaseManagement>(
         new SubscriptionLeaseManagement(
             std::move(cq), std::move(shutdown_manager),
-            std::move(timer_factory), std::move(child), max_deadline_time));
+            std::move(timer_factory), std::move(child), max_deadline_time,
+            std::move(metrics),
+            [] { return std::chrono::system_clock::now(); }));
   }
 
   static std::shared_ptr<SubscriptionLeaseManagement> CreateForTesting(
@@ -66,20 +98,25 @@ class SubscriptionLeaseManagement
       std::shared_ptr<SessionShutdownManager> shutdown_manager,
       TimerFactory timer_factory,
       std::shared_ptr<SubscriptionBatchSource> child,
-      std::chrono::seconds max_deadline_time) {
+      std::chrono::seconds max_deadline_time,
+      std::shared_ptr<LeaseMetricsCounters> metrics = {},
+      Clock clock = [] { return std::chrono::system_clock::now(); }) {
     return std::shared_ptr<SubscriptionLeaseManagement>(
         new SubscriptionLeaseManagement(
             std::move(cq), std::move(shutdown_manager),
-            std::move(timer_factory), std::move(child), max_deadline_time));
+            std::move(timer_factory), std::move(child), max_deadline_time,
+            std::move(metrics), std::move(clock)));
   }
 
   void Start(BatchCallback cb) override;
   void Shutdown() override;
   void AckMessage(std::string const& ack_id) override;
   void NackMessage(std::string const& ack_id) override;
+  void BulkAck(std::vector<std::string> ack_ids) override;
   void BulkNack(std::vector<std::string> ack_ids) override;
   void ExtendLeases(std::vector<std::string> ack_ids,
                     std::chrono::seconds extension) override;
+  void UpdateStreamAckDeadline(std::chrono::seconds deadline) override;
 
  private:
   SubscriptionLeaseManagement(
@@ -87,12 +124,16 @@ class SubscriptionLeaseManagement
       std::shared_ptr<SessionShutdownManager> shutdown_manager,
       TimerFactory timer_factory,
       std::shared_ptr<SubscriptionBatchSource> child,
-      std::chrono::seconds max_deadline_time)
+      std::chrono::seconds max_deadline_time,
+      std::shared_ptr<LeaseMetricsCounters> metrics, Clock clock)
       : cq_(std::move(cq)),
         timer_factory_(std::move(timer_factory)),
         child_(std::move(child)),
         shutdown_manager_(std::move(shutdown_manager)),
-        max_deadline_time_(max_deadline_time) {}
+        max_deadline_time_(max_deadline_time),
+        metrics_(metrics ? std::move(metrics)
+                         : std::make_shared<LeaseMetricsCounters>()),
+        clock_(std::move(clock)) {}
 
   void OnRead(
       StatusOr<google::pubsub::v1::StreamingPullResponse> const& response);
@@ -110,11 +151,21 @@ class SubscriptionLeaseManagement
 
   void NackAll(std::unique_lock<std::mutex> lk);
 
+  /// Remove the lease for a message handled by the application.
+  void OnHandled(std::unique_lock<std::mutex> const& lk,
+                 std::string const& ack_id);
+
+  /// Update the ack deadline from the estimator, return true if it changed.
+  bool UpdateAckDeadline(std::unique_lock<std::mutex> const& lk,
+                         std::chrono::system_clock::time_point now);
+
   google::cloud::CompletionQueue cq_;
   TimerFactory const timer_factory_;
   std::shared_ptr<SubscriptionBatchSource> const child_;
   std::shared_ptr<SessionShutdownManager> const shutdown_manager_;
   std::chrono::seconds const max_deadline_time_;
+  std::shared_ptr<LeaseMetricsCounters> const metrics_;
+  Clock const clock_;
 
   std::mutex mu_;
 
@@ -122,11 +173,23 @@ class SubscriptionLeaseManagement
   struct LeaseStatus {
     std::chrono::system_clock::time_point estimated_server_deadline;
     std::chrono::system_clock::time_point handling_deadline;
+    std::chrono::system_clock::time_point received;
   };
   std::map<std::string, LeaseStatus> leases_;
 
+  AckDeadlineEstimator estimator_;
+  std::chrono::seconds ack_deadline_ = kMinimumAckDeadline;
+  // The service may receive a new stream ack deadline after it delivers some
+  // messages. For a short time after each change, assume the new messages use
+  // the smaller of the last two values.
+  std::chrono::seconds previous_ack_deadline_ = kMinimumAckDeadline;
+  std::chrono::system_clock::time_point previous_ack_deadline_expiration_;
+
   bool refreshing_leases_ = false;
   future<void> refresh_timer_;
+  // When the current refresh timer expires, `max()` if there is no timer.
+  std::chrono::system_clock::time_point refresh_deadline_ =
+      (std::chrono::system_clock::time_point::max)();
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
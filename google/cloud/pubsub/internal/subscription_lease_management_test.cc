@@ -62,7 +62,10 @@ TEST(SubscriptionLeaseManagementTest, NormalLifecycle) {
         .WillOnce([&](std::vector<std::string> const& ack_ids,
                       std::chrono::seconds extension) {
           EXPECT_THAT(ack_ids, ElementsAre("ack-0-0", "ack-0-2"));
-          EXPECT_LE(std::abs((kTestDeadline - extension).count()), 2);
+          // The messages are handled quickly, so the estimated deadline is
+          // the minimum.
+          EXPECT_EQ(SubscriptionLeaseManagement::kMinimumAckDeadline,
+                    extension);
           return make_ready_future(Status{});
         });
     // Then a message is nacked.
@@ -72,7 +75,8 @@ TEST(SubscriptionLeaseManagementTest, NormalLifecycle) {
         .WillOnce([&](std::vector<std::string> const& ack_ids,
                       std::chrono::seconds extension) {
           EXPECT_THAT(ack_ids, ElementsAre("ack-0-0"));
-          EXPECT_LE(std::abs((kTestDeadline - extension).count()), 2);
+          EXPECT_EQ(SubscriptionLeaseManagement::kMinimumAckDeadline,
+                    extension);
           return make_ready_future(Status{});
         });
     // Then all unhandled messages are nacked on shutdown.
@@ -157,6 +161,112 @@ TEST(SubscriptionLeaseManagementTest, ShutdownOnError) {
   EXPECT_THAT(done.get(), StatusIs(StatusCode::kPermissionDenied));
 }
 
+/// @test Verify the ack deadline is estimated from the handling times.
+TEST(SubscriptionLeaseManagementTest, AdaptiveAckDeadline) {
+  auto mock = std::make_shared<pubsub_testing::MockSubscriptionBatchSource>();
+  BatchCallback batch_callback;
+  EXPECT_CALL(*mock, Start).WillOnce([&](BatchCallback cb) {
+    batch_callback = std::move(cb);
+  });
+  EXPECT_CALL(*mock, AckMessage).Times(100);
+  EXPECT_CALL(*mock, UpdateStreamAckDeadline(std::chrono::seconds(30)))
+      .Times(1);
+  EXPECT_CALL(*mock, BulkNack).Times(1);
+  EXPECT_CALL(*mock, Shutdown).Times(1);
+
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads background;
+  auto make_timer = [](std::chrono::system_clock::time_point) {
+    return make_ready_future(Status(StatusCode::kCancelled, "test-cancel"));
+  };
+  auto now = std::chrono::system_clock::now();
+  auto clock = [&now] { return now; };
+  auto metrics = std::make_shared<LeaseMetricsCounters>();
+  auto shutdown_manager = std::make_shared<SessionShutdownManager>();
+  auto uut = SubscriptionLeaseManagement::CreateForTesting(
+      background.cq(), shutdown_manager, make_timer, mock,
+      std::chrono::seconds(600), metrics, clock);
+
+  auto done = shutdown_manager->Start({});
+  uut->Start([](StatusOr<google::pubsub::v1::StreamingPullResponse> const&) {});
+
+  batch_callback(GenerateMessages("0-", 100));
+  now += std::chrono::seconds(30);
+  for (int i = 0; i != 100; ++i) uut->AckMessage("ack-0-" + std::to_string(i));
+  // All the messages were acked after their estimated lease expired.
+  EXPECT_EQ(100, metrics->expired_leases.load());
+
+  // The new deadline is sent to the service with the next batch of messages.
+  EXPECT_EQ(10, metrics->ack_deadline_seconds.load());
+  batch_callback(GenerateMessages("1-", 1));
+  EXPECT_EQ(30, metrics->ack_deadline_seconds.load());
+
+  shutdown_manager->MarkAsShutdown(__func__, Status{});
+  uut->Shutdown();
+  EXPECT_THAT(done.get(), StatusIs(StatusCode::kOk));
+}
+
+/// @test Verify the leases that expire close together are extended together.
+TEST(SubscriptionLeaseManagementTest, CoalesceExtensions) {
+  auto mock = std::make_shared<pubsub_testing::MockSubscriptionBatchSource>();
+  BatchCallback batch_callback;
+  EXPECT_CALL(*mock, Start).WillOnce([&](BatchCallback cb) {
+    batch_callback = std::move(cb);
+  });
+  EXPECT_CALL(*mock, ExtendLeases)
+      .WillOnce([&](std::vector<std::string> const& ack_ids,
+                    std::chrono::seconds extension) {
+        EXPECT_THAT(ack_ids,
+                    ElementsAre("ack-0-0", "ack-0-1", "ack-1-0", "ack-1-1"));
+        EXPECT_EQ(SubscriptionLeaseManagement::kMinimumAckDeadline, extension);
+      });
+  EXPECT_CALL(*mock, BulkNack).Times(1);
+  EXPECT_CALL(*mock, Shutdown).Times(1);
+
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads background;
+  std::vector<promise<Status>> timers;
+  std::vector<std::chrono::system_clock::time_point> deadlines;
+  auto make_timer = [&](std::chrono::system_clock::time_point d) {
+    deadlines.push_back(d);
+    timers.emplace_back();
+    return timers.back().get_future();
+  };
+  auto const start = std::chrono::system_clock::now();
+  auto now = start;
+  auto clock = [&now] { return now; };
+  auto metrics = std::make_shared<LeaseMetricsCounters>();
+  auto shutdown_manager = std::make_shared<SessionShutdownManager>();
+  auto uut = SubscriptionLeaseManagement::CreateForTesting(
+      background.cq(), shutdown_manager, make_timer, mock,
+      std::chrono::seconds(600), metrics, clock);
+
+  auto done = shutdown_manager->Start({});
+  uut->Start([](StatusOr<google::pubsub::v1::StreamingPullResponse> const&) {});
+
+  using std::chrono::seconds;
+  batch_callback(GenerateMessages("0-", 2));
+  ASSERT_EQ(1, timers.size());
+  EXPECT_EQ(start + seconds(8), deadlines[0]);
+
+  // The existing timer expires earlier, there is no need for a new timer.
+  now = start + seconds(5);
+  batch_callback(GenerateMessages("1-", 2));
+  ASSERT_EQ(1, timers.size());
+
+  // The second batch expires soon after the first, extend all the messages.
+  now = start + seconds(8);
+  timers[0].set_value({});
+  ASSERT_EQ(2, timers.size());
+  EXPECT_EQ(start + seconds(16), deadlines[1]);
+  EXPECT_EQ(1, metrics->extension_requests.load());
+  EXPECT_EQ(4, metrics->extended_leases.load());
+  EXPECT_EQ(0, metrics->expired_leases.load());
+
+  shutdown_manager->MarkAsShutdown(__func__, Status{});
+  uut->Shutdown();
+  timers[1].set_value(Status(StatusCode::kCancelled, "test-cancel"));
+  EXPECT_THAT(done.get(), StatusIs(StatusCode::kOk));
+}
+
 /// @test Verify ExtendLeases does not call the `child` object.
 TEST(SubscriptionLeaseManagementTest, DoesNotPropagateExtendLeases) {
   auto mock = std::make_shared<pubsub_testing::MockSubscriptionBatchSource>();
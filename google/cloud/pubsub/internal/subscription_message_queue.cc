@@ -22,6 +22,12 @@ namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
 void SubscriptionMessageQueue::Start(MessageCallback cb) {
+  StartBatch([cb](std::vector<google::pubsub::v1::ReceivedMessage> messages) {
+    for (auto& m : messages) cb(std::move(m));
+  });
+}
+
+void SubscriptionMessageQueue::StartBatch(MessageBatchCallback cb) {
   std::unique_lock<std::mutex> lk(mu_);
   if (callback_) return;
   callback_ = std::move(cb);
@@ -58,6 +64,34 @@ future<Status> SubscriptionMessageQueue::NackMessage(std::string const& ack_id,
   return make_ready_future(Status{});
 }
 
+future<Status> SubscriptionMessageQueue::BulkAck(
+    std::vector<std::string> ack_ids, std::size_t) {
+  std::unique_lock<std::mutex> lk(mu_);
+  bool unblocked = false;
+  for (auto const& id : ack_ids) unblocked = HandlerDone(lk, id) || unblocked;
+  if (unblocked) {
+    DrainQueue(std::move(lk));
+  } else {
+    lk.unlock();
+  }
+  source_->BulkAck(std::move(ack_ids));
+  return make_ready_future(Status{});
+}
+
+future<Status> SubscriptionMessageQueue::BulkNack(
+    std::vector<std::string> ack_ids, std::size_t) {
+  std::unique_lock<std::mutex> lk(mu_);
+  bool unblocked = false;
+  for (auto const& id : ack_ids) unblocked = HandlerDone(lk, id) || unblocked;
+  if (unblocked) {
+    DrainQueue(std::move(lk));
+  } else {
+    lk.unlock();
+  }
+  source_->BulkNack(std::move(ack_ids));
+  return make_ready_future(Status{});
+}
+
 void SubscriptionMessageQueue::OnRead(
     StatusOr<google::pubsub::v1::StreamingPullResponse> r) {
   std::unique_lock<std::mutex> lk(mu_);
@@ -74,11 +108,13 @@ void SubscriptionMessageQueue::OnRead(
     google::pubsub::v1::StreamingPullResponse r) {
   auto handle_response = [&] {
     shutdown_manager_->FinishedOperation("OnRead");
+    auto const received = metrics_ ? std::chrono::steady_clock::now()
+                                   : std::chrono::steady_clock::time_point{};
     for (auto& m : *r.mutable_received_messages()) {
-      auto key = m.message().ordering_key();
+      auto const& key = m.message().ordering_key();
       if (key.empty()) {
         // Empty key, requires no ordering and therefore immediately runnable.
-        runnable_messages_.push_back(std::move(m));
+        runnable_messages_.push_back({std::move(m), received});
         continue;
       }
       // The message requires ordering, find out if there is an existing queue
@@ -89,11 +125,11 @@ void SubscriptionMessageQueue::OnRead(
       // the per-ordering-key queue as a marker for any other incoming messages
       // with the same ordering key.
       if (loc.second) {
-        runnable_messages_.push_back(std::move(m));
+        runnable_messages_.push_back({std::move(m), received});
         continue;
       }
       // Insert the messages into the existing queue.
-      loc.first->second.push_back(std::move(m));
+      loc.first->second.push_back({std::move(m), received});
     }
     DrainQueue(std::move(lk));
   };
@@ -117,18 +153,18 @@ void SubscriptionMessageQueue::Shutdown(std::unique_lock<std::mutex> lk) {
   available_slots_ = 0;
   QueueByOrderingKey queues;
   queues.swap(queues_);
-  std::deque<google::pubsub::v1::ReceivedMessage> runnable_messages;
+  std::deque<QueuedMessage> runnable_messages;
   runnable_messages.swap(runnable_messages_);
   lk.unlock();
 
   std::vector<std::string> ack_ids;
   for (auto& kv : queues) {
     for (auto& m : kv.second) {
-      ack_ids.push_back(std::move(*m.mutable_ack_id()));
+      ack_ids.push_back(std::move(*m.message.mutable_ack_id()));
     }
   }
   for (auto& m : runnable_messages) {
-    ack_ids.push_back(std::move(*m.mutable_ack_id()));
+    ack_ids.push_back(std::move(*m.message.mutable_ack_id()));
   }
 
   if (ack_ids.empty()) return;
@@ -137,44 +173,62 @@ void SubscriptionMessageQueue::Shutdown(std::unique_lock<std::mutex> lk) {
 
 void SubscriptionMessageQueue::DrainQueue(std::unique_lock<std::mutex> lk) {
   while (!runnable_messages_.empty() && available_slots_ > 0 && !shutdown_) {
-    auto m = std::move(runnable_messages_.front());
-    runnable_messages_.pop_front();
-    --available_slots_;
-    // No need to track messages without an ordering key, as there is no action
-    // to take in their HandlerDone() member function.
-    if (!m.message().ordering_key().empty()) {
-      ordering_key_by_ack_id_[m.ack_id()] = m.message().ordering_key();
+    auto const n = (std::min)(available_slots_, runnable_messages_.size());
+    std::vector<google::pubsub::v1::ReceivedMessage> batch;
+    batch.reserve(n);
+    auto const now = metrics_ ? std::chrono::steady_clock::now()
+                              : std::chrono::steady_clock::time_point{};
+    for (std::size_t i = 0; i != n; ++i) {
+      auto& m = runnable_messages_.front();
+      // No need to track messages without an ordering key, as there is no
+      // action to take in their HandlerDone() member function.
+      auto const& key = m.message.message().ordering_key();
+      if (!key.empty()) ordering_key_by_ack_id_[m.message.ack_id()] = key;
+      if (metrics_) {
+        metrics_->Record(pubsub::MetricsHistogram::kQueueingDelay,
+                         std::chrono::duration_cast<std::chrono::microseconds>(
+                             now - m.received));
+      }
+      batch.push_back(std::move(m.message));
+      runnable_messages_.pop_front();
     }
+    available_slots_ -= n;
     // Don't hold a lock during the callback, as the callee may call `Read()`
     // or something similar.
     lk.unlock();
-    callback_(std::move(m));
+    callback_(std::move(batch));
     lk.lock();
   }
 }
 
 void SubscriptionMessageQueue::HandlerDone(std::string const& ack_id) {
   std::unique_lock<std::mutex> lk(mu_);
+  if (!HandlerDone(lk, ack_id)) return;
+  DrainQueue(std::move(lk));
+}
+
+bool SubscriptionMessageQueue::HandlerDone(std::unique_lock<std::mutex> const&,
+                                           std::string const& ack_id) {
   // Find out the ordering key for this message.
   auto loc = ordering_key_by_ack_id_.find(ack_id);
   // Messages without an ordering key are not inserted in the collection (see
   // `DrainQueue()`), so this happens routinely.
-  if (loc == ordering_key_by_ack_id_.end()) return;
+  if (loc == ordering_key_by_ack_id_.end()) return false;
   auto key = std::move(loc->second);
   ordering_key_by_ack_id_.erase(loc);
   auto ql = queues_.find(key);
   // This is purely defensive, but should not happen.
-  if (ql == queues_.end()) return;
+  if (ql == queues_.end()) return false;
   if (ql->second.empty()) {
     // There are no more messages for this ordering key, remove the queue, as it
     // also serves as a marker to order the next message.
     queues_.erase(ql);
-    return;
+    return false;
   }
   auto m = std::move(ql->second.front());
   ql->second.pop_front();
   runnable_messages_.push_back(std::move(m));
-  DrainQueue(std::move(lk));
+  return true;
 }
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
@@ -18,6 +18,7 @@
 #include "google/cloud/pubsub/internal/session_shutdown_manager.h"
 #include "google/cloud/pubsub/internal/subscription_batch_source.h"
 #include "google/cloud/pubsub/internal/subscription_message_source.h"
+#include "google/cloud/pubsub/metrics_sink.h"
 #include "google/cloud/pubsub/version.h"
 #include "google/cloud/internal/random.h"
 // TODO(#4501) - these hacks can be removed if #include <absl/...> works
@@ -29,9 +30,12 @@
 // TODO(#4501) - end
 #include "google/cloud/internal/diagnostics_pop.inc"
 #include <google/pubsub/v1/pubsub.pb.h>
+#include <chrono>
 #include <deque>
 #include <functional>
 #include <mutex>
+#include <string>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -50,6 +54,8 @@ inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
  * drains the queue by calling `Read(n)` which allow this stage to send up to
  * `n` messages. After `n` messages are sent more calls to `Read(n)` *are*
  * required, the queue does not drain just because some messages completed.
+ * All the runnable messages (up to `n`) are sent in a single batch, the
+ * `Start()` callback receives the messages in the batch one at a time.
  *
  * Messages with ordering keys are executed in order. The class keeps a message
  * queue per ordering key. The queue is created when a message with a new
@@ -62,6 +68,9 @@ inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
  * For messages with an ordering key, this class also maintains a mapping of
  * ack_id to ordering key. This is necessary to determine which ordering key
  * queue is drained when the message is acknowledged or rejected.
+ *
+ * If @p metrics is not null, the class reports how long each message waits in
+ * the queues.
  */
 class SubscriptionMessageQueue
     : public SubscriptionMessageSource,
@@ -69,26 +78,34 @@ class SubscriptionMessageQueue
  public:
   static std::shared_ptr<SubscriptionMessageQueue> Create(
       std::shared_ptr<SessionShutdownManager> shutdown_manager,
-      std::shared_ptr<SubscriptionBatchSource> source) {
+      std::shared_ptr<SubscriptionBatchSource> source,
+      std::shared_ptr<pubsub::MetricsSink> metrics = {}) {
     return std::shared_ptr<SubscriptionMessageQueue>(
         new SubscriptionMessageQueue(std::move(shutdown_manager),
-                                     std::move(source)));
+                                     std::move(source), std::move(metrics)));
   }
 
   void Start(MessageCallback cb) override;
+  void StartBatch(MessageBatchCallback cb) override;
   void Shutdown() override;
   void Read(std::size_t max_callbacks) override;
   future<Status> AckMessage(std::string const& ack_id,
                             std::size_t size) override;
   future<Status> NackMessage(std::string const& ack_id,
                              std::size_t size) override;
+  future<Status> BulkAck(std::vector<std::string> ack_ids,
+                         std::size_t total_size) override;
+  future<Status> BulkNack(std::vector<std::string> ack_ids,
+                          std::size_t total_size) override;
 
  private:
   explicit SubscriptionMessageQueue(
       std::shared_ptr<SessionShutdownManager> shutdown_manager,
-      std::shared_ptr<SubscriptionBatchSource> source)
+      std::shared_ptr<SubscriptionBatchSource> source,
+      std::shared_ptr<pubsub::MetricsSink> metrics)
       : shutdown_manager_(std::move(shutdown_manager)),
-        source_(std::move(source)) {}
+        source_(std::move(source)),
+        metrics_(std::move(metrics)) {}
 
   void OnRead(StatusOr<google::pubsub::v1::StreamingPullResponse> r);
   void OnRead(std::unique_lock<std::mutex> lk,
@@ -99,18 +116,28 @@ class SubscriptionMessageQueue
   /// Process a nack() or ack() for a message
   void HandlerDone(std::string const& ack_id);
 
+  /// Process a nack() or ack() for a message, return true if it unblocked a
+  /// message with the same ordering key.
+  bool HandlerDone(std::unique_lock<std::mutex> const& lk,
+                   std::string const& ack_id);
+
   std::shared_ptr<SessionShutdownManager> const shutdown_manager_;
   std::shared_ptr<SubscriptionBatchSource> const source_;
+  std::shared_ptr<pubsub::MetricsSink> const metrics_;
 
+  /// A message in the queues, `received` is only set if `metrics_` is not null.
+  struct QueuedMessage {
+    google::pubsub::v1::ReceivedMessage message;
+    std::chrono::steady_clock::time_point received;
+  };
   using QueueByOrderingKey =
-      absl::flat_hash_map<std::string,
-                          std::deque<google::pubsub::v1::ReceivedMessage>>;
+      absl::flat_hash_map<std::string, std::deque<QueuedMessage>>;
 
   std::mutex mu_;
-  MessageCallback callback_;
+  MessageBatchCallback callback_;
   bool shutdown_ = false;
   std::size_t available_slots_ = 0;
-  std::deque<google::pubsub::v1::ReceivedMessage> runnable_messages_;
+  std::deque<QueuedMessage> runnable_messages_;
   QueueByOrderingKey queues_;
   absl::flat_hash_map<std::string, std::string> ordering_key_by_ack_id_;
 };
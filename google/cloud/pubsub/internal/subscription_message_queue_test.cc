@@ -159,6 +159,85 @@ TEST(SubscriptionMessageQueueTest, Basic) {
 }
 
 /// @test Verify that messages received after a shutdown are nacked.
+/// @test Verify batches contain all the runnable messages, one per key.
+TEST(SubscriptionMessageQueueTest, BatchRespectsOrderingKeys) {
+  auto mock = std::make_shared<pubsub_testing::MockSubscriptionBatchSource>();
+  EXPECT_CALL(*mock, Shutdown).Times(1);
+  BatchCallback batch_callback;
+  EXPECT_CALL(*mock, Start).WillOnce([&](BatchCallback cb) {
+    batch_callback = std::move(cb);
+  });
+  std::vector<std::string> acked;
+  EXPECT_CALL(*mock, BulkAck)
+      .Times(2)
+      .WillRepeatedly([&](std::vector<std::string> const& ack_ids) {
+        acked.insert(acked.end(), ack_ids.begin(), ack_ids.end());
+      });
+
+  std::vector<std::vector<std::string>> batches;
+  auto handler =
+      [&batches](std::vector<google::pubsub::v1::ReceivedMessage> messages) {
+        std::vector<std::string> ids;
+        for (auto const& m : messages) ids.push_back(m.message().message_id());
+        batches.push_back(std::move(ids));
+      };
+
+  auto shutdown = std::make_shared<SessionShutdownManager>();
+  shutdown->Start({});
+  auto uut = SubscriptionMessageQueue::Create(shutdown, mock);
+  uut->StartBatch(handler);
+
+  auto messages = GenerateOrderKeyMessages("k0", 0, 2);
+  for (auto& m : GenerateOrderKeyMessages({}, 0, 2)) messages.push_back(m);
+  batch_callback(AsPullResponse(messages));
+  EXPECT_THAT(batches, IsEmpty());
+
+  uut->Read(10);
+  ASSERT_EQ(1, batches.size());
+  EXPECT_THAT(batches[0], ElementsAre("id-k0-000000", "id--000000",
+                                      "id--000001"));
+
+  uut->BulkAck({"ack-k0-000000", "ack--000000", "ack--000001"}, 0);
+  ASSERT_EQ(2, batches.size());
+  EXPECT_THAT(batches[1], ElementsAre("id-k0-000001"));
+
+  uut->BulkAck({"ack-k0-000001"}, 0);
+  EXPECT_THAT(acked, ElementsAre("ack-k0-000000", "ack--000000",
+                                 "ack--000001", "ack-k0-000001"));
+  uut->Shutdown();
+}
+
+/// @test Verify the queueing delay is reported for each message.
+TEST(SubscriptionMessageQueueTest, ReportsQueueingDelay) {
+  auto mock = std::make_shared<pubsub_testing::MockSubscriptionBatchSource>();
+  EXPECT_CALL(*mock, Shutdown).Times(1);
+  BatchCallback batch_callback;
+  EXPECT_CALL(*mock, Start).WillOnce([&](BatchCallback cb) {
+    batch_callback = std::move(cb);
+  });
+  EXPECT_CALL(*mock, BulkNack).Times(1);
+
+  std::vector<google::pubsub::v1::ReceivedMessage> received;
+  auto handler = [&received](google::pubsub::v1::ReceivedMessage m) {
+    received.push_back(std::move(m));
+  };
+
+  auto metrics = std::make_shared<pubsub::InProcessMetricsSink>();
+  auto shutdown = std::make_shared<SessionShutdownManager>();
+  shutdown->Start({});
+  auto uut = SubscriptionMessageQueue::Create(shutdown, mock, metrics);
+  uut->Start(handler);
+
+  batch_callback(AsPullResponse(GenerateMessages()));
+  uut->Read(2);
+  EXPECT_EQ(2, received.size());
+  auto const delay =
+      metrics->histogram(pubsub::MetricsHistogram::kQueueingDelay);
+  EXPECT_EQ(2, delay.count);
+
+  uut->Shutdown();
+}
+
 TEST(SubscriptionMessageQueueTest, NackOnSessionShutdown) {
   auto mock = std::make_shared<pubsub_testing::MockSubscriptionBatchSource>();
   EXPECT_CALL(*mock, Shutdown);
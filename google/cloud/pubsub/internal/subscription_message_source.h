@@ -20,6 +20,8 @@
 #include "google/cloud/status.h"
 #include <google/pubsub/v1/pubsub.pb.h>
 #include <functional>
+#include <string>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -28,6 +30,8 @@ inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
 using MessageCallback =
     std::function<void(google::pubsub::v1::ReceivedMessage)>;
+using MessageBatchCallback =
+    std::function<void(std::vector<google::pubsub::v1::ReceivedMessage>)>;
 
 /**
  * Defines the interface for one-message-at-a-time sources.
@@ -44,6 +48,10 @@ class SubscriptionMessageSource {
   /// no effect, only the first callback is used.
   virtual void Start(MessageCallback) = 0;
 
+  /// Start the source, receiving all the messages available in each callback.
+  /// Only one of `Start()` or `StartBatch()` should be called.
+  virtual void StartBatch(MessageBatchCallback) = 0;
+
   /// Shutdown the source, cancel any outstanding requests and or timers. No
   /// callbacks should be generated after this call.
   virtual void Shutdown() = 0;
@@ -73,6 +81,26 @@ class SubscriptionMessageSource {
    */
   virtual future<Status> NackMessage(std::string const& ack_id,
                                      std::size_t size) = 0;
+
+  /**
+   * Positive acknowledgment for multiple messages.
+   *
+   * Equivalent to calling `AckMessage()` for each element in @p ack_ids, but
+   * more efficient. The @p total_size parameter should be the sum of the
+   * original message size estimates.
+   */
+  virtual future<Status> BulkAck(std::vector<std::string> ack_ids,
+                                 std::size_t total_size) = 0;
+
+  /**
+   * Negative acknowledgment for multiple messages.
+   *
+   * Equivalent to calling `NackMessage()` for each element in @p ack_ids, but
+   * more efficient. The @p total_size parameter should be the sum of the
+   * original message size estimates.
+   */
+  virtual future<Status> BulkNack(std::vector<std::string> ack_ids,
+                                  std::size_t total_size) = 0;
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
@@ -13,11 +13,13 @@
 // limitations under the License.
 
 #include "google/cloud/pubsub/internal/subscription_session.h"
+#include "google/cloud/pubsub/internal/multi_stream_subscription_batch_source.h"
 #include "google/cloud/pubsub/internal/streaming_subscription_batch_source.h"
 #include "google/cloud/pubsub/internal/subscription_lease_management.h"
 #include "google/cloud/pubsub/internal/subscription_message_queue.h"
 #include "google/cloud/log.h"
 #include "absl/memory/memory.h"
+#include <functional>
 
 namespace google {
 namespace cloud {
@@ -25,6 +27,24 @@ namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 namespace {
 
+/// Start the pipeline with either a per-message or a batch callback.
+using StartPipeline = std::function<void(SubscriptionConcurrencyControl&)>;
+
+StartPipeline MakeStart(pubsub::SubscriberConnection::SubscribeParams p) {
+  auto callback = std::move(p.callback);
+  return [callback](SubscriptionConcurrencyControl& pipeline) {
+    pipeline.Start(callback);
+  };
+}
+
+StartPipeline MakeStart(pubsub::SubscriberConnection::SubscribeBatchParams p) {
+  auto callback = std::move(p.callback);
+  auto const max_batch_size = p.max_batch_size;
+  return [callback, max_batch_size](SubscriptionConcurrencyControl& pipeline) {
+    pipeline.StartBatch(callback, max_batch_size);
+  };
+}
+
 class SubscriptionSessionImpl
     : public std::enable_shared_from_this<SubscriptionSessionImpl> {
  public:
@@ -33,12 +53,12 @@ class SubscriptionSessionImpl
       google::cloud::CompletionQueue executor,
       std::shared_ptr<SessionShutdownManager> shutdown_manager,
       std::shared_ptr<SubscriptionBatchSource> source,
-      pubsub::SubscriberConnection::SubscribeParams p) {
-    auto queue =
-        SubscriptionMessageQueue::Create(shutdown_manager, std::move(source));
+      StartPipeline const& start) {
+    auto queue = SubscriptionMessageQueue::Create(
+        shutdown_manager, std::move(source), options.metrics_sink());
     auto concurrency_control = SubscriptionConcurrencyControl::Create(
-        executor, shutdown_manager, std::move(queue),
-        options.max_concurrency());
+        executor, shutdown_manager, std::move(queue), options.max_concurrency(),
+        options.metrics_sink());
 
     auto self = std::make_shared<SubscriptionSessionImpl>(
         std::move(executor), std::move(shutdown_manager),
@@ -54,7 +74,7 @@ class SubscriptionSessionImpl
     // 2) When the completion queue is shutdown, the timer is canceled and
     //    `self` gets a chance to shutdown the pipeline.
     self->ScheduleTimer();
-    self->pipeline_->Start(std::move(p.callback));
+    start(*self->pipeline_);
     return result.then([weak](future<Status> f) {
       if (auto self = weak.lock()) self->ShutdownCompleted();
       return f.get();
@@ -155,6 +175,72 @@ class SubscriptionSessionImpl
   ShutdownState shutdown_state_ = kNotInShutdown;
   future<void> timer_;
 };
+
+/// Each of @p n streams requests an equal share of the flow control limits.
+std::int64_t StreamShare(std::int64_t limit, std::size_t n) {
+  // Zero means "unlimited", and must remain so.
+  if (limit == 0) return 0;
+  auto const streams = static_cast<std::int64_t>(n);
+  return (limit + streams - 1) / streams;
+}
+
+std::shared_ptr<SubscriptionBatchSource> MakeBatchSource(
+    pubsub::Subscription const& subscription,
+    pubsub::SubscriberOptions const& options,
+    std::vector<std::shared_ptr<SubscriberStub>> const& stubs,
+    google::cloud::CompletionQueue const& executor,
+    std::shared_ptr<SessionShutdownManager> const& shutdown_manager,
+    std::string const& client_id,
+    std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
+    std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy) {
+  auto const n = options.concurrent_streams();
+  if (n <= 1) {
+    return std::make_shared<StreamingSubscriptionBatchSource>(
+        executor, shutdown_manager, stubs.front(), subscription.FullName(),
+        client_id, options, std::move(retry_policy),
+        std::move(backoff_policy));
+  }
+  auto stream_options = options;
+  stream_options
+      .set_max_outstanding_messages(
+          StreamShare(options.max_outstanding_messages(), n))
+      .set_max_outstanding_bytes(
+          StreamShare(options.max_outstanding_bytes(), n));
+  std::vector<std::shared_ptr<SubscriptionBatchSource>> children;
+  children.reserve(n);
+  for (std::size_t i = 0; i != n; ++i) {
+    children.push_back(std::make_shared<StreamingSubscriptionBatchSource>(
+        executor, shutdown_manager, stubs[i % stubs.size()],
+        subscription.FullName(), client_id, stream_options,
+        retry_policy->clone(), backoff_policy->clone()));
+  }
+  return std::make_shared<MultiStreamSubscriptionBatchSource>(
+      std::move(children));
+}
+
+future<Status> CreateSession(
+    pubsub::Subscription const& subscription,
+    pubsub::SubscriberOptions const& options,
+    std::vector<std::shared_ptr<pubsub_internal::SubscriberStub>> const& stubs,
+    google::cloud::CompletionQueue const& executor,
+    std::string const& client_id, StartPipeline const& start,
+    std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
+    std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy,
+    std::shared_ptr<LeaseMetricsCounters> lease_metrics) {
+  auto shutdown_manager = std::make_shared<SessionShutdownManager>();
+  auto batch = MakeBatchSource(subscription, options, stubs, executor,
+                               shutdown_manager, client_id,
+                               std::move(retry_policy),
+                               std::move(backoff_policy));
+  auto lease_management = SubscriptionLeaseManagement::Create(
+      executor, shutdown_manager, std::move(batch),
+      options.max_deadline_time(), std::move(lease_metrics));
+
+  return SubscriptionSessionImpl::Create(options, executor,
+                                         std::move(shutdown_manager),
+                                         std::move(lease_management), start);
+}
+
 }  // namespace
 
 future<Status> CreateSubscriptionSession(
@@ -165,18 +251,41 @@ future<Status> CreateSubscriptionSession(
     pubsub::SubscriberConnection::SubscribeParams p,
     std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
     std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy) {
-  auto shutdown_manager = std::make_shared<SessionShutdownManager>();
-  auto batch = std::make_shared<StreamingSubscriptionBatchSource>(
-      executor, shutdown_manager, stub, subscription.FullName(),
-      std::move(client_id), options, std::move(retry_policy),
+  return CreateSubscriptionSession(
+      subscription, options,
+      std::vector<std::shared_ptr<pubsub_internal::SubscriberStub>>{stub},
+      executor, std::move(client_id), std::move(p), std::move(retry_policy),
       std::move(backoff_policy));
-  auto lease_management = SubscriptionLeaseManagement::Create(
-      executor, shutdown_manager, std::move(batch),
-      options.max_deadline_time());
+}
 
-  return SubscriptionSessionImpl::Create(
-      options, std::move(executor), std::move(shutdown_manager),
-      std::move(lease_management), std::move(p));
+future<Status> CreateSubscriptionSession(
+    pubsub::Subscription const& subscription,
+    pubsub::SubscriberOptions const& options,
+    std::vector<std::shared_ptr<pubsub_internal::SubscriberStub>> const& stubs,
+    google::cloud::CompletionQueue const& executor, std::string client_id,
+    pubsub::SubscriberConnection::SubscribeParams p,
+    std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
+    std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy,
+    std::shared_ptr<LeaseMetricsCounters> lease_metrics) {
+  return CreateSession(subscription, options, stubs, executor,
+                       std::move(client_id), MakeStart(std::move(p)),
+                       std::move(retry_policy), std::move(backoff_policy),
+                       std::move(lease_metrics));
+}
+
+future<Status> CreateBatchSubscriptionSession(
+    pubsub::Subscription const& subscription,
+    pubsub::SubscriberOptions const& options,
+    std::vector<std::shared_ptr<pubsub_internal::SubscriberStub>> const& stubs,
+    google::cloud::CompletionQueue const& executor, std::string client_id,
+    pubsub::SubscriberConnection::SubscribeBatchParams p,
+    std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
+    std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy,
+    std::shared_ptr<LeaseMetricsCounters> lease_metrics) {
+  return CreateSession(subscription, options, stubs, executor,
+                       std::move(client_id), MakeStart(std::move(p)),
+                       std::move(retry_policy), std::move(backoff_policy),
+                       std::move(lease_metrics));
 }
 
 future<Status> CreateTestingSubscriptionSession(
@@ -198,10 +307,10 @@ future<Status> CreateTestingSubscriptionSession(
             .clone();
   }
   auto shutdown_manager = std::make_shared<SessionShutdownManager>();
-  auto batch = std::make_shared<StreamingSubscriptionBatchSource>(
-      executor, shutdown_manager, stub, subscription.FullName(),
-      "test-client-id", options, std::move(retry_policy),
-      std::move(backoff_policy));
+  auto batch =
+      MakeBatchSource(subscription, options, {stub}, executor,
+                      shutdown_manager, "test-client-id",
+                      std::move(retry_policy), std::move(backoff_policy));
 
   auto cq = executor;  // need a copy to make it mutable
   auto timer = [cq](std::chrono::system_clock::time_point) mutable {
@@ -216,7 +325,7 @@ future<Status> CreateTestingSubscriptionSession(
 
   return SubscriptionSessionImpl::Create(
       options, std::move(executor), std::move(shutdown_manager),
-      std::move(lease_management), std::move(p));
+      std::move(lease_management), MakeStart(std::move(p)));
 }
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
@@ -19,6 +19,7 @@
 #include "google/cloud/pubsub/internal/session_shutdown_manager.h"
 #include "google/cloud/pubsub/internal/subscriber_stub.h"
 #include "google/cloud/pubsub/internal/subscription_concurrency_control.h"
+#include "google/cloud/pubsub/internal/subscription_lease_management.h"
 #include "google/cloud/pubsub/retry_policy.h"
 #include "google/cloud/pubsub/subscriber_connection.h"
 #include "google/cloud/pubsub/version.h"
@@ -27,6 +28,7 @@
 #include <deque>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -42,6 +44,38 @@ future<Status> CreateSubscriptionSession(
     std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
     std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy);
 
+/**
+ * Create a session using `options.concurrent_streams()` streaming pulls.
+ *
+ * The streams are assigned to the @p stubs in round-robin order, typically
+ * each stub uses a different channel. The lease management updates
+ * @p lease_metrics, if not null.
+ */
+future<Status> CreateSubscriptionSession(
+    pubsub::Subscription const& subscription,
+    pubsub::SubscriberOptions const& options,
+    std::vector<std::shared_ptr<pubsub_internal::SubscriberStub>> const& stubs,
+    google::cloud::CompletionQueue const& executor, std::string client_id,
+    pubsub::SubscriberConnection::SubscribeParams p,
+    std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
+    std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy,
+    std::shared_ptr<LeaseMetricsCounters> lease_metrics = {});
+
+/**
+ * Create a session delivering messages in batches.
+ *
+ * Other than the callback, this is the same as `CreateSubscriptionSession()`.
+ */
+future<Status> CreateBatchSubscriptionSession(
+    pubsub::Subscription const& subscription,
+    pubsub::SubscriberOptions const& options,
+    std::vector<std::shared_ptr<pubsub_internal::SubscriberStub>> const& stubs,
+    google::cloud::CompletionQueue const& executor, std::string client_id,
+    pubsub::SubscriberConnection::SubscribeBatchParams p,
+    std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
+    std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy,
+    std::shared_ptr<LeaseMetricsCounters> lease_metrics = {});
+
 future<Status> CreateTestingSubscriptionSession(
     pubsub::Subscription const& subscription,
     pubsub::SubscriberOptions const& options,
@@ -279,6 +279,48 @@ TEST(SubscriptionSessionTest, ShutdownWaitsFutures) {
   EXPECT_EQ(initial_value, final_value);
 }
 
+/// @test Verify batch sessions deliver and acknowledge messages in batches.
+TEST(SubscriptionSessionTest, BatchCallbacks) {
+  auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
+  pubsub::Subscription const subscription("test-project", "test-subscription");
+
+  EXPECT_CALL(*mock, AsyncStreamingPull)
+      .Times(AtLeast(1))
+      .WillRepeatedly(FakeAsyncStreamingPull);
+
+  auto constexpr kMaxBatchSize = 4;
+  auto constexpr kExpectedMessages = 100;
+  internal::AutomaticallyCreatedBackgroundThreads background;
+  std::atomic<int> message_count{0};
+  std::atomic<std::size_t> largest_batch{0};
+  promise<void> got_enough;
+  auto handler = [&](std::vector<pubsub::Message> const& messages,
+                     pubsub::BulkAckHandler h) {
+    if (messages.size() > largest_batch.load()) {
+      largest_batch.store(messages.size());
+    }
+    auto const n = static_cast<int>(messages.size());
+    auto const previous = message_count.fetch_add(n);
+    if (previous < kExpectedMessages && previous + n >= kExpectedMessages) {
+      got_enough.set_value();
+    }
+    std::move(h).ack();
+  };
+
+  auto session = CreateBatchSubscriptionSession(
+      subscription,
+      pubsub::SubscriberOptions{}.set_max_concurrency(2 * kMaxBatchSize),
+      {mock}, background.cq(), "fake-client-id", {handler, kMaxBatchSize},
+      pubsub_testing::TestRetryPolicy(), pubsub_testing::TestBackoffPolicy());
+  got_enough.get_future()
+      .then([&session](future<void>) { session.cancel(); })
+      .get();
+
+  EXPECT_STATUS_OK(session.get());
+  EXPECT_LE(kExpectedMessages, message_count.load());
+  EXPECT_GE(kMaxBatchSize, largest_batch.load());
+}
+
 /// @test Verify shutting down a session waits for pending tasks.
 TEST(SubscriptionSessionTest, ShutdownWaitsConditionVars) {
   auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
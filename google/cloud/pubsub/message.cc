@@ -43,6 +43,13 @@ std::chrono::system_clock::time_point Message::publish_time() const {
   return google::cloud::internal::ToChronoTimePoint(proto_.publish_time());
 }
 
+std::string const& Message::attribute(std::string const& key) const {
+  static auto const* const kEmpty = new std::string;
+  auto const& attributes = proto_.attributes();
+  auto const loc = attributes.find(key);
+  return loc == attributes.end() ? *kEmpty : loc->second;
+}
+
 std::size_t Message::MessageSize() const {
   return pubsub_internal::MessageProtoSize(proto_);
 }
@@ -19,6 +19,7 @@
 #include <google/pubsub/v1/pubsub.pb.h>
 #include <iosfwd>
 #include <map>
+#include <string>
 #include <vector>
 
 namespace google {
@@ -66,6 +67,17 @@ class MessageBuilder;
 using PubsubMessageDataType = std::decay<decltype(
     std::declval<google::pubsub::v1::PubsubMessage>().data())>::type;
 
+/**
+ * Defines the type for the message attributes.
+ *
+ * This is the type used to store the attributes inside `Message`. Applications
+ * should treat it as a read-only associative container, similar to a
+ * `std::unordered_map<std::string, std::string>`, and use
+ * `Message::attributes_view()` to examine the attributes without copying them.
+ */
+using PubsubMessageAttributesType = std::decay<decltype(
+    std::declval<google::pubsub::v1::PubsubMessage>().attributes())>::type;
+
 /**
  * The C++ representation for a Cloud Pub/Sub messages.
  *
@@ -91,6 +103,29 @@ class Message {
     }
     return r;
   }
+
+  /**
+   * The message attributes, without copying them.
+   *
+   * The reference is invalidated if the message is modified or destroyed. Use
+   * `attributes()` to get a copy.
+   */
+  PubsubMessageAttributesType const& attributes_view() const {
+    return proto_.attributes();
+  }
+
+  /// Returns true if the message has an attribute named @p key.
+  bool has_attribute(std::string const& key) const {
+    return proto_.attributes().count(key) != 0;
+  }
+
+  /**
+   * Returns the value of the @p key attribute, without copying it.
+   *
+   * Returns an empty string if the message has no attribute named @p key, use
+   * `has_attribute()` to distinguish this case from an empty value.
+   */
+  std::string const& attribute(std::string const& key) const;
   //@}
 
   //@{
@@ -171,19 +206,16 @@ class MessageBuilder {
 
   /// Inserts an attribute to the message, leaving the message unchanged if @p
   /// key is already present.
-  MessageBuilder& InsertAttribute(std::string const& key,
-                                  std::string const& value) & {
-    using value_type =
-        google::protobuf::Map<std::string, std::string>::value_type;
-    proto_.mutable_attributes()->insert(value_type{key, value});
+  MessageBuilder& InsertAttribute(std::string const& key, std::string value) & {
+    Insert(*proto_.mutable_attributes(), key, std::move(value));
     return *this;
   }
 
   /// Inserts an attribute to the message, leaving the message unchanged if @p
   /// key is already present.
   MessageBuilder&& InsertAttribute(std::string const& key,
-                                   std::string const& value) && {
-    return std::move(InsertAttribute(key, value));
+                                   std::string value) && {
+    return std::move(InsertAttribute(key, std::move(value)));
   }
 
   /// Inserts or sets an attribute on the message.
@@ -224,12 +256,8 @@ class MessageBuilder {
   MessageBuilder& SetAttributes(
       // NOLINTNEXTLINE(performance-unnecessary-value-param)
       std::vector<std::pair<std::string, std::string>> v) & {
-    using value_type =
-        google::protobuf::Map<std::string, std::string>::value_type;
     google::protobuf::Map<std::string, std::string> tmp;
-    for (auto& kv : v) {
-      tmp.insert(value_type(std::move(kv.first), std::move(kv.second)));
-    }
+    for (auto& kv : v) Insert(tmp, kv.first, std::move(kv.second));
     proto_.mutable_attributes()->swap(tmp);
     return *this;
   }
@@ -256,6 +284,15 @@ class MessageBuilder {
   }
 
  private:
+  /// Insert @p key unless it is already present, moving (not copying) @p value.
+  static void Insert(google::protobuf::Map<std::string, std::string>& map,
+                     std::string const& key, std::string value) {
+    using value_type =
+        google::protobuf::Map<std::string, std::string>::value_type;
+    auto loc = map.insert(value_type(key, std::string{}));
+    if (loc.second) loc.first->second = std::move(value);
+  }
+
   google::pubsub::v1::PubsubMessage proto_;
 };
 
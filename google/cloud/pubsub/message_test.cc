@@ -132,6 +132,36 @@ TEST(Message, SetAttributesVectorStdTupleSimple) {
                                    std::make_pair("k2", "v2")));
 }
 
+TEST(Message, SetAttributesVectorStdPairDuplicates) {
+  auto const m0 = MessageBuilder{}
+                      .SetAttributes({{"k0", "v0"}, {"k1", "v1"}, {"k0", "v2"}})
+                      .Build();
+  EXPECT_THAT(m0.attributes(),
+              UnorderedElementsAre(std::make_pair("k0", "v0"),
+                                   std::make_pair("k1", "v1")));
+}
+
+TEST(Message, AttributesView) {
+  auto const m0 = MessageBuilder{}
+                      .SetAttribute("k0", "v0")
+                      .SetAttribute("k1", "")
+                      .SetAttribute("k2", "v2")
+                      .Build();
+  auto const& view = m0.attributes_view();
+  EXPECT_EQ(3U, view.size());
+  std::map<std::string, std::string> actual(view.begin(), view.end());
+  EXPECT_EQ(m0.attributes(), actual);
+
+  EXPECT_TRUE(m0.has_attribute("k0"));
+  EXPECT_TRUE(m0.has_attribute("k1"));
+  EXPECT_FALSE(m0.has_attribute("k3"));
+  EXPECT_EQ("v0", m0.attribute("k0"));
+  EXPECT_EQ("", m0.attribute("k1"));
+  EXPECT_EQ("", m0.attribute("k3"));
+  // The accessors return references to the attributes in the message.
+  EXPECT_EQ(&view.at("k2"), &m0.attribute("k2"));
+}
+
 TEST(Message, SetData) {
   auto const m0 =
       MessageBuilder{}.SetData("original").SetData("changed").Build();
@@ -0,0 +1,110 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/metrics_sink.h"
+
+namespace google {
+namespace cloud {
+namespace pubsub {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+std::string ToString(MetricsCounter counter) {
+  switch (counter) {
+    case MetricsCounter::kPublishBatches:
+      return "PublishBatches";
+    case MetricsCounter::kPublishedMessages:
+      return "PublishedMessages";
+    case MetricsCounter::kPublishFailedMessages:
+      return "PublishFailedMessages";
+    case MetricsCounter::kReceivedMessages:
+      return "ReceivedMessages";
+    case MetricsCounter::kAckedMessages:
+      return "AckedMessages";
+    case MetricsCounter::kNackedMessages:
+      return "NackedMessages";
+  }
+  return "Unknown";
+}
+
+std::string ToString(MetricsHistogram histogram) {
+  switch (histogram) {
+    case MetricsHistogram::kBatchFillTime:
+      return "BatchFillTime";
+    case MetricsHistogram::kBatchCorkedTime:
+      return "BatchCorkedTime";
+    case MetricsHistogram::kPublishLatency:
+      return "PublishLatency";
+    case MetricsHistogram::kQueueingDelay:
+      return "QueueingDelay";
+    case MetricsHistogram::kCallbackTime:
+      return "CallbackTime";
+    case MetricsHistogram::kAckLatency:
+      return "AckLatency";
+  }
+  return "Unknown";
+}
+
+std::size_t constexpr InProcessMetricsSink::kBucketCount;
+std::size_t constexpr InProcessMetricsSink::kCounterCount;
+std::size_t constexpr InProcessMetricsSink::kHistogramCount;
+
+InProcessMetricsSink::InProcessMetricsSink() {
+  for (auto& c : counters_) c.store(0);
+  for (auto& h : histograms_) {
+    h.sum.store(0);
+    for (auto& b : h.buckets) b.store(0);
+  }
+}
+
+void InProcessMetricsSink::Increment(MetricsCounter counter,
+                                     std::int64_t value) {
+  counters_[static_cast<std::size_t>(counter)].fetch_add(
+      value, std::memory_order_relaxed);
+}
+
+void InProcessMetricsSink::Record(MetricsHistogram histogram,
+                                  std::chrono::microseconds value) {
+  auto const bucket =
+      google::cloud::internal::LatencyBucket(value, kBucketCount);
+  auto& h = histograms_[static_cast<std::size_t>(histogram)];
+  h.sum.fetch_add(value.count(), std::memory_order_relaxed);
+  h.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+std::int64_t InProcessMetricsSink::counter(MetricsCounter counter) const {
+  return counters_[static_cast<std::size_t>(counter)].load(
+      std::memory_order_relaxed);
+}
+
+MetricsHistogramSnapshot InProcessMetricsSink::histogram(
+    MetricsHistogram histogram) const {
+  auto const& h = histograms_[static_cast<std::size_t>(histogram)];
+  MetricsHistogramSnapshot snapshot;
+  snapshot.buckets.reserve(kBucketCount);
+  // The count is the sum of the buckets, so it is consistent with them even if
+  // other threads are recording samples.
+  snapshot.count = 0;
+  for (auto const& b : h.buckets) {
+    snapshot.buckets.push_back(b.load(std::memory_order_relaxed));
+    snapshot.count += snapshot.buckets.back();
+  }
+  snapshot.sum =
+      std::chrono::microseconds(h.sum.load(std::memory_order_relaxed));
+  return snapshot;
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub
+}  // namespace cloud
+}  // namespace google
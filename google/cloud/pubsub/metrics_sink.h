@@ -0,0 +1,180 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_METRICS_SINK_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_METRICS_SINK_H
+
+#include "google/cloud/pubsub/version.h"
+#include "google/cloud/internal/latency_histogram.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+/// The counters reported to a `MetricsSink`.
+enum class MetricsCounter {
+  /// The number of `Publish()` RPCs, including failed RPCs.
+  kPublishBatches,
+  /// The number of messages in successful `Publish()` RPCs.
+  kPublishedMessages,
+  /// The number of messages in failed `Publish()` RPCs.
+  kPublishFailedMessages,
+  /// The number of messages delivered to the application callbacks.
+  kReceivedMessages,
+  /// The number of messages acked by the application.
+  kAckedMessages,
+  /// The number of messages nacked by the application.
+  kNackedMessages,
+};
+
+/// The latencies reported to a `MetricsSink`.
+enum class MetricsHistogram {
+  /// The time from the first message in a batch until the batch is ready.
+  kBatchFillTime,
+  /**
+   * The time a ready batch waits before its `Publish()` RPC starts.
+   *
+   * With message ordering a batch waits until the previous batch for the same
+   * ordering key completes. Batches may also wait because too many RPCs are
+   * in progress, see `PublisherOptions::set_maximum_concurrent_batches()`.
+   */
+  kBatchCorkedTime,
+  /// The latency of each `Publish()` RPC, including any retries.
+  kPublishLatency,
+  /// The time messages wait in the subscriber before their callback is
+  /// scheduled, for example, because a previous message with the same ordering
+  /// key is still being handled.
+  kQueueingDelay,
+  /// The time spent in each call to the application callback.
+  kCallbackTime,
+  /// The time from scheduling the callback until the application acks or
+  /// nacks the message(s).
+  kAckLatency,
+};
+
+/// A human-readable name for @p counter.
+std::string ToString(MetricsCounter counter);
+
+/// A human-readable name for @p histogram.
+std::string ToString(MetricsHistogram histogram);
+
+/**
+ * Receives the metrics reported by a `Publisher` or a `Subscriber`.
+ *
+ * Applications can implement this interface to export the metrics to their
+ * monitoring system. The member functions are called from the threads running
+ * the library, often while processing each message, so they must be
+ * thread-safe, and they should be fast and non-blocking.
+ *
+ * The library does not measure anything unless a sink is configured, see
+ * `PublisherOptions::set_metrics_sink()` and
+ * `SubscriberOptions::set_metrics_sink()`.
+ *
+ * @see `InProcessMetricsSink` for a simple implementation.
+ */
+class MetricsSink {
+ public:
+  virtual ~MetricsSink() = default;
+
+  /// Add @p value to @p counter.
+  virtual void Increment(MetricsCounter counter, std::int64_t value) = 0;
+
+  /// Add a sample to @p histogram.
+  virtual void Record(MetricsHistogram histogram,
+                      std::chrono::microseconds value) = 0;
+};
+
+/**
+ * The values in a histogram.
+ *
+ * The histograms use logarithmic buckets, the first bucket contains the samples
+ * below 2us, and the i-th bucket contains the samples in the `[2^i, 2^(i+1))`
+ * microseconds range.
+ */
+struct MetricsHistogramSnapshot {
+  /// The number of samples.
+  std::int64_t count;
+  /// The sum of all the samples.
+  std::chrono::microseconds sum;
+  /// The number of samples in each bucket.
+  std::vector<std::int64_t> buckets;
+
+  /// The (exclusive) upper bound for the samples in @p bucket.
+  static std::chrono::microseconds UpperBound(std::size_t bucket) {
+    return google::cloud::internal::LatencyBucketUpperBound(bucket);
+  }
+
+  /**
+   * An estimate of the @p percentile latency, in the [0, 100] range.
+   *
+   * Returns the upper bound of the bucket containing the percentile, or zero
+   * if there are no samples.
+   */
+  std::chrono::microseconds Percentile(double percentile) const {
+    return google::cloud::internal::LatencyPercentile(buckets, percentile);
+  }
+};
+
+/**
+ * Aggregate the metrics in memory.
+ *
+ * This sink keeps a running total for each counter and histogram, using
+ * relaxed atomic operations. Applications, and the library benchmarks, can
+ * read the totals at any time, for example, to tune the `PublisherOptions` or
+ * `SubscriberOptions` for their workload.
+ */
+class InProcessMetricsSink : public MetricsSink {
+ public:
+  InProcessMetricsSink();
+
+  void Increment(MetricsCounter counter, std::int64_t value) override;
+  void Record(MetricsHistogram histogram,
+              std::chrono::microseconds value) override;
+
+  /// The current value of @p counter.
+  std::int64_t counter(MetricsCounter counter) const;
+
+  /// The current values of @p histogram.
+  MetricsHistogramSnapshot histogram(MetricsHistogram histogram) const;
+
+  static std::size_t constexpr kBucketCount = 40;
+
+ private:
+  static std::size_t constexpr kCounterCount =
+      static_cast<std::size_t>(MetricsCounter::kNackedMessages) + 1;
+  static std::size_t constexpr kHistogramCount =
+      static_cast<std::size_t>(MetricsHistogram::kAckLatency) + 1;
+
+  struct Histogram {
+    std::atomic<std::int64_t> sum;
+    std::array<std::atomic<std::int64_t>, kBucketCount> buckets;
+  };
+
+  std::array<std::atomic<std::int64_t>, kCounterCount> counters_;
+  std::array<Histogram, kHistogramCount> histograms_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_METRICS_SINK_H
@@ -0,0 +1,109 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/metrics_sink.h"
+#include <gmock/gmock.h>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+
+using us = std::chrono::microseconds;
+
+TEST(InProcessMetricsSink, Counters) {
+  InProcessMetricsSink sink;
+  EXPECT_EQ(0, sink.counter(MetricsCounter::kPublishedMessages));
+  sink.Increment(MetricsCounter::kPublishedMessages, 3);
+  sink.Increment(MetricsCounter::kPublishedMessages, 4);
+  sink.Increment(MetricsCounter::kAckedMessages, 1);
+  EXPECT_EQ(7, sink.counter(MetricsCounter::kPublishedMessages));
+  EXPECT_EQ(1, sink.counter(MetricsCounter::kAckedMessages));
+  EXPECT_EQ(0, sink.counter(MetricsCounter::kNackedMessages));
+}
+
+TEST(InProcessMetricsSink, Histogram) {
+  InProcessMetricsSink sink;
+  sink.Record(MetricsHistogram::kPublishLatency, us(0));
+  sink.Record(MetricsHistogram::kPublishLatency, us(1));
+  sink.Record(MetricsHistogram::kPublishLatency, us(2));
+  sink.Record(MetricsHistogram::kPublishLatency, us(1000));
+
+  auto const h = sink.histogram(MetricsHistogram::kPublishLatency);
+  EXPECT_EQ(4, h.count);
+  EXPECT_EQ(us(1003), h.sum);
+  ASSERT_EQ(InProcessMetricsSink::kBucketCount, h.buckets.size());
+  EXPECT_EQ(2, h.buckets[0]);
+  EXPECT_EQ(1, h.buckets[1]);
+  // 2^9 <= 1000 < 2^10
+  EXPECT_EQ(1, h.buckets[9]);
+
+  EXPECT_EQ(0, sink.histogram(MetricsHistogram::kAckLatency).count);
+}
+
+TEST(InProcessMetricsSink, HistogramOverflow) {
+  InProcessMetricsSink sink;
+  sink.Record(MetricsHistogram::kCallbackTime,
+              us((std::numeric_limits<std::int64_t>::max)()));
+  auto const h = sink.histogram(MetricsHistogram::kCallbackTime);
+  EXPECT_EQ(1, h.buckets.back());
+}
+
+TEST(InProcessMetricsSink, Concurrent) {
+  InProcessMetricsSink sink;
+  auto constexpr kThreads = 4;
+  auto constexpr kIterations = 1000;
+  std::vector<std::thread> threads;
+  for (int i = 0; i != kThreads; ++i) {
+    threads.emplace_back([&sink] {
+      for (int j = 0; j != kIterations; ++j) {
+        sink.Increment(MetricsCounter::kReceivedMessages, 1);
+        sink.Record(MetricsHistogram::kQueueingDelay, us(j));
+      }
+    });
+  }
+  for (auto& t : threads) t.join();
+  EXPECT_EQ(kThreads * kIterations,
+            sink.counter(MetricsCounter::kReceivedMessages));
+  EXPECT_EQ(kThreads * kIterations,
+            sink.histogram(MetricsHistogram::kQueueingDelay).count);
+}
+
+TEST(MetricsHistogramSnapshot, Percentile) {
+  MetricsHistogramSnapshot h{0, us(0), {}};
+  EXPECT_EQ(us(0), h.Percentile(50.0));
+
+  h.buckets = {10, 0, 0, 80, 10};
+  h.count = 100;
+  EXPECT_EQ(us(2), h.Percentile(5.0));
+  EXPECT_EQ(us(16), h.Percentile(50.0));
+  EXPECT_EQ(us(16), h.Percentile(90.0));
+  EXPECT_EQ(us(32), h.Percentile(99.0));
+  EXPECT_EQ(us(32), h.Percentile(100.0));
+}
+
+TEST(MetricsSink, ToString) {
+  EXPECT_EQ("PublishedMessages", ToString(MetricsCounter::kPublishedMessages));
+  EXPECT_EQ("AckLatency", ToString(MetricsHistogram::kAckLatency));
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub
+}  // namespace cloud
+}  // namespace google
@@ -38,6 +38,9 @@ class MockPublisherConnection : public pubsub::PublisherConnection {
               (override));
   MOCK_METHOD(void, ResumePublish,
               (pubsub::PublisherConnection::ResumePublishParams), (override));
+  MOCK_METHOD(pubsub::PublisherFlowControlMetrics, FlowControlMetrics,
+              (pubsub::PublisherConnection::FlowControlMetricsParams),
+              (override));
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
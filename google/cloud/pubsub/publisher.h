@@ -178,6 +178,20 @@ class Publisher {
     connection_->ResumePublish({std::move(ordering_key)});
   }
 
+  /**
+   * Returns the current state of the publisher flow control.
+   *
+   * Applications can use this function to monitor the backlog of messages
+   * published but not yet completed.
+   *
+   * @see `PublisherOptions::set_maximum_pending_messages()` and
+   *     `PublisherOptions::set_maximum_pending_bytes()` to configure the flow
+   *     control limits.
+   */
+  PublisherFlowControlMetrics FlowControlMetrics() {
+    return connection_->FlowControlMetrics({});
+  }
+
  private:
   std::shared_ptr<PublisherConnection> connection_;
 };
@@ -15,14 +15,19 @@
 #include "google/cloud/pubsub/publisher_connection.h"
 #include "google/cloud/pubsub/internal/batching_publisher_connection.h"
 #include "google/cloud/pubsub/internal/default_retry_policies.h"
+#include "google/cloud/pubsub/internal/flow_controlled_publisher_connection.h"
 #include "google/cloud/pubsub/internal/ordering_key_publisher_connection.h"
 #include "google/cloud/pubsub/internal/publisher_logging.h"
 #include "google/cloud/pubsub/internal/publisher_metadata.h"
 #include "google/cloud/pubsub/internal/publisher_stub.h"
 #include "google/cloud/pubsub/internal/rejects_with_ordering_key.h"
+#include "google/cloud/pubsub/internal/sharded_publisher_connection.h"
 #include "google/cloud/future_void.h"
 #include "google/cloud/log.h"
+#include <algorithm>
+#include <functional>
 #include <memory>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -44,6 +49,10 @@ class ContainingPublisherConnection : public PublisherConnection {
   void ResumePublish(ResumePublishParams p) override {
     child_->ResumePublish(std::move(p));
   }
+  PublisherFlowControlMetrics FlowControlMetrics(
+      FlowControlMetricsParams p) override {
+    return child_->FlowControlMetrics(p);
+  }
 
  private:
   std::shared_ptr<BackgroundThreads> background_;
@@ -64,15 +73,30 @@ void PublisherConnection::Flush(FlushParams) {}
 // NOLINTNEXTLINE(performance-unnecessary-value-param)
 void PublisherConnection::ResumePublish(ResumePublishParams) {}
 
+PublisherFlowControlMetrics PublisherConnection::FlowControlMetrics(
+    FlowControlMetricsParams) {
+  return PublisherFlowControlMetrics{0, 0, 0, 0};
+}
+
 std::shared_ptr<PublisherConnection> MakePublisherConnection(
     Topic topic, PublisherOptions options, ConnectionOptions connection_options,
     std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
     std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy) {
-  auto stub = pubsub_internal::CreateDefaultPublisherStub(connection_options,
-                                                          /*channel_id=*/0);
+  // Each shard uses a different channel, up to the number of channels in the
+  // connection. With message ordering the ordering keys are spread across the
+  // same channels.
+  auto const num_channels = static_cast<std::size_t>(
+      (std::max)(1, connection_options.num_channels()));
+  auto const stub_count = (std::min)(num_channels, options.shard_count());
+  std::vector<std::shared_ptr<pubsub_internal::PublisherStub>> stubs;
+  stubs.reserve(stub_count);
+  for (std::size_t i = 0; i != stub_count; ++i) {
+    stubs.push_back(pubsub_internal::CreateDefaultPublisherStub(
+        connection_options, static_cast<int>(i)));
+  }
   return pubsub_internal::MakePublisherConnection(
       std::move(topic), std::move(options), std::move(connection_options),
-      std::move(stub), std::move(retry_policy), std::move(backoff_policy));
+      std::move(stubs), std::move(retry_policy), std::move(backoff_policy));
 }
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
@@ -87,13 +111,30 @@ std::shared_ptr<pubsub::PublisherConnection> MakePublisherConnection(
     std::shared_ptr<PublisherStub> stub,
     std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
     std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy) {
+  return MakePublisherConnection(
+      std::move(topic), std::move(options), std::move(connection_options),
+      std::vector<std::shared_ptr<PublisherStub>>{std::move(stub)},
+      std::move(retry_policy), std::move(backoff_policy));
+}
+
+std::shared_ptr<pubsub::PublisherConnection> MakePublisherConnection(
+    pubsub::Topic topic, pubsub::PublisherOptions options,
+    pubsub::ConnectionOptions connection_options,
+    std::vector<std::shared_ptr<PublisherStub>> stubs,
+    std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
+    std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy) {
   if (!retry_policy) retry_policy = DefaultRetryPolicy();
   if (!backoff_policy) backoff_policy = DefaultBackoffPolicy();
-  stub = std::make_shared<pubsub_internal::PublisherMetadata>(std::move(stub));
+  for (auto& stub : stubs) {
+    stub =
+        std::make_shared<pubsub_internal::PublisherMetadata>(std::move(stub));
+    if (connection_options.tracing_enabled("rpc")) {
+      stub = std::make_shared<pubsub_internal::PublisherLogging>(
+          std::move(stub), connection_options.tracing_options());
+    }
+  }
   if (connection_options.tracing_enabled("rpc")) {
     GCP_LOG(INFO) << "Enabled logging for gRPC calls";
-    stub = std::make_shared<pubsub_internal::PublisherLogging>(
-        std::move(stub), connection_options.tracing_options());
   }
 
   auto default_thread_pool_size = []() -> std::size_t {
@@ -107,29 +148,48 @@ std::shared_ptr<pubsub::PublisherConnection> MakePublisherConnection(
   }
 
   auto background = connection_options.background_threads_factory()();
+  std::shared_ptr<BatchConcurrencyLimiter> limiter;
+  if (options.maximum_concurrent_batches() != 0) {
+    limiter = std::make_shared<BatchConcurrencyLimiter>(
+        background->cq(), options.maximum_concurrent_batches());
+  }
+
   auto make_connection = [&]() -> std::shared_ptr<pubsub::PublisherConnection> {
     auto cq = background->cq();
+    // We need to copy these values because we will call `clone()` on them
+    // multiple times.
+    std::shared_ptr<pubsub::RetryPolicy const> retry = std::move(retry_policy);
+    std::shared_ptr<pubsub::BackoffPolicy const> backoff =
+        std::move(backoff_policy);
     if (options.message_ordering()) {
-      // We need to copy these values because we will call `clone()` on them
-      // multiple times.
-      std::shared_ptr<pubsub::RetryPolicy const> retry =
-          std::move(retry_policy);
-      std::shared_ptr<pubsub::BackoffPolicy const> backoff =
-          std::move(backoff_policy);
-      auto factory = [topic, options, stub, cq, retry,
-                      backoff](std::string const& ordering_key) {
-        return BatchingPublisherConnection::Create(topic, options, ordering_key,
-                                                   stub, cq, retry->clone(),
-                                                   backoff->clone());
+      auto factory = [topic, options, stubs, cq, retry, backoff,
+                      limiter](std::string const& ordering_key) {
+        auto const& stub =
+            stubs[std::hash<std::string>{}(ordering_key) % stubs.size()];
+        return BatchingPublisherConnection::Create(
+            topic, options, ordering_key, stub, cq, retry->clone(),
+            backoff->clone(), limiter);
       };
-      return OrderingKeyPublisherConnection::Create(std::move(factory));
+      return OrderingKeyPublisherConnection::Create(
+          std::move(factory), options.ordering_key_idle_timeout());
+    }
+    std::vector<std::shared_ptr<pubsub::PublisherConnection>> shards;
+    shards.reserve(options.shard_count());
+    for (std::size_t i = 0; i != options.shard_count(); ++i) {
+      shards.push_back(BatchingPublisherConnection::Create(
+          topic, options, {}, stubs[i % stubs.size()], cq, retry->clone(),
+          backoff->clone(), limiter));
+    }
+    if (shards.size() == 1) {
+      return RejectsWithOrderingKey::Create(std::move(shards.front()));
     }
-    return RejectsWithOrderingKey::Create(BatchingPublisherConnection::Create(
-        std::move(topic), std::move(options), {}, std::move(stub),
-        std::move(cq), std::move(retry_policy), std::move(backoff_policy)));
+    return RejectsWithOrderingKey::Create(
+        ShardedPublisherConnection::Create(std::move(shards)));
   };
+  auto flow_control = FlowControlledPublisherConnection::Create(
+      options, make_connection());
   return std::make_shared<pubsub::ContainingPublisherConnection>(
-      std::move(background), make_connection());
+      std::move(background), std::move(flow_control));
 }
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
@@ -25,12 +25,34 @@
 #include "google/cloud/pubsub/version.h"
 #include "google/cloud/future.h"
 #include "google/cloud/status_or.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
 
 namespace google {
 namespace cloud {
 namespace pubsub {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
+/**
+ * The state of the publisher flow control.
+ *
+ * @see `PublisherOptions::set_maximum_pending_messages()` and
+ *     `PublisherOptions::set_maximum_pending_bytes()` to configure the flow
+ *     control limits.
+ */
+struct PublisherFlowControlMetrics {
+  /// The number of messages published but not yet completed.
+  std::size_t pending_messages;
+  /// The total size of the messages published but not yet completed.
+  std::size_t pending_bytes;
+  /// The number of `Publish()` calls blocked by the flow control.
+  std::int64_t blocked;
+  /// The number of messages rejected by the flow control.
+  std::int64_t rejected;
+};
+
 /**
  * A connection to the Cloud Pub/Sub service to publish events.
  *
@@ -66,6 +88,9 @@ class PublisherConnection {
     std::string ordering_key;
   };
 
+  /// Wrap the arguments for `FlowControlMetrics()`
+  struct FlowControlMetricsParams {};
+
   /// Defines the interface for `Publisher::Publish()`
   virtual future<StatusOr<std::string>> Publish(PublishParams p);
 
@@ -74,6 +99,10 @@ class PublisherConnection {
 
   /// Defines the interface for `Publisher::ResumePublish()`
   virtual void ResumePublish(ResumePublishParams p);
+
+  /// Defines the interface for `Publisher::FlowControlMetrics()`
+  virtual PublisherFlowControlMetrics FlowControlMetrics(
+      FlowControlMetricsParams);
 };
 
 /**
@@ -125,6 +154,14 @@ std::shared_ptr<pubsub::PublisherConnection> MakePublisherConnection(
     std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
     std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy);
 
+/// Create a connection where the batchers use the stubs in round-robin.
+std::shared_ptr<pubsub::PublisherConnection> MakePublisherConnection(
+    pubsub::Topic topic, pubsub::PublisherOptions options,
+    pubsub::ConnectionOptions connection_options,
+    std::vector<std::shared_ptr<PublisherStub>> stubs,
+    std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
+    std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy);
+
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
 }  // namespace pubsub_internal
 }  // namespace cloud
@@ -59,6 +59,45 @@ TEST(PublisherConnectionTest, Basic) {
   EXPECT_EQ("test-message-id-0", *response);
 }
 
+TEST(PublisherConnectionTest, FlowControl) {
+  auto mock = std::make_shared<pubsub_testing::MockPublisherStub>();
+  Topic const topic("test-project", "test-topic");
+
+  promise<StatusOr<google::pubsub::v1::PublishResponse>> response;
+  EXPECT_CALL(*mock, AsyncPublish)
+      .WillOnce([&](google::cloud::CompletionQueue&,
+                    std::unique_ptr<grpc::ClientContext>,
+                    google::pubsub::v1::PublishRequest const&) {
+        return response.get_future();
+      });
+
+  auto publisher = pubsub_internal::MakePublisherConnection(
+      topic,
+      PublisherOptions{}
+          .set_maximum_batch_message_count(1)
+          .set_maximum_pending_messages(1)
+          .set_full_publisher_rejects(),
+      {}, mock, pubsub_testing::TestRetryPolicy(),
+      pubsub_testing::TestBackoffPolicy());
+  auto f0 =
+      publisher->Publish({MessageBuilder{}.SetData("test-data-0").Build()});
+  auto r1 =
+      publisher->Publish({MessageBuilder{}.SetData("test-data-1").Build()})
+          .get();
+  EXPECT_THAT(r1.status(), StatusIs(StatusCode::kFailedPrecondition));
+  auto metrics = publisher->FlowControlMetrics({});
+  EXPECT_EQ(1, metrics.pending_messages);
+  EXPECT_EQ(1, metrics.rejected);
+
+  google::pubsub::v1::PublishResponse r;
+  r.add_message_ids("test-message-id-0");
+  response.set_value(std::move(r));
+  auto r0 = f0.get();
+  ASSERT_STATUS_OK(r0);
+  EXPECT_EQ("test-message-id-0", *r0);
+  EXPECT_EQ(0, publisher->FlowControlMetrics({}).pending_messages);
+}
+
 TEST(PublisherConnectionTest, Metadata) {
   auto mock = std::make_shared<pubsub_testing::MockPublisherStub>();
   Topic const topic("test-project", "test-topic");
@@ -43,6 +43,58 @@ TEST(PublisherOptions, Setters) {
   EXPECT_FALSE(b1.message_ordering());
 }
 
+TEST(PublisherOptions, Sharding) {
+  auto const b0 = PublisherOptions{};
+  EXPECT_EQ(1, b0.shard_count());
+  EXPECT_EQ(0, b0.maximum_concurrent_batches());
+
+  auto b1 =
+      PublisherOptions{}.set_shard_count(8).set_maximum_concurrent_batches(4);
+  EXPECT_EQ(8, b1.shard_count());
+  EXPECT_EQ(4, b1.maximum_concurrent_batches());
+
+  // 0 resets to default
+  b1.set_shard_count(0);
+  EXPECT_EQ(1, b1.shard_count());
+}
+
+TEST(PublisherOptions, OrderingKeyIdleTimeout) {
+  auto const b0 = PublisherOptions{};
+  EXPECT_EQ(std::chrono::seconds(60), b0.ordering_key_idle_timeout());
+
+  auto const b1 =
+      PublisherOptions{}.set_ordering_key_idle_timeout(std::chrono::minutes(2));
+  EXPECT_EQ(std::chrono::seconds(120), b1.ordering_key_idle_timeout());
+}
+
+TEST(PublisherOptions, FlowControl) {
+  auto const b0 = PublisherOptions{};
+  EXPECT_TRUE(b0.full_publisher_ignored());
+  EXPECT_FALSE(b0.full_publisher_rejects());
+  EXPECT_FALSE(b0.full_publisher_blocks());
+
+  auto const b1 = PublisherOptions{}
+                      .set_maximum_pending_messages(100)
+                      .set_maximum_pending_bytes(1024)
+                      .set_full_publisher_rejects();
+  EXPECT_EQ(100, b1.maximum_pending_messages());
+  EXPECT_EQ(1024, b1.maximum_pending_bytes());
+  EXPECT_TRUE(b1.full_publisher_rejects());
+
+  auto const b2 = PublisherOptions{}.set_full_publisher_blocks();
+  EXPECT_TRUE(b2.full_publisher_blocks());
+  EXPECT_FALSE(b2.full_publisher_ignored());
+  auto const b3 = PublisherOptions{b2}.set_full_publisher_ignored();
+  EXPECT_TRUE(b3.full_publisher_ignored());
+}
+
+TEST(PublisherOptions, MetricsSink) {
+  EXPECT_EQ(nullptr, PublisherOptions{}.metrics_sink());
+  auto sink = std::make_shared<InProcessMetricsSink>();
+  auto const b1 = PublisherOptions{}.set_metrics_sink(sink);
+  EXPECT_EQ(sink, b1.metrics_sink());
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
 }  // namespace pubsub
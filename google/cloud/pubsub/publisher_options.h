@@ -15,10 +15,12 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_PUBLISHER_OPTIONS_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_PUBLISHER_OPTIONS_H
 
+#include "google/cloud/pubsub/metrics_sink.h"
 #include "google/cloud/pubsub/version.h"
 #include <chrono>
 #include <cstddef>
 #include <limits>
+#include <memory>
 
 namespace google {
 namespace cloud {
@@ -38,6 +40,12 @@ inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
  * Applications developers should consult the Cloud Pub/Sub
  * [pricing page][pubsub-pricing-link] when selecting a batching configuration.
  *
+ * The options also control the publisher flow control. Applications can limit
+ * the number of messages, and the total size of the messages, that are
+ * pending (published but not yet acknowledged by the service). By default the
+ * limits are ignored, applications can configure the publisher to block the
+ * caller, or to reject new messages, once a limit is reached.
+ *
  * @par Example
  * @snippet samples.cc publisher-options
  *
@@ -133,15 +141,206 @@ class PublisherOptions {
     return *this;
   }
 
+  /// How long the publisher keeps the state for an idle ordering key.
+  std::chrono::milliseconds ordering_key_idle_timeout() const {
+    return ordering_key_idle_timeout_;
+  }
+
+  /**
+   * Set how long the publisher keeps the state for an idle ordering key.
+   *
+   * With message ordering enabled the publisher keeps a batcher for each
+   * ordering key. Batchers without pending messages, and that are not paused
+   * by a previous error, are discarded once they have been idle for this long.
+   * Applications that use many short-lived ordering keys may want to reduce
+   * this value to release memory sooner.
+   *
+   * The default value is 60 seconds.
+   */
+  template <typename Rep, typename Period>
+  PublisherOptions& set_ordering_key_idle_timeout(
+      std::chrono::duration<Rep, Period> v) {
+    ordering_key_idle_timeout_ =
+        std::chrono::duration_cast<std::chrono::milliseconds>(v);
+    return *this;
+  }
+
+  /// The number of independent batchers for messages without ordering keys.
+  std::size_t shard_count() const { return shard_count_; }
+
+  /**
+   * Set the number of independent batchers for messages without ordering keys.
+   *
+   * Each batcher has its own lock and batch, and uses a different channel
+   * (up to `ConnectionOptions::num_channels()`). Applications publishing many
+   * messages from several threads may increase this value to reduce
+   * contention. Each thread publishes to the same batcher, so messages
+   * published by a thread are sent in order, but are not guaranteed to be
+   * received in order.
+   *
+   * This option has no effect if message ordering is enabled, in that case
+   * each ordering key has its own batcher, and the ordering keys are spread
+   * across the channels.
+   *
+   * @param v the new value, 0 resets to the default (a single batcher).
+   */
+  PublisherOptions& set_shard_count(std::size_t v) {
+    shard_count_ = v == 0 ? 1 : v;
+    return *this;
+  }
+
+  /// The maximum number of concurrent `Publish()` RPCs, 0 means unlimited.
+  std::size_t maximum_concurrent_batches() const {
+    return maximum_concurrent_batches_;
+  }
+
+  /**
+   * Limit the number of concurrent `Publish()` RPCs.
+   *
+   * Batches that are ready while this many RPCs are in progress are queued
+   * until one of the RPCs completes. The limit applies to all the batchers in
+   * the publisher.
+   *
+   * @param v the new value, 0 removes the limit (the default).
+   */
+  PublisherOptions& set_maximum_concurrent_batches(std::size_t v) {
+    maximum_concurrent_batches_ = v;
+    return *this;
+  }
+
+  /// The maximum number of pending messages.
+  std::size_t maximum_pending_messages() const {
+    return maximum_pending_messages_;
+  }
+
+  /**
+   * Set the maximum number of pending messages.
+   *
+   * A message is pending from the time `Publisher::Publish()` is called until
+   * the returned future is satisfied. The publisher flow control takes
+   * effect once this many messages are pending.
+   *
+   * @see `set_full_publisher_blocks()`, `set_full_publisher_rejects()`, and
+   *     `set_full_publisher_ignored()` to configure the behavior when the
+   *     limit is reached.
+   */
+  PublisherOptions& set_maximum_pending_messages(std::size_t v) {
+    maximum_pending_messages_ = v;
+    return *this;
+  }
+
+  /// The maximum size of the pending messages.
+  std::size_t maximum_pending_bytes() const { return maximum_pending_bytes_; }
+
+  /**
+   * Set the maximum size of the pending messages.
+   *
+   * The publisher flow control takes effect once the size of the pending
+   * messages reaches this value.
+   */
+  PublisherOptions& set_maximum_pending_bytes(std::size_t v) {
+    maximum_pending_bytes_ = v;
+    return *this;
+  }
+
+  /// Returns `true` if the flow control limits are ignored.
+  bool full_publisher_ignored() const {
+    return full_publisher_action_ == FullPublisherAction::kIgnored;
+  }
+
+  /// Returns `true` if the publisher rejects messages when full.
+  bool full_publisher_rejects() const {
+    return full_publisher_action_ == FullPublisherAction::kRejects;
+  }
+
+  /// Returns `true` if the publisher blocks the caller when full.
+  bool full_publisher_blocks() const {
+    return full_publisher_action_ == FullPublisherAction::kBlocks;
+  }
+
+  /**
+   * Ignore the flow control limits.
+   *
+   * This is the default, the publisher accepts all messages, but still counts
+   * the pending messages, see `Publisher::FlowControlMetrics()`.
+   */
+  PublisherOptions& set_full_publisher_ignored() {
+    full_publisher_action_ = FullPublisherAction::kIgnored;
+    return *this;
+  }
+
+  /**
+   * Reject new messages when the publisher is full.
+   *
+   * `Publisher::Publish()` returns a future satisfied with a
+   * `kFailedPrecondition` error if accepting the message would exceed the
+   * flow control limits.
+   */
+  PublisherOptions& set_full_publisher_rejects() {
+    full_publisher_action_ = FullPublisherAction::kRejects;
+    return *this;
+  }
+
+  /**
+   * Block the caller when the publisher is full.
+   *
+   * `Publisher::Publish()` blocks until accepting the message would not exceed
+   * the flow control limits. A message larger than `maximum_pending_bytes()`
+   * is accepted once there are no other pending messages.
+   *
+   * @warning Applications should not call `Publish()` from the threads
+   *     servicing the `CompletionQueue` of the publisher (for example, from a
+   *     `.then()` continuation of a previous `Publish()` call) as these
+   *     threads are needed to release the blocked callers.
+   */
+  PublisherOptions& set_full_publisher_blocks() {
+    full_publisher_action_ = FullPublisherAction::kBlocks;
+    return *this;
+  }
+
+  /// The sink receiving the publisher metrics, null if none is configured.
+  std::shared_ptr<MetricsSink> const& metrics_sink() const {
+    return metrics_sink_;
+  }
+
+  /**
+   * Report the publisher metrics to @p v.
+   *
+   * The publisher reports the time to fill each batch, the time the batches
+   * wait before they are sent, the latency of the `Publish()` RPCs, and the
+   * number of messages published. By default no sink is configured, and the
+   * publisher does not measure these values.
+   *
+   * @see `MetricsCounter` and `MetricsHistogram` for the details.
+   */
+  PublisherOptions& set_metrics_sink(std::shared_ptr<MetricsSink> v) {
+    metrics_sink_ = std::move(v);
+    return *this;
+  }
+
  private:
+  enum class FullPublisherAction { kIgnored, kRejects, kBlocks };
+
   static auto constexpr kDefaultMaximumHoldTime = std::chrono::milliseconds(10);
   static std::size_t constexpr kDefaultMaximumMessageCount = 100;
   static std::size_t constexpr kDefaultMaximumMessageSize = 1024 * 1024L;
+  static auto constexpr kDefaultOrderingKeyIdleTimeout =
+      std::chrono::seconds(60);
 
   std::chrono::microseconds maximum_hold_time_ = kDefaultMaximumHoldTime;
   std::size_t maximum_batch_message_count_ = kDefaultMaximumMessageCount;
   std::size_t maximum_batch_bytes_ = kDefaultMaximumMessageSize;
   bool message_ordering_ = false;
+  std::chrono::milliseconds ordering_key_idle_timeout_ =
+      kDefaultOrderingKeyIdleTimeout;
+  std::size_t shard_count_ = 1;
+  std::size_t maximum_concurrent_batches_ = 0;
+  std::size_t maximum_pending_messages_ =
+      (std::numeric_limits<std::size_t>::max)();
+  std::size_t maximum_pending_bytes_ =
+      (std::numeric_limits<std::size_t>::max)();
+  FullPublisherAction full_publisher_action_ = FullPublisherAction::kIgnored;
+  std::shared_ptr<MetricsSink> metrics_sink_;
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
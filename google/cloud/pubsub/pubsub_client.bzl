@@ -20,16 +20,22 @@ pubsub_client_hdrs = [
     "ack_handler.h",
     "application_callback.h",
     "backoff_policy.h",
+    "bulk_ack_handler.h",
     "connection_options.h",
+    "internal/ack_deadline_estimator.h",
+    "internal/batch_concurrency_limiter.h",
     "internal/batching_publisher_connection.h",
     "internal/default_retry_policies.h",
     "internal/emulator_overrides.h",
+    "internal/flow_controlled_publisher_connection.h",
+    "internal/multi_stream_subscription_batch_source.h",
     "internal/ordering_key_publisher_connection.h",
     "internal/publisher_logging.h",
     "internal/publisher_metadata.h",
     "internal/publisher_stub.h",
     "internal/rejects_with_ordering_key.h",
     "internal/session_shutdown_manager.h",
+    "internal/sharded_publisher_connection.h",
     "internal/streaming_subscription_batch_source.h",
     "internal/subscriber_logging.h",
     "internal/subscriber_metadata.h",
@@ -42,6 +48,7 @@ pubsub_client_hdrs = [
     "internal/subscription_session.h",
     "internal/user_agent_prefix.h",
     "message.h",
+    "metrics_sink.h",
     "publisher.h",
     "publisher_connection.h",
     "publisher_options.h",
@@ -65,16 +72,22 @@ pubsub_client_hdrs = [
 
 pubsub_client_srcs = [
     "ack_handler.cc",
+    "bulk_ack_handler.cc",
     "connection_options.cc",
+    "internal/ack_deadline_estimator.cc",
+    "internal/batch_concurrency_limiter.cc",
     "internal/batching_publisher_connection.cc",
     "internal/default_retry_policies.cc",
     "internal/emulator_overrides.cc",
+    "internal/flow_controlled_publisher_connection.cc",
+    "internal/multi_stream_subscription_batch_source.cc",
     "internal/ordering_key_publisher_connection.cc",
     "internal/publisher_logging.cc",
     "internal/publisher_metadata.cc",
     "internal/publisher_stub.cc",
     "internal/rejects_with_ordering_key.cc",
     "internal/session_shutdown_manager.cc",
+    "internal/sharded_publisher_connection.cc",
     "internal/streaming_subscription_batch_source.cc",
     "internal/subscriber_logging.cc",
     "internal/subscriber_metadata.cc",
@@ -85,6 +98,7 @@ pubsub_client_srcs = [
     "internal/subscription_session.cc",
     "internal/user_agent_prefix.cc",
     "message.cc",
+    "metrics_sink.cc",
     "publisher.cc",
     "publisher_connection.cc",
     "publisher_options.cc",
@@ -18,13 +18,19 @@
 
 pubsub_client_unit_tests = [
     "ack_handler_test.cc",
+    "bulk_ack_handler_test.cc",
+    "internal/ack_deadline_estimator_test.cc",
+    "internal/batch_concurrency_limiter_test.cc",
     "internal/batching_publisher_connection_test.cc",
     "internal/emulator_overrides_test.cc",
+    "internal/flow_controlled_publisher_connection_test.cc",
+    "internal/multi_stream_subscription_batch_source_test.cc",
     "internal/ordering_key_publisher_connection_test.cc",
     "internal/publisher_logging_test.cc",
     "internal/publisher_metadata_test.cc",
     "internal/rejects_with_ordering_key_test.cc",
     "internal/session_shutdown_manager_test.cc",
+    "internal/sharded_publisher_connection_test.cc",
     "internal/streaming_subscription_batch_source_test.cc",
     "internal/subscriber_logging_test.cc",
     "internal/subscriber_metadata_test.cc",
@@ -34,6 +40,7 @@ pubsub_client_unit_tests = [
     "internal/subscription_session_test.cc",
     "internal/user_agent_prefix_test.cc",
     "message_test.cc",
+    "metrics_sink_test.cc",
     "publisher_connection_test.cc",
     "publisher_option_test.cc",
     "publisher_test.cc",
@@ -131,6 +131,55 @@ class Subscriber {
     return connection_->Subscribe({std::move(f)});
   }
 
+  /**
+   * Creates a new session to receive messages from @p subscription in batches.
+   *
+   * Applications receiving many small messages can use this function to reduce
+   * the per-message overhead. The library delivers up to @p max_batch_size
+   * messages in each call to @p cb, and all the messages in the batch are
+   * acknowledged (or rejected) with a single `pubsub::BulkAckHandler`.
+   *
+   * A batch contains at most one message for each ordering key. The next
+   * message with the same ordering key is not delivered until the batch is
+   * acknowledged or rejected.
+   *
+   * The messages in a batch count against `SubscriberOptions::max_concurrency`
+   * individually.
+   *
+   * @note Callable must be `CopyConstructible`, as @p cb will be stored in a
+   *   [`std::function<>`][std-function-link].
+   *
+   * @par Idempotency
+   * This is an idempotent operation; it only reads messages from the service.
+   * See `Subscribe()` for more details.
+   *
+   * @param cb the callable invoked when messages are received. This must be
+   *     usable to construct a `std::function<void(std::vector<pubsub::Message>,
+   *     pubsub::BulkAckHandler)>`.
+   * @param max_batch_size the maximum number of messages in each batch.
+   * @return a future that is satisfied when the session will no longer receive
+   *     messages. Calling `.cancel()` in this object will (eventually)
+   *     terminate the session and satisfy the future.
+   *
+   * [std-function-link]:
+   * https://en.cppreference.com/w/cpp/utility/functional/function
+   */
+  template <typename Callable>
+  future<Status> SubscribeBatch(Callable&& cb, std::size_t max_batch_size) {
+    BatchApplicationCallback f(std::forward<Callable>(cb));
+    return connection_->SubscribeBatch({std::move(f), max_batch_size});
+  }
+
+  /**
+   * Return the counters for the message lease management.
+   *
+   * Applications can use this function to verify the messages are handled
+   * before their leases expire, or to tune `SubscriberOptions`.
+   */
+  SubscriberLeaseMetrics LeaseMetrics() {
+    return connection_->LeaseMetrics({});
+  }
+
  private:
   std::shared_ptr<SubscriberConnection> connection_;
 };
@@ -21,6 +21,7 @@
 #include "google/cloud/log.h"
 #include <algorithm>
 #include <memory>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -35,16 +36,36 @@ future<Status> SubscriberConnection::Subscribe(SubscribeParams) {
       Status{StatusCode::kUnimplemented, "needs-override"});
 }
 
+// NOLINTNEXTLINE(performance-unnecessary-value-param)
+future<Status> SubscriberConnection::SubscribeBatch(SubscribeBatchParams) {
+  return make_ready_future(
+      Status{StatusCode::kUnimplemented, "needs-override"});
+}
+
+SubscriberLeaseMetrics SubscriberConnection::LeaseMetrics(LeaseMetricsParams) {
+  return SubscriberLeaseMetrics{0, 0, 0, std::chrono::seconds(0)};
+}
+
 std::shared_ptr<SubscriberConnection> MakeSubscriberConnection(
     Subscription subscription, SubscriberOptions options,
     ConnectionOptions connection_options,
     std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
     std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy) {
-  auto stub = pubsub_internal::CreateDefaultSubscriberStub(connection_options,
-                                                           /*channel_id=*/0);
+  // Each concurrent stream uses a different channel, up to the number of
+  // channels in the connection.
+  auto const num_channels = static_cast<std::size_t>(
+      (std::max)(1, connection_options.num_channels()));
+  auto const stub_count =
+      (std::min)(num_channels, options.concurrent_streams());
+  std::vector<std::shared_ptr<pubsub_internal::SubscriberStub>> stubs;
+  stubs.reserve(stub_count);
+  for (std::size_t i = 0; i != stub_count; ++i) {
+    stubs.push_back(pubsub_internal::CreateDefaultSubscriberStub(
+        connection_options, static_cast<int>(i)));
+  }
   return pubsub_internal::MakeSubscriberConnection(
       std::move(subscription), std::move(options),
-      std::move(connection_options), std::move(stub), std::move(retry_policy),
+      std::move(connection_options), std::move(stubs), std::move(retry_policy),
       std::move(backoff_policy));
 }
 
@@ -59,12 +80,12 @@ class SubscriberConnectionImpl : public pubsub::SubscriberConnection {
   explicit SubscriberConnectionImpl(
       pubsub::Subscription subscription, pubsub::SubscriberOptions options,
       pubsub::ConnectionOptions const& connection_options,
-      std::shared_ptr<pubsub_internal::SubscriberStub> stub,
+      std::vector<std::shared_ptr<pubsub_internal::SubscriberStub>> stubs,
       std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
       std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy)
       : subscription_(std::move(subscription)),
         options_(std::move(options)),
-        stub_(std::move(stub)),
+        stubs_(std::move(stubs)),
         background_(connection_options.background_threads_factory()()),
         retry_policy_(std::move(retry_policy)),
         backoff_policy_(std::move(backoff_policy)),
@@ -73,24 +94,43 @@ class SubscriberConnectionImpl : public pubsub::SubscriberConnection {
   ~SubscriberConnectionImpl() override = default;
 
   future<Status> Subscribe(SubscribeParams p) override {
-    auto client_id = [this] {
-      std::lock_guard<std::mutex> lk(mu_);
-      auto constexpr kLength = 32;
-      auto constexpr kChars = "abcdefghijklmnopqrstuvwxyz0123456789";
-      return google::cloud::internal::Sample(generator_, kLength, kChars);
-    }();
-    return CreateSubscriptionSession(
-        subscription_, options_, stub_, background_->cq(), std::move(client_id),
-        std::move(p), retry_policy_->clone(), backoff_policy_->clone());
+    return CreateSubscriptionSession(subscription_, options_, stubs_,
+                                     background_->cq(), MakeClientId(),
+                                     std::move(p), retry_policy_->clone(),
+                                     backoff_policy_->clone(), lease_metrics_);
+  }
+
+  future<Status> SubscribeBatch(SubscribeBatchParams p) override {
+    return CreateBatchSubscriptionSession(
+        subscription_, options_, stubs_, background_->cq(), MakeClientId(),
+        std::move(p), retry_policy_->clone(), backoff_policy_->clone(),
+        lease_metrics_);
+  }
+
+  pubsub::SubscriberLeaseMetrics LeaseMetrics(LeaseMetricsParams) override {
+    return pubsub::SubscriberLeaseMetrics{
+        lease_metrics_->extension_requests.load(),
+        lease_metrics_->extended_leases.load(),
+        lease_metrics_->expired_leases.load(),
+        std::chrono::seconds(lease_metrics_->ack_deadline_seconds.load())};
   }
 
  private:
+  std::string MakeClientId() {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto constexpr kLength = 32;
+    auto constexpr kChars = "abcdefghijklmnopqrstuvwxyz0123456789";
+    return google::cloud::internal::Sample(generator_, kLength, kChars);
+  }
+
   pubsub::Subscription const subscription_;
   pubsub::SubscriberOptions const options_;
-  std::shared_ptr<pubsub_internal::SubscriberStub> stub_;
+  std::vector<std::shared_ptr<pubsub_internal::SubscriberStub>> const stubs_;
   std::shared_ptr<BackgroundThreads> background_;
   std::unique_ptr<pubsub::RetryPolicy const> retry_policy_;
   std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy_;
+  std::shared_ptr<LeaseMetricsCounters> const lease_metrics_ =
+      std::make_shared<LeaseMetricsCounters>();
   std::mutex mu_;
   google::cloud::internal::DefaultPRNG generator_;
 };
@@ -102,14 +142,31 @@ std::shared_ptr<pubsub::SubscriberConnection> MakeSubscriberConnection(
     std::shared_ptr<SubscriberStub> stub,
     std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
     std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy) {
+  return MakeSubscriberConnection(
+      std::move(subscription), std::move(options),
+      std::move(connection_options),
+      std::vector<std::shared_ptr<SubscriberStub>>{std::move(stub)},
+      std::move(retry_policy), std::move(backoff_policy));
+}
+
+std::shared_ptr<pubsub::SubscriberConnection> MakeSubscriberConnection(
+    pubsub::Subscription subscription, pubsub::SubscriberOptions options,
+    pubsub::ConnectionOptions connection_options,
+    std::vector<std::shared_ptr<SubscriberStub>> stubs,
+    std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
+    std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy) {
   if (!retry_policy) retry_policy = DefaultRetryPolicy();
   if (!backoff_policy) backoff_policy = DefaultBackoffPolicy();
-  stub = std::make_shared<SubscriberMetadata>(std::move(stub));
+  for (auto& stub : stubs) {
+    stub = std::make_shared<SubscriberMetadata>(std::move(stub));
+    if (connection_options.tracing_enabled("rpc")) {
+      stub = std::make_shared<pubsub_internal::SubscriberLogging>(
+          std::move(stub), connection_options.tracing_options(),
+          connection_options.tracing_enabled("rpc-streams"));
+    }
+  }
   if (connection_options.tracing_enabled("rpc")) {
     GCP_LOG(INFO) << "Enabled logging for gRPC calls";
-    stub = std::make_shared<pubsub_internal::SubscriberLogging>(
-        std::move(stub), connection_options.tracing_options(),
-        connection_options.tracing_enabled("rpc-streams"));
   }
   auto default_thread_pool_size = []() -> std::size_t {
     auto constexpr kDefaultThreadPoolSize = 4;
@@ -122,7 +179,7 @@ std::shared_ptr<pubsub::SubscriberConnection> MakeSubscriberConnection(
   }
   return std::make_shared<SubscriberConnectionImpl>(
       std::move(subscription), std::move(options),
-      std::move(connection_options), std::move(stub), std::move(retry_policy),
+      std::move(connection_options), std::move(stubs), std::move(retry_policy),
       std::move(backoff_policy));
 }
 
@@ -18,6 +18,7 @@
 #include "google/cloud/pubsub/ack_handler.h"
 #include "google/cloud/pubsub/application_callback.h"
 #include "google/cloud/pubsub/backoff_policy.h"
+#include "google/cloud/pubsub/bulk_ack_handler.h"
 #include "google/cloud/pubsub/connection_options.h"
 #include "google/cloud/pubsub/internal/subscriber_stub.h"
 #include "google/cloud/pubsub/message.h"
@@ -26,13 +27,36 @@
 #include "google/cloud/pubsub/subscription.h"
 #include "google/cloud/pubsub/version.h"
 #include "google/cloud/status_or.h"
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <vector>
 
 namespace google {
 namespace cloud {
 namespace pubsub {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
+/**
+ * Counters to monitor the message lease management in a `Subscriber`.
+ *
+ * The library estimates the ack deadline from the time the application takes
+ * to handle each message, and extends the message leases as needed. These
+ * counters include all the sessions created by a `SubscriberConnection`.
+ */
+struct SubscriberLeaseMetrics {
+  /// The number of requests sent to extend message leases.
+  std::int64_t extension_requests;
+  /// The total number of message leases extended.
+  std::int64_t extended_leases;
+  /// The number of messages acked or nacked after their lease (probably)
+  /// expired, the service may have redelivered these messages.
+  std::int64_t expired_leases;
+  /// The current estimated ack deadline.
+  std::chrono::seconds ack_deadline;
+};
+
 /**
  * A connection to the Cloud Pub/Sub service to receive events.
  *
@@ -60,8 +84,23 @@ class SubscriberConnection {
     ApplicationCallback callback;
   };
 
+  /// Wrap the arguments for `SubscribeBatch()`
+  struct SubscribeBatchParams {
+    BatchApplicationCallback callback;
+    std::size_t max_batch_size;
+  };
+
+  /// Wrap the arguments for `LeaseMetrics()`
+  struct LeaseMetricsParams {};
+
   /// Defines the interface for `Subscriber::Subscribe()`
   virtual future<Status> Subscribe(SubscribeParams p);
+
+  /// Defines the interface for `Subscriber::SubscribeBatch()`
+  virtual future<Status> SubscribeBatch(SubscribeBatchParams p);
+
+  /// Defines the interface for `Subscriber::LeaseMetrics()`
+  virtual SubscriberLeaseMetrics LeaseMetrics(LeaseMetricsParams);
 };
 
 /**
@@ -115,6 +154,14 @@ std::shared_ptr<pubsub::SubscriberConnection> MakeSubscriberConnection(
     std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
     std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy);
 
+/// Create a connection where the streaming pulls use the stubs in round-robin.
+std::shared_ptr<pubsub::SubscriberConnection> MakeSubscriberConnection(
+    pubsub::Subscription subscription, pubsub::SubscriberOptions options,
+    pubsub::ConnectionOptions connection_options,
+    std::vector<std::shared_ptr<SubscriberStub>> stubs,
+    std::unique_ptr<pubsub::RetryPolicy const> retry_policy,
+    std::unique_ptr<pubsub::BackoffPolicy const> backoff_policy);
+
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
 }  // namespace pubsub_internal
 }  // namespace cloud
@@ -113,6 +113,56 @@ TEST(SubscriberConnectionTest, PullFailure) {
               StatusIs(StatusCode::kPermissionDenied, HasSubstr("uh-oh")));
 }
 
+/// @test Verify the streams are spread across the stubs.
+TEST(SubscriberConnectionTest, ConcurrentStreams) {
+  auto mock0 = std::make_shared<pubsub_testing::MockSubscriberStub>();
+  auto mock1 = std::make_shared<pubsub_testing::MockSubscriberStub>();
+  Subscription const subscription("test-project", "test-subscription");
+
+  auto fake = [](google::cloud::CompletionQueue& cq,
+                 std::unique_ptr<grpc::ClientContext> context,
+                 google::pubsub::v1::StreamingPullRequest const& request) {
+    // The flow control limits are split across the streams.
+    EXPECT_EQ(25, request.max_outstanding_messages());
+    EXPECT_EQ(1024, request.max_outstanding_bytes());
+    return FakeAsyncStreamingPull(cq, std::move(context), request);
+  };
+  EXPECT_CALL(*mock0, AsyncStreamingPull)
+      .Times(AtLeast(2))
+      .WillRepeatedly(fake);
+  EXPECT_CALL(*mock1, AsyncStreamingPull)
+      .Times(AtLeast(2))
+      .WillRepeatedly(fake);
+
+  CompletionQueue cq;
+  auto subscriber = pubsub_internal::MakeSubscriberConnection(
+      subscription,
+      pubsub::SubscriberOptions{}
+          .set_concurrent_streams(4)
+          .set_max_outstanding_messages(100)
+          .set_max_outstanding_bytes(4096),
+      ConnectionOptions{grpc::InsecureChannelCredentials()}
+          .DisableBackgroundThreads(cq),
+      std::vector<std::shared_ptr<pubsub_internal::SubscriberStub>>{mock0,
+                                                                    mock1},
+      pubsub_testing::TestRetryPolicy(), pubsub_testing::TestBackoffPolicy());
+  std::atomic_flag received_one{false};
+  promise<void> waiter;
+  auto handler = [&](Message const&, AckHandler h) {
+    std::move(h).ack();
+    if (received_one.test_and_set()) return;
+    waiter.set_value();
+  };
+  std::thread t([&cq] { cq.Run(); });
+  auto response = subscriber->Subscribe({handler});
+  waiter.get_future().wait();
+  response.cancel();
+  ASSERT_STATUS_OK(response.get());
+  cq.CancelAll();
+  cq.Shutdown();
+  t.join();
+}
+
 /// @test Verify key events are logged
 TEST(SubscriberConnectionTest, MakeSubscriberConnectionSetupsLogging) {
   auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
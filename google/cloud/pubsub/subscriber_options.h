@@ -15,8 +15,10 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_SUBSCRIBER_OPTIONS_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_SUBSCRIBER_OPTIONS_H
 
+#include "google/cloud/pubsub/metrics_sink.h"
 #include "google/cloud/pubsub/version.h"
 #include <chrono>
+#include <memory>
 #include <thread>
 
 namespace google {
@@ -95,6 +97,10 @@ class SubscriberOptions {
    *     application, thus, if the library receives a batch of N messages their
    *     deadline for all the messages is extended repeatedly. Only once the
    *     message is delivered to a callback does the deadline become immutable.
+   *
+   * @note The library extends the leases in increments of the 99th percentile
+   *     of the observed message handling times (between 10 and 600 seconds),
+   *     this value is only used as the initial stream ack deadline.
    */
   std::chrono::seconds max_deadline_time() const { return max_deadline_time_; }
 
@@ -105,12 +111,13 @@ class SubscriberOptions {
   }
 
   /**
-   * Set the maximum number of outstanding messages per streaming pull.
+   * Set the maximum number of outstanding messages per subscription.
    *
    * The Cloud Pub/Sub C++ client library uses streaming pull requests to
    * receive messages from the service. The service will stop delivering
    * messages if @p message_count or more messages have not been acknowledged
-   * nor rejected.
+   * nor rejected. If the subscription uses several streaming pulls (see
+   * `set_concurrent_streams()`) the limit is split evenly across them.
    *
    * @par Example
    * @snippet samples.cc subscriber-flow-control
@@ -124,12 +131,14 @@ class SubscriberOptions {
   }
 
   /**
-   * Set the maximum number of outstanding bytes per streaming pull.
+   * Set the maximum number of outstanding bytes per subscription.
    *
    * The Cloud Pub/Sub C++ client library uses streaming pull requests to
    * receive messages from the service. The service will stop delivering
    * messages if @p bytes or more worth of messages have not been
-   * acknowledged nor rejected.
+   * acknowledged nor rejected. If the subscription uses several streaming
+   * pulls (see `set_concurrent_streams()`) the limit is split evenly across
+   * them.
    *
    * @par Example
    * @snippet samples.cc subscriber-flow-control
@@ -166,6 +175,28 @@ class SubscriberOptions {
   /// Maximum number of callbacks scheduled by the library at a time.
   std::size_t max_concurrency() const { return max_concurrency_; }
 
+  /**
+   * Set the number of concurrent streaming pulls for each subscription.
+   *
+   * A single streaming pull is limited by the throughput of one stream, and
+   * one connection to the service. Applications receiving a high volume of
+   * messages can use several streaming pulls for each subscription. The
+   * streams are spread across the channels in the connection (see
+   * `ConnectionOptions::set_num_channels()`).
+   *
+   * The flow control limits (see `set_max_outstanding_messages()` and
+   * `set_max_outstanding_bytes()`) and the lease management are shared by all
+   * the streams, each stream requests a proportional share of the limits from
+   * the service.
+   *
+   * @param v the new value, 0 resets to the default (a single stream).
+   */
+  SubscriberOptions& set_concurrent_streams(std::size_t v) {
+    concurrent_streams_ = v == 0 ? 1 : v;
+    return *this;
+  }
+  std::size_t concurrent_streams() const { return concurrent_streams_; }
+
   /**
    * Control how often the session polls for automatic shutdowns.
    *
@@ -183,6 +214,25 @@ class SubscriberOptions {
     return shutdown_polling_period_;
   }
 
+  /**
+   * Report the subscriber metrics to @p v.
+   *
+   * The subscriber reports how long the messages wait before their callback
+   * is scheduled, the time spent in each callback, the time until each message
+   * is acked or nacked, and the number of messages received, acked, and
+   * nacked. By default no sink is configured, and the subscriber does not
+   * measure these values.
+   *
+   * @see `MetricsCounter` and `MetricsHistogram` for the details.
+   */
+  SubscriberOptions& set_metrics_sink(std::shared_ptr<MetricsSink> v) {
+    metrics_sink_ = std::move(v);
+    return *this;
+  }
+  std::shared_ptr<MetricsSink> const& metrics_sink() const {
+    return metrics_sink_;
+  }
+
  private:
   static std::size_t DefaultMaxConcurrency() {
     auto constexpr kDefaultMaxConcurrency = 4;
@@ -194,7 +244,9 @@ class SubscriberOptions {
   std::int64_t max_outstanding_messages_ = 1000;
   std::int64_t max_outstanding_bytes_ = 100 * 1024 * 1024L;
   std::size_t max_concurrency_ = DefaultMaxConcurrency();
+  std::size_t concurrent_streams_ = 1;
   std::chrono::milliseconds shutdown_polling_period_ = std::chrono::seconds(5);
+  std::shared_ptr<MetricsSink> metrics_sink_;
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
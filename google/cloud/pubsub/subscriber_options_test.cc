@@ -26,6 +26,7 @@ TEST(SubscriberOptionsTest, Default) {
   EXPECT_LT(0, options.max_outstanding_messages());
   EXPECT_LT(0, options.max_outstanding_bytes());
   EXPECT_LT(0, options.max_concurrency());
+  EXPECT_EQ(1, options.concurrent_streams());
 }
 
 TEST(SubscriberOptionsTest, SetMessageCount) {
@@ -53,6 +54,22 @@ TEST(SubscriberOptionsTest, SetConcurrency) {
   EXPECT_EQ(SubscriberOptions{}.max_concurrency(), options.max_concurrency());
 }
 
+TEST(SubscriberOptionsTest, SetConcurrentStreams) {
+  auto options = SubscriberOptions{}.set_concurrent_streams(4);
+  EXPECT_EQ(4, options.concurrent_streams());
+
+  // 0 resets to default
+  options.set_concurrent_streams(0);
+  EXPECT_EQ(1, options.concurrent_streams());
+}
+
+TEST(SubscriberOptionsTest, SetMetricsSink) {
+  EXPECT_EQ(nullptr, SubscriberOptions{}.metrics_sink());
+  auto sink = std::make_shared<InProcessMetricsSink>();
+  auto options = SubscriberOptions{}.set_metrics_sink(sink);
+  EXPECT_EQ(sink, options.metrics_sink());
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
 }  // namespace pubsub
@@ -14,6 +14,7 @@
 
 #include "google/cloud/pubsub/subscriber.h"
 #include "google/cloud/pubsub/mocks/mock_ack_handler.h"
+#include "google/cloud/pubsub/mocks/mock_bulk_ack_handler.h"
 #include "google/cloud/pubsub/mocks/mock_subscriber_connection.h"
 #include "google/cloud/testing_util/assert_ok.h"
 #include "absl/memory/memory.h"
@@ -63,6 +64,37 @@ TEST(SubscriberTest, SubscribeSimple) {
   ASSERT_STATUS_OK(status);
 }
 
+/// @test Verify Subscriber::SubscribeBatch() works, including mocks.
+TEST(SubscriberTest, SubscribeBatch) {
+  auto mock = std::make_shared<pubsub_mocks::MockSubscriberConnection>();
+  EXPECT_CALL(*mock, SubscribeBatch(_))
+      .WillOnce([&](SubscriberConnection::SubscribeBatchParams const& p) {
+        EXPECT_EQ(2, p.max_batch_size);
+        auto ack = absl::make_unique<pubsub_mocks::MockBulkAckHandler>();
+        EXPECT_CALL(*ack, ack()).Times(1);
+        p.callback({pubsub::MessageBuilder{}.SetData("m0").Build(),
+                    pubsub::MessageBuilder{}.SetData("m1").Build()},
+                   BulkAckHandler(std::move(ack)));
+        return make_ready_future(Status{});
+      });
+
+  Subscriber subscriber(mock);
+  std::vector<std::string> received;
+  auto status = subscriber
+                    .SubscribeBatch(
+                        [&](std::vector<Message> const& messages,
+                            BulkAckHandler h) {
+                          for (auto const& m : messages) {
+                            received.push_back(m.data());
+                          }
+                          std::move(h).ack();
+                        },
+                        2)
+                    .get();
+  ASSERT_STATUS_OK(status);
+  EXPECT_THAT(received, ::testing::ElementsAre("m0", "m1"));
+}
+
 /// @test Verify Subscriber::Subscribe() works, including mocks.
 TEST(SubscriberTest, SubscribeWithOptions) {
   Subscription const subscription("test-project", "test-subscription");
@@ -78,6 +110,21 @@ TEST(SubscriberTest, SubscribeWithOptions) {
   ASSERT_STATUS_OK(status);
 }
 
+/// @test Verify Subscriber::LeaseMetrics() works, including mocks.
+TEST(SubscriberTest, LeaseMetrics) {
+  auto mock = std::make_shared<pubsub_mocks::MockSubscriberConnection>();
+  EXPECT_CALL(*mock, LeaseMetrics).WillOnce([] {
+    return SubscriberLeaseMetrics{1, 2, 3, std::chrono::seconds(42)};
+  });
+
+  Subscriber subscriber(mock);
+  auto metrics = subscriber.LeaseMetrics();
+  EXPECT_EQ(1, metrics.extension_requests);
+  EXPECT_EQ(2, metrics.extended_leases);
+  EXPECT_EQ(3, metrics.expired_leases);
+  EXPECT_EQ(std::chrono::seconds(42), metrics.ack_deadline);
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
 }  // namespace pubsub
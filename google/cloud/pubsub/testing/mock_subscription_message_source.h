@@ -28,12 +28,17 @@ class MockSubscriptionMessageSource
     : public pubsub_internal::SubscriptionMessageSource {
  public:
   MOCK_METHOD1(Start, void(pubsub_internal::MessageCallback));
+  MOCK_METHOD1(StartBatch, void(pubsub_internal::MessageBatchCallback));
   MOCK_METHOD0(Shutdown, void());
   MOCK_METHOD1(Read, void(std::size_t max_callbacks));
   MOCK_METHOD2(AckMessage,
                future<Status>(std::string const& ack_id, std::size_t size));
   MOCK_METHOD2(NackMessage,
                future<Status>(std::string const& ack_id, std::size_t size));
+  MOCK_METHOD2(BulkAck, future<Status>(std::vector<std::string> ack_ids,
+                                       std::size_t total_size));
+  MOCK_METHOD2(BulkNack, future<Status>(std::vector<std::string> ack_ids,
+                                        std::size_t total_size));
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
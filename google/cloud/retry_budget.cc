@@ -0,0 +1,66 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/retry_budget.h"
+#include <algorithm>
+#include <cmath>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+
+std::int64_t ToFixedPoint(double value, std::int64_t scale) {
+  return static_cast<std::int64_t>(
+      std::llround((std::max)(0.0, value) * static_cast<double>(scale)));
+}
+
+}  // namespace
+
+std::int64_t constexpr RetryBudget::kTokenScale;
+
+RetryBudget::RetryBudget(double retry_ratio, double max_tokens)
+    : deposit_(ToFixedPoint(retry_ratio, kTokenScale)),
+      max_tokens_(ToFixedPoint(max_tokens, kTokenScale)),
+      tokens_(max_tokens_) {}
+
+bool RetryBudget::TryRetry() {
+  auto current = tokens_.load(std::memory_order_relaxed);
+  do {
+    if (current < kTokenScale) {
+      throttled_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+  } while (!tokens_.compare_exchange_weak(current, current - kTokenScale,
+                                          std::memory_order_relaxed));
+  permitted_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+double RetryBudget::tokens() const {
+  return static_cast<double>(tokens_.load(std::memory_order_relaxed)) /
+         static_cast<double>(kTokenScale);
+}
+
+void RetryBudget::OnSuccessSlow(std::int64_t current) {
+  while (current < max_tokens_ &&
+         !tokens_.compare_exchange_weak(
+             current, (std::min)(max_tokens_, current + deposit_),
+             std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
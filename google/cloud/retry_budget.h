@@ -0,0 +1,111 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_RETRY_BUDGET_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_RETRY_BUDGET_H
+
+#include "google/cloud/version.h"
+#include <atomic>
+#include <cstdint>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+
+/**
+ * Limits the retries across all the requests sharing this object.
+ *
+ * The retry policies decide if each request should be retried, without any
+ * knowledge of other requests. During a partial outage all the requests in a
+ * client retry independently, and the retries multiply the load on the service
+ * when it is least able to handle it. A `RetryBudget` caps the retries to a
+ * fraction of the successful requests.
+ *
+ * The budget is a token bucket: each successful request adds @p retry_ratio
+ * tokens, and each retry consumes one token. If there are no tokens left the
+ * retry loop returns the last error instead of retrying. The bucket starts
+ * full, and holds at most @p max_tokens tokens, this allows short bursts of
+ * retries even for clients with little traffic.
+ *
+ * Share a single object across all the clients (or connections) that should
+ * be limited together, typically via `ConnectionOptions::set_retry_budget()`.
+ * The Bigtable clients take the budget via `bigtable::BudgetedRetryPolicy`.
+ *
+ * @par Performance
+ * All the operations are lock-free. When the bucket is full, which is the
+ * common case for healthy services, recording a successful request is a single
+ * relaxed atomic load.
+ */
+class RetryBudget {
+ public:
+  /**
+   * Create a budget.
+   *
+   * @param retry_ratio the number of retries allowed per successful request,
+   *     for example, `0.1` allows one retry for every 10 successful requests.
+   * @param max_tokens the maximum number of retries that can accumulate.
+   */
+  explicit RetryBudget(double retry_ratio = 0.1, double max_tokens = 10.0);
+
+  RetryBudget(RetryBudget const&) = delete;
+  RetryBudget& operator=(RetryBudget const&) = delete;
+
+  /// Record a successful request.
+  void OnSuccess() {
+    // Avoid writing to the (shared) cache line when the bucket is full.
+    auto current = tokens_.load(std::memory_order_relaxed);
+    if (current >= max_tokens_) return;
+    OnSuccessSlow(current);
+  }
+
+  /**
+   * Consume the token for one retry.
+   *
+   * @return false if the budget is exhausted, and the request should not be
+   *     retried.
+   */
+  bool TryRetry();
+
+  /// The number of retries currently available.
+  double tokens() const;
+
+  /// The number of retries allowed by this budget.
+  std::int64_t permitted_retries() const {
+    return permitted_.load(std::memory_order_relaxed);
+  }
+
+  /// The number of retries rejected by this budget.
+  std::int64_t throttled_retries() const {
+    return throttled_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  void OnSuccessSlow(std::int64_t current);
+
+  // The tokens are stored as fixed point numbers, in units of
+  // `1 / kTokenScale`, so they can be updated with integer atomics.
+  static std::int64_t constexpr kTokenScale = 1000;
+
+  std::int64_t const deposit_;
+  std::int64_t const max_tokens_;
+  std::atomic<std::int64_t> tokens_;
+  std::atomic<std::int64_t> permitted_{0};
+  std::atomic<std::int64_t> throttled_{0};
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_RETRY_BUDGET_H
@@ -0,0 +1,79 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/retry_budget.h"
+#include <gmock/gmock.h>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+
+TEST(RetryBudgetTest, StartsFull) {
+  RetryBudget budget(0.1, 3.0);
+  EXPECT_DOUBLE_EQ(3.0, budget.tokens());
+  EXPECT_TRUE(budget.TryRetry());
+  EXPECT_TRUE(budget.TryRetry());
+  EXPECT_TRUE(budget.TryRetry());
+  EXPECT_FALSE(budget.TryRetry());
+  EXPECT_FALSE(budget.TryRetry());
+  EXPECT_EQ(3, budget.permitted_retries());
+  EXPECT_EQ(2, budget.throttled_retries());
+}
+
+TEST(RetryBudgetTest, SuccessesRefill) {
+  RetryBudget budget(0.25, 2.0);
+  EXPECT_TRUE(budget.TryRetry());
+  EXPECT_TRUE(budget.TryRetry());
+  EXPECT_FALSE(budget.TryRetry());
+
+  // Each retry requires 4 successful requests.
+  for (int i = 0; i != 3; ++i) budget.OnSuccess();
+  EXPECT_FALSE(budget.TryRetry());
+  budget.OnSuccess();
+  EXPECT_TRUE(budget.TryRetry());
+  EXPECT_FALSE(budget.TryRetry());
+}
+
+TEST(RetryBudgetTest, CappedAtMaxTokens) {
+  RetryBudget budget(0.5, 2.0);
+  for (int i = 0; i != 100; ++i) budget.OnSuccess();
+  EXPECT_DOUBLE_EQ(2.0, budget.tokens());
+  EXPECT_TRUE(budget.TryRetry());
+  EXPECT_TRUE(budget.TryRetry());
+  EXPECT_FALSE(budget.TryRetry());
+}
+
+TEST(RetryBudgetTest, ConcurrentUse) {
+  auto constexpr kThreadCount = 4;
+  auto constexpr kIterations = 1000;
+  // The budget only allows one retry per successful request, and starts empty.
+  RetryBudget budget(1.0, 0.0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kThreadCount; ++t) {
+    threads.emplace_back([&budget] {
+      for (int i = 0; i != kIterations; ++i) budget.TryRetry();
+    });
+  }
+  for (auto& t : threads) t.join();
+  EXPECT_EQ(0, budget.permitted_retries());
+  EXPECT_EQ(kThreadCount * kIterations, budget.throttled_retries());
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,124 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/rpc_metrics.h"
+#include "absl/memory/memory.h"
+#include <atomic>
+#include <unordered_map>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+
+std::atomic<std::uint64_t> aggregator_id_generator{0};
+
+// Only the owning thread writes to a counter, so a relaxed load + store is
+// enough, and avoids the cost of a read-modify-write instruction.
+void Increment(std::atomic<std::int64_t>& counter, std::int64_t value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value,
+                std::memory_order_relaxed);
+}
+
+}  // namespace
+
+struct RpcMetricsAggregator::Shard {
+  struct Counters {
+    std::atomic<std::int64_t> attempts{0};
+    std::atomic<std::int64_t> request_bytes{0};
+    std::atomic<std::int64_t> response_bytes{0};
+    std::atomic<std::int64_t> total_latency_ns{0};
+    std::array<std::atomic<std::int64_t>, kRpcStatusCodeCount> status_codes{};
+    std::array<std::atomic<std::int64_t>, kRpcLatencyBucketCount>
+        latency_histogram{};
+  };
+
+  // Guards insertions into `methods`. The owning thread reads `methods`
+  // without the lock, as it is the only thread that modifies the map.
+  std::mutex mu;
+  std::unordered_map<char const*, std::unique_ptr<Counters>> methods;
+};
+
+RpcMetricsAggregator::RpcMetricsAggregator()
+    : id_(++aggregator_id_generator) {}
+
+RpcMetricsAggregator::~RpcMetricsAggregator() = default;
+
+void RpcMetricsAggregator::Record(RpcMetricsSample const& sample) {
+  auto& shard = LocalShard();
+  auto loc = shard.methods.find(sample.method);
+  if (loc == shard.methods.end()) {
+    std::lock_guard<std::mutex> lk(shard.mu);
+    loc = shard.methods
+              .emplace(sample.method, absl::make_unique<Shard::Counters>())
+              .first;
+  }
+  auto& counters = *loc->second;
+  Increment(counters.attempts, 1);
+  Increment(counters.request_bytes,
+            static_cast<std::int64_t>(sample.request_bytes));
+  Increment(counters.response_bytes,
+            static_cast<std::int64_t>(sample.response_bytes));
+  Increment(counters.total_latency_ns, sample.latency.count());
+  auto const code = static_cast<std::size_t>(sample.code);
+  if (code < kRpcStatusCodeCount) Increment(counters.status_codes[code], 1);
+  auto const bucket = internal::LatencyBucket(
+      std::chrono::duration_cast<std::chrono::microseconds>(sample.latency),
+      kRpcLatencyBucketCount);
+  Increment(counters.latency_histogram[bucket], 1);
+}
+
+std::map<std::string, RpcMethodMetrics> RpcMetricsAggregator::Snapshot()
+    const {
+  std::map<std::string, RpcMethodMetrics> result;
+  std::lock_guard<std::mutex> lk(mu_);
+  for (auto const& shard : shards_) {
+    std::lock_guard<std::mutex> shard_lk(shard->mu);
+    for (auto const& kv : shard->methods) {
+      auto const& c = *kv.second;
+      auto& m = result[kv.first];
+      m.attempts += c.attempts.load(std::memory_order_relaxed);
+      m.request_bytes += c.request_bytes.load(std::memory_order_relaxed);
+      m.response_bytes += c.response_bytes.load(std::memory_order_relaxed);
+      m.total_latency += std::chrono::nanoseconds(
+          c.total_latency_ns.load(std::memory_order_relaxed));
+      for (std::size_t i = 0; i != kRpcStatusCodeCount; ++i) {
+        m.status_codes[i] += c.status_codes[i].load(std::memory_order_relaxed);
+      }
+      for (std::size_t i = 0; i != kRpcLatencyBucketCount; ++i) {
+        m.latency_histogram[i] +=
+            c.latency_histogram[i].load(std::memory_order_relaxed);
+      }
+    }
+  }
+  return result;
+}
+
+RpcMetricsAggregator::Shard& RpcMetricsAggregator::LocalShard() {
+  // Aggregator ids are never reused, so entries for deleted aggregators are
+  // never found again. They are small, and released when the thread exits.
+  thread_local std::unordered_map<std::uint64_t, Shard*> shards;
+  auto loc = shards.find(id_);
+  if (loc != shards.end()) return *loc->second;
+  auto shard = absl::make_unique<Shard>();
+  auto* s = shard.get();
+  std::lock_guard<std::mutex> lk(mu_);
+  shards_.push_back(std::move(shard));
+  shards.emplace(id_, s);
+  return *s;
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,143 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_RPC_METRICS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_RPC_METRICS_H
+
+#include "google/cloud/internal/latency_histogram.h"
+#include "google/cloud/status.h"
+#include "google/cloud/version.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+
+/**
+ * The measurements for a single RPC attempt.
+ *
+ * Each call through a metrics decorator is one attempt, so RPCs retried by the
+ * client library produce one sample per attempt.
+ */
+struct RpcMetricsSample {
+  /// The name of the RPC, must be a string with static storage duration.
+  char const* method;
+  /**
+   * The time elapsed between starting the RPC and receiving its result.
+   *
+   * For streams, the time until their final status, or until they are
+   * destroyed. Streams destroyed before their final status is known are
+   * recorded as `StatusCode::kCancelled`.
+   */
+  std::chrono::nanoseconds latency;
+  /// The size of the serialized request(s), for streams all the writes.
+  std::size_t request_bytes;
+  /// The size of the serialized response(s), zero on unary RPC errors.
+  std::size_t response_bytes;
+  /// The result of the attempt.
+  StatusCode code;
+};
+
+/**
+ * Receives the measurements for each RPC attempt.
+ *
+ * Implementations are called from the threads issuing RPCs, including the
+ * threads running the background `CompletionQueue`. They must be thread-safe,
+ * and should be cheap, as they run for every RPC attempt.
+ */
+class RpcMetricsSink {
+ public:
+  virtual ~RpcMetricsSink() = default;
+
+  virtual void Record(RpcMetricsSample const& sample) = 0;
+};
+
+/// The number of buckets in the `RpcMethodMetrics` latency histogram.
+constexpr std::size_t kRpcLatencyBucketCount = 32;
+
+/// The number of distinct `StatusCode` values, for `RpcMethodMetrics`.
+constexpr std::size_t kRpcStatusCodeCount = 17;
+
+/// The aggregated measurements for one RPC.
+struct RpcMethodMetrics {
+  std::int64_t attempts = 0;
+  std::int64_t request_bytes = 0;
+  std::int64_t response_bytes = 0;
+  std::chrono::nanoseconds total_latency{0};
+  /// The number of attempts by `StatusCode`, indexed by the numeric value.
+  std::array<std::int64_t, kRpcStatusCodeCount> status_codes{};
+  /**
+   * The number of attempts by latency, using logarithmic buckets.
+   *
+   * Bucket `0` counts the latencies below 2us, bucket `i` counts the latencies
+   * in the `[2^i, 2^(i+1))` microseconds range, and the last bucket counts
+   * everything above that.
+   */
+  std::array<std::int64_t, kRpcLatencyBucketCount> latency_histogram{};
+
+  /**
+   * An estimate of the @p percentile latency, in the [0, 100] range.
+   *
+   * Returns the upper bound of the bucket containing the percentile, or zero
+   * if there are no samples.
+   */
+  std::chrono::microseconds Percentile(double percentile) const {
+    return internal::LatencyPercentile(latency_histogram, percentile);
+  }
+};
+
+/**
+ * A `RpcMetricsSink` aggregating the samples in memory.
+ *
+ * Each thread records into its own shard, using relaxed atomic loads and
+ * stores. Recording threads never contend with each other, and only take a
+ * (per-shard, uncontended) lock the first time a thread sees a new RPC name.
+ * `Snapshot()` merges the shards, it is intended to be called periodically,
+ * for example, to export the data to a monitoring system.
+ */
+class RpcMetricsAggregator : public RpcMetricsSink {
+ public:
+  RpcMetricsAggregator();
+  ~RpcMetricsAggregator() override;
+
+  RpcMetricsAggregator(RpcMetricsAggregator const&) = delete;
+  RpcMetricsAggregator& operator=(RpcMetricsAggregator const&) = delete;
+
+  void Record(RpcMetricsSample const& sample) override;
+
+  /// Returns the aggregated metrics, keyed by RPC name.
+  std::map<std::string, RpcMethodMetrics> Snapshot() const;
+
+ private:
+  struct Shard;
+  Shard& LocalShard();
+
+  std::uint64_t const id_;
+  mutable std::mutex mu_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_RPC_METRICS_H
@@ -0,0 +1,90 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/rpc_metrics.h"
+#include <gmock/gmock.h>
+#include <thread>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+
+using ::testing::ElementsAre;
+
+std::size_t Index(StatusCode code) { return static_cast<std::size_t>(code); }
+
+TEST(RpcMetricsTest, Aggregate) {
+  RpcMetricsAggregator aggregator;
+  aggregator.Record({"Service.Get", std::chrono::microseconds(3), 10, 100,
+                     StatusCode::kOk});
+  aggregator.Record({"Service.Get", std::chrono::microseconds(5), 10, 0,
+                     StatusCode::kUnavailable});
+  aggregator.Record({"Service.List", std::chrono::microseconds(0), 20, 200,
+                     StatusCode::kOk});
+
+  auto const snapshot = aggregator.Snapshot();
+  ASSERT_EQ(2, snapshot.size());
+
+  auto const& get = snapshot.at("Service.Get");
+  EXPECT_EQ(2, get.attempts);
+  EXPECT_EQ(20, get.request_bytes);
+  EXPECT_EQ(100, get.response_bytes);
+  EXPECT_EQ(std::chrono::microseconds(8), get.total_latency);
+  EXPECT_EQ(1, get.status_codes[Index(StatusCode::kOk)]);
+  EXPECT_EQ(1, get.status_codes[Index(StatusCode::kUnavailable)]);
+  EXPECT_EQ(1, get.latency_histogram[1]);
+  EXPECT_EQ(1, get.latency_histogram[2]);
+  EXPECT_EQ(std::chrono::microseconds(4), get.Percentile(50.0));
+  EXPECT_EQ(std::chrono::microseconds(8), get.Percentile(99.0));
+
+  auto const& list = snapshot.at("Service.List");
+  EXPECT_EQ(1, list.attempts);
+  EXPECT_EQ(1, list.latency_histogram[0]);
+  EXPECT_EQ(std::chrono::microseconds(2), list.Percentile(50.0));
+}
+
+TEST(RpcMetricsTest, MergesThreads) {
+  auto constexpr kThreadCount = 4;
+  auto constexpr kIterations = 1000;
+  RpcMetricsAggregator aggregator;
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kThreadCount; ++t) {
+    threads.emplace_back([&aggregator] {
+      for (int i = 0; i != kIterations; ++i) {
+        aggregator.Record({"Service.Get", std::chrono::microseconds(1), 1, 2,
+                           StatusCode::kOk});
+        // Snapshots can run concurrently with the recording threads.
+        if (i % 100 == 0) (void)aggregator.Snapshot();
+      }
+    });
+  }
+  for (auto& t : threads) t.join();
+
+  auto const snapshot = aggregator.Snapshot();
+  std::vector<std::string> names;
+  for (auto const& kv : snapshot) names.push_back(kv.first);
+  EXPECT_THAT(names, ElementsAre("Service.Get"));
+  auto const& get = snapshot.at("Service.Get");
+  EXPECT_EQ(kThreadCount * kIterations, get.attempts);
+  EXPECT_EQ(kThreadCount * kIterations, get.request_bytes);
+  EXPECT_EQ(2 * kThreadCount * kIterations, get.response_bytes);
+  EXPECT_EQ(kThreadCount * kIterations,
+            get.status_codes[Index(StatusCode::kOk)]);
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -13,6 +13,9 @@
 // limitations under the License.
 
 #include "google/cloud/spanner/database_admin_connection.h"
+#include "google/cloud/background_threads.h"
+#include "google/cloud/connection_options.h"
+#include "google/cloud/internal/async_polling_loop.h"
 #include "google/cloud/internal/polling_loop.h"
 #include "google/cloud/internal/retry_loop.h"
 #include "google/cloud/internal/time_utils.h"
@@ -24,8 +27,8 @@ namespace spanner {
 inline namespace SPANNER_CLIENT_NS {
 namespace gcsa = ::google::spanner::admin::database::v1;
 
+using google::cloud::internal::AsyncAwaitLongRunningOperation;
 using google::cloud::internal::Idempotency;
-using google::cloud::internal::PollingLoop;
 using google::cloud::internal::PollingLoopMetadataExtractor;
 using google::cloud::internal::PollingLoopResponseExtractor;
 
@@ -127,21 +130,27 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
  public:
   explicit DatabaseAdminConnectionImpl(
       std::shared_ptr<internal::DatabaseAdminStub> stub,
+      std::unique_ptr<BackgroundThreads> background_threads,
       std::unique_ptr<RetryPolicy> retry_policy,
       std::unique_ptr<BackoffPolicy> backoff_policy,
       std::unique_ptr<PollingPolicy> polling_policy)
       : stub_(std::move(stub)),
         retry_policy_prototype_(std::move(retry_policy)),
         backoff_policy_prototype_(std::move(backoff_policy)),
-        polling_policy_prototype_(std::move(polling_policy)) {}
+        polling_policy_prototype_(std::move(polling_policy)),
+        background_threads_(std::move(background_threads)) {}
 
   explicit DatabaseAdminConnectionImpl(
-      std::shared_ptr<internal::DatabaseAdminStub> stub)
-      : DatabaseAdminConnectionImpl(std::move(stub), DefaultAdminRetryPolicy(),
-                                    DefaultAdminBackoffPolicy(),
-                                    DefaultAdminPollingPolicy()) {}
+      std::shared_ptr<internal::DatabaseAdminStub> stub,
+      std::unique_ptr<BackgroundThreads> background_threads)
+      : DatabaseAdminConnectionImpl(
+            std::move(stub), std::move(background_threads),
+            DefaultAdminRetryPolicy(), DefaultAdminBackoffPolicy(),
+            DefaultAdminPollingPolicy()) {}
 
-  ~DatabaseAdminConnectionImpl() override = default;
+  // Stop polling any pending operations, otherwise releasing the background
+  // threads would block until their next polling timer expires.
+  ~DatabaseAdminConnectionImpl() override { polling_loops_.Shutdown(); }
 
   future<StatusOr<google::spanner::admin::database::v1::Database>>
   CreateDatabase(CreateDatabaseParams p) override {
@@ -507,119 +516,52 @@ class DatabaseAdminConnectionImpl : public DatabaseAdminConnection {
  private:
   future<StatusOr<gcsa::Database>> AwaitDatabase(
       google::longrunning::Operation operation) {
-    promise<StatusOr<gcsa::Database>> pr;
-    auto f = pr.get_future();
-
-    // TODO(#4038) - use the (implicit) completion queue to run this loop.
-    std::thread t(
-        [](std::shared_ptr<internal::DatabaseAdminStub> stub,
-           google::longrunning::Operation operation,
-           std::unique_ptr<PollingPolicy> polling_policy,
-           google::cloud::promise<StatusOr<gcsa::Database>> promise,
-           char const* location) mutable {
-          auto result =
-              PollingLoop<PollingLoopResponseExtractor<gcsa::Database>>(
-                  std::move(polling_policy),
-                  [stub](
-                      grpc::ClientContext& context,
-                      google::longrunning::GetOperationRequest const& request) {
-                    return stub->GetOperation(context, request);
-                  },
-                  std::move(operation), location);
-
-          // Drop our reference to stub; ideally we'd have std::moved into the
-          // lambda. Doing this also prevents a false leak from being reported
-          // when using googlemock.
-          stub.reset();
-          promise.set_value(std::move(result));
-        },
-        stub_, std::move(operation), polling_policy_prototype_->clone(),
-        std::move(pr), __func__);
-    t.detach();
-
-    return f;
+    return AwaitOperation<PollingLoopResponseExtractor<gcsa::Database>>(
+        std::move(operation), __func__);
   }
 
   future<StatusOr<gcsa::UpdateDatabaseDdlMetadata>> AwaitUpdateDatabase(
       google::longrunning::Operation operation) {
-    promise<StatusOr<gcsa::UpdateDatabaseDdlMetadata>> pr;
-    auto f = pr.get_future();
-
-    // TODO(#4038) - use the (implicit) completion queue to run this loop.
-    std::thread t(
-        [](std::shared_ptr<internal::DatabaseAdminStub> stub,
-           google::longrunning::Operation operation,
-           std::unique_ptr<PollingPolicy> polling_policy,
-           promise<StatusOr<gcsa::UpdateDatabaseDdlMetadata>> promise,
-           char const* location) mutable {
-          auto result = PollingLoop<
-              PollingLoopMetadataExtractor<gcsa::UpdateDatabaseDdlMetadata>>(
-              std::move(polling_policy),
-              [stub](grpc::ClientContext& context,
-                     google::longrunning::GetOperationRequest const& request) {
-                return stub->GetOperation(context, request);
-              },
-              std::move(operation), location);
-
-          // Drop our reference to stub; ideally we'd have std::moved into the
-          // lambda. Doing this also prevents a false leak from being reported
-          // when using googlemock.
-          stub.reset();
-          promise.set_value(std::move(result));
-        },
-        stub_, std::move(operation), polling_policy_prototype_->clone(),
-        std::move(pr), __func__);
-    t.detach();
-
-    return f;
+    return AwaitOperation<
+        PollingLoopMetadataExtractor<gcsa::UpdateDatabaseDdlMetadata>>(
+        std::move(operation), __func__);
   }
 
   future<StatusOr<gcsa::Backup>> AwaitCreateBackup(
       google::longrunning::Operation operation) {
-    // Create a local copy of stub because `this` might get out of scope when
-    // the callback will be called.
-    std::shared_ptr<internal::DatabaseAdminStub> cancel_stub(stub_);
-    // Create a promise with a cancellation callback.
-    promise<StatusOr<gcsa::Backup>> pr([cancel_stub, operation]() {
-      grpc::ClientContext context;
-      google::longrunning::CancelOperationRequest request;
-      request.set_name(operation.name());
-      cancel_stub->CancelOperation(context, request);
-    });
-    auto f = pr.get_future();
-
-    // TODO(#4038) - use the (implicit) completion queue to run this loop.
-    std::thread t(
-        [](std::shared_ptr<internal::DatabaseAdminStub> stub,
-           google::longrunning::Operation operation,
-           std::unique_ptr<PollingPolicy> polling_policy,
-           google::cloud::promise<StatusOr<gcsa::Backup>> promise,
-           char const* location) mutable {
-          auto result = PollingLoop<PollingLoopResponseExtractor<gcsa::Backup>>(
-              std::move(polling_policy),
-              [stub](grpc::ClientContext& context,
-                     google::longrunning::GetOperationRequest const& request) {
-                return stub->GetOperation(context, request);
-              },
-              std::move(operation), location);
+    return AwaitOperation<PollingLoopResponseExtractor<gcsa::Backup>>(
+        std::move(operation), __func__);
+  }
 
-          // Drop our reference to stub; ideally we'd have std::moved into the
-          // lambda. Doing this also prevents a false leak from being reported
-          // when using googlemock.
-          stub.reset();
-          promise.set_value(std::move(result));
+  // Poll the operation using the completion queue timers, no thread blocks
+  // between polls. Cancelling the returned future asks the service to cancel
+  // the operation. Destroying the connection stops polling, and satisfies the
+  // returned future with a `kCancelled` error.
+  template <typename ValueExtractor>
+  future<typename ValueExtractor::ReturnType> AwaitOperation(
+      google::longrunning::Operation operation, char const* location) {
+    auto stub = stub_;
+    return AsyncAwaitLongRunningOperation<ValueExtractor>(
+        background_threads_->cq(), std::move(operation),
+        [stub](google::cloud::CompletionQueue& cq,
+               std::unique_ptr<grpc::ClientContext> context,
+               google::longrunning::GetOperationRequest const& request) {
+          return stub->AsyncGetOperation(cq, std::move(context), request);
         },
-        stub_, std::move(operation), polling_policy_prototype_->clone(),
-        std::move(pr), __func__);
-    t.detach();
-
-    return f;
+        [stub](google::cloud::CompletionQueue& cq,
+               std::unique_ptr<grpc::ClientContext> context,
+               google::longrunning::CancelOperationRequest const& request) {
+          return stub->AsyncCancelOperation(cq, std::move(context), request);
+        },
+        polling_policy_prototype_->clone(), location, &polling_loops_);
   }
 
   std::shared_ptr<internal::DatabaseAdminStub> stub_;
   std::unique_ptr<RetryPolicy const> retry_policy_prototype_;
   std::unique_ptr<BackoffPolicy const> backoff_policy_prototype_;
   std::unique_ptr<PollingPolicy const> polling_policy_prototype_;
+  std::unique_ptr<BackgroundThreads> background_threads_;
+  google::cloud::internal::AsyncPollingLoopGroup polling_loops_;
 };
 }  // namespace
 
@@ -628,7 +570,8 @@ DatabaseAdminConnection::~DatabaseAdminConnection() = default;
 std::shared_ptr<DatabaseAdminConnection> MakeDatabaseAdminConnection(
     ConnectionOptions const& options) {
   return std::make_shared<DatabaseAdminConnectionImpl>(
-      internal::CreateDefaultDatabaseAdminStub(options));
+      internal::CreateDefaultDatabaseAdminStub(options),
+      options.background_threads_factory()());
 }
 
 std::shared_ptr<DatabaseAdminConnection> MakeDatabaseAdminConnection(
@@ -637,8 +580,8 @@ std::shared_ptr<DatabaseAdminConnection> MakeDatabaseAdminConnection(
     std::unique_ptr<PollingPolicy> polling_policy) {
   return std::make_shared<DatabaseAdminConnectionImpl>(
       internal::CreateDefaultDatabaseAdminStub(options),
-      std::move(retry_policy), std::move(backoff_policy),
-      std::move(polling_policy));
+      options.background_threads_factory()(), std::move(retry_policy),
+      std::move(backoff_policy), std::move(polling_policy));
 }
 
 namespace internal {
@@ -649,7 +592,8 @@ std::shared_ptr<DatabaseAdminConnection> MakeDatabaseAdminConnection(
     std::unique_ptr<BackoffPolicy> backoff_policy,
     std::unique_ptr<PollingPolicy> polling_policy) {
   return std::make_shared<DatabaseAdminConnectionImpl>(
-      std::move(stub), std::move(retry_policy), std::move(backoff_policy),
+      std::move(stub), google::cloud::internal::DefaultBackgroundThreads(1),
+      std::move(retry_policy), std::move(backoff_policy),
       std::move(polling_policy));
 }
 
@@ -319,6 +319,11 @@ class DatabaseAdminConnection {
  *
  * @see `DatabaseAdminConnection`
  *
+ * Long-running operations are polled using the connection's background
+ * threads. If the connection is destroyed before an operation completes, the
+ * future returned for it is satisfied with a `kCancelled` error. The operation
+ * itself is not cancelled, and continues to run in the service.
+ *
  * @param options (optional) configure the `DatabaseAdminConnection` created by
  *     this function.
  */
@@ -60,8 +60,8 @@ TEST(DatabaseAdminClientTest, CreateDatabaseSuccess) {
         op.set_done(false);
         return make_status_or(op);
       });
-  EXPECT_CALL(*mock, GetOperation(_, _))
-      .WillOnce([](grpc::ClientContext&,
+  EXPECT_CALL(*mock, AsyncGetOperation(_, _, _))
+      .WillOnce([](CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
                    google::longrunning::GetOperationRequest const& r) {
         EXPECT_EQ("test-operation-name", r.name());
         google::longrunning::Operation op;
@@ -70,7 +70,7 @@ TEST(DatabaseAdminClientTest, CreateDatabaseSuccess) {
         gcsa::Database database;
         database.set_name("test-db");
         op.mutable_response()->PackFrom(database);
-        return make_status_or(op);
+        return make_ready_future(make_status_or(op));
       });
 
   auto conn = CreateTestingConnection(std::move(mock));
@@ -102,6 +102,45 @@ TEST(DatabaseAdminClientTest, HandleCreateDatabaseError) {
   EXPECT_THAT(db, StatusIs(StatusCode::kPermissionDenied));
 }
 
+/// @test Verify that destroying the connection stops polling operations.
+TEST(DatabaseAdminClientTest, CreateDatabaseDestroyConnectionWhilePolling) {
+  auto mock = std::make_shared<MockDatabaseAdminStub>();
+
+  EXPECT_CALL(*mock, CreateDatabase(_, _))
+      .WillOnce([](grpc::ClientContext&, gcsa::CreateDatabaseRequest const&) {
+        google::longrunning::Operation op;
+        op.set_name("test-operation-name");
+        op.set_done(false);
+        return make_status_or(op);
+      });
+  EXPECT_CALL(*mock, AsyncGetOperation(_, _, _)).Times(0);
+  EXPECT_CALL(*mock, AsyncCancelOperation(_, _, _)).Times(0);
+
+  // Wait much longer than any test should take before polling.
+  LimitedErrorCountRetryPolicy retry(/*maximum_failures=*/2);
+  ExponentialBackoffPolicy backoff(
+      /*initial_delay=*/std::chrono::microseconds(1),
+      /*maximum_delay=*/std::chrono::microseconds(1),
+      /*scaling=*/2.0);
+  GenericPollingPolicy<LimitedErrorCountRetryPolicy> polling(
+      retry, ExponentialBackoffPolicy(
+                 /*initial_delay=*/std::chrono::minutes(5),
+                 /*maximum_delay=*/std::chrono::minutes(5),
+                 /*scaling=*/2.0));
+  auto conn = internal::MakeDatabaseAdminConnection(
+      mock, retry.clone(), backoff.clone(), polling.clone());
+  Database dbase("test-project", "test-instance", "test-db");
+  auto fut = conn->CreateDatabase({dbase, {}});
+  EXPECT_EQ(std::future_status::timeout,
+            fut.wait_for(std::chrono::milliseconds(10)));
+
+  // This would block until the next poll if the timer was not cancelled.
+  conn.reset();
+  ASSERT_EQ(std::future_status::ready, fut.wait_for(std::chrono::seconds(0)));
+  auto db = fut.get();
+  EXPECT_THAT(db, StatusIs(StatusCode::kCancelled));
+}
+
 /// @test Verify that the successful case works.
 TEST(DatabaseAdminClientTest, GetDatabaseSuccess) {
   auto mock = std::make_shared<MockDatabaseAdminStub>();
@@ -219,8 +258,8 @@ TEST(DatabaseAdminClientTest, UpdateDatabaseSuccess) {
             op.set_done(false);
             return make_status_or(op);
           });
-  EXPECT_CALL(*mock, GetOperation(_, _))
-      .WillOnce([](grpc::ClientContext&,
+  EXPECT_CALL(*mock, AsyncGetOperation(_, _, _))
+      .WillOnce([](CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
                    google::longrunning::GetOperationRequest const& r) {
         EXPECT_EQ("test-operation-name", r.name());
         google::longrunning::Operation op;
@@ -229,7 +268,7 @@ TEST(DatabaseAdminClientTest, UpdateDatabaseSuccess) {
         gcsa::UpdateDatabaseDdlMetadata metadata;
         metadata.set_database("test-db");
         op.mutable_metadata()->PackFrom(metadata);
-        return make_status_or(op);
+        return make_ready_future(make_status_or(op));
       });
 
   auto conn = CreateTestingConnection(std::move(mock));
@@ -275,8 +314,8 @@ TEST(DatabaseAdminClientTest, CreateDatabaseErrorInPoll) {
         op.set_done(false);
         return make_status_or(std::move(op));
       });
-  EXPECT_CALL(*mock, GetOperation(_, _))
-      .WillOnce([](grpc::ClientContext&,
+  EXPECT_CALL(*mock, AsyncGetOperation(_, _, _))
+      .WillOnce([](CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
                    google::longrunning::GetOperationRequest const& r) {
         EXPECT_EQ("test-operation-name", r.name());
         google::longrunning::Operation op;
@@ -284,7 +323,7 @@ TEST(DatabaseAdminClientTest, CreateDatabaseErrorInPoll) {
         op.mutable_error()->set_code(
             static_cast<int>(grpc::StatusCode::PERMISSION_DENIED));
         op.mutable_error()->set_message("uh-oh");
-        return op;
+        return make_ready_future(make_status_or(op));
       });
 
   auto conn = CreateTestingConnection(std::move(mock));
@@ -305,8 +344,8 @@ TEST(DatabaseAdminClientTest, UpdateDatabaseGetOperationError) {
             op.set_done(false);
             return make_status_or(std::move(op));
           });
-  EXPECT_CALL(*mock, GetOperation(_, _))
-      .WillOnce([](grpc::ClientContext&,
+  EXPECT_CALL(*mock, AsyncGetOperation(_, _, _))
+      .WillOnce([](CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
                    google::longrunning::GetOperationRequest const& r) {
         EXPECT_EQ("test-operation-name", r.name());
         google::longrunning::Operation op;
@@ -314,7 +353,7 @@ TEST(DatabaseAdminClientTest, UpdateDatabaseGetOperationError) {
         op.mutable_error()->set_code(
             static_cast<int>(grpc::StatusCode::PERMISSION_DENIED));
         op.mutable_error()->set_message("uh-oh");
-        return op;
+        return make_ready_future(make_status_or(op));
       });
 
   auto conn = CreateTestingConnection(std::move(mock));
@@ -419,8 +458,8 @@ TEST(DatabaseAdminClientTest, RestoreDatabaseSuccess) {
         op.set_done(false);
         return make_status_or(op);
       });
-  EXPECT_CALL(*mock, GetOperation(_, _))
-      .WillOnce([](grpc::ClientContext&,
+  EXPECT_CALL(*mock, AsyncGetOperation(_, _, _))
+      .WillOnce([](CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
                    google::longrunning::GetOperationRequest const& r) {
         EXPECT_EQ("test-operation-name", r.name());
         google::longrunning::Operation op;
@@ -429,7 +468,7 @@ TEST(DatabaseAdminClientTest, RestoreDatabaseSuccess) {
         gcsa::Database database;
         database.set_name("test-db");
         op.mutable_response()->PackFrom(database);
-        return make_status_or(op);
+        return make_ready_future(make_status_or(op));
       });
 
   auto conn = CreateTestingConnection(std::move(mock));
@@ -675,8 +714,8 @@ TEST(DatabaseAdminClientTest, CreateBackupSuccess) {
         op.set_done(false);
         return make_status_or(op);
       });
-  EXPECT_CALL(*mock, GetOperation(_, _))
-      .WillOnce([](grpc::ClientContext&,
+  EXPECT_CALL(*mock, AsyncGetOperation(_, _, _))
+      .WillOnce([](CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
                    google::longrunning::GetOperationRequest const& r) {
         EXPECT_EQ("test-operation-name", r.name());
         google::longrunning::Operation op;
@@ -685,7 +724,7 @@ TEST(DatabaseAdminClientTest, CreateBackupSuccess) {
         gcsa::Backup backup;
         backup.set_name("test-backup");
         op.mutable_response()->PackFrom(backup);
-        return make_status_or(op);
+        return make_ready_future(make_status_or(op));
       });
 
   auto conn = CreateTestingConnection(std::move(mock));
@@ -701,10 +740,6 @@ TEST(DatabaseAdminClientTest, CreateBackupSuccess) {
 /// @test Verify cancellation.
 TEST(DatabaseAdminClientTest, CreateBackupCancel) {
   auto mock = std::make_shared<MockDatabaseAdminStub>();
-  // Suppress a false leak.
-  // TODO(#4038): After we fix the issue #4038, we won't need to use
-  // `AllowLeak()` any more.
-  Mock::AllowLeak(mock.get());
   promise<void> p;
 
   EXPECT_CALL(*mock, CreateBackup(_, _))
@@ -714,24 +749,24 @@ TEST(DatabaseAdminClientTest, CreateBackupCancel) {
         op.set_done(false);
         return make_status_or(op);
       });
-  EXPECT_CALL(*mock, CancelOperation(_, _))
-      .WillOnce([](grpc::ClientContext&,
+  EXPECT_CALL(*mock, AsyncCancelOperation(_, _, _))
+      .WillOnce([](CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
                    google::longrunning::CancelOperationRequest const& r) {
         EXPECT_EQ("test-operation-name", r.name());
-        return google::cloud::Status();
+        return make_ready_future(google::cloud::Status());
       });
-  EXPECT_CALL(*mock, GetOperation(_, _))
-      .WillOnce([&p](grpc::ClientContext&,
+  EXPECT_CALL(*mock, AsyncGetOperation(_, _, _))
+      .WillOnce([&p](CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
                      google::longrunning::GetOperationRequest const& r) {
         EXPECT_EQ("test-operation-name", r.name());
         google::longrunning::Operation op;
         op.set_name(r.name());
         op.set_done(false);
-        // wait for `cancel` call in the main thread.
-        p.get_future().get();
-        return make_status_or(op);
+        // Complete only after the `cancel` call in the main thread.
+        return p.get_future().then(
+            [op](future<void>) { return make_status_or(op); });
       })
-      .WillOnce([](grpc::ClientContext&,
+      .WillOnce([](CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
                    google::longrunning::GetOperationRequest const& r) {
         EXPECT_EQ("test-operation-name", r.name());
         google::longrunning::Operation op;
@@ -740,7 +775,7 @@ TEST(DatabaseAdminClientTest, CreateBackupCancel) {
         gcsa::Backup backup;
         backup.set_name("test-backup");
         op.mutable_response()->PackFrom(backup);
-        return make_status_or(op);
+        return make_ready_future(make_status_or(op));
       });
 
   auto conn = CreateTestingConnection(std::move(mock));
@@ -14,6 +14,9 @@
 
 #include "google/cloud/spanner/instance_admin_connection.h"
 #include "google/cloud/spanner/instance.h"
+#include "google/cloud/background_threads.h"
+#include "google/cloud/connection_options.h"
+#include "google/cloud/internal/async_polling_loop.h"
 #include "google/cloud/internal/polling_loop.h"
 #include "google/cloud/internal/retry_loop.h"
 #include <chrono>
@@ -52,23 +55,30 @@ std::unique_ptr<PollingPolicy> DefaultInstanceAdminPollingPolicy() {
 
 class InstanceAdminConnectionImpl : public InstanceAdminConnection {
  public:
-  InstanceAdminConnectionImpl(std::shared_ptr<internal::InstanceAdminStub> stub,
-                              std::unique_ptr<RetryPolicy> retry_policy,
-                              std::unique_ptr<BackoffPolicy> backoff_policy,
-                              std::unique_ptr<PollingPolicy> polling_policy)
+  InstanceAdminConnectionImpl(
+      std::shared_ptr<internal::InstanceAdminStub> stub,
+      std::unique_ptr<BackgroundThreads> background_threads,
+      std::unique_ptr<RetryPolicy> retry_policy,
+      std::unique_ptr<BackoffPolicy> backoff_policy,
+      std::unique_ptr<PollingPolicy> polling_policy)
       : stub_(std::move(stub)),
         retry_policy_prototype_(std::move(retry_policy)),
         backoff_policy_prototype_(std::move(backoff_policy)),
-        polling_policy_prototype_(std::move(polling_policy)) {}
-
-  explicit InstanceAdminConnectionImpl(
-      std::shared_ptr<internal::InstanceAdminStub> stub)
-      : InstanceAdminConnectionImpl(std::move(stub),
-                                    DefaultInstanceAdminRetryPolicy(),
-                                    DefaultInstanceAdminBackoffPolicy(),
-                                    DefaultInstanceAdminPollingPolicy()) {}
-
-  ~InstanceAdminConnectionImpl() override = default;
+        polling_policy_prototype_(std::move(polling_policy)),
+        background_threads_(std::move(background_threads)) {}
+
+  InstanceAdminConnectionImpl(
+      std::shared_ptr<internal::InstanceAdminStub> stub,
+      std::unique_ptr<BackgroundThreads> background_threads)
+      : InstanceAdminConnectionImpl(
+            std::move(stub), std::move(background_threads),
+            DefaultInstanceAdminRetryPolicy(),
+            DefaultInstanceAdminBackoffPolicy(),
+            DefaultInstanceAdminPollingPolicy()) {}
+
+  // Stop polling any pending operations, otherwise releasing the background
+  // threads would block until their next polling timer expires.
+  ~InstanceAdminConnectionImpl() override { polling_loops_.Shutdown(); }
 
   StatusOr<gcsa::Instance> GetInstance(GetInstanceParams gip) override {
     gcsa::GetInstanceRequest request;
@@ -260,44 +270,35 @@ class InstanceAdminConnectionImpl : public InstanceAdminConnection {
   }
 
  private:
+  // Poll the operation using the completion queue timers, no thread blocks
+  // between polls. Cancelling the returned future asks the service to cancel
+  // the operation. Destroying the connection stops polling, and satisfies the
+  // returned future with a `kCancelled` error.
   future<StatusOr<gcsa::Instance>> AwaitCreateOrUpdateInstance(
       google::longrunning::Operation operation) {
-    promise<StatusOr<gcsa::Instance>> pr;
-    auto f = pr.get_future();
-
-    // TODO(#4038) - use the (implicit) completion queue to run this loop.
-    std::thread t(
-        [](std::shared_ptr<internal::InstanceAdminStub> stub,
-           google::longrunning::Operation operation,
-           std::unique_ptr<PollingPolicy> polling_policy,
-           google::cloud::promise<StatusOr<gcsa::Instance>> promise,
-           char const* location) mutable {
-          auto result = google::cloud::internal::PollingLoop<
-              google::cloud::internal::PollingLoopResponseExtractor<
-                  gcsa::Instance>>(
-              std::move(polling_policy),
-              [stub](grpc::ClientContext& context,
-                     google::longrunning::GetOperationRequest const& request) {
-                return stub->GetOperation(context, request);
-              },
-              std::move(operation), location);
-
-          // Drop our reference to stub; ideally we'd have std::moved into the
-          // lambda. Doing this also prevents a false leak from being reported
-          // when using googlemock.
-          stub.reset();
-          promise.set_value(std::move(result));
+    auto stub = stub_;
+    return google::cloud::internal::AsyncAwaitLongRunningOperation<
+        google::cloud::internal::PollingLoopResponseExtractor<gcsa::Instance>>(
+        background_threads_->cq(), std::move(operation),
+        [stub](google::cloud::CompletionQueue& cq,
+               std::unique_ptr<grpc::ClientContext> context,
+               google::longrunning::GetOperationRequest const& request) {
+          return stub->AsyncGetOperation(cq, std::move(context), request);
         },
-        stub_, std::move(operation), polling_policy_prototype_->clone(),
-        std::move(pr), __func__);
-    t.detach();
-
-    return f;
+        [stub](google::cloud::CompletionQueue& cq,
+               std::unique_ptr<grpc::ClientContext> context,
+               google::longrunning::CancelOperationRequest const& request) {
+          return stub->AsyncCancelOperation(cq, std::move(context), request);
+        },
+        polling_policy_prototype_->clone(), __func__, &polling_loops_);
   }
+
   std::shared_ptr<internal::InstanceAdminStub> stub_;
   std::unique_ptr<RetryPolicy const> retry_policy_prototype_;
   std::unique_ptr<BackoffPolicy const> backoff_policy_prototype_;
   std::unique_ptr<PollingPolicy const> polling_policy_prototype_;
+  std::unique_ptr<BackgroundThreads> background_threads_;
+  google::cloud::internal::AsyncPollingLoopGroup polling_loops_;
 };
 }  // namespace
 
@@ -313,18 +314,19 @@ std::shared_ptr<InstanceAdminConnection> MakeInstanceAdminConnection(
     ConnectionOptions const& options, std::unique_ptr<RetryPolicy> retry_policy,
     std::unique_ptr<BackoffPolicy> backoff_policy,
     std::unique_ptr<PollingPolicy> polling_policy) {
-  return internal::MakeInstanceAdminConnection(
+  return std::make_shared<InstanceAdminConnectionImpl>(
       internal::CreateDefaultInstanceAdminStub(options),
-      std::move(retry_policy), std::move(backoff_policy),
-      std::move(polling_policy));
+      options.background_threads_factory()(), std::move(retry_policy),
+      std::move(backoff_policy), std::move(polling_policy));
 }
 
 namespace internal {
 
 std::shared_ptr<InstanceAdminConnection> MakeInstanceAdminConnection(
     std::shared_ptr<internal::InstanceAdminStub> base_stub,
-    ConnectionOptions const&) {
-  return std::make_shared<InstanceAdminConnectionImpl>(std::move(base_stub));
+    ConnectionOptions const& options) {
+  return std::make_shared<InstanceAdminConnectionImpl>(
+      std::move(base_stub), options.background_threads_factory()());
 }
 
 std::shared_ptr<InstanceAdminConnection> MakeInstanceAdminConnection(
@@ -333,7 +335,9 @@ std::shared_ptr<InstanceAdminConnection> MakeInstanceAdminConnection(
     std::unique_ptr<BackoffPolicy> backoff_policy,
     std::unique_ptr<PollingPolicy> polling_policy) {
   return std::make_shared<InstanceAdminConnectionImpl>(
-      std::move(base_stub), std::move(retry_policy), std::move(backoff_policy),
+      std::move(base_stub),
+      google::cloud::internal::DefaultBackgroundThreads(1),
+      std::move(retry_policy), std::move(backoff_policy),
       std::move(polling_policy));
 }
 
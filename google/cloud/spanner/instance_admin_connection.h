@@ -209,6 +209,11 @@ class InstanceAdminConnection {
  *
  * @see `InstanceAdminConnection`
  *
+ * Long-running operations are polled using the connection's background
+ * threads. If the connection is destroyed before an operation completes, the
+ * future returned for it is satisfied with a `kCancelled` error. The operation
+ * itself is not cancelled, and continues to run in the service.
+ *
  * @param options (optional) configure the `InstanceAdminConnection` created by
  *     this function.
  */
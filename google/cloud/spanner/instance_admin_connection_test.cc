@@ -129,9 +129,10 @@ TEST(InstanceAdminClientTest, CreateInstanceSuccess) {
         op.set_done(false);
         return make_status_or(op);
       });
-  EXPECT_CALL(*mock, GetOperation(_, _))
+  EXPECT_CALL(*mock, AsyncGetOperation(_, _, _))
       .WillOnce(
-          [&expected_name](grpc::ClientContext&,
+          [&expected_name](CompletionQueue&,
+                           std::unique_ptr<grpc::ClientContext>,
                            google::longrunning::GetOperationRequest const& r) {
             EXPECT_EQ("test-operation-name", r.name());
             google::longrunning::Operation op;
@@ -140,7 +141,7 @@ TEST(InstanceAdminClientTest, CreateInstanceSuccess) {
             gcsa::Instance instance;
             instance.set_name(expected_name);
             op.mutable_response()->PackFrom(instance);
-            return make_status_or(op);
+            return make_ready_future(make_status_or(op));
           });
 
   auto conn = MakeLimitedRetryConnection(std::move(mock));
@@ -180,6 +181,45 @@ TEST(InstanceAdminClientTest, CreateInstanceError) {
   EXPECT_THAT(instance, StatusIs(StatusCode::kPermissionDenied));
 }
 
+/// @test Verify that destroying the connection stops polling operations.
+TEST(InstanceAdminClientTest, CreateInstanceDestroyConnectionWhilePolling) {
+  auto mock = std::make_shared<spanner_testing::MockInstanceAdminStub>();
+
+  EXPECT_CALL(*mock, CreateInstance(_, _))
+      .WillOnce([](grpc::ClientContext&, gcsa::CreateInstanceRequest const&) {
+        google::longrunning::Operation op;
+        op.set_name("test-operation-name");
+        op.set_done(false);
+        return make_status_or(op);
+      });
+  EXPECT_CALL(*mock, AsyncGetOperation(_, _, _)).Times(0);
+
+  // Wait much longer than any test should take before polling.
+  LimitedErrorCountRetryPolicy retry(/*maximum_failures=*/2);
+  ExponentialBackoffPolicy backoff(
+      /*initial_delay=*/std::chrono::microseconds(1),
+      /*maximum_delay=*/std::chrono::microseconds(1),
+      /*scaling=*/2.0);
+  GenericPollingPolicy<LimitedErrorCountRetryPolicy> polling(
+      retry, ExponentialBackoffPolicy(
+                 /*initial_delay=*/std::chrono::minutes(5),
+                 /*maximum_delay=*/std::chrono::minutes(5),
+                 /*scaling=*/2.0));
+  auto conn = internal::MakeInstanceAdminConnection(
+      mock, retry.clone(), backoff.clone(), polling.clone());
+  Instance in("test-project", "test-instance");
+  auto fut = conn->CreateInstance(
+      {CreateInstanceRequestBuilder(in, "test-instance-config").Build()});
+  EXPECT_EQ(std::future_status::timeout,
+            fut.wait_for(std::chrono::milliseconds(10)));
+
+  // This would block until the next poll if the timer was not cancelled.
+  conn.reset();
+  ASSERT_EQ(std::future_status::ready, fut.wait_for(std::chrono::seconds(0)));
+  auto instance = fut.get();
+  EXPECT_THAT(instance, StatusIs(StatusCode::kCancelled));
+}
+
 TEST(InstanceAdminClientTest, UpdateInstanceSuccess) {
   auto mock = std::make_shared<spanner_testing::MockInstanceAdminStub>();
   std::string expected_name = "projects/test-project/instances/test-instance";
@@ -194,9 +234,10 @@ TEST(InstanceAdminClientTest, UpdateInstanceSuccess) {
         op.set_done(false);
         return make_status_or(op);
       });
-  EXPECT_CALL(*mock, GetOperation(_, _))
+  EXPECT_CALL(*mock, AsyncGetOperation(_, _, _))
       .WillOnce(
-          [&expected_name](grpc::ClientContext&,
+          [&expected_name](CompletionQueue&,
+                           std::unique_ptr<grpc::ClientContext>,
                            google::longrunning::GetOperationRequest const& r) {
             EXPECT_EQ("test-operation-name", r.name());
             google::longrunning::Operation op;
@@ -205,7 +246,7 @@ TEST(InstanceAdminClientTest, UpdateInstanceSuccess) {
             gcsa::Instance instance;
             instance.set_name(expected_name);
             op.mutable_response()->PackFrom(instance);
-            return make_status_or(op);
+            return make_ready_future(make_status_or(op));
           });
 
   auto conn = MakeLimitedRetryConnection(std::move(mock));
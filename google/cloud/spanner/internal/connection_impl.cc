@@ -114,6 +114,8 @@ ConnectionImpl::ConnectionImpl(Database db,
     : db_(std::move(db)),
       retry_policy_prototype_(std::move(retry_policy)),
       backoff_policy_prototype_(std::move(backoff_policy)),
+      retry_budget_(options.retry_budget()),
+      backoff_sleeper_(options.backoff_sleeper()),
       background_threads_(options.background_threads_factory()()),
       session_pool_(MakeSessionPool(
           db_, std::move(stubs), std::move(session_pool_options),
@@ -374,7 +376,7 @@ StatusOr<spanner_proto::Transaction> ConnectionImpl::BeginTransaction(
               spanner_proto::BeginTransactionRequest const& request) {
         return stub->BeginTransaction(context, request);
       },
-      begin, func);
+      begin, func, retry_budget_, backoff_sleeper_);
   if (!response) {
     auto status = std::move(response).status();
     if (internal::IsSessionNotFound(status)) session->set_bad();
@@ -494,7 +496,7 @@ StatusOr<std::vector<ReadPartition>> ConnectionImpl::PartitionReadImpl(
                 spanner_proto::PartitionReadRequest const& request) {
           return stub->PartitionRead(context, request);
         },
-        request, __func__);
+        request, __func__, retry_budget_, backoff_sleeper_);
     if (s->has_begin()) {
       if (response.ok()) {
         if (!response->has_transaction()) {
@@ -678,9 +680,12 @@ StatusOr<ResultType> ConnectionImpl::CommonDmlImpl(
   auto stub = session_pool_->GetStub(*session);
   auto const& retry_policy = retry_policy_prototype_;
   auto const& backoff_policy = backoff_policy_prototype_;
+  auto const& retry_budget = retry_budget_;
+  auto const& backoff_sleeper = backoff_sleeper_;
 
   auto retry_resume_fn =
-      [function_name, stub, retry_policy, backoff_policy,
+      [function_name, stub, retry_policy, backoff_policy, retry_budget,
+       backoff_sleeper,
        session](spanner_proto::ExecuteSqlRequest& request) mutable
       -> StatusOr<std::unique_ptr<ResultSourceInterface>> {
     StatusOr<spanner_proto::ResultSet> response = RetryLoop(
@@ -690,7 +695,7 @@ StatusOr<ResultType> ConnectionImpl::CommonDmlImpl(
                spanner_proto::ExecuteSqlRequest const& request) {
           return stub->ExecuteSql(context, request);
         },
-        request, function_name);
+        request, function_name, retry_budget, backoff_sleeper);
     if (!response) {
       auto status = std::move(response).status();
       if (internal::IsSessionNotFound(status)) session->set_bad();
@@ -763,7 +768,7 @@ StatusOr<std::vector<QueryPartition>> ConnectionImpl::PartitionQueryImpl(
                 spanner_proto::PartitionQueryRequest const& request) {
           return stub->PartitionQuery(context, request);
         },
-        request, __func__);
+        request, __func__, retry_budget_, backoff_sleeper_);
     if (s->has_begin()) {
       if (response.ok()) {
         if (!response->has_transaction()) {
@@ -826,7 +831,7 @@ StatusOr<BatchDmlResult> ConnectionImpl::ExecuteBatchDmlImpl(
                 spanner_proto::ExecuteBatchDmlRequest const& request) {
           return stub->ExecuteBatchDml(context, request);
         },
-        request, __func__);
+        request, __func__, retry_budget_, backoff_sleeper_);
     if (s->has_begin()) {
       if (response.ok() && response->result_sets_size() > 0) {
         if (!response->result_sets(0).metadata().has_transaction()) {
@@ -933,7 +938,7 @@ StatusOr<CommitResult> ConnectionImpl::CommitImpl(
               spanner_proto::CommitRequest const& request) {
         return stub->Commit(context, request);
       },
-      request, __func__);
+      request, __func__, retry_budget_, backoff_sleeper_);
   if (!response) {
     auto status = std::move(response).status();
     if (internal::IsSessionNotFound(status)) session->set_bad();
@@ -981,7 +986,7 @@ Status ConnectionImpl::RollbackImpl(
               spanner_proto::RollbackRequest const& request) {
         return stub->Rollback(context, request);
       },
-      request, __func__);
+      request, __func__, retry_budget_, backoff_sleeper_);
   if (internal::IsSessionNotFound(status)) session->set_bad();
   return status;
 }
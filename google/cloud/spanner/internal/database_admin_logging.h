@@ -136,6 +136,16 @@ class DatabaseAdminLogging : public DatabaseAdminStub {
   Status CancelOperation(
       grpc::ClientContext& context,
       google::longrunning::CancelOperationRequest const& request) override;
+
+  future<StatusOr<google::longrunning::Operation>> AsyncGetOperation(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> context,
+      google::longrunning::GetOperationRequest const& request) override;
+
+  future<Status> AsyncCancelOperation(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> context,
+      google::longrunning::CancelOperationRequest const& request) override;
   //@}
 
  private:
@@ -18,6 +18,7 @@
 #include "google/cloud/log.h"
 #include "google/cloud/testing_util/assert_ok.h"
 #include "google/cloud/testing_util/capture_log_lines_backend.h"
+#include "absl/memory/memory.h"
 #include <gmock/gmock.h>
 
 namespace google {
@@ -336,6 +337,47 @@ TEST_F(DatabaseAdminLoggingTest, CancelOperation) {
   EXPECT_THAT(log_lines, Contains(HasSubstr(TransientError().message())));
 }
 
+TEST_F(DatabaseAdminLoggingTest, AsyncGetOperation) {
+  EXPECT_CALL(*mock_, AsyncGetOperation(_, _, _))
+      .WillOnce([](CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
+                   google::longrunning::GetOperationRequest const&) {
+        return make_ready_future(
+            StatusOr<google::longrunning::Operation>(TransientError()));
+      });
+
+  DatabaseAdminLogging stub(mock_, TracingOptions{});
+
+  CompletionQueue cq;
+  auto status =
+      stub.AsyncGetOperation(cq, absl::make_unique<grpc::ClientContext>(),
+                             google::longrunning::GetOperationRequest{});
+  EXPECT_EQ(TransientError(), status.get().status());
+
+  auto const log_lines = ClearLogLines();
+  EXPECT_THAT(log_lines, Contains(HasSubstr("AsyncGetOperation")));
+  EXPECT_THAT(log_lines, Contains(HasSubstr(TransientError().message())));
+}
+
+TEST_F(DatabaseAdminLoggingTest, AsyncCancelOperation) {
+  EXPECT_CALL(*mock_, AsyncCancelOperation(_, _, _))
+      .WillOnce([](CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
+                   google::longrunning::CancelOperationRequest const&) {
+        return make_ready_future(TransientError());
+      });
+
+  DatabaseAdminLogging stub(mock_, TracingOptions{});
+
+  CompletionQueue cq;
+  auto status =
+      stub.AsyncCancelOperation(cq, absl::make_unique<grpc::ClientContext>(),
+                                google::longrunning::CancelOperationRequest{});
+  EXPECT_EQ(TransientError(), status.get());
+
+  auto const log_lines = ClearLogLines();
+  EXPECT_THAT(log_lines, Contains(HasSubstr("AsyncCancelOperation")));
+  EXPECT_THAT(log_lines, Contains(HasSubstr(TransientError().message())));
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace SPANNER_CLIENT_NS
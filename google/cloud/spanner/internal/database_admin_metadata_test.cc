@@ -17,6 +17,7 @@
 #include "google/cloud/internal/api_client_header.h"
 #include "google/cloud/testing_util/assert_ok.h"
 #include "google/cloud/testing_util/validate_metadata.h"
+#include "absl/memory/memory.h"
 #include <gmock/gmock.h>
 
 namespace google {
@@ -428,6 +429,47 @@ TEST_F(DatabaseAdminMetadataTest, CancelOperation) {
   EXPECT_EQ(TransientError(), status);
 }
 
+TEST_F(DatabaseAdminMetadataTest, AsyncGetOperation) {
+  EXPECT_CALL(*mock_, AsyncGetOperation(_, _, _))
+      .WillOnce([this](CompletionQueue&,
+                       std::unique_ptr<grpc::ClientContext> context,
+                       google::longrunning::GetOperationRequest const&) {
+        EXPECT_STATUS_OK(IsContextMDValid(
+            *context, "google.longrunning.Operations.GetOperation",
+            expected_api_client_header_));
+        return make_ready_future(
+            StatusOr<google::longrunning::Operation>(TransientError()));
+      });
+
+  DatabaseAdminMetadata stub(mock_);
+  CompletionQueue cq;
+  google::longrunning::GetOperationRequest request;
+  request.set_name("operations/fake-operation-name");
+  auto status = stub.AsyncGetOperation(
+      cq, absl::make_unique<grpc::ClientContext>(), request);
+  EXPECT_EQ(TransientError(), status.get().status());
+}
+
+TEST_F(DatabaseAdminMetadataTest, AsyncCancelOperation) {
+  EXPECT_CALL(*mock_, AsyncCancelOperation(_, _, _))
+      .WillOnce([this](CompletionQueue&,
+                       std::unique_ptr<grpc::ClientContext> context,
+                       google::longrunning::CancelOperationRequest const&) {
+        EXPECT_STATUS_OK(IsContextMDValid(
+            *context, "google.longrunning.Operations.CancelOperation",
+            expected_api_client_header_));
+        return make_ready_future(TransientError());
+      });
+
+  DatabaseAdminMetadata stub(mock_);
+  CompletionQueue cq;
+  google::longrunning::CancelOperationRequest request;
+  request.set_name("operations/fake-operation-name");
+  auto status = stub.AsyncCancelOperation(
+      cq, absl::make_unique<grpc::ClientContext>(), request);
+  EXPECT_EQ(TransientError(), status.get());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace SPANNER_CLIENT_NS
@@ -17,6 +17,7 @@
 
 #include "google/cloud/spanner/connection_options.h"
 #include "google/cloud/spanner/version.h"
+#include "google/cloud/completion_queue.h"
 #include "google/cloud/future.h"
 #include "google/cloud/status_or.h"
 #include <google/spanner/admin/database/v1/spanner_database_admin.grpc.pb.h>
@@ -140,6 +141,18 @@ class DatabaseAdminStub {
   virtual Status CancelOperation(
       grpc::ClientContext& client_context,
       google::longrunning::CancelOperationRequest const& request) = 0;
+
+  /// Poll a long-running operation, without blocking.
+  virtual future<StatusOr<google::longrunning::Operation>> AsyncGetOperation(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> client_context,
+      google::longrunning::GetOperationRequest const& request) = 0;
+
+  /// Cancel a long-running operation, without blocking.
+  virtual future<Status> AsyncCancelOperation(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> client_context,
+      google::longrunning::CancelOperationRequest const& request) = 0;
 };
 
 /**
@@ -167,6 +167,36 @@ class DefaultInstanceAdminStub : public InstanceAdminStub {
     return response;
   }
 
+  future<StatusOr<google::longrunning::Operation>> AsyncGetOperation(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> client_context,
+      google::longrunning::GetOperationRequest const& request) override {
+    return cq.MakeUnaryRpc(
+        [this](grpc::ClientContext* context,
+               google::longrunning::GetOperationRequest const& request,
+               grpc::CompletionQueue* cq) {
+          return operations_->AsyncGetOperation(context, request, cq);
+        },
+        request, std::move(client_context));
+  }
+
+  future<Status> AsyncCancelOperation(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> client_context,
+      google::longrunning::CancelOperationRequest const& request) override {
+    return cq
+        .MakeUnaryRpc(
+            [this](grpc::ClientContext* context,
+                   google::longrunning::CancelOperationRequest const& request,
+                   grpc::CompletionQueue* cq) {
+              return operations_->AsyncCancelOperation(context, request, cq);
+            },
+            request, std::move(client_context))
+        .then([](future<StatusOr<google::protobuf::Empty>> f) {
+          return f.get().status();
+        });
+  }
+
  private:
   std::unique_ptr<gcsa::InstanceAdmin::Stub> instance_admin_;
   std::unique_ptr<google::longrunning::Operations::Stub> operations_;
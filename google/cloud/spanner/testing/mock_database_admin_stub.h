@@ -131,6 +131,16 @@ class MockDatabaseAdminStub
   MOCK_METHOD2(CancelOperation,
                Status(grpc::ClientContext&,
                       google::longrunning::CancelOperationRequest const&));
+
+  MOCK_METHOD3(AsyncGetOperation,
+               future<StatusOr<google::longrunning::Operation>>(
+                   CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
+                   google::longrunning::GetOperationRequest const&));
+
+  MOCK_METHOD3(AsyncCancelOperation,
+               future<Status>(
+                   CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
+                   google::longrunning::CancelOperationRequest const&));
 };
 
 }  // namespace SPANNER_CLIENT_NS
@@ -76,6 +76,14 @@ class MockInstanceAdminStub
                StatusOr<google::longrunning::Operation>(
                    grpc::ClientContext&,
                    google::longrunning::GetOperationRequest const&));
+  MOCK_METHOD3(AsyncGetOperation,
+               future<StatusOr<google::longrunning::Operation>>(
+                   CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
+                   google::longrunning::GetOperationRequest const&));
+  MOCK_METHOD3(AsyncCancelOperation,
+               future<Status>(
+                   CompletionQueue&, std::unique_ptr<grpc::ClientContext>,
+                   google::longrunning::CancelOperationRequest const&));
 };
 
 }  // namespace SPANNER_CLIENT_NS
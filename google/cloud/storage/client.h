@@ -162,6 +162,13 @@ class ResumableParallelUploadState;
  * class. The documentation for the constructors show examples of this in
  * action.
  *
+ * The application can also limit the retries across all the requests made by
+ * one or more clients, by passing the same
+ * `std::shared_ptr<google::cloud::RetryBudget>` to their constructors.
+ * Applications running on a cooperative scheduler can pass a
+ * `google::cloud::BackoffSleeper` to yield to the scheduler, instead of
+ * blocking the thread, while waiting between retries.
+ *
  * @see https://cloud.google.com/storage/ for an overview of GCS.
  *
  * @see https://cloud.google.com/storage/docs/key-terms for an introduction of
@@ -19,7 +19,6 @@
 #include "google/cloud/internal/retry_policy.h"
 #include "absl/memory/memory.h"
 #include <sstream>
-#include <thread>
 
 // Define the defaults using a pre-processor macro, this allows the application
 // developers to change the defaults for their application by compiling with
@@ -62,6 +61,9 @@ using ::google::cloud::storage::internal::raw_client_wrapper_utils::Signature;
  * @param function the pointer to the member function to call.
  * @param request an initialized request parameter for the call.
  * @param error_message include this message in any exception or error log.
+ * @param budget if set, limits the retries across all the requests
+ *     sharing it.
+ * @param sleeper waits for the backoff period between attempts.
  * @return the result from making the call;
  * @throw std::exception with a description of the last error.
  */
@@ -70,7 +72,8 @@ typename Signature<MemberFunction>::ReturnType MakeCall(
     RetryPolicy& retry_policy, BackoffPolicy& backoff_policy,
     Idempotency idempotency, RawClient& client, MemberFunction function,
     typename Signature<MemberFunction>::RequestType const& request,
-    char const* error_message) {
+    char const* error_message, std::shared_ptr<RetryBudget> const& budget,
+    BackoffSleeper const& sleeper) {
   Status last_status(StatusCode::kDeadlineExceeded,
                      "Retry policy exhausted before first attempt was made.");
   auto error = [&last_status](std::string const& msg) {
@@ -80,6 +83,7 @@ typename Signature<MemberFunction>::ReturnType MakeCall(
   while (!retry_policy.IsExhausted()) {
     auto result = (client.*function)(request);
     if (result.ok()) {
+      if (budget) budget->OnSuccess();
       return result;
     }
     last_status = std::move(result).status();
@@ -101,8 +105,13 @@ typename Signature<MemberFunction>::ReturnType MakeCall(
       // Exit the loop immediately instead of sleeping before trying again.
       break;
     }
-    auto delay = backoff_policy.OnCompletion();
-    std::this_thread::sleep_for(delay);
+    if (budget && !budget->TryRetry()) {
+      std::ostringstream os;
+      os << "Retry budget exhausted in " << error_message << ": "
+         << last_status;
+      return error(std::move(os).str());
+    }
+    sleeper(backoff_policy.OnCompletion());
   }
   std::ostringstream os;
   os << "Retry policy exhausted in " << error_message << ": " << last_status;
@@ -121,6 +130,7 @@ RetryClient::RetryClient(std::shared_ptr<RawClient> client, DefaultPolicies)
                                STORAGE_CLIENT_DEFAULT_BACKOFF_SCALING)
           .clone();
   idempotency_policy_ = AlwaysRetryIdempotencyPolicy().clone();
+  backoff_sleeper_ = DefaultBackoffSleeper();
 }
 
 ClientOptions const& RetryClient::client_options() const {
@@ -135,7 +145,8 @@ StatusOr<ListBucketsResponse> RetryClient::ListBuckets(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::ListBuckets, request, __func__);
+                  &RawClient::ListBuckets, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<BucketMetadata> RetryClient::CreateBucket(
@@ -146,7 +157,8 @@ StatusOr<BucketMetadata> RetryClient::CreateBucket(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::CreateBucket, request, __func__);
+                  &RawClient::CreateBucket, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<BucketMetadata> RetryClient::GetBucketMetadata(
@@ -157,7 +169,8 @@ StatusOr<BucketMetadata> RetryClient::GetBucketMetadata(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::GetBucketMetadata, request, __func__);
+                  &RawClient::GetBucketMetadata, request, __func__,
+                  retry_budget_, backoff_sleeper_);
 }
 
 StatusOr<EmptyResponse> RetryClient::DeleteBucket(
@@ -168,7 +181,8 @@ StatusOr<EmptyResponse> RetryClient::DeleteBucket(
                          ? Idempotency::kIdempotent
                          : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::DeleteBucket, request, __func__);
+                  &RawClient::DeleteBucket, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<BucketMetadata> RetryClient::UpdateBucket(
@@ -179,7 +193,8 @@ StatusOr<BucketMetadata> RetryClient::UpdateBucket(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::UpdateBucket, request, __func__);
+                  &RawClient::UpdateBucket, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<BucketMetadata> RetryClient::PatchBucket(
@@ -190,7 +205,8 @@ StatusOr<BucketMetadata> RetryClient::PatchBucket(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::PatchBucket, request, __func__);
+                  &RawClient::PatchBucket, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<IamPolicy> RetryClient::GetBucketIamPolicy(
@@ -201,7 +217,8 @@ StatusOr<IamPolicy> RetryClient::GetBucketIamPolicy(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::GetBucketIamPolicy, request, __func__);
+                  &RawClient::GetBucketIamPolicy, request, __func__,
+                  retry_budget_, backoff_sleeper_);
 }
 
 StatusOr<NativeIamPolicy> RetryClient::GetNativeBucketIamPolicy(
@@ -212,7 +229,8 @@ StatusOr<NativeIamPolicy> RetryClient::GetNativeBucketIamPolicy(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::GetNativeBucketIamPolicy, request, __func__);
+                  &RawClient::GetNativeBucketIamPolicy, request, __func__,
+                  retry_budget_, backoff_sleeper_);
 }
 
 StatusOr<IamPolicy> RetryClient::SetBucketIamPolicy(
@@ -223,7 +241,8 @@ StatusOr<IamPolicy> RetryClient::SetBucketIamPolicy(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::SetBucketIamPolicy, request, __func__);
+                  &RawClient::SetBucketIamPolicy, request, __func__,
+                  retry_budget_, backoff_sleeper_);
 }
 
 StatusOr<NativeIamPolicy> RetryClient::SetNativeBucketIamPolicy(
@@ -234,7 +253,8 @@ StatusOr<NativeIamPolicy> RetryClient::SetNativeBucketIamPolicy(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::SetNativeBucketIamPolicy, request, __func__);
+                  &RawClient::SetNativeBucketIamPolicy, request, __func__,
+                  retry_budget_, backoff_sleeper_);
 }
 
 StatusOr<TestBucketIamPermissionsResponse>
@@ -246,7 +266,8 @@ RetryClient::TestBucketIamPermissions(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::TestBucketIamPermissions, request, __func__);
+                  &RawClient::TestBucketIamPermissions, request, __func__,
+                  retry_budget_, backoff_sleeper_);
 }
 
 StatusOr<BucketMetadata> RetryClient::LockBucketRetentionPolicy(
@@ -257,7 +278,8 @@ StatusOr<BucketMetadata> RetryClient::LockBucketRetentionPolicy(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::LockBucketRetentionPolicy, request, __func__);
+                  &RawClient::LockBucketRetentionPolicy, request, __func__,
+                  retry_budget_, backoff_sleeper_);
 }
 
 StatusOr<ObjectMetadata> RetryClient::InsertObjectMedia(
@@ -268,7 +290,8 @@ StatusOr<ObjectMetadata> RetryClient::InsertObjectMedia(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::InsertObjectMedia, request, __func__);
+                  &RawClient::InsertObjectMedia, request, __func__,
+                  retry_budget_, backoff_sleeper_);
 }
 
 StatusOr<ObjectMetadata> RetryClient::CopyObject(
@@ -279,7 +302,8 @@ StatusOr<ObjectMetadata> RetryClient::CopyObject(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::CopyObject, request, __func__);
+                  &RawClient::CopyObject, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<ObjectMetadata> RetryClient::GetObjectMetadata(
@@ -290,7 +314,8 @@ StatusOr<ObjectMetadata> RetryClient::GetObjectMetadata(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::GetObjectMetadata, request, __func__);
+                  &RawClient::GetObjectMetadata, request, __func__,
+                  retry_budget_, backoff_sleeper_);
 }
 
 StatusOr<std::unique_ptr<ObjectReadSource>> RetryClient::ReadObjectNotWrapped(
@@ -300,7 +325,8 @@ StatusOr<std::unique_ptr<ObjectReadSource>> RetryClient::ReadObjectNotWrapped(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(retry_policy, backoff_policy, idempotency, *client_,
-                  &RawClient::ReadObject, request, __func__);
+                  &RawClient::ReadObject, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<std::unique_ptr<ObjectReadSource>> RetryClient::ReadObject(
@@ -325,7 +351,8 @@ StatusOr<ListObjectsResponse> RetryClient::ListObjects(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::ListObjects, request, __func__);
+                  &RawClient::ListObjects, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<EmptyResponse> RetryClient::DeleteObject(
@@ -336,7 +363,8 @@ StatusOr<EmptyResponse> RetryClient::DeleteObject(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::DeleteObject, request, __func__);
+                  &RawClient::DeleteObject, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<ObjectMetadata> RetryClient::UpdateObject(
@@ -347,7 +375,8 @@ StatusOr<ObjectMetadata> RetryClient::UpdateObject(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::UpdateObject, request, __func__);
+                  &RawClient::UpdateObject, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<ObjectMetadata> RetryClient::PatchObject(
@@ -358,7 +387,8 @@ StatusOr<ObjectMetadata> RetryClient::PatchObject(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::PatchObject, request, __func__);
+                  &RawClient::PatchObject, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<ObjectMetadata> RetryClient::ComposeObject(
@@ -369,7 +399,8 @@ StatusOr<ObjectMetadata> RetryClient::ComposeObject(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::ComposeObject, request, __func__);
+                  &RawClient::ComposeObject, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<RewriteObjectResponse> RetryClient::RewriteObject(
@@ -380,7 +411,8 @@ StatusOr<RewriteObjectResponse> RetryClient::RewriteObject(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::RewriteObject, request, __func__);
+                  &RawClient::RewriteObject, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<std::unique_ptr<ResumableUploadSession>>
@@ -391,7 +423,8 @@ RetryClient::CreateResumableSession(ResumableUploadRequest const& request) {
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   auto result = MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                         &RawClient::CreateResumableSession, request, __func__);
+                         &RawClient::CreateResumableSession, request, __func__,
+                         retry_budget_, backoff_sleeper_);
   if (!result.ok()) {
     return result;
   }
@@ -399,7 +432,7 @@ RetryClient::CreateResumableSession(ResumableUploadRequest const& request) {
   return std::unique_ptr<ResumableUploadSession>(
       absl::make_unique<RetryResumableUploadSession>(
           std::move(result).value(), std::move(retry_policy),
-          std::move(backoff_policy)));
+          std::move(backoff_policy), backoff_sleeper_));
 }
 
 StatusOr<std::unique_ptr<ResumableUploadSession>>
@@ -408,7 +441,7 @@ RetryClient::RestoreResumableSession(std::string const& request) {
   auto backoff_policy = backoff_policy_prototype_->clone();
   return MakeCall(*retry_policy, *backoff_policy, Idempotency::kIdempotent,
                   *client_, &RawClient::RestoreResumableSession, request,
-                  __func__);
+                  __func__, retry_budget_, backoff_sleeper_);
 }
 
 StatusOr<EmptyResponse> RetryClient::DeleteResumableUpload(
@@ -417,7 +450,7 @@ StatusOr<EmptyResponse> RetryClient::DeleteResumableUpload(
   auto backoff_policy = backoff_policy_prototype_->clone();
   return MakeCall(*retry_policy, *backoff_policy, Idempotency::kIdempotent,
                   *client_, &RawClient::DeleteResumableUpload, request,
-                  __func__);
+                  __func__, retry_budget_, backoff_sleeper_);
 }
 
 StatusOr<ListBucketAclResponse> RetryClient::ListBucketAcl(
@@ -428,7 +461,8 @@ StatusOr<ListBucketAclResponse> RetryClient::ListBucketAcl(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::ListBucketAcl, request, __func__);
+                  &RawClient::ListBucketAcl, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<BucketAccessControl> RetryClient::GetBucketAcl(
@@ -439,7 +473,8 @@ StatusOr<BucketAccessControl> RetryClient::GetBucketAcl(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::GetBucketAcl, request, __func__);
+                  &RawClient::GetBucketAcl, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<BucketAccessControl> RetryClient::CreateBucketAcl(
@@ -450,7 +485,8 @@ StatusOr<BucketAccessControl> RetryClient::CreateBucketAcl(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::CreateBucketAcl, request, __func__);
+                  &RawClient::CreateBucketAcl, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<EmptyResponse> RetryClient::DeleteBucketAcl(
@@ -461,7 +497,8 @@ StatusOr<EmptyResponse> RetryClient::DeleteBucketAcl(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::DeleteBucketAcl, request, __func__);
+                  &RawClient::DeleteBucketAcl, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<ListObjectAclResponse> RetryClient::ListObjectAcl(
@@ -472,7 +509,8 @@ StatusOr<ListObjectAclResponse> RetryClient::ListObjectAcl(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::ListObjectAcl, request, __func__);
+                  &RawClient::ListObjectAcl, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<BucketAccessControl> RetryClient::UpdateBucketAcl(
@@ -483,7 +521,8 @@ StatusOr<BucketAccessControl> RetryClient::UpdateBucketAcl(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::UpdateBucketAcl, request, __func__);
+                  &RawClient::UpdateBucketAcl, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<BucketAccessControl> RetryClient::PatchBucketAcl(
@@ -494,7 +533,8 @@ StatusOr<BucketAccessControl> RetryClient::PatchBucketAcl(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::PatchBucketAcl, request, __func__);
+                  &RawClient::PatchBucketAcl, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<ObjectAccessControl> RetryClient::CreateObjectAcl(
@@ -505,7 +545,8 @@ StatusOr<ObjectAccessControl> RetryClient::CreateObjectAcl(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::CreateObjectAcl, request, __func__);
+                  &RawClient::CreateObjectAcl, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<EmptyResponse> RetryClient::DeleteObjectAcl(
@@ -516,7 +557,8 @@ StatusOr<EmptyResponse> RetryClient::DeleteObjectAcl(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::DeleteObjectAcl, request, __func__);
+                  &RawClient::DeleteObjectAcl, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<ObjectAccessControl> RetryClient::GetObjectAcl(
@@ -527,7 +569,8 @@ StatusOr<ObjectAccessControl> RetryClient::GetObjectAcl(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::GetObjectAcl, request, __func__);
+                  &RawClient::GetObjectAcl, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<ObjectAccessControl> RetryClient::UpdateObjectAcl(
@@ -538,7 +581,8 @@ StatusOr<ObjectAccessControl> RetryClient::UpdateObjectAcl(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::UpdateObjectAcl, request, __func__);
+                  &RawClient::UpdateObjectAcl, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<ObjectAccessControl> RetryClient::PatchObjectAcl(
@@ -549,7 +593,8 @@ StatusOr<ObjectAccessControl> RetryClient::PatchObjectAcl(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::PatchObjectAcl, request, __func__);
+                  &RawClient::PatchObjectAcl, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<ListDefaultObjectAclResponse> RetryClient::ListDefaultObjectAcl(
@@ -560,7 +605,8 @@ StatusOr<ListDefaultObjectAclResponse> RetryClient::ListDefaultObjectAcl(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::ListDefaultObjectAcl, request, __func__);
+                  &RawClient::ListDefaultObjectAcl, request, __func__,
+                  retry_budget_, backoff_sleeper_);
 }
 
 StatusOr<ObjectAccessControl> RetryClient::CreateDefaultObjectAcl(
@@ -571,7 +617,8 @@ StatusOr<ObjectAccessControl> RetryClient::CreateDefaultObjectAcl(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::CreateDefaultObjectAcl, request, __func__);
+                  &RawClient::CreateDefaultObjectAcl, request, __func__,
+                  retry_budget_, backoff_sleeper_);
 }
 
 StatusOr<EmptyResponse> RetryClient::DeleteDefaultObjectAcl(
@@ -582,7 +629,8 @@ StatusOr<EmptyResponse> RetryClient::DeleteDefaultObjectAcl(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::DeleteDefaultObjectAcl, request, __func__);
+                  &RawClient::DeleteDefaultObjectAcl, request, __func__,
+                  retry_budget_, backoff_sleeper_);
 }
 
 StatusOr<ObjectAccessControl> RetryClient::GetDefaultObjectAcl(
@@ -593,7 +641,8 @@ StatusOr<ObjectAccessControl> RetryClient::GetDefaultObjectAcl(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::GetDefaultObjectAcl, request, __func__);
+                  &RawClient::GetDefaultObjectAcl, request, __func__,
+                  retry_budget_, backoff_sleeper_);
 }
 
 StatusOr<ObjectAccessControl> RetryClient::UpdateDefaultObjectAcl(
@@ -604,7 +653,8 @@ StatusOr<ObjectAccessControl> RetryClient::UpdateDefaultObjectAcl(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::UpdateDefaultObjectAcl, request, __func__);
+                  &RawClient::UpdateDefaultObjectAcl, request, __func__,
+                  retry_budget_, backoff_sleeper_);
 }
 
 StatusOr<ObjectAccessControl> RetryClient::PatchDefaultObjectAcl(
@@ -615,7 +665,8 @@ StatusOr<ObjectAccessControl> RetryClient::PatchDefaultObjectAcl(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::PatchDefaultObjectAcl, request, __func__);
+                  &RawClient::PatchDefaultObjectAcl, request, __func__,
+                  retry_budget_, backoff_sleeper_);
 }
 
 StatusOr<ServiceAccount> RetryClient::GetServiceAccount(
@@ -626,7 +677,8 @@ StatusOr<ServiceAccount> RetryClient::GetServiceAccount(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::GetServiceAccount, request, __func__);
+                  &RawClient::GetServiceAccount, request, __func__,
+                  retry_budget_, backoff_sleeper_);
 }
 
 StatusOr<ListHmacKeysResponse> RetryClient::ListHmacKeys(
@@ -637,7 +689,8 @@ StatusOr<ListHmacKeysResponse> RetryClient::ListHmacKeys(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::ListHmacKeys, request, __func__);
+                  &RawClient::ListHmacKeys, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<CreateHmacKeyResponse> RetryClient::CreateHmacKey(
@@ -648,7 +701,8 @@ StatusOr<CreateHmacKeyResponse> RetryClient::CreateHmacKey(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::CreateHmacKey, request, __func__);
+                  &RawClient::CreateHmacKey, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<EmptyResponse> RetryClient::DeleteHmacKey(
@@ -659,7 +713,8 @@ StatusOr<EmptyResponse> RetryClient::DeleteHmacKey(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::DeleteHmacKey, request, __func__);
+                  &RawClient::DeleteHmacKey, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<HmacKeyMetadata> RetryClient::GetHmacKey(
@@ -670,7 +725,8 @@ StatusOr<HmacKeyMetadata> RetryClient::GetHmacKey(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::GetHmacKey, request, __func__);
+                  &RawClient::GetHmacKey, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<HmacKeyMetadata> RetryClient::UpdateHmacKey(
@@ -681,7 +737,8 @@ StatusOr<HmacKeyMetadata> RetryClient::UpdateHmacKey(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::UpdateHmacKey, request, __func__);
+                  &RawClient::UpdateHmacKey, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<SignBlobResponse> RetryClient::SignBlob(
@@ -692,7 +749,8 @@ StatusOr<SignBlobResponse> RetryClient::SignBlob(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::SignBlob, request, __func__);
+                  &RawClient::SignBlob, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<ListNotificationsResponse> RetryClient::ListNotifications(
@@ -703,7 +761,8 @@ StatusOr<ListNotificationsResponse> RetryClient::ListNotifications(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::ListNotifications, request, __func__);
+                  &RawClient::ListNotifications, request, __func__,
+                  retry_budget_, backoff_sleeper_);
 }
 
 StatusOr<NotificationMetadata> RetryClient::CreateNotification(
@@ -714,7 +773,8 @@ StatusOr<NotificationMetadata> RetryClient::CreateNotification(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::CreateNotification, request, __func__);
+                  &RawClient::CreateNotification, request, __func__,
+                  retry_budget_, backoff_sleeper_);
 }
 
 StatusOr<NotificationMetadata> RetryClient::GetNotification(
@@ -725,7 +785,8 @@ StatusOr<NotificationMetadata> RetryClient::GetNotification(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::GetNotification, request, __func__);
+                  &RawClient::GetNotification, request, __func__, retry_budget_,
+                  backoff_sleeper_);
 }
 
 StatusOr<EmptyResponse> RetryClient::DeleteNotification(
@@ -736,7 +797,8 @@ StatusOr<EmptyResponse> RetryClient::DeleteNotification(
                                ? Idempotency::kIdempotent
                                : Idempotency::kNonIdempotent;
   return MakeCall(*retry_policy, *backoff_policy, idempotency, *client_,
-                  &RawClient::DeleteNotification, request, __func__);
+                  &RawClient::DeleteNotification, request, __func__,
+                  retry_budget_, backoff_sleeper_);
 }
 
 }  // namespace internal
@@ -20,6 +20,8 @@
 #include "google/cloud/storage/internal/resumable_upload_session.h"
 #include "google/cloud/storage/retry_policy.h"
 #include "google/cloud/storage/version.h"
+#include "google/cloud/backoff_sleeper.h"
+#include "google/cloud/retry_budget.h"
 
 namespace google {
 namespace cloud {
@@ -164,6 +166,9 @@ class RetryClient : public RawClient,
 
   std::shared_ptr<RawClient> client() const { return client_; }
 
+  /// The function used to wait between retries.
+  BackoffSleeper const& backoff_sleeper() const { return backoff_sleeper_; }
+
  private:
   void Apply(RetryPolicy const& policy) {
     retry_policy_prototype_ = policy.clone();
@@ -177,6 +182,15 @@ class RetryClient : public RawClient,
     idempotency_policy_ = policy.clone();
   }
 
+  void Apply(std::shared_ptr<RetryBudget> budget) {
+    retry_budget_ = std::move(budget);
+  }
+
+  void Apply(BackoffSleeper sleeper) {
+    if (!sleeper) sleeper = DefaultBackoffSleeper();
+    backoff_sleeper_ = std::move(sleeper);
+  }
+
   void ApplyPolicies() {}
 
   template <typename P, typename... Policies>
@@ -189,6 +203,8 @@ class RetryClient : public RawClient,
   std::shared_ptr<RetryPolicy const> retry_policy_prototype_;
   std::shared_ptr<BackoffPolicy const> backoff_policy_prototype_;
   std::shared_ptr<IdempotencyPolicy const> idempotency_policy_;
+  std::shared_ptr<RetryBudget> retry_budget_;
+  BackoffSleeper backoff_sleeper_;
 };
 
 }  // namespace internal
@@ -16,8 +16,10 @@
 #include "google/cloud/storage/testing/canonical_errors.h"
 #include "google/cloud/storage/testing/mock_client.h"
 #include "google/cloud/testing_util/chrono_literals.h"
+#include "google/cloud/testing_util/assert_ok.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include <gmock/gmock.h>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -107,6 +109,54 @@ TEST_F(RetryClientTest, ExpiredRetryPolicy) {
                HasSubstr("Retry policy exhausted before first attempt")));
 }
 
+/// @test Verify that the retry loop waits using the `BackoffSleeper`.
+TEST_F(RetryClientTest, UsesBackoffSleeper) {
+  std::vector<std::chrono::milliseconds> sleeps;
+  RetryClient client(std::shared_ptr<internal::RawClient>(mock_),
+                     LimitedErrorCountRetryPolicy(3),
+                     ExponentialBackoffPolicy(1_us, 2_us, 2),
+                     BackoffSleeper([&sleeps](std::chrono::milliseconds p) {
+                       sleeps.push_back(p);
+                     }));
+
+  EXPECT_CALL(*mock_, GetObjectMetadata(_))
+      .WillOnce(Return(StatusOr<ObjectMetadata>(TransientError())))
+      .WillOnce(Return(StatusOr<ObjectMetadata>(TransientError())))
+      .WillOnce(Return(make_status_or(ObjectMetadata{})));
+
+  StatusOr<ObjectMetadata> result = client.GetObjectMetadata(
+      GetObjectMetadataRequest("test-bucket", "test-object"));
+  EXPECT_STATUS_OK(result);
+  EXPECT_EQ(2, sleeps.size());
+}
+
+/// @test Verify that the retry budget limits the retries across requests.
+TEST_F(RetryClientTest, RetryBudgetExhausted) {
+  auto budget = std::make_shared<RetryBudget>(0.0, 1.0);
+  RetryClient client(std::shared_ptr<internal::RawClient>(mock_),
+                     LimitedErrorCountRetryPolicy(3),
+                     // Make the tests faster.
+                     ExponentialBackoffPolicy(1_us, 2_us, 2), budget);
+
+  EXPECT_CALL(*mock_, GetObjectMetadata(_))
+      .Times(3)
+      .WillRepeatedly(Return(StatusOr<ObjectMetadata>(TransientError())));
+
+  // The first request consumes the only retry in the budget.
+  StatusOr<ObjectMetadata> result = client.GetObjectMetadata(
+      GetObjectMetadataRequest("test-bucket", "test-object"));
+  EXPECT_THAT(result, StatusIs(TransientError().code(),
+                               HasSubstr("Retry budget exhausted")));
+
+  // The second request fails without retrying.
+  result = client.GetObjectMetadata(
+      GetObjectMetadataRequest("test-bucket", "test-object"));
+  EXPECT_THAT(result, StatusIs(TransientError().code(),
+                               HasSubstr("Retry budget exhausted")));
+  EXPECT_EQ(1, budget->permitted_retries());
+  EXPECT_EQ(2, budget->throttled_retries());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
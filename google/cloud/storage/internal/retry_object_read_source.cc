@@ -14,7 +14,6 @@
 
 #include "google/cloud/storage/internal/retry_object_read_source.h"
 #include "google/cloud/log.h"
-#include <thread>
 
 namespace google {
 namespace cloud {
@@ -84,7 +83,7 @@ StatusOr<ReadSourceResult> RetryObjectReadSource::Read(char* buf,
   auto retry_policy = retry_policy_prototype_->clone();
   int counter = 0;
   for (; !result && retry_policy->OnFailure(result.status());
-       std::this_thread::sleep_for(backoff_policy->OnCompletion()),
+       client_->backoff_sleeper()(backoff_policy->OnCompletion()),
        result = child_->Read(buf, n)) {
     // A Read() request failed, most likely that means the connection failed or
     // stalled. The current child might no longer be usable, so we will try to
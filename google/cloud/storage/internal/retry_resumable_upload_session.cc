@@ -14,7 +14,6 @@
 
 #include "google/cloud/storage/internal/retry_resumable_upload_session.h"
 #include <sstream>
-#include <thread>
 
 namespace google {
 namespace cloud {
@@ -119,8 +118,7 @@ RetryResumableUploadSession::UploadGenericChunk(
     if (!retry_policy->OnFailure(last_status)) {
       return ReturnError(std::move(last_status), *retry_policy, __func__);
     }
-    auto delay = backoff_policy->OnCompletion();
-    std::this_thread::sleep_for(delay);
+    backoff_sleeper_(backoff_policy->OnCompletion());
 
     result =
         ResetSession(*retry_policy, *backoff_policy, std::move(last_status));
@@ -146,8 +144,7 @@ StatusOr<ResumableUploadResponse> RetryResumableUploadSession::ResetSession(
     if (!retry_policy.OnFailure(last_status)) {
       return ReturnError(std::move(last_status), retry_policy, __func__);
     }
-    auto delay = backoff_policy.OnCompletion();
-    std::this_thread::sleep_for(delay);
+    backoff_sleeper_(backoff_policy.OnCompletion());
   }
   std::ostringstream os;
   os << "Retry policy exhausted in " << __func__ << ": " << last_status;
@@ -18,6 +18,7 @@
 #include "google/cloud/storage/internal/resumable_upload_session.h"
 #include "google/cloud/storage/retry_policy.h"
 #include "google/cloud/storage/version.h"
+#include "google/cloud/backoff_sleeper.h"
 #include "absl/types/optional.h"
 #include <memory>
 
@@ -37,10 +38,12 @@ class RetryResumableUploadSession : public ResumableUploadSession {
   explicit RetryResumableUploadSession(
       std::unique_ptr<ResumableUploadSession> session,
       std::unique_ptr<RetryPolicy> retry_policy,
-      std::unique_ptr<BackoffPolicy> backoff_policy)
+      std::unique_ptr<BackoffPolicy> backoff_policy,
+      BackoffSleeper backoff_sleeper = DefaultBackoffSleeper())
       : session_(std::move(session)),
         retry_policy_prototype_(std::move(retry_policy)),
-        backoff_policy_prototype_(std::move(backoff_policy)) {}
+        backoff_policy_prototype_(std::move(backoff_policy)),
+        backoff_sleeper_(std::move(backoff_sleeper)) {}
 
   StatusOr<ResumableUploadResponse> UploadChunk(
       ConstBufferSequence const& buffers) override;
@@ -67,6 +70,7 @@ class RetryResumableUploadSession : public ResumableUploadSession {
   std::unique_ptr<ResumableUploadSession> session_;
   std::unique_ptr<RetryPolicy const> retry_policy_prototype_;
   std::unique_ptr<BackoffPolicy const> backoff_policy_prototype_;
+  BackoffSleeper backoff_sleeper_;
 };
 
 }  // namespace internal
@@ -0,0 +1,66 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/testing_util/allocation_counter.h"
+#include <cstdlib>
+#include <new>
+
+namespace {
+// The counter for the calling thread, threads that never call
+// `AllocationCounter::Start()` do not count their allocations.
+thread_local std::atomic<std::int64_t>* current_count = nullptr;
+}  // namespace
+
+void* operator new(std::size_t size) {
+  if (current_count != nullptr) ++*current_count;
+  auto* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+#ifdef GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    throw std::bad_alloc();
+#else
+    std::abort();
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  }
+  return p;
+}
+
+void* operator new[](std::size_t size) { return ::operator new(size); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete[](void* p) noexcept { ::operator delete(p); }
+
+#if defined(__cpp_sized_deallocation)
+// Without these the compiler warns (`-Wsized-deallocation`) about replacing
+// only the unsized versions.
+void operator delete(void* p, std::size_t) noexcept { ::operator delete(p); }
+
+void operator delete[](void* p, std::size_t) noexcept { ::operator delete(p); }
+#endif  // defined(__cpp_sized_deallocation)
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+
+void AllocationCounter::Start() { current_count = &count_; }
+
+void AllocationCounter::Stop() {
+  if (current_count == &count_) current_count = nullptr;
+}
+
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,64 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_ALLOCATION_COUNTER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_ALLOCATION_COUNTER_H
+
+#include "google/cloud/version.h"
+#include <atomic>
+#include <cstdint>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace testing_util {
+
+/**
+ * Count the memory allocations made by some threads.
+ *
+ * Programs linking this library replace the global `operator new` and
+ * `operator delete`. Each call to `operator new` is counted by the
+ * `AllocationCounter` started in the calling thread, if any. This is only
+ * intended for benchmarks, where we want to count the allocations in the
+ * threads running the client library, but not in (for example) the threads of
+ * an embedded server.
+ *
+ * Several threads may count their allocations with the same
+ * `AllocationCounter`, but each thread counts with at most one at a time.
+ */
+class AllocationCounter {
+ public:
+  AllocationCounter() = default;
+  AllocationCounter(AllocationCounter const&) = delete;
+  AllocationCounter& operator=(AllocationCounter const&) = delete;
+
+  /// Count the allocations made by the calling thread, until `Stop()`.
+  void Start();
+
+  /// Stop counting the allocations made by the calling thread.
+  void Stop();
+
+  /// The number of allocations counted so far.
+  std::int64_t count() const { return count_.load(); }
+
+ private:
+  std::atomic<std::int64_t> count_{0};
+};
+
+}  // namespace testing_util
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_ALLOCATION_COUNTER_H
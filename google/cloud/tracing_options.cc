@@ -40,6 +40,13 @@ absl::optional<std::int64_t> ParseInteger(std::string const& str) {
   return val;
 }
 
+absl::optional<double> ParseDouble(std::string const& str) {
+  std::size_t econv = -1;
+  auto val = std::stod(str, &econv);
+  if (econv != str.size()) return {};
+  return val;
+}
+
 }  // namespace
 
 TracingOptions& TracingOptions::SetOptions(std::string const& str) {
@@ -56,6 +63,12 @@ TracingOptions& TracingOptions::SetOptions(std::string const& str) {
       if (auto v = ParseBoolean(val)) use_short_repeated_primitives_ = *v;
     } else if (opt == "truncate_string_field_longer_than") {
       if (auto v = ParseInteger(val)) truncate_string_field_longer_than_ = *v;
+    } else if (opt == "truncate_message_longer_than") {
+      if (auto v = ParseInteger(val)) truncate_message_longer_than_ = *v;
+    } else if (opt == "sampling_rate") {
+      if (auto v = ParseDouble(val)) {
+        sampling_rate_ = (std::min)(1.0, (std::max)(0.0, *v));
+      }
     }
     if (comma == end) break;
     pos = comma + 1;
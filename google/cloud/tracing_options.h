@@ -29,6 +29,8 @@ inline namespace GOOGLE_CLOUD_CPP_NS {
  *   single_line_mode=on
  *   use_short_repeated_primitives=on
  *   truncate_string_field_longer_than=128
+ *   truncate_message_longer_than=0
+ *   sampling_rate=1.0
  */
 class TracingOptions {
  public:
@@ -49,10 +51,20 @@ class TracingOptions {
     return truncate_string_field_longer_than_;
   }
 
+  /// If non-zero, truncate each traced message longer than this.
+  std::int64_t truncate_message_longer_than() const {
+    return truncate_message_longer_than_;
+  }
+
+  /// The fraction of the RPCs traced, in the `[0.0, 1.0]` range.
+  double sampling_rate() const { return sampling_rate_; }
+
  private:
   bool single_line_mode_ = true;
   bool use_short_repeated_primitives_ = true;
   std::int64_t truncate_string_field_longer_than_ = 128;
+  std::int64_t truncate_message_longer_than_ = 0;
+  double sampling_rate_ = 1.0;
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_NS
@@ -25,6 +25,8 @@ TEST(TracingOptionsTest, Defaults) {
   EXPECT_TRUE(tracing_options.single_line_mode());
   EXPECT_TRUE(tracing_options.use_short_repeated_primitives());
   EXPECT_EQ(128, tracing_options.truncate_string_field_longer_than());
+  EXPECT_EQ(0, tracing_options.truncate_message_longer_than());
+  EXPECT_EQ(1.0, tracing_options.sampling_rate());
 
   // Unknown/unparseable options are ignored.
   tracing_options.SetOptions("foo=1,bar=T,baz=no");
@@ -38,10 +40,22 @@ TEST(TracingOptionsTest, Override) {
   tracing_options.SetOptions(
       ",single_line_mode=F"
       ",use_short_repeated_primitives=n"
-      ",truncate_string_field_longer_than=256");
+      ",truncate_string_field_longer_than=256"
+      ",truncate_message_longer_than=4096"
+      ",sampling_rate=0.25");
   EXPECT_FALSE(tracing_options.single_line_mode());
   EXPECT_FALSE(tracing_options.use_short_repeated_primitives());
   EXPECT_EQ(256, tracing_options.truncate_string_field_longer_than());
+  EXPECT_EQ(4096, tracing_options.truncate_message_longer_than());
+  EXPECT_EQ(0.25, tracing_options.sampling_rate());
+}
+
+TEST(TracingOptionsTest, SamplingRateIsClamped) {
+  TracingOptions tracing_options;
+  tracing_options.SetOptions("sampling_rate=2");
+  EXPECT_EQ(1.0, tracing_options.sampling_rate());
+  tracing_options.SetOptions("sampling_rate=-1");
+  EXPECT_EQ(0.0, tracing_options.sampling_rate());
 }
 
 }  // namespace